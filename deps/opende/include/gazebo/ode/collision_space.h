@@ -65,6 +65,39 @@ ODE_API dSpaceID dQuadTreeSpaceCreate (dSpaceID space, const dVector3 Center, co
 
 ODE_API dSpaceID dSweepAndPruneSpaceCreate( dSpaceID space, int axisorder );
 
+/**
+ * @brief Create a bounding volume hierarchy space.
+ *
+ * Geoms are stored in a balanced tree of axis aligned boxes, inflated by a
+ * margin. Only geoms that move out of their inflated box update the tree,
+ * which makes this space well suited to many static or slowly moving geoms.
+ *
+ * @param space the parent space, or 0
+ * @returns The new space.
+ * @ingroup collide
+ */
+ODE_API dSpaceID dBVHSpaceCreate( dSpaceID space );
+
+/**
+ * @brief Set the margin by which the boxes of a BVH space are inflated.
+ *
+ * Larger margins rebuild the tree less often for moving geoms, at the cost
+ * of more candidate pairs. Only boxes computed afterwards are affected.
+ *
+ * @param space a BVH space
+ * @param margin the margin, non negative
+ * @ingroup collide
+ */
+ODE_API void dBVHSpaceSetMargin( dSpaceID space, dReal margin );
+
+/**
+ * @brief Get the margin by which the boxes of a BVH space are inflated.
+ * @param space a BVH space
+ * @returns The margin.
+ * @ingroup collide
+ */
+ODE_API dReal dBVHSpaceGetMargin( dSpaceID space );
+
 
 
 ODE_API void dSpaceDestroy (dSpaceID);
@@ -161,6 +194,7 @@ ODE_API dGeomID dSpaceGetGeom (dSpaceID, int i);
  *  @li dHashSpaceClass
  *  @li dSweepAndPruneSpaceClass
  *  @li dQuadTreeSpaceClass
+ *  @li dBVHSpaceClass
  *  @li dFirstUserClass
  *  @li dLastUserClass
  *
@@ -175,6 +209,52 @@ ODE_API dGeomID dSpaceGetGeom (dSpaceID, int i);
  */
 ODE_API int dSpaceGetClass(dSpaceID space);
 
+/**
+ * @brief Get the size of the buffer that holds the order of the geoms of
+ * the simple and hash spaces in a space, the space included.
+ * @sa dSpaceSaveState
+ * @ingroup collide
+ */
+ODE_API size_t dSpaceGetStateSize (dSpaceID space);
+
+/**
+ * @brief Copy the order of the geoms of the simple and hash spaces in a
+ * space, the space included, to a buffer. The other spaces keep the
+ * geoms in structures of their own, only their sub-spaces are saved.
+ *
+ * Moving a geom moves it to the front of its space, and the order of the
+ * geoms is the order in which their collisions are reported. Saving it
+ * along with the state of the bodies lets a simulation be replayed
+ * exactly.
+ *
+ * @param space the space.
+ * @param buffer a buffer of at least dSpaceGetStateSize(space) bytes.
+ * @ingroup collide
+ */
+ODE_API void dSpaceSaveState (dSpaceID space, void *buffer);
+
+/**
+ * @brief Check that the order of the geoms saved by dSpaceSaveState can be
+ * restored, without changing the space.
+ * @param space the space.
+ * @param buffer the saved state.
+ * @param size the size of the saved state.
+ * @returns 1 if dSpaceRestoreState would succeed, 0 otherwise.
+ * @ingroup collide
+ */
+ODE_API int dSpaceCheckState (dSpaceID space, const void *buffer,
+                              size_t size);
+
+/**
+ * @brief Restore the order of the geoms saved by dSpaceSaveState. All the
+ * geoms are marked as moved.
+ * @param space the space, with the same geoms as when the state was saved.
+ * @param buffer the saved state.
+ * @returns 1 if the order was restored, 0 if the geoms don't match.
+ * @ingroup collide
+ */
+ODE_API int dSpaceRestoreState (dSpaceID space, const void *buffer);
+
 #ifdef __cplusplus
 }
 #endif
@@ -561,6 +561,14 @@ ODE_API dReal *dWorldGetQuickStepRMSConstraintResidual (dWorldID);
  */
 ODE_API int dWorldGetQuickStepNumContacts (dWorldID);
 
+/**
+ * @brief Get the number of PGS sweeps done in the last quickstep,
+ * summed over all islands.
+ * @ingroup world
+ * @returns the number of PGS iterations of the last step.
+ */
+ODE_API int dWorldGetQuickStepIterationCount (dWorldID);
+
 /* PGS experimental parameters */
 
 /**
@@ -600,6 +608,13 @@ ODE_API bool dWorldGetQuickStepExperimentalRowReordering (dWorldID);
  */
 ODE_API dReal dWorldGetQuickStepWarmStartFactor (dWorldID);
 
+/**
+ * @brief Get the match distance of contact warm starting.
+ * see dWorldSetQuickStepContactWarmStartDistance for details.
+ * @ingroup world
+ */
+ODE_API dReal dWorldGetQuickStepContactWarmStartDistance (dWorldID);
+
 /**
  * @brief Get extra friction constraint iterations within each time step.
  * @ingroup world
@@ -669,6 +684,67 @@ ODE_API void dWorldSetQuickStepExperimentalRowReordering (dWorldID, bool order);
  */
 ODE_API void dWorldSetQuickStepWarmStartFactor (dWorldID, dReal warm);
 
+/**
+ * @brief Warm start contact joints from the impulses of the previous step.
+ * Contact joints are usually recreated every step, so they start from zero.
+ * With this set, the impulses of each contact are kept after the step, and
+ * a new contact between the same pair of geoms, and within this distance
+ * of an old one, starts from its impulses. Scaled by the warm start factor.
+ * @ingroup world
+ * @param distance 0: turn off contact warm starting, anything else is the
+ * distance a contact point may move in one step and still be matched.
+ */
+ODE_API void dWorldSetQuickStepContactWarmStartDistance (dWorldID, dReal distance);
+
+/**
+ * @brief Get the size of the buffer that holds the impulses kept for
+ * contact warm starting.
+ * @sa dWorldSaveContactWarmStartState
+ * @ingroup world
+ */
+ODE_API size_t dWorldGetContactWarmStartStateSize (dWorldID);
+
+/**
+ * @brief Copy the impulses kept for contact warm starting to a buffer.
+ *
+ * The impulses refer to the geoms by pointer, so the state can only be
+ * restored to the same world, while the geoms exist.
+ *
+ * @param buffer a buffer of at least dWorldGetContactWarmStartStateSize
+ * bytes.
+ * @ingroup world
+ */
+ODE_API void dWorldSaveContactWarmStartState (dWorldID, void *buffer);
+
+/**
+ * @brief Check that the impulses saved by dWorldSaveContactWarmStartState
+ * can be restored, without changing the world.
+ * @param space a space that holds, directly or in its sub-spaces, every
+ * geom of the world.
+ * @param buffer the saved state.
+ * @param size the size of the saved state.
+ * @returns 1 if dWorldRestoreContactWarmStartState would succeed, 0
+ * otherwise.
+ * @ingroup world
+ */
+ODE_API int dWorldCheckContactWarmStartState (dWorldID, dSpaceID space,
+                                              const void *buffer, size_t size);
+
+/**
+ * @brief Replace the impulses kept for contact warm starting with the ones
+ * saved by dWorldSaveContactWarmStartState.
+ * @param space a space that holds, directly or in its sub-spaces, every
+ * geom of the world.
+ * @param buffer the saved state.
+ * @param size the size of the saved state.
+ * @returns 1 if the impulses were restored, 0 if a geom they refer to is
+ * no longer in the space.
+ * @ingroup world
+ */
+ODE_API int dWorldRestoreContactWarmStartState (dWorldID, dSpaceID space,
+                                                const void *buffer,
+                                                size_t size);
+
 /**
  * @brief Set extra friction constraint iterations within each time step,
  * to be done after initial sweeps.
@@ -1661,6 +1737,39 @@ ODE_API dGeomID dBodyGetFirstGeom (dBodyID b);
 ODE_API dGeomID dBodyGetNextGeom (dGeomID g);
 
 
+/**
+ * @brief Get the size of the buffer that holds the dynamic state of a body.
+ * @remarks
+ * The size depends on the number of auto-disable average samples of the
+ * body.
+ * @sa dBodySaveState
+ * @ingroup bodies
+ */
+ODE_API size_t dBodyGetStateSize (dBodyID b);
+
+/**
+ * @brief Copy the dynamic state of a body to a buffer.
+ *
+ * The state is the position, orientation, velocities, accumulated forces
+ * and the auto-disable counters of the body. Its parameters, such as its
+ * mass, are not part of it.
+ *
+ * @param b the body.
+ * @param buffer a buffer of at least dBodyGetStateSize(b) bytes.
+ * @ingroup bodies
+ */
+ODE_API void dBodySaveState (dBodyID b, void *buffer);
+
+/**
+ * @brief Restore the dynamic state of a body saved by dBodySaveState.
+ * @param b the body, with the same auto-disable parameters as when the
+ * state was saved.
+ * @param buffer the saved state.
+ * @ingroup bodies
+ */
+ODE_API void dBodyRestoreState (dBodyID b, const void *buffer);
+
+
 /**
  * @brief Resets the damping settings to the current world's settings.
  * @ingroup bodies damping
@@ -2131,6 +2240,24 @@ ODE_API void dJointSetFeedback (dJointID, dJointFeedback *);
  */
 ODE_API dJointFeedback *dJointGetFeedback (dJointID);
 
+/**
+ * @brief Get the constraint forces of the last step, used to warm start
+ * the next one.
+ * @param lambda receives 6 values.
+ * @param lambda_erp receives 6 values.
+ * @ingroup joints
+ */
+ODE_API void dJointGetWarmStart (dJointID, dReal *lambda, dReal *lambda_erp);
+
+/**
+ * @brief Set the constraint forces used to warm start the next step.
+ * @param lambda 6 values.
+ * @param lambda_erp 6 values.
+ * @ingroup joints
+ */
+ODE_API void dJointSetWarmStart (dJointID, const dReal *lambda,
+    const dReal *lambda_erp);
+
 /**
  * @brief Set the joint anchor point.
  * @ingroup joints
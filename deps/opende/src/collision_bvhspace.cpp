@@ -0,0 +1,793 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001-2003 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+/*
+ *  Bounding volume hierarchy space.
+ *
+ *  Geoms are kept in the leaves of a balanced binary tree of axis aligned
+ *  boxes (a "dynamic AABB tree"). The box of each leaf is the AABB of its
+ *  geom inflated by a margin, so that a geom which moves by less than the
+ *  margin does not change the tree at all. Geoms that move further are
+ *  removed and reinserted, and the tree is rebalanced with rotations on
+ *  the way up.
+ *
+ *  This makes the space cheap to maintain when most geoms do not move,
+ *  e.g. for the static geoms of a large world, while collide() and
+ *  collide2() only visit subtrees whose boxes overlap.
+ *
+ *  Geoms with infinite AABBs (planes, ...) are kept in a separate list and
+ *  tested against everything.
+ */
+
+#include <gazebo/ode/common.h>
+#include <gazebo/ode/odemath.h>
+#include <gazebo/ode/matrix.h>
+#include <gazebo/ode/collision_space.h>
+#include <gazebo/ode/collision.h>
+
+#include "config.h"
+#include "collision_kernel.h"
+#include "collision_space_internal.h"
+
+
+#define GEOM_ENABLED(g) (((g)->gflags & GEOM_ENABLE_TEST_MASK) == GEOM_ENABLE_TEST_VALUE)
+
+// HACK: like the SAP space, we abuse the 'next' and 'tome' members of dxGeom.
+// 'next' stores the leaf node of the geom, and 'tome' its index in GeomList.
+#define GEOM_SET_NODE(g,idx) { (g)->next = (dxGeom*)(size_t)(idx); }
+#define GEOM_GET_NODE(g) ((int)(size_t)(g)->next)
+#define GEOM_SET_GEOM_IDX(g,idx) { (g)->tome = (dxGeom**)(size_t)(idx); }
+#define GEOM_GET_GEOM_IDX(g) ((int)(size_t)(g)->tome)
+
+// Node index of a geom that is in neither the tree nor the infinite list.
+#define NULL_NODE (-1)
+// Node index of a geom that is in the infinite list.
+#define INFINITE_NODE (-2)
+
+
+static inline bool isInfinite( const dReal *aabb )
+{
+	return aabb[0] == -dInfinity || aabb[1] == dInfinity ||
+		aabb[2] == -dInfinity || aabb[3] == dInfinity ||
+		aabb[4] == -dInfinity || aabb[5] == dInfinity;
+}
+
+static inline bool overlaps( const dReal *a, const dReal *b )
+{
+	return a[0] <= b[1] && a[1] >= b[0] &&
+		a[2] <= b[3] && a[3] >= b[2] &&
+		a[4] <= b[5] && a[5] >= b[4];
+}
+
+static inline bool contains( const dReal *outer, const dReal *inner )
+{
+	return outer[0] <= inner[0] && outer[1] >= inner[1] &&
+		outer[2] <= inner[2] && outer[3] >= inner[3] &&
+		outer[4] <= inner[4] && outer[5] >= inner[5];
+}
+
+static inline void combine( const dReal *a, const dReal *b, dReal *result )
+{
+	for ( int i = 0; i < 6; i += 2 ) {
+		result[i] = a[i] < b[i] ? a[i] : b[i];
+		result[i+1] = a[i+1] > b[i+1] ? a[i+1] : b[i+1];
+	}
+}
+
+static inline dReal surfaceArea( const dReal *aabb )
+{
+	dReal x = aabb[1] - aabb[0];
+	dReal y = aabb[3] - aabb[2];
+	dReal z = aabb[5] - aabb[4];
+	return 2 * ( x * y + y * z + z * x );
+}
+
+
+// --------------------------------------------------------------------------
+//  BVH space code
+// --------------------------------------------------------------------------
+
+struct dxBVHSpace : public dxSpace
+{
+	// Constructor / Destructor
+	dxBVHSpace( dSpaceID _space );
+	~dxBVHSpace();
+
+	// dxSpace
+	virtual dxGeom* getGeom(int i);
+	virtual void add(dxGeom* g);
+	virtual void remove(dxGeom* g);
+	virtual void dirty(dxGeom* g);
+	virtual void computeAABB();
+	virtual void cleanGeoms();
+	virtual void collide( void *data, dNearCallback *callback );
+	virtual void collide2( void *data, dxGeom *geom, dNearCallback *callback );
+
+	void setMargin( dReal margin ) { Margin = margin; }
+	dReal getMargin() const { return Margin; }
+
+private:
+
+	//--------------------------------------------------------------------------
+	// Local Declarations
+	//--------------------------------------------------------------------------
+
+	//! A tree node. Leaves have a geom and no children.
+	struct Node
+	{
+		dReal aabb[6];	//!< Inflated AABB for leaves, union of children otherwise
+		int parent;		//!< Parent node, or next free node
+		int child1;		//!< First child, NULL_NODE for leaves
+		int child2;		//!< Second child, NULL_NODE for leaves
+		int height;		//!< 0 for leaves, -1 for free nodes
+		dxGeom *geom;	//!< Geom of a leaf
+	};
+
+	//--------------------------------------------------------------------------
+	// Helpers
+	//--------------------------------------------------------------------------
+
+	bool isLeaf( int node ) const { return Nodes[node].child1 == NULL_NODE; }
+
+	int allocateNode();
+	void freeNode( int node );
+
+	void insertLeaf( int leaf );
+	void removeLeaf( int leaf );
+	int balance( int node );
+	void refit( int node );
+
+	// Place a clean geom in the tree or in the infinite list
+	void update( dxGeom *g );
+	void removeInfinite( dxGeom *g );
+
+	void collideSelf( int node, void *data, dNearCallback *callback );
+	void collidePair( int node1, int node2, void *data, dNearCallback *callback );
+	void collideQuery( int node, dxGeom *geom, void *data, dNearCallback *callback );
+
+	//--------------------------------------------------------------------------
+	// Implementation Data
+	//--------------------------------------------------------------------------
+
+	dArray<Node> Nodes;				// tree nodes, including free ones
+	int Root;						// root node
+	int FreeList;					// first free node
+
+	dArray<dxGeom*> GeomList;		// all geoms, for getGeom()
+	dArray<dxGeom*> DirtyList;		// geoms that moved since the last clean
+	dArray<dxGeom*> InfiniteList;	// geoms with infinite AABBs
+
+	dReal Margin;					// AABB inflation of the leaves
+};
+
+// Creation
+dSpaceID dBVHSpaceCreate( dxSpace* space ) {
+	return new dxBVHSpace( space );
+}
+
+void dBVHSpaceSetMargin( dxSpace* space, dReal margin )
+{
+	dAASSERT(space);
+	dUASSERT(dGeomIsSpace(space) && space->type == dBVHSpaceClass,
+		"argument must be a BVH space");
+	dUASSERT(margin >= 0, "margin must not be negative");
+	((dxBVHSpace*)space)->setMargin( margin );
+}
+
+dReal dBVHSpaceGetMargin( dxSpace* space )
+{
+	dAASSERT(space);
+	dUASSERT(dGeomIsSpace(space) && space->type == dBVHSpaceClass,
+		"argument must be a BVH space");
+	return ((dxBVHSpace*)space)->getMargin();
+}
+
+
+//==============================================================================
+
+dxBVHSpace::dxBVHSpace( dSpaceID _space ) : dxSpace( _space )
+{
+	type = dBVHSpaceClass;
+	Root = NULL_NODE;
+	FreeList = NULL_NODE;
+	Margin = REAL(0.05);
+	dSetZero (aabb,6);
+}
+
+dxBVHSpace::~dxBVHSpace()
+{
+	CHECK_NOT_LOCKED(this);
+	if ( cleanup ) {
+		// note that destroying each geom will call remove()
+		for ( ; GeomList.size(); dGeomDestroy( GeomList[ 0 ] ) ) {}
+	}
+	else {
+		// just unhook them
+		for ( ; GeomList.size(); remove( GeomList[ 0 ] ) ) {}
+	}
+}
+
+dxGeom* dxBVHSpace::getGeom( int i )
+{
+	dUASSERT( i >= 0 && i < count, "index out of range" );
+	return GeomList[i];
+}
+
+void dxBVHSpace::add( dxGeom* g )
+{
+	CHECK_NOT_LOCKED (this);
+	dAASSERT(g);
+	dUASSERT(g->parent_space == 0 && g->next == 0, "geom is already in a space");
+
+	// the geom is placed in the tree when the space is cleaned
+	g->gflags |= GEOM_DIRTY | GEOM_AABB_BAD;
+	GEOM_SET_NODE( g, NULL_NODE );
+	GEOM_SET_GEOM_IDX( g, GeomList.size() );
+	GeomList.push( g );
+	DirtyList.push( g );
+
+	g->parent_space = this;
+	this->count++;
+
+	dGeomMoved(this);
+}
+
+void dxBVHSpace::remove( dxGeom* g )
+{
+	CHECK_NOT_LOCKED(this);
+	dAASSERT(g);
+	dUASSERT(g->parent_space == this,"object is not in this space");
+
+	int node = GEOM_GET_NODE(g);
+	if ( node == INFINITE_NODE ) {
+		removeInfinite( g );
+	}
+	else if ( node != NULL_NODE ) {
+		removeLeaf( node );
+		freeNode( node );
+	}
+
+	// dirty geoms are always in the dirty list
+	if ( g->gflags & GEOM_DIRTY ) {
+		int dirtySize = DirtyList.size();
+		for ( int i = 0; i < dirtySize; ++i ) {
+			if ( DirtyList[i] == g ) {
+				DirtyList[i] = DirtyList[dirtySize-1];
+				DirtyList.setSize( dirtySize-1 );
+				break;
+			}
+		}
+	}
+
+	// remove from geom list, place last in place of this
+	int geomIdx = GEOM_GET_GEOM_IDX(g);
+	dUASSERT( geomIdx>=0 && geomIdx<GeomList.size(), "geom indices messed up" );
+	int geomSize = GeomList.size();
+	dxGeom* lastG = GeomList[geomSize-1];
+	GeomList[geomIdx] = lastG;
+	GEOM_SET_GEOM_IDX(lastG,geomIdx);
+	GeomList.setSize( geomSize-1 );
+	count--;
+
+	// safeguard
+	g->next = 0;
+	g->tome = 0;
+	g->parent_space = 0;
+
+	// the bounding box of this space (and that of all the parents) may have
+	// changed as a consequence of the removal.
+	dGeomMoved(this);
+}
+
+void dxBVHSpace::dirty( dxGeom* g )
+{
+	dAASSERT(g);
+	dUASSERT(g->parent_space == this,"object is not in this space");
+
+	// dGeomMoved() only calls this for geoms that were clean, so each
+	// geom is in the dirty list at most once. Geoms may be moved from
+	// several threads, so lock the mutex like dxSpace::dirty does.
+	boost::mutex::scoped_lock lock(this->mutex);
+	DirtyList.push( g );
+}
+
+void dxBVHSpace::computeAABB()
+{
+	cleanGeoms();
+
+	if ( InfiniteList.size() ) {
+		aabb[0] = -dInfinity;
+		aabb[1] = dInfinity;
+		aabb[2] = -dInfinity;
+		aabb[3] = dInfinity;
+		aabb[4] = -dInfinity;
+		aabb[5] = dInfinity;
+	}
+	else if ( Root != NULL_NODE ) {
+		memcpy( aabb, Nodes[Root].aabb, 6*sizeof(dReal) );
+	}
+	else {
+		dSetZero (aabb,6);
+	}
+}
+
+void dxBVHSpace::cleanGeoms()
+{
+	int dirtySize = DirtyList.size();
+	if( !dirtySize )
+		return;
+
+	// compute the AABBs of all dirty geoms, clear the dirty flags and move
+	// the geoms that left their leaf box
+	lock_count++;
+
+	for( int i = 0; i < dirtySize; ++i ) {
+		dxGeom* g = DirtyList[i];
+		if( IS_SPACE(g) ) {
+			((dxSpace*)g)->cleanGeoms();
+		}
+		g->recomputeAABB();
+		g->gflags &= (~(GEOM_DIRTY|GEOM_AABB_BAD));
+		update( g );
+	}
+	DirtyList.setSize( 0 );
+
+	lock_count--;
+}
+
+void dxBVHSpace::update( dxGeom *g )
+{
+	int node = GEOM_GET_NODE(g);
+
+	if ( isInfinite( g->aabb ) ) {
+		if ( node == INFINITE_NODE )
+			return;
+		if ( node != NULL_NODE ) {
+			removeLeaf( node );
+			freeNode( node );
+		}
+		GEOM_SET_NODE( g, INFINITE_NODE );
+		InfiniteList.push( g );
+		return;
+	}
+
+	if ( node == INFINITE_NODE ) {
+		removeInfinite( g );
+		node = NULL_NODE;
+	}
+
+	if ( node != NULL_NODE ) {
+		// nothing to do while the geom stays inside its inflated box
+		if ( contains( Nodes[node].aabb, g->aabb ) )
+			return;
+		removeLeaf( node );
+	}
+	else {
+		node = allocateNode();
+		Nodes[node].geom = g;
+		GEOM_SET_NODE( g, node );
+	}
+
+	Node &leaf = Nodes[node];
+	for ( int i = 0; i < 6; i += 2 ) {
+		leaf.aabb[i] = g->aabb[i] - Margin;
+		leaf.aabb[i+1] = g->aabb[i+1] + Margin;
+	}
+	insertLeaf( node );
+}
+
+void dxBVHSpace::removeInfinite( dxGeom *g )
+{
+	int infSize = InfiniteList.size();
+	for ( int i = 0; i < infSize; ++i ) {
+		if ( InfiniteList[i] == g ) {
+			InfiniteList[i] = InfiniteList[infSize-1];
+			InfiniteList.setSize( infSize-1 );
+			break;
+		}
+	}
+	GEOM_SET_NODE( g, NULL_NODE );
+}
+
+void dxBVHSpace::collide( void *data, dNearCallback *callback )
+{
+	dAASSERT (callback);
+
+	lock_count++;
+
+	cleanGeoms();
+
+	// collide the tree with itself
+	if ( Root != NULL_NODE )
+		collideSelf( Root, data, callback );
+
+	// collide infinite ones with each other and with everything else
+	int infSize = InfiniteList.size();
+	int geomSize = GeomList.size();
+	for ( int m = 0; m < infSize; ++m ) {
+		dxGeom* g1 = InfiniteList[m];
+		if ( !GEOM_ENABLED(g1) )
+			continue;
+
+		for ( int n = m+1; n < infSize; ++n ) {
+			dxGeom* g2 = InfiniteList[n];
+			if ( GEOM_ENABLED(g2) )
+				collideAABBs( g1, g2, data, callback );
+		}
+
+		for ( int n = 0; n < geomSize; ++n ) {
+			dxGeom* g2 = GeomList[n];
+			if ( GEOM_GET_NODE(g2) != INFINITE_NODE && GEOM_ENABLED(g2) )
+				collideAABBs( g1, g2, data, callback );
+		}
+	}
+
+	lock_count--;
+}
+
+void dxBVHSpace::collide2( void *data, dxGeom *geom, dNearCallback *callback )
+{
+	dAASSERT (geom && callback);
+
+	lock_count++;
+
+	cleanGeoms();
+	geom->recomputeAABB();
+
+	if ( !isInfinite( geom->aabb ) ) {
+		if ( Root != NULL_NODE )
+			collideQuery( Root, geom, data, callback );
+	}
+	else {
+		// every geom can touch an infinite one
+		int geomSize = GeomList.size();
+		for ( int i = 0; i < geomSize; ++i ) {
+			dxGeom* g = GeomList[i];
+			if ( g != geom && GEOM_GET_NODE(g) != INFINITE_NODE && GEOM_ENABLED(g) )
+				collideAABBs( g, geom, data, callback );
+		}
+	}
+
+	int infSize = InfiniteList.size();
+	for ( int i = 0; i < infSize; ++i ) {
+		dxGeom* g = InfiniteList[i];
+		if ( g != geom && GEOM_ENABLED(g) )
+			collideAABBs( g, geom, data, callback );
+	}
+
+	lock_count--;
+}
+
+void dxBVHSpace::collideSelf( int node, void *data, dNearCallback *callback )
+{
+	if ( isLeaf( node ) )
+		return;
+
+	int child1 = Nodes[node].child1;
+	int child2 = Nodes[node].child2;
+	collideSelf( child1, data, callback );
+	collideSelf( child2, data, callback );
+	collidePair( child1, child2, data, callback );
+}
+
+void dxBVHSpace::collidePair( int node1, int node2, void *data, dNearCallback *callback )
+{
+	const Node &n1 = Nodes[node1];
+	const Node &n2 = Nodes[node2];
+	if ( !overlaps( n1.aabb, n2.aabb ) )
+		return;
+
+	bool leaf1 = isLeaf( node1 );
+	bool leaf2 = isLeaf( node2 );
+	if ( leaf1 && leaf2 ) {
+		if ( GEOM_ENABLED(n1.geom) && GEOM_ENABLED(n2.geom) )
+			collideAABBs( n1.geom, n2.geom, data, callback );
+	}
+	else if ( leaf2 || ( !leaf1 && n1.height >= n2.height ) ) {
+		// descend into the larger subtree
+		collidePair( n1.child1, node2, data, callback );
+		collidePair( n1.child2, node2, data, callback );
+	}
+	else {
+		collidePair( node1, n2.child1, data, callback );
+		collidePair( node1, n2.child2, data, callback );
+	}
+}
+
+void dxBVHSpace::collideQuery( int node, dxGeom *geom, void *data, dNearCallback *callback )
+{
+	const Node &n = Nodes[node];
+	if ( !overlaps( n.aabb, geom->aabb ) )
+		return;
+
+	if ( isLeaf( node ) ) {
+		if ( n.geom != geom && GEOM_ENABLED(n.geom) )
+			collideAABBs( n.geom, geom, data, callback );
+	}
+	else {
+		collideQuery( n.child1, geom, data, callback );
+		collideQuery( n.child2, geom, data, callback );
+	}
+}
+
+
+//==============================================================================
+// Tree maintenance, after the dynamic AABB tree of Box2D and Bullet.
+
+int dxBVHSpace::allocateNode()
+{
+	int node;
+	if ( FreeList != NULL_NODE ) {
+		node = FreeList;
+		FreeList = Nodes[node].parent;
+	}
+	else {
+		node = Nodes.size();
+		Nodes.setSize( node + 1 );
+	}
+
+	Node &n = Nodes[node];
+	n.parent = NULL_NODE;
+	n.child1 = NULL_NODE;
+	n.child2 = NULL_NODE;
+	n.height = 0;
+	n.geom = 0;
+	return node;
+}
+
+void dxBVHSpace::freeNode( int node )
+{
+	Nodes[node].parent = FreeList;
+	Nodes[node].height = -1;
+	Nodes[node].geom = 0;
+	FreeList = node;
+}
+
+void dxBVHSpace::insertLeaf( int leaf )
+{
+	if ( Root == NULL_NODE ) {
+		Root = leaf;
+		Nodes[leaf].parent = NULL_NODE;
+		return;
+	}
+
+	// find the best sibling, using the surface area heuristic
+	dReal leafAABB[6];
+	memcpy( leafAABB, Nodes[leaf].aabb, 6*sizeof(dReal) );
+
+	int index = Root;
+	while ( !isLeaf( index ) ) {
+		const Node &n = Nodes[index];
+
+		dReal combined[6];
+		combine( n.aabb, leafAABB, combined );
+		dReal area = surfaceArea( n.aabb );
+		dReal combinedArea = surfaceArea( combined );
+
+		// cost of creating a new parent for this node and the new leaf
+		dReal cost = 2 * combinedArea;
+
+		// minimum cost of pushing the leaf further down the tree
+		dReal inheritanceCost = 2 * ( combinedArea - area );
+
+		dReal childCost[2];
+		int children[2] = { n.child1, n.child2 };
+		for ( int i = 0; i < 2; ++i ) {
+			const Node &child = Nodes[children[i]];
+			combine( child.aabb, leafAABB, combined );
+			if ( isLeaf( children[i] ) ) {
+				childCost[i] = surfaceArea( combined ) + inheritanceCost;
+			}
+			else {
+				childCost[i] = surfaceArea( combined ) - surfaceArea( child.aabb ) +
+					inheritanceCost;
+			}
+		}
+
+		if ( cost < childCost[0] && cost < childCost[1] )
+			break;
+
+		index = childCost[0] < childCost[1] ? children[0] : children[1];
+	}
+
+	int sibling = index;
+
+	// create a new parent
+	int newParent = allocateNode();
+	int oldParent = Nodes[sibling].parent;
+	Node &p = Nodes[newParent];
+	p.parent = oldParent;
+	combine( leafAABB, Nodes[sibling].aabb, p.aabb );
+	p.height = Nodes[sibling].height + 1;
+	p.child1 = sibling;
+	p.child2 = leaf;
+
+	if ( oldParent != NULL_NODE ) {
+		if ( Nodes[oldParent].child1 == sibling )
+			Nodes[oldParent].child1 = newParent;
+		else
+			Nodes[oldParent].child2 = newParent;
+	}
+	else {
+		Root = newParent;
+	}
+	Nodes[sibling].parent = newParent;
+	Nodes[leaf].parent = newParent;
+
+	// walk back up the tree fixing heights and boxes
+	refit( Nodes[leaf].parent );
+}
+
+void dxBVHSpace::removeLeaf( int leaf )
+{
+	if ( leaf == Root ) {
+		Root = NULL_NODE;
+		return;
+	}
+
+	int parent = Nodes[leaf].parent;
+	int grandParent = Nodes[parent].parent;
+	int sibling = Nodes[parent].child1 == leaf ?
+		Nodes[parent].child2 : Nodes[parent].child1;
+
+	if ( grandParent != NULL_NODE ) {
+		// destroy the parent and connect the sibling to the grand parent
+		if ( Nodes[grandParent].child1 == parent )
+			Nodes[grandParent].child1 = sibling;
+		else
+			Nodes[grandParent].child2 = sibling;
+		Nodes[sibling].parent = grandParent;
+		freeNode( parent );
+
+		refit( grandParent );
+	}
+	else {
+		Root = sibling;
+		Nodes[sibling].parent = NULL_NODE;
+		freeNode( parent );
+	}
+}
+
+void dxBVHSpace::refit( int node )
+{
+	while ( node != NULL_NODE ) {
+		node = balance( node );
+
+		Node &n = Nodes[node];
+		const Node &child1 = Nodes[n.child1];
+		const Node &child2 = Nodes[n.child2];
+		n.height = 1 + ( child1.height > child2.height ? child1.height : child2.height );
+		combine( child1.aabb, child2.aabb, n.aabb );
+
+		node = n.parent;
+	}
+}
+
+// Perform a left or right rotation if node A is imbalanced.
+// Returns the new root of the subtree.
+int dxBVHSpace::balance( int iA )
+{
+	Node *A = &Nodes[iA];
+	if ( isLeaf( iA ) || A->height < 2 )
+		return iA;
+
+	int iB = A->child1;
+	int iC = A->child2;
+	Node *B = &Nodes[iB];
+	Node *C = &Nodes[iC];
+
+	int imbalance = C->height - B->height;
+
+	// rotate C up
+	if ( imbalance > 1 ) {
+		int iF = C->child1;
+		int iG = C->child2;
+		Node *F = &Nodes[iF];
+		Node *G = &Nodes[iG];
+
+		// swap A and C
+		C->child1 = iA;
+		C->parent = A->parent;
+		A->parent = iC;
+
+		// A's old parent should point to C
+		if ( C->parent != NULL_NODE ) {
+			if ( Nodes[C->parent].child1 == iA )
+				Nodes[C->parent].child1 = iC;
+			else
+				Nodes[C->parent].child2 = iC;
+		}
+		else {
+			Root = iC;
+		}
+
+		// rotate
+		if ( F->height > G->height ) {
+			C->child2 = iF;
+			A->child2 = iG;
+			G->parent = iA;
+			combine( B->aabb, G->aabb, A->aabb );
+			combine( A->aabb, F->aabb, C->aabb );
+			A->height = 1 + ( B->height > G->height ? B->height : G->height );
+			C->height = 1 + ( A->height > F->height ? A->height : F->height );
+		}
+		else {
+			C->child2 = iG;
+			A->child2 = iF;
+			F->parent = iA;
+			combine( B->aabb, F->aabb, A->aabb );
+			combine( A->aabb, G->aabb, C->aabb );
+			A->height = 1 + ( B->height > F->height ? B->height : F->height );
+			C->height = 1 + ( A->height > G->height ? A->height : G->height );
+		}
+
+		return iC;
+	}
+
+	// rotate B up
+	if ( imbalance < -1 ) {
+		int iD = B->child1;
+		int iE = B->child2;
+		Node *D = &Nodes[iD];
+		Node *E = &Nodes[iE];
+
+		// swap A and B
+		B->child1 = iA;
+		B->parent = A->parent;
+		A->parent = iB;
+
+		// A's old parent should point to B
+		if ( B->parent != NULL_NODE ) {
+			if ( Nodes[B->parent].child1 == iA )
+				Nodes[B->parent].child1 = iB;
+			else
+				Nodes[B->parent].child2 = iB;
+		}
+		else {
+			Root = iB;
+		}
+
+		// rotate
+		if ( D->height > E->height ) {
+			B->child2 = iD;
+			A->child1 = iE;
+			E->parent = iA;
+			combine( C->aabb, E->aabb, A->aabb );
+			combine( A->aabb, D->aabb, B->aabb );
+			A->height = 1 + ( C->height > E->height ? C->height : E->height );
+			B->height = 1 + ( A->height > D->height ? A->height : D->height );
+		}
+		else {
+			B->child2 = iE;
+			A->child1 = iD;
+			D->parent = iA;
+			combine( C->aabb, D->aabb, A->aabb );
+			combine( A->aabb, E->aabb, B->aabb );
+			A->height = 1 + ( C->height > D->height ? C->height : D->height );
+			B->height = 1 + ( A->height > E->height ? A->height : E->height );
+		}
+
+		return iB;
+	}
+
+	return iA;
+}
@@ -40,6 +40,7 @@ for geometry objects
 #include "collision_transform.h"
 #include "collision_trimesh_internal.h"
 #include "collision_space_internal.h"
+#include "quickstep.h"
 #include "odeou.h"
 
 //#ifdef dLIBCCD_ENABLED
@@ -372,6 +373,7 @@ dxGeom::dxGeom (dSpaceID _space, int is_placeable)
   dSetZero (aabb,6);
   category_bits = ~0;
   collide_bits = ~0;
+  warm_start_world = 0;
 
   // put this geom in a space if required
   if (_space) dSpaceAdd (_space,this);
@@ -380,6 +382,10 @@ dxGeom::dxGeom (dSpaceID _space, int is_placeable)
 
 dxGeom::~dxGeom()
 {
+   // the warm starts are matched by geom, don't let a new geom take them
+   if (warm_start_world)
+     dxRemoveContactWarmStarts (warm_start_world,this);
+
    if (parent_space)
      dSpaceRemove (parent_space,this);
 
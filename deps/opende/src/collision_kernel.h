@@ -110,6 +110,9 @@ struct dxGeom : public dBase {
   dReal aabb[6];	// cached AABB for this space
   unsigned long category_bits,collide_bits;
 
+  // the world whose contact warm starts refer to this geom, 0 if none
+  dxWorld *warm_start_world;
+
   dxGeom (dSpaceID _space, int is_placeable);
   virtual ~dxGeom();
 
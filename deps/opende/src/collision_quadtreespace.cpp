@@ -336,6 +336,10 @@ struct dxQuadTreeSpace : public dxSpace{
 
 	dArray<dxGeom*> DirtyList;
 
+	int BlockCount;	// Number of blocks
+	dArray<dxGeom*> GeomCache;	// All geoms, for getGeom()
+	bool GeomCacheValid;
+
 	dxQuadTreeSpace(dSpaceID _space, const dVector3 Center, const dVector3 Extents, int Depth);
 	~dxQuadTreeSpace();
 
@@ -362,7 +366,7 @@ struct dxQuadTreeSpace : public dxSpace{
 dxQuadTreeSpace::dxQuadTreeSpace(dSpaceID _space, const dVector3 Center, const dVector3 Extents, int Depth) : dxSpace(_space){
 	type = dQuadTreeSpaceClass;
 
-	int BlockCount = 0;
+	BlockCount = 0;
 	// TODO: should be just BlockCount = (4^(n+1) - 1)/3
 	for (int i = 0; i <= Depth; i++){
 		BlockCount += (int)pow((dReal)SPLITS, i);
@@ -383,6 +387,8 @@ dxQuadTreeSpace::dxQuadTreeSpace(dSpaceID _space, const dVector3 Center, const d
 	CurrentObject = 0;
 	CurrentIndex = -1;
 
+	GeomCacheValid = false;
+
 	// Init AABB. We initialize to infinity because it is not illegal for an object to be outside of the tree. Its simply inserted in the root block
 	aabb[0] = -dInfinity;
 	aabb[1] = dInfinity;
@@ -409,77 +415,22 @@ dxQuadTreeSpace::~dxQuadTreeSpace(){
 	dFree(CurrentChild, (Depth + 1) * sizeof(int));
 }
 
-dxGeom* dxQuadTreeSpace::getGeom(int /*Index*/){
-	//dUASSERT(Index >= 0 && Index < count, "index out of range");
-
-	//@@@
-	dDebug (0,"dxQuadTreeSpace::getGeom() not yet implemented");
+dxGeom* dxQuadTreeSpace::getGeom(int Index){
+	dUASSERT(Index >= 0 && Index < count, "index out of range");
 
-	return 0;
-
-	// This doesnt work
-
-	/*if (CurrentIndex == Index){
-		// Loop through all objects in the local list
-CHILDRECURSE:
-		if (CurrentObject){
-			dGeomID g = CurrentObject;
-			CurrentObject = CurrentObject->next;
-			CurrentIndex++;
-		
-#ifdef DRAWBLOCKS
-			DrawBlock(CurrentBlock);
-#endif	//DRAWBLOCKS
-			return g;
-		}
-		else{
-			// Now lets loop through our children. Starting at index 0.
-			if (CurrentBlock->Children){
-				CurrentChild[CurrentLevel] = 0;
-PARENTRECURSE:
-				for (int& i = CurrentChild[CurrentLevel]; i < SPLITS; i++){
-					if (CurrentBlock->Children[i].GeomCount == 0){
-						continue;
-					}
-					CurrentBlock = &CurrentBlock->Children[i];
-					CurrentObject = CurrentBlock->First;
-				
-					i++;
-				
-					CurrentLevel++;
-					goto CHILDRECURSE;
-				}
+	// The geoms are spread over the blocks, so enumerate them once into a
+	// flat list, which stays valid until a geom is added or removed.
+	if (!GeomCacheValid){
+		GeomCache.setSize(0);
+		for (int i = 0; i < BlockCount; i++){
+			for (dxGeom* g = Blocks[i].mFirst; g; g = g->next){
+				GeomCache.push(g);
 			}
 		}
-		
-		// Now lets go back to the parent so it can continue processing its other children.
-		if (CurrentBlock->Parent){
-			CurrentBlock = CurrentBlock->Parent;
-			CurrentLevel--;
-			goto PARENTRECURSE;
-		}
-	}
-	else{
-		CurrentBlock = &Blocks[0];
-		CurrentLevel = 0;
-		CurrentObject = CurrentObject;
-		CurrentIndex = 0;
-
-		// Other states are already set
-		CurrentObject = CurrentBlock->First;
-	}
-
-
-	if (current_geom && current_index == Index - 1){
-		//current_geom = current_geom->next; // next
-		current_index = Index;
-		return current_geom;
+		GeomCacheValid = true;
 	}
-	else for (int i = 0; i < Index; i++){	// this will be verrrrrrry slow
-		getGeom(i);
-	}*/
 
-	return 0;
+	return GeomCache[Index];
 }
 
 void dxQuadTreeSpace::add(dxGeom* g){
@@ -494,6 +445,7 @@ void dxQuadTreeSpace::add(dxGeom* g){
 	g->parent_space = this;
 	Blocks[0].GetBlock(g->aabb)->AddObject(g);	// Add to best block
 	count++;
+	GeomCacheValid = false;
 	
 	// enumerator has been invalidated
 	current_geom = 0;
@@ -508,6 +460,7 @@ void dxQuadTreeSpace::remove(dxGeom* g){
 	
 	// remove
 	((Block*)g->tome)->DelObject(g);
+	GeomCacheValid = false;
 	count--;
 
 	for (int i = 0; i < DirtyList.size(); i++){
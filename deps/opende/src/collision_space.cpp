@@ -34,6 +34,7 @@ spaces
 #include "collision_kernel.h"
 #include "collision_space_internal.h"
 #include "util.h"
+#include <vector>
 
 #ifdef _MSC_VER
 #pragma warning(disable:4291)  // for VC++, no complaints about "no matching operator delete found"
@@ -761,6 +762,210 @@ int dSpaceGetClass (dxSpace *space)
   return space->type;
 }
 
+// the order of the geoms of simple and hash spaces is saved, the other
+// spaces have internal structures of their own. They only save their
+// sub-spaces, since those may have an order.
+//
+// An ordered space saves its geom count and its geoms, in order, and an
+// unordered space its sub-space count and its sub-spaces. Both are
+// followed by the states of their sub-spaces, in the order they were
+// saved in.
+static bool spaceHasOrder (dxGeom *geom)
+{
+  return geom->type == dSimpleSpaceClass || geom->type == dHashSpaceClass;
+}
+
+// the sub-spaces of a space that has no order
+static void spaceSubSpaces (dxSpace *space, std::vector<dxSpace*> &spaces)
+{
+  const int count = space->getNumGeoms ();
+  for (int i = 0; i < count; ++i) {
+    dxGeom *g = space->getGeom (i);
+    if (IS_SPACE (g))
+      spaces.push_back ((dxSpace*) g);
+  }
+}
+
+size_t dSpaceGetStateSize (dxSpace *space)
+{
+  dAASSERT (space);
+  size_t size = sizeof(int);
+  if (spaceHasOrder (space)) {
+    size += space->count * sizeof(dxGeom*);
+    for (dxGeom *g = space->first; g; g = g->next) {
+      if (IS_SPACE (g))
+        size += dSpaceGetStateSize ((dxSpace*) g);
+    }
+  }
+  else {
+    std::vector<dxSpace*> spaces;
+    spaceSubSpaces (space, spaces);
+    for (size_t i = 0; i < spaces.size(); ++i)
+      size += sizeof(dxGeom*) + dSpaceGetStateSize (spaces[i]);
+  }
+  return size;
+}
+
+static char *spaceSaveState (dxSpace *space, char *buffer)
+{
+  // the buffer may not be aligned
+  if (spaceHasOrder (space)) {
+    memcpy (buffer, &space->count, sizeof(int));
+    buffer += sizeof(int);
+    for (dxGeom *g = space->first; g; g = g->next) {
+      memcpy (buffer, &g, sizeof(dxGeom*));
+      buffer += sizeof(dxGeom*);
+    }
+    for (dxGeom *g = space->first; g; g = g->next) {
+      if (IS_SPACE (g))
+        buffer = spaceSaveState ((dxSpace*) g, buffer);
+    }
+  }
+  else {
+    std::vector<dxSpace*> spaces;
+    spaceSubSpaces (space, spaces);
+    int count = (int) spaces.size();
+    memcpy (buffer, &count, sizeof(int));
+    buffer += sizeof(int);
+    for (int i = 0; i < count; ++i) {
+      dxGeom *g = spaces[i];
+      memcpy (buffer, &g, sizeof(dxGeom*));
+      buffer += sizeof(dxGeom*);
+      buffer = spaceSaveState (spaces[i], buffer);
+    }
+  }
+  return buffer;
+}
+
+void dSpaceSaveState (dxSpace *space, void *buffer)
+{
+  dAASSERT (space && buffer);
+  spaceSaveState (space, (char*) buffer);
+}
+
+// the sub-spaces are saved in the order of their geoms, which is the order
+// they have once restored
+static const char *spaceCheckState (dxSpace *space, const char *buffer,
+                                    const char *end)
+{
+  int count;
+  if (end - buffer < (ptrdiff_t) sizeof(int))
+    return 0;
+  memcpy (&count, buffer, sizeof(int));
+  buffer += sizeof(int);
+
+  if (!spaceHasOrder (space)) {
+    std::vector<dxSpace*> spaces;
+    spaceSubSpaces (space, spaces);
+    if (count != (int) spaces.size())
+      return 0;
+    for (int i = 0; i < count && buffer; ++i) {
+      dxGeom *g;
+      if (end - buffer < (ptrdiff_t) sizeof(dxGeom*))
+        return 0;
+      memcpy (&g, buffer, sizeof(dxGeom*));
+      buffer += sizeof(dxGeom*);
+      if (!g || g->parent_space != space || !IS_SPACE (g))
+        return 0;
+      buffer = spaceCheckState ((dxSpace*) g, buffer, end);
+    }
+    return buffer;
+  }
+
+  if (count != space->count)
+    return 0;
+
+  if (end - buffer < (ptrdiff_t) (count * sizeof(dxGeom*)))
+    return 0;
+  const char *geoms = buffer;
+  buffer += count * sizeof(dxGeom*);
+
+  for (int i = 0; i < count; ++i) {
+    dxGeom *g;
+    memcpy (&g, geoms + i * sizeof(dxGeom*), sizeof(dxGeom*));
+    if (!g || g->parent_space != space)
+      return 0;
+  }
+  for (int i = 0; i < count && buffer; ++i) {
+    dxGeom *g;
+    memcpy (&g, geoms + i * sizeof(dxGeom*), sizeof(dxGeom*));
+    if (IS_SPACE (g))
+      buffer = spaceCheckState ((dxSpace*) g, buffer, end);
+  }
+  return buffer;
+}
+
+int dSpaceCheckState (dxSpace *space, const void *buffer, size_t size)
+{
+  dAASSERT (space && buffer);
+  const char *end = (const char*) buffer + size;
+  return spaceCheckState (space, (const char*) buffer, end) == end;
+}
+
+static const char *spaceRestoreState (dxSpace *space, const char *buffer)
+{
+  CHECK_NOT_LOCKED (space);
+
+  int count;
+  memcpy (&count, buffer, sizeof(int));
+  buffer += sizeof(int);
+
+  if (!spaceHasOrder (space)) {
+    for (int i = 0; i < count && buffer; ++i) {
+      dxGeom *g;
+      memcpy (&g, buffer, sizeof(dxGeom*));
+      buffer += sizeof(dxGeom*);
+      if (!g || g->parent_space != space || !IS_SPACE (g))
+        return 0;
+      buffer = spaceRestoreState ((dxSpace*) g, buffer);
+    }
+    return buffer;
+  }
+
+  if (count != space->count)
+    return 0;
+
+  const char *geoms = buffer;
+  for (int i = 0; i < count; ++i) {
+    dxGeom *g;
+    memcpy (&g, geoms + i * sizeof(dxGeom*), sizeof(dxGeom*));
+    if (!g || g->parent_space != space)
+      return 0;
+  }
+  buffer += count * sizeof(dxGeom*);
+
+  {
+    boost::mutex::scoped_lock lock(space->mutex);
+    // geoms are added to the front of the list, so add them in reverse
+    for (int i = count - 1; i >= 0; --i) {
+      dxGeom *g;
+      memcpy (&g, geoms + i * sizeof(dxGeom*), sizeof(dxGeom*));
+      g->spaceRemove();
+      g->spaceAdd (&space->first);
+      // every geom is dirty, so that the dirty geoms still come first
+      g->gflags |= GEOM_DIRTY | GEOM_AABB_BAD;
+      if (g->offset_posr)
+        g->gflags |= GEOM_POSR_BAD;
+    }
+  }
+  space->current_geom = 0;
+
+  for (dxGeom *g = space->first; g && buffer; g = g->next) {
+    if (IS_SPACE (g))
+      buffer = spaceRestoreState ((dxSpace*) g, buffer);
+  }
+  return buffer;
+}
+
+int dSpaceRestoreState (dxSpace *space, const void *buffer)
+{
+  dAASSERT (space && buffer);
+  if (!spaceRestoreState (space, (const char*) buffer))
+    return 0;
+  dGeomMoved (space);
+  return 1;
+}
+
 
 void dSpaceCollide (dxSpace *space, void *data, dNearCallback *callback)
 {
@@ -814,16 +1019,17 @@ void dSpaceCollide2 (dxGeom *g1, dxGeom *g2, void *data,
 			}
 			else {
 				// iterate through the space that has the fewest geoms, calling
-				// collide2 in the other space for each one.
+				// collide2 in the other space for each one. getGeom() is used
+				// since not all spaces keep their geoms in the 'first' list.
 				if (s1->count < s2->count) {
 					DataCallback dc = {data, callback};
-					for (dxGeom *g = s1->first; g; g=g->next) {
-						s2->collide2 (&dc,g,swap_callback);
+					for (int i = 0; i < s1->count; ++i) {
+						s2->collide2 (&dc,s1->getGeom(i),swap_callback);
 					}
 				}
 				else {
-					for (dxGeom *g = s2->first; g; g=g->next) {
-						s1->collide2 (data,g,callback);
+					for (int i = 0; i < s2->count; ++i) {
+						s1->collide2 (data,s2->getGeom(i),callback);
 					}
 				}
 			}
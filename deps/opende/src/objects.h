@@ -26,7 +26,9 @@
 #ifndef _ODE_OBJECT_H_
 #define _ODE_OBJECT_H_
 
+#include <atomic>
 #include <limits>
+#include <vector>
 #include <gazebo/ode/common.h>
 #include <gazebo/ode/memory.h>
 #include <gazebo/ode/mass.h>
@@ -122,6 +124,8 @@ struct dxQuickStepParameters {
   bool thread_position_correction;  // threaded position correction computations
   bool row_reorder1;  // control quickstep row reordering
   dReal warm_start;  // warm start factor, 0: no warm start, 1: full warm start
+  dReal contact_warm_start_distance;  // contact match distance, 0: no contact warm start
+  std::atomic<int> iteration_count;  // PGS sweeps of the last step, summed over islands
   int friction_iterations;  // extra quickstep iterations friction.
   Friction_Model friction_model;  // friction model, enum type Friction_Model
   World_Solver_Type world_solver_type;  // world step solver, enum type World_Solver_Type.
@@ -185,6 +189,25 @@ struct dxBody : public dObject {
 };
 
 
+// impulses of a contact joint at the end of a step, used to warm start a
+// contact between the same geoms in the next step
+struct dxContactWarmStart {
+  dGeomID g1,g2;      // geoms in contact, in the order of the contact joint
+  dVector3 pos;       // contact position
+  dReal lambda[6];
+  dReal lambda_erp[6];
+  bool used;          // already matched to a contact of this step
+};
+
+// an island to step, with the offsets of its bodies and joints in the
+// island arrays, and an estimate of its cost used to schedule it
+struct dxIslandTask {
+  int index;          // island index, also index of its working memory
+  int bodyoffset, bcount;
+  int jointoffset, jcount;
+  size_t cost;
+};
+
 struct dxWorld : public dBase {
   dxBody *firstbody;    // body linked list
   dxJoint *firstjoint;    // joint linked list
@@ -204,6 +227,8 @@ struct dxWorld : public dBase {
   dReal max_angular_speed;      // limit the angular velocity to this magnitude
   boost::threadpool::pool *threadpool;
   boost::threadpool::pool *row_threadpool;
+  std::vector<dxIslandTask> island_tasks; // islands of this step, in scheduling order
+  std::vector<dxContactWarmStart> contact_warm_starts; // sorted by geom pair
 };
 
 
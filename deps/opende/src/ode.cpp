@@ -1176,6 +1176,95 @@ dGeomID dBodyGetNextGeom(dGeomID geom)
         return dGeomGetBodyNext(geom);
 }
 
+// dynamic state of a body, followed by its auto-disable average buffers
+struct dxBodyState {
+  dxPosR posr;
+  dQuaternion q;
+  dVector3 lvel,avel;
+  dVector3 facc,tacc;
+  unsigned flags;
+  dReal adis_timeleft;
+  int adis_stepsleft;
+  unsigned int average_counter;
+  int average_ready;
+};
+
+size_t dBodyGetStateSize (dBodyID b)
+{
+  dAASSERT (b);
+  size_t size = sizeof(dxBodyState);
+  if (b->average_lvel_buffer)
+    size += b->adis.average_samples * sizeof(dVector3);
+  if (b->average_avel_buffer)
+    size += b->adis.average_samples * sizeof(dVector3);
+  return size;
+}
+
+void dBodySaveState (dBodyID b, void *buffer)
+{
+  dAASSERT (b && buffer);
+  // the buffer may not be aligned
+  dxBodyState state;
+  state.posr = b->posr;
+  memcpy (state.q, b->q, sizeof(dQuaternion));
+  memcpy (state.lvel, b->lvel, sizeof(dVector3));
+  memcpy (state.avel, b->avel, sizeof(dVector3));
+  memcpy (state.facc, b->facc, sizeof(dVector3));
+  memcpy (state.tacc, b->tacc, sizeof(dVector3));
+  state.flags = b->flags;
+  state.adis_timeleft = b->adis_timeleft;
+  state.adis_stepsleft = b->adis_stepsleft;
+  state.average_counter = b->average_counter;
+  state.average_ready = b->average_ready;
+  memcpy (buffer, &state, sizeof(dxBodyState));
+
+  char *average = (char*) buffer + sizeof(dxBodyState);
+  if (b->average_lvel_buffer) {
+    memcpy (average, b->average_lvel_buffer,
+        b->adis.average_samples * sizeof(dVector3));
+    average += b->adis.average_samples * sizeof(dVector3);
+  }
+  if (b->average_avel_buffer) {
+    memcpy (average, b->average_avel_buffer,
+        b->adis.average_samples * sizeof(dVector3));
+  }
+}
+
+void dBodyRestoreState (dBodyID b, const void *buffer)
+{
+  dAASSERT (b && buffer);
+  // the buffer may not be aligned
+  dxBodyState state;
+  memcpy (&state, buffer, sizeof(dxBodyState));
+  b->posr = state.posr;
+  memcpy (b->q, state.q, sizeof(dQuaternion));
+  memcpy (b->lvel, state.lvel, sizeof(dVector3));
+  memcpy (b->avel, state.avel, sizeof(dVector3));
+  memcpy (b->facc, state.facc, sizeof(dVector3));
+  memcpy (b->tacc, state.tacc, sizeof(dVector3));
+  // only the disabled flag changes while stepping
+  b->flags = (b->flags & ~dxBodyDisabled) | (state.flags & dxBodyDisabled);
+  b->adis_timeleft = state.adis_timeleft;
+  b->adis_stepsleft = state.adis_stepsleft;
+  b->average_counter = state.average_counter;
+  b->average_ready = state.average_ready;
+
+  const char *average = (const char*) buffer + sizeof(dxBodyState);
+  if (b->average_lvel_buffer) {
+    memcpy (b->average_lvel_buffer, average,
+        b->adis.average_samples * sizeof(dVector3));
+    average += b->adis.average_samples * sizeof(dVector3);
+  }
+  if (b->average_avel_buffer) {
+    memcpy (b->average_avel_buffer, average,
+        b->adis.average_samples * sizeof(dVector3));
+  }
+
+  // notify all attached geoms that this body has moved
+  for (dxGeom *geom = b->geom; geom; geom = dGeomGetBodyNext (geom))
+    dGeomMoved (geom);
+}
+
 
 int dBodyGetGyroscopicMode(dBodyID b)
 {
@@ -1542,6 +1631,21 @@ dJointFeedback *dJointGetFeedback (dxJoint *joint)
   return joint->feedback;
 }
 
+void dJointGetWarmStart (dxJoint *joint, dReal *lambda, dReal *lambda_erp)
+{
+  dAASSERT (joint && lambda && lambda_erp);
+  memcpy (lambda, joint->lambda, sizeof(joint->lambda));
+  memcpy (lambda_erp, joint->lambda_erp, sizeof(joint->lambda_erp));
+}
+
+void dJointSetWarmStart (dxJoint *joint, const dReal *lambda,
+    const dReal *lambda_erp)
+{
+  dAASSERT (joint && lambda && lambda_erp);
+  memcpy (joint->lambda, lambda, sizeof(joint->lambda));
+  memcpy (joint->lambda_erp, lambda_erp, sizeof(joint->lambda_erp));
+}
+
 
 
 dJointID dConnectingJoint (dBodyID in_b1, dBodyID in_b2)
@@ -1668,6 +1772,8 @@ dxWorld * dWorldCreate()
   w->qs.thread_position_correction = false;
   w->qs.row_reorder1 = true;
   w->qs.warm_start = 0.5;
+  w->qs.contact_warm_start_distance = 0;
+  w->qs.iteration_count = 0;
   w->qs.friction_iterations = 10;
   w->qs.friction_model = pyramid_friction;
   w->qs.world_solver_type = ODE_DEFAULT;
@@ -1757,6 +1863,8 @@ void dWorldDestroy (dxWorld *w)
     delete w->row_threadpool;
   }
 
+  dxClearContactWarmStarts (w);
+
   delete w;
 }
 
@@ -1984,9 +2092,12 @@ int dWorldQuickStep (dWorldID w, dReal stepsize)
 
   bool result = false;
 
+  w->qs.iteration_count = 0;
   if (dxReallocateWorldProcessContext (w, stepsize, &dxEstimateQuickStepMemoryRequirements))
   {
+    dxLoadContactWarmStarts (w);
     dxProcessIslands (w, stepsize, &dxQuickStepper);
+    dxSaveContactWarmStarts (w);
 
     result = true;
   }
@@ -2282,6 +2393,12 @@ int dWorldGetQuickStepNumContacts (dWorldID w)
   return w->qs.num_contacts;
 }
 
+int dWorldGetQuickStepIterationCount (dWorldID w)
+{
+  dAASSERT(w);
+  return w->qs.iteration_count;
+}
+
 /* experimental PGS */
 bool dWorldGetQuickStepInertiaRatioReduction (dWorldID w)
 {
@@ -2319,6 +2436,12 @@ dReal  dWorldGetQuickStepWarmStartFactor (dWorldID w)
   return w->qs.warm_start;
 }
 
+dReal  dWorldGetQuickStepContactWarmStartDistance (dWorldID w)
+{
+  dAASSERT(w);
+  return w->qs.contact_warm_start_distance;
+}
+
 int  dWorldGetQuickStepExtraFrictionIterations (dWorldID w)
 {
   dAASSERT(w);
@@ -2373,6 +2496,43 @@ void dWorldSetQuickStepWarmStartFactor (dWorldID w, dReal warm)
   w->qs.warm_start = warm;
 }
 
+void dWorldSetQuickStepContactWarmStartDistance (dWorldID w, dReal distance)
+{
+  dAASSERT(w);
+  w->qs.contact_warm_start_distance = distance;
+  if (distance <= 0)
+    dxClearContactWarmStarts (w);
+}
+
+size_t dWorldGetContactWarmStartStateSize (dWorldID w)
+{
+  dAASSERT(w);
+  return dxContactWarmStartStateSize (w);
+}
+
+void dWorldSaveContactWarmStartState (dWorldID w, void *buffer)
+{
+  dAASSERT(w && buffer);
+  dxSaveContactWarmStartState (w, buffer);
+}
+
+int dWorldCheckContactWarmStartState (dWorldID w, dSpaceID space,
+                                      const void *buffer, size_t size)
+{
+  dAASSERT(w && space && buffer);
+  return dxCheckContactWarmStartState (w, space, buffer, size);
+}
+
+int dWorldRestoreContactWarmStartState (dWorldID w, dSpaceID space,
+                                        const void *buffer, size_t size)
+{
+  dAASSERT(w && space && buffer);
+  if (!dxCheckContactWarmStartState (w, space, buffer, size))
+    return 0;
+  dxRestoreContactWarmStartState (w, buffer);
+  return 1;
+}
+
 void dWorldSetQuickStepExtraFrictionIterations (dWorldID w, int iters)
 {
   dAASSERT(w);
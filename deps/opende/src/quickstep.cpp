@@ -30,6 +30,8 @@
 #include "config.h"
 #include "objects.h"
 #include "joints/joint.h"
+#include "joints/contact.h"
+#include "collision_kernel.h"
 #include "lcp.h"
 #include "util.h"
 
@@ -38,6 +40,8 @@
 #include <sys/types.h>
 #include <unistd.h>
 #endif
+#include <algorithm>
+#include <functional>
 #include "quickstep_util.h"
 #include "quickstep_cg_lcp.h"
 #include "quickstep_pgs_lcp.h"
@@ -651,3 +655,212 @@ size_t dxEstimateQuickStepMemoryRequirements (
 
   return res;
 }
+
+//***************************************************************************
+// contact warm starting
+
+static bool CompareContactWarmStart (const dxContactWarmStart &a,
+  const dxContactWarmStart &b)
+{
+  if (a.g1 != b.g1)
+    return std::less<dGeomID>()(a.g1, b.g1);
+  return std::less<dGeomID>()(a.g2, b.g2);
+}
+
+void dxLoadContactWarmStarts (dxWorld *world)
+{
+  std::vector<dxContactWarmStart> &warmstarts = world->contact_warm_starts;
+  const dReal distance = world->qs.contact_warm_start_distance;
+  if (warmstarts.empty() || distance <= 0 || world->qs.warm_start <= 0)
+    return;
+
+  const dReal maxdist2 = distance * distance;
+  dxContactWarmStart key;
+  for (dxJoint *j = world->firstjoint; j; j = (dxJoint*)j->next) {
+    if (j->type() != dJointTypeContact)
+      continue;
+
+    dxJointContact *contact = (dxJointContact*)j;
+    key.g1 = contact->contact.geom.g1;
+    key.g2 = contact->contact.geom.g2;
+    std::pair<std::vector<dxContactWarmStart>::iterator,
+      std::vector<dxContactWarmStart>::iterator> range =
+      std::equal_range(warmstarts.begin(), warmstarts.end(), key,
+        CompareContactWarmStart);
+
+    // the geoms usually touch at several points, take the closest
+    // contact of the previous step that no other contact has taken yet
+    dxContactWarmStart *closest = NULL;
+    dReal closestdist2 = maxdist2;
+    for (std::vector<dxContactWarmStart>::iterator it = range.first;
+         it != range.second; ++it) {
+      if (it->used)
+        continue;
+      dVector3 diff;
+      dSubtractVectors3(diff, it->pos, contact->contact.geom.pos);
+      dReal dist2 = dCalcVectorLengthSquare3(diff);
+      if (dist2 <= closestdist2) {
+        closest = &*it;
+        closestdist2 = dist2;
+      }
+    }
+
+    if (closest) {
+      closest->used = true;
+      memcpy (j->lambda, closest->lambda, 6 * sizeof(dReal));
+      memcpy (j->lambda_erp, closest->lambda_erp, 6 * sizeof(dReal));
+    }
+  }
+}
+
+// point the geoms of the warm starts back to the world, so that destroying
+// one of them removes its warm starts
+static void dxLinkContactWarmStarts (dxWorld *world)
+{
+  std::vector<dxContactWarmStart> &warmstarts = world->contact_warm_starts;
+  for (std::vector<dxContactWarmStart>::iterator it = warmstarts.begin();
+       it != warmstarts.end(); ++it) {
+    if (it->g1) it->g1->warm_start_world = world;
+    if (it->g2) it->g2->warm_start_world = world;
+  }
+}
+
+void dxClearContactWarmStarts (dxWorld *world)
+{
+  std::vector<dxContactWarmStart> &warmstarts = world->contact_warm_starts;
+  for (std::vector<dxContactWarmStart>::iterator it = warmstarts.begin();
+       it != warmstarts.end(); ++it) {
+    if (it->g1) it->g1->warm_start_world = 0;
+    if (it->g2) it->g2->warm_start_world = 0;
+  }
+  warmstarts.clear();
+}
+
+void dxRemoveContactWarmStarts (dxWorld *world, dxGeom *geom)
+{
+  // compacting in place keeps the sort order
+  std::vector<dxContactWarmStart> &warmstarts = world->contact_warm_starts;
+  size_t count = 0;
+  for (size_t i = 0; i < warmstarts.size(); ++i) {
+    dxContactWarmStart &warmstart = warmstarts[i];
+    if (warmstart.g1 != geom && warmstart.g2 != geom) {
+      warmstarts[count++] = warmstart;
+      continue;
+    }
+    // the other geom may have no warm start left
+    if (warmstart.g1) warmstart.g1->warm_start_world = 0;
+    if (warmstart.g2) warmstart.g2->warm_start_world = 0;
+  }
+  warmstarts.resize(count);
+  geom->warm_start_world = 0;
+  dxLinkContactWarmStarts (world);
+}
+
+void dxSaveContactWarmStarts (dxWorld *world)
+{
+  std::vector<dxContactWarmStart> &warmstarts = world->contact_warm_starts;
+  dxClearContactWarmStarts (world);
+  if (world->qs.contact_warm_start_distance <= 0 || world->qs.warm_start <= 0)
+    return;
+
+  dxContactWarmStart warmstart;
+  warmstart.used = false;
+  for (dxJoint *j = world->firstjoint; j; j = (dxJoint*)j->next) {
+    if (j->type() != dJointTypeContact)
+      continue;
+
+    dxJointContact *contact = (dxJointContact*)j;
+    warmstart.g1 = contact->contact.geom.g1;
+    warmstart.g2 = contact->contact.geom.g2;
+    dCopyVector3(warmstart.pos, contact->contact.geom.pos);
+    memcpy (warmstart.lambda, j->lambda, 6 * sizeof(dReal));
+    memcpy (warmstart.lambda_erp, j->lambda_erp, 6 * sizeof(dReal));
+    warmstarts.push_back(warmstart);
+  }
+
+  std::sort(warmstarts.begin(), warmstarts.end(), CompareContactWarmStart);
+  dxLinkContactWarmStarts (world);
+}
+
+// the state is the number of warm starts followed by the warm starts, in
+// their sorted order
+
+size_t dxContactWarmStartStateSize (dxWorld *world)
+{
+  return sizeof(int) +
+    world->contact_warm_starts.size() * sizeof(dxContactWarmStart);
+}
+
+void dxSaveContactWarmStartState (dxWorld *world, void *buffer)
+{
+  // the buffer may not be aligned
+  const std::vector<dxContactWarmStart> &warmstarts =
+    world->contact_warm_starts;
+  int count = (int) warmstarts.size();
+  char *data = (char*) buffer;
+  memcpy (data, &count, sizeof(int));
+  if (count > 0)
+    memcpy (data + sizeof(int), &warmstarts[0],
+      count * sizeof(dxContactWarmStart));
+}
+
+// the geoms of a space and of its sub-spaces
+static void collectSpaceGeoms (dxSpace *space, std::vector<dxGeom*> &geoms)
+{
+  const int count = dSpaceGetNumGeoms (space);
+  for (int i = 0; i < count; ++i) {
+    dxGeom *g = dSpaceGetGeom (space, i);
+    geoms.push_back(g);
+    if (dGeomIsSpace (g))
+      collectSpaceGeoms ((dxSpace*) g, geoms);
+  }
+}
+
+int dxCheckContactWarmStartState (dxWorld *world, dxSpace *space,
+                                  const void *buffer, size_t size)
+{
+  (void) world;
+  const char *data = (const char*) buffer;
+  int count;
+  if (size < sizeof(int))
+    return 0;
+  memcpy (&count, data, sizeof(int));
+  if (count < 0 || size != sizeof(int) + count * sizeof(dxContactWarmStart))
+    return 0;
+
+  // every geom must still be in the space, the geoms the warm starts
+  // referred to may have been destroyed since
+  std::vector<dxGeom*> geoms;
+  collectSpaceGeoms (space, geoms);
+  std::sort(geoms.begin(), geoms.end());
+
+  dxContactWarmStart warmstart;
+  for (int i = 0; i < count; ++i) {
+    memcpy (&warmstart, data + sizeof(int) + i * sizeof(dxContactWarmStart),
+      sizeof(dxContactWarmStart));
+    if ((warmstart.g1 && !std::binary_search(geoms.begin(), geoms.end(),
+           warmstart.g1)) ||
+        (warmstart.g2 && !std::binary_search(geoms.begin(), geoms.end(),
+           warmstart.g2)))
+      return 0;
+  }
+  return 1;
+}
+
+void dxRestoreContactWarmStartState (dxWorld *world, const void *buffer)
+{
+  dxClearContactWarmStarts (world);
+
+  const char *data = (const char*) buffer;
+  int count;
+  memcpy (&count, data, sizeof(int));
+  std::vector<dxContactWarmStart> &warmstarts = world->contact_warm_starts;
+  warmstarts.resize(count);
+  if (count > 0)
+    memcpy (&warmstarts[0], data + sizeof(int),
+      count * sizeof(dxContactWarmStart));
+  for (int i = 0; i < count; ++i)
+    warmstarts[i].used = false;
+
+  dxLinkContactWarmStarts (world);
+}
@@ -32,5 +32,32 @@ void dxQuickStepper (dxWorldProcessContext *context,
         dxWorld *world, dxBody * const *body, int nb,
 		    dxJoint * const *_joint, int _nj, dReal stepsize);
 
+// warm start the contact joints of the world from the impulses of the
+// contacts of the previous step that are close enough
+void dxLoadContactWarmStarts (dxWorld *world);
+
+// keep the impulses of the contact joints of the world for the next step
+void dxSaveContactWarmStarts (dxWorld *world);
+
+// forget the impulses kept by dxSaveContactWarmStarts
+void dxClearContactWarmStarts (dxWorld *world);
+
+// forget the impulses kept for the contacts of a geom being destroyed
+void dxRemoveContactWarmStarts (dxWorld *world, dxGeom *geom);
+
+// size of the buffer that holds the kept impulses
+size_t dxContactWarmStartStateSize (dxWorld *world);
+
+// copy the kept impulses to a buffer
+void dxSaveContactWarmStartState (dxWorld *world, void *buffer);
+
+// check that a buffer holds impulses kept for geoms of the space
+int dxCheckContactWarmStartState (dxWorld *world, dxSpace *space,
+                                  const void *buffer, size_t size);
+
+// replace the kept impulses with a buffer checked by
+// dxCheckContactWarmStartState
+void dxRestoreContactWarmStartState (dxWorld *world, const void *buffer);
+
 
 #endif
@@ -205,8 +205,18 @@ static void* ComputeRows(void *p)
   dRealMutablePtr cforce_ptr2;
   int total_iterations = precon_iterations + num_iterations +
     friction_iterations;
+  int iterations_done = 0;
+
+  // islands are solved in parallel and share qs, keep the errors of this
+  // island local and only publish them once done
+  dReal iter_rms_dlambda[4];
+  dReal iter_rms_residual[4];
+  int iter_num_contacts = 0;
+  dSetZero(iter_rms_dlambda, 4);
+  dSetZero(iter_rms_residual, 4);
   for (int iteration = 0; iteration < total_iterations; ++iteration)
   {
+    ++iterations_done;
     // reset rms_dlambda at beginning of iteration
     rms_dlambda[2] = 0;
     // reset rms_error at beginning of iteration
@@ -828,10 +838,10 @@ static void* ComputeRows(void *p)
       dlambda_total_mean = (rms_dlambda[0] + rms_dlambda[1] + rms_dlambda[2])/
         ((dReal)(m_rms_dlambda[0] + m_rms_dlambda[1] + m_rms_dlambda[2]));
 
-    qs->rms_dlambda[0] = sqrt(dlambda_bilateral_mean);
-    qs->rms_dlambda[1] = sqrt(dlambda_contact_normal_mean);
-    qs->rms_dlambda[2] = sqrt(dlambda_contact_friction_mean);
-    qs->rms_dlambda[3] = sqrt(dlambda_total_mean);
+    iter_rms_dlambda[0] = sqrt(dlambda_bilateral_mean);
+    iter_rms_dlambda[1] = sqrt(dlambda_contact_normal_mean);
+    iter_rms_dlambda[2] = sqrt(dlambda_contact_friction_mean);
+    iter_rms_dlambda[3] = sqrt(dlambda_total_mean);
 
     dReal residual_bilateral_mean = 0.0;
     dReal residual_contact_normal_mean = 0.0;
@@ -848,11 +858,11 @@ static void* ComputeRows(void *p)
       residual_total_mean = (rms_error[0] + rms_error[1] + rms_error[2])/
         ((dReal)(m_rms_dlambda[0] + m_rms_dlambda[1] + m_rms_dlambda[2]));
 
-    qs->rms_constraint_residual[0] = sqrt(residual_bilateral_mean);
-    qs->rms_constraint_residual[1] = sqrt(residual_contact_normal_mean);
-    qs->rms_constraint_residual[2] = sqrt(residual_contact_friction_mean);
-    qs->rms_constraint_residual[3] = sqrt(residual_total_mean);
-    qs->num_contacts = m_rms_dlambda[1];
+    iter_rms_residual[0] = sqrt(residual_bilateral_mean);
+    iter_rms_residual[1] = sqrt(residual_contact_normal_mean);
+    iter_rms_residual[2] = sqrt(residual_contact_friction_mean);
+    iter_rms_residual[3] = sqrt(residual_total_mean);
+    iter_num_contacts = m_rms_dlambda[1];
 
 #ifdef HDF5_INSTRUMENT
     errors[iteration] = residual_total_mean;
@@ -868,14 +878,14 @@ static void* ComputeRows(void *p)
     //  for (int i=startRow+1; i<startRow+nRows; i++)
     //    printf(" %10d;",order[i].index);
     //  printf("\n%f %f %f\n",
-    //    qs->rms_dlambda[0],qs->rms_dlambda[1],qs->rms_dlambda[2]);
+    //    iter_rms_dlambda[0],iter_rms_dlambda[1],iter_rms_dlambda[2]);
     //}
 
 #ifdef SHOW_CONVERGENCE
     /* uncomment for convergence information per row sweep (LOTS OF DATA!)
     printf("MONITOR: thread(%d) iter(%d) rms(%20.18f %20.18f %20.18)f\n",
       thread_id, iteration,
-      qs->rms_dlambda[0], qs->rms_dlambda[1], qs->rms_dlambda[2]);
+      iter_rms_dlambda[0], iter_rms_dlambda[1], iter_rms_dlambda[2]);
 
     // print lambda
     for (int i=startRow; i<startRow+nRows; i++)
@@ -886,14 +896,14 @@ static void* ComputeRows(void *p)
 
     // option to stop when tolerance has been met
     if (iteration >= precon_iterations &&
-        qs->rms_constraint_residual[3] < pgs_lcp_tolerance)
+        iter_rms_residual[3] < pgs_lcp_tolerance)
     {
       #ifdef DEBUG_CONVERGENCE_TOLERANCE
         printf("CONVERGED: id: %d steps: %d,"
                " rms(%20.18f + %20.18f + %20.18f) < tol(%20.18f)\n",
           thread_id, iteration,
-          qs->rms_constraint_residual[0], qs->rms_constraint_residual[1],
-          qs->rms_constraint_residual[2],
+          iter_rms_residual[0], iter_rms_residual[1],
+          iter_rms_residual[2],
           pgs_lcp_tolerance);
       #endif
       // tolerance satisfied, stop iterating
@@ -905,13 +915,21 @@ static void* ComputeRows(void *p)
         printf("WARNING: id: %d did not converge in %d steps,"
                " rms(%20.18f + %20.18f + %20.18f) > tol(%20.18f)\n",
           thread_id, num_iterations,
-          qs->rms_constraint_residual[0], qs->rms_constraint_residual[1],
-          qs->rms_constraint_residual[2],
+          iter_rms_residual[0], iter_rms_residual[1],
+          iter_rms_residual[2],
           pgs_lcp_tolerance);
       #endif
     }
   } // end of for loop on iterations
 
+  memcpy(qs->rms_dlambda, iter_rms_dlambda, 4 * sizeof(dReal));
+  memcpy(qs->rms_constraint_residual, iter_rms_residual, 4 * sizeof(dReal));
+  qs->num_contacts = iter_num_contacts;
+
+  // the position correction thread sweeps the same rows, count them once
+  if (!position_correction_thread)
+    qs->iteration_count += iterations_done;
+
 #ifdef SHOW_CONVERGENCE
   // show starting lambda
   printf("final lambdas: [");
@@ -25,6 +25,7 @@
 #include "objects.h"
 #include "joints/joint.h"
 #include "util.h"
+#include <algorithm>
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/bind/bind.hpp>
 #include <gazebo/ode/timer.h>
@@ -593,6 +594,25 @@ void dxProcessOneIsland(dxWorldProcessContext *island_context, dxWorld *world, d
 #endif
 }
 
+// estimate of the cost of stepping an island. the solver sweeps every
+// constraint row a fixed number of times, and updates every body once.
+static size_t EstimateIslandCost(dxBody *const *, int bcount,
+                                 dxJoint *const *jointstart, int jcount)
+{
+  size_t rows = 0;
+  dxJoint::SureMaxInfo info;
+  for (int i = 0; i < jcount; ++i) {
+    jointstart[i]->getSureMaxInfo(&info);
+    rows += info.max_m;
+  }
+  return rows + bcount;
+}
+
+static bool CompareIslandCost(const dxIslandTask &a, const dxIslandTask &b)
+{
+  return a.cost > b.cost;
+}
+
 void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
 {
   const int sizeelements = 2;
@@ -609,12 +629,34 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
   dxJoint *const *joint;
   context->RetrievePreallocations(islandcount, islandsizes, body, joint, islandreqs);
 
-  dxBody *const *bodystart = body;
-  dxJoint *const *jointstart = joint;
-
   IFTIMING(dTimerStart("preprocessing islands"));
-  int island_index = 0;
-  int const *const sizesend = islandsizes + islandcount * sizeelements;
+  const bool threaded = world->threadpool && world->threadpool->size() > 0;
+
+  std::vector<dxIslandTask> &tasks = world->island_tasks;
+  tasks.resize(islandcount);
+  {
+    int bodyoffset = 0;
+    int jointoffset = 0;
+    int const *sizescurr = islandsizes;
+    for (int i = 0; i < islandcount; ++i, sizescurr += sizeelements) {
+      dxIslandTask &task = tasks[i];
+      task.index = i;
+      task.bodyoffset = bodyoffset;
+      task.bcount = sizescurr[0];
+      task.jointoffset = jointoffset;
+      task.jcount = sizescurr[1];
+      task.cost = threaded ? EstimateIslandCost(body + bodyoffset,
+        task.bcount, joint + jointoffset, task.jcount) : 0;
+      bodyoffset += task.bcount;
+      jointoffset += task.jcount;
+    }
+  }
+
+  // the pool threads take the islands in the order they are scheduled.
+  // schedule the most expensive islands first, so the cheap ones fill
+  // in around them instead of one big island finishing last.
+  if (threaded && islandcount > 1)
+    std::stable_sort(tasks.begin(), tasks.end(), CompareIslandCost);
 
 #ifdef REPORT_THREAD_TIMING
   struct timeval tv;
@@ -624,12 +666,15 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
   printf(">>>>>>>>>>>> start island spawn threads at time %f\n",cur_time);
 #endif
 
-  for (int const *sizescurr = islandsizes; sizescurr != sizesend; sizescurr += sizeelements) {
-    int bcount = sizescurr[0];
-    int jcount = sizescurr[1];
+  for (int i = 0; i < islandcount; ++i) {
+    const dxIslandTask &task = tasks[i];
+    dxBody *const *bodystart = body + task.bodyoffset;
+    int bcount = task.bcount;
+    dxJoint *const *jointstart = joint + task.jointoffset;
+    int jcount = task.jcount;
 
     // get working memory for each island
-    dxStepWorkingMemory *island_wmem = world->island_wmems[island_index++];
+    dxStepWorkingMemory *island_wmem = world->island_wmems[task.index];
     dIASSERT(island_wmem != NULL);
     dxWorldProcessContext *island_context = island_wmem->GetWorldProcessingContext();
 
@@ -637,20 +682,17 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
 #ifdef USE_TPISLAND
     IFTIMING(dTimerNow("scheduling island"));
     //printf("debug opende tp %d\n",world->threadpool->size());
-    if (world->threadpool && world->threadpool->size() > 0)
+    if (threaded)
       world->threadpool->schedule(boost::bind(dxProcessOneIsland,island_context, world, stepsize, stepper,bodystart, bcount, jointstart, jcount));
     else //automatically skip threadpool if only 1 thread allocated
       dxProcessOneIsland(island_context, world, stepsize, stepper,bodystart, bcount, jointstart, jcount);
 #else
     dxProcessOneIsland(island_context, world, stepsize, stepper,bodystart, bcount, jointstart, jcount);
 #endif
-
-    bodystart += bcount;
-    jointstart += jcount;
   }
 #ifdef USE_TPISLAND
   IFTIMING(dTimerNow("islands wait"));
-  if (world->threadpool && world->threadpool->size() > 0)
+  if (threaded)
     world->threadpool->wait();
 #endif
   IFTIMING(dTimerEnd());
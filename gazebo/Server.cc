@@ -53,6 +53,7 @@
 #include "gazebo/common/ModelDatabase.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/ProfileTimeline.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Events.hh"
@@ -134,6 +135,9 @@ namespace gazebo
 
     /// \brief Set whether to lockstep physics and rendering
     bool lockstep = false;
+
+    /// \brief Set whether to update models in parallel
+    bool parallelModelUpdate = false;
   };
 }
 
@@ -184,12 +188,13 @@ bool Server::ParseArgs(int _argc, char **_argv)
     ("help,h", "Produce this help message.")
     ("pause,u", "Start the server in a paused state.")
     ("lockstep", "Lockstep simulation so sensor update rates are respected.")
+    ("parallel_model_update", "Update independent models in parallel.")
     ("physics,e", po::value<std::string>(),
      "Specify a physics engine (ode|bullet|dart|simbody).")
     ("play,p", po::value<std::string>(), "Play a log file.")
     ("record,r", "Record state data.")
     ("record_encoding", po::value<std::string>()->default_value("zlib"),
-     "Compression encoding format for log data (zlib|bz2|txt).")
+     "Compression encoding format for log data (zlib|bz2|txt|bin).")
     ("record_path", po::value<std::string>()->default_value(""),
      "Absolute path in which to store state data")
     ("record_period", po::value<double>()->default_value(-1),
@@ -323,6 +328,11 @@ bool Server::ParseArgs(int _argc, char **_argv)
   }
   rendering::set_lockstep_enabled(this->dataPtr->lockstep);
 
+  if (this->dataPtr->vm.count("parallel_model_update"))
+  {
+    this->dataPtr->parallelModelUpdate = true;
+  }
+
   if (!this->PreLoad())
   {
     gzerr << "Unable to load gazebo\n";
@@ -557,6 +567,9 @@ bool Server::LoadImpl(sdf::ElementPtr _elem,
     {
       gzthrow("Failed to load the World\n"  << e);
     }
+
+    if (this->dataPtr->parallelModelUpdate)
+      world->SetParallelModelUpdate(true);
   }
 
   this->dataPtr->node = transport::NodePtr(new transport::Node());
@@ -675,6 +688,7 @@ void Server::Run()
   this->dataPtr->initialized = true;
 
   IGN_PROFILE_THREAD_NAME("gzserver");
+  GZ_PROFILE_THREAD_NAME("gzserver");
   // Stay on this loop until Gazebo needs to be shut down
   // The server and sensor manager outlive worlds
   while (!this->dataPtr->stop)
@@ -18,9 +18,12 @@
 #include <curl/curl.h>
 #include <tinyxml.h>
 #include <math.h>
+#include <algorithm>
 #include <sstream>
 #include <set>
 #include <memory>
+#include <unordered_map>
+#include <utility>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/unordered_map.hpp>
@@ -81,6 +84,192 @@ struct Vector2dHash : unary_function<const ignition::math::Vector2d,
   }
 };
 
+/////////////////////////////////////////////////
+/// \brief Powers of ten that are exactly representable as a double.
+static const double kExactPowersOfTen[] =
+{
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/////////////////////////////////////////////////
+/// \brief Check for the whitespace that separates COLLADA list values.
+/// \param[in] _c Character to check.
+/// \return True if _c is whitespace.
+static inline bool IsListSpace(const char _c)
+{
+  return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\r';
+}
+
+/////////////////////////////////////////////////
+/// \brief Check for a decimal digit, independently of the locale.
+/// \param[in] _c Character to check.
+/// \return True if _c is a digit.
+static inline bool IsDigit(const char _c)
+{
+  return _c >= '0' && _c <= '9';
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse a plain decimal number, such as "-1.25e-3". The result is
+/// exact, because the digits are gathered in an integer that fits a double
+/// and scaled by a single exactly representable power of ten.
+/// \param[in,out] _str Start of the number. On success it's moved past
+/// the number.
+/// \param[out] _value Parsed value.
+/// \return False if the token can't be parsed exactly this way, in which
+/// case the caller should fall back to a complete parser.
+static bool ParseFastFloat(const char *&_str, double &_value)
+{
+  const char *s = _str;
+  const bool negative = *s == '-';
+  if (*s == '-' || *s == '+')
+    ++s;
+
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int exponent = 0;
+  bool hasDigits = false;
+
+  for (; IsDigit(*s); ++s)
+  {
+    hasDigits = true;
+    if (mantissa > 0 || *s != '0')
+    {
+      if (++digits > 19)
+        return false;
+      mantissa = mantissa * 10 + (*s - '0');
+    }
+  }
+
+  if (*s == '.')
+  {
+    for (++s; IsDigit(*s); ++s)
+    {
+      hasDigits = true;
+      if (mantissa > 0 || *s != '0')
+      {
+        if (++digits > 19)
+          return false;
+        mantissa = mantissa * 10 + (*s - '0');
+      }
+      --exponent;
+    }
+  }
+
+  if (!hasDigits)
+    return false;
+
+  if (*s == 'e' || *s == 'E')
+  {
+    ++s;
+    const bool negativeExp = *s == '-';
+    if (*s == '-' || *s == '+')
+      ++s;
+    if (!IsDigit(*s))
+      return false;
+
+    int exp = 0;
+    for (; IsDigit(*s); ++s)
+    {
+      if (exp < 10000)
+        exp = exp * 10 + (*s - '0');
+    }
+    exponent += negativeExp ? -exp : exp;
+  }
+
+  // The token must end here
+  if (*s != '\0' && !IsListSpace(*s))
+    return false;
+
+  if (mantissa > (uint64_t(1) << 53))
+    return false;
+
+  double value = static_cast<double>(mantissa);
+  if (mantissa != 0)
+  {
+    if (exponent < -22 || exponent > 22)
+      return false;
+    if (exponent < 0)
+      value /= kExactPowersOfTen[-exponent];
+    else
+      value *= kExactPowersOfTen[exponent];
+  }
+
+  _value = negative ? -value : value;
+  _str = s;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse a whitespace separated list of floating point values, such
+/// as the content of a <float_array>.
+/// \param[in] _str List to parse.
+/// \param[out] _values The parsed values are appended to this vector.
+static void ParseFloats(const char *_str, std::vector<double> &_values)
+{
+  const char *s = _str;
+  while (true)
+  {
+    while (IsListSpace(*s))
+      ++s;
+    if (*s == '\0')
+      break;
+
+    double value;
+    if (!ParseFastFloat(s, value))
+    {
+      // Uncommon token, such as "NaN", or a number with too many digits
+      const char *end = s;
+      while (*end != '\0' && !IsListSpace(*end))
+        ++end;
+      value = ignition::math::parseFloat(std::string(s, end));
+      s = end;
+    }
+    _values.push_back(value);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse a whitespace separated list of integers, such as the
+/// content of a <p> or <vcount> element.
+/// \param[in] _str List to parse.
+/// \param[out] _values The parsed values are appended to this vector.
+static void ParseInts(const char *_str, std::vector<int> &_values)
+{
+  const char *s = _str;
+  while (true)
+  {
+    while (IsListSpace(*s))
+      ++s;
+    if (*s == '\0')
+      break;
+
+    const char *start = s;
+    const bool negative = *s == '-';
+    if (*s == '-' || *s == '+')
+      ++s;
+
+    int value = 0;
+    int digits = 0;
+    for (; IsDigit(*s) && digits < 9; ++s, ++digits)
+      value = value * 10 + (*s - '0');
+
+    if (digits == 0 || (*s != '\0' && !IsListSpace(*s)))
+    {
+      // Uncommon token, such as a very large or invalid number
+      while (*s != '\0' && !IsListSpace(*s))
+        ++s;
+      value = ignition::math::parseInt(std::string(start, s));
+    }
+    else if (negative)
+    {
+      value = -value;
+    }
+    _values.push_back(value);
+  }
+}
+
 //////////////////////////////////////////////////
   ColladaLoader::ColladaLoader()
 : MeshLoader(), dataPtr(new ColladaLoaderPrivate)
@@ -121,6 +310,8 @@ Mesh *ColladaLoader::Load(const std::string &_filename)
   this->dataPtr->colladaXml = xmlDoc.FirstChildElement("COLLADA");
   if (!this->dataPtr->colladaXml)
     gzerr << "Missing COLLADA tag\n";
+  else
+    this->IndexElementIds();
 
   if (std::string(this->dataPtr->colladaXml->Attribute("version")) != "1.4.0" &&
       std::string(this->dataPtr->colladaXml->Attribute("version")) != "1.4.1")
@@ -149,9 +340,45 @@ Mesh *ColladaLoader::Load(const std::string &_filename)
   if (mesh->HasSkeleton())
     mesh->GetSkeleton()->Scale(this->dataPtr->meter);
 
+  // The indexed elements are owned by xmlDoc
+  this->dataPtr->elementIds.clear();
+  this->dataPtr->colladaXml = nullptr;
+
   return mesh;
 }
 
+/////////////////////////////////////////////////
+void ColladaLoader::IndexElementIds()
+{
+  this->dataPtr->elementIds.clear();
+
+  // Walk the document in the same pre-order as GetElementId, so that the
+  // first element with an id or sid wins when it isn't unique.
+  std::vector<TiXmlElement *> stack;
+  stack.push_back(this->dataPtr->colladaXml);
+  while (!stack.empty())
+  {
+    TiXmlElement *elem = stack.back();
+    stack.pop_back();
+
+    const char *id = elem->Attribute("id");
+    if (id)
+      this->dataPtr->elementIds.emplace(id, elem);
+    const char *sid = elem->Attribute("sid");
+    if (sid)
+      this->dataPtr->elementIds.emplace(sid, elem);
+
+    // Push the children in reverse, so that the first one is visited first
+    const size_t first = stack.size();
+    for (TiXmlElement *child = elem->FirstChildElement(); child;
+         child = child->NextSiblingElement())
+    {
+      stack.push_back(child);
+    }
+    std::reverse(stack.begin() + first, stack.end());
+  }
+}
+
 /////////////////////////////////////////////////
 void ColladaLoader::LoadScene(Mesh *_mesh)
 {
@@ -499,37 +726,21 @@ void ColladaLoader::LoadController(TiXmlElement *_contrXml,
 
   TiXmlElement *weightsXml = this->GetElementId("source", weightsURL);
 
-  std::string wString = weightsXml->FirstChildElement("float_array")->GetText();
-  std::vector<std::string> wStrs;
-  boost::split(wStrs, wString, boost::is_any_of(" \t"));
-
-  std::vector<float> weights;
-  for (unsigned int i = 0; i < wStrs.size(); ++i)
-    weights.push_back(ignition::math::parseFloat(wStrs[i]));
-
-  std::string cString = vertWeightsXml->FirstChildElement("vcount")->GetText();
-  std::string vString = vertWeightsXml->FirstChildElement("v")->GetText();
-  std::vector<std::string> vCountStrs;
-  std::vector<std::string> vStrs;
-
-  boost::split(vCountStrs, cString, boost::is_any_of(" \t"));
-  boost::split(vStrs, vString, boost::is_any_of(" \t"));
-
-  std::vector<unsigned int> vCount;
-  std::vector<unsigned int> v;
+  std::vector<double> weights;
+  ParseFloats(weightsXml->FirstChildElement("float_array")->GetText(),
+      weights);
 
-  for (unsigned int i = 0; i < vCountStrs.size(); ++i)
-    vCount.push_back(ignition::math::parseInt(vCountStrs[i]));
-
-  for (unsigned int i = 0; i < vStrs.size(); ++i)
-    v.push_back(ignition::math::parseInt(vStrs[i]));
+  std::vector<int> vCount;
+  std::vector<int> v;
+  ParseInts(vertWeightsXml->FirstChildElement("vcount")->GetText(), vCount);
+  ParseInts(vertWeightsXml->FirstChildElement("v")->GetText(), v);
 
   skeleton->SetNumVertAttached(vCount.size());
 
   unsigned int vIndex = 0;
   for (unsigned int i = 0; i < vCount.size(); ++i)
   {
-    for (unsigned int j = 0; j < vCount[i]; ++j)
+    for (int j = 0; j < vCount[i]; ++j)
     {
       skeleton->AddVertNodeWeight(i, joints[v[vIndex + jOffset]],
                                     weights[v[vIndex + wOffset]]);
@@ -916,6 +1127,14 @@ TiXmlElement *ColladaLoader::GetElementId(TiXmlElement *_parent,
   if (id.length() > 0 && id[0] == '#')
     id.erase(0, 1);
 
+  // Look up ids in the whole document with the index built by Load
+  if (!id.empty() && _parent == this->dataPtr->colladaXml &&
+      !this->dataPtr->elementIds.empty())
+  {
+    auto iter = this->dataPtr->elementIds.find(id);
+    return iter != this->dataPtr->elementIds.end() ? iter->second : nullptr;
+  }
+
   if ((id.empty() && _parent->Value() == _name) ||
       (_parent->Attribute("id") && _parent->Attribute("id") == id) ||
       (_parent->Attribute("sid") && _parent->Attribute("sid") == id))
@@ -1033,30 +1252,25 @@ void ColladaLoader::LoadPositions(const std::string &_id,
 
     return;
   }
-  std::string valueStr = floatArrayXml->GetText();
+  std::vector<double> coords;
+  ParseFloats(floatArrayXml->GetText(), coords);
 
   boost::unordered_map<ignition::math::Vector3d,
     unsigned int, Vector3Hash> unique;
+  unique.reserve(coords.size() / 3);
+  _values.reserve(_values.size() + coords.size() / 3);
 
-  std::vector<std::string> strs;
-  std::vector<std::string>::iterator iter, end;
-  boost::split(strs, valueStr, boost::is_any_of(" \t"));
-
-  end = strs.end();
-  for (iter = strs.begin(); iter != end; iter += 3)
+  for (size_t i = 0; i + 2 < coords.size(); i += 3)
   {
-    ignition::math::Vector3d vec(ignition::math::parseFloat(*iter),
-        ignition::math::parseFloat(*(iter+1)),
-        ignition::math::parseFloat(*(iter+2)));
+    ignition::math::Vector3d vec(coords[i], coords[i+1], coords[i+2]);
 
     vec = _transform * vec;
     _values.push_back(vec);
 
     // create a map of duplicate indices
-    if (unique.find(vec) != unique.end())
-      _duplicates[_values.size()-1] = unique[vec];
-    else
-      unique[vec] = _values.size()-1;
+    auto inserted = unique.emplace(vec, _values.size()-1);
+    if (!inserted.second)
+      _duplicates[_values.size()-1] = inserted.first->second;
   }
 
   this->dataPtr->positionDuplicateMap[_id] = _duplicates;
@@ -1116,28 +1330,26 @@ void ColladaLoader::LoadNormals(const std::string &_id,
     return;
   }
 
+  std::vector<double> coords;
+  ParseFloats(floatArrayXml->GetText(), coords);
+
   boost::unordered_map<ignition::math::Vector3d,
     unsigned int, Vector3Hash> unique;
+  unique.reserve(coords.size() / 3);
+  _values.reserve(_values.size() + coords.size() / 3);
 
-  std::string valueStr = floatArrayXml->GetText();
-  std::istringstream iss(valueStr);
-  do
+  for (size_t i = 0; i + 2 < coords.size(); i += 3)
   {
-    ignition::math::Vector3d vec;
-    iss >> vec.X() >> vec.Y() >> vec.Z();
-    if (iss)
-    {
-      vec = rotMat * vec;
-      vec.Normalize();
-      _values.push_back(vec);
+    ignition::math::Vector3d vec(coords[i], coords[i+1], coords[i+2]);
+    vec = rotMat * vec;
+    vec.Normalize();
+    _values.push_back(vec);
 
-      // create a map of duplicate indices
-      if (unique.find(vec) != unique.end())
-        _duplicates[_values.size()-1] = unique[vec];
-      else
-        unique[vec] = _values.size()-1;
-    }
-  } while (iss);
+    // create a map of duplicate indices
+    auto inserted = unique.emplace(vec, _values.size()-1);
+    if (!inserted.second)
+      _duplicates[_values.size()-1] = inserted.first->second;
+  }
 
   this->dataPtr->normalDuplicateMap[_id] = _duplicates;
   this->dataPtr->normalIds[_id] = _values;
@@ -1267,26 +1479,28 @@ void ColladaLoader::LoadTexCoords(const std::string &_id,
   boost::unordered_map<ignition::math::Vector2d,
     unsigned int, Vector2dHash> unique;
 
-  // Read the raw texture values, and split them on spaces.
-  std::string valueStr = floatArrayXml->GetText();
-  std::vector<std::string> values;
-  boost::split(values, valueStr, boost::is_any_of(" "));
+  // Read the raw texture values.
+  std::vector<double> values;
+  values.reserve(totCount);
+  ParseFloats(floatArrayXml->GetText(), values);
+  if (values.size() < static_cast<size_t>(totCount))
+  {
+    gzerr << "Error reading texture coordinates. Element with id[" << _id
+          << "] has fewer values than its count\n";
+    return;
+  }
 
   // Read in all the texture coordinates.
-  for (int i = 0; i < totCount; i += stride)
+  for (int i = 0; i + 1 < totCount; i += stride)
   {
     // We only handle 2D texture coordinates right now.
-    ignition::math::Vector2d vec(boost::lexical_cast<double>(values[i]),
-          1.0 - boost::lexical_cast<double>(values[i+1]));
+    ignition::math::Vector2d vec(values[i], 1.0 - values[i+1]);
     _values.push_back(vec);
 
     // create a map of duplicate indices
-    if (unique.find(vec) != unique.end())
-    {
-      _duplicates[_values.size()-1] = unique[vec];
-    }
-    else
-      unique[vec] = _values.size()-1;
+    auto inserted = unique.emplace(vec, _values.size()-1);
+    if (!inserted.second)
+      _duplicates[_values.size()-1] = inserted.first->second;
   }
 
   this->dataPtr->texcoordDuplicateMap[_id] = _duplicates;
@@ -1619,32 +1833,29 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
   // break poly into triangles
   // if vcount >= 4, anchor around 0 (note this is bad for concave elements)
   //   e.g. if vcount = 4, break into triangle 1: [0,1,2], triangle 2: [0,2,3]
-  std::vector<std::string> vcountStrs;
   TiXmlElement *vcountXml = _polylistXml->FirstChildElement("vcount");
-  std::string vcountStr = vcountXml->GetText();
-  boost::split(vcountStrs, vcountStr, boost::is_any_of(" \t"));
   std::vector<int> vcounts;
-  for (unsigned int j = 0; j < vcountStrs.size(); ++j)
-    vcounts.push_back(ignition::math::parseInt(vcountStrs[j]));
+  ParseInts(vcountXml->GetText(), vcounts);
 
   // read p
   TiXmlElement *pXml = _polylistXml->FirstChildElement("p");
-  std::string pStr = pXml->GetText();
+  std::vector<int> pValues;
+  ParseInts(pXml->GetText(), pValues);
 
   // vertexIndexMap is a map of collada vertex index to Gazebo submesh vertex
   // indices, used for identifying vertices that can be shared.
-  std::map<unsigned int, std::vector<GeometryIndices> > vertexIndexMap;
+  std::unordered_map<unsigned int, std::vector<GeometryIndices> >
+    vertexIndexMap;
+  vertexIndexMap.reserve(verts.size());
   unsigned int *values = new unsigned int[inputSize];
   memset(values, 0, inputSize);
 
-  std::vector<std::string> strs;
-  boost::split(strs, pStr, boost::is_any_of(" \t"));
-  std::vector<std::string>::iterator strsIter = strs.begin();
+  std::vector<int>::const_iterator pIter = pValues.begin();
   for (unsigned int l = 0; l < vcounts.size(); ++l)
   {
     // put us at the beginning of the polygon list
     if (l > 0)
-      strsIter += inputSize*vcounts[l-1];
+      pIter += inputSize*vcounts[l-1];
 
     for (unsigned int k = 2; k < (unsigned int)vcounts[l]; ++k)
     {
@@ -1665,7 +1876,7 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
 
         for (unsigned int i = 0; i < inputSize; ++i)
         {
-          values[i] = ignition::math::parseInt(strsIter[triangle_index+i]);
+          values[i] = pIter[triangle_index+i];
           /*gzerr << "debug parsing "
                 << " poly-i[" << l
                 << "] tri-end-index[" << k
@@ -1691,7 +1902,8 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
             daeVertIndex = positionDupMap[daeVertIndex];
 
           // if the vertex index has not been previously added then just add it.
-          if (vertexIndexMap.find(daeVertIndex) == vertexIndexMap.end())
+          auto vertexIndexIter = vertexIndexMap.find(daeVertIndex);
+          if (vertexIndexIter == vertexIndexMap.end())
           {
             addIndex = true;
           }
@@ -1701,8 +1913,8 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
             // the same normal and texcoord index values
             bool toDuplicate = true;
             unsigned int reuseIndex = 0;
-            std::vector<GeometryIndices> inputValues =
-                vertexIndexMap[daeVertIndex];
+            const std::vector<GeometryIndices> &inputValues =
+                vertexIndexIter->second;
 
             for (unsigned int i = 0; i < inputValues.size(); ++i)
             {
@@ -1965,7 +2177,8 @@ void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
 
     return;
   }
-  std::string pStr = pXml->GetText();
+  std::vector<int> pValues;
+  ParseInts(pXml->GetText(), pValues);
 
   // Collada format allows normals and texcoords to have their own set of
   // indices for more efficient storage of data but opengl only supports one
@@ -1975,17 +2188,17 @@ void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
 
   // vertexIndexMap is a map of collada vertex index to Gazebo submesh vertex
   // indices, used for identifying vertices that can be shared.
-  std::map<unsigned int, std::vector<GeometryIndices> > vertexIndexMap;
+  std::unordered_map<unsigned int, std::vector<GeometryIndices> >
+    vertexIndexMap;
+  vertexIndexMap.reserve(verts.size());
 
   std::vector<unsigned int> values(offsetSize);
-  std::vector<std::string> strs;
-
-  boost::split(strs, pStr, boost::is_any_of(" \t"));
 
-  for (unsigned int j = 0; j < strs.size(); j += offsetSize)
+  for (size_t j = 0; offsetSize > 0 && j + offsetSize <= pValues.size();
+       j += offsetSize)
   {
     for (unsigned int i = 0; i < offsetSize; ++i)
-      values.at(i) = ignition::math::parseInt(strs[j+i]);
+      values.at(i) = pValues[j+i];
 
     unsigned int daeVertIndex = 0;
     bool addIndex = !hasVertices;
@@ -2001,7 +2214,8 @@ void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
         daeVertIndex = positionDupMap[daeVertIndex];
 
       // if the vertex index has not been previously added then just add it.
-      if (vertexIndexMap.find(daeVertIndex) == vertexIndexMap.end())
+      auto vertexIndexIter = vertexIndexMap.find(daeVertIndex);
+      if (vertexIndexIter == vertexIndexMap.end())
       {
         addIndex = true;
       }
@@ -2011,7 +2225,8 @@ void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
         // same normal and texcoord index values
         bool toDuplicate = true;
         unsigned int reuseIndex = 0;
-        std::vector<GeometryIndices> inputValues = vertexIndexMap[daeVertIndex];
+        const std::vector<GeometryIndices> &inputValues =
+            vertexIndexIter->second;
 
         for (unsigned int i = 0; i < inputValues.size(); ++i)
         {
@@ -2140,21 +2355,16 @@ void ColladaLoader::LoadLines(TiXmlElement *_xml,
   this->LoadVertices(source, _transform, verts, norms);
 
   TiXmlElement *pXml = _xml->FirstChildElement("p");
-  std::string pStr = pXml->GetText();
-  std::istringstream iss(pStr);
+  std::vector<int> pValues;
+  ParseInts(pXml->GetText(), pValues);
 
-  do
+  for (size_t i = 0; i + 1 < pValues.size(); i += 2)
   {
-    int a, b;
-    iss >> a >> b;
-
-    if (!iss)
-      break;
-    subMesh->AddVertex(verts[a]);
+    subMesh->AddVertex(verts[pValues[i]]);
     subMesh->AddIndex(subMesh->GetVertexCount() - 1);
-    subMesh->AddVertex(verts[b]);
+    subMesh->AddVertex(verts[pValues[i+1]]);
     subMesh->AddIndex(subMesh->GetVertexCount() - 1);
-  } while (iss);
+  }
 
   _mesh->AddSubMesh(subMesh);
 }
@@ -100,6 +100,10 @@ namespace gazebo
       private: void LoadGeometry(TiXmlElement *_xml,
                    const ignition::math::Matrix4d &_transform, Mesh *_mesh);
 
+      /// \brief Index the elements of the loaded document by id and sid,
+      /// so that GetElementId doesn't search the whole document each time.
+      private: void IndexElementIds();
+
       /// \brief Get an XML element by ID
       /// \param[in] _parent The parent element
       /// \param[in] _name String name of the element
@@ -19,6 +19,7 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <ignition/math/Vector3.hh>
@@ -47,6 +48,9 @@ namespace gazebo
       /// \brief root xml element of COLLADA data
       public: TiXmlElement *colladaXml;
 
+      /// \brief Elements of the COLLADA data indexed by id and sid.
+      public: std::unordered_map<std::string, TiXmlElement *> elementIds;
+
       /// \brief directory of COLLADA file name
       public: std::string path;
 
@@ -15,12 +15,37 @@
  *
  */
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Event.hh"
 
 using namespace gazebo;
 using namespace event;
 
+/// \brief Groups of the connections of an event, see
+/// EventT::SignalGrouped.
+class ConnectionGroupTable
+{
+  /// \brief Group of each connection that has one, by connection id.
+  public: std::map<int, std::string> groups;
+
+  /// \brief Connections sorted by group, null when they must be sorted
+  /// again. Shared with the signals that are running.
+  public: std::shared_ptr<const EventGroups> sorted;
+};
+
+/// \brief Mutex that protects g_connectionGroups.
+static std::mutex g_connectionGroupsMutex;
+
+/// \brief Groups of the connections, by event. Only the events that had a
+/// grouped connection are listed.
+static std::map<const Event *, ConnectionGroupTable> g_connectionGroups;
+
 //////////////////////////////////////////////////
 Event::Event()
   : signaled(false)
@@ -44,6 +69,93 @@ void Event::SetSignaled(const bool _sig)
   this->signaled = _sig;
 }
 
+//////////////////////////////////////////////////
+void Event::SetConnectionGroup(const int _id, const std::string &_group)
+{
+  std::lock_guard<std::mutex> lock(g_connectionGroupsMutex);
+
+  auto iter = g_connectionGroups.find(this);
+  if (_group.empty())
+  {
+    // The id may belong to a removed connection
+    if (iter != g_connectionGroups.end())
+    {
+      iter->second.groups.erase(_id);
+      iter->second.sorted.reset();
+    }
+    return;
+  }
+
+  ConnectionGroupTable &table = g_connectionGroups[this];
+  table.groups[_id] = _group;
+  table.sorted.reset();
+}
+
+//////////////////////////////////////////////////
+void Event::ClearConnectionGroups()
+{
+  std::lock_guard<std::mutex> lock(g_connectionGroupsMutex);
+  g_connectionGroups.erase(this);
+}
+
+//////////////////////////////////////////////////
+void Event::ConnectionsChanged()
+{
+  std::lock_guard<std::mutex> lock(g_connectionGroupsMutex);
+
+  auto iter = g_connectionGroups.find(this);
+  if (iter != g_connectionGroups.end())
+    iter->second.sorted.reset();
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const EventGroups> Event::SortedGroups() const
+{
+  std::lock_guard<std::mutex> lock(g_connectionGroupsMutex);
+
+  auto iter = g_connectionGroups.find(this);
+  if (iter == g_connectionGroups.end())
+    return nullptr;
+  return iter->second.sorted;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const EventGroups> Event::SortGroups(
+    const std::vector<int> &_ids)
+{
+  std::lock_guard<std::mutex> lock(g_connectionGroupsMutex);
+
+  ConnectionGroupTable &table = g_connectionGroups[this];
+
+  std::shared_ptr<EventGroups> sorted(new EventGroups);
+  std::map<int, std::string> groups;
+  std::map<std::string, size_t> groupIndices;
+  for (auto const id : _ids)
+  {
+    auto groupIter = table.groups.find(id);
+    if (groupIter == table.groups.end())
+    {
+      sorted->serial.push_back(id);
+      continue;
+    }
+
+    auto indexIter = groupIndices.find(groupIter->second);
+    if (indexIter == groupIndices.end())
+    {
+      indexIter = groupIndices.emplace(
+          groupIter->second, sorted->groups.size()).first;
+      sorted->groups.emplace_back();
+    }
+    sorted->groups[indexIter->second].push_back(id);
+    groups.insert(*groupIter);
+  }
+
+  // Forget the groups of the removed connections
+  table.groups.swap(groups);
+  table.sorted = sorted;
+  return table.sorted;
+}
+
 //////////////////////////////////////////////////
 Connection::Connection(Event *_e, const int _i)
   : event(_e), id(_i)
@@ -23,6 +23,8 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include "gazebo/gazebo_config.h"
 #include "gazebo/common/Time.hh"
@@ -40,6 +42,19 @@ namespace gazebo
     /// \addtogroup gazebo_event Events
     /// \{
 
+    /// \internal
+    /// \brief Ids of the connections of an event, sorted by group. Used by
+    /// EventT::SignalGrouped.
+    class GZ_COMMON_VISIBLE EventGroups
+    {
+      /// \brief Connections without a group, in connection order.
+      public: std::vector<int> serial;
+
+      /// \brief Connections of each group, in connection order. Groups are
+      /// ordered by their first connection.
+      public: std::vector<std::vector<int>> groups;
+    };
+
     /// \class Event Event.hh common/common.hh
     /// \brief Base class for all events
     class GZ_COMMON_VISIBLE Event
@@ -62,6 +77,38 @@ namespace gazebo
       /// \param[in] _sig True if the event has been signaled.
       public: void SetSignaled(const bool _sig);
 
+      /// \internal
+      /// \brief Set the group of a new connection. The groups are kept
+      /// outside of the event, by connection id.
+      /// \param[in] _id Id of the connection.
+      /// \param[in] _group Name of the group, empty for none.
+      protected: void SetConnectionGroup(const int _id,
+                     const std::string &_group);
+
+      /// \internal
+      /// \brief Forget the groups of all the connections, called when the
+      /// event is destroyed.
+      protected: void ClearConnectionGroups();
+
+      /// \internal
+      /// \brief Tell that connections were removed, so that they are
+      /// sorted by group again.
+      protected: void ConnectionsChanged();
+
+      /// \internal
+      /// \brief Get the connections sorted by group.
+      /// \return The sorted connections, or null if they changed since they
+      /// were last sorted.
+      protected: std::shared_ptr<const EventGroups> SortedGroups() const;
+
+      /// \internal
+      /// \brief Sort connections by group, and keep the result until they
+      /// change.
+      /// \param[in] _ids Ids of all the connections, in connection order.
+      /// \return The sorted connections.
+      protected: std::shared_ptr<const EventGroups> SortGroups(
+                     const std::vector<int> &_ids);
+
       /// \brief True if the event has been signaled.
       private: bool signaled;
     };
@@ -110,6 +157,19 @@ namespace gazebo
       /// Disconnect when it goes out of scope.
       public: ConnectionPtr Connect(const std::function<T> &_subscriber);
 
+      /// \brief Connect a callback that only touches the state of a group,
+      /// such as a model. SignalGrouped may run the callbacks of different
+      /// groups concurrently, while the callbacks of a group always run in
+      /// the order they were connected. Signal runs all the callbacks in
+      /// order.
+      /// \param[in] _subscriber Pointer to a callback function.
+      /// \param[in] _group Name of the group, empty for a callback that
+      /// can touch any state.
+      /// \return A Connection object, which will automatically call
+      /// Disconnect when it goes out of scope.
+      public: ConnectionPtr Connect(const std::function<T> &_subscriber,
+                  const std::string &_group);
+
       /// \brief Disconnect a callback to this event.
       /// \param[in] _id The id of the connection to disconnect.
       public: virtual void Disconnect(int _id);
@@ -561,6 +621,47 @@ namespace gazebo
         }
       }
 
+      /// \brief Signal the event with one parameter, running the callbacks
+      /// connected without a group first, in order, and then each group of
+      /// callbacks through a dispatcher.
+      /// \param[in] _p parameter.
+      /// \param[in] _dispatch Called once with the number of groups and a
+      /// function that runs the callbacks of a group given its index. It
+      /// may run the groups concurrently, and must return once all of them
+      /// have run.
+      public: template< typename P >
+              void SignalGrouped(const P &_p,
+                  const std::function<void (const size_t,
+                      const std::function<void (const size_t)> &)> &_dispatch)
+      {
+        IGN_PROFILE("Event::SignalGrouped");
+
+        this->Cleanup();
+
+        this->SetSignaled(true);
+        std::shared_ptr<const EventGroups> groups = this->Groups();
+
+        for (auto const id : groups->serial)
+        {
+          auto iter = this->connections.find(id);
+          if (iter != this->connections.end() && iter->second->on)
+            iter->second->callback(_p);
+        }
+
+        if (groups->groups.empty())
+          return;
+
+        _dispatch(groups->groups.size(), [&](const size_t _index)
+        {
+          for (auto const id : groups->groups[_index])
+          {
+            auto iter = this->connections.find(id);
+            if (iter != this->connections.end() && iter->second->on)
+              iter->second->callback(_p);
+          }
+        });
+      }
+
       /// \internal
       /// \brief Removes queued connections.
       /// We assume that this function is called from a Signal function.
@@ -585,6 +686,12 @@ namespace gazebo
         public: std::function<T> callback;
       };
 
+      /// \internal
+      /// \brief Get the connections sorted by group, sorting them again if
+      /// they changed.
+      /// \return Connections sorted by group.
+      private: std::shared_ptr<const EventGroups> Groups();
+
       /// \def EvtConnectionMap
       /// \brief Event Connection map typedef.
       typedef std::map<int, std::unique_ptr<EventConnection>> EvtConnectionMap;
@@ -613,6 +720,7 @@ namespace gazebo
     {
       std::lock_guard<std::mutex> lock(this->mutex);
       this->connections.clear();
+      this->ClearConnectionGroups();
     }
 
     /// \brief Adds a connection.
@@ -628,6 +736,26 @@ namespace gazebo
         index = iter->first + 1;
       }
       this->connections[index].reset(new EventConnection(true, _subscriber));
+      this->SetConnectionGroup(index, "");
+      return ConnectionPtr(new Connection(this, index));
+    }
+
+    /// \brief Adds a connection to a group.
+    /// \param[in] _subscriber the subscriber to connect.
+    /// \param[in] _group the group of the subscriber.
+    template<typename T>
+    ConnectionPtr EventT<T>::Connect(const std::function<T> &_subscriber,
+        const std::string &_group)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      int index = 0;
+      if (!this->connections.empty())
+      {
+        auto const &iter = this->connections.rbegin();
+        index = iter->first + 1;
+      }
+      this->connections[index].reset(new EventConnection(true, _subscriber));
+      this->SetConnectionGroup(index, _group);
       return ConnectionPtr(new Connection(this, index));
     }
 
@@ -665,8 +793,31 @@ namespace gazebo
       // Remove all queue connections.
       for (auto &conn : this->connectionsToRemove)
         this->connections.erase(conn);
+      if (!this->connectionsToRemove.empty())
+        this->ConnectionsChanged();
       this->connectionsToRemove.clear();
     }
+
+    /////////////////////////////////////////////
+    /// \brief Sorts the connections by group.
+    template<typename T>
+    std::shared_ptr<const EventGroups> EventT<T>::Groups()
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      std::shared_ptr<const EventGroups> sorted = this->SortedGroups();
+      if (sorted)
+        return sorted;
+
+      std::vector<int> ids;
+      ids.reserve(this->connections.size());
+      for (auto const &iter : this->connections)
+      {
+        if (iter.second != NULL)
+          ids.push_back(iter.first);
+      }
+
+      return this->SortGroups(ids);
+    }
     /// \}
   }
 }
@@ -17,7 +17,9 @@
 
 #include <functional>
 #include <future>
+#include <string>
 #include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 #include <gazebo/common/Time.hh>
 #include <gazebo/common/Event.hh>
@@ -222,6 +224,124 @@ TEST_F(EventTest, ManyChanges)
   EXPECT_EQ(g_callback1, 2);
 }
 
+/////////////////////////////////////////////////
+TEST_F(EventTest, SignalGrouped)
+{
+  event::EventT<void (int)> evt;
+  std::vector<std::string> calls;
+
+  auto record = [&calls](const std::string &_name, int _value)
+  {
+    calls.push_back(_name + std::to_string(_value));
+  };
+
+  event::ConnectionPtr a1 = evt.Connect(
+      std::bind(record, "a1_", std::placeholders::_1), "a");
+  event::ConnectionPtr serial1 = evt.Connect(
+      std::bind(record, "s1_", std::placeholders::_1));
+  event::ConnectionPtr b1 = evt.Connect(
+      std::bind(record, "b1_", std::placeholders::_1), "b");
+  event::ConnectionPtr a2 = evt.Connect(
+      std::bind(record, "a2_", std::placeholders::_1), "a");
+  event::ConnectionPtr serial2 = evt.Connect(
+      std::bind(record, "s2_", std::placeholders::_1), "");
+  EXPECT_EQ(evt.ConnectionCount(), 5u);
+
+  // Signal runs every callback in connection order
+  evt(1);
+  EXPECT_EQ(calls, std::vector<std::string>(
+        {"a1_1", "s1_1", "b1_1", "a2_1", "s2_1"}));
+
+  // SignalGrouped runs the callbacks without a group first, then hands
+  // each group to the dispatcher, in the order of their first connection
+  calls.clear();
+  std::vector<size_t> counts;
+  auto reverse = [&](const size_t _count,
+      const std::function<void (const size_t)> &_run)
+  {
+    counts.push_back(_count);
+    for (size_t i = _count; i > 0; --i)
+      _run(i - 1);
+  };
+  evt.SignalGrouped(2, reverse);
+  EXPECT_EQ(counts, std::vector<size_t>({2u}));
+  EXPECT_EQ(calls, std::vector<std::string>(
+        {"s1_2", "s2_2", "b1_2", "a1_2", "a2_2"}));
+
+  // Groups are sorted again after a disconnection
+  calls.clear();
+  b1.reset();
+  evt.SignalGrouped(3, reverse);
+  EXPECT_EQ(counts, std::vector<size_t>({2u, 1u}));
+  EXPECT_EQ(calls, std::vector<std::string>(
+        {"s1_3", "s2_3", "a1_3", "a2_3"}));
+
+  // The dispatcher isn't called without groups
+  calls.clear();
+  a1.reset();
+  a2.reset();
+  evt.SignalGrouped(4, reverse);
+  EXPECT_EQ(counts, std::vector<size_t>({2u, 1u}));
+  EXPECT_EQ(calls, std::vector<std::string>({"s1_4", "s2_4"}));
+
+  // Ids are reused once all the connections are gone, a new connection
+  // doesn't inherit the group of a removed one
+  calls.clear();
+  serial1.reset();
+  serial2.reset();
+  evt.SignalGrouped(5, reverse);
+  EXPECT_TRUE(calls.empty());
+  a1 = evt.Connect(std::bind(record, "n1_", std::placeholders::_1));
+  evt.SignalGrouped(6, reverse);
+  EXPECT_EQ(counts, std::vector<size_t>({2u, 1u}));
+  EXPECT_EQ(calls, std::vector<std::string>({"n1_6"}));
+}
+
+/////////////////////////////////////////////////
+TEST_F(EventTest, SignalGroupedConcurrent)
+{
+  event::EventT<void (int)> evt;
+  const unsigned int groupCount = 8;
+  const unsigned int callbackCount = 4;
+
+  // Each group appends to its own list, without locking
+  std::vector<std::vector<int>> values(groupCount);
+  std::list<event::ConnectionPtr> connections;
+  for (unsigned int c = 0; c < callbackCount; ++c)
+  {
+    for (unsigned int g = 0; g < groupCount; ++g)
+    {
+      connections.push_back(evt.Connect([&values, g, c](int _value)
+      {
+        values[g].push_back(_value * 10 + c);
+      }, "group" + std::to_string(g)));
+    }
+  }
+
+  auto threads = [](const size_t _count,
+      const std::function<void (const size_t)> &_run)
+  {
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < _count; ++i)
+      workers.emplace_back(_run, i);
+    for (auto &worker : workers)
+      worker.join();
+  };
+
+  for (int i = 1; i <= 10; ++i)
+    evt.SignalGrouped(i, threads);
+
+  for (auto const &groupValues : values)
+  {
+    ASSERT_EQ(groupValues.size(), 10u * callbackCount);
+    for (unsigned int i = 0; i < groupValues.size(); ++i)
+    {
+      EXPECT_EQ(groupValues[i],
+          static_cast<int>((i / callbackCount + 1) * 10 + i % callbackCount));
+    }
+  }
+}
+
 
 /////////////////////////////////////////////////
 // Race condition helper functions
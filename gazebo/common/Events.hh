@@ -108,6 +108,18 @@ namespace gazebo
               static ConnectionPtr ConnectWorldUpdateBegin(T _subscriber)
               { return worldUpdateBegin.Connect(_subscriber); }
 
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief Connect a callback to the world update start signal, which
+      /// only touches the state of one model. The world may run the
+      /// callbacks of different models concurrently.
+      /// \param[in] _subscriber the subscriber to this event
+      /// \param[in] _model scoped name of the model
+      /// \return a connection
+      public: template<typename T>
+              static ConnectionPtr ConnectWorldUpdateBegin(T _subscriber,
+                  const std::string &_model)
+              { return worldUpdateBegin.Connect(_subscriber, _model); }
+
       //////////////////////////////////////////////////////////////////////////
       /// \brief Connect a callback to the before physics update signal
       /// \param[in] _subscriber the subscriber to this event
@@ -120,6 +132,18 @@ namespace gazebo
               static ConnectionPtr ConnectBeforePhysicsUpdate(T _subscriber)
               { return beforePhysicsUpdate.Connect(_subscriber); }
 
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief Connect a callback to the before physics update signal,
+      /// which only touches the state of one model. The world may run the
+      /// callbacks of different models concurrently.
+      /// \param[in] _subscriber the subscriber to this event
+      /// \param[in] _model scoped name of the model
+      /// \return a connection
+      public: template<typename T>
+              static ConnectionPtr ConnectBeforePhysicsUpdate(T _subscriber,
+                  const std::string &_model)
+              { return beforePhysicsUpdate.Connect(_subscriber, _model); }
+
       //////////////////////////////////////////////////////////////////////////
       /// \brief Connect a callback to the world update end signal
       /// \param[in] _subscriber the subscriber to this event
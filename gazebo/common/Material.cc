@@ -17,6 +17,7 @@
 
 #include <boost/filesystem.hpp>
 #include <algorithm>
+#include <mutex>
 #include <boost/lexical_cast.hpp>
 
 #include "gazebo/common/SystemPaths.hh"
@@ -29,6 +30,10 @@ using namespace common;
 
 unsigned int Material::counter = 0;
 
+/// \brief Protects the counter, because meshes and their materials can be
+/// loaded by several threads at the same time.
+static std::mutex g_counterMutex;
+
 std::string Material::ShadeModeStr[SHADE_COUNT] = {"FLAT", "GOURAUD",
   "PHONG", "BLINN"};
 std::string Material::BlendModeStr[BLEND_COUNT] = {"ADD", "MODULATE",
@@ -37,7 +42,11 @@ std::string Material::BlendModeStr[BLEND_COUNT] = {"ADD", "MODULATE",
 //////////////////////////////////////////////////
 Material::Material()
 {
-  this->name = "gazebo_material_" + boost::lexical_cast<std::string>(counter++);
+  {
+    std::lock_guard<std::mutex> lock(g_counterMutex);
+    this->name =
+      "gazebo_material_" + boost::lexical_cast<std::string>(counter++);
+  }
   this->blendMode = REPLACE;
   this->shadeMode = GOURAUD;
   this->ambient.Set(0.4, 0.4, 0.4, 1);
@@ -49,7 +58,11 @@ Material::Material()
 //////////////////////////////////////////////////
 Material::Material(const ignition::math::Color &_clr)
 {
-  this->name = "gazebo_material_" + boost::lexical_cast<std::string>(counter++);
+  {
+    std::lock_guard<std::mutex> lock(g_counterMutex);
+    this->name =
+      "gazebo_material_" + boost::lexical_cast<std::string>(counter++);
+  }
   this->blendMode = REPLACE;
   this->shadeMode = GOURAUD;
   this->ambient = _clr;
@@ -17,6 +17,9 @@
 #include <float.h>
 #include <string.h>
 #include <algorithm>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "gazebo/common/Material.hh"
 #include "gazebo/common/Exception.hh"
@@ -28,6 +31,68 @@
 using namespace gazebo;
 using namespace common;
 
+/// \brief Compact storage of a submesh, see SubMesh::SetCompact.
+class SubMeshCompactData
+{
+  /// \brief Flat vertex array.
+  public: std::vector<float> vertexData;
+
+  /// \brief Flat normal array.
+  public: std::vector<float> normalData;
+
+  /// \brief Flat texture coordinate array.
+  public: std::vector<float> texCoordData;
+};
+
+/// \brief Mutex that protects g_compactData.
+static std::mutex g_compactMutex;
+
+/// \brief Storage of the compact submeshes, by submesh. A compact submesh
+/// never has double precision vertices, so the table is only searched for
+/// the submeshes that have none.
+static std::unordered_map<const SubMesh *,
+    std::unique_ptr<SubMeshCompactData>> g_compactData;
+
+/// \brief Get the compact storage of a submesh.
+/// \param[in] _mesh The submesh.
+/// \param[in] _vertices Double precision vertices of the submesh.
+/// \return The compact storage, or null if the storage isn't compact.
+static SubMeshCompactData *CompactData(const SubMesh *_mesh,
+    const std::vector<ignition::math::Vector3d> &_vertices)
+{
+  if (!_vertices.empty())
+    return nullptr;
+
+  std::lock_guard<std::mutex> lock(g_compactMutex);
+  auto iter = g_compactData.find(_mesh);
+  return iter != g_compactData.end() ? iter->second.get() : nullptr;
+}
+
+/// \brief Get a vector from a flat array of x, y, z triplets.
+/// \param[in] _data The flat array.
+/// \param[in] _i Index of the vector.
+/// \return The vector.
+static ignition::math::Vector3d FlatVector3(const std::vector<float> &_data,
+    const unsigned int _i)
+{
+  const float *v = &_data[_i * 3];
+  return ignition::math::Vector3d(v[0], v[1], v[2]);
+}
+
+/// \brief Set the compact storage of a submesh.
+/// \param[in] _mesh The submesh.
+/// \param[in] _data The compact storage, null if the storage isn't
+/// compact.
+static void SetCompactData(const SubMesh *_mesh,
+    std::unique_ptr<SubMeshCompactData> _data)
+{
+  std::lock_guard<std::mutex> lock(g_compactMutex);
+  if (_data)
+    g_compactData[_mesh] = std::move(_data);
+  else
+    g_compactData.erase(_mesh);
+}
+
 
 //////////////////////////////////////////////////
 Mesh::Mesh()
@@ -303,11 +368,23 @@ void Mesh::FillArrays(float **_vertArr, int **_indArr) const
     if ((*iter)->GetVertexCount() <= 2)
       continue;
 
-    float *vertTmp = nullptr;
-    int *indTmp = nullptr;
-    (*iter)->FillArrays(&vertTmp, &indTmp);
-
-    memcpy(vPtr, vertTmp, sizeof(vertTmp[0])*(*iter)->GetVertexCount()*3);
+    // Compact submeshes are copied without conversion
+    const unsigned int subVertCount = (*iter)->GetVertexCount();
+    if ((*iter)->Compact())
+    {
+      memcpy(vPtr, (*iter)->VertexData(),
+          sizeof(vPtr[0]) * subVertCount * 3);
+    }
+    else
+    {
+      for (unsigned int i = 0; i < subVertCount; ++i)
+      {
+        const ignition::math::Vector3d v = (*iter)->Vertex(i);
+        vPtr[i * 3] = static_cast<float>(v.X());
+        vPtr[i * 3 + 1] = static_cast<float>(v.Y());
+        vPtr[i * 3 + 2] = static_cast<float>(v.Z());
+      }
+    }
 
     for (unsigned int i = 0; i < (*iter)->GetIndexCount(); ++i)
     {
@@ -316,13 +393,17 @@ void Mesh::FillArrays(float **_vertArr, int **_indArr) const
 
     offset = offset + (*iter)->GetMaxIndex() + 1;
 
-    vPtr += (*iter)->GetVertexCount()*3;
-
-    delete [] vertTmp;
-    delete [] indTmp;
+    vPtr += subVertCount * 3;
   }
 }
 
+//////////////////////////////////////////////////
+void Mesh::SetCompact(const bool _compact)
+{
+  for (auto &subMesh : this->submeshes)
+    subMesh->SetCompact(_compact);
+}
+
 //////////////////////////////////////////////////
 void Mesh::RecalculateNormals()
 {
@@ -413,6 +494,7 @@ SubMesh::SubMesh()
 
 //////////////////////////////////////////////////
 SubMesh::SubMesh(const SubMesh *_mesh)
+  : SubMesh()
 {
   if (!_mesh)
   {
@@ -435,16 +517,50 @@ SubMesh::SubMesh(const SubMesh *_mesh)
       std::back_inserter(this->texCoords));
   std::copy(_mesh->vertices.begin(), _mesh->vertices.end(),
       std::back_inserter(this->vertices));
+
+  const SubMeshCompactData *data = CompactData(_mesh, _mesh->vertices);
+  if (data)
+    SetCompactData(this, std::make_unique<SubMeshCompactData>(*data));
+}
+
+//////////////////////////////////////////////////
+SubMesh::SubMesh(const SubMesh &_mesh)
+  : SubMesh(&_mesh)
+{
 }
 
 //////////////////////////////////////////////////
 SubMesh::~SubMesh()
 {
+  if (this->vertices.empty())
+    SetCompactData(this, nullptr);
+
   this->vertices.clear();
   this->indices.clear();
   this->nodeAssignments.clear();
 }
 
+//////////////////////////////////////////////////
+SubMesh &SubMesh::operator=(const SubMesh &_mesh)
+{
+  if (&_mesh == this)
+    return *this;
+
+  const SubMeshCompactData *data = CompactData(&_mesh, _mesh.vertices);
+  SetCompactData(this, data ?
+      std::make_unique<SubMeshCompactData>(*data) : nullptr);
+
+  this->name = _mesh.name;
+  this->materialIndex = _mesh.materialIndex;
+  this->primitiveType = _mesh.primitiveType;
+  this->nodeAssignments = _mesh.nodeAssignments;
+  this->indices = _mesh.indices;
+  this->normals = _mesh.normals;
+  this->texCoords = _mesh.texCoords;
+  this->vertices = _mesh.vertices;
+  return *this;
+}
+
 //////////////////////////////////////////////////
 void SubMesh::SetPrimitiveType(PrimitiveType _type)
 {
@@ -460,6 +576,20 @@ SubMesh::PrimitiveType SubMesh::GetPrimitiveType() const
 //////////////////////////////////////////////////
 void SubMesh::CopyVertices(const std::vector<ignition::math::Vector3d> &_verts)
 {
+  SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (data)
+  {
+    data->vertexData.clear();
+    data->vertexData.reserve(_verts.size() * 3);
+    for (const auto &vert : _verts)
+    {
+      data->vertexData.push_back(static_cast<float>(vert.X()));
+      data->vertexData.push_back(static_cast<float>(vert.Y()));
+      data->vertexData.push_back(static_cast<float>(vert.Z()));
+    }
+    return;
+  }
+
   this->vertices.clear();
   this->vertices.resize(_verts.size());
   std::copy(_verts.begin(), _verts.end(), this->vertices.begin());
@@ -469,22 +599,30 @@ void SubMesh::CopyVertices(const std::vector<ignition::math::Vector3d> &_verts)
 void SubMesh::CopyNormals(const std::vector<ignition::math::Vector3d> &_norms)
 {
   this->normals.clear();
-  this->normals.resize(_norms.size());
+  SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (data)
+    data->normalData.clear();
+  this->SetNormalCount(_norms.size());
   for (unsigned int i = 0; i < _norms.size(); ++i)
   {
-    this->normals[i] = _norms[i];
-    this->normals[i].Normalize();
-    if (ignition::math::equal(this->normals[i].Length(), 0.0))
+    ignition::math::Vector3d normal = _norms[i];
+    normal.Normalize();
+    if (ignition::math::equal(normal.Length(), 0.0))
     {
-      this->normals[i].Set(0, 0, 1);
+      normal.Set(0, 0, 1);
     }
+    this->SetNormal(i, normal);
   }
 }
 
 //////////////////////////////////////////////////
 void SubMesh::SetVertexCount(unsigned int _count)
 {
-  this->vertices.resize(_count);
+  SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (data)
+    data->vertexData.resize(_count * 3);
+  else
+    this->vertices.resize(_count);
 }
 
 //////////////////////////////////////////////////
@@ -496,13 +634,21 @@ void SubMesh::SetIndexCount(unsigned int _count)
 //////////////////////////////////////////////////
 void SubMesh::SetNormalCount(unsigned int _count)
 {
-  this->normals.resize(_count);
+  SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (data)
+    data->normalData.resize(_count * 3);
+  else
+    this->normals.resize(_count);
 }
 
 //////////////////////////////////////////////////
 void SubMesh::SetTexCoordCount(unsigned int _count)
 {
-  this->texCoords.resize(_count);
+  SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (data)
+    data->texCoordData.resize(_count * 2);
+  else
+    this->texCoords.resize(_count);
 }
 
 //////////////////////////////////////////////////
@@ -514,7 +660,17 @@ void SubMesh::AddIndex(unsigned int _i)
 //////////////////////////////////////////////////
 void SubMesh::AddVertex(const ignition::math::Vector3d &_v)
 {
-  this->vertices.push_back(_v);
+  SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (data)
+  {
+    data->vertexData.push_back(static_cast<float>(_v.X()));
+    data->vertexData.push_back(static_cast<float>(_v.Y()));
+    data->vertexData.push_back(static_cast<float>(_v.Z()));
+  }
+  else
+  {
+    this->vertices.push_back(_v);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -526,7 +682,17 @@ void SubMesh::AddVertex(double _x, double _y, double _z)
 //////////////////////////////////////////////////
 void SubMesh::AddNormal(const ignition::math::Vector3d &_n)
 {
-  this->normals.push_back(_n);
+  SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (data)
+  {
+    data->normalData.push_back(static_cast<float>(_n.X()));
+    data->normalData.push_back(static_cast<float>(_n.Y()));
+    data->normalData.push_back(static_cast<float>(_n.Z()));
+  }
+  else
+  {
+    this->normals.push_back(_n);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -538,7 +704,16 @@ void SubMesh::AddNormal(double _x, double _y, double _z)
 //////////////////////////////////////////////////
 void SubMesh::AddTexCoord(double _u, double _v)
 {
-  this->texCoords.push_back(ignition::math::Vector2d(_u, _v));
+  SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (data)
+  {
+    data->texCoordData.push_back(static_cast<float>(_u));
+    data->texCoordData.push_back(static_cast<float>(_v));
+  }
+  else
+  {
+    this->texCoords.push_back(ignition::math::Vector2d(_u, _v));
+  }
 }
 
 //////////////////////////////////////////////////
@@ -556,6 +731,15 @@ void SubMesh::AddNodeAssignment(unsigned int _vertex, unsigned int _node,
 //////////////////////////////////////////////////
 ignition::math::Vector3d SubMesh::Vertex(unsigned int _i) const
 {
+  const SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (data)
+  {
+    if (_i >= data->vertexData.size() / 3)
+      gzthrow("Index too large");
+
+    return FlatVector3(data->vertexData, _i);
+  }
+
   if (_i >= this->vertices.size())
     gzthrow("Index too large");
 
@@ -565,15 +749,35 @@ ignition::math::Vector3d SubMesh::Vertex(unsigned int _i) const
 //////////////////////////////////////////////////
 void SubMesh::SetVertex(unsigned int _i, const ignition::math::Vector3d &_v)
 {
-  if (_i >= this->vertices.size())
+  SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (_i >= (data ? data->vertexData.size() / 3 : this->vertices.size()))
     gzthrow("Index too large");
 
-  this->vertices[_i] = _v;
+  if (data)
+  {
+    float *v = &data->vertexData[_i * 3];
+    v[0] = static_cast<float>(_v.X());
+    v[1] = static_cast<float>(_v.Y());
+    v[2] = static_cast<float>(_v.Z());
+  }
+  else
+  {
+    this->vertices[_i] = _v;
+  }
 }
 
 //////////////////////////////////////////////////
 ignition::math::Vector3d SubMesh::Normal(unsigned int _i) const
 {
+  const SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (data)
+  {
+    if (_i >= data->normalData.size() / 3)
+      gzthrow("Index too large");
+
+    return FlatVector3(data->normalData, _i);
+  }
+
   if (_i >= this->normals.size())
     gzthrow("Index too large");
 
@@ -583,15 +787,36 @@ ignition::math::Vector3d SubMesh::Normal(unsigned int _i) const
 //////////////////////////////////////////////////
 void SubMesh::SetNormal(unsigned int _i, const ignition::math::Vector3d &_n)
 {
-  if (_i >= this->normals.size())
+  SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (_i >= (data ? data->normalData.size() / 3 : this->normals.size()))
     gzthrow("Index too large");
 
-  this->normals[_i] = _n;
+  if (data)
+  {
+    float *n = &data->normalData[_i * 3];
+    n[0] = static_cast<float>(_n.X());
+    n[1] = static_cast<float>(_n.Y());
+    n[2] = static_cast<float>(_n.Z());
+  }
+  else
+  {
+    this->normals[_i] = _n;
+  }
 }
 
 //////////////////////////////////////////////////
 ignition::math::Vector2d SubMesh::TexCoord(unsigned int _i) const
 {
+  const SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (data)
+  {
+    if (_i >= data->texCoordData.size() / 2)
+      gzthrow("Index too large");
+
+    const float *t = &data->texCoordData[_i * 2];
+    return ignition::math::Vector2d(t[0], t[1]);
+  }
+
   if (_i >= this->texCoords.size())
     gzthrow("Index too large");
 
@@ -610,10 +835,20 @@ NodeAssignment SubMesh::GetNodeAssignment(unsigned int _i) const
 //////////////////////////////////////////////////
 void SubMesh::SetTexCoord(unsigned int _i, const ignition::math::Vector2d &_t)
 {
-  if (_i >= this->texCoords.size())
+  SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (_i >= (data ? data->texCoordData.size() / 2 : this->texCoords.size()))
     gzthrow("Index too large");
 
-  this->texCoords[_i] = _t;
+  if (data)
+  {
+    float *t = &data->texCoordData[_i * 2];
+    t[0] = static_cast<float>(_t.X());
+    t[1] = static_cast<float>(_t.Y());
+  }
+  else
+  {
+    this->texCoords[_i] = _t;
+  }
 }
 
 //////////////////////////////////////////////////
@@ -629,17 +864,20 @@ unsigned int SubMesh::GetIndex(unsigned int _i) const
 ignition::math::Vector3d SubMesh::Max() const
 {
   ignition::math::Vector3d max;
-  std::vector<ignition::math::Vector3d>::const_iterator iter;
 
   max.X(-FLT_MAX);
   max.Y(-FLT_MAX);
   max.Z(-FLT_MAX);
 
-  for (iter = this->vertices.begin(); iter != this->vertices.end(); ++iter)
+  const SubMeshCompactData *data = CompactData(this, this->vertices);
+  const unsigned int count = this->GetVertexCount();
+  for (unsigned int i = 0; i < count; ++i)
   {
-    max.X(std::max(max.X(), (*iter).X()));
-    max.Y(std::max(max.Y(), (*iter).Y()));
-    max.Z(std::max(max.Z(), (*iter).Z()));
+    const ignition::math::Vector3d v = data ?
+        FlatVector3(data->vertexData, i) : this->vertices[i];
+    max.X(std::max(max.X(), v.X()));
+    max.Y(std::max(max.Y(), v.Y()));
+    max.Z(std::max(max.Z(), v.Z()));
   }
 
   return max;
@@ -649,17 +887,20 @@ ignition::math::Vector3d SubMesh::Max() const
 ignition::math::Vector3d SubMesh::Min() const
 {
   ignition::math::Vector3d min;
-  std::vector<ignition::math::Vector3d>::const_iterator iter;
 
   min.X(FLT_MAX);
   min.Y(FLT_MAX);
   min.Z(FLT_MAX);
 
-  for (iter = this->vertices.begin(); iter != this->vertices.end(); ++iter)
+  const SubMeshCompactData *data = CompactData(this, this->vertices);
+  const unsigned int count = this->GetVertexCount();
+  for (unsigned int i = 0; i < count; ++i)
   {
-    min.X(std::min(min.X(), (*iter).X()));
-    min.Y(std::min(min.Y(), (*iter).Y()));
-    min.Z(std::min(min.Z(), (*iter).Z()));
+    const ignition::math::Vector3d v = data ?
+        FlatVector3(data->vertexData, i) : this->vertices[i];
+    min.X(std::min(min.X(), v.X()));
+    min.Y(std::min(min.Y(), v.Y()));
+    min.Z(std::min(min.Z(), v.Z()));
   }
 
   return min;
@@ -668,12 +909,18 @@ ignition::math::Vector3d SubMesh::Min() const
 //////////////////////////////////////////////////
 unsigned int SubMesh::GetVertexCount() const
 {
+  const SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (data)
+    return data->vertexData.size() / 3;
   return this->vertices.size();
 }
 
 //////////////////////////////////////////////////
 unsigned int SubMesh::GetNormalCount() const
 {
+  const SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (data)
+    return data->normalData.size() / 3;
   return this->normals.size();
 }
 
@@ -686,6 +933,9 @@ unsigned int SubMesh::GetIndexCount() const
 //////////////////////////////////////////////////
 unsigned int SubMesh::GetTexCoordCount() const
 {
+  const SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (data)
+    return data->texCoordData.size() / 2;
   return this->texCoords.size();
 }
 
@@ -722,11 +972,13 @@ unsigned int SubMesh::GetMaterialIndex() const
 //////////////////////////////////////////////////
 bool SubMesh::HasVertex(const ignition::math::Vector3d &_v) const
 {
-  std::vector< ignition::math::Vector3d >::const_iterator iter;
-
-  for (iter = this->vertices.begin(); iter != this->vertices.end(); ++iter)
-    if (_v.Equal(*iter))
+  const SubMeshCompactData *data = CompactData(this, this->vertices);
+  const unsigned int count = this->GetVertexCount();
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    if (_v.Equal(data ? FlatVector3(data->vertexData, i) : this->vertices[i]))
       return true;
+  }
 
   return false;
 }
@@ -734,11 +986,13 @@ bool SubMesh::HasVertex(const ignition::math::Vector3d &_v) const
 //////////////////////////////////////////////////
 unsigned int SubMesh::GetVertexIndex(const ignition::math::Vector3d &_v) const
 {
-  std::vector< ignition::math::Vector3d >::const_iterator iter;
-
-  for (iter = this->vertices.begin(); iter != this->vertices.end(); ++iter)
-    if (_v.Equal(*iter))
-      return iter - this->vertices.begin();
+  const SubMeshCompactData *data = CompactData(this, this->vertices);
+  const unsigned int count = this->GetVertexCount();
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    if (_v.Equal(data ? FlatVector3(data->vertexData, i) : this->vertices[i]))
+      return i;
+  }
 
   return 0;
 }
@@ -746,7 +1000,9 @@ unsigned int SubMesh::GetVertexIndex(const ignition::math::Vector3d &_v) const
 //////////////////////////////////////////////////
 void SubMesh::FillArrays(float **_vertArr, int **_indArr) const
 {
-  if (this->vertices.empty() || this->indices.empty())
+  const SubMeshCompactData *data = CompactData(this, this->vertices);
+  const unsigned int vertexCount = this->GetVertexCount();
+  if (vertexCount == 0 || this->indices.empty())
     gzerr << "No vertices or indices\n";
 
   std::vector<ignition::math::Vector3d>::const_iterator viter;
@@ -759,15 +1015,23 @@ void SubMesh::FillArrays(float **_vertArr, int **_indArr) const
   if (*_indArr)
     delete [] *_indArr;
 
-  *_vertArr = new float[this->vertices.size() * 3];
+  *_vertArr = new float[vertexCount * 3];
   *_indArr = new int[this->indices.size()];
 
-  for (viter = this->vertices.begin(), i = 0; viter != this->vertices.end();
-      ++viter)
+  // Compact vertices are already in the layout of the array
+  if (data)
   {
-    (*_vertArr)[i++] = static_cast<float>((*viter).X());
-    (*_vertArr)[i++] = static_cast<float>((*viter).Y());
-    (*_vertArr)[i++] = static_cast<float>((*viter).Z());
+    std::copy(data->vertexData.begin(), data->vertexData.end(), *_vertArr);
+  }
+  else
+  {
+    for (viter = this->vertices.begin(), i = 0;
+        viter != this->vertices.end(); ++viter)
+    {
+      (*_vertArr)[i++] = static_cast<float>((*viter).X());
+      (*_vertArr)[i++] = static_cast<float>((*viter).Y());
+      (*_vertArr)[i++] = static_cast<float>((*viter).Z());
+    }
   }
 
   for (iiter = this->indices.begin(), i = 0;
@@ -781,39 +1045,51 @@ void SubMesh::FillArrays(float **_vertArr, int **_indArr) const
 void SubMesh::RecalculateNormals()
 {
   unsigned int i;
-  if (normals.size() < 3)
+  if (this->GetNormalCount() < 3)
     return;
 
-  // Reset all the normals
-  for (i = 0; i < this->normals.size(); ++i)
-    this->normals[i].Set(0, 0, 0);
+  // Work on double precision copies, whatever the storage
+  const SubMeshCompactData *data = CompactData(this, this->vertices);
+  std::vector<ignition::math::Vector3d> verts;
+  if (data)
+  {
+    verts.resize(this->GetVertexCount());
+    for (i = 0; i < verts.size(); ++i)
+      verts[i] = FlatVector3(data->vertexData, i);
+  }
+  else
+  {
+    verts = this->vertices;
+  }
 
-  if (this->normals.size() != this->vertices.size())
-    this->normals.resize(this->vertices.size());
+  // Reset all the normals
+  std::vector<ignition::math::Vector3d> norms(verts.size());
 
   // For each face, which is defined by three indices, calculate the normals
   for (i = 0; i < this->indices.size(); i+= 3)
   {
-    ignition::math::Vector3d v1 = this->vertices[this->indices[i]];
-    ignition::math::Vector3d v2 = this->vertices[this->indices[i+1]];
-    ignition::math::Vector3d v3 = this->vertices[this->indices[i+2]];
+    ignition::math::Vector3d v1 = verts[this->indices[i]];
+    ignition::math::Vector3d v2 = verts[this->indices[i+1]];
+    ignition::math::Vector3d v3 = verts[this->indices[i+2]];
     ignition::math::Vector3d n = ignition::math::Vector3d::Normal(v1, v2, v3);
 
-    for (unsigned int j = 0; j< this->vertices.size(); ++j)
+    for (unsigned int j = 0; j< verts.size(); ++j)
     {
-      if (this->vertices[j] == v1 ||
-          this->vertices[j] == v2 ||
-          this->vertices[j] == v3)
+      if (verts[j] == v1 ||
+          verts[j] == v2 ||
+          verts[j] == v3)
       {
-        this->normals[j] += n;
+        norms[j] += n;
       }
     }
   }
 
   // Normalize the results
-  for (i = 0; i < this->normals.size(); ++i)
+  this->SetNormalCount(norms.size());
+  for (i = 0; i < norms.size(); ++i)
   {
-    this->normals[i].Normalize();
+    norms[i].Normalize();
+    this->SetNormal(i, norms[i]);
   }
 }
 
@@ -854,14 +1130,15 @@ void Mesh::GetAABB(ignition::math::Vector3d &_center,
 //////////////////////////////////////////////////
 void SubMesh::GenSphericalTexCoord(const ignition::math::Vector3d &_center)
 {
-  std::vector<ignition::math::Vector3d>::const_iterator viter;
-  for (viter = this->vertices.begin(); viter != this->vertices.end(); ++viter)
+  for (unsigned int i = 0; i < this->GetVertexCount(); ++i)
   {
+    const ignition::math::Vector3d vert = this->Vertex(i);
+
     // generate projected texture coordinates, projected from center
     // get x, y, z for computing texture coordinate projections
-    double x = (*viter).X() - _center.X();
-    double y = (*viter).Y() - _center.Y();
-    double z = (*viter).Z() - _center.Z();
+    double x = vert.X() - _center.X();
+    double y = vert.Y() - _center.Y();
+    double z = vert.Z() - _center.Z();
 
     double r = std::max(0.000001, sqrt(x*x+y*y+z*z));
     double s = std::min(1.0, std::max(-1.0, z/r));
@@ -877,6 +1154,13 @@ void SubMesh::Scale(double _factor)
 {
   for (auto &vert : this->vertices)
     vert *= _factor;
+
+  SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (!data)
+    return;
+
+  for (auto &value : data->vertexData)
+    value = static_cast<float>(value * _factor);
 }
 
 //////////////////////////////////////////////////
@@ -884,6 +1168,18 @@ void SubMesh::SetScale(const ignition::math::Vector3d &_factor)
 {
   for (auto &vert : this->vertices)
     vert *= _factor;
+
+  SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (!data)
+    return;
+
+  std::vector<float> &values = data->vertexData;
+  for (size_t i = 0; i + 2 < values.size(); i += 3)
+  {
+    values[i] = static_cast<float>(values[i] * _factor.X());
+    values[i+1] = static_cast<float>(values[i+1] * _factor.Y());
+    values[i+2] = static_cast<float>(values[i+2] * _factor.Z());
+  }
 }
 
 //////////////////////////////////////////////////
@@ -902,6 +1198,108 @@ void SubMesh::Translate(const ignition::math::Vector3d &_vec)
 {
   for (auto &vert : this->vertices)
     vert += _vec;
+
+  SubMeshCompactData *data = CompactData(this, this->vertices);
+  if (!data)
+    return;
+
+  std::vector<float> &values = data->vertexData;
+  for (size_t i = 0; i + 2 < values.size(); i += 3)
+  {
+    values[i] = static_cast<float>(values[i] + _vec.X());
+    values[i+1] = static_cast<float>(values[i+1] + _vec.Y());
+    values[i+2] = static_cast<float>(values[i+2] + _vec.Z());
+  }
+}
+
+//////////////////////////////////////////////////
+void SubMesh::SetCompact(const bool _compact)
+{
+  std::unique_ptr<SubMeshCompactData> data;
+  {
+    std::lock_guard<std::mutex> lock(g_compactMutex);
+    auto iter = g_compactData.find(this);
+    if (iter != g_compactData.end())
+    {
+      if (_compact)
+        return;
+      data = std::move(iter->second);
+      g_compactData.erase(iter);
+    }
+  }
+
+  if (_compact)
+  {
+    data.reset(new SubMeshCompactData);
+    data->vertexData.reserve(this->vertices.size() * 3);
+    for (const auto &vert : this->vertices)
+    {
+      data->vertexData.push_back(static_cast<float>(vert.X()));
+      data->vertexData.push_back(static_cast<float>(vert.Y()));
+      data->vertexData.push_back(static_cast<float>(vert.Z()));
+    }
+    data->normalData.reserve(this->normals.size() * 3);
+    for (const auto &norm : this->normals)
+    {
+      data->normalData.push_back(static_cast<float>(norm.X()));
+      data->normalData.push_back(static_cast<float>(norm.Y()));
+      data->normalData.push_back(static_cast<float>(norm.Z()));
+    }
+    data->texCoordData.reserve(this->texCoords.size() * 2);
+    for (const auto &coord : this->texCoords)
+    {
+      data->texCoordData.push_back(static_cast<float>(coord.X()));
+      data->texCoordData.push_back(static_cast<float>(coord.Y()));
+    }
+
+    // Compact submeshes never have double precision arrays
+    std::vector<ignition::math::Vector3d>().swap(this->vertices);
+    std::vector<ignition::math::Vector3d>().swap(this->normals);
+    std::vector<ignition::math::Vector2d>().swap(this->texCoords);
+    SetCompactData(this, std::move(data));
+  }
+  else if (data)
+  {
+    const std::vector<float> &verts = data->vertexData;
+    this->vertices.reserve(verts.size() / 3);
+    for (size_t i = 0; i + 2 < verts.size(); i += 3)
+      this->vertices.emplace_back(verts[i], verts[i+1], verts[i+2]);
+    const std::vector<float> &norms = data->normalData;
+    this->normals.reserve(norms.size() / 3);
+    for (size_t i = 0; i + 2 < norms.size(); i += 3)
+      this->normals.emplace_back(norms[i], norms[i+1], norms[i+2]);
+    const std::vector<float> &coords = data->texCoordData;
+    this->texCoords.reserve(coords.size() / 2);
+    for (size_t i = 0; i + 1 < coords.size(); i += 2)
+      this->texCoords.emplace_back(coords[i], coords[i+1]);
+  }
+}
+
+//////////////////////////////////////////////////
+bool SubMesh::Compact() const
+{
+  return CompactData(this, this->vertices) != nullptr;
+}
+
+//////////////////////////////////////////////////
+const float *SubMesh::VertexData() const
+{
+  const SubMeshCompactData *data = CompactData(this, this->vertices);
+  return data ? data->vertexData.data() : nullptr;
+}
+
+//////////////////////////////////////////////////
+const float *SubMesh::NormalData() const
+{
+  const SubMeshCompactData *data = CompactData(this, this->vertices);
+  return data ? data->normalData.data() : nullptr;
+}
+
+//////////////////////////////////////////////////
+const float *SubMesh::TexCoordData() const
+{
+  const SubMeshCompactData *data = CompactData(this, this->vertices);
+  return data ? data->texCoordData.data() : nullptr;
 }
 
 //////////////////////////////////////////////////
@@ -135,6 +135,11 @@ namespace gazebo
       /// indices.
       public: void RecalculateNormals();
 
+      /// \brief Set the storage of all the submeshes, see
+      /// SubMesh::SetCompact.
+      /// \param[in] _compact True for compact storage.
+      public: void SetCompact(const bool _compact);
+
       /// \brief Get AABB coordinate
       /// \param[out] _center of the bounding box
       /// \param[out] _minXYZ bounding box minimum values
@@ -224,9 +229,18 @@ namespace gazebo
       // cppcheck-suppress noExplicitConstructor
       public: SubMesh(const SubMesh *_mesh);
 
+      /// \brief Copy constructor.
+      /// \param[in] _mesh Submesh to copy.
+      public: SubMesh(const SubMesh &_mesh);
+
       /// \brief Destructor
       public: virtual ~SubMesh();
 
+      /// \brief Assignment operator.
+      /// \param[in] _mesh Submesh to copy.
+      /// \return Reference to this submesh.
+      public: SubMesh &operator=(const SubMesh &_mesh);
+
       /// \brief Set the name of this mesh
       /// \param[in] _n the name to set
       public: void SetName(const std::string &_n);
@@ -396,6 +410,35 @@ namespace gazebo
       /// \param[in] _indArr
       public: void FillArrays(float **_vertArr, int **_indArr) const;
 
+      /// \brief Set whether the vertices, normals and texture coordinates
+      /// are stored in compact form: single precision values in one flat
+      /// array per attribute. Compact storage takes half the memory, and
+      /// the vertices are copied to FillArrays without any conversion.
+      /// Values are rounded to single precision when the storage becomes
+      /// compact.
+      /// \param[in] _compact True for compact storage.
+      public: void SetCompact(const bool _compact);
+
+      /// \brief Get whether the storage is compact, see SetCompact.
+      /// \return True if the storage is compact.
+      public: bool Compact() const;
+
+      /// \brief Get the flat array of vertex positions, in compact storage.
+      /// \return GetVertexCount() x, y, z triplets, or null if the storage
+      /// isn't compact.
+      public: const float *VertexData() const;
+
+      /// \brief Get the flat array of normals, in compact storage.
+      /// \return GetNormalCount() x, y, z triplets, or null if the storage
+      /// isn't compact.
+      public: const float *NormalData() const;
+
+      /// \brief Get the flat array of texture coordinates, in compact
+      /// storage.
+      /// \return GetTexCoordCount() u, v pairs, or null if the storage
+      /// isn't compact.
+      public: const float *TexCoordData() const;
+
       /// \brief Recalculate all the normals.
       public: void RecalculateNormals();
 
@@ -0,0 +1,669 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <ignition/math/Color.hh>
+#include <ignition/math/Vector2.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace
+{
+  /// \brief Magic bytes at the start of a cache file.
+  const char kMagic[] = "GZMESHC";
+
+  /// \brief Size of the magic bytes, including the terminating zero.
+  const size_t kMagicSize = 8;
+
+  /// \brief Byte order mark, which doesn't match on a host of another
+  /// byte order.
+  const uint32_t kByteOrderMark = 0x01020304;
+
+  /// \brief Extension of the cache files.
+  const char kExtension[] = ".gzmesh";
+
+  /// \brief Writes the binary representation of a mesh.
+  class Writer
+  {
+    /// \brief Append a value in host byte order.
+    /// \param[in] _value Value to append.
+    public: template<typename T> void Append(const T &_value)
+    {
+      this->data.append(reinterpret_cast<const char *>(&_value), sizeof(T));
+    }
+
+    /// \brief Append a length prefixed string.
+    /// \param[in] _str String to append.
+    public: void Append(const std::string &_str)
+    {
+      this->Append(static_cast<uint32_t>(_str.size()));
+      this->data.append(_str);
+    }
+
+    /// \brief Append an array, aligned on 8 bytes so that it can be used
+    /// in place once the file is mapped.
+    /// \param[in] _values Values to append.
+    public: template<typename T>
+            void AppendArray(const std::vector<T> &_values)
+    {
+      this->data.append((8 - this->data.size() % 8) % 8, '\0');
+      if (!_values.empty())
+      {
+        this->data.append(reinterpret_cast<const char *>(_values.data()),
+            _values.size() * sizeof(T));
+      }
+    }
+
+    /// \brief Encoded data.
+    public: std::string data;
+  };
+
+  /// \brief Reads the binary representation of a mesh, with bounds checks.
+  class Reader
+  {
+    /// \brief Constructor.
+    /// \param[in] _data Start of the data.
+    /// \param[in] _size Size of the data.
+    public: Reader(const char *_data, const size_t _size)
+      : data(_data), size(_size)
+    {
+    }
+
+    /// \brief Read a value in host byte order.
+    /// \param[out] _value Value read.
+    /// \return False if past the end of the data.
+    public: template<typename T> bool Read(T &_value)
+    {
+      if (this->size - this->pos < sizeof(T))
+        return false;
+      std::memcpy(&_value, this->data + this->pos, sizeof(T));
+      this->pos += sizeof(T);
+      return true;
+    }
+
+    /// \brief Read a length prefixed string.
+    /// \param[out] _str String read.
+    /// \return False if past the end of the data.
+    public: bool Read(std::string &_str)
+    {
+      uint32_t length = 0;
+      if (!this->Read(length) || this->size - this->pos < length)
+        return false;
+      _str.assign(this->data + this->pos, length);
+      this->pos += length;
+      return true;
+    }
+
+    /// \brief Read an array of values.
+    /// \param[in] _count Number of values.
+    /// \param[out] _values Values read.
+    /// \return False if past the end of the data.
+    public: template<typename T> bool ReadArray(const size_t _count,
+        std::vector<T> &_values)
+    {
+      this->pos += (8 - this->pos % 8) % 8;
+      if (this->pos > this->size ||
+          (this->size - this->pos) / sizeof(T) < _count)
+      {
+        return false;
+      }
+      _values.resize(_count);
+      if (_count > 0)
+      {
+        std::memcpy(_values.data(), this->data + this->pos,
+            _count * sizeof(T));
+      }
+      this->pos += _count * sizeof(T);
+      return true;
+    }
+
+    /// \brief Start of the data.
+    private: const char *data;
+
+    /// \brief Size of the data.
+    private: size_t size;
+
+    /// \brief Read position.
+    private: size_t pos = 0;
+  };
+
+  /////////////////////////////////////////////////
+  void AppendColor(Writer &_writer, const ignition::math::Color &_color)
+  {
+    _writer.Append(_color.R());
+    _writer.Append(_color.G());
+    _writer.Append(_color.B());
+    _writer.Append(_color.A());
+  }
+
+  /////////////////////////////////////////////////
+  bool ReadColor(Reader &_reader, ignition::math::Color &_color)
+  {
+    float r, g, b, a;
+    if (!_reader.Read(r) || !_reader.Read(g) || !_reader.Read(b) ||
+        !_reader.Read(a))
+    {
+      return false;
+    }
+    _color.Set(r, g, b, a);
+    return true;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Read a whole file.
+  /// \param[in] _filename Path to the file.
+  /// \param[out] _content Content of the file.
+  /// \return False if the file can't be read.
+  bool ReadFile(const std::string &_filename, std::string &_content)
+  {
+    std::ifstream file(_filename, std::ios::binary);
+    if (!file)
+      return false;
+
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    if (!file)
+      return false;
+
+    _content = stream.str();
+    return true;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Get the files a loader reads along with a mesh file: the
+  /// material libraries of an OBJ file. Textures are only referenced by
+  /// path, and are checked when a cached mesh is loaded.
+  /// \param[in] _filename Full path to the mesh file.
+  /// \param[in] _content Content of the mesh file.
+  /// \return Full paths to the dependent files.
+  std::vector<std::string> Dependencies(const std::string &_filename,
+      const std::string &_content)
+  {
+    std::vector<std::string> dependencies;
+
+    std::string extension = boost::filesystem::path(
+        _filename).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+        ::tolower);
+    if (extension != ".obj")
+      return dependencies;
+
+    // Same as OBJLoader, the libraries are relative to the OBJ file
+    const std::string dir = _filename.substr(0, _filename.rfind('/') + 1);
+
+    std::istringstream stream(_content);
+    std::string line;
+    while (std::getline(stream, line))
+    {
+      const size_t start = line.find_first_not_of(" \t");
+      if (start == std::string::npos ||
+          line.compare(start, 6, "mtllib") != 0 ||
+          line.size() <= start + 6 ||
+          (line[start + 6] != ' ' && line[start + 6] != '\t'))
+      {
+        continue;
+      }
+
+      // Names are separated by spaces, which may be escaped
+      std::string name;
+      bool escaping = false;
+      for (size_t i = start + 7; i <= line.size(); ++i)
+      {
+        const char ch = i < line.size() ? line[i] : ' ';
+        if (escaping)
+        {
+          escaping = false;
+          name += ch;
+        }
+        else if (ch == '\\')
+          escaping = true;
+        else if (ch == ' ' || ch == '\t' || ch == '\r')
+        {
+          if (!name.empty())
+            dependencies.push_back(dir + name);
+          name.clear();
+        }
+        else
+          name += ch;
+      }
+    }
+
+    return dependencies;
+  }
+}
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for MeshCache
+    class MeshCachePrivate
+    {
+      /// \brief Get the path of the cache file of a key.
+      /// \param[in] _key Key of the mesh.
+      /// \return Path to the file.
+      public: boost::filesystem::path File(const std::string &_key) const
+      {
+        return this->path / (_key + kExtension);
+      }
+
+      /// \brief Directory of the cache.
+      public: boost::filesystem::path path;
+
+      /// \brief Maximum size of the cache in bytes.
+      public: uint64_t maxSize = 0;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+MeshCache::MeshCache(const std::string &_path, const uint64_t _maxSize)
+  : dataPtr(new MeshCachePrivate)
+{
+  this->dataPtr->path = _path;
+  this->dataPtr->maxSize = _maxSize;
+}
+
+/////////////////////////////////////////////////
+MeshCache::~MeshCache()
+{
+}
+
+/////////////////////////////////////////////////
+std::string MeshCache::Path() const
+{
+  return this->dataPtr->path.string();
+}
+
+/////////////////////////////////////////////////
+uint64_t MeshCache::MaxSize() const
+{
+  return this->dataPtr->maxSize;
+}
+
+/////////////////////////////////////////////////
+uint64_t MeshCache::Size() const
+{
+  uint64_t size = 0;
+  boost::system::error_code ec;
+  for (boost::filesystem::directory_iterator iter(this->dataPtr->path, ec),
+       end; !ec && iter != end; iter.increment(ec))
+  {
+    if (iter->path().extension() == kExtension)
+    {
+      boost::system::error_code fileEc;
+      const uint64_t fileSize = boost::filesystem::file_size(iter->path(),
+          fileEc);
+      if (!fileEc)
+        size += fileSize;
+    }
+  }
+  return size;
+}
+
+/////////////////////////////////////////////////
+std::string MeshCache::Key(const std::string &_filename)
+{
+  std::string content;
+  if (!ReadFile(_filename, content))
+    return std::string();
+
+  std::ostringstream stream;
+  stream << kMagic << GZ_MESH_CACHE_VERSION << '\n' << _filename << '\0'
+         << content.size() << '\0' << content;
+
+  // A missing dependency is part of the key too, since the loader then
+  // falls back to defaults
+  for (auto const &dependency : Dependencies(_filename, content))
+  {
+    std::string dependencyContent;
+    stream << dependency << '\0';
+    if (ReadFile(dependency, dependencyContent))
+    {
+      stream << dependencyContent.size() << '\0' << dependencyContent;
+    }
+    else
+      stream << "missing" << '\0';
+  }
+
+  return get_sha1<std::string>(stream.str());
+}
+
+/////////////////////////////////////////////////
+Mesh *MeshCache::Load(const std::string &_key) const
+{
+  const boost::filesystem::path filePath = this->dataPtr->File(_key);
+
+  boost::system::error_code ec;
+  if (!boost::filesystem::exists(filePath, ec) ||
+      boost::filesystem::file_size(filePath, ec) == 0 || ec)
+  {
+    return nullptr;
+  }
+
+  boost::iostreams::mapped_file_source file;
+  try
+  {
+    file.open(filePath.string());
+  }
+  catch(std::exception &_e)
+  {
+    gzwarn << "Unable to open mesh cache file[" << filePath.string()
+           << "]: " << _e.what() << "\n";
+    return nullptr;
+  }
+
+  Reader reader(file.data(), file.size());
+
+  char magic[kMagicSize];
+  uint32_t version = 0;
+  uint32_t byteOrderMark = 0;
+  for (size_t i = 0; i < kMagicSize; ++i)
+  {
+    if (!reader.Read(magic[i]))
+      return nullptr;
+  }
+  if (std::memcmp(magic, kMagic, kMagicSize) != 0 ||
+      !reader.Read(version) || version != GZ_MESH_CACHE_VERSION ||
+      !reader.Read(byteOrderMark) || byteOrderMark != kByteOrderMark)
+  {
+    return nullptr;
+  }
+
+  std::unique_ptr<Mesh> mesh(new Mesh());
+
+  std::string meshPath;
+  uint32_t materialCount = 0;
+  if (!reader.Read(meshPath) || !reader.Read(materialCount))
+    return nullptr;
+  mesh->SetPath(meshPath);
+
+  for (uint32_t i = 0; i < materialCount; ++i)
+  {
+    std::unique_ptr<Material> material(new Material());
+    std::string texture;
+    ignition::math::Color ambient, diffuse, specular, emissive;
+    double transparency, shininess, srcFactor, dstFactor, pointSize;
+    uint32_t blendMode, shadeMode;
+    uint8_t depthWrite, lighting;
+    if (!reader.Read(texture) || !ReadColor(reader, ambient) ||
+        !ReadColor(reader, diffuse) || !ReadColor(reader, specular) ||
+        !ReadColor(reader, emissive) || !reader.Read(transparency) ||
+        !reader.Read(shininess) || !reader.Read(srcFactor) ||
+        !reader.Read(dstFactor) || !reader.Read(blendMode) ||
+        !reader.Read(shadeMode) || !reader.Read(pointSize) ||
+        !reader.Read(depthWrite) || !reader.Read(lighting) ||
+        blendMode >= Material::BLEND_COUNT ||
+        shadeMode >= Material::SHADE_COUNT)
+    {
+      return nullptr;
+    }
+
+    // The texture was found when the mesh was first loaded. Load the mesh
+    // again if it has moved since.
+    if (!texture.empty() && !boost::filesystem::exists(texture, ec))
+      return nullptr;
+
+    material->SetTextureImage(texture);
+    material->SetAmbient(ambient);
+    material->SetDiffuse(diffuse);
+    material->SetSpecular(specular);
+    material->SetEmissive(emissive);
+    material->SetTransparency(transparency);
+    material->SetShininess(shininess);
+    material->SetBlendFactors(srcFactor, dstFactor);
+    material->SetBlendMode(static_cast<Material::BlendMode>(blendMode));
+    material->SetShadeMode(static_cast<Material::ShadeMode>(shadeMode));
+    material->SetPointSize(pointSize);
+    material->SetDepthWrite(depthWrite != 0);
+    material->SetLighting(lighting != 0);
+    mesh->AddMaterial(material.release());
+  }
+
+  uint32_t subMeshCount = 0;
+  if (!reader.Read(subMeshCount))
+    return nullptr;
+
+  std::vector<double> vertices, normals, texCoords;
+  std::vector<uint32_t> indices;
+  for (uint32_t i = 0; i < subMeshCount; ++i)
+  {
+    std::string name;
+    uint32_t primitiveType;
+    int32_t materialIndex;
+    uint32_t vertexCount, normalCount, texCoordCount, indexCount;
+    if (!reader.Read(name) || !reader.Read(primitiveType) ||
+        !reader.Read(materialIndex) || !reader.Read(vertexCount) ||
+        !reader.Read(normalCount) || !reader.Read(texCoordCount) ||
+        !reader.Read(indexCount) ||
+        primitiveType > SubMesh::TRISTRIPS ||
+        !reader.ReadArray(3 * static_cast<size_t>(vertexCount), vertices) ||
+        !reader.ReadArray(3 * static_cast<size_t>(normalCount), normals) ||
+        !reader.ReadArray(2 * static_cast<size_t>(texCoordCount), texCoords) ||
+        !reader.ReadArray(indexCount, indices))
+    {
+      return nullptr;
+    }
+
+    SubMesh *subMesh = new SubMesh();
+    mesh->AddSubMesh(subMesh);
+    subMesh->SetName(name);
+    subMesh->SetPrimitiveType(static_cast<SubMesh::PrimitiveType>(
+        primitiveType));
+    subMesh->SetMaterialIndex(static_cast<unsigned int>(materialIndex));
+
+    subMesh->SetVertexCount(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v)
+    {
+      subMesh->SetVertex(v, ignition::math::Vector3d(
+          vertices[3*v], vertices[3*v+1], vertices[3*v+2]));
+    }
+    subMesh->SetNormalCount(normalCount);
+    for (uint32_t n = 0; n < normalCount; ++n)
+    {
+      subMesh->SetNormal(n, ignition::math::Vector3d(
+          normals[3*n], normals[3*n+1], normals[3*n+2]));
+    }
+    subMesh->SetTexCoordCount(texCoordCount);
+    for (uint32_t t = 0; t < texCoordCount; ++t)
+    {
+      subMesh->SetTexCoord(t, ignition::math::Vector2d(
+          texCoords[2*t], texCoords[2*t+1]));
+    }
+    for (uint32_t index : indices)
+      subMesh->AddIndex(index);
+  }
+
+  // Mark the file as recently used
+  boost::filesystem::last_write_time(filePath, std::time(nullptr), ec);
+
+  return mesh.release();
+}
+
+/////////////////////////////////////////////////
+bool MeshCache::Save(const std::string &_key, const Mesh *_mesh)
+{
+  if (_key.empty() || !_mesh || _mesh->HasSkeleton() ||
+      this->dataPtr->maxSize == 0)
+  {
+    return false;
+  }
+
+  Writer writer;
+  writer.data.append(kMagic, kMagicSize);
+  writer.Append(static_cast<uint32_t>(GZ_MESH_CACHE_VERSION));
+  writer.Append(kByteOrderMark);
+
+  writer.Append(_mesh->GetPath());
+  writer.Append(static_cast<uint32_t>(_mesh->GetMaterialCount()));
+  for (unsigned int i = 0; i < _mesh->GetMaterialCount(); ++i)
+  {
+    const Material *material = _mesh->GetMaterial(i);
+    double srcFactor, dstFactor;
+    material->GetBlendFactors(srcFactor, dstFactor);
+
+    writer.Append(material->GetTextureImage());
+    AppendColor(writer, material->Ambient());
+    AppendColor(writer, material->Diffuse());
+    AppendColor(writer, material->Specular());
+    AppendColor(writer, material->Emissive());
+    writer.Append(material->GetTransparency());
+    writer.Append(material->GetShininess());
+    writer.Append(srcFactor);
+    writer.Append(dstFactor);
+    writer.Append(static_cast<uint32_t>(material->GetBlendMode()));
+    writer.Append(static_cast<uint32_t>(material->GetShadeMode()));
+    writer.Append(material->GetPointSize());
+    writer.Append(static_cast<uint8_t>(material->GetDepthWrite()));
+    writer.Append(static_cast<uint8_t>(material->GetLighting()));
+  }
+
+  writer.Append(static_cast<uint32_t>(_mesh->GetSubMeshCount()));
+  std::vector<double> vertices, normals, texCoords;
+  std::vector<uint32_t> indices;
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh->GetSubMesh(i);
+    if (subMesh->GetNodeAssignmentsCount() > 0)
+      return false;
+
+    vertices.clear();
+    for (unsigned int v = 0; v < subMesh->GetVertexCount(); ++v)
+    {
+      const ignition::math::Vector3d vertex = subMesh->Vertex(v);
+      vertices.insert(vertices.end(), {vertex.X(), vertex.Y(), vertex.Z()});
+    }
+    normals.clear();
+    for (unsigned int n = 0; n < subMesh->GetNormalCount(); ++n)
+    {
+      const ignition::math::Vector3d normal = subMesh->Normal(n);
+      normals.insert(normals.end(), {normal.X(), normal.Y(), normal.Z()});
+    }
+    texCoords.clear();
+    for (unsigned int t = 0; t < subMesh->GetTexCoordCount(); ++t)
+    {
+      const ignition::math::Vector2d texCoord = subMesh->TexCoord(t);
+      texCoords.insert(texCoords.end(), {texCoord.X(), texCoord.Y()});
+    }
+    indices.clear();
+    for (unsigned int n = 0; n < subMesh->GetIndexCount(); ++n)
+      indices.push_back(subMesh->GetIndex(n));
+
+    writer.Append(subMesh->GetName());
+    writer.Append(static_cast<uint32_t>(subMesh->GetPrimitiveType()));
+    writer.Append(static_cast<int32_t>(subMesh->GetMaterialIndex()));
+    writer.Append(static_cast<uint32_t>(subMesh->GetVertexCount()));
+    writer.Append(static_cast<uint32_t>(subMesh->GetNormalCount()));
+    writer.Append(static_cast<uint32_t>(subMesh->GetTexCoordCount()));
+    writer.Append(static_cast<uint32_t>(subMesh->GetIndexCount()));
+    writer.AppendArray(vertices);
+    writer.AppendArray(normals);
+    writer.AppendArray(texCoords);
+    writer.AppendArray(indices);
+  }
+
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(this->dataPtr->path, ec);
+
+  // Write to a temporary file, and rename it, so that other processes
+  // never see a partial file.
+  const boost::filesystem::path filePath = this->dataPtr->File(_key);
+  const boost::filesystem::path tmpPath = this->dataPtr->path /
+    boost::filesystem::unique_path(_key + ".%%%%-%%%%.tmp", ec);
+  {
+    std::ofstream out(tmpPath.string(), std::ios::binary);
+    out.write(writer.data.data(), writer.data.size());
+    if (!out)
+    {
+      gzwarn << "Unable to write mesh cache file[" << tmpPath.string()
+             << "]\n";
+      out.close();
+      boost::filesystem::remove(tmpPath, ec);
+      return false;
+    }
+  }
+
+  boost::filesystem::rename(tmpPath, filePath, ec);
+  if (ec)
+  {
+    boost::filesystem::remove(tmpPath, ec);
+    return false;
+  }
+
+  this->Evict();
+  return boost::filesystem::exists(filePath, ec);
+}
+
+/////////////////////////////////////////////////
+void MeshCache::Evict()
+{
+  // Last use time, size and path of each file
+  std::vector<std::tuple<std::time_t, uint64_t, boost::filesystem::path>>
+    files;
+  uint64_t size = 0;
+
+  boost::system::error_code ec;
+  for (boost::filesystem::directory_iterator iter(this->dataPtr->path, ec),
+       end; !ec && iter != end; iter.increment(ec))
+  {
+    if (iter->path().extension() != kExtension)
+      continue;
+
+    boost::system::error_code fileEc;
+    const uint64_t fileSize = boost::filesystem::file_size(iter->path(),
+        fileEc);
+    const std::time_t time = boost::filesystem::last_write_time(
+        iter->path(), fileEc);
+    if (fileEc)
+      continue;
+
+    files.emplace_back(time, fileSize, iter->path());
+    size += fileSize;
+  }
+
+  if (size <= this->dataPtr->maxSize)
+    return;
+
+  std::sort(files.begin(), files.end());
+  for (auto const &file : files)
+  {
+    if (size <= this->dataPtr->maxSize)
+      break;
+
+    if (boost::filesystem::remove(std::get<2>(file), ec))
+      size -= std::get<1>(file);
+  }
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_MESHCACHE_HH_
+#define GAZEBO_COMMON_MESHCACHE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+/// \brief Version of the mesh cache file format. Files of other versions
+/// are ignored.
+#define GZ_MESH_CACHE_VERSION 2
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declarations
+    class Mesh;
+    class MeshCachePrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class MeshCache MeshCache.hh common/common.hh
+    /// \brief Persistent cache of loaded meshes.
+    ///
+    /// A mesh is stored in a binary file named after a SHA1 of the path
+    /// and content of its source file, and of the files loaded along with
+    /// it such as the material libraries of an OBJ file, so a changed
+    /// source file is loaded again. Textures are only stored by path, and
+    /// the mesh is loaded again if one of them was moved. The file holds
+    /// the materials and the flat vertex, normal, texture coordinate and
+    /// index buffers of each submesh, in the byte order of the host:
+    ///
+    ///   "GZMESHC\0" | uint32 version | uint32 byte order mark | mesh
+    ///
+    /// Loading a cached mesh copies the buffers out of the memory mapped
+    /// file, without any parsing. Meshes with a skeleton aren't cached.
+    /// When the cache grows past its maximum size, the least recently used
+    /// files are removed.
+    class GZ_COMMON_VISIBLE MeshCache
+    {
+      /// \brief Constructor.
+      /// \param[in] _path Directory of the cache. It's created when the
+      /// first mesh is saved.
+      /// \param[in] _maxSize Maximum size of the cache in bytes.
+      public: MeshCache(const std::string &_path, const uint64_t _maxSize);
+
+      /// \brief Destructor.
+      public: ~MeshCache();
+
+      /// \brief Get the directory of the cache.
+      /// \return Path to the directory.
+      public: std::string Path() const;
+
+      /// \brief Get the maximum size of the cache.
+      /// \return Size in bytes.
+      public: uint64_t MaxSize() const;
+
+      /// \brief Get the size of the files in the cache.
+      /// \return Size in bytes.
+      public: uint64_t Size() const;
+
+      /// \brief Compute the key of a mesh file.
+      /// \param[in] _filename Full path to the mesh file.
+      /// \return SHA1 of the path and content of the file and of its
+      /// dependencies, or an empty string if the file can't be read.
+      public: static std::string Key(const std::string &_filename);
+
+      /// \brief Load a mesh from the cache.
+      /// \param[in] _key Key of the mesh file, see Key().
+      /// \return A new mesh owned by the caller, or null if the mesh isn't
+      /// in the cache, or its cache file is invalid.
+      public: Mesh *Load(const std::string &_key) const;
+
+      /// \brief Save a mesh in the cache, and remove the least recently
+      /// used files if the cache is then too large.
+      /// \param[in] _key Key of the mesh file, see Key().
+      /// \param[in] _mesh Mesh loaded from the file.
+      /// \return True if the mesh was saved. Meshes with a skeleton aren't
+      /// saved.
+      public: bool Save(const std::string &_key, const Mesh *_mesh);
+
+      /// \brief Remove the least recently used files until the cache
+      /// isn't larger than its maximum size.
+      public: void Evict();
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<MeshCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
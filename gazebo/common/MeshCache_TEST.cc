@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "test_config.h"
+#include "gazebo/common/ColladaLoader.hh"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+#include "gazebo/common/STLLoader.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MeshCache : public gazebo::testing::AutoLogFixture
+{
+  /// \brief Create a temporary cache directory.
+  protected: virtual void SetUp()
+  {
+    gazebo::testing::AutoLogFixture::SetUp();
+    this->path = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gz_mesh_cache_%%%%%%%%");
+  }
+
+  /// \brief Remove the temporary cache directory.
+  protected: virtual void TearDown()
+  {
+    boost::filesystem::remove_all(this->path);
+    gazebo::testing::AutoLogFixture::TearDown();
+  }
+
+  /// \brief Temporary cache directory.
+  protected: boost::filesystem::path path;
+};
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, Key)
+{
+  const std::string box = std::string(PROJECT_SOURCE_PATH) +
+    "/test/data/box.dae";
+  const std::string boxOffset = std::string(PROJECT_SOURCE_PATH) +
+    "/test/data/box_offset.dae";
+
+  const std::string key = common::MeshCache::Key(box);
+  EXPECT_EQ(key.size(), 40u);
+  EXPECT_EQ(common::MeshCache::Key(box), key);
+  EXPECT_NE(common::MeshCache::Key(boxOffset), key);
+  EXPECT_TRUE(common::MeshCache::Key(
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/missing.dae").empty());
+}
+
+/////////////////////////////////////////////////
+/// \brief The key of an OBJ file depends on its material libraries.
+TEST_F(MeshCache, KeyDependencies)
+{
+  boost::filesystem::create_directories(this->path / "obj");
+  const std::string obj = (this->path / "obj" / "box.obj").string();
+  const std::string mtl = (this->path / "obj" / "box.mtl").string();
+  {
+    std::ofstream file(obj);
+    file << "mtllib box.mtl\n"
+         << "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+         << "usemtl red\nf 1 2 3\n";
+  }
+  {
+    std::ofstream file(mtl);
+    file << "newmtl red\nKd 1 0 0\n";
+  }
+
+  const std::string key = common::MeshCache::Key(obj);
+  EXPECT_EQ(key.size(), 40u);
+  EXPECT_EQ(common::MeshCache::Key(obj), key);
+
+  {
+    std::ofstream file(mtl);
+    file << "newmtl red\nKd 0 1 0\n";
+  }
+  const std::string changedKey = common::MeshCache::Key(obj);
+  EXPECT_EQ(changedKey.size(), 40u);
+  EXPECT_NE(changedKey, key);
+
+  boost::filesystem::remove(mtl);
+  const std::string missingKey = common::MeshCache::Key(obj);
+  EXPECT_EQ(missingKey.size(), 40u);
+  EXPECT_NE(missingKey, key);
+  EXPECT_NE(missingKey, changedKey);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, SaveLoad)
+{
+  const std::string filename = std::string(PROJECT_SOURCE_PATH) +
+    "/test/data/box.dae";
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(filename));
+  ASSERT_TRUE(mesh != nullptr);
+
+  common::MeshCache cache(this->path.string(), 1024 * 1024);
+  EXPECT_EQ(cache.Path(), this->path.string());
+  EXPECT_EQ(cache.MaxSize(), 1024u * 1024u);
+
+  const std::string key = common::MeshCache::Key(filename);
+  EXPECT_TRUE(cache.Load(key) == nullptr);
+  EXPECT_EQ(cache.Size(), 0u);
+
+  EXPECT_TRUE(cache.Save(key, mesh.get()));
+  EXPECT_GT(cache.Size(), 0u);
+
+  std::unique_ptr<common::Mesh> cached(cache.Load(key));
+  ASSERT_TRUE(cached != nullptr);
+  EXPECT_EQ(cached->GetPath(), mesh->GetPath());
+  EXPECT_FALSE(cached->HasSkeleton());
+
+  ASSERT_EQ(cached->GetMaterialCount(), mesh->GetMaterialCount());
+  for (unsigned int i = 0; i < mesh->GetMaterialCount(); ++i)
+  {
+    const common::Material *mat = mesh->GetMaterial(i);
+    const common::Material *cachedMat = cached->GetMaterial(i);
+    EXPECT_EQ(cachedMat->GetTextureImage(), mat->GetTextureImage());
+    EXPECT_EQ(cachedMat->Ambient(), mat->Ambient());
+    EXPECT_EQ(cachedMat->Diffuse(), mat->Diffuse());
+    EXPECT_EQ(cachedMat->Specular(), mat->Specular());
+    EXPECT_EQ(cachedMat->Emissive(), mat->Emissive());
+    EXPECT_DOUBLE_EQ(cachedMat->GetShininess(), mat->GetShininess());
+    EXPECT_DOUBLE_EQ(cachedMat->GetTransparency(), mat->GetTransparency());
+    EXPECT_EQ(cachedMat->GetBlendMode(), mat->GetBlendMode());
+    EXPECT_EQ(cachedMat->GetShadeMode(), mat->GetShadeMode());
+  }
+
+  ASSERT_EQ(cached->GetSubMeshCount(), mesh->GetSubMeshCount());
+  for (unsigned int i = 0; i < mesh->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *subMesh = mesh->GetSubMesh(i);
+    const common::SubMesh *cachedSubMesh = cached->GetSubMesh(i);
+    EXPECT_EQ(cachedSubMesh->GetName(), subMesh->GetName());
+    EXPECT_EQ(cachedSubMesh->GetPrimitiveType(),
+        subMesh->GetPrimitiveType());
+    EXPECT_EQ(cachedSubMesh->GetMaterialIndex(), subMesh->GetMaterialIndex());
+
+    ASSERT_EQ(cachedSubMesh->GetVertexCount(), subMesh->GetVertexCount());
+    for (unsigned int j = 0; j < subMesh->GetVertexCount(); ++j)
+      EXPECT_EQ(cachedSubMesh->Vertex(j), subMesh->Vertex(j));
+
+    ASSERT_EQ(cachedSubMesh->GetNormalCount(), subMesh->GetNormalCount());
+    for (unsigned int j = 0; j < subMesh->GetNormalCount(); ++j)
+      EXPECT_EQ(cachedSubMesh->Normal(j), subMesh->Normal(j));
+
+    ASSERT_EQ(cachedSubMesh->GetTexCoordCount(), subMesh->GetTexCoordCount());
+    for (unsigned int j = 0; j < subMesh->GetTexCoordCount(); ++j)
+      EXPECT_EQ(cachedSubMesh->TexCoord(j), subMesh->TexCoord(j));
+
+    ASSERT_EQ(cachedSubMesh->GetIndexCount(), subMesh->GetIndexCount());
+    for (unsigned int j = 0; j < subMesh->GetIndexCount(); ++j)
+      EXPECT_EQ(cachedSubMesh->GetIndex(j), subMesh->GetIndex(j));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, Skeleton)
+{
+  const std::string filename = std::string(PROJECT_SOURCE_PATH) +
+    "/test/data/box_with_animation_outside_skeleton.dae";
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(filename));
+  ASSERT_TRUE(mesh != nullptr);
+  ASSERT_TRUE(mesh->HasSkeleton());
+
+  // Meshes with a skeleton aren't cached
+  common::MeshCache cache(this->path.string(), 1024 * 1024);
+  const std::string key = common::MeshCache::Key(filename);
+  EXPECT_FALSE(cache.Save(key, mesh.get()));
+  EXPECT_TRUE(cache.Load(key) == nullptr);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, Invalid)
+{
+  const std::string filename = std::string(PROJECT_SOURCE_PATH) +
+    "/test/data/twoFaces.stl";
+  common::STLLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(filename));
+  ASSERT_TRUE(mesh != nullptr);
+
+  common::MeshCache cache(this->path.string(), 1024 * 1024);
+  const std::string key = common::MeshCache::Key(filename);
+  ASSERT_TRUE(cache.Save(key, mesh.get()));
+
+  // Truncated files are ignored
+  const boost::filesystem::path file = this->path / (key + ".gzmesh");
+  ASSERT_TRUE(boost::filesystem::exists(file));
+  const uintmax_t size = boost::filesystem::file_size(file);
+  for (uintmax_t truncatedSize : {size - 1, size / 2, uintmax_t(4)})
+  {
+    boost::filesystem::resize_file(file, truncatedSize);
+    EXPECT_TRUE(cache.Load(key) == nullptr) << truncatedSize;
+  }
+
+  // So are files of another format
+  {
+    std::ofstream out(file.string(), std::ios::binary);
+    out << "solid not a cache file";
+  }
+  EXPECT_TRUE(cache.Load(key) == nullptr);
+
+  // A disabled cache doesn't save anything
+  common::MeshCache disabled(this->path.string(), 0);
+  EXPECT_FALSE(disabled.Save(key, mesh.get()));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, Evict)
+{
+  const std::string filename = std::string(PROJECT_SOURCE_PATH) +
+    "/test/data/twoFaces.stl";
+  common::STLLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(filename));
+  ASSERT_TRUE(mesh != nullptr);
+
+  common::MeshCache unlimited(this->path.string(), 1024 * 1024);
+  ASSERT_TRUE(unlimited.Save("first", mesh.get()));
+  const uint64_t fileSize = unlimited.Size();
+  ASSERT_GT(fileSize, 0u);
+
+  // Room for three files
+  common::MeshCache cache(this->path.string(), 3 * fileSize);
+  for (int i = 0; i < 10; ++i)
+    cache.Save("key" + std::to_string(i), mesh.get());
+  EXPECT_EQ(cache.Size(), 3 * fileSize);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
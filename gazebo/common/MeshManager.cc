@@ -16,8 +16,18 @@
  */
 
 #include <sys/stat.h>
-#include <string>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <future>
 #include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+
+#include <boost/filesystem.hpp>
 
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Matrix3.hh>
@@ -31,10 +41,13 @@
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
 #include "gazebo/common/ColladaLoader.hh"
 #include "gazebo/common/ColladaExporter.hh"
 #include "gazebo/common/STLLoader.hh"
 #include "gazebo/common/OBJLoader.hh"
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/common/VertexGrid.hh"
 #include "gazebo/gazebo_config.h"
 
 #ifdef HAVE_GTS
@@ -51,15 +64,9 @@ namespace common
 //////////////////////////////////////////////////
 class MeshManagerPrivate
 {
-  /// \brief 3D mesh loader for COLLADA files
-  public: ColladaLoader *colladaLoader = nullptr;
-
   /// \brief 3D mesh exporter for COLLADA files
   public: ColladaExporter *colladaExporter = nullptr;
 
-  /// \brief 3D mesh loader for STL files
-  public: STLLoader *stlLoader = nullptr;
-
   // \brief 3D mesh loader for FBX files
   // \todo The FBX loader needs to be implemented.
   // public: FBXLoader *fbxLoader = nullptr;
@@ -67,25 +74,108 @@ class MeshManagerPrivate
   /// \brief Dictionary of meshes, indexed by name
   public: std::map<std::string, Mesh*> meshes;
 
+  /// \brief Meshes being loaded, indexed by name. Threads that request a
+  /// mesh that is being loaded wait for its result.
+  public: std::map<std::string, std::shared_future<Mesh *>> loading;
+
   /// \brief supported file extensions for meshes
   public: std::vector<std::string> fileExtensions;
 
-  /// \brief Mutex to protect from loading the same mesh in different threads
-  /// at the same time.
+  /// \brief Persistent cache of the meshes loaded from files, null if
+  /// disabled.
+  public: std::unique_ptr<MeshCache> cache;
+
+  /// \brief True to store the meshes loaded from files in compact form,
+  /// see SubMesh::SetCompact.
+  public: bool compact = false;
+
+  /// \brief Mutex to protect the meshes and the meshes being loaded. It
+  /// isn't held while a mesh is loaded, so that different meshes can be
+  /// loaded by different threads at the same time.
   public: boost::mutex mutex;
 };
 
-// added here for ABI compatibility
-// TODO move to header / private class when merging forward.
-static OBJLoader objLoader;
+//////////////////////////////////////////////////
+/// \brief Load a mesh file, from the mesh cache if possible. A new loader
+/// is used for each file, because the loaders keep the state of the file
+/// being loaded.
+/// \param[in] _filename Name of the mesh, used in error messages.
+/// \param[in] _fullname Full path to the mesh file.
+/// \param[in] _cache Mesh cache, null if disabled.
+/// \return The loaded mesh, or null on error.
+static Mesh *LoadMeshFile(const std::string &_filename,
+    const std::string &_fullname, MeshCache *_cache)
+{
+  std::string extension = _fullname.substr(_fullname.rfind(".")+1,
+      _fullname.size());
+  std::transform(extension.begin(), extension.end(),
+      extension.begin(), ::tolower);
+
+  std::unique_ptr<MeshLoader> loader;
+  if (extension == "stl" || extension == "stlb" || extension == "stla")
+    loader.reset(new STLLoader());
+  else if (extension == "dae")
+    loader.reset(new ColladaLoader());
+  else if (extension == "obj")
+    loader.reset(new OBJLoader());
+  else
+  {
+    gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
+    return nullptr;
+  }
+
+  std::string key;
+  if (_cache)
+  {
+    key = MeshCache::Key(_fullname);
+    Mesh *mesh = key.empty() ? nullptr : _cache->Load(key);
+    if (mesh)
+      return mesh;
+  }
+
+  Mesh *mesh = loader->Load(_fullname);
+  if (mesh && !key.empty())
+    _cache->Save(key, mesh);
+
+  return mesh;
+}
+
+//////////////////////////////////////////////////
+/// \brief Find the mesh files referenced by an SDF element.
+/// \param[in] _sdf SDF element to search.
+/// \param[in] _parentName Only search geometries inside elements with this
+/// name, unless it is empty.
+/// \param[in] _inParent True if _sdf is inside an element named _parentName.
+/// \param[out] _filenames The full paths of the meshes are added to this.
+static void FindMeshFiles(const sdf::ElementPtr &_sdf,
+    const std::string &_parentName, const bool _inParent,
+    std::set<std::string> &_filenames)
+{
+  const bool inParent = _inParent || _parentName.empty() ||
+      _sdf->GetName() == _parentName;
+
+  if (inParent && _sdf->GetName() == "mesh" && _sdf->HasElement("uri"))
+  {
+    // Use the same name as MeshShape, so that it finds the mesh
+    std::string filename = common::find_file(common::asFullPath(
+        _sdf->Get<std::string>("uri"), _sdf->FilePath()));
+    if (!filename.empty() && filename != "__default__")
+      _filenames.insert(filename);
+    return;
+  }
+
+  for (sdf::ElementPtr child = _sdf->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    FindMeshFiles(child, _parentName, inParent, _filenames);
+  }
+}
 
 //////////////////////////////////////////////////
 MeshManager::MeshManager()
   : dataPtr(new MeshManagerPrivate)
 {
-  this->dataPtr->colladaLoader = new ColladaLoader();
   this->dataPtr->colladaExporter = new ColladaExporter();
-  this->dataPtr->stlLoader = new STLLoader();
 
   // Create some basic shapes
   this->CreatePlane("unit_plane",
@@ -119,14 +209,41 @@ MeshManager::MeshManager()
   this->dataPtr->fileExtensions.push_back("stlb");
   this->dataPtr->fileExtensions.push_back("dae");
   this->dataPtr->fileExtensions.push_back("obj");
+
+  // Meshes loaded from files are kept in a persistent cache when its size
+  // is set, in MiB.
+  uint64_t cacheSize = 0;
+  const char *cacheSizeEnv = common::getEnv("GAZEBO_MESH_CACHE_SIZE");
+  if (cacheSizeEnv)
+    cacheSize = std::strtoull(cacheSizeEnv, nullptr, 10);
+
+  std::string cachePath;
+  const char *cachePathEnv = common::getEnv("GAZEBO_MESH_CACHE_PATH");
+  if (cachePathEnv)
+    cachePath = cachePathEnv;
+  else
+  {
+    cachePath = (boost::filesystem::path(
+        SystemPaths::Instance()->GetLogPath()) / "mesh_cache").string();
+  }
+
+  if (cacheSize > 0)
+  {
+    this->dataPtr->cache.reset(
+        new MeshCache(cachePath, cacheSize * 1024 * 1024));
+  }
+
+  // Meshes loaded from files can be stored in single precision, which
+  // halves the memory taken by large meshes.
+  const char *compactEnv = common::getEnv("GAZEBO_MESH_COMPACT");
+  this->dataPtr->compact = compactEnv && std::string(compactEnv) != "" &&
+      std::string(compactEnv) != "0";
 }
 
 //////////////////////////////////////////////////
 MeshManager::~MeshManager()
 {
-  delete this->dataPtr->colladaLoader;
   delete this->dataPtr->colladaExporter;
-  delete this->dataPtr->stlLoader;
   for (auto &pairNameMesh : this->dataPtr->meshes)
   {
     delete pairNameMesh.second;
@@ -146,81 +263,133 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     return nullptr;
   }
 
-  Mesh *mesh = nullptr;
+  std::promise<Mesh *> promise;
+  std::shared_future<Mesh *> pending;
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    auto iter = this->dataPtr->meshes.find(_filename);
+    if (iter != this->dataPtr->meshes.end())
+      return iter->second;
+
+    // If another thread is loading the mesh, wait for it instead of
+    // loading it twice.
+    auto loadingIter = this->dataPtr->loading.find(_filename);
+    if (loadingIter != this->dataPtr->loading.end())
+      pending = loadingIter->second;
+    else
+      this->dataPtr->loading[_filename] = promise.get_future().share();
+  }
 
-  std::string extension;
+  if (pending.valid())
+    return pending.get();
 
-  if (this->HasMesh(_filename))
+  // Publish the result of this thread to the threads waiting for it
+  auto finish = [&](Mesh *_mesh)
   {
-    return this->dataPtr->meshes[_filename];
-
-    // This breaks trimesh geom. Each new trimesh should have a unique name.
-    /*
-    // erase mesh from this->dataPtr->meshes.
-    // This allows a mesh to be modified and
-    // inserted into gazebo again without closing gazebo.
-    std::map<std::string, Mesh*>::iterator iter;
-    iter = this->dataPtr->meshes.find(_filename);
-    delete iter->second;
-    iter->second = nullptr;
-    this->dataPtr->meshes.erase(iter);
-    */
-  }
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    if (_mesh)
+      this->dataPtr->meshes.insert(std::make_pair(_filename, _mesh));
+    this->dataPtr->loading.erase(_filename);
+  };
 
+  Mesh *mesh = nullptr;
   std::string fullname = common::find_file(_filename);
 
   if (!fullname.empty())
   {
-    extension = fullname.substr(fullname.rfind(".")+1, fullname.size());
-    std::transform(extension.begin(), extension.end(),
-        extension.begin(), ::tolower);
-    MeshLoader *loader = nullptr;
-
-    if (extension == "stl" || extension == "stlb" || extension == "stla")
-      loader = this->dataPtr->stlLoader;
-    else if (extension == "dae")
-      loader = this->dataPtr->colladaLoader;
-    else if (extension == "obj")
-      loader = &objLoader;
-    else
-    {
-      gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
-      return nullptr;
-    }
-
     try
     {
-      // This mutex prevents two threads from loading the same mesh at the
-      // same time.
-      boost::mutex::scoped_lock lock(this->dataPtr->mutex);
-      if (!this->HasMesh(_filename))
+      if ((mesh = LoadMeshFile(_filename, fullname,
+              this->dataPtr->cache.get())) != nullptr)
       {
-        if ((mesh = loader->Load(fullname)) != nullptr)
-        {
-          mesh->SetName(_filename);
-          this->dataPtr->meshes.insert(std::make_pair(_filename, mesh));
-        }
-        else
-          gzerr << "Unable to load mesh[" << fullname << "]\n";
+        mesh->SetName(_filename);
+        if (this->dataPtr->compact)
+          mesh->SetCompact(true);
       }
       else
-      {
-        mesh = this->dataPtr->meshes[_filename];
-      }
+        gzerr << "Unable to load mesh[" << fullname << "]\n";
     }
     catch(gazebo::common::Exception &e)
     {
+      finish(nullptr);
+      promise.set_exception(std::current_exception());
+
       gzerr << "Error loading mesh[" << fullname << "]\n";
       gzerr << e << "\n";
       gzthrow(e);
     }
+    catch(...)
+    {
+      finish(nullptr);
+      promise.set_exception(std::current_exception());
+      throw;
+    }
   }
   else
     gzerr << "Unable to find file[" << _filename << "]\n";
 
+  finish(mesh);
+  promise.set_value(mesh);
+
   return mesh;
 }
 
+//////////////////////////////////////////////////
+void MeshManager::Prefetch(const std::vector<std::string> &_filenames)
+{
+  if (_filenames.empty())
+    return;
+
+  // Each thread takes the next mesh to load until there are none left
+  std::atomic<size_t> next(0);
+  auto loadNext = [&]()
+  {
+    for (size_t i = next++; i < _filenames.size(); i = next++)
+    {
+      try
+      {
+        this->Load(_filenames[i]);
+      }
+      catch(...)
+      {
+        // Load has printed the error. It'll be printed again when the
+        // mesh is needed.
+      }
+    }
+  };
+
+  const size_t threadCount = std::min<size_t>(_filenames.size(),
+      std::max(1u, std::thread::hardware_concurrency()));
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < threadCount; ++i)
+    threads.emplace_back(loadNext);
+  loadNext();
+
+  for (auto &thread : threads)
+    thread.join();
+}
+
+//////////////////////////////////////////////////
+void MeshManager::Prefetch(const sdf::ElementPtr &_sdf,
+    const std::string &_parentName)
+{
+  if (!_sdf)
+    return;
+
+  std::set<std::string> filenames;
+  FindMeshFiles(_sdf, _parentName, false, filenames);
+
+  std::vector<std::string> toLoad;
+  for (auto const &filename : filenames)
+  {
+    if (this->IsValidFilename(filename) && !this->HasMesh(filename))
+      toLoad.push_back(filename);
+  }
+
+  this->Prefetch(toLoad);
+}
+
 //////////////////////////////////////////////////
 void MeshManager::Export(const Mesh *_mesh, const std::string &_filename,
     const std::string &_extension, bool _exportTextures)
@@ -257,28 +426,33 @@ void MeshManager::GetMeshAABB(const Mesh *_mesh,
     ignition::math::Vector3d &_center,
     ignition::math::Vector3d &_minXYZ, ignition::math::Vector3d &_maxXYZ)
 {
-  if (this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()]->GetAABB(_center, _minXYZ, _maxXYZ);
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->meshes.find(_mesh->GetName());
+  if (iter != this->dataPtr->meshes.end())
+    iter->second->GetAABB(_center, _minXYZ, _maxXYZ);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::GenSphericalTexCoord(const Mesh *_mesh,
     const ignition::math::Vector3d &_center)
 {
-  if (this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()]->GenSphericalTexCoord(_center);
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->meshes.find(_mesh->GetName());
+  if (iter != this->dataPtr->meshes.end())
+    iter->second->GenSphericalTexCoord(_center);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::AddMesh(Mesh *_mesh)
 {
-  if (!this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()] = _mesh;
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  this->dataPtr->meshes.insert(std::make_pair(_mesh->GetName(), _mesh));
 }
 
 //////////////////////////////////////////////////
 const Mesh *MeshManager::GetMesh(const std::string &_name) const
 {
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
 
   iter = this->dataPtr->meshes.find(_name);
@@ -295,6 +469,7 @@ bool MeshManager::HasMesh(const std::string &_name) const
   if (_name.empty())
     return false;
 
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
   iter = this->dataPtr->meshes.find(_name);
 
@@ -318,7 +493,7 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->AddMesh(mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -386,7 +561,7 @@ void MeshManager::CreatePlane(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->AddMesh(mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -466,7 +641,7 @@ void MeshManager::CreateBox(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->AddMesh(mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -767,7 +942,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     }
   }
 
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->AddMesh(mesh);
   return;
 }
 
@@ -783,7 +958,7 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->AddMesh(mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -884,7 +1059,7 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->AddMesh(mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -1001,7 +1176,7 @@ void MeshManager::CreateCone(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->AddMesh(mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -1118,7 +1293,7 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->AddMesh(mesh);
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
 
@@ -1339,28 +1514,37 @@ void MeshManager::CreateBoolean(const std::string &_name, const Mesh *_m1,
   MeshCSG csg;
   Mesh *mesh = csg.CreateBoolean(_m1, _m2, _operation, _offset);
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->AddMesh(mesh);
 }
 #endif
 
 //////////////////////////////////////////////////
 size_t MeshManager::AddUniquePointToVerticesTable(
                      std::vector<ignition::math::Vector2d> &_vertices,
+                     VertexGrid &_grid,
                      const ignition::math::Vector2d &_p,
                      double _tol)
 {
+  const ignition::math::Vector3d p(_p.X(), _p.Y(), 0);
+  std::vector<unsigned int> candidates;
+  _grid.Candidates(p, candidates);
+
+  // Return the first point within tolerance, as a scan of the table would
   double sqrTol = _tol * _tol;
-  for (auto i = 0u; i != _vertices.size(); ++i)
+  size_t r = _vertices.size();
+  for (const auto i : candidates)
   {
     auto v = _vertices[i] - _p;
     double d = (v.X() * v.X() + v.Y() * v.Y());
-    if ( d < sqrTol)
-    {
-      return i;
-    }
+    if (d < sqrTol && i < r)
+      r = i;
+  }
+
+  if (r == _vertices.size())
+  {
+    _vertices.push_back(_p);
+    _grid.Add(p, r);
   }
-  _vertices.push_back(_p);
-  size_t r =  _vertices.size() -1;
   return r;
 }
 
@@ -1371,15 +1555,22 @@ void MeshManager::ConvertPolylinesToVerticesAndEdges(
     std::vector<ignition::math::Vector2d> &_vertices,
     std::vector<ignition::math::Vector2i> &edges)
 {
+  VertexGrid grid(_tol);
+  for (auto i = 0u; i != _vertices.size(); ++i)
+  {
+    grid.Add(ignition::math::Vector3d(
+        _vertices[i].X(), _vertices[i].Y(), 0), i);
+  }
+
   for (auto poly : _polys)
   {
     ignition::math::Vector2d previous = poly[0];
     for (auto i = 1u; i != poly.size(); ++i)
     {
       auto p = poly[i];
-      auto startPointIndex = AddUniquePointToVerticesTable(_vertices,
+      auto startPointIndex = AddUniquePointToVerticesTable(_vertices, grid,
           previous, _tol);
-      auto endPointIndex = AddUniquePointToVerticesTable(_vertices,
+      auto endPointIndex = AddUniquePointToVerticesTable(_vertices, grid,
           p, _tol);
       // current end point is now the starting point for the next edge
       previous = p;
@@ -25,6 +25,7 @@
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Vector2.hh>
 #include <ignition/math/Vector3.hh>
+#include <sdf/sdf.hh>
 
 #include "gazebo/common/SingletonT.hh"
 #include "gazebo/common/CommonTypes.hh"
@@ -41,6 +42,7 @@ namespace gazebo
     class MeshManagerPrivate;
     class Mesh;
     class SubMesh;
+    class VertexGrid;
 
     /// \addtogroup gazebo_common Common
     /// \{
@@ -62,6 +64,20 @@ namespace gazebo
       /// \return a pointer to the created mesh
       public: const Mesh *Load(const std::string &_filename);
 
+      /// \brief Load meshes concurrently, so that later calls to Load
+      /// return them right away. Meshes that are already loaded, or being
+      /// loaded by another thread, are skipped.
+      /// \param[in] _filenames Paths to the meshes.
+      public: void Prefetch(const std::vector<std::string> &_filenames);
+
+      /// \brief Load concurrently all the meshes referenced by an SDF
+      /// element, such as a world, and its descendants.
+      /// \param[in] _sdf SDF element to search for <mesh> elements.
+      /// \param[in] _parentName If not empty, only load the meshes of
+      /// geometries inside elements with this name, e.g. "collision".
+      public: void Prefetch(const sdf::ElementPtr &_sdf,
+                  const std::string &_parentName = "");
+
       /// \brief Export a mesh to a file
       /// \param[in] _mesh Pointer to the mesh to be exported
       /// \param[in] _filename Exported file's path and name
@@ -252,12 +268,15 @@ namespace gazebo
       /// \brief Check a point againts a list, and only adds it to the list
       /// if it is not there already.
       /// \param[in] _vertices the vertex table where points are stored
+      /// \param[in] _grid grid of the vertex table, with cells of at least
+      /// _tol
       /// \param[in] _p the point coordinates
       /// \param[in] _tol the maximum distance under which 2 points are
       /// considered to be the same point.
       /// \return the index of the point.
       private: static size_t AddUniquePointToVerticesTable(
                       std::vector<ignition::math::Vector2d> &_vertices,
+                      VertexGrid &_grid,
                       const ignition::math::Vector2d &_p,
                       double _tol);
 
@@ -17,6 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "test_config.h"
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/MeshManager.hh"
@@ -266,6 +271,99 @@ TEST_F(MeshManager, CreateExtrudedPolylineInvalid)
   EXPECT_TRUE(!common::MeshManager::Instance()->HasMesh(meshName));
 }
 
+/////////////////////////////////////////////////
+TEST_F(MeshManager, ConcurrentLoad)
+{
+  const std::vector<std::string> filenames =
+  {
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae",
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/box_offset.dae",
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/box.obj",
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/twoFaces.stl"
+  };
+
+  // Every thread loads every mesh, in a different order
+  const size_t threadCount = 8;
+  std::vector<std::vector<const common::Mesh *>> meshes(threadCount,
+      std::vector<const common::Mesh *>(filenames.size(), nullptr));
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < threadCount; ++t)
+  {
+    threads.emplace_back([&, t]()
+    {
+      for (size_t i = 0; i < filenames.size(); ++i)
+      {
+        const size_t index = (i + t) % filenames.size();
+        meshes[t][index] =
+          common::MeshManager::Instance()->Load(filenames[index]);
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  // A mesh is loaded once, and shared by all the threads
+  for (size_t i = 0; i < filenames.size(); ++i)
+  {
+    ASSERT_TRUE(meshes[0][i] != nullptr) << filenames[i];
+    EXPECT_EQ(meshes[0][i]->GetName(), filenames[i]);
+    EXPECT_TRUE(common::MeshManager::Instance()->HasMesh(filenames[i]));
+    for (size_t t = 1; t < threadCount; ++t)
+      EXPECT_EQ(meshes[t][i], meshes[0][i]) << filenames[i];
+  }
+
+  // A missing mesh isn't loaded, and can be requested again
+  const std::string missing =
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/missing.dae";
+  EXPECT_TRUE(common::MeshManager::Instance()->Load(missing) == nullptr);
+  EXPECT_FALSE(common::MeshManager::Instance()->HasMesh(missing));
+  EXPECT_TRUE(common::MeshManager::Instance()->Load(missing) == nullptr);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, Prefetch)
+{
+  const std::string filename = std::string(PROJECT_SOURCE_PATH) +
+    "/test/data/box_with_multiple_geoms.dae";
+  const std::string missing =
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/missing.stl";
+
+  EXPECT_FALSE(common::MeshManager::Instance()->HasMesh(filename));
+  common::MeshManager::Instance()->Prefetch({filename, filename, missing});
+  EXPECT_TRUE(common::MeshManager::Instance()->HasMesh(filename));
+  EXPECT_FALSE(common::MeshManager::Instance()->HasMesh(missing));
+
+  // Only the meshes of collisions
+  const std::string visualFilename = std::string(PROJECT_SOURCE_PATH) +
+    "/test/data/box_with_default_stride.dae";
+  const std::string collisionFilename = std::string(PROJECT_SOURCE_PATH) +
+    "/test/data/box_nested_animation.dae";
+
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='model'>"
+    << "<link name='link'>"
+    << "  <visual name='v'><geometry><mesh>"
+    << "    <uri>" << visualFilename << "</uri>"
+    << "  </mesh></geometry></visual>"
+    << "  <collision name='c'><geometry><mesh>"
+    << "    <uri>" << collisionFilename << "</uri>"
+    << "  </mesh></geometry></collision>"
+    << "</link>"
+    << "</model>"
+    << "</sdf>";
+  sdf::SDFPtr sdf(new sdf::SDF());
+  sdf::init(sdf);
+  ASSERT_TRUE(sdf::readString(sdfStr.str(), sdf));
+
+  common::MeshManager::Instance()->Prefetch(sdf->Root(), "collision");
+  EXPECT_TRUE(common::MeshManager::Instance()->HasMesh(collisionFilename));
+  EXPECT_FALSE(common::MeshManager::Instance()->HasMesh(visualFilename));
+
+  common::MeshManager::Instance()->Prefetch(sdf->Root());
+  EXPECT_TRUE(common::MeshManager::Instance()->HasMesh(visualFilename));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
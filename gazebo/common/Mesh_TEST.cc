@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <memory>
 
 #include "test_config.h"
 #include "gazebo/common/ColladaLoader.hh"
@@ -334,6 +335,121 @@ TEST_F(MeshTest, STLRead)
   }
 }
 
+/////////////////////////////////////////////////
+// Test the compact storage of a submesh.
+TEST_F(MeshTest, Compact)
+{
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box_offset.dae"));
+  ASSERT_TRUE(mesh != nullptr);
+  const common::SubMesh *original = mesh->GetSubMesh("Cube");
+  ASSERT_TRUE(original != nullptr);
+  ASSERT_GT(original->GetTexCoordCount(), 0u);
+
+  common::SubMesh submesh(original);
+  EXPECT_FALSE(submesh.Compact());
+  EXPECT_TRUE(submesh.VertexData() == nullptr);
+  EXPECT_TRUE(submesh.NormalData() == nullptr);
+  EXPECT_TRUE(submesh.TexCoordData() == nullptr);
+
+  submesh.SetCompact(true);
+  EXPECT_TRUE(submesh.Compact());
+  ASSERT_EQ(submesh.GetVertexCount(), original->GetVertexCount());
+  ASSERT_EQ(submesh.GetNormalCount(), original->GetNormalCount());
+  ASSERT_EQ(submesh.GetTexCoordCount(), original->GetTexCoordCount());
+  ASSERT_EQ(submesh.GetIndexCount(), original->GetIndexCount());
+
+  // Values are rounded to single precision, and stored in flat arrays
+  const float *vertexData = submesh.VertexData();
+  const float *normalData = submesh.NormalData();
+  const float *texCoordData = submesh.TexCoordData();
+  ASSERT_TRUE(vertexData != nullptr);
+  ASSERT_TRUE(normalData != nullptr);
+  ASSERT_TRUE(texCoordData != nullptr);
+  for (unsigned int i = 0; i < submesh.GetVertexCount(); ++i)
+  {
+    const ignition::math::Vector3d v = original->Vertex(i);
+    EXPECT_FLOAT_EQ(vertexData[i * 3], v.X());
+    EXPECT_FLOAT_EQ(vertexData[i * 3 + 1], v.Y());
+    EXPECT_FLOAT_EQ(vertexData[i * 3 + 2], v.Z());
+    EXPECT_DOUBLE_EQ(submesh.Vertex(i).X(), vertexData[i * 3]);
+  }
+  for (unsigned int i = 0; i < submesh.GetNormalCount(); ++i)
+  {
+    const ignition::math::Vector3d n = original->Normal(i);
+    EXPECT_FLOAT_EQ(normalData[i * 3], n.X());
+    EXPECT_FLOAT_EQ(normalData[i * 3 + 1], n.Y());
+    EXPECT_FLOAT_EQ(normalData[i * 3 + 2], n.Z());
+  }
+  for (unsigned int i = 0; i < submesh.GetTexCoordCount(); ++i)
+  {
+    const ignition::math::Vector2d t = original->TexCoord(i);
+    EXPECT_FLOAT_EQ(texCoordData[i * 2], t.X());
+    EXPECT_FLOAT_EQ(texCoordData[i * 2 + 1], t.Y());
+  }
+
+  // The flat arrays are the same as with the double precision storage
+  float *vertArray = nullptr;
+  int *indArray = nullptr;
+  float *compactVertArray = nullptr;
+  int *compactIndArray = nullptr;
+  original->FillArrays(&vertArray, &indArray);
+  submesh.FillArrays(&compactVertArray, &compactIndArray);
+  for (unsigned int i = 0; i < submesh.GetVertexCount() * 3; ++i)
+    EXPECT_EQ(compactVertArray[i], vertArray[i]);
+  for (unsigned int i = 0; i < submesh.GetIndexCount(); ++i)
+    EXPECT_EQ(compactIndArray[i], indArray[i]);
+  delete [] vertArray;
+  delete [] indArray;
+  delete [] compactVertArray;
+  delete [] compactIndArray;
+
+  // Edits go to the compact storage
+  submesh.AddVertex(1, 2, 3);
+  EXPECT_EQ(submesh.GetVertexCount(), original->GetVertexCount() + 1);
+  EXPECT_EQ(submesh.Vertex(submesh.GetVertexCount() - 1),
+      ignition::math::Vector3d(1, 2, 3));
+  EXPECT_TRUE(submesh.HasVertex(ignition::math::Vector3d(1, 2, 3)));
+  EXPECT_EQ(submesh.GetVertexIndex(ignition::math::Vector3d(1, 2, 3)),
+      submesh.GetVertexCount() - 1);
+  submesh.SetVertexCount(original->GetVertexCount());
+
+  submesh.Center(ignition::math::Vector3d(1, 2, 3));
+  EXPECT_EQ(ignition::math::Vector3d(0, 1, 2), submesh.Min());
+  EXPECT_EQ(ignition::math::Vector3d(2, 3, 4), submesh.Max());
+  submesh.Scale(2);
+  EXPECT_EQ(ignition::math::Vector3d(0, 2, 4), submesh.Min());
+  EXPECT_EQ(ignition::math::Vector3d(4, 6, 8), submesh.Max());
+
+  // And back
+  submesh.SetCompact(false);
+  EXPECT_FALSE(submesh.Compact());
+  EXPECT_TRUE(submesh.VertexData() == nullptr);
+  EXPECT_EQ(submesh.GetVertexCount(), original->GetVertexCount());
+  EXPECT_EQ(submesh.GetNormalCount(), original->GetNormalCount());
+  EXPECT_EQ(submesh.GetTexCoordCount(), original->GetTexCoordCount());
+  EXPECT_EQ(ignition::math::Vector3d(0, 2, 4), submesh.Min());
+  EXPECT_EQ(ignition::math::Vector3d(4, 6, 8), submesh.Max());
+
+  // All the submeshes of a mesh
+  mesh->SetCompact(true);
+  for (unsigned int i = 0; i < mesh->GetSubMeshCount(); ++i)
+    EXPECT_TRUE(mesh->GetSubMesh(i)->Compact());
+
+  // Copies keep the compact storage
+  const common::SubMesh *compactSubmesh = mesh->GetSubMesh("Cube");
+  common::SubMesh copy(*compactSubmesh);
+  EXPECT_TRUE(copy.Compact());
+  EXPECT_TRUE(copy.VertexData() != compactSubmesh->VertexData());
+  EXPECT_EQ(copy.Vertex(0), compactSubmesh->Vertex(0));
+  common::SubMesh assigned;
+  assigned = *compactSubmesh;
+  EXPECT_TRUE(assigned.Compact());
+  EXPECT_EQ(assigned.GetVertexCount(), compactSubmesh->GetVertexCount());
+  EXPECT_EQ(assigned.Vertex(0), compactSubmesh->Vertex(0));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -151,6 +151,14 @@ namespace gazebo
       /// \param[in] _de  The derivative error.
       public: void GetErrors(double &_pe, double &_ie, double &_de);
 
+      /// \brief Set the PID error terms, to restore the state of the
+      /// controller. The previous proportional error is set to _pe, as it
+      /// is after an update.
+      /// \param[in] _pe  The proportional error.
+      /// \param[in] _ie  The integral error.
+      /// \param[in] _de  The derivative error.
+      public: void SetErrors(double _pe, double _ie, double _de);
+
       /// \brief Assignment operator
       /// \param[in] _p a reference to a PID to assign values from
       /// \return reference to this instance
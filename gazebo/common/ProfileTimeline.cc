@@ -0,0 +1,480 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <limits>
+#include <utility>
+
+#include "gazebo/common/ProfileTimelinePrivate.hh"
+#include "gazebo/common/ProfileTimeline.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Number of events kept per thread.
+static const size_t g_profileCapacity = 1 << 15;
+
+/// \brief Number of events kept for all the threads that exited. The
+/// oldest threads are dropped first.
+static const size_t g_profileRetiredCapacity = 4 * g_profileCapacity;
+
+/// \brief Deepest nesting of zones recorded on a thread.
+static const int g_profileMaxDepth = 64;
+
+/// \brief True while zones are recorded.
+static std::atomic<bool> g_profileEnabled(false);
+
+/// \brief True between the construction and the destruction of the
+/// timeline, so that threads exiting after it don't touch it.
+static std::atomic<bool> g_profileAlive(false);
+
+/// \brief A zone opened on a thread.
+struct ProfileOpenZone
+{
+  /// \brief Id of the zone.
+  uint32_t zone;
+
+  /// \brief False if recording was disabled when the zone was opened.
+  bool active;
+
+  /// \brief Start time of the zone.
+  uint64_t begin;
+
+  /// \brief Time of the previous lap, or the start time.
+  uint64_t lap;
+};
+
+/// \brief Zones opened on this thread.
+static thread_local ProfileOpenZone t_profileStack[g_profileMaxDepth];
+
+/// \brief Number of zones opened on this thread, including those deeper
+/// than g_profileMaxDepth.
+static thread_local int t_profileDepth = 0;
+
+/// \brief Owns the buffer of a thread, and frees it when the thread
+/// exits.
+class ProfileThreadOwner
+{
+  /// \brief Destructor. Keeps the events of the thread and frees its
+  /// ring buffer.
+  public: ~ProfileThreadOwner();
+
+  /// \brief Timeline private data the buffer belongs to.
+  public: ProfileTimelinePrivate *data = nullptr;
+
+  /// \brief Buffer of the thread, created when it first records a zone.
+  public: ProfileThreadBuffer *buffer = nullptr;
+};
+
+/// \brief Buffer of this thread.
+static thread_local ProfileThreadOwner t_profileOwner;
+
+/////////////////////////////////////////////////
+/// \brief Get the time of the steady clock.
+/// \return Time in nanoseconds.
+static uint64_t ProfileNow()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the buffer of the calling thread, creating it if needed.
+/// \param[in] _data Timeline private data.
+/// \return The buffer.
+static ProfileThreadBuffer *ThreadBuffer(ProfileTimelinePrivate &_data)
+{
+  if (!t_profileOwner.buffer)
+  {
+    std::lock_guard<std::mutex> lock(_data.mutex);
+    const uint32_t id = _data.nextThreadId++;
+    _data.buffers.emplace_back(new ProfileThreadBuffer(id, g_profileCapacity));
+    _data.buffers.back()->name = "Thread " + std::to_string(id);
+    t_profileOwner.data = &_data;
+    t_profileOwner.buffer = _data.buffers.back().get();
+  }
+  return t_profileOwner.buffer;
+}
+
+/////////////////////////////////////////////////
+/// \brief Record a zone in the buffer of the calling thread.
+/// \param[in] _data Timeline private data.
+/// \param[in] _zone Id of the zone.
+/// \param[in] _begin Start time of the zone.
+/// \param[in] _end End time of the zone.
+static void Record(ProfileTimelinePrivate &_data, const uint32_t _zone,
+    const uint64_t _begin, const uint64_t _end)
+{
+  ProfileThreadBuffer *buffer = ThreadBuffer(_data);
+  const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+  ProfileEventSlot &slot = buffer->events[head & (g_profileCapacity - 1)];
+
+  // Readers discard the slot while its sequence number is odd
+  slot.sequence.store(2 * head + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.begin.store(_begin, std::memory_order_relaxed);
+  slot.end.store(_end, std::memory_order_relaxed);
+  slot.zone.store(_zone, std::memory_order_relaxed);
+  slot.sequence.store(2 * head + 2, std::memory_order_release);
+
+  buffer->head.store(head + 1, std::memory_order_release);
+}
+
+/////////////////////////////////////////////////
+/// \brief Copy the events of a buffer that are still valid.
+/// \param[in] _buffer The buffer.
+/// \param[out] _events Events appended to.
+static void CopyEvents(const ProfileThreadBuffer &_buffer,
+    std::vector<ProfileEvent> &_events)
+{
+  const uint64_t capacity = _buffer.events.size();
+  const uint64_t head = _buffer.head.load(std::memory_order_acquire);
+  const uint64_t first = std::max(_buffer.tail.load(),
+      head > capacity ? head - capacity : 0);
+
+  for (uint64_t i = first; i < head; ++i)
+  {
+    const ProfileEventSlot &slot = _buffer.events[i & (capacity - 1)];
+
+    // The owning thread may be writing a newer event in the slot, or may
+    // have written one already.
+    const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * i + 2)
+      continue;
+
+    ProfileEvent event;
+    event.begin = slot.begin.load(std::memory_order_relaxed);
+    event.end = slot.end.load(std::memory_order_relaxed);
+    event.zone = slot.zone.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+      continue;
+
+    _events.push_back(event);
+  }
+}
+
+/////////////////////////////////////////////////
+ProfileThreadOwner::~ProfileThreadOwner()
+{
+  if (!this->buffer || !g_profileAlive)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->data->mutex);
+  auto &buffers = this->data->buffers;
+  auto iter = std::find_if(buffers.begin(), buffers.end(),
+      [this](const std::unique_ptr<ProfileThreadBuffer> &_buffer)
+      {
+        return _buffer.get() == this->buffer;
+      });
+  if (iter == buffers.end())
+    return;
+
+  ProfileRetiredThread retired;
+  retired.id = this->buffer->id;
+  retired.name = this->buffer->name;
+  CopyEvents(*this->buffer, retired.events);
+  buffers.erase(iter);
+
+  if (!retired.events.empty())
+  {
+    this->data->retiredEvents += retired.events.size();
+    this->data->retired.push_back(std::move(retired));
+
+    auto &threads = this->data->retired;
+    size_t dropped = 0;
+    while (this->data->retiredEvents > g_profileRetiredCapacity &&
+        dropped < threads.size())
+    {
+      this->data->retiredEvents -= threads[dropped++].events.size();
+    }
+    threads.erase(threads.begin(), threads.begin() + dropped);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a string as a JSON string.
+/// \param[in] _out Stream to write to.
+/// \param[in] _str The string.
+static void WriteJsonString(std::ostream &_out, const std::string &_str)
+{
+  _out << '"';
+  for (const char c : _str)
+  {
+    if (c == '"' || c == '\\')
+      _out << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      _out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+           << static_cast<int>(c) << std::dec << std::setfill(' ');
+    }
+    else
+      _out << c;
+  }
+  _out << '"';
+}
+
+/////////////////////////////////////////////////
+ProfileTimeline::ProfileTimeline()
+  : dataPtr(new ProfileTimelinePrivate)
+{
+  g_profileAlive = true;
+}
+
+/////////////////////////////////////////////////
+ProfileTimeline::~ProfileTimeline()
+{
+  g_profileEnabled = false;
+  g_profileAlive = false;
+}
+
+/////////////////////////////////////////////////
+void ProfileTimeline::SetEnabled(const bool _enabled)
+{
+  g_profileEnabled = _enabled;
+}
+
+/////////////////////////////////////////////////
+bool ProfileTimeline::Enabled() const
+{
+  return g_profileEnabled;
+}
+
+/////////////////////////////////////////////////
+uint32_t ProfileTimeline::RegisterZone(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->zoneIds.find(_name);
+  if (iter != this->dataPtr->zoneIds.end())
+    return iter->second;
+
+  const uint32_t id = static_cast<uint32_t>(this->dataPtr->zoneNames.size());
+  this->dataPtr->zoneNames.push_back(_name);
+  this->dataPtr->zoneIds[_name] = id;
+  return id;
+}
+
+/////////////////////////////////////////////////
+std::string ProfileTimeline::ZoneName(const uint32_t _id) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (_id >= this->dataPtr->zoneNames.size())
+    return std::string();
+  return this->dataPtr->zoneNames[_id];
+}
+
+/////////////////////////////////////////////////
+void ProfileTimeline::SetThreadName(const std::string &_name)
+{
+  ProfileThreadBuffer *buffer = ThreadBuffer(*this->dataPtr);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  buffer->name = _name;
+}
+
+/////////////////////////////////////////////////
+void ProfileTimeline::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto const &buffer : this->dataPtr->buffers)
+    buffer->tail = buffer->head.load();
+  this->dataPtr->retired.clear();
+  this->dataPtr->retiredEvents = 0;
+}
+
+/////////////////////////////////////////////////
+std::vector<ProfileZoneStats> ProfileTimeline::Stats(
+    const double _window) const
+{
+  std::vector<ProfileEvent> events;
+  std::vector<std::string> names;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    for (auto const &buffer : this->dataPtr->buffers)
+      CopyEvents(*buffer, events);
+    for (auto const &thread : this->dataPtr->retired)
+      events.insert(events.end(), thread.events.begin(), thread.events.end());
+    names = this->dataPtr->zoneNames;
+  }
+
+  const uint64_t now = ProfileNow();
+  const double window = std::max(0.0, _window) * 1e9;
+  const uint64_t from = window < static_cast<double>(now) ?
+    now - static_cast<uint64_t>(window) : 0;
+
+  std::vector<std::vector<uint64_t>> durations(names.size());
+  for (auto const &event : events)
+  {
+    if (event.end >= from && event.zone < durations.size())
+      durations[event.zone].push_back(event.end - event.begin);
+  }
+
+  std::vector<ProfileZoneStats> result;
+  for (size_t i = 0; i < durations.size(); ++i)
+  {
+    std::vector<uint64_t> &zone = durations[i];
+    if (zone.empty())
+      continue;
+
+    std::sort(zone.begin(), zone.end());
+    ProfileZoneStats stats;
+    stats.name = names[i];
+    stats.count = zone.size();
+    double sum = 0;
+    for (const uint64_t duration : zone)
+      sum += duration;
+    stats.mean = sum * 1e-9 / zone.size();
+    stats.p50 = zone[(zone.size() - 1) / 2] * 1e-9;
+    stats.p99 = zone[(zone.size() - 1) * 99 / 100] * 1e-9;
+    stats.max = zone.back() * 1e-9;
+    result.push_back(stats);
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+void ProfileTimeline::WriteStats(std::ostream &_out,
+    const double _window) const
+{
+  _out << std::setw(50) << std::left << "zone" << std::right
+       << std::setw(10) << "count"
+       << std::setw(12) << "mean(ms)"
+       << std::setw(12) << "p50(ms)"
+       << std::setw(12) << "p99(ms)"
+       << std::setw(12) << "max(ms)" << "\n";
+
+  for (auto const &stats : this->Stats(_window))
+  {
+    _out << std::setw(50) << std::left << stats.name << std::right
+         << std::setw(10) << stats.count << std::fixed << std::setprecision(4)
+         << std::setw(12) << stats.mean * 1e3
+         << std::setw(12) << stats.p50 * 1e3
+         << std::setw(12) << stats.p99 * 1e3
+         << std::setw(12) << stats.max * 1e3 << "\n";
+  }
+}
+
+/////////////////////////////////////////////////
+void ProfileTimeline::WriteTrace(std::ostream &_out) const
+{
+  std::vector<std::pair<uint32_t, std::string>> threads;
+  std::vector<std::pair<uint32_t, std::vector<ProfileEvent>>> events;
+  std::vector<std::string> names;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    for (auto const &thread : this->dataPtr->retired)
+    {
+      threads.emplace_back(thread.id, thread.name);
+      events.emplace_back(thread.id, thread.events);
+    }
+    for (auto const &buffer : this->dataPtr->buffers)
+    {
+      threads.emplace_back(buffer->id, buffer->name);
+      events.emplace_back(buffer->id, std::vector<ProfileEvent>());
+      CopyEvents(*buffer, events.back().second);
+    }
+    names = this->dataPtr->zoneNames;
+  }
+
+  // Timestamps start at the oldest zone
+  uint64_t start = std::numeric_limits<uint64_t>::max();
+  for (auto const &thread : events)
+  {
+    for (auto const &event : thread.second)
+      start = std::min(start, event.begin);
+  }
+
+  _out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (auto const &thread : threads)
+  {
+    _out << (first ? "\n" : ",\n")
+         << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":"
+         << thread.first << ",\"args\":{\"name\":";
+    WriteJsonString(_out, thread.second);
+    _out << "}}";
+    first = false;
+  }
+
+  _out << std::fixed << std::setprecision(3);
+  for (auto const &thread : events)
+  {
+    for (auto const &event : thread.second)
+    {
+      if (event.zone >= names.size())
+        continue;
+
+      _out << (first ? "\n" : ",\n") << "{\"name\":";
+      WriteJsonString(_out, names[event.zone]);
+      _out << ",\"cat\":\"gazebo\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+           << thread.first
+           << ",\"ts\":" << (event.begin - start) * 1e-3
+           << ",\"dur\":" << (event.end - event.begin) * 1e-3 << "}";
+      first = false;
+    }
+  }
+  _out << "\n]}\n";
+}
+
+/////////////////////////////////////////////////
+void ProfileTimeline::Begin(const uint32_t _zone)
+{
+  const int depth = t_profileDepth++;
+  if (depth >= g_profileMaxDepth)
+    return;
+
+  ProfileOpenZone &open = t_profileStack[depth];
+  open.zone = _zone;
+  open.active = g_profileEnabled.load(std::memory_order_relaxed);
+  if (open.active)
+  {
+    open.begin = ProfileNow();
+    open.lap = open.begin;
+  }
+}
+
+/////////////////////////////////////////////////
+void ProfileTimeline::End()
+{
+  if (t_profileDepth == 0)
+    return;
+
+  const int depth = --t_profileDepth;
+  if (depth >= g_profileMaxDepth || !t_profileStack[depth].active)
+    return;
+
+  const ProfileOpenZone &open = t_profileStack[depth];
+  Record(*ProfileTimeline::Instance()->dataPtr, open.zone, open.begin,
+      ProfileNow());
+}
+
+/////////////////////////////////////////////////
+void ProfileTimeline::Lap(const uint32_t _zone)
+{
+  const int depth = t_profileDepth - 1;
+  if (depth < 0 || depth >= g_profileMaxDepth ||
+      !t_profileStack[depth].active)
+  {
+    return;
+  }
+
+  ProfileOpenZone &open = t_profileStack[depth];
+  const uint64_t now = ProfileNow();
+  Record(*ProfileTimeline::Instance()->dataPtr, _zone, open.lap, now);
+  open.lap = now;
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_PROFILETIMELINE_HH_
+#define GAZEBO_COMMON_PROFILETIMELINE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_COMMON_VISIBLE, gazebo, common, ProfileTimeline)
+
+/// \brief Helpers to give the variables of the profiling macros unique
+/// names.
+#define GZ_PROFILE_CONCAT_IMPL(_a, _b) _a##_b
+#define GZ_PROFILE_CONCAT(_a, _b) GZ_PROFILE_CONCAT_IMPL(_a, _b)
+
+/// \brief Record a profiling zone from this point to the end of the
+/// enclosing scope. The zone is registered once, the first time the line
+/// runs.
+/// \param[in] _name Name of the zone, a string literal.
+#define GZ_PROFILE(_name) \
+  static const gazebo::common::ProfileZone \
+    GZ_PROFILE_CONCAT(gzProfileZone, __LINE__)(_name); \
+  const gazebo::common::ProfileScope \
+    GZ_PROFILE_CONCAT(gzProfileScope, __LINE__)( \
+        GZ_PROFILE_CONCAT(gzProfileZone, __LINE__))
+
+/// \brief Record a zone nested in the innermost open zone, from its start
+/// or its previous lap to now.
+/// \param[in] _name Name of the lap zone, a string literal.
+#define GZ_PROFILE_LAP(_name) \
+  do \
+  { \
+    static const gazebo::common::ProfileZone gzProfileLapZone(_name); \
+    gazebo::common::ProfileTimeline::Lap(gzProfileLapZone.Id()); \
+  } while (false)
+
+/// \brief Name the calling thread in the profiling timeline.
+/// \param[in] _name Name of the thread.
+#define GZ_PROFILE_THREAD_NAME(_name) \
+  gazebo::common::ProfileTimeline::Instance()->SetThreadName(_name)
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class ProfileTimelinePrivate;
+
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \brief Duration statistics of a profiling zone.
+    class GZ_COMMON_VISIBLE ProfileZoneStats
+    {
+      /// \brief Name of the zone.
+      public: std::string name;
+
+      /// \brief Number of times the zone was recorded.
+      public: uint64_t count = 0;
+
+      /// \brief Mean duration in seconds.
+      public: double mean = 0;
+
+      /// \brief Median duration in seconds.
+      public: double p50 = 0;
+
+      /// \brief 99th percentile of the duration in seconds.
+      public: double p99 = 0;
+
+      /// \brief Largest duration in seconds.
+      public: double max = 0;
+    };
+
+    /// \class ProfileTimeline ProfileTimeline.hh common/common.hh
+    /// \brief Timeline of profiling zones, recorded by every thread into a
+    /// ring buffer of its own without locking.
+    ///
+    /// Zones are added with the GZ_PROFILE and GZ_PROFILE_LAP macros. They
+    /// are always compiled in, and only read the clock once recording is
+    /// enabled with SetEnabled. The timeline can be exported as a Chrome
+    /// trace, which Perfetto and chrome://tracing can open, and rolling
+    /// statistics can be queried while recording.
+    ///
+    /// The ring buffer of a thread is freed when the thread exits. Its
+    /// events are kept until Clear, up to a fixed number of events for all
+    /// the exited threads.
+    class GZ_COMMON_VISIBLE ProfileTimeline :
+      public SingletonT<ProfileTimeline>
+    {
+      /// \brief Constructor
+      private: ProfileTimeline();
+
+      /// \brief Destructor
+      private: virtual ~ProfileTimeline();
+
+      /// \brief Enable or disable recording.
+      /// \param[in] _enabled True to record zones.
+      public: void SetEnabled(const bool _enabled);
+
+      /// \brief Get whether zones are recorded.
+      /// \return True if zones are recorded.
+      public: bool Enabled() const;
+
+      /// \brief Register a zone, or get the id of a zone registered with
+      /// the same name.
+      /// \param[in] _name Name of the zone.
+      /// \return Id of the zone.
+      public: uint32_t RegisterZone(const std::string &_name);
+
+      /// \brief Get the name of a zone.
+      /// \param[in] _id Id of the zone.
+      /// \return Name of the zone, empty if the id is unknown.
+      public: std::string ZoneName(const uint32_t _id) const;
+
+      /// \brief Name the calling thread.
+      /// \param[in] _name Name of the thread.
+      public: void SetThreadName(const std::string &_name);
+
+      /// \brief Drop all the recorded zones.
+      public: void Clear();
+
+      /// \brief Get the statistics of the zones that ended recently.
+      /// \param[in] _window Length of the window in seconds.
+      /// \return Statistics of each zone recorded in the window, in the
+      /// order the zones were registered.
+      public: std::vector<ProfileZoneStats> Stats(const double _window) const;
+
+      /// \brief Write the statistics of the zones that ended recently as a
+      /// table.
+      /// \param[in] _out Stream to write to.
+      /// \param[in] _window Length of the window in seconds.
+      public: void WriteStats(std::ostream &_out, const double _window) const;
+
+      /// \brief Write the recorded zones in the Chrome trace event format.
+      /// \param[in] _out Stream to write to.
+      public: void WriteTrace(std::ostream &_out) const;
+
+      /// \brief Open a zone on the calling thread.
+      /// \param[in] _zone Id of the zone.
+      public: static void Begin(const uint32_t _zone);
+
+      /// \brief Close the zone opened last on the calling thread.
+      public: static void End();
+
+      /// \brief Record a lap of the zone opened last on the calling thread.
+      /// \param[in] _zone Id of the lap zone.
+      public: static void Lap(const uint32_t _zone);
+
+      // Singleton implementation
+      private: friend class SingletonT<ProfileTimeline>;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<ProfileTimelinePrivate> dataPtr;
+    };
+
+    /// \brief A profiling zone registered once per call site.
+    class GZ_COMMON_VISIBLE ProfileZone
+    {
+      /// \brief Constructor
+      /// \param[in] _name Name of the zone.
+      public: explicit ProfileZone(const char *_name)
+              : id(ProfileTimeline::Instance()->RegisterZone(_name))
+              {
+              }
+
+      /// \brief Get the id of the zone.
+      /// \return Id of the zone.
+      public: uint32_t Id() const
+              {
+                return this->id;
+              }
+
+      /// \brief Id of the zone.
+      private: const uint32_t id;
+    };
+
+    /// \brief Records a zone while in scope.
+    class GZ_COMMON_VISIBLE ProfileScope
+    {
+      /// \brief Constructor
+      /// \param[in] _zone Zone to record.
+      public: explicit ProfileScope(const ProfileZone &_zone)
+              {
+                ProfileTimeline::Begin(_zone.Id());
+              }
+
+      /// \brief Destructor
+      public: ~ProfileScope()
+              {
+                ProfileTimeline::End();
+              }
+
+      /// \brief Not copyable.
+      public: ProfileScope(const ProfileScope &) = delete;
+
+      /// \brief Not assignable.
+      public: ProfileScope &operator=(const ProfileScope &) = delete;
+    };
+    /// \}
+  }
+}
+#endif
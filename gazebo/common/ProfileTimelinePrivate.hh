@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_PROFILETIMELINE_PRIVATE_HH_
+#define GAZEBO_COMMON_PROFILETIMELINE_PRIVATE_HH_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief A recorded zone.
+    class ProfileEvent
+    {
+      /// \brief Start time in nanoseconds of the steady clock.
+      public: uint64_t begin;
+
+      /// \brief End time in nanoseconds of the steady clock.
+      public: uint64_t end;
+
+      /// \brief Id of the zone.
+      public: uint32_t zone;
+    };
+
+    /// \internal
+    /// \brief Slot of a ring buffer, holding one event. The fields are
+    /// atomic so that readers may copy a slot while the owning thread
+    /// writes it, and the sequence number tells them whether the copy is
+    /// valid.
+    class ProfileEventSlot
+    {
+      /// \brief Twice the index of the event in the slot plus one while
+      /// the event is written, plus two once it is written. Zero if the
+      /// slot was never written.
+      public: std::atomic<uint64_t> sequence{0};
+
+      /// \brief Start time in nanoseconds of the steady clock.
+      public: std::atomic<uint64_t> begin{0};
+
+      /// \brief End time in nanoseconds of the steady clock.
+      public: std::atomic<uint64_t> end{0};
+
+      /// \brief Id of the zone.
+      public: std::atomic<uint32_t> zone{0};
+    };
+
+    /// \internal
+    /// \brief Ring buffer of the zones recorded by one thread. Only the
+    /// owning thread writes events, and readers discard the slots that
+    /// were overwritten while they were copied.
+    class ProfileThreadBuffer
+    {
+      /// \brief Constructor
+      /// \param[in] _id Id of the thread in the timeline.
+      /// \param[in] _capacity Number of events kept, a power of two.
+      public: ProfileThreadBuffer(const uint32_t _id, const size_t _capacity)
+              : id(_id), events(_capacity)
+              {
+              }
+
+      /// \brief Id of the thread in the timeline.
+      public: const uint32_t id;
+
+      /// \brief Name of the thread, protected by the timeline mutex.
+      public: std::string name;
+
+      /// \brief Ring of events.
+      public: std::vector<ProfileEventSlot> events;
+
+      /// \brief Number of events written since the thread started.
+      public: std::atomic<uint64_t> head{0};
+
+      /// \brief Events before this count were cleared.
+      public: std::atomic<uint64_t> tail{0};
+    };
+
+    /// \internal
+    /// \brief Zones recorded by a thread that exited, kept once its ring
+    /// buffer is freed.
+    class ProfileRetiredThread
+    {
+      /// \brief Id of the thread in the timeline.
+      public: uint32_t id;
+
+      /// \brief Name of the thread.
+      public: std::string name;
+
+      /// \brief Events of the thread, oldest first.
+      public: std::vector<ProfileEvent> events;
+    };
+
+    /// \internal
+    /// \brief Private data for the ProfileTimeline class
+    class ProfileTimelinePrivate
+    {
+      /// \brief Protects the zone registry and the list of buffers.
+      public: mutable std::mutex mutex;
+
+      /// \brief Zone names, indexed by zone id.
+      public: std::vector<std::string> zoneNames;
+
+      /// \brief Zone ids, indexed by name.
+      public: std::unordered_map<std::string, uint32_t> zoneIds;
+
+      /// \brief Buffers of the running threads that recorded zones.
+      public: std::vector<std::unique_ptr<ProfileThreadBuffer>> buffers;
+
+      /// \brief Zones of the threads that exited, oldest thread first, so
+      /// that they can still be exported.
+      public: std::vector<ProfileRetiredThread> retired;
+
+      /// \brief Number of events in retired.
+      public: size_t retiredEvents = 0;
+
+      /// \brief Id of the next thread that records a zone.
+      public: uint32_t nextThreadId = 1;
+    };
+  }
+}
+#endif
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gazebo/common/ProfileTimeline.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ProfileTimelineTest : public gazebo::testing::AutoLogFixture
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Find the statistics of a zone.
+/// \param[in] _stats Statistics of all the zones.
+/// \param[in] _name Name of the zone.
+/// \return Pointer to the statistics, null if the zone wasn't recorded.
+const common::ProfileZoneStats *FindStats(
+    const std::vector<common::ProfileZoneStats> &_stats,
+    const std::string &_name)
+{
+  for (auto const &stats : _stats)
+  {
+    if (stats.name == _name)
+      return &stats;
+  }
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+/// \brief Record a zone with two laps.
+void RecordZone()
+{
+  GZ_PROFILE("ProfileTimelineTest::Zone");
+  GZ_PROFILE_LAP("ProfileTimelineTest::Zone:first");
+  {
+    GZ_PROFILE("ProfileTimelineTest::Nested");
+  }
+  GZ_PROFILE_LAP("ProfileTimelineTest::Zone:second");
+}
+
+/////////////////////////////////////////////////
+TEST_F(ProfileTimelineTest, Disabled)
+{
+  common::ProfileTimeline *timeline = common::ProfileTimeline::Instance();
+  timeline->SetEnabled(false);
+  timeline->Clear();
+  EXPECT_FALSE(timeline->Enabled());
+
+  RecordZone();
+  EXPECT_TRUE(timeline->Stats(60).empty());
+
+  // Zones are registered once by name
+  const uint32_t id = timeline->RegisterZone("ProfileTimelineTest::Zone");
+  EXPECT_EQ(timeline->ZoneName(id), "ProfileTimelineTest::Zone");
+  EXPECT_EQ(timeline->RegisterZone("ProfileTimelineTest::Zone"), id);
+  EXPECT_TRUE(timeline->ZoneName(100000).empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ProfileTimelineTest, Stats)
+{
+  common::ProfileTimeline *timeline = common::ProfileTimeline::Instance();
+  timeline->Clear();
+  timeline->SetEnabled(true);
+
+  for (int i = 0; i < 100; ++i)
+    RecordZone();
+
+  // A zone opened while recording was disabled isn't recorded, nor are
+  // its laps.
+  timeline->SetEnabled(false);
+  {
+    GZ_PROFILE("ProfileTimelineTest::Zone");
+    timeline->SetEnabled(true);
+    GZ_PROFILE_LAP("ProfileTimelineTest::Zone:first");
+  }
+  timeline->SetEnabled(false);
+
+  std::vector<common::ProfileZoneStats> stats = timeline->Stats(60);
+  for (auto const &name : {"ProfileTimelineTest::Zone",
+      "ProfileTimelineTest::Zone:first", "ProfileTimelineTest::Nested",
+      "ProfileTimelineTest::Zone:second"})
+  {
+    const common::ProfileZoneStats *zone = FindStats(stats, name);
+    ASSERT_TRUE(zone != nullptr) << name;
+    EXPECT_EQ(zone->count, 100u) << name;
+    EXPECT_LE(zone->p50, zone->p99) << name;
+    EXPECT_LE(zone->p99, zone->max) << name;
+    EXPECT_LE(zone->mean, zone->max) << name;
+  }
+
+  // A zone lasts at least as long as its laps and nested zones
+  EXPECT_GE(FindStats(stats, "ProfileTimelineTest::Zone")->max,
+      FindStats(stats, "ProfileTimelineTest::Nested")->max);
+
+  std::ostringstream table;
+  timeline->WriteStats(table, 60);
+  EXPECT_NE(table.str().find("ProfileTimelineTest::Nested"),
+      std::string::npos);
+
+  timeline->Clear();
+  EXPECT_TRUE(timeline->Stats(60).empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ProfileTimelineTest, Threads)
+{
+  common::ProfileTimeline *timeline = common::ProfileTimeline::Instance();
+  timeline->Clear();
+  timeline->SetEnabled(true);
+
+  // More zones than a thread keeps
+  const int threadCount = 4;
+  const int zoneCount = 50000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t)
+  {
+    threads.emplace_back([t, zoneCount]()
+    {
+      GZ_PROFILE_THREAD_NAME("ProfileTimelineTest" + std::to_string(t));
+      for (int i = 0; i < zoneCount; ++i)
+      {
+        GZ_PROFILE("ProfileTimelineTest::Thread");
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  timeline->SetEnabled(false);
+
+  const std::vector<common::ProfileZoneStats> stats = timeline->Stats(60);
+  const common::ProfileZoneStats *zone =
+    FindStats(stats, "ProfileTimelineTest::Thread");
+  ASSERT_TRUE(zone != nullptr);
+  EXPECT_GT(zone->count, 0u);
+  EXPECT_LT(zone->count, static_cast<uint64_t>(threadCount * zoneCount));
+
+  std::ostringstream trace;
+  timeline->WriteTrace(trace);
+  const std::string json = trace.str();
+  EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+  EXPECT_NE(json.find("\"ProfileTimelineTest::Thread\""), std::string::npos);
+  EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+  for (int t = 0; t < threadCount; ++t)
+  {
+    EXPECT_NE(json.find("\"ProfileTimelineTest" + std::to_string(t) + "\""),
+        std::string::npos);
+  }
+  EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+}
+
+/////////////////////////////////////////////////
+TEST_F(ProfileTimelineTest, ReadWhileRecording)
+{
+  common::ProfileTimeline *timeline = common::ProfileTimeline::Instance();
+  timeline->Clear();
+  timeline->SetEnabled(true);
+
+  // The rings wrap around while they are read
+  std::atomic<bool> done(false);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; ++t)
+  {
+    threads.emplace_back([&done]()
+    {
+      while (!done)
+      {
+        GZ_PROFILE("ProfileTimelineTest::Write");
+      }
+    });
+  }
+
+  for (int i = 0; i < 20; ++i)
+  {
+    const std::vector<common::ProfileZoneStats> stats = timeline->Stats(60);
+    const common::ProfileZoneStats *zone =
+      FindStats(stats, "ProfileTimelineTest::Write");
+    if (!zone)
+      continue;
+
+    // Torn events would have end times from another zone
+    EXPECT_GE(zone->p50, 0.0);
+    EXPECT_LE(zone->max, 1.0);
+  }
+
+  done = true;
+  for (auto &thread : threads)
+    thread.join();
+  timeline->SetEnabled(false);
+  timeline->Clear();
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
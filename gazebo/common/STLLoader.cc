@@ -18,6 +18,7 @@
 #include <ctype.h>
 #include <stdio.h>
 #include <memory>
+#include <vector>
 
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Vector3.hh>
@@ -25,6 +26,7 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/STLLoader.hh"
+#include "gazebo/common/VertexGrid.hh"
 
 using namespace gazebo;
 using namespace common;
@@ -83,6 +85,11 @@ bool STLLoader::ReadAscii(FILE *_filein, Mesh *_mesh)
 
   SubMesh *subMesh = new SubMesh();
 
+  // Duplicated vertices are found in a grid instead of scanning all the
+  // vertices, with the tolerance of Vector3::Equal.
+  VertexGrid grid(1e-6);
+  std::vector<unsigned int> candidates;
+
   // Read the next line of the file into INPUT.
   while (fgets (input, LINE_MAX_LEN, _filein) != nullptr)
   {
@@ -138,7 +145,26 @@ bool STLLoader::ReadAscii(FILE *_filein, Mesh *_mesh)
 
         subMesh->AddVertex(vertex);
         subMesh->AddNormal(normal);
-        subMesh->AddIndex(subMesh->GetVertexIndex(vertex));
+
+        // Index the first vertex equal to this one, as GetVertexIndex does
+        const unsigned int last = subMesh->GetVertexCount() - 1;
+        unsigned int index = last;
+        bool copy = false;
+        grid.Candidates(vertex, candidates);
+        for (const auto candidate : candidates)
+        {
+          const ignition::math::Vector3d other = subMesh->Vertex(candidate);
+          if (candidate < index && other.Equal(vertex))
+            index = candidate;
+          copy = copy || (other.X() == vertex.X() &&
+              other.Y() == vertex.Y() && other.Z() == vertex.Z());
+        }
+
+        // A copy of a vertex in the grid can't be the first match of a
+        // later vertex, so it's left out
+        if (!copy)
+          grid.Add(vertex, last);
+        subMesh->AddIndex(index);
       }
 
       if (fgets (input, LINE_MAX_LEN, _filein) == nullptr)
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+#include <boost/functional/hash.hpp>
+
+#include "gazebo/common/VertexGrid.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for the VertexGrid class
+    class VertexGridPrivate
+    {
+      /// \brief Half size of the box searched around a position.
+      public: double margin;
+
+      /// \brief Size of the cells.
+      public: double cellSize;
+
+      /// \brief Vertex indices, by hash of their cell. Cells whose hashes
+      /// collide share their entries, which only adds candidates.
+      public: std::unordered_multimap<std::size_t, unsigned int> cells;
+    };
+  }
+}
+
+/// \brief Cell coordinates are clamped to this magnitude, so that very
+/// large or invalid positions don't overflow.
+static const double kMaxCell = 4503599627370496.0;
+
+/////////////////////////////////////////////////
+/// \brief Get the cell coordinate of a value.
+/// \param[in] _value Coordinate of a position.
+/// \param[in] _cellSize Size of the cells.
+/// \return Cell coordinate.
+static int64_t CellCoord(const double _value, const double _cellSize)
+{
+  const double cell = std::floor(_value / _cellSize);
+  if (cell > -kMaxCell && cell < kMaxCell)
+    return static_cast<int64_t>(cell);
+
+  // Also catches NaN
+  return static_cast<int64_t>(cell > 0 ? kMaxCell : -kMaxCell);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the hash of a cell.
+/// \param[in] _x Cell coordinate along x.
+/// \param[in] _y Cell coordinate along y.
+/// \param[in] _z Cell coordinate along z.
+/// \return Hash of the cell.
+static std::size_t CellHash(const int64_t _x, const int64_t _y,
+    const int64_t _z)
+{
+  std::size_t seed = 0;
+  boost::hash_combine(seed, _x);
+  boost::hash_combine(seed, _y);
+  boost::hash_combine(seed, _z);
+  return seed;
+}
+
+/////////////////////////////////////////////////
+VertexGrid::VertexGrid(const double _tolerance)
+  : dataPtr(new VertexGridPrivate)
+{
+  // The box is widened by half the tolerance so that rounding can't hide a
+  // candidate. Cells four times the tolerance mean that a box usually
+  // overlaps few cells.
+  if (_tolerance > 0 && std::isfinite(_tolerance))
+  {
+    this->dataPtr->margin = 1.5 * _tolerance;
+    this->dataPtr->cellSize = 4 * _tolerance;
+  }
+  else
+  {
+    this->dataPtr->margin = 0;
+    this->dataPtr->cellSize = 1.0;
+  }
+}
+
+/////////////////////////////////////////////////
+VertexGrid::~VertexGrid()
+{
+}
+
+/////////////////////////////////////////////////
+void VertexGrid::Add(const ignition::math::Vector3d &_vertex,
+    const unsigned int _index)
+{
+  const double size = this->dataPtr->cellSize;
+  this->dataPtr->cells.emplace(CellHash(CellCoord(_vertex.X(), size),
+      CellCoord(_vertex.Y(), size), CellCoord(_vertex.Z(), size)), _index);
+}
+
+/////////////////////////////////////////////////
+void VertexGrid::Candidates(const ignition::math::Vector3d &_vertex,
+    std::vector<unsigned int> &_indices) const
+{
+  _indices.clear();
+
+  const double size = this->dataPtr->cellSize;
+  const double margin = this->dataPtr->margin;
+  const int64_t minX = CellCoord(_vertex.X() - margin, size);
+  const int64_t maxX = CellCoord(_vertex.X() + margin, size);
+  const int64_t minY = CellCoord(_vertex.Y() - margin, size);
+  const int64_t maxY = CellCoord(_vertex.Y() + margin, size);
+  const int64_t minZ = CellCoord(_vertex.Z() - margin, size);
+  const int64_t maxZ = CellCoord(_vertex.Z() + margin, size);
+
+  // The box is smaller than a cell, so it overlaps 8 cells at most
+  std::size_t visited[8];
+  unsigned int visitedCount = 0;
+  for (int64_t i = minX; i <= maxX; ++i)
+  {
+    for (int64_t j = minY; j <= maxY; ++j)
+    {
+      for (int64_t k = minZ; k <= maxZ; ++k)
+      {
+        const std::size_t hash = CellHash(i, j, k);
+        if (std::find(visited, visited + visitedCount, hash) !=
+            visited + visitedCount)
+        {
+          continue;
+        }
+        visited[visitedCount++] = hash;
+
+        auto range = this->dataPtr->cells.equal_range(hash);
+        for (auto iter = range.first; iter != range.second; ++iter)
+          _indices.push_back(iter->second);
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+size_t VertexGrid::Size() const
+{
+  return this->dataPtr->cells.size();
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_VERTEXGRID_HH_
+#define GAZEBO_COMMON_VERTEXGRID_HH_
+
+#include <memory>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declarations
+    class VertexGridPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class VertexGrid VertexGrid.hh common/common.hh
+    /// \brief Hashed uniform grid of vertex indices, used to find the
+    /// duplicates of a vertex without scanning all the vertices.
+    ///
+    /// The grid only returns candidates: the vertices in the cells which
+    /// overlap the tolerance box of a position. The caller compares them
+    /// with its own test, which must not match vertices farther than the
+    /// tolerance along an axis.
+    class GZ_COMMON_VISIBLE VertexGrid
+    {
+      /// \brief Constructor.
+      /// \param[in] _tolerance Distance along each axis under which
+      /// vertices may be duplicates.
+      public: explicit VertexGrid(const double _tolerance);
+
+      /// \brief Destructor.
+      public: ~VertexGrid();
+
+      /// \brief Add a vertex.
+      /// \param[in] _vertex Position of the vertex.
+      /// \param[in] _index Index of the vertex.
+      public: void Add(const ignition::math::Vector3d &_vertex,
+                  const unsigned int _index);
+
+      /// \brief Get the vertices which may be within the tolerance of a
+      /// position.
+      /// \param[in] _vertex Position to look around.
+      /// \param[out] _indices Indices of the vertices, in no particular
+      /// order. The vector is cleared first.
+      public: void Candidates(const ignition::math::Vector3d &_vertex,
+                  std::vector<unsigned int> &_indices) const;
+
+      /// \brief Get the number of vertices in the grid.
+      /// \return Number of vertices.
+      public: size_t Size() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<VertexGridPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
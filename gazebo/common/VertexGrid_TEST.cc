@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gazebo/common/VertexGrid.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class VertexGridTest : public gazebo::testing::AutoLogFixture
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Check whether an index is in a list of candidates.
+/// \param[in] _indices Candidates.
+/// \param[in] _index Index to look for.
+/// \return True if the index is a candidate.
+static bool HasIndex(const std::vector<unsigned int> &_indices,
+    const unsigned int _index)
+{
+  return std::find(_indices.begin(), _indices.end(), _index) !=
+      _indices.end();
+}
+
+/////////////////////////////////////////////////
+TEST_F(VertexGridTest, Candidates)
+{
+  common::VertexGrid grid(1e-3);
+  EXPECT_EQ(grid.Size(), 0u);
+
+  std::vector<unsigned int> indices = {42};
+  grid.Candidates(ignition::math::Vector3d::Zero, indices);
+  EXPECT_TRUE(indices.empty());
+
+  grid.Add(ignition::math::Vector3d(1, 2, 3), 0);
+  grid.Add(ignition::math::Vector3d(1, 2, 3), 1);
+  grid.Add(ignition::math::Vector3d(-1, -2, -3), 2);
+  EXPECT_EQ(grid.Size(), 3u);
+
+  // Vertices within the tolerance along each axis are candidates, on
+  // either side of cell boundaries
+  for (const double offset : {-1e-3, -5e-4, 0.0, 5e-4, 1e-3})
+  {
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+      const ignition::math::Vector3d delta(axis == 0 ? offset : 0,
+          axis == 1 ? offset : 0, axis == 2 ? offset : 0);
+      grid.Candidates(ignition::math::Vector3d(1, 2, 3) + delta, indices);
+      EXPECT_TRUE(HasIndex(indices, 0)) << offset << " " << axis;
+      EXPECT_TRUE(HasIndex(indices, 1)) << offset << " " << axis;
+      EXPECT_FALSE(HasIndex(indices, 2)) << offset << " " << axis;
+
+      grid.Candidates(ignition::math::Vector3d(-1, -2, -3) + delta, indices);
+      EXPECT_TRUE(HasIndex(indices, 2)) << offset << " " << axis;
+    }
+  }
+
+  // Far vertices aren't
+  grid.Candidates(ignition::math::Vector3d(1, 2, 3.1), indices);
+  EXPECT_TRUE(indices.empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(VertexGridTest, Dense)
+{
+  // A line of vertices closer than the tolerance
+  common::VertexGrid grid(1e-6);
+  for (unsigned int i = 0; i < 1000; ++i)
+    grid.Add(ignition::math::Vector3d(i * 1e-7, 0, 0), i);
+
+  std::vector<unsigned int> indices;
+  for (unsigned int i = 0; i < 1000; ++i)
+  {
+    grid.Candidates(ignition::math::Vector3d(i * 1e-7, 0, 0), indices);
+    for (unsigned int j = 0; j < 1000; ++j)
+    {
+      if (std::abs(static_cast<int>(i) - static_cast<int>(j)) <= 10)
+        EXPECT_TRUE(HasIndex(indices, j)) << i << " " << j;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(VertexGridTest, Invalid)
+{
+  const double inf = std::numeric_limits<double>::infinity();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+
+  // Any tolerance gives a usable grid
+  for (const double tolerance : {0.0, -1.0, inf, nan, 1e-300})
+  {
+    common::VertexGrid grid(tolerance);
+    grid.Add(ignition::math::Vector3d(1, 2, 3), 0);
+
+    std::vector<unsigned int> indices;
+    grid.Candidates(ignition::math::Vector3d(1, 2, 3), indices);
+    EXPECT_TRUE(HasIndex(indices, 0)) << tolerance;
+  }
+
+  // And so do invalid and huge positions
+  common::VertexGrid grid(1e-6);
+  grid.Add(ignition::math::Vector3d(nan, 0, 0), 0);
+  grid.Add(ignition::math::Vector3d(inf, -inf, 0), 1);
+  grid.Add(ignition::math::Vector3d(1e300, -1e300, 0), 2);
+
+  std::vector<unsigned int> indices;
+  grid.Candidates(ignition::math::Vector3d(1e300, -1e300, 0), indices);
+  EXPECT_TRUE(HasIndex(indices, 2));
+  grid.Candidates(ignition::math::Vector3d(nan, 0, 0), indices);
+  EXPECT_TRUE(HasIndex(indices, 0));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -50,7 +50,7 @@ void help()
   << "  -r [ --record ]               Record state data.\n"
   << "  --record_encoding arg (=zlib) Compression encoding format for log "
   << "data \n"
-  << "                                (zlib|bz2|txt).\n"
+  << "                                (zlib|bz2|txt|bin).\n"
   << "  --record_path arg             Absolute path in which to store "
   << "state data.\n"
   << "  --record_period arg (=-1)     Recording period (seconds).\n"
@@ -70,6 +70,8 @@ void help()
   << "                                the world file.\n"
   << "  --lockstep                    Lockstep simulation so sensor update "
   <<                                  "rates are respected.\n"
+  << "  --parallel_model_update       Update independent models in "
+  <<                                  "parallel.\n"
   << "\n";
 }
 
@@ -283,7 +283,7 @@ void ContactManager::Clear()
 }
 
 /////////////////////////////////////////////////
-void ContactManager::PublishContacts()
+void ContactManager::PublishContacts(const bool _publish)
 {
 //  if (this->contacts.size() == 0)
 //    return;
@@ -296,7 +296,7 @@ void ContactManager::PublishContacts()
   }
 
   // publish to default topic, ~/physics/contacts
-  if (!transport::getMinimalComms())
+  if (_publish && !transport::getMinimalComms())
   {
     msgs::Contacts msg;
     for (unsigned int i = 0; i < this->contactIndex; ++i)
@@ -314,23 +314,36 @@ void ContactManager::PublishContacts()
 
   // publish to other custom topics
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  if (this->customContactPublishers.empty())
+    return;
+
+  const common::Time simTime = this->world->SimTime();
   boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
   for (iter = this->customContactPublishers.begin();
       iter != this->customContactPublishers.end(); ++iter)
   {
     ContactPublisher *contactPublisher = iter->second;
-    msgs::Contacts msg2;
-    for (unsigned int j = 0;
-        j < contactPublisher->contacts.size(); ++j)
+
+    // Deliver the contacts in process.
+    if (contactPublisher->callback)
+      contactPublisher->callback(contactPublisher->contacts, simTime);
+
+    // Only build a message if someone is listening to the topic.
+    if (_publish && contactPublisher->publisher->HasConnections())
     {
-      if (contactPublisher->contacts[j]->count == 0)
-        continue;
+      msgs::Contacts msg2;
+      for (unsigned int j = 0;
+          j < contactPublisher->contacts.size(); ++j)
+      {
+        if (contactPublisher->contacts[j]->count == 0)
+          continue;
 
-      msgs::Contact *contactMsg = msg2.add_contact();
-      contactPublisher->contacts[j]->FillMsg(*contactMsg);
+        msgs::Contact *contactMsg = msg2.add_contact();
+        contactPublisher->contacts[j]->FillMsg(*contactMsg);
+      }
+      msgs::Set(msg2.mutable_time(), simTime);
+      contactPublisher->publisher->Publish(msg2);
     }
-    msgs::Set(msg2.mutable_time(), this->world->SimTime());
-    contactPublisher->publisher->Publish(msg2);
     contactPublisher->contacts.clear();
   }
 }
@@ -436,6 +449,7 @@ void ContactManager::RemoveFilter(const std::string &_name)
   if (iter != customContactPublishers.end())
   {
     ContactPublisher *contactPublisher = iter->second;
+    contactPublisher->callback = nullptr;
     contactPublisher->contacts.clear();
     contactPublisher->collisionNames.clear();
     contactPublisher->collisions.clear();
@@ -445,6 +459,25 @@ void ContactManager::RemoveFilter(const std::string &_name)
   }
 }
 
+/////////////////////////////////////////////////
+bool ContactManager::SetFilterCallback(const std::string &_name,
+    const ContactCallback &_callback)
+{
+  std::string name = _name;
+  boost::replace_all(name, "::", "/");
+
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  auto iter = this->customContactPublishers.find(name);
+  if (iter == this->customContactPublishers.end())
+  {
+    gzerr << "Contact filter [" << _name << "] does not exist" << std::endl;
+    return false;
+  }
+
+  iter->second->callback = _callback;
+  return true;
+}
+
 /////////////////////////////////////////////////
 unsigned int ContactManager::GetFilterCount()
 {
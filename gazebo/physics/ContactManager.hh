@@ -18,6 +18,7 @@
 #ifndef GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 #define GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 
+#include <functional>
 #include <vector>
 #include <string>
 #include <map>
@@ -37,6 +38,16 @@ namespace gazebo
 {
   namespace physics
   {
+    /// \def ContactCallback
+    /// \brief Callback that receives the contacts of a filter in the
+    /// physics thread.
+    /// \param[in] _contacts Contacts of the filter. The contacts are owned by
+    /// the ContactManager and are only valid during the callback. Contacts
+    /// with a zero count have no contact points.
+    /// \param[in] _time Simulation time of the contacts.
+    typedef std::function<void (const std::vector<Contact *> &_contacts,
+        const common::Time &_time)> ContactCallback;
+
     /// \brief A custom contact publisher created for each contact filter
     /// in the Contact Manager.
     class GZ_PHYSICS_VISIBLE ContactPublisher
@@ -56,6 +67,10 @@ namespace gazebo
       /// \brief A list of contacts associated to the collisions.
       public: std::vector<Contact *> contacts;
 
+      /// \brief In process callback, receives the contacts before they are
+      /// published.
+      public: ContactCallback callback;
+
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
@@ -160,7 +175,9 @@ namespace gazebo
       public: void Clear();
 
       /// \brief Publish all contacts in a msgs::Contacts message.
-      public: void PublishContacts();
+      /// \param[in] _publish False to only deliver the contacts of the
+      /// filters, without publishing any message.
+      public: void PublishContacts(const bool _publish = true);
 
       /// \brief Set the contact count to zero.
       public: void ResetCount();
@@ -195,6 +212,20 @@ namespace gazebo
       /// param[in] _name Filter name.
       public: void RemoveFilter(const std::string &_name);
 
+      /// \brief Deliver the contacts of a filter to a callback, without
+      /// building and parsing a contacts message.
+      ///
+      /// The callback is called by PublishContacts, in the physics thread,
+      /// once per step. Consumers in the same process should use it instead
+      /// of subscribing to the filter topic. The topic is still published to
+      /// when it has subscribers. The callback is removed with the filter.
+      /// \param[in] _name Filter name.
+      /// \param[in] _callback Callback, or an empty function to remove the
+      /// callback.
+      /// \return False if the filter doesn't exist.
+      public: bool SetFilterCallback(const std::string &_name,
+                  const ContactCallback &_callback);
+
       /// \brief Get the number of filters in the contact manager.
       /// return Number of filters
       public: unsigned int GetFilterCount();
@@ -194,6 +194,58 @@ TEST_F(ContactManagerTest, NeverDropContacts)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, FilterCallback)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::ContactManager *manager = world->Physics()->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+
+  // No callback without a filter
+  EXPECT_FALSE(manager->SetFilterCallback("box_filter",
+      physics::ContactCallback()));
+
+  std::string topic = manager->CreateFilter("box_filter",
+      "box::link::collision");
+  EXPECT_FALSE(topic.empty());
+
+  unsigned int calls = 0;
+  unsigned int contactCount = 0;
+  common::Time contactTime;
+  EXPECT_TRUE(manager->SetFilterCallback("box_filter",
+      [&](const std::vector<physics::Contact *> &_contacts,
+          const common::Time &_time)
+      {
+        ++calls;
+        contactTime = _time;
+        for (auto const &contact : _contacts)
+        {
+          if (contact->count == 0)
+            continue;
+          ++contactCount;
+          EXPECT_TRUE(contact->collision1->GetScopedName() ==
+              "box::link::collision" ||
+              contact->collision2->GetScopedName() == "box::link::collision");
+        }
+      }));
+
+  // The box rests on the ground plane
+  world->Step(10);
+  EXPECT_EQ(calls, 10u);
+  EXPECT_GT(contactCount, 0u);
+  EXPECT_EQ(contactTime, world->SimTime());
+
+  // The callback is removed with the filter
+  manager->RemoveFilter("box_filter");
+  world->Step(1);
+  EXPECT_EQ(calls, 10u);
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -154,7 +154,13 @@ void Entity::SetStatic(const bool &_s)
   for (iter = this->children.begin(); iter != this->children.end(); ++iter)
   {
     EntityPtr e = boost::dynamic_pointer_cast<Entity>(*iter);
-    if (e)
+    if (!e)
+      continue;
+
+    // Links override SetStatic
+    if (e->HasType(Base::LINK))
+      boost::static_pointer_cast<Link>(e)->SetStatic(_s);
+    else
       e->SetStatic(_s);
   }
 }
@@ -17,6 +17,8 @@
 #include <functional>
 #include <map>
 #include <mutex>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <ignition/math/Helpers.hh>
@@ -26,9 +28,6 @@
 
 #include "gazebo/common/Events.hh"
 
-#include "gazebo/transport/Node.hh"
-#include "gazebo/transport/Subscriber.hh"
-
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Joint.hh"
@@ -47,8 +46,10 @@ using namespace physics;
 class gazebo::physics::GripperPrivate
 {
   /// \brief Callback used when the gripper contacts an object.
-  /// \param[in] _msg Message that contains contact information.
-  public: void OnContacts(ConstContactsPtr &_msg);
+  /// \param[in] _contacts Contacts of the gripper's filter.
+  /// \param[in] _time Simulation time of the contacts.
+  public: void OnContacts(const std::vector<Contact *> &_contacts,
+                          const common::Time &_time);
 
   /// \brief Update the gripper.
   public: void OnUpdate();
@@ -80,8 +81,12 @@ class gazebo::physics::GripperPrivate
   /// \brief The collisions for the links in the gripper.
   public: std::map<std::string, physics::CollisionPtr> collisions;
 
-  /// \brief The current contacts.
-  public: std::vector<msgs::Contact> contacts;
+  /// \brief Name of the contact filter, scoped by the model so that
+  /// grippers with the same name in different models don't share it.
+  public: std::string filterName;
+
+  /// \brief Scoped names of the collisions of the current contacts.
+  public: std::vector<std::pair<std::string, std::string>> contacts;
 
   /// \brief Mutex used to protect reading/writing the contact message.
   public: std::mutex mutexContacts;
@@ -124,12 +129,6 @@ class gazebo::physics::GripperPrivate
 
   /// \brief Name of the gripper.
   public: std::string name;
-
-  /// \brief Node for communication.
-  public: transport::NodePtr node;
-
-  /// \brief Subscription to contact messages from the physics engine.
-  public: transport::SubscriberPtr contactSub;
 };
 
 /////////////////////////////////////////////////
@@ -145,18 +144,20 @@ Gripper::Gripper(ModelPtr _model) : dataPtr(new GripperPrivate)
   this->dataPtr->attached = false;
 
   this->dataPtr->updateRate = common::Time(0, common::Time::SecToNano(0.75));
-
-  this->dataPtr->node = transport::NodePtr(new transport::Node());
 }
 
 /////////////////////////////////////////////////
 Gripper::~Gripper()
 {
-  if (this->dataPtr->world && this->dataPtr->world->Running())
+  // The filter calls back into the private data, so it's removed even
+  // when the world isn't running
+  if (!this->dataPtr->filterName.empty() && this->dataPtr->world &&
+      this->dataPtr->world->Physics() &&
+      this->dataPtr->world->Physics()->GetContactManager())
   {
     physics::ContactManager *mgr =
         this->dataPtr->world->Physics()->GetContactManager();
-    mgr->RemoveFilter(this->Name());
+    mgr->RemoveFilter(this->dataPtr->filterName);
   }
 
   this->dataPtr->model.reset();
@@ -167,8 +168,6 @@ Gripper::~Gripper()
 /////////////////////////////////////////////////
 void Gripper::Load(sdf::ElementPtr _sdf)
 {
-  this->dataPtr->node->Init(this->dataPtr->world->Name());
-
   this->dataPtr->name = _sdf->Get<std::string>("name");
   this->dataPtr->fixedJoint =
       this->dataPtr->world->Physics()->CreateJoint("fixed",
@@ -218,13 +217,12 @@ void Gripper::Load(sdf::ElementPtr _sdf)
     // this sensor
     physics::ContactManager *mgr =
         this->dataPtr->world->Physics()->GetContactManager();
-    std::string topic = mgr->CreateFilter(this->Name(),
-        this->dataPtr->collisions);
-    if (!this->dataPtr->contactSub)
-    {
-      this->dataPtr->contactSub = this->dataPtr->node->Subscribe(topic,
-          &GripperPrivate::OnContacts, this->dataPtr.get());
-    }
+    this->dataPtr->filterName =
+        this->dataPtr->model->GetScopedName() + "::" + this->Name();
+    mgr->CreateFilter(this->dataPtr->filterName, this->dataPtr->collisions);
+    mgr->SetFilterCallback(this->dataPtr->filterName,
+        std::bind(&GripperPrivate::OnContacts, this->dataPtr.get(),
+          std::placeholders::_1, std::placeholders::_2));
   }
   this->dataPtr->connections.push_back(event::Events::ConnectWorldUpdateEnd(
           std::bind(&GripperPrivate::OnUpdate, this->dataPtr.get())));
@@ -307,8 +305,8 @@ void GripperPrivate::HandleAttach()
   // needed.
   for (unsigned int i = 0; i < this->contacts.size(); ++i)
   {
-    std::string name1 = this->contacts[i].collision1();
-    std::string name2 = this->contacts[i].collision2();
+    const std::string &name1 = this->contacts[i].first;
+    const std::string &name2 = this->contacts[i].second;
 
     if (this->collisions.find(name1) == this->collisions.end())
     {
@@ -371,20 +369,19 @@ void GripperPrivate::HandleDetach()
 }
 
 /////////////////////////////////////////////////
-void GripperPrivate::OnContacts(ConstContactsPtr &_msg)
+void GripperPrivate::OnContacts(const std::vector<Contact *> &_contacts,
+    const common::Time &/*_time*/)
 {
-  for (int i = 0; i < _msg->contact_size(); ++i)
+  for (auto const &contact : _contacts)
   {
-    CollisionPtr collision1 = boost::dynamic_pointer_cast<Collision>(
-        this->world->EntityByName(_msg->contact(i).collision1()));
-    CollisionPtr collision2 = boost::dynamic_pointer_cast<Collision>(
-        this->world->EntityByName(_msg->contact(i).collision2()));
-
-    if ((collision1 && !collision1->IsStatic()) &&
-        (collision2 && !collision2->IsStatic()))
+    // The collisions are known, no need to look them up by name.
+    if (contact->count > 0 &&
+        (contact->collision1 && !contact->collision1->IsStatic()) &&
+        (contact->collision2 && !contact->collision2->IsStatic()))
     {
       std::lock_guard<std::mutex> lock(this->mutexContacts);
-      this->contacts.push_back(_msg->contact(i));
+      this->contacts.emplace_back(contact->collision1->GetScopedName(),
+          contact->collision2->GetScopedName());
     }
   }
 }
@@ -15,6 +15,7 @@
  *
 */
 
+#include <cmath>
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/transport/Node.hh"
@@ -24,6 +25,7 @@
 #include "gazebo/physics/Joint.hh"
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/Snapshot.hh"
 
 #include "gazebo/physics/JointControllerPrivate.hh"
 #include "gazebo/physics/JointController.hh"
@@ -31,6 +33,60 @@
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Apply the PID fields of a joint command message.
+/// \param[in] _msg PID fields of the message.
+/// \param[in,out] _pid PID controller to update.
+static void ApplyPid(const ignition::msgs::PID &_msg, common::PID &_pid)
+{
+  if (_msg.has_p_gain_optional())
+    _pid.SetPGain(_msg.p_gain_optional().data());
+
+  if (_msg.has_i_gain_optional())
+    _pid.SetIGain(_msg.i_gain_optional().data());
+
+  if (_msg.has_d_gain_optional())
+    _pid.SetDGain(_msg.d_gain_optional().data());
+
+  if (_msg.has_i_max_optional())
+    _pid.SetIMax(_msg.i_max_optional().data());
+
+  if (_msg.has_i_min_optional())
+    _pid.SetIMin(_msg.i_min_optional().data());
+
+  if (_msg.has_limit_optional())
+  {
+    _pid.SetCmdMax(_msg.limit_optional().data());
+    _pid.SetCmdMin(-_msg.limit_optional().data());
+  }
+}
+
+/// \brief Apply the PID fields of a joint command message.
+/// \param[in] _msg PID fields of the message.
+/// \param[in,out] _pid PID controller to update.
+static void ApplyPid(const msgs::PID &_msg, common::PID &_pid)
+{
+  if (_msg.has_p_gain())
+    _pid.SetPGain(_msg.p_gain());
+
+  if (_msg.has_i_gain())
+    _pid.SetIGain(_msg.i_gain());
+
+  if (_msg.has_d_gain())
+    _pid.SetDGain(_msg.d_gain());
+
+  if (_msg.has_i_max())
+    _pid.SetIMax(_msg.i_max());
+
+  if (_msg.has_i_min())
+    _pid.SetIMin(_msg.i_min());
+
+  if (_msg.has_limit())
+  {
+    _pid.SetCmdMax(_msg.limit());
+    _pid.SetCmdMin(-_msg.limit());
+  }
+}
+
 /////////////////////////////////////////////////
 JointController::JointController(ModelPtr _model)
   : dataPtr(new JointControllerPrivate)
@@ -51,6 +107,13 @@ JointController::JointController(ModelPtr _model)
     gzerr << "Error subscribing to topic [" << topic << "]\n";
   }
 
+  topic = "/" + modelName + "/joint_cmd_v";
+  if (!this->dataPtr->node.Subscribe(topic,
+      &JointController::OnJointCommands, this))
+  {
+    gzerr << "Error subscribing to topic [" << topic << "]\n";
+  }
+
   std::string service = "/" + modelName + "/joint_cmd_req";
   if (!this->dataPtr->node.Advertise(service,
       &JointController::OnJointCmdReq, this))
@@ -69,44 +132,58 @@ JointController::~JointController()
 /////////////////////////////////////////////////
 void JointController::AddJoint(JointPtr _joint)
 {
-  this->dataPtr->joints[_joint->GetScopedName()] = _joint;
-  this->dataPtr->posPids[_joint->GetScopedName()].Init(
-      1, 0.1, 0.01, 1, -1, 1000, -1000);
-  this->dataPtr->velPids[_joint->GetScopedName()].Init(
-      1, 0.1, 0.01, 1, -1, 1000, -1000);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  const std::string name = _joint->GetScopedName();
+  auto iter = this->dataPtr->indices.find(name);
+  if (iter == this->dataPtr->indices.end())
+  {
+    iter = this->dataPtr->indices.insert(std::make_pair(name,
+          static_cast<unsigned int>(this->dataPtr->commands.size()))).first;
+    this->dataPtr->commands.push_back(JointCommand());
+  }
+
+  JointCommand &cmd = this->dataPtr->commands[iter->second];
+  cmd.name = name;
+  cmd.joint = _joint;
+  cmd.posPid.Init(1, 0.1, 0.01, 1, -1, 1000, -1000);
+  cmd.velPid.Init(1, 0.1, 0.01, 1, -1, 1000, -1000);
 }
 
 /////////////////////////////////////////////////
 void JointController::RemoveJoint(Joint *_joint)
 {
-  if (_joint)
-  {
-    this->dataPtr->joints.erase(_joint->GetScopedName());
-    this->dataPtr->posPids.erase(_joint->GetScopedName());
-    this->dataPtr->velPids.erase(_joint->GetScopedName());
-  }
+  if (!_joint)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  auto iter = this->dataPtr->indices.find(_joint->GetScopedName());
+  if (iter == this->dataPtr->indices.end())
+    return;
+
+  this->dataPtr->commands.erase(
+      this->dataPtr->commands.begin() + iter->second);
+
+  // The joints after the removed one move down by one
+  this->dataPtr->indices.clear();
+  for (unsigned int i = 0; i < this->dataPtr->commands.size(); ++i)
+    this->dataPtr->indices[this->dataPtr->commands[i].name] = i;
 }
 
 /////////////////////////////////////////////////
 void JointController::Reset()
 {
-  // Reset setpoints and feed-forward.
-  this->dataPtr->positions.clear();
-  this->dataPtr->velocities.clear();
-  this->dataPtr->forces.clear();
-
-  std::map<std::string, common::PID>::iterator iter;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  for (iter = this->dataPtr->posPids.begin();
-    iter != this->dataPtr->posPids.end(); ++iter)
-  {
-    iter->second.Reset();
-  }
-
-  for (iter = this->dataPtr->velPids.begin();
-    iter != this->dataPtr->velPids.end(); ++iter)
+  // Reset setpoints and feed-forward.
+  for (auto &cmd : this->dataPtr->commands)
   {
-    iter->second.Reset();
+    cmd.hasForce = false;
+    cmd.hasPosition = false;
+    cmd.hasVelocity = false;
+    cmd.posPid.Reset();
+    cmd.velPid.Reset();
   }
 }
 
@@ -124,69 +201,40 @@ void JointController::Update()
   // TODO: fix this when World::ResetTime is improved
   if (stepTime > 0)
   {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
     IGN_PROFILE_BEGIN("forces");
-    if (!this->dataPtr->forces.empty())
+    for (auto &cmd : this->dataPtr->commands)
     {
-      std::map<std::string, double>::iterator iter;
-      for (iter = this->dataPtr->forces.begin();
-          iter != this->dataPtr->forces.end(); ++iter)
-      {
-        this->dataPtr->joints[iter->first]->SetForce(0, iter->second);
-      }
+      if (cmd.hasForce)
+        cmd.joint->SetForce(0, cmd.force);
     }
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("positions");
-    if (!this->dataPtr->positions.empty())
+    for (auto &cmd : this->dataPtr->commands)
     {
-      std::map<std::string, double>::iterator iter;
-
-      for (iter = this->dataPtr->positions.begin();
-           iter != this->dataPtr->positions.end(); ++iter)
+      if (cmd.hasPosition)
       {
-        double cmd = this->dataPtr->posPids[iter->first].Update(
-            this->dataPtr->joints[iter->first]->Position(0) -
-            iter->second, stepTime);
-        this->dataPtr->joints[iter->first]->SetForce(0, cmd);
+        double force = cmd.posPid.Update(
+            cmd.joint->Position(0) - cmd.position, stepTime);
+        cmd.joint->SetForce(0, force);
       }
     }
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("velocities");
-    if (!this->dataPtr->velocities.empty())
+    for (auto &cmd : this->dataPtr->commands)
     {
-      std::map<std::string, double>::iterator iter;
-
-      for (iter = this->dataPtr->velocities.begin();
-           iter != this->dataPtr->velocities.end(); ++iter)
+      if (cmd.hasVelocity)
       {
-        double cmd = this->dataPtr->velPids[iter->first].Update(
-            this->dataPtr->joints[iter->first]->GetVelocity(0) - iter->second,
-            stepTime);
-        this->dataPtr->joints[iter->first]->SetForce(0, cmd);
+        double force = cmd.velPid.Update(
+            cmd.joint->GetVelocity(0) - cmd.velocity, stepTime);
+        cmd.joint->SetForce(0, force);
       }
     }
     IGN_PROFILE_END();
   }
-
-  /* enable below if we want to set position kinematically
-  if (this->dataPtr->positions.size() > 0)
-  {
-    std::map<std::string, JointPtr>::iterator iter;
-    for (iter = this->dataPtr->joints.begin();
-         iter != this->dataPtr->joints.end(); ++iter)
-    {
-      if (this->dataPtr->positions.find(iter->first) ==
-          this->dataPtr->positions.end())
-      {
-        this->dataPtr->positions[iter->first] =
-          iter->second->Position(0);
-      }
-    }
-    this->SetJointPositions(this->dataPtr->positions);
-    this->dataPtr->positions.clear();
-  }
-  */
 }
 
 /////////////////////////////////////////////////
@@ -196,199 +244,153 @@ bool JointController::OnJointCmdReq(const ignition::msgs::StringMsg &_req,
   const std::string &jointName = _req.data();
   _rep.set_name(jointName);
 
-  if (this->dataPtr->forces.find(jointName) !=
-      this->dataPtr->forces.end())
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  auto iter = this->dataPtr->indices.find(jointName);
+  if (iter == this->dataPtr->indices.end())
+    return true;
+
+  const JointCommand &cmd = this->dataPtr->commands[iter->second];
+
+  if (cmd.hasForce)
+    _rep.mutable_force_optional()->set_data(cmd.force);
+
+  if (cmd.hasPosition)
+    _rep.mutable_position()->mutable_target_optional()->set_data(cmd.position);
+
+  if (cmd.hasVelocity)
+    _rep.mutable_velocity()->mutable_target_optional()->set_data(cmd.velocity);
+
+  _rep.mutable_position()->mutable_p_gain_optional()->set_data(
+      cmd.posPid.GetPGain());
+  _rep.mutable_position()->mutable_d_gain_optional()->set_data(
+      cmd.posPid.GetDGain());
+  _rep.mutable_position()->mutable_i_gain_optional()->set_data(
+      cmd.posPid.GetIGain());
+
+  _rep.mutable_velocity()->mutable_p_gain_optional()->set_data(
+      cmd.velPid.GetPGain());
+  _rep.mutable_velocity()->mutable_d_gain_optional()->set_data(
+      cmd.velPid.GetDGain());
+  _rep.mutable_velocity()->mutable_i_gain_optional()->set_data(
+      cmd.velPid.GetIGain());
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void JointController::OnJointCommand(const ignition::msgs::JointCmd &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  auto iter = this->dataPtr->indices.find(_msg.name());
+  if (iter == this->dataPtr->indices.end())
   {
-    _rep.mutable_force_optional()->set_data(this->dataPtr->forces[jointName]);
+    gzerr << "Unable to find joint[" << _msg.name() << "]\n";
+    return;
   }
 
-  if (this->dataPtr->positions.find(jointName) !=
-      this->dataPtr->positions.end())
+  JointCommand &cmd = this->dataPtr->commands[iter->second];
+
+  if (_msg.reset())
   {
-    _rep.mutable_position()->mutable_target_optional()->set_data(
-        this->dataPtr->positions[jointName]);
+    cmd.hasForce = false;
+    cmd.hasPosition = false;
+    cmd.hasVelocity = false;
   }
 
-  if (this->dataPtr->velocities.find(jointName) !=
-      this->dataPtr->velocities.end())
+  if (_msg.has_force_optional())
   {
-    _rep.mutable_velocity()->mutable_target_optional()->set_data(
-        this->dataPtr->velocities[jointName]);
+    cmd.force = _msg.force_optional().data();
+    cmd.hasForce = true;
   }
 
-  if (this->dataPtr->posPids.find(jointName) !=
-      this->dataPtr->posPids.end())
+  if (_msg.has_position())
   {
-    _rep.mutable_position()->mutable_p_gain_optional()->set_data(
-        this->dataPtr->posPids[jointName].GetPGain());
-    _rep.mutable_position()->mutable_d_gain_optional()->set_data(
-        this->dataPtr->posPids[jointName].GetDGain());
-    _rep.mutable_position()->mutable_i_gain_optional()->set_data(
-        this->dataPtr->posPids[jointName].GetIGain());
+    if (_msg.position().has_target_optional())
+    {
+      cmd.position = _msg.position().target_optional().data();
+      cmd.hasPosition = true;
+    }
+    ApplyPid(_msg.position(), cmd.posPid);
   }
 
-  if (this->dataPtr->velPids.find(jointName) !=
-      this->dataPtr->velPids.end())
+  if (_msg.has_velocity())
   {
-    _rep.mutable_velocity()->mutable_p_gain_optional()->set_data(
-        this->dataPtr->velPids[jointName].GetPGain());
-    _rep.mutable_velocity()->mutable_d_gain_optional()->set_data(
-        this->dataPtr->velPids[jointName].GetDGain());
-    _rep.mutable_velocity()->mutable_i_gain_optional()->set_data(
-        this->dataPtr->velPids[jointName].GetIGain());
+    if (_msg.velocity().has_target_optional())
+    {
+      cmd.velocity = _msg.velocity().target_optional().data();
+      cmd.hasVelocity = true;
+    }
+    ApplyPid(_msg.velocity(), cmd.velPid);
   }
-
-  return true;
 }
 
 /////////////////////////////////////////////////
-void JointController::OnJointCommand(const ignition::msgs::JointCmd &_msg)
+void JointController::OnJointCommands(const msgs::JointCmd_V &_msg)
 {
-  std::map<std::string, JointPtr>::iterator iter;
-  iter = this->dataPtr->joints.find(_msg.name());
-  if (iter != this->dataPtr->joints.end())
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  for (auto const &jointCmd : _msg.joint_cmd())
   {
-    if (_msg.reset())
+    auto iter = this->dataPtr->indices.find(jointCmd.name());
+    if (iter == this->dataPtr->indices.end())
     {
-      if (this->dataPtr->forces.find(_msg.name()) !=
-          this->dataPtr->forces.end())
-      {
-        this->dataPtr->forces.erase(this->dataPtr->forces.find(_msg.name()));
-      }
-
-      if (this->dataPtr->positions.find(_msg.name()) !=
-          this->dataPtr->positions.end())
-      {
-        this->dataPtr->positions.erase(
-            this->dataPtr->positions.find(_msg.name()));
-      }
-
-      if (this->dataPtr->velocities.find(_msg.name()) !=
-          this->dataPtr->velocities.end())
-      {
-        this->dataPtr->velocities.erase(
-            this->dataPtr->velocities.find(_msg.name()));
-      }
+      gzerr << "Unable to find joint[" << jointCmd.name() << "]\n";
+      continue;
     }
 
-    if (_msg.has_force_optional())
-      this->dataPtr->forces[_msg.name()] = _msg.force_optional().data();
+    JointCommand &cmd = this->dataPtr->commands[iter->second];
 
-    if (_msg.has_position())
+    if (jointCmd.reset())
     {
-      if (_msg.position().has_target_optional())
-      {
-        if (!this->SetPositionTarget(_msg.name(),
-            _msg.position().target_optional().data()))
-        {
-          gzerr << "Unable to set position target for joint["
-            << _msg.name() << "]. Joint is not found.\n";
-        }
-      }
-
-      if (_msg.position().has_p_gain_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetPGain(
-            _msg.position().p_gain_optional().data());
-      }
-
-      if (_msg.position().has_i_gain_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetIGain(
-            _msg.position().i_gain_optional().data());
-      }
-
-      if (_msg.position().has_d_gain_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetDGain(
-            _msg.position().d_gain_optional().data());
-      }
-
-      if (_msg.position().has_i_max_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetIMax(
-            _msg.position().i_max_optional().data());
-      }
-
-      if (_msg.position().has_i_min_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetIMin(
-            _msg.position().i_min_optional().data());
-      }
-
-      if (_msg.position().has_limit_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetCmdMax(
-            _msg.position().limit_optional().data());
-        this->dataPtr->posPids[_msg.name()].SetCmdMin(
-            -_msg.position().limit_optional().data());
-      }
+      cmd.hasForce = false;
+      cmd.hasPosition = false;
+      cmd.hasVelocity = false;
     }
 
-    if (_msg.has_velocity())
+    if (jointCmd.has_force())
     {
-      if (_msg.velocity().has_target_optional())
-      {
-        if (!this->SetVelocityTarget(_msg.name(),
-            _msg.velocity().target_optional().data()))
-        {
-          gzerr << "Unable to set velocity target for joint["
-            << _msg.name() << "]. Joint is not found.\n";
-        }
-      }
-
-      if (_msg.velocity().has_p_gain_optional())
-      {
-        this->dataPtr->velPids[_msg.name()].SetPGain(
-            _msg.velocity().p_gain_optional().data());
-      }
-
-      if (_msg.velocity().has_i_gain_optional())
-      {
-        this->dataPtr->velPids[_msg.name()].SetIGain(
-            _msg.velocity().i_gain_optional().data());
-      }
-
-      if (_msg.velocity().has_d_gain_optional())
-      {
-        this->dataPtr->velPids[_msg.name()].SetDGain(
-            _msg.velocity().d_gain_optional().data());
-      }
-
-      if (_msg.velocity().has_i_max_optional())
-      {
-        this->dataPtr->velPids[_msg.name()].SetIMax(
-            _msg.velocity().i_max_optional().data());
-      }
+      cmd.force = jointCmd.force();
+      cmd.hasForce = true;
+    }
 
-      if (_msg.velocity().has_i_min_optional())
+    if (jointCmd.has_position())
+    {
+      if (jointCmd.position().has_target())
       {
-        this->dataPtr->velPids[_msg.name()].SetIMin(
-            _msg.velocity().i_min_optional().data());
+        cmd.position = jointCmd.position().target();
+        cmd.hasPosition = true;
       }
+      ApplyPid(jointCmd.position(), cmd.posPid);
+    }
 
-      if (_msg.velocity().has_limit_optional())
+    if (jointCmd.has_velocity())
+    {
+      if (jointCmd.velocity().has_target())
       {
-        this->dataPtr->velPids[_msg.name()].SetCmdMax(
-            _msg.velocity().limit_optional().data());
-        this->dataPtr->velPids[_msg.name()].SetCmdMin(
-            -_msg.velocity().limit_optional().data());
+        cmd.velocity = jointCmd.velocity().target();
+        cmd.hasVelocity = true;
       }
+      ApplyPid(jointCmd.velocity(), cmd.velPid);
     }
   }
-  else
-    gzerr << "Unable to find joint[" << _msg.name() << "]\n";
 }
 
 //////////////////////////////////////////////////
 void JointController::SetJointPosition(const std::string & _name,
                                        double _position, int _index)
 {
-  std::map<std::string, JointPtr>::iterator jiter =
-    this->dataPtr->joints.find(_name);
+  JointPtr joint;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto iter = this->dataPtr->indices.find(_name);
+    if (iter != this->dataPtr->indices.end())
+      joint = this->dataPtr->commands[iter->second].joint;
+  }
 
-  if (jiter != this->dataPtr->joints.end())
-    this->SetJointPosition(jiter->second, _position, _index);
+  if (joint)
+    this->SetJointPosition(joint, _position, _index);
   else
     gzwarn << "SetJointPosition [" << _name << "] not found\n";
 }
@@ -399,24 +401,22 @@ void JointController::SetJointPositions(
 {
   // go through all joints in this model and update each one
   //   for each joint update, recursively update all children
-  std::map<std::string, JointPtr>::iterator iter;
   std::map<std::string, double>::const_iterator jiter;
 
-  for (iter = this->dataPtr->joints.begin();
-      iter != this->dataPtr->joints.end(); ++iter)
+  for (auto const &named : this->GetJoints())
   {
     // First try name without scope, i.e. joint_name
-    jiter = _jointPositions.find(iter->second->GetName());
+    jiter = _jointPositions.find(named.second->GetName());
 
     if (jiter == _jointPositions.end())
     {
       // Second try name with scope, i.e. model_name::joint_name
-      jiter = _jointPositions.find(iter->second->GetScopedName());
+      jiter = _jointPositions.find(named.second->GetScopedName());
       if (jiter == _jointPositions.end())
         continue;
     }
 
-    this->SetJointPosition(iter->second, jiter->second);
+    this->SetJointPosition(named.second, jiter->second);
   }
 }
 
@@ -436,48 +436,175 @@ common::Time JointController::GetLastUpdateTime() const
 /////////////////////////////////////////////////
 std::map<std::string, JointPtr> JointController::GetJoints() const
 {
-  return this->dataPtr->joints;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::map<std::string, JointPtr> result;
+  for (auto const &cmd : this->dataPtr->commands)
+    result[cmd.name] = cmd.joint;
+  return result;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, common::PID> JointController::GetPositionPIDs() const
 {
-  return this->dataPtr->posPids;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::map<std::string, common::PID> result;
+  for (auto const &cmd : this->dataPtr->commands)
+    result[cmd.name] = cmd.posPid;
+  return result;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, common::PID> JointController::GetVelocityPIDs() const
 {
-  return this->dataPtr->velPids;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::map<std::string, common::PID> result;
+  for (auto const &cmd : this->dataPtr->commands)
+    result[cmd.name] = cmd.velPid;
+  return result;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, double> JointController::GetForces() const
 {
-  return this->dataPtr->forces;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::map<std::string, double> result;
+  for (auto const &cmd : this->dataPtr->commands)
+  {
+    if (cmd.hasForce)
+      result[cmd.name] = cmd.force;
+  }
+  return result;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, double> JointController::GetPositions() const
 {
-  return this->dataPtr->positions;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::map<std::string, double> result;
+  for (auto const &cmd : this->dataPtr->commands)
+  {
+    if (cmd.hasPosition)
+      result[cmd.name] = cmd.position;
+  }
+  return result;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, double> JointController::GetVelocities() const
 {
-  return this->dataPtr->velocities;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::map<std::string, double> result;
+  for (auto const &cmd : this->dataPtr->commands)
+  {
+    if (cmd.hasVelocity)
+      result[cmd.name] = cmd.velocity;
+  }
+  return result;
+}
+
+/// \brief State of a joint command saved in a snapshot.
+struct JointCommandSnapshot
+{
+  double force;
+  double position;
+  double velocity;
+  bool hasForce;
+  bool hasPosition;
+  bool hasVelocity;
+
+  /// \brief Errors and command of the position PID controller.
+  double posPid[4];
+
+  /// \brief Errors and command of the velocity PID controller.
+  double velPid[4];
+};
+
+//////////////////////////////////////////////////
+void JointController::SaveSnapshot(Snapshot &_snapshot) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  _snapshot.Write(this->dataPtr->prevUpdateTime.sec);
+  _snapshot.Write(this->dataPtr->prevUpdateTime.nsec);
+  _snapshot.Write(static_cast<uint32_t>(this->dataPtr->commands.size()));
+
+  for (auto &cmd : this->dataPtr->commands)
+  {
+    JointCommandSnapshot state;
+    state.force = cmd.force;
+    state.position = cmd.position;
+    state.velocity = cmd.velocity;
+    state.hasForce = cmd.hasForce;
+    state.hasPosition = cmd.hasPosition;
+    state.hasVelocity = cmd.hasVelocity;
+    cmd.posPid.GetErrors(state.posPid[0], state.posPid[1], state.posPid[2]);
+    state.posPid[3] = cmd.posPid.GetCmd();
+    cmd.velPid.GetErrors(state.velPid[0], state.velPid[1], state.velPid[2]);
+    state.velPid[3] = cmd.velPid.GetCmd();
+    _snapshot.Write(state);
+  }
+}
+
+//////////////////////////////////////////////////
+bool JointController::CheckSnapshot(const Snapshot &_snapshot,
+    size_t &_offset) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  common::Time prevUpdateTime;
+  uint32_t count;
+  return _snapshot.Read(_offset, prevUpdateTime.sec) &&
+    _snapshot.Read(_offset, prevUpdateTime.nsec) &&
+    _snapshot.Read(_offset, count) &&
+    count == this->dataPtr->commands.size() &&
+    _snapshot.Data(_offset, count * sizeof(JointCommandSnapshot)) != nullptr;
+}
+
+//////////////////////////////////////////////////
+bool JointController::RestoreSnapshot(const Snapshot &_snapshot,
+    size_t &_offset)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  uint32_t count;
+  if (!_snapshot.Read(_offset, this->dataPtr->prevUpdateTime.sec) ||
+      !_snapshot.Read(_offset, this->dataPtr->prevUpdateTime.nsec) ||
+      !_snapshot.Read(_offset, count) ||
+      count != this->dataPtr->commands.size())
+  {
+    return false;
+  }
+
+  for (auto &cmd : this->dataPtr->commands)
+  {
+    JointCommandSnapshot state;
+    if (!_snapshot.Read(_offset, state))
+      return false;
+
+    cmd.force = state.force;
+    cmd.position = state.position;
+    cmd.velocity = state.velocity;
+    cmd.hasForce = state.hasForce;
+    cmd.hasPosition = state.hasPosition;
+    cmd.hasVelocity = state.hasVelocity;
+    cmd.posPid.SetErrors(state.posPid[0], state.posPid[1], state.posPid[2]);
+    cmd.posPid.SetCmd(state.posPid[3]);
+    cmd.velPid.SetErrors(state.velPid[0], state.velPid[1], state.velPid[2]);
+    cmd.velPid.SetCmd(state.velPid[3]);
+  }
+
+  return true;
 }
 
 //////////////////////////////////////////////////
 void JointController::SetPositionPID(const std::string &_jointName,
                                      const common::PID &_pid)
 {
-  std::map<std::string, JointPtr>::iterator iter;
-  iter = this->dataPtr->joints.find(_jointName);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  if (iter != this->dataPtr->joints.end())
-    this->dataPtr->posPids[_jointName] = _pid;
+  auto iter = this->dataPtr->indices.find(_jointName);
+  if (iter != this->dataPtr->indices.end())
+    this->dataPtr->commands[iter->second].posPid = _pid;
   else
     gzerr << "Unable to find joint with name[" << _jointName << "]\n";
 }
@@ -486,27 +613,20 @@ void JointController::SetPositionPID(const std::string &_jointName,
 bool JointController::SetPositionTarget(const std::string &_jointName,
     const double _target)
 {
-  bool result = false;
-
-  if (this->dataPtr->posPids.find(_jointName) !=
-      this->dataPtr->posPids.end())
-  {
-    this->dataPtr->positions[_jointName] = _target;
-    result = true;
-  }
-
-  return result;
+  int index = this->JointIndex(_jointName);
+  return index >= 0 &&
+    this->SetPositionTarget(static_cast<unsigned int>(index), _target);
 }
 
 //////////////////////////////////////////////////
 void JointController::SetVelocityPID(const std::string &_jointName,
                                      const common::PID &_pid)
 {
-  std::map<std::string, JointPtr>::iterator iter;
-  iter = this->dataPtr->joints.find(_jointName);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  if (iter != this->dataPtr->joints.end())
-    this->dataPtr->velPids[_jointName] = _pid;
+  auto iter = this->dataPtr->indices.find(_jointName);
+  if (iter != this->dataPtr->indices.end())
+    this->dataPtr->commands[iter->second].velPid = _pid;
   else
     gzerr << "Unable to find joint with name[" << _jointName << "]\n";
 }
@@ -515,30 +635,132 @@ void JointController::SetVelocityPID(const std::string &_jointName,
 bool JointController::SetVelocityTarget(const std::string &_jointName,
     const double _target)
 {
-  bool result = false;
+  int index = this->JointIndex(_jointName);
+  return index >= 0 &&
+    this->SetVelocityTarget(static_cast<unsigned int>(index), _target);
+}
+
+/////////////////////////////////////////////////
+bool JointController::SetForce(const std::string &_jointName,
+    const double _force)
+{
+  int index = this->JointIndex(_jointName);
+  return index >= 0 &&
+    this->SetForce(static_cast<unsigned int>(index), _force);
+}
+
+/////////////////////////////////////////////////
+int JointController::JointIndex(const std::string &_jointName) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  auto iter = this->dataPtr->indices.find(_jointName);
+  if (iter == this->dataPtr->indices.end())
+    return -1;
+
+  return static_cast<int>(iter->second);
+}
+
+/////////////////////////////////////////////////
+bool JointController::SetPositionTarget(const unsigned int _index,
+    const double _target)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  if (_index >= this->dataPtr->commands.size())
+    return false;
+
+  JointCommand &cmd = this->dataPtr->commands[_index];
+  cmd.position = _target;
+  cmd.hasPosition = true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool JointController::SetVelocityTarget(const unsigned int _index,
+    const double _target)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  if (_index >= this->dataPtr->commands.size())
+    return false;
+
+  JointCommand &cmd = this->dataPtr->commands[_index];
+  cmd.velocity = _target;
+  cmd.hasVelocity = true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool JointController::SetForce(const unsigned int _index, const double _force)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  if (_index >= this->dataPtr->commands.size())
+    return false;
+
+  JointCommand &cmd = this->dataPtr->commands[_index];
+  cmd.force = _force;
+  cmd.hasForce = true;
+  return true;
+}
 
-  if (this->dataPtr->velPids.find(_jointName) !=
-      this->dataPtr->velPids.end())
+/////////////////////////////////////////////////
+bool JointController::SetPositionTargets(const std::vector<double> &_targets)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  if (_targets.size() != this->dataPtr->commands.size())
+    return false;
+
+  for (size_t i = 0; i < _targets.size(); ++i)
   {
-    this->dataPtr->velocities[_jointName] = _target;
-    result = true;
-  }
+    if (std::isnan(_targets[i]))
+      continue;
 
-  return result;
+    JointCommand &cmd = this->dataPtr->commands[i];
+    cmd.position = _targets[i];
+    cmd.hasPosition = true;
+  }
+  return true;
 }
 
 /////////////////////////////////////////////////
-bool JointController::SetForce(const std::string &_jointName,
-    const double _force)
+bool JointController::SetVelocityTargets(const std::vector<double> &_targets)
 {
-  bool result = false;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  if (_targets.size() != this->dataPtr->commands.size())
+    return false;
 
-  if (this->dataPtr->joints.find(_jointName) !=
-      this->dataPtr->joints.end())
+  for (size_t i = 0; i < _targets.size(); ++i)
   {
-    this->dataPtr->forces[_jointName] = _force;
-    result = true;
+    if (std::isnan(_targets[i]))
+      continue;
+
+    JointCommand &cmd = this->dataPtr->commands[i];
+    cmd.velocity = _targets[i];
+    cmd.hasVelocity = true;
   }
+  return true;
+}
 
-  return result;
+/////////////////////////////////////////////////
+bool JointController::SetForces(const std::vector<double> &_forces)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  if (_forces.size() != this->dataPtr->commands.size())
+    return false;
+
+  for (size_t i = 0; i < _forces.size(); ++i)
+  {
+    if (std::isnan(_forces[i]))
+      continue;
+
+    JointCommand &cmd = this->dataPtr->commands[i];
+    cmd.force = _forces[i];
+    cmd.hasForce = true;
+  }
+  return true;
 }
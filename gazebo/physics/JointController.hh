@@ -116,6 +116,52 @@ namespace gazebo
       /// \return False if the joint was not found.
       public: bool SetForce(const std::string &_jointName, const double _force);
 
+      /// \brief Get the index of a joint. Commands set by index skip the
+      /// name lookup. Indices are dense, in the order the joints were added,
+      /// and change when a joint is removed.
+      /// \param[in] _jointName Scoped name of the joint.
+      /// \return Index of the joint, -1 if the joint was not found.
+      public: int JointIndex(const std::string &_jointName) const;
+
+      /// \brief Set the target position for the position PID controller.
+      /// \param[in] _index Index of the joint, see JointIndex.
+      /// \param[in] _target Position target.
+      /// \return False if the index is out of range.
+      public: bool SetPositionTarget(const unsigned int _index,
+                  const double _target);
+
+      /// \brief Set the target velocity for the velocity PID controller.
+      /// \param[in] _index Index of the joint, see JointIndex.
+      /// \param[in] _target Velocity target.
+      /// \return False if the index is out of range.
+      public: bool SetVelocityTarget(const unsigned int _index,
+                  const double _target);
+
+      /// \brief Set the applied effort for the specified joint.
+      /// This force will persist across time steps.
+      /// \param[in] _index Index of the joint, see JointIndex.
+      /// \param[in] _force Force to apply.
+      /// \return False if the index is out of range.
+      public: bool SetForce(const unsigned int _index, const double _force);
+
+      /// \brief Set the position targets of all the joints at once.
+      /// \param[in] _targets Position targets, by joint index. A NaN target
+      /// leaves the joint unchanged.
+      /// \return False if the size of _targets isn't the number of joints.
+      public: bool SetPositionTargets(const std::vector<double> &_targets);
+
+      /// \brief Set the velocity targets of all the joints at once.
+      /// \param[in] _targets Velocity targets, by joint index. A NaN target
+      /// leaves the joint unchanged.
+      /// \return False if the size of _targets isn't the number of joints.
+      public: bool SetVelocityTargets(const std::vector<double> &_targets);
+
+      /// \brief Set the applied efforts of all the joints at once.
+      /// \param[in] _forces Forces, by joint index. A NaN force leaves the
+      /// joint unchanged.
+      /// \return False if the size of _forces isn't the number of joints.
+      public: bool SetForces(const std::vector<double> &_forces);
+
       /// \brief Get all the position PID controllers.
       /// \return A map<joint_name, PID> for all the position PID
       /// controllers.
@@ -141,6 +187,30 @@ namespace gazebo
       /// set by the user of the JointController.
       public: std::map<std::string, double> GetVelocities() const;
 
+      /// \brief Append the state of the controller to a snapshot: the
+      /// targets, the forces and the PID errors and commands. The gains
+      /// aren't saved.
+      /// \param[in,out] _snapshot Snapshot being saved.
+      /// \sa World::SaveSnapshot
+      public: void SaveSnapshot(Snapshot &_snapshot) const;
+
+      /// \brief Check the state saved by SaveSnapshot without restoring it.
+      /// \param[in] _snapshot Snapshot being restored.
+      /// \param[in,out] _offset Position of the state of the controller in
+      /// the snapshot, moved past it.
+      /// \return False if RestoreSnapshot would fail.
+      public: bool CheckSnapshot(const Snapshot &_snapshot,
+                  size_t &_offset) const;
+
+      /// \brief Restore the state saved by SaveSnapshot.
+      /// \param[in] _snapshot Snapshot being restored.
+      /// \param[in,out] _offset Position of the state of the controller in
+      /// the snapshot, moved past it.
+      /// \return False if the snapshot is too short, or was saved with a
+      /// different number of joints.
+      public: bool RestoreSnapshot(const Snapshot &_snapshot,
+                  size_t &_offset);
+
       /// \brief Callback for service to request the current control parameters.
       /// \param[in] _req The service request. The service expects a joint
       /// name.
@@ -155,6 +225,11 @@ namespace gazebo
       /// \param[in] _msg The received message.
       private: void OnJointCommand(const ignition::msgs::JointCmd &_msg);
 
+      /// \brief Callback when a vector of joint commands is received. All
+      /// the commands are applied before the next update.
+      /// \param[in] _msg The received message.
+      private: void OnJointCommands(const msgs::JointCmd_V &_msg);
+
       /// \brief Set the positions of a Joint by name
       ///        The position is specified in native units, which means,
       ///        if you are using metric system, it's meters for SliderJoint
@@ -17,8 +17,10 @@
 #ifndef _GAZEBO_JOINTCONTROLLER_PRIVATE_HH_
 #define _GAZEBO_JOINTCONTROLLER_PRIVATE_HH_
 
-#include <string>
 #include <map>
+#include <mutex>
+#include <string>
+#include <vector>
 #include <ignition/transport.hh>
 
 #include "gazebo/transport/TransportTypes.hh"
@@ -30,6 +32,40 @@ namespace gazebo
 {
   namespace physics
   {
+    /// \brief Command state of a joint controlled by a JointController.
+    class JointCommand
+    {
+      /// \brief Scoped name of the joint.
+      public: std::string name;
+
+      /// \brief The joint.
+      public: JointPtr joint;
+
+      /// \brief Position PID controller.
+      public: common::PID posPid;
+
+      /// \brief Velocity PID controller.
+      public: common::PID velPid;
+
+      /// \brief Force applied to the joint.
+      public: double force = 0;
+
+      /// \brief Position target.
+      public: double position = 0;
+
+      /// \brief Velocity target.
+      public: double velocity = 0;
+
+      /// \brief True if a force is applied.
+      public: bool hasForce = false;
+
+      /// \brief True if a position target is set.
+      public: bool hasPosition = false;
+
+      /// \brief True if a velocity target is set.
+      public: bool hasVelocity = false;
+    };
+
     class JointControllerPrivate
     {
       /// \brief Model to control.
@@ -38,23 +74,16 @@ namespace gazebo
       /// \brief List of links that have been updated.
       public: Link_V updatedLinks;
 
-      /// \brief Map of joint names to the joint pointer.
-      public: std::map<std::string, JointPtr> joints;
-
-      /// \brief Position PID controllers.
-      public: std::map<std::string, common::PID> posPids;
-
-      /// \brief Velocity PID controllers.
-      public: std::map<std::string, common::PID> velPids;
-
-      /// \brief Forces applied to joints.
-      public: std::map<std::string, double> forces;
+      /// \brief Commands of all the joints, in the order they were added.
+      /// The position of a joint in this vector is its joint index.
+      public: std::vector<JointCommand> commands;
 
-      /// \brief Joint positions.
-      public: std::map<std::string, double> positions;
+      /// \brief Map of joint names to their index in commands.
+      public: std::map<std::string, unsigned int> indices;
 
-      /// \brief Joint velocities.
-      public: std::map<std::string, double> velocities;
+      /// \brief Protects the commands, which are set from the transport
+      /// threads.
+      public: mutable std::mutex mutex;
 
       /// \brief Node for communication.
       /// \deprecated See JointControllerPrivate::node.
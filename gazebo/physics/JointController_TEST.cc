@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include <limits>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/transport.hh>
@@ -280,6 +281,82 @@ TEST_F(JointControllerTest, SetJointPositions)
   EXPECT_NO_THROW(jointController->SetJointPositions(positions));
 }
 
+/////////////////////////////////////////////////
+TEST_F(JointControllerTest, JointIndex)
+{
+  // Create a dummy model
+  physics::ModelPtr model(new physics::Model(physics::BasePtr()));
+  EXPECT_TRUE(model != NULL);
+
+  // Create the joint controller
+  physics::JointControllerPtr jointController(
+      new physics::JointController(model));
+  EXPECT_TRUE(jointController != NULL);
+
+  physics::JointPtr joint1(new FakeJoint(model));
+  joint1->SetName("joint1");
+
+  physics::JointPtr joint2(new FakeJoint(model));
+  joint2->SetName("joint2");
+
+  // Joints are indexed in the order they're added
+  jointController->AddJoint(joint1);
+  jointController->AddJoint(joint2);
+  int index1 = jointController->JointIndex(joint1->GetScopedName());
+  int index2 = jointController->JointIndex(joint2->GetScopedName());
+  EXPECT_EQ(index1, 0);
+  EXPECT_EQ(index2, 1);
+  EXPECT_EQ(jointController->JointIndex("my_bad_name"), -1);
+
+  // Set commands by index
+  EXPECT_TRUE(jointController->SetPositionTarget(index2, 1.5));
+  EXPECT_TRUE(jointController->SetVelocityTarget(index1, 2.5));
+  EXPECT_TRUE(jointController->SetForce(index1, 3.5));
+  EXPECT_FALSE(jointController->SetPositionTarget(2u, 1.0));
+  EXPECT_FALSE(jointController->SetVelocityTarget(2u, 1.0));
+  EXPECT_FALSE(jointController->SetForce(2u, 1.0));
+
+  std::map<std::string, double> positions = jointController->GetPositions();
+  EXPECT_EQ(positions.size(), 1u);
+  EXPECT_DOUBLE_EQ(positions[joint2->GetScopedName()], 1.5);
+  std::map<std::string, double> velocities = jointController->GetVelocities();
+  EXPECT_EQ(velocities.size(), 1u);
+  EXPECT_DOUBLE_EQ(velocities[joint1->GetScopedName()], 2.5);
+  std::map<std::string, double> forces = jointController->GetForces();
+  EXPECT_EQ(forces.size(), 1u);
+  EXPECT_DOUBLE_EQ(forces[joint1->GetScopedName()], 3.5);
+
+  // Set all the targets at once, a NaN leaves a joint unchanged
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_TRUE(jointController->SetPositionTargets({0.1, nan}));
+  EXPECT_TRUE(jointController->SetVelocityTargets({0.2, 0.3}));
+  EXPECT_TRUE(jointController->SetForces({nan, 0.4}));
+  EXPECT_FALSE(jointController->SetPositionTargets({0.1}));
+  EXPECT_FALSE(jointController->SetVelocityTargets({0.1, 0.2, 0.3}));
+  EXPECT_FALSE(jointController->SetForces({}));
+
+  positions = jointController->GetPositions();
+  EXPECT_EQ(positions.size(), 2u);
+  EXPECT_DOUBLE_EQ(positions[joint1->GetScopedName()], 0.1);
+  EXPECT_DOUBLE_EQ(positions[joint2->GetScopedName()], 1.5);
+  velocities = jointController->GetVelocities();
+  EXPECT_EQ(velocities.size(), 2u);
+  EXPECT_DOUBLE_EQ(velocities[joint1->GetScopedName()], 0.2);
+  EXPECT_DOUBLE_EQ(velocities[joint2->GetScopedName()], 0.3);
+  forces = jointController->GetForces();
+  EXPECT_EQ(forces.size(), 2u);
+  EXPECT_DOUBLE_EQ(forces[joint1->GetScopedName()], 3.5);
+  EXPECT_DOUBLE_EQ(forces[joint2->GetScopedName()], 0.4);
+
+  // Removing a joint moves the following joints down
+  jointController->RemoveJoint(joint1.get());
+  EXPECT_EQ(jointController->JointIndex(joint1->GetScopedName()), -1);
+  EXPECT_EQ(jointController->JointIndex(joint2->GetScopedName()), 0);
+  positions = jointController->GetPositions();
+  EXPECT_EQ(positions.size(), 1u);
+  EXPECT_DOUBLE_EQ(positions[joint2->GetScopedName()], 1.5);
+}
+
 /////////////////////////////////////////////////
 TEST_F(JointControllerTest, JointCmd)
 {
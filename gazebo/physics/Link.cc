@@ -46,6 +46,7 @@
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Snapshot.hh"
 #include "gazebo/physics/Wind.hh"
 
 #include "gazebo/util/IntrospectionManager.hh"
@@ -94,6 +95,9 @@ class gazebo::physics::LinkPrivate
   /// \brief Wrench subscriber.
   public: transport::SubscriberPtr wrenchSub;
 
+  /// \brief Called by SetStatic, set by the physics engine.
+  public: std::function<void (bool)> staticCallback;
+
   /// \brief Vector of wrench messages to be processed.
   public: std::vector<msgs::Wrench> wrenchMsgs;
 
@@ -932,12 +936,16 @@ ignition::math::Matrix3d Link::WorldInertiaMatrix() const
 void Link::AddParentJoint(JointPtr _joint)
 {
   this->dataPtr->parentJoints.push_back(_joint);
+  if (this->world)
+    this->world->_InvalidateModelUpdateGroups();
 }
 
 //////////////////////////////////////////////////
 void Link::AddChildJoint(JointPtr _joint)
 {
   this->dataPtr->childJoints.push_back(_joint);
+  if (this->world)
+    this->world->_InvalidateModelUpdateGroups();
 }
 
 //////////////////////////////////////////////////
@@ -951,6 +959,8 @@ void Link::RemoveParentJoint(const std::string &_jointName)
     if ((*iter)->GetName() == _jointName)
     {
       this->dataPtr->parentJoints.erase(iter);
+      if (this->world)
+        this->world->_InvalidateModelUpdateGroups();
       break;
     }
   }
@@ -967,6 +977,8 @@ void Link::RemoveChildJoint(const std::string &_jointName)
     if ((*iter)->GetName() == _jointName)
     {
       this->dataPtr->childJoints.erase(iter);
+      if (this->world)
+        this->world->_InvalidateModelUpdateGroups();
       break;
     }
   }
@@ -1146,6 +1158,8 @@ void Link::AttachStaticModel(ModelPtr &_model,
 
   this->dataPtr->attachedModels.push_back(_model);
   this->attachedModelsOffset.push_back(_offset);
+  if (this->world)
+    this->world->_InvalidateModelUpdateGroups();
 }
 
 //////////////////////////////////////////////////
@@ -1159,6 +1173,8 @@ void Link::DetachStaticModel(const std::string &_modelName)
           this->dataPtr->attachedModels.begin()+i);
       this->attachedModelsOffset.erase(
           this->attachedModelsOffset.begin()+i);
+      if (this->world)
+        this->world->_InvalidateModelUpdateGroups();
       break;
     }
   }
@@ -1169,6 +1185,14 @@ void Link::DetachAllStaticModels()
 {
   this->dataPtr->attachedModels.clear();
   this->attachedModelsOffset.clear();
+  if (this->world)
+    this->world->_InvalidateModelUpdateGroups();
+}
+
+//////////////////////////////////////////////////
+const std::vector<ModelPtr> &Link::AttachedStaticModels() const
+{
+  return this->dataPtr->attachedModels;
 }
 
 //////////////////////////////////////////////////
@@ -1206,6 +1230,43 @@ void Link::SetState(const LinkState &_state)
   }*/
 }
 
+/////////////////////////////////////////////////
+void Link::SaveSnapshot(Snapshot &_snapshot) const
+{
+  const ignition::math::Pose3d pose = this->WorldPose();
+  const ignition::math::Vector3d linearVel = this->WorldCoGLinearVel();
+  const ignition::math::Vector3d angularVel = this->WorldAngularVel();
+
+  const double state[13] = {
+    pose.Pos().X(), pose.Pos().Y(), pose.Pos().Z(),
+    pose.Rot().W(), pose.Rot().X(), pose.Rot().Y(), pose.Rot().Z(),
+    linearVel.X(), linearVel.Y(), linearVel.Z(),
+    angularVel.X(), angularVel.Y(), angularVel.Z()};
+  _snapshot.Write(state);
+}
+
+/////////////////////////////////////////////////
+bool Link::CheckSnapshot(const Snapshot &_snapshot, size_t &_offset) const
+{
+  return _snapshot.Data(_offset, 13 * sizeof(double)) != nullptr;
+}
+
+/////////////////////////////////////////////////
+bool Link::RestoreSnapshot(const Snapshot &_snapshot, size_t &_offset)
+{
+  double state[13];
+  if (!_snapshot.Read(_offset, state))
+    return false;
+
+  this->SetWorldPose(ignition::math::Pose3d(state[0], state[1], state[2],
+        state[3], state[4], state[5], state[6]));
+  this->SetLinearVel(
+      ignition::math::Vector3d(state[7], state[8], state[9]));
+  this->SetAngularVel(
+      ignition::math::Vector3d(state[10], state[11], state[12]));
+  return true;
+}
+
 /////////////////////////////////////////////////
 double Link::GetLinearDamping() const
 {
@@ -1809,6 +1870,15 @@ void Link::SetStatic(const bool &_static)
   }
 
   Entity::SetStatic(_static);
+
+  if (this->dataPtr->staticCallback)
+    this->dataPtr->staticCallback(_static);
+}
+
+//////////////////////////////////////////////////
+void Link::SetStaticCallback(std::function<void (bool)> _callback)
+{
+  this->dataPtr->staticCallback = _callback;
 }
 
 //////////////////////////////////////////////////
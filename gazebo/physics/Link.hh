@@ -454,6 +454,11 @@ namespace gazebo
       /// \brief Detach all static models from this link.
       public: void DetachAllStaticModels();
 
+      /// \brief Get the static models attached to this link.
+      /// \return Models attached with AttachStaticModel.
+      /// \sa AttachStaticModel
+      public: const std::vector<ModelPtr> &AttachedStaticModels() const;
+
       /// \internal
       /// \brief Called when the pose is changed. Do not call this directly.
       public: virtual void OnPoseChange() override;
@@ -462,6 +467,30 @@ namespace gazebo
       /// \param[in] _state The state to set the link to.
       public: void SetState(const LinkState &_state);
 
+      /// \brief Append the dynamic state of the link to a snapshot. This is
+      /// the world pose and velocities of the link. World::SaveSnapshot
+      /// uses it for engines that don't save their own state of the body.
+      /// \param[in,out] _snapshot Snapshot being saved.
+      /// \sa World::SaveSnapshot
+      public: void SaveSnapshot(Snapshot &_snapshot) const;
+
+      /// \brief Check the dynamic state saved by SaveSnapshot without
+      /// restoring it.
+      /// \param[in] _snapshot Snapshot being restored.
+      /// \param[in,out] _offset Position of the state of the link in the
+      /// snapshot, moved past it.
+      /// \return False if RestoreSnapshot would fail.
+      public: bool CheckSnapshot(const Snapshot &_snapshot,
+                  size_t &_offset) const;
+
+      /// \brief Restore the dynamic state saved by SaveSnapshot.
+      /// \param[in] _snapshot Snapshot being restored.
+      /// \param[in,out] _offset Position of the state of the link in the
+      /// snapshot, moved past it.
+      /// \return False if the snapshot is too short.
+      public: bool RestoreSnapshot(const Snapshot &_snapshot,
+                  size_t &_offset);
+
       /// \brief Update the mass matrix.
       public: virtual void UpdateMass() {}
 
@@ -675,6 +704,13 @@ namespace gazebo
       /// \brief Register items in the introspection service.
       protected: virtual void RegisterIntrospectionItems() override;
 
+      /// \brief Set a function called by SetStatic after the link is made
+      /// static or dynamic. Physics engines use it to update their own
+      /// state of the link.
+      /// \param[in] _callback Function called with the new static flag.
+      protected: void SetStaticCallback(
+          std::function<void (bool)> _callback);
+
       /// \brief Inertial properties.
       protected: InertialPtr inertial;
 
@@ -33,6 +33,7 @@ using namespace physics;
 MeshShape::MeshShape(CollisionPtr _parent)
   : Shape(_parent)
 {
+  this->mesh = NULL;
   this->submesh = NULL;
   this->AddType(Base::MESH_SHAPE);
   sdf::initFile("mesh_shape.sdf", this->sdf);
@@ -133,6 +134,57 @@ void MeshShape::SetMesh(const std::string &_uri,
   this->Init();
 }
 
+//////////////////////////////////////////////////
+bool MeshShape::Triangles(std::vector<float> &_vertices,
+    std::vector<int> &_indices) const
+{
+  _vertices.clear();
+  _indices.clear();
+
+  if (!this->mesh)
+    return false;
+
+  float *vertArr = nullptr;
+  int *indArr = nullptr;
+  unsigned int vertCount = 0;
+  unsigned int indCount = 0;
+
+  if (this->submesh)
+  {
+    vertCount = this->submesh->GetVertexCount();
+    indCount = this->submesh->GetIndexCount();
+    this->submesh->FillArrays(&vertArr, &indArr);
+  }
+  else
+  {
+    // Mesh::FillArrays skips the degenerate submeshes
+    for (unsigned int i = 0; i < this->mesh->GetSubMeshCount(); ++i)
+    {
+      const common::SubMesh *sub = this->mesh->GetSubMesh(i);
+      if (sub->GetVertexCount() <= 2)
+        continue;
+      vertCount += sub->GetVertexCount();
+      indCount += sub->GetIndexCount();
+    }
+    this->mesh->FillArrays(&vertArr, &indArr);
+  }
+
+  const ignition::math::Vector3d scale = this->Size();
+  _vertices.resize(vertCount * 3);
+  for (unsigned int i = 0; i < vertCount; ++i)
+  {
+    _vertices[i * 3 + 0] = vertArr[i * 3 + 0] * scale.X();
+    _vertices[i * 3 + 1] = vertArr[i * 3 + 1] * scale.Y();
+    _vertices[i * 3 + 2] = vertArr[i * 3 + 2] * scale.Z();
+  }
+  _indices.assign(indArr, indArr + indCount);
+
+  delete [] vertArr;
+  delete [] indArr;
+
+  return true;
+}
+
 //////////////////////////////////////////////////
 void MeshShape::FillMsg(msgs::Geometry &_msg)
 {
@@ -18,6 +18,7 @@
 #define GAZEBO_PHYSICS_MESHSHAPE_HH_
 
 #include <string>
+#include <vector>
 
 #include "gazebo/common/CommonTypes.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -78,6 +79,14 @@ namespace gazebo
       /// \param[in] _msg Message that contains triangle mesh info.
       public: virtual void ProcessMsg(const msgs::Geometry &_msg);
 
+      /// \brief Get the triangles of the collision mesh, scaled, in the
+      /// frame of the collision.
+      /// \param[out] _vertices Vertex coordinates, three per vertex.
+      /// \param[out] _indices Vertex indices, three per triangle.
+      /// \return False if the mesh isn't loaded.
+      public: bool Triangles(std::vector<float> &_vertices,
+                  std::vector<int> &_indices) const;
+
       /// \brief Pointer to the mesh data.
       protected: const common::Mesh *mesh;
 
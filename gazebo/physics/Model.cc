@@ -18,6 +18,7 @@
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
 #include <float.h>
+#include <atomic>
 
 #include <boost/bind/bind.hpp>
 #include <boost/function.hpp>
@@ -56,6 +57,11 @@
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Structure version of all the models. Kept out of the installed
+/// Model class so that its layout doesn't change. Models are loaded and
+/// changed by the threads of several worlds, so it's atomic.
+static std::atomic<unsigned int> g_structureVersion(0);
+
 //////////////////////////////////////////////////
 Model::Model(BasePtr _parent)
   : Entity(_parent)
@@ -227,6 +233,7 @@ void Model::LoadLinks()
       link->Load(linkElem);
       linkElem = linkElem->GetNextElement("link");
       this->links.push_back(link);
+      this->StructureChanged();
     }
   }
 }
@@ -246,6 +253,7 @@ void Model::LoadModels()
       model->SetWorld(this->GetWorld());
       model->Load(modelElem);
       this->models.push_back(model);
+      this->StructureChanged();
       modelElem = modelElem->GetNextElement("model");
     }
 
@@ -516,6 +524,7 @@ void Model::Fini()
   }
   this->canonicalLink.reset();
   this->links.clear();
+  this->StructureChanged();
 
   this->plugins.clear();
 
@@ -1345,6 +1354,7 @@ void Model::AttachStaticModel(ModelPtr &_model, ignition::math::Pose3d _offset)
 
   this->attachedModels.push_back(_model);
   this->attachedModelsOffset.push_back(_offset);
+  this->world->_InvalidateModelUpdateGroups();
 }
 
 //////////////////////////////////////////////////
@@ -1356,11 +1366,18 @@ void Model::DetachStaticModel(const std::string &_modelName)
     {
       this->attachedModels.erase(this->attachedModels.begin()+i);
       this->attachedModelsOffset.erase(this->attachedModelsOffset.begin()+i);
+      this->world->_InvalidateModelUpdateGroups();
       break;
     }
   }
 }
 
+//////////////////////////////////////////////////
+const std::vector<ModelPtr> &Model::AttachedStaticModels() const
+{
+  return this->attachedModels;
+}
+
 //////////////////////////////////////////////////
 void Model::OnPoseChange()
 {
@@ -1524,10 +1541,25 @@ void Model::RemoveLink(const std::string &_name)
     if ((*iter)->GetName() == _name || (*iter)->GetScopedName() == _name)
     {
       this->links.erase(iter);
+      this->StructureChanged();
       break;
     }
   }
 }
+
+/////////////////////////////////////////////////
+unsigned int Model::StructureVersion() const
+{
+  return g_structureVersion.load(std::memory_order_acquire);
+}
+
+/////////////////////////////////////////////////
+void Model::StructureChanged()
+{
+  // Also covers the models this one is nested in, which include its links
+  // in their own structure
+  g_structureVersion.fetch_add(1, std::memory_order_acq_rel);
+}
 /////////////////////////////////////////////////
 JointControllerPtr Model::GetJointController()
 {
@@ -1764,6 +1796,7 @@ LinkPtr Model::CreateLink(const std::string &_name)
 
   link->SetName(_name);
   this->links.push_back(link);
+  this->StructureChanged();
 
   return link;
 }
@@ -192,6 +192,14 @@ namespace gazebo
       /// \return a vector of Link's in this model
       public: const Link_V &GetLinks() const;
 
+      /// \brief Get a counter that changes whenever a link or a nested
+      /// model is added to or removed from this model or one of its nested
+      /// models. Used to cache data derived from the model structure. The
+      /// counter is shared by all models, so it also changes when other
+      /// models change. Structure changes are rare.
+      /// \return Structure version of the model.
+      public: unsigned int StructureVersion() const;
+
       /// \brief Get the joints.
       /// \return Vector of joints.
       public: const Joint_V &GetJoints() const;
@@ -295,6 +303,11 @@ namespace gazebo
       /// \sa Model::AttachStaticModel.
       public: void DetachStaticModel(const std::string &_model);
 
+      /// \brief Get the static models attached to this model.
+      /// \return Models attached with AttachStaticModel.
+      /// \sa Model::AttachStaticModel.
+      public: const std::vector<ModelPtr> &AttachedStaticModels() const;
+
       /// \brief Set the current model state.
       /// \param[in] _state State to set the model to.
       public: void SetState(const ModelState &_state);
@@ -514,6 +527,11 @@ namespace gazebo
       /// \param[in] _name Name of the link to remove.
       private: void RemoveLink(const std::string &_name);
 
+      /// \brief Change the structure version of this model and of all the
+      /// models it's nested in.
+      /// \sa StructureVersion
+      private: void StructureChanged();
+
       /// \brief Publish the scale.
       private: virtual void PublishScale();
 
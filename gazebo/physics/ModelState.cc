@@ -20,6 +20,7 @@
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/ModelState.hh"
+#include "gazebo/util/LogRecordFilter.hh"
 
 using namespace gazebo;
 using namespace physics;
@@ -111,6 +112,15 @@ ModelState::~ModelState()
 /////////////////////////////////////////////////
 void ModelState::Load(const ModelPtr _model, const common::Time &_realTime,
     const common::Time &_simTime, const uint64_t _iterations)
+{
+  static const util::LogRecordFilter matchAll;
+  this->Load(_model, _realTime, _simTime, _iterations, matchAll);
+}
+
+/////////////////////////////////////////////////
+void ModelState::Load(const ModelPtr _model, const common::Time &_realTime,
+    const common::Time &_simTime, const uint64_t _iterations,
+    const util::LogRecordFilter &_filter)
 {
   this->name = _model->GetName();
   this->wallTime = common::Time::GetWallTime();
@@ -120,20 +130,51 @@ void ModelState::Load(const ModelPtr _model, const common::Time &_realTime,
   this->pose = _model->WorldPose();
   this->scale = _model->Scale();
 
-  // Load all the links
-  this->linkStates.clear();
-  const Link_V links = _model->GetLinks();
-  for (Link_V::const_iterator iter = links.begin(); iter != links.end(); ++iter)
+  // Load all the links. Existing states are updated in place.
+  size_t count = 0;
+  for (auto const &link : _model->GetLinks())
   {
-    this->linkStates[(*iter)->GetName()].Load(*iter, _realTime, _simTime,
+    if (!_filter.MatchLink(link->GetName()))
+      continue;
+
+    this->linkStates[link->GetName()].Load(link, _realTime, _simTime,
         _iterations);
+    ++count;
+  }
+
+  // Remove links that no longer exist or no longer match the filter.
+  if (this->linkStates.size() != count)
+  {
+    for (auto iter = this->linkStates.begin();
+         iter != this->linkStates.end();)
+    {
+      if (!_filter.MatchLink(iter->first) || !_model->GetLink(iter->first))
+        iter = this->linkStates.erase(iter);
+      else
+        ++iter;
+    }
   }
 
   // Load all the models
-  this->modelStates.clear();
+  count = 0;
   for (const auto &m : _model->NestedModels())
   {
-    this->modelStates[m->GetName()].Load(m, _realTime, _simTime, _iterations);
+    this->modelStates[m->GetName()].Load(m, _realTime, _simTime, _iterations,
+        _filter);
+    ++count;
+  }
+
+  // Remove nested models that no longer exist.
+  if (this->modelStates.size() != count)
+  {
+    for (auto iter = this->modelStates.begin();
+         iter != this->modelStates.end();)
+    {
+      if (!_model->NestedModel(iter->first))
+        iter = this->modelStates.erase(iter);
+      else
+        ++iter;
+    }
   }
 
   // Copy all the joints
@@ -256,6 +297,39 @@ bool ModelState::IsZero() const
       this->scale == ignition::math::Vector3d::Zero;
 }
 
+/////////////////////////////////////////////////
+bool ModelState::DiffIsZero(const ModelState &_state) const
+{
+  if (!PoseDiffIsZero(this->pose, _state.pose) ||
+      this->scale - _state.scale != ignition::math::Vector3d::Zero)
+  {
+    return false;
+  }
+
+  // Only entities present in both states contribute to the difference.
+  for (auto const &ls : this->linkStates)
+  {
+    auto other = _state.linkStates.find(ls.first);
+    if (other != _state.linkStates.end() &&
+        !PoseDiffIsZero(ls.second.Pose(), other->second.Pose()))
+    {
+      return false;
+    }
+  }
+
+  for (auto const &ms : this->modelStates)
+  {
+    auto other = _state.modelStates.find(ms.first);
+    if (other != _state.modelStates.end() &&
+        !ms.second.DiffIsZero(other->second))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 unsigned int ModelState::GetLinkStateCount() const
 {
@@ -405,23 +479,10 @@ ModelState &ModelState::operator=(const ModelState &_state)
   this->pose = _state.pose;
   this->scale = _state.scale;
 
-  // Clear the link, joint, and model states.
-  this->linkStates.clear();
+  // Copy the link and model states, reusing the existing entries.
   this->jointStates.clear();
-  this->modelStates.clear();
-
-  // Copy the link states.
-  for (LinkState_M::const_iterator iter =
-       _state.linkStates.begin(); iter != _state.linkStates.end(); ++iter)
-  {
-    this->linkStates.insert(std::make_pair(iter->first, iter->second));
-  }
-
-  // Copy the model states.
-  for (const auto &ms : _state.modelStates)
-  {
-    this->modelStates.insert(std::make_pair(ms.first, ms.second));
-  }
+  AssignStates(this->linkStates, _state.linkStates);
+  AssignStates(this->modelStates, _state.modelStates);
 
   // Copy the joint states.
   // for (JointState_M::const_iterator iter =
@@ -28,6 +28,7 @@
 #include "gazebo/physics/State.hh"
 #include "gazebo/physics/LinkState.hh"
 #include "gazebo/physics/JointState.hh"
+#include "gazebo/util/UtilTypes.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -88,6 +89,20 @@ namespace gazebo
       public: void Load(const ModelPtr _model, const common::Time &_realTime,
                   const common::Time &_simTime, const uint64_t _iterations);
 
+      /// \brief Load state from Model pointer, keeping only the links and
+      /// nested models accepted by a filter.
+      ///
+      /// Build a ModelState from an existing Model.
+      /// \param[in] _model Pointer to the model from which to gather state
+      /// info.
+      /// \param[in] _realTime Real time stamp.
+      /// \param[in] _simTime Sim time stamp.
+      /// \param[in] _iterations Simulation iterations.
+      /// \param[in] _filter Compiled log record filter.
+      public: void Load(const ModelPtr _model, const common::Time &_realTime,
+                  const common::Time &_simTime, const uint64_t _iterations,
+                  const util::LogRecordFilter &_filter);
+
       /// \brief Load state from SDF element.
       ///
       /// Load ModelState information from stored data in and SDF::Element
@@ -106,6 +121,14 @@ namespace gazebo
       /// \return True if the values in the state are zero.
       public: bool IsZero() const;
 
+      /// \brief Check whether the difference to another state is zero.
+      ///
+      /// This is equivalent to (*this - _state).IsZero(), without building
+      /// the difference.
+      /// \param[in] _state State to compare with.
+      /// \return True if the difference is zero.
+      public: bool DiffIsZero(const ModelState &_state) const;
+
       /// \brief Get the number of link states.
       ///
       /// This returns the number of Links recorded.
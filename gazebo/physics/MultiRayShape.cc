@@ -14,17 +14,285 @@
  * limitations under the License.
  *
 */
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ignition/common/Profiler.hh"
+
 #include "gazebo/common/Exception.hh"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/BoxShape.hh"
+#include "gazebo/physics/CylinderShape.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/MeshShape.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PlaneShape.hh"
+#include "gazebo/physics/SphereShape.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/MultiRayShapePrivate.hh"
 #include "gazebo/physics/MultiRayShape.hh"
 
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Meshes with more triangles than this are intersected by the
+/// intersect callback, which can use the bounding volume tree of the
+/// physics engine, rather than by the batch kernels.
+static const unsigned int kMaxBatchTriangles = 4096;
+
+/// \brief Mutex that protects g_multiRayData.
+static std::mutex g_multiRayMutex;
+
+/// \brief Private data of the multiray shapes. MultiRayShape has no data
+/// pointer, so its private data is kept here, by shape, and looked up once
+/// per scan.
+static std::unordered_map<const MultiRayShape *,
+    std::unique_ptr<MultiRayShapePrivate>> g_multiRayData;
+
+//////////////////////////////////////////////////
+/// \brief Get the private data of a multiray shape.
+/// \param[in] _shape The shape.
+/// \return The private data, created with the shape.
+static MultiRayShapePrivate &MultiRayData(const MultiRayShape *_shape)
+{
+  std::lock_guard<std::mutex> lock(g_multiRayMutex);
+  return *g_multiRayData.at(_shape);
+}
+
+//////////////////////////////////////////////////
+/// \brief Compute the world bounding box of a box in a local frame.
+/// \param[in] _pose Pose of the local frame.
+/// \param[in] _center Center of the box in the local frame.
+/// \param[in] _half Half extents of the box in the local frame.
+/// \return World bounding box.
+static ignition::math::AxisAlignedBox WorldBounds(
+    const ignition::math::Pose3d &_pose,
+    const ignition::math::Vector3d &_center,
+    const ignition::math::Vector3d &_half)
+{
+  const ignition::math::Vector3d center = _pose.CoordPositionAdd(_center);
+  const ignition::math::Vector3d x =
+      (_pose.Rot() * ignition::math::Vector3d(_half.X(), 0, 0)).Abs();
+  const ignition::math::Vector3d y =
+      (_pose.Rot() * ignition::math::Vector3d(0, _half.Y(), 0)).Abs();
+  const ignition::math::Vector3d z =
+      (_pose.Rot() * ignition::math::Vector3d(0, 0, _half.Z())).Abs();
+  const ignition::math::Vector3d extent = x + y + z;
+  return ignition::math::AxisAlignedBox(center - extent, center + extent);
+}
+
+//////////////////////////////////////////////////
+/// \brief Describe a collision as a batch primitive.
+/// \param[in] _collision The collision.
+/// \param[in,out] _data Private data of the multiray shape, which caches
+/// the triangles of meshes.
+/// \param[out] _primitive The primitive.
+/// \return False if the batch kernels don't support the shape.
+static bool MakePrimitive(Collision *_collision, MultiRayShapePrivate &_data,
+    RayBatchPrimitive &_primitive)
+{
+  ShapePtr shape = _collision->GetShape();
+  if (!shape)
+    return false;
+
+  _primitive.pose = _collision->WorldPose();
+  _primitive.id = _collision->GetId();
+  _primitive.retro = _collision->GetLaserRetro();
+
+  if (shape->HasType(Base::BOX_SHAPE))
+  {
+    _primitive.type = RayBatchPrimitive::BOX;
+    _primitive.size = boost::static_pointer_cast<BoxShape>(shape)->Size();
+    _primitive.bounds = WorldBounds(_primitive.pose,
+        ignition::math::Vector3d::Zero, _primitive.size * 0.5);
+  }
+  else if (shape->HasType(Base::SPHERE_SHAPE))
+  {
+    const double radius =
+        boost::static_pointer_cast<SphereShape>(shape)->GetRadius();
+    _primitive.type = RayBatchPrimitive::SPHERE;
+    _primitive.size.Set(radius, radius, radius);
+    _primitive.bounds = ignition::math::AxisAlignedBox(
+        _primitive.pose.Pos() - _primitive.size,
+        _primitive.pose.Pos() + _primitive.size);
+  }
+  else if (shape->HasType(Base::CYLINDER_SHAPE))
+  {
+    CylinderShapePtr cylinder =
+        boost::static_pointer_cast<CylinderShape>(shape);
+    _primitive.type = RayBatchPrimitive::CYLINDER;
+    _primitive.size.Set(cylinder->GetRadius(), cylinder->GetRadius(),
+        cylinder->GetLength());
+    _primitive.bounds = WorldBounds(_primitive.pose,
+        ignition::math::Vector3d::Zero, ignition::math::Vector3d(
+        _primitive.size.X(), _primitive.size.Y(), _primitive.size.Z() * 0.5));
+  }
+  else if (shape->HasType(Base::PLANE_SHAPE))
+  {
+    // Same convention as the ODE plane: the normal is in the world frame,
+    // and the plane goes through the origin of the collision.
+    _primitive.type = RayBatchPrimitive::PLANE;
+    _primitive.normal =
+        boost::static_pointer_cast<PlaneShape>(shape)->Normal().Normalized();
+    _primitive.offset = _primitive.normal.Dot(_primitive.pose.Pos());
+  }
+  else if (shape->HasType(Base::MESH_SHAPE))
+  {
+    MeshShapePtr meshShape = boost::static_pointer_cast<MeshShape>(shape);
+
+    auto iter = _data.meshes.find(_primitive.id);
+    if (iter == _data.meshes.end() ||
+        iter->second.scale != meshShape->Size())
+    {
+      MultiRayShapeMesh &mesh = _data.meshes[_primitive.id];
+      mesh.scale = meshShape->Size();
+      mesh.vertices.reset(new std::vector<float>);
+      mesh.indices.reset(new std::vector<int>);
+      meshShape->Triangles(*mesh.vertices, *mesh.indices);
+
+      // Large meshes are left to the physics engine
+      if (mesh.indices->size() / 3 > kMaxBatchTriangles)
+      {
+        mesh.vertices.reset();
+        mesh.indices.reset();
+      }
+      else
+      {
+        mesh.min.Set(0, 0, 0);
+        mesh.max.Set(0, 0, 0);
+        for (size_t i = 0; i + 2 < mesh.vertices->size(); i += 3)
+        {
+          ignition::math::Vector3d v((*mesh.vertices)[i],
+              (*mesh.vertices)[i + 1], (*mesh.vertices)[i + 2]);
+          if (i == 0)
+          {
+            mesh.min = v;
+            mesh.max = v;
+          }
+          mesh.min.Min(v);
+          mesh.max.Max(v);
+        }
+      }
+      iter = _data.meshes.find(_primitive.id);
+    }
+
+    iter->second.lastScan = _data.scanCount;
+    if (!iter->second.vertices)
+      return false;
+
+    _primitive.type = RayBatchPrimitive::TRIANGLES;
+    _primitive.vertices = iter->second.vertices;
+    _primitive.indices = iter->second.indices;
+    _primitive.bounds = WorldBounds(_primitive.pose,
+        (iter->second.min + iter->second.max) * 0.5,
+        (iter->second.max - iter->second.min) * 0.5);
+  }
+  else
+  {
+    return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Add the collisions of a model and its nested models, except
+/// rays, to a list of candidates.
+/// \param[in] _model The model.
+/// \param[out] _collisions List of candidates.
+static void AddCandidates(const ModelPtr &_model,
+    std::vector<Collision *> &_collisions)
+{
+  for (auto const &link : _model->GetLinks())
+  {
+    for (auto const &collision : link->GetCollisions())
+    {
+      if (!collision->GetShape() || (collision->GetShapeType() &
+          (Base::RAY_SHAPE | Base::MULTIRAY_SHAPE)))
+      {
+        continue;
+      }
+      _collisions.push_back(collision.get());
+    }
+  }
+
+  for (auto const &nested : _model->NestedModels())
+    AddCandidates(nested, _collisions);
+}
+
+//////////////////////////////////////////////////
+/// \brief Default candidates of a scan: all the collisions of the world.
+/// The bounding boxes of collisions are not in the world frame for all
+/// physics engines, so the candidates are culled by
+/// MultiRayShape::UpdateBatch, from the extents of their shapes.
+/// \param[in] _world The world.
+/// \param[out] _collisions List of candidates.
+static void FindCandidates(const WorldPtr &_world,
+    std::vector<Collision *> &_collisions)
+{
+  if (!_world)
+    return;
+
+  for (auto const &model : _world->Models())
+    AddCandidates(model, _collisions);
+}
+
+//////////////////////////////////////////////////
+/// \brief Default intersection of the rays with the collisions that the
+/// batch kernels don't support: one RayShape::GetIntersection per ray.
+/// \param[in] _rays The rays of the scan.
+/// \param[in] _collisions The collisions.
+/// \param[in,out] _batch Rays of the scan, with the hits found so far.
+static void IntersectCollisions(const std::vector<RayShapePtr> &_rays,
+    const std::vector<Collision *> &_collisions, RayBatch &_batch)
+{
+  // Hits are reported by name, on a collision or on its link
+  std::unordered_map<std::string, Collision *> byName;
+  for (auto const &collision : _collisions)
+  {
+    LinkPtr link = collision->GetLink();
+    if (!link)
+      continue;
+
+    byName[collision->GetScopedName()] = collision;
+    byName.emplace(link->GetScopedName(), collision);
+  }
+
+  if (byName.empty())
+    return;
+
+  // One query per ray for all the collisions. Only the closest hit is
+  // known, keep it if it is on one of them.
+  for (unsigned int i = 0; i < _batch.Count(); ++i)
+  {
+    double dist;
+    std::string entity;
+    _rays[i]->GetIntersection(dist, entity);
+    if (entity.empty())
+      continue;
+
+    auto iter = byName.find(entity);
+    if (iter != byName.end())
+    {
+      _batch.SetHit(i, dist, iter->second->GetId(),
+          iter->second->GetLaserRetro());
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 MultiRayShape::MultiRayShape(CollisionPtr _parent)
 : Shape(_parent)
 {
+  {
+    std::lock_guard<std::mutex> lock(g_multiRayMutex);
+    g_multiRayData[this].reset(new MultiRayShapePrivate);
+  }
+
   this->AddType(MULTIRAY_SHAPE);
   this->SetName("multiray");
 }
@@ -39,6 +307,9 @@ MultiRayShape::MultiRayShape(PhysicsEnginePtr /*_physicsEngine*/)
 MultiRayShape::~MultiRayShape()
 {
   this->rays.clear();
+
+  std::lock_guard<std::mutex> lock(g_multiRayMutex);
+  g_multiRayData.erase(this);
 }
 
 //////////////////////////////////////////////////
@@ -170,16 +441,13 @@ void MultiRayShape::Update()
   // The measurable range is (max-min)
   double fullRange = this->GetMaxRange() - this->GetMinRange();
 
-  // Reset the ray lengths and mark the collisions as dirty (so they get
-  // redrawn)
+  // Reset the ray lengths. The global points of the rays are updated by
+  // the physics engine in UpdateRays.
   unsigned int raySize = this->rays.size();
   for (unsigned int i = 0; i < raySize; ++i)
   {
     this->rays[i]->SetLength(fullRange);
     this->rays[i]->SetRetro(0.0);
-
-    // Get the global points of the line
-    this->rays[i]->Update();
   }
 
   // do actual collision checks
@@ -325,3 +593,140 @@ RayShapePtr MultiRayShape::Ray(const unsigned int _rayIndex) const
   else
     return RayShapePtr();
 }
+
+//////////////////////////////////////////////////
+void MultiRayShape::UpdateBatch()
+{
+  IGN_PROFILE("MultiRayShape::UpdateBatch");
+
+  MultiRayShapePrivate &data = MultiRayData(this);
+
+  const unsigned int rayCount = this->rays.size();
+  RayBatch &batch = data.batch;
+  batch.Resize(rayCount);
+
+  // The rays of a shape attached to a collision are relative to its link,
+  // as in RayShape::Update. Standalone rays are in the world frame.
+  LinkPtr link;
+  if (this->collisionParent)
+    link = this->collisionParent->GetLink();
+  const ignition::math::Pose3d linkPose =
+      link ? link->WorldPose() : ignition::math::Pose3d::Zero;
+
+  for (unsigned int i = 0; i < rayCount; ++i)
+  {
+    ignition::math::Vector3d start, end;
+    if (link)
+    {
+      this->rays[i]->RelativePoints(start, end);
+      start = linkPose.CoordPositionAdd(start);
+      end = linkPose.CoordPositionAdd(end);
+    }
+    else
+    {
+      this->rays[i]->GlobalPoints(start, end);
+    }
+    batch.SetRay(i, start, end);
+  }
+  batch.Reset();
+
+  // One broadphase query for the whole scan
+  ++data.scanCount;
+  data.candidates.clear();
+  if (rayCount > 0)
+  {
+    if (data.candidatesCallback)
+      data.candidatesCallback(batch.Bounds(), data.candidates);
+    else
+      FindCandidates(this->GetWorld(), data.candidates);
+  }
+
+  data.primitives.clear();
+  data.fallbacks.clear();
+  for (auto const &collision : data.candidates)
+  {
+    RayBatchPrimitive primitive;
+    if (!MakePrimitive(collision, data, primitive))
+    {
+      data.fallbacks.push_back(collision);
+    }
+    else if (primitive.type == RayBatchPrimitive::PLANE ||
+             primitive.bounds.Intersects(batch.Bounds()))
+    {
+      data.primitives.push_back(primitive);
+    }
+  }
+
+  batch.Intersect(data.primitives);
+
+  if (!data.fallbacks.empty())
+  {
+    if (data.intersectCallback)
+      data.intersectCallback(data.fallbacks, batch);
+    else
+      IntersectCollisions(this->rays, data.fallbacks, batch);
+  }
+
+  // Forget the meshes that are out of range
+  for (auto iter = data.meshes.begin(); iter != data.meshes.end();)
+  {
+    if (iter->second.lastScan != data.scanCount)
+      iter = data.meshes.erase(iter);
+    else
+      ++iter;
+  }
+
+  for (unsigned int i = 0; i < rayCount; ++i)
+  {
+    this->rays[i]->SetLength(batch.Distance(i));
+    this->rays[i]->SetRetro(batch.Retro(i));
+  }
+
+  // Only report the rays that hit another collision than in the previous
+  // scan, most of them usually hit the same one.
+  data.hitIds.resize(rayCount, 0);
+  if (data.hitCallback)
+  {
+    std::unordered_map<unsigned int, Collision *> byId;
+    for (unsigned int i = 0; i < rayCount; ++i)
+    {
+      const unsigned int id = batch.HitId(i);
+      if (id == data.hitIds[i])
+        continue;
+
+      if (byId.empty())
+      {
+        for (auto const &collision : data.candidates)
+          byId[collision->GetId()] = collision;
+      }
+
+      auto iter = byId.find(id);
+      data.hitCallback(i, iter != byId.end() ? iter->second : nullptr);
+    }
+  }
+  for (unsigned int i = 0; i < rayCount; ++i)
+    data.hitIds[i] = batch.HitId(i);
+}
+
+//////////////////////////////////////////////////
+void MultiRayShape::SetCandidatesCallback(
+    std::function<void (const ignition::math::AxisAlignedBox &,
+      std::vector<Collision *> &)> _callback)
+{
+  MultiRayData(this).candidatesCallback = _callback;
+}
+
+//////////////////////////////////////////////////
+void MultiRayShape::SetIntersectCallback(
+    std::function<void (const std::vector<Collision *> &, RayBatch &)>
+      _callback)
+{
+  MultiRayData(this).intersectCallback = _callback;
+}
+
+//////////////////////////////////////////////////
+void MultiRayShape::SetHitCallback(
+    std::function<void (const unsigned int, Collision *)> _callback)
+{
+  MultiRayData(this).hitCallback = _callback;
+}
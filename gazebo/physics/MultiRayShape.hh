@@ -17,12 +17,15 @@
 #ifndef GAZEBO_PHYSICS_MULTIRAYSHAPE_HH_
 #define GAZEBO_PHYSICS_MULTIRAYSHAPE_HH_
 
+#include <functional>
 #include <vector>
 #include <string>
 #include <ignition/math/Angle.hh>
+#include <ignition/math/AxisAlignedBox.hh>
 
 #include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/Shape.hh"
+#include "gazebo/physics/RayBatch.hh"
 #include "gazebo/physics/RayShape.hh"
 #include "gazebo/util/system.hh"
 
@@ -179,6 +182,46 @@ namespace gazebo
       /// \sa RayCount()
       public: RayShapePtr Ray(const unsigned int _rayIndex) const;
 
+      /// \brief Intersect all the rays with the collisions of the world as
+      /// one batch, and store the closest hit of each ray. The candidate
+      /// collisions are found once for the whole scan, then primitive and
+      /// small mesh collisions are intersected with packets of rays, and
+      /// the other collisions one ray at a time. The caller must hold the
+      /// physics update mutex.
+      /// \sa SetCandidatesCallback
+      /// \sa SetIntersectCallback
+      protected: void UpdateBatch();
+
+      /// \brief Set the function that finds the collisions that may be hit
+      /// by a scan. By default the bounding box of every collision in the
+      /// world is checked, physics engines can use their broadphase instead.
+      /// The function gets the bounding box of all the rays, in the world
+      /// frame, and adds the collisions whose bounding box overlaps it.
+      /// Ray shapes must be ignored.
+      /// \param[in] _callback The function, or nullptr for the default.
+      protected: void SetCandidatesCallback(
+                     std::function<void (
+                       const ignition::math::AxisAlignedBox &,
+                       std::vector<Collision *> &)> _callback);
+
+      /// \brief Set the function that intersects the rays with the
+      /// collisions whose shapes aren't supported by the batch kernels, such
+      /// as heightmaps, and reports the hits with RayBatch::SetHit. By
+      /// default RayShape::GetIntersection is called once per ray, and only
+      /// the hits on one of the collisions or on their links are kept.
+      /// \param[in] _callback The function, or nullptr for the default.
+      protected: void SetIntersectCallback(
+                     std::function<void (const std::vector<Collision *> &,
+                       RayBatch &)> _callback);
+
+      /// \brief Set the function called by UpdateBatch for every ray whose
+      /// closest collision changed since the previous scan.
+      /// \param[in] _callback The function, which gets the index of the ray
+      /// and the collision it hit, or nullptr if it didn't hit anything.
+      protected: void SetHitCallback(
+                     std::function<void (const unsigned int, Collision *)>
+                       _callback);
+
       /// \brief Ray data
       protected: std::vector<RayShapePtr> rays;
 
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_MULTIRAYSHAPE_PRIVATE_HH_
+#define GAZEBO_PHYSICS_MULTIRAYSHAPE_PRIVATE_HH_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/RayBatch.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Triangles of a mesh collision, cached between scans.
+    class MultiRayShapeMesh
+    {
+      /// \brief Scale of the mesh when the triangles were extracted.
+      public: ignition::math::Vector3d scale;
+
+      /// \brief Vertex coordinates, scaled. Null if the mesh is too large
+      /// for the batch kernels.
+      public: std::shared_ptr<std::vector<float>> vertices;
+
+      /// \brief Vertex indices.
+      public: std::shared_ptr<std::vector<int>> indices;
+
+      /// \brief Bounding box corner of the vertices.
+      public: ignition::math::Vector3d min;
+
+      /// \brief Bounding box corner of the vertices.
+      public: ignition::math::Vector3d max;
+
+      /// \brief Scan in which the mesh was last seen.
+      public: unsigned int lastScan = 0;
+    };
+
+    /// \internal
+    /// \brief Private data for the MultiRayShape class.
+    class MultiRayShapePrivate
+    {
+      /// \brief Rays of the current scan and their hits.
+      public: RayBatch batch;
+
+      /// \brief Number of scans done, used to expire cached meshes.
+      public: unsigned int scanCount = 0;
+
+      /// \brief Collisions that may be hit by the current scan.
+      public: std::vector<Collision *> candidates;
+
+      /// \brief Candidates intersected by the batch kernels.
+      public: std::vector<RayBatchPrimitive> primitives;
+
+      /// \brief Candidates not supported by the batch kernels, see
+      /// MultiRayShape::SetIntersectCallback.
+      public: std::vector<Collision *> fallbacks;
+
+      /// \brief Id of the collision hit by each ray in the previous scan,
+      /// zero for none.
+      public: std::vector<unsigned int> hitIds;
+
+      /// \brief Finds the candidates, see
+      /// MultiRayShape::SetCandidatesCallback.
+      public: std::function<void (const ignition::math::AxisAlignedBox &,
+                  std::vector<Collision *> &)> candidatesCallback;
+
+      /// \brief Intersects the fallbacks, see
+      /// MultiRayShape::SetIntersectCallback.
+      public: std::function<void (const std::vector<Collision *> &,
+                  RayBatch &)> intersectCallback;
+
+      /// \brief Called when the hit of a ray changes, see
+      /// MultiRayShape::SetHitCallback.
+      public: std::function<void (const unsigned int, Collision *)>
+                  hitCallback;
+
+      /// \brief Triangles of the mesh candidates, by collision id.
+      public: std::map<unsigned int, MultiRayShapeMesh> meshes;
+    };
+  }
+}
+#endif
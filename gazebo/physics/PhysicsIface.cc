@@ -15,19 +15,33 @@
  *
 */
 
+#include <memory>
+#include <mutex>
+
 #include <boost/thread/mutex.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/AtmosphereFactory.hh"
 #include "gazebo/physics/PhysicsFactory.hh"
 #include "gazebo/physics/PhysicsIface.hh"
+#include "gazebo/util/IntrospectionManager.hh"
 #include "gazebo/gazebo_config.h"
 
 using namespace gazebo;
 
 std::vector<physics::WorldPtr> g_worlds;
 
+/// \brief Thread pool used by step_worlds.
+static std::unique_ptr<tbb::task_arena> g_worldPool;
+
+/// \brief Protects g_worldPool.
+static std::mutex g_worldPoolMutex;
+
 boost::mutex g_uniqueIdMutex;
 uint32_t g_uniqueId = 0;
 
@@ -123,6 +137,42 @@ void physics::run_worlds(unsigned int _steps)
     world->Run(_steps);
 }
 
+/////////////////////////////////////////////////
+void physics::step_worlds(const unsigned int _steps,
+    const unsigned int _publishPeriod)
+{
+  std::lock_guard<std::mutex> lock(g_worldPoolMutex);
+
+  if (!g_worldPool)
+    g_worldPool.reset(new tbb::task_arena());
+
+  g_worldPool->execute([&]()
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, g_worlds.size(), 1),
+        [&](const tbb::blocked_range<size_t> &_r)
+        {
+          for (size_t i = _r.begin(); i != _r.end(); ++i)
+            g_worlds[i]->StepBlocking(_steps, _publishPeriod);
+        });
+  });
+
+  // The introspection items of the worlds are sampled once all the worlds
+  // stopped.
+  util::IntrospectionManager::Instance()->Update();
+  util::IntrospectionManager::Instance()->NotifyUpdates();
+}
+
+/////////////////////////////////////////////////
+void physics::set_world_pool_threads(const unsigned int _threads)
+{
+  std::lock_guard<std::mutex> lock(g_worldPoolMutex);
+
+  if (_threads == 0)
+    g_worldPool.reset(new tbb::task_arena());
+  else
+    g_worldPool.reset(new tbb::task_arena(static_cast<int>(_threads)));
+}
+
 /////////////////////////////////////////////////
 void physics::pause_worlds(bool _pause)
 {
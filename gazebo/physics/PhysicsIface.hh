@@ -121,6 +121,31 @@ namespace gazebo
     GZ_PHYSICS_VISIBLE
     void run_worlds(unsigned int _iterations = 0);
 
+    /// \brief Step multiple worlds stored in static variable
+    /// gazebo::g_worlds on a shared thread pool, and block until every
+    /// world took its steps. Each world is stepped by one pool thread at a
+    /// time, the threads left over run the parallel parts of the world
+    /// updates. The worlds must have been initialized, and must not be
+    /// running their own thread, see run_worlds.
+    /// \param[in] _steps Number of steps for each world to take.
+    /// \param[in] _publishPeriod Publish the world statistics, the poses
+    /// and the contacts every _publishPeriod steps, and after the last
+    /// one.
+    ///
+    /// Each world logs its own state when recording, and the sensor
+    /// manager publishes the performance metrics of each world. The
+    /// introspection manager is shared by the worlds, so its items are
+    /// updated once per call, after the worlds took their steps.
+    GZ_PHYSICS_VISIBLE
+    void step_worlds(const unsigned int _steps,
+                     const unsigned int _publishPeriod = 1);
+
+    /// \brief Set the number of threads of the pool used by step_worlds.
+    /// \param[in] _threads Number of threads. Zero uses one thread per
+    /// hardware thread.
+    GZ_PHYSICS_VISIBLE
+    void set_world_pool_threads(const unsigned int _threads);
+
     /// \brief stop multiple worlds stored in static variable
     /// gazebo::g_worlds
     GZ_PHYSICS_VISIBLE
@@ -50,6 +50,7 @@ namespace gazebo
     class PresetManager;
     class UserCmd;
     class UserCmdManager;
+    class Snapshot;
     class PhysicsEngine;
     class Wind;
     class Atmosphere;
@@ -0,0 +1,689 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <ignition/math/Matrix3.hh>
+
+#include "gazebo/physics/RayBatch.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for the RayBatch class.
+    class RayBatchPrivate
+    {
+      /// \brief Number of rays.
+      public: unsigned int count = 0;
+
+      /// \brief Number of packets.
+      public: unsigned int packetCount = 0;
+
+      /// \brief Ray origins, padded to a whole number of packets.
+      public: std::vector<double> originX, originY, originZ;
+
+      /// \brief Unit ray directions.
+      public: std::vector<double> dirX, dirY, dirZ;
+
+      /// \brief Ray lengths. Padding rays have a zero length.
+      public: std::vector<double> length;
+
+      /// \brief Distance to the closest hit.
+      public: std::vector<double> distance;
+
+      /// \brief Id of the closest hit, zero for none.
+      public: std::vector<unsigned int> hitId;
+
+      /// \brief Retro reflectance of the closest hit.
+      public: std::vector<float> retro;
+
+      /// \brief Bounding box corners of each packet, three per packet.
+      public: std::vector<double> packetMin, packetMax;
+
+      /// \brief Bounding box of all the rays.
+      public: ignition::math::AxisAlignedBox bounds;
+    };
+
+    /// \internal
+    /// \brief A primitive with its transform in a form used by the kernels.
+    class RayBatchPrepared
+    {
+      /// \brief The primitive.
+      public: const RayBatchPrimitive *primitive = nullptr;
+
+      /// \brief Rotation matrix from the primitive frame to the world
+      /// frame, row major.
+      public: double rot[9];
+
+      /// \brief Position of the primitive.
+      public: double pos[3];
+
+      /// \brief World bounding box corners.
+      public: double min[3];
+
+      /// \brief World bounding box corners.
+      public: double max[3];
+    };
+  }
+}
+
+/// \brief Shorthand for the packet size.
+static const unsigned int kPacket = RayBatch::PacketSize;
+
+/// \brief Value of the distance for a miss.
+static const double kMiss = std::numeric_limits<double>::infinity();
+
+//////////////////////////////////////////////////
+/// \brief Transform the rays of a packet into the frame of a primitive.
+static void PacketToLocal(const RayBatchPrivate &_d, const unsigned int _start,
+    const RayBatchPrepared &_p, double *_ox, double *_oy, double *_oz,
+    double *_dx, double *_dy, double *_dz)
+{
+  const double *ox = _d.originX.data() + _start;
+  const double *oy = _d.originY.data() + _start;
+  const double *oz = _d.originZ.data() + _start;
+  const double *dx = _d.dirX.data() + _start;
+  const double *dy = _d.dirY.data() + _start;
+  const double *dz = _d.dirZ.data() + _start;
+  const double *r = _p.rot;
+
+  for (unsigned int i = 0; i < kPacket; ++i)
+  {
+    const double vx = ox[i] - _p.pos[0];
+    const double vy = oy[i] - _p.pos[1];
+    const double vz = oz[i] - _p.pos[2];
+
+    // Multiply by the transpose of the rotation
+    _ox[i] = r[0] * vx + r[3] * vy + r[6] * vz;
+    _oy[i] = r[1] * vx + r[4] * vy + r[7] * vz;
+    _oz[i] = r[2] * vx + r[5] * vy + r[8] * vz;
+    _dx[i] = r[0] * dx[i] + r[3] * dy[i] + r[6] * dz[i];
+    _dy[i] = r[1] * dx[i] + r[4] * dy[i] + r[7] * dz[i];
+    _dz[i] = r[2] * dx[i] + r[5] * dy[i] + r[8] * dz[i];
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Keep the hits of a packet that are closer than the current hits.
+static void CommitPacket(RayBatchPrivate &_d, const unsigned int _start,
+    const double *_t, const RayBatchPrimitive &_primitive)
+{
+  double *distance = _d.distance.data() + _start;
+  unsigned int *hitId = _d.hitId.data() + _start;
+  float *retro = _d.retro.data() + _start;
+
+  for (unsigned int i = 0; i < kPacket; ++i)
+  {
+    const bool hit = _t[i] >= 0 && _t[i] < distance[i];
+    distance[i] = hit ? _t[i] : distance[i];
+    hitId[i] = hit ? _primitive.id : hitId[i];
+    retro[i] = hit ? _primitive.retro : retro[i];
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Select the hit distance from the entry and exit distances of a
+/// convex solid: the entry point, or the exit point if the ray starts
+/// inside.
+static void SelectHits(const double *_near, const double *_far, double *_t)
+{
+  for (unsigned int i = 0; i < kPacket; ++i)
+  {
+    const double t = _near[i] >= 0 ? _near[i] : _far[i];
+    _t[i] = (_near[i] <= _far[i] && t >= 0) ? t : kMiss;
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Compute the entry and exit distances of the slab
+/// -_half <= x <= _half.
+static void Slab(const double *_o, const double *_dir, const double _half,
+    double *_near, double *_far)
+{
+  for (unsigned int i = 0; i < kPacket; ++i)
+  {
+    const double inv = 1.0 / _dir[i];
+    const double t1 = (-_half - _o[i]) * inv;
+    const double t2 = (_half - _o[i]) * inv;
+    _near[i] = std::max(_near[i], std::min(t1, t2));
+    _far[i] = std::min(_far[i], std::max(t1, t2));
+  }
+}
+
+//////////////////////////////////////////////////
+static void IntersectSphere(RayBatchPrivate &_d, const unsigned int _start,
+    const RayBatchPrepared &_p)
+{
+  const double *ox = _d.originX.data() + _start;
+  const double *oy = _d.originY.data() + _start;
+  const double *oz = _d.originZ.data() + _start;
+  const double *dx = _d.dirX.data() + _start;
+  const double *dy = _d.dirY.data() + _start;
+  const double *dz = _d.dirZ.data() + _start;
+  const double radius = _p.primitive->size.X();
+  const double r2 = radius * radius;
+
+  double t[kPacket];
+  for (unsigned int i = 0; i < kPacket; ++i)
+  {
+    const double vx = ox[i] - _p.pos[0];
+    const double vy = oy[i] - _p.pos[1];
+    const double vz = oz[i] - _p.pos[2];
+    const double b = vx * dx[i] + vy * dy[i] + vz * dz[i];
+    const double c = vx * vx + vy * vy + vz * vz - r2;
+    const double disc = b * b - c;
+    const double sq = std::sqrt(std::max(disc, 0.0));
+    const double t0 = -b - sq;
+    const double t1 = -b + sq;
+    const double hit = t0 >= 0 ? t0 : t1;
+    t[i] = (disc >= 0 && hit >= 0) ? hit : kMiss;
+  }
+
+  CommitPacket(_d, _start, t, *_p.primitive);
+}
+
+//////////////////////////////////////////////////
+static void IntersectBox(RayBatchPrivate &_d, const unsigned int _start,
+    const RayBatchPrepared &_p)
+{
+  double ox[kPacket], oy[kPacket], oz[kPacket];
+  double dx[kPacket], dy[kPacket], dz[kPacket];
+  PacketToLocal(_d, _start, _p, ox, oy, oz, dx, dy, dz);
+
+  double nearT[kPacket], farT[kPacket], t[kPacket];
+  std::fill(nearT, nearT + kPacket, -kMiss);
+  std::fill(farT, farT + kPacket, kMiss);
+
+  const ignition::math::Vector3d half = _p.primitive->size * 0.5;
+  Slab(ox, dx, half.X(), nearT, farT);
+  Slab(oy, dy, half.Y(), nearT, farT);
+  Slab(oz, dz, half.Z(), nearT, farT);
+
+  SelectHits(nearT, farT, t);
+  CommitPacket(_d, _start, t, *_p.primitive);
+}
+
+//////////////////////////////////////////////////
+static void IntersectCylinder(RayBatchPrivate &_d, const unsigned int _start,
+    const RayBatchPrepared &_p)
+{
+  double ox[kPacket], oy[kPacket], oz[kPacket];
+  double dx[kPacket], dy[kPacket], dz[kPacket];
+  PacketToLocal(_d, _start, _p, ox, oy, oz, dx, dy, dz);
+
+  double nearT[kPacket], farT[kPacket], t[kPacket];
+  std::fill(nearT, nearT + kPacket, -kMiss);
+  std::fill(farT, farT + kPacket, kMiss);
+
+  // Caps
+  Slab(oz, dz, _p.primitive->size.Z() * 0.5, nearT, farT);
+
+  // Infinite cylinder
+  const double radius = _p.primitive->size.X();
+  const double r2 = radius * radius;
+  for (unsigned int i = 0; i < kPacket; ++i)
+  {
+    const double a = dx[i] * dx[i] + dy[i] * dy[i];
+    const double b = ox[i] * dx[i] + oy[i] * dy[i];
+    const double c = ox[i] * ox[i] + oy[i] * oy[i] - r2;
+    const double disc = b * b - a * c;
+    const double sq = std::sqrt(std::max(disc, 0.0));
+
+    // A ray parallel to the axis is either always or never inside
+    const bool parallel = a < 1e-12;
+    const double invA = 1.0 / (parallel ? 1.0 : a);
+    const double n = parallel ? (c <= 0 ? -kMiss : kMiss) :
+        (disc >= 0 ? (-b - sq) * invA : kMiss);
+    const double f = parallel ? (c <= 0 ? kMiss : -kMiss) :
+        (disc >= 0 ? (-b + sq) * invA : -kMiss);
+
+    nearT[i] = std::max(nearT[i], n);
+    farT[i] = std::min(farT[i], f);
+  }
+
+  SelectHits(nearT, farT, t);
+  CommitPacket(_d, _start, t, *_p.primitive);
+}
+
+//////////////////////////////////////////////////
+static void IntersectPlane(RayBatchPrivate &_d, const unsigned int _start,
+    const RayBatchPrepared &_p)
+{
+  const double *ox = _d.originX.data() + _start;
+  const double *oy = _d.originY.data() + _start;
+  const double *oz = _d.originZ.data() + _start;
+  const double *dx = _d.dirX.data() + _start;
+  const double *dy = _d.dirY.data() + _start;
+  const double *dz = _d.dirZ.data() + _start;
+  const ignition::math::Vector3d &n = _p.primitive->normal;
+  const double offset = _p.primitive->offset;
+
+  double t[kPacket];
+  for (unsigned int i = 0; i < kPacket; ++i)
+  {
+    const double denom = n.X() * dx[i] + n.Y() * dy[i] + n.Z() * dz[i];
+    const double num = offset - (n.X() * ox[i] + n.Y() * oy[i] +
+        n.Z() * oz[i]);
+    const double hit = num / (denom != 0 ? denom : 1.0);
+    t[i] = (denom != 0 && hit >= 0) ? hit : kMiss;
+  }
+
+  CommitPacket(_d, _start, t, *_p.primitive);
+}
+
+//////////////////////////////////////////////////
+static void IntersectTriangles(RayBatchPrivate &_d, const unsigned int _start,
+    const RayBatchPrepared &_p)
+{
+  const RayBatchPrimitive &primitive = *_p.primitive;
+  if (!primitive.vertices || !primitive.indices)
+    return;
+
+  double ox[kPacket], oy[kPacket], oz[kPacket];
+  double dx[kPacket], dy[kPacket], dz[kPacket];
+  PacketToLocal(_d, _start, _p, ox, oy, oz, dx, dy, dz);
+
+  // Bounding box of the packet in the frame of the mesh
+  const double *length = _d.length.data() + _start;
+  double lo[3] = {kMiss, kMiss, kMiss};
+  double hi[3] = {-kMiss, -kMiss, -kMiss};
+  for (unsigned int i = 0; i < kPacket; ++i)
+  {
+    const double end[3] = {ox[i] + dx[i] * length[i],
+        oy[i] + dy[i] * length[i], oz[i] + dz[i] * length[i]};
+    lo[0] = std::min(lo[0], std::min(ox[i], end[0]));
+    lo[1] = std::min(lo[1], std::min(oy[i], end[1]));
+    lo[2] = std::min(lo[2], std::min(oz[i], end[2]));
+    hi[0] = std::max(hi[0], std::max(ox[i], end[0]));
+    hi[1] = std::max(hi[1], std::max(oy[i], end[1]));
+    hi[2] = std::max(hi[2], std::max(oz[i], end[2]));
+  }
+
+  double t[kPacket];
+  std::fill(t, t + kPacket, kMiss);
+
+  const std::vector<float> &vertices = *primitive.vertices;
+  const std::vector<int> &indices = *primitive.indices;
+  const int vertexCount = static_cast<int>(vertices.size() / 3);
+  for (size_t tri = 0; tri + 2 < indices.size(); tri += 3)
+  {
+    const int i0 = indices[tri];
+    const int i1 = indices[tri + 1];
+    const int i2 = indices[tri + 2];
+    if (i0 < 0 || i1 < 0 || i2 < 0 ||
+        i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount)
+    {
+      continue;
+    }
+
+    const float *a = &vertices[i0 * 3];
+    const float *b = &vertices[i1 * 3];
+    const float *c = &vertices[i2 * 3];
+
+    // Skip triangles away from the packet
+    bool away = false;
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      away = away ||
+          std::max(a[k], std::max(b[k], c[k])) < lo[k] ||
+          std::min(a[k], std::min(b[k], c[k])) > hi[k];
+    }
+    if (away)
+      continue;
+
+    const double e1x = b[0] - a[0], e1y = b[1] - a[1], e1z = b[2] - a[2];
+    const double e2x = c[0] - a[0], e2y = c[1] - a[1], e2z = c[2] - a[2];
+
+    // Moller-Trumbore, without back face culling
+    for (unsigned int i = 0; i < kPacket; ++i)
+    {
+      const double px = dy[i] * e2z - dz[i] * e2y;
+      const double py = dz[i] * e2x - dx[i] * e2z;
+      const double pz = dx[i] * e2y - dy[i] * e2x;
+      const double det = e1x * px + e1y * py + e1z * pz;
+      const bool valid = std::abs(det) > 1e-12;
+      const double invDet = 1.0 / (valid ? det : 1.0);
+
+      const double tx = ox[i] - a[0], ty = oy[i] - a[1], tz = oz[i] - a[2];
+      const double u = (tx * px + ty * py + tz * pz) * invDet;
+
+      const double qx = ty * e1z - tz * e1y;
+      const double qy = tz * e1x - tx * e1z;
+      const double qz = tx * e1y - ty * e1x;
+      const double v = (dx[i] * qx + dy[i] * qy + dz[i] * qz) * invDet;
+      const double hit = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+
+      const bool inside = valid && u >= 0 && v >= 0 && u + v <= 1 &&
+          hit >= 0;
+      t[i] = (inside && hit < t[i]) ? hit : t[i];
+    }
+  }
+
+  CommitPacket(_d, _start, t, primitive);
+}
+
+/// \brief Intersects ranges of packets with all the primitives.
+class IntersectPackets_TBB
+{
+  /// \brief Constructor.
+  /// \param[in] _data Rays and results.
+  /// \param[in] _prepared Primitives to intersect.
+  public: IntersectPackets_TBB(RayBatchPrivate *_data,
+              const std::vector<RayBatchPrepared> *_prepared)
+    : data(_data), prepared(_prepared)
+  {
+  }
+
+  /// \brief Intersect a range of packets.
+  /// \param[in] _r Range of packet indices.
+  public: void operator() (const tbb::blocked_range<size_t> &_r) const
+  {
+    for (size_t p = _r.begin(); p != _r.end(); ++p)
+    {
+      const double *pmin = &this->data->packetMin[p * 3];
+      const double *pmax = &this->data->packetMax[p * 3];
+      const unsigned int start = static_cast<unsigned int>(p) * kPacket;
+
+      for (auto const &prep : *this->prepared)
+      {
+        if (prep.primitive->type != RayBatchPrimitive::PLANE &&
+            (prep.max[0] < pmin[0] || prep.min[0] > pmax[0] ||
+             prep.max[1] < pmin[1] || prep.min[1] > pmax[1] ||
+             prep.max[2] < pmin[2] || prep.min[2] > pmax[2]))
+        {
+          continue;
+        }
+
+        switch (prep.primitive->type)
+        {
+          case RayBatchPrimitive::BOX:
+            IntersectBox(*this->data, start, prep);
+            break;
+          case RayBatchPrimitive::SPHERE:
+            IntersectSphere(*this->data, start, prep);
+            break;
+          case RayBatchPrimitive::CYLINDER:
+            IntersectCylinder(*this->data, start, prep);
+            break;
+          case RayBatchPrimitive::PLANE:
+            IntersectPlane(*this->data, start, prep);
+            break;
+          case RayBatchPrimitive::TRIANGLES:
+            IntersectTriangles(*this->data, start, prep);
+            break;
+          default:
+            break;
+        }
+      }
+    }
+  }
+
+  /// \brief Rays and results.
+  private: RayBatchPrivate *data;
+
+  /// \brief Primitives to intersect.
+  private: const std::vector<RayBatchPrepared> *prepared;
+};
+
+//////////////////////////////////////////////////
+RayBatch::RayBatch()
+  : dataPtr(new RayBatchPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+RayBatch::~RayBatch()
+{
+}
+
+//////////////////////////////////////////////////
+void RayBatch::Resize(const unsigned int _count)
+{
+  this->dataPtr->count = _count;
+  this->dataPtr->packetCount = (_count + kPacket - 1) / kPacket;
+
+  const size_t padded = this->dataPtr->packetCount * kPacket;
+  this->dataPtr->originX.resize(padded, 0);
+  this->dataPtr->originY.resize(padded, 0);
+  this->dataPtr->originZ.resize(padded, 0);
+  this->dataPtr->dirX.resize(padded, 1);
+  this->dataPtr->dirY.resize(padded, 0);
+  this->dataPtr->dirZ.resize(padded, 0);
+  this->dataPtr->length.resize(padded, 0);
+  this->dataPtr->distance.resize(padded, 0);
+  this->dataPtr->hitId.resize(padded, 0);
+  this->dataPtr->retro.resize(padded, 0);
+  this->dataPtr->packetMin.resize(this->dataPtr->packetCount * 3);
+  this->dataPtr->packetMax.resize(this->dataPtr->packetCount * 3);
+}
+
+//////////////////////////////////////////////////
+unsigned int RayBatch::Count() const
+{
+  return this->dataPtr->count;
+}
+
+//////////////////////////////////////////////////
+void RayBatch::SetRay(const unsigned int _index,
+    const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_end)
+{
+  if (_index >= this->dataPtr->count)
+    return;
+
+  ignition::math::Vector3d dir = _end - _start;
+  const double len = dir.Length();
+  if (len > 0)
+    dir /= len;
+  else
+    dir = ignition::math::Vector3d::UnitX;
+
+  this->dataPtr->originX[_index] = _start.X();
+  this->dataPtr->originY[_index] = _start.Y();
+  this->dataPtr->originZ[_index] = _start.Z();
+  this->dataPtr->dirX[_index] = dir.X();
+  this->dataPtr->dirY[_index] = dir.Y();
+  this->dataPtr->dirZ[_index] = dir.Z();
+  this->dataPtr->length[_index] = len;
+}
+
+//////////////////////////////////////////////////
+void RayBatch::Reset()
+{
+  RayBatchPrivate &d = *this->dataPtr;
+  const unsigned int padded = d.packetCount * kPacket;
+
+  // Padding rays sit on the last ray with a zero length, so they neither
+  // grow the packet bounds nor report hits.
+  for (unsigned int i = d.count; i < padded; ++i)
+  {
+    d.originX[i] = d.originX[d.count - 1];
+    d.originY[i] = d.originY[d.count - 1];
+    d.originZ[i] = d.originZ[d.count - 1];
+    d.length[i] = 0;
+  }
+
+  std::copy(d.length.begin(), d.length.end(), d.distance.begin());
+  std::fill(d.hitId.begin(), d.hitId.end(), 0u);
+  std::fill(d.retro.begin(), d.retro.end(), 0.0f);
+
+  ignition::math::Vector3d lo(kMiss, kMiss, kMiss);
+  ignition::math::Vector3d hi(-kMiss, -kMiss, -kMiss);
+  for (unsigned int p = 0; p < d.packetCount; ++p)
+  {
+    double *pmin = &d.packetMin[p * 3];
+    double *pmax = &d.packetMax[p * 3];
+    std::fill(pmin, pmin + 3, kMiss);
+    std::fill(pmax, pmax + 3, -kMiss);
+
+    for (unsigned int i = p * kPacket; i < (p + 1) * kPacket; ++i)
+    {
+      const double o[3] = {d.originX[i], d.originY[i], d.originZ[i]};
+      const double e[3] = {o[0] + d.dirX[i] * d.length[i],
+          o[1] + d.dirY[i] * d.length[i], o[2] + d.dirZ[i] * d.length[i]};
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        pmin[k] = std::min(pmin[k], std::min(o[k], e[k]));
+        pmax[k] = std::max(pmax[k], std::max(o[k], e[k]));
+      }
+    }
+
+    lo.Min(ignition::math::Vector3d(pmin[0], pmin[1], pmin[2]));
+    hi.Max(ignition::math::Vector3d(pmax[0], pmax[1], pmax[2]));
+  }
+
+  if (d.packetCount > 0)
+    d.bounds = ignition::math::AxisAlignedBox(lo, hi);
+  else
+    d.bounds = ignition::math::AxisAlignedBox();
+}
+
+//////////////////////////////////////////////////
+const ignition::math::AxisAlignedBox &RayBatch::Bounds() const
+{
+  return this->dataPtr->bounds;
+}
+
+//////////////////////////////////////////////////
+void RayBatch::Intersect(const std::vector<RayBatchPrimitive> &_primitives,
+    const bool _parallel)
+{
+  if (this->dataPtr->packetCount == 0 || _primitives.empty())
+    return;
+
+  // Precompute the transforms once, rather than once per packet
+  std::vector<RayBatchPrepared> prepared(_primitives.size());
+  for (size_t i = 0; i < _primitives.size(); ++i)
+  {
+    const RayBatchPrimitive &primitive = _primitives[i];
+    RayBatchPrepared &prep = prepared[i];
+    prep.primitive = &primitive;
+
+    ignition::math::Matrix3d rot(primitive.pose.Rot());
+    for (unsigned int r = 0; r < 3; ++r)
+    {
+      for (unsigned int c = 0; c < 3; ++c)
+        prep.rot[r * 3 + c] = rot(r, c);
+    }
+
+    prep.pos[0] = primitive.pose.Pos().X();
+    prep.pos[1] = primitive.pose.Pos().Y();
+    prep.pos[2] = primitive.pose.Pos().Z();
+
+    prep.min[0] = primitive.bounds.Min().X();
+    prep.min[1] = primitive.bounds.Min().Y();
+    prep.min[2] = primitive.bounds.Min().Z();
+    prep.max[0] = primitive.bounds.Max().X();
+    prep.max[1] = primitive.bounds.Max().Y();
+    prep.max[2] = primitive.bounds.Max().Z();
+  }
+
+  IntersectPackets_TBB intersect(this->dataPtr.get(), &prepared);
+  if (_parallel && this->dataPtr->packetCount > 1)
+  {
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, this->dataPtr->packetCount), intersect);
+  }
+  else
+  {
+    intersect(tbb::blocked_range<size_t>(0, this->dataPtr->packetCount));
+  }
+}
+
+//////////////////////////////////////////////////
+void RayBatch::RaysInBox(const ignition::math::AxisAlignedBox &_box,
+    std::vector<unsigned int> &_rays) const
+{
+  _rays.clear();
+
+  const ignition::math::Vector3d &lo = _box.Min();
+  const ignition::math::Vector3d &hi = _box.Max();
+  for (unsigned int p = 0; p < this->dataPtr->packetCount; ++p)
+  {
+    const double *pmin = &this->dataPtr->packetMin[p * 3];
+    const double *pmax = &this->dataPtr->packetMax[p * 3];
+    if (hi.X() < pmin[0] || lo.X() > pmax[0] ||
+        hi.Y() < pmin[1] || lo.Y() > pmax[1] ||
+        hi.Z() < pmin[2] || lo.Z() > pmax[2])
+    {
+      continue;
+    }
+
+    const unsigned int end =
+        std::min((p + 1) * kPacket, this->dataPtr->count);
+    for (unsigned int i = p * kPacket; i < end; ++i)
+      _rays.push_back(i);
+  }
+}
+
+//////////////////////////////////////////////////
+bool RayBatch::SetHit(const unsigned int _index, const double _distance,
+    const unsigned int _id, const float _retro)
+{
+  if (_index >= this->dataPtr->count || _distance < 0 ||
+      _distance >= this->dataPtr->distance[_index])
+  {
+    return false;
+  }
+
+  this->dataPtr->distance[_index] = _distance;
+  this->dataPtr->hitId[_index] = _id;
+  this->dataPtr->retro[_index] = _retro;
+  return true;
+}
+
+//////////////////////////////////////////////////
+double RayBatch::Length(const unsigned int _index) const
+{
+  if (_index >= this->dataPtr->count)
+    return 0;
+  return this->dataPtr->length[_index];
+}
+
+//////////////////////////////////////////////////
+double RayBatch::Distance(const unsigned int _index) const
+{
+  if (_index >= this->dataPtr->count)
+    return 0;
+  return this->dataPtr->distance[_index];
+}
+
+//////////////////////////////////////////////////
+unsigned int RayBatch::HitId(const unsigned int _index) const
+{
+  if (_index >= this->dataPtr->count)
+    return 0;
+  return this->dataPtr->hitId[_index];
+}
+
+//////////////////////////////////////////////////
+float RayBatch::Retro(const unsigned int _index) const
+{
+  if (_index >= this->dataPtr->count)
+    return 0;
+  return this->dataPtr->retro[_index];
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_RAYBATCH_HH_
+#define GAZEBO_PHYSICS_RAYBATCH_HH_
+
+#include <memory>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    class RayBatchPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class RayBatchPrimitive RayBatch.hh physics/physics.hh
+    /// \brief A shape intersected by a RayBatch, in the world frame.
+    class GZ_PHYSICS_VISIBLE RayBatchPrimitive
+    {
+      /// \brief Types of primitives.
+      public: enum Type
+      {
+        /// \brief Box centered on the pose, with full extents size.
+        BOX,
+
+        /// \brief Sphere centered on the pose, with radius size.X().
+        SPHERE,
+
+        /// \brief Cylinder along the Z axis of the pose, with radius
+        /// size.X() and length size.Z().
+        CYLINDER,
+
+        /// \brief Infinite plane of points p such that normal.Dot(p) is
+        /// equal to offset.
+        PLANE,
+
+        /// \brief Triangles with vertices in the frame of the pose.
+        TRIANGLES
+      };
+
+      /// \brief Type of the primitive.
+      public: Type type = BOX;
+
+      /// \brief World pose of the primitive.
+      public: ignition::math::Pose3d pose;
+
+      /// \brief Dimensions of the primitive, see Type.
+      public: ignition::math::Vector3d size;
+
+      /// \brief Unit normal of a plane, in the world frame.
+      public: ignition::math::Vector3d normal;
+
+      /// \brief Offset of a plane along its normal.
+      public: double offset = 0;
+
+      /// \brief World axis aligned bounding box. Not used by planes.
+      public: ignition::math::AxisAlignedBox bounds;
+
+      /// \brief Vertex coordinates of the triangles, three per vertex.
+      public: std::shared_ptr<const std::vector<float>> vertices;
+
+      /// \brief Vertex indices of the triangles, three per triangle.
+      public: std::shared_ptr<const std::vector<int>> indices;
+
+      /// \brief Id reported for the rays that hit this primitive. Must not
+      /// be zero.
+      public: unsigned int id = 0;
+
+      /// \brief Retro reflectance reported for the rays that hit this
+      /// primitive.
+      public: float retro = 0;
+    };
+
+    /// \class RayBatch RayBatch.hh physics/physics.hh
+    /// \brief Intersects a set of rays with a set of primitives.
+    ///
+    /// The rays are stored as structures of arrays and grouped in packets
+    /// of PacketSize consecutive rays. A primitive is only intersected
+    /// with the packets whose bounding box it overlaps, and the kernels
+    /// process a whole packet in branch free loops, which the compiler
+    /// vectorizes. Packets are distributed over the TBB thread pool.
+    ///
+    /// The intersection semantics follow ODE: a ray starting inside a
+    /// solid hits its boundary on the way out, and only hits at a distance
+    /// between zero and the ray length are reported.
+    ///
+    /// Usage: Resize, SetRay for every ray, Reset, then Intersect and
+    /// SetHit, and finally read the results.
+    class GZ_PHYSICS_VISIBLE RayBatch
+    {
+      /// \brief Number of rays in a packet.
+      public: static const unsigned int PacketSize = 16;
+
+      /// \brief Constructor.
+      public: RayBatch();
+
+      /// \brief Destructor.
+      public: virtual ~RayBatch();
+
+      /// \brief Set the number of rays.
+      /// \param[in] _count Number of rays.
+      public: void Resize(const unsigned int _count);
+
+      /// \brief Get the number of rays.
+      /// \return Number of rays.
+      public: unsigned int Count() const;
+
+      /// \brief Set a ray from its end points in the world frame.
+      /// \param[in] _index Index of the ray.
+      /// \param[in] _start Start of the ray.
+      /// \param[in] _end End of the ray.
+      public: void SetRay(const unsigned int _index,
+                  const ignition::math::Vector3d &_start,
+                  const ignition::math::Vector3d &_end);
+
+      /// \brief Clear the results, and compute the bounding boxes of the
+      /// packets. Must be called after the rays are set, and before
+      /// Bounds, Intersect or SetHit.
+      public: void Reset();
+
+      /// \brief Get the bounding box of all the rays.
+      /// \return Bounding box in the world frame.
+      public: const ignition::math::AxisAlignedBox &Bounds() const;
+
+      /// \brief Intersect all the rays with a set of primitives, and keep
+      /// the closest hit of each ray.
+      /// \param[in] _primitives The primitives.
+      /// \param[in] _parallel True to split the packets across threads.
+      public: void Intersect(const std::vector<RayBatchPrimitive> &_primitives,
+                  const bool _parallel = true);
+
+      /// \brief Get the rays that may hit a bounding box, at the
+      /// granularity of packets.
+      /// \param[in] _box Bounding box in the world frame.
+      /// \param[out] _rays Indices of the rays.
+      public: void RaysInBox(const ignition::math::AxisAlignedBox &_box,
+                  std::vector<unsigned int> &_rays) const;
+
+      /// \brief Report a hit found by another intersection method. The hit
+      /// is only kept if it is closer than the current hit.
+      /// \param[in] _index Index of the ray.
+      /// \param[in] _distance Distance from the start of the ray.
+      /// \param[in] _id Id of the object hit.
+      /// \param[in] _retro Retro reflectance of the object hit.
+      /// \return True if the hit was kept.
+      public: bool SetHit(const unsigned int _index, const double _distance,
+                  const unsigned int _id, const float _retro);
+
+      /// \brief Get the length of a ray.
+      /// \param[in] _index Index of the ray.
+      /// \return Length of the ray.
+      public: double Length(const unsigned int _index) const;
+
+      /// \brief Get the distance to the closest hit of a ray.
+      /// \param[in] _index Index of the ray.
+      /// \return Distance to the hit, or the length of the ray if there
+      /// was no hit.
+      public: double Distance(const unsigned int _index) const;
+
+      /// \brief Get the id of the object hit by a ray.
+      /// \param[in] _index Index of the ray.
+      /// \return Id of the object, zero if there was no hit.
+      public: unsigned int HitId(const unsigned int _index) const;
+
+      /// \brief Get the retro reflectance of the object hit by a ray.
+      /// \param[in] _index Index of the ray.
+      /// \return Retro reflectance, zero if there was no hit.
+      public: float Retro(const unsigned int _index) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<RayBatchPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/Helpers.hh>
+
+#include "test/util.hh"
+#include "gazebo/physics/RayBatch.hh"
+
+using namespace gazebo;
+
+class RayBatchTest : public gazebo::testing::AutoLogFixture
+{
+  /// \brief Create a batch of rays along +X, starting at x = 0, spread
+  /// along Y.
+  /// \param[in] _count Number of rays.
+  /// \param[in] _length Length of the rays.
+  /// \param[out] _batch Batch to fill.
+  public: void FanX(const unsigned int _count, const double _length,
+              physics::RayBatch &_batch)
+  {
+    _batch.Resize(_count);
+    for (unsigned int i = 0; i < _count; ++i)
+    {
+      const double y = -1.0 + 2.0 * i / std::max(_count - 1, 1u);
+      _batch.SetRay(i, ignition::math::Vector3d(0, y, 0),
+          ignition::math::Vector3d(_length, y, 0));
+    }
+    _batch.Reset();
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(RayBatchTest, Empty)
+{
+  physics::RayBatch batch;
+  batch.Resize(0);
+  batch.Reset();
+  EXPECT_EQ(batch.Count(), 0u);
+
+  std::vector<physics::RayBatchPrimitive> primitives(1);
+  batch.Intersect(primitives);
+  EXPECT_DOUBLE_EQ(batch.Distance(0), 0);
+  EXPECT_EQ(batch.HitId(0), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RayBatchTest, Box)
+{
+  physics::RayBatch batch;
+  this->FanX(37, 10, batch);
+  EXPECT_EQ(batch.Count(), 37u);
+  EXPECT_DOUBLE_EQ(batch.Bounds().Max().X(), 10);
+
+  // Box rotated by 90 degrees around Z, so the short side faces the rays
+  std::vector<physics::RayBatchPrimitive> primitives(1);
+  primitives[0].type = physics::RayBatchPrimitive::BOX;
+  primitives[0].pose.Set(5, 0, 0, 0, 0, IGN_PI * 0.5);
+  primitives[0].size.Set(4, 1, 2);
+  primitives[0].bounds = ignition::math::AxisAlignedBox(
+      ignition::math::Vector3d(4.5, -2, -1),
+      ignition::math::Vector3d(5.5, 2, 1));
+  primitives[0].id = 7;
+  primitives[0].retro = 0.5f;
+
+  batch.Intersect(primitives);
+  for (unsigned int i = 0; i < batch.Count(); ++i)
+  {
+    EXPECT_NEAR(batch.Distance(i), 4.5, 1e-9) << i;
+    EXPECT_EQ(batch.HitId(i), 7u);
+    EXPECT_FLOAT_EQ(batch.Retro(i), 0.5f);
+  }
+
+  // A ray starting inside reports the exit point
+  batch.Resize(1);
+  batch.SetRay(0, ignition::math::Vector3d(5, 0, 0),
+      ignition::math::Vector3d(15, 0, 0));
+  batch.Reset();
+  batch.Intersect(primitives);
+  EXPECT_NEAR(batch.Distance(0), 0.5, 1e-9);
+
+  // Too short to reach the box
+  batch.SetRay(0, ignition::math::Vector3d(0, 0, 0),
+      ignition::math::Vector3d(4, 0, 0));
+  batch.Reset();
+  batch.Intersect(primitives);
+  EXPECT_DOUBLE_EQ(batch.Distance(0), 4);
+  EXPECT_EQ(batch.HitId(0), 0u);
+
+  // Box behind the ray
+  batch.SetRay(0, ignition::math::Vector3d(6, 0, 0),
+      ignition::math::Vector3d(16, 0, 0));
+  batch.Reset();
+  batch.Intersect(primitives);
+  EXPECT_DOUBLE_EQ(batch.Distance(0), 10);
+  EXPECT_EQ(batch.HitId(0), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RayBatchTest, Sphere)
+{
+  physics::RayBatch batch;
+  this->FanX(21, 10, batch);
+
+  std::vector<physics::RayBatchPrimitive> primitives(1);
+  primitives[0].type = physics::RayBatchPrimitive::SPHERE;
+  primitives[0].pose.Set(5, 0, 0, 0, 0, 0);
+  primitives[0].size.Set(0.5, 0.5, 0.5);
+  primitives[0].bounds = ignition::math::AxisAlignedBox(
+      ignition::math::Vector3d(4.5, -0.5, -0.5),
+      ignition::math::Vector3d(5.5, 0.5, 0.5));
+  primitives[0].id = 3;
+
+  batch.Intersect(primitives);
+  for (unsigned int i = 0; i < batch.Count(); ++i)
+  {
+    const double y = -1.0 + 2.0 * i / 20.0;
+    if (std::abs(y) < 0.5)
+    {
+      EXPECT_NEAR(batch.Distance(i), 5 - std::sqrt(0.25 - y * y), 1e-9);
+      EXPECT_EQ(batch.HitId(i), 3u);
+    }
+    else if (std::abs(y) > 0.5 + 1e-9)
+    {
+      EXPECT_DOUBLE_EQ(batch.Distance(i), 10);
+      EXPECT_EQ(batch.HitId(i), 0u);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(RayBatchTest, Cylinder)
+{
+  physics::RayBatch batch;
+  batch.Resize(3);
+  // Hits the side
+  batch.SetRay(0, ignition::math::Vector3d(0, 0, 0),
+      ignition::math::Vector3d(10, 0, 0));
+  // Hits the top cap
+  batch.SetRay(1, ignition::math::Vector3d(5, 0, 10),
+      ignition::math::Vector3d(5, 0, 0));
+  // Starts inside, exits through the side
+  batch.SetRay(2, ignition::math::Vector3d(5, 0, 0),
+      ignition::math::Vector3d(5, 10, 0));
+  batch.Reset();
+
+  std::vector<physics::RayBatchPrimitive> primitives(1);
+  primitives[0].type = physics::RayBatchPrimitive::CYLINDER;
+  primitives[0].pose.Set(5, 0, 0, 0, 0, 0);
+  primitives[0].size.Set(1, 1, 4);
+  primitives[0].bounds = ignition::math::AxisAlignedBox(
+      ignition::math::Vector3d(4, -1, -2),
+      ignition::math::Vector3d(6, 1, 2));
+  primitives[0].id = 1;
+
+  batch.Intersect(primitives);
+  EXPECT_NEAR(batch.Distance(0), 4, 1e-9);
+  EXPECT_NEAR(batch.Distance(1), 8, 1e-9);
+  EXPECT_NEAR(batch.Distance(2), 1, 1e-9);
+
+  // Lying cylinder, rotated around Y so its axis is along X
+  primitives[0].pose.Set(5, 0, 0, 0, IGN_PI * 0.5, 0);
+  primitives[0].bounds = ignition::math::AxisAlignedBox(
+      ignition::math::Vector3d(3, -1, -1),
+      ignition::math::Vector3d(7, 1, 1));
+  batch.Reset();
+  batch.Intersect(primitives);
+  EXPECT_NEAR(batch.Distance(0), 3, 1e-9);
+  EXPECT_NEAR(batch.Distance(1), 9, 1e-9);
+  EXPECT_NEAR(batch.Distance(2), 1, 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RayBatchTest, Plane)
+{
+  physics::RayBatch batch;
+  batch.Resize(3);
+  // Pointing down at 45 degrees
+  batch.SetRay(0, ignition::math::Vector3d(0, 0, 1),
+      ignition::math::Vector3d(10, 0, -9));
+  // Parallel to the plane
+  batch.SetRay(1, ignition::math::Vector3d(0, 0, 1),
+      ignition::math::Vector3d(10, 0, 1));
+  // Pointing up
+  batch.SetRay(2, ignition::math::Vector3d(0, 0, 1),
+      ignition::math::Vector3d(0, 0, 11));
+  batch.Reset();
+
+  std::vector<physics::RayBatchPrimitive> primitives(1);
+  primitives[0].type = physics::RayBatchPrimitive::PLANE;
+  primitives[0].normal = ignition::math::Vector3d::UnitZ;
+  primitives[0].offset = 0;
+  primitives[0].id = 9;
+
+  batch.Intersect(primitives);
+  EXPECT_NEAR(batch.Distance(0), std::sqrt(2.0), 1e-9);
+  EXPECT_EQ(batch.HitId(0), 9u);
+  EXPECT_DOUBLE_EQ(batch.Distance(1), 10);
+  EXPECT_EQ(batch.HitId(1), 0u);
+  EXPECT_DOUBLE_EQ(batch.Distance(2), 10);
+  EXPECT_EQ(batch.HitId(2), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RayBatchTest, Triangles)
+{
+  physics::RayBatch batch;
+  this->FanX(5, 10, batch);
+
+  // Square in the YZ plane, at x = 3 after translation
+  auto vertices = std::make_shared<std::vector<float>>(
+      std::vector<float>{0, -0.6f, -0.6f, 0, 0.6f, -0.6f,
+                         0, 0.6f, 0.6f, 0, -0.6f, 0.6f});
+  auto indices = std::make_shared<std::vector<int>>(
+      std::vector<int>{0, 1, 2, 0, 2, 3});
+
+  std::vector<physics::RayBatchPrimitive> primitives(1);
+  primitives[0].type = physics::RayBatchPrimitive::TRIANGLES;
+  primitives[0].pose.Set(3, 0, 0, 0, 0, 0);
+  primitives[0].vertices = vertices;
+  primitives[0].indices = indices;
+  primitives[0].bounds = ignition::math::AxisAlignedBox(
+      ignition::math::Vector3d(3, -0.6, -0.6),
+      ignition::math::Vector3d(3, 0.6, 0.6));
+  primitives[0].id = 4;
+
+  batch.Intersect(primitives);
+  // Rays at y = -1, -0.5, 0, 0.5, 1
+  EXPECT_DOUBLE_EQ(batch.Distance(0), 10);
+  EXPECT_NEAR(batch.Distance(1), 3, 1e-6);
+  EXPECT_NEAR(batch.Distance(2), 3, 1e-6);
+  EXPECT_NEAR(batch.Distance(3), 3, 1e-6);
+  EXPECT_DOUBLE_EQ(batch.Distance(4), 10);
+  EXPECT_EQ(batch.HitId(2), 4u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RayBatchTest, Closest)
+{
+  physics::RayBatch batch;
+  this->FanX(1000, 20, batch);
+
+  // A row of spheres and a box hiding some of them
+  std::vector<physics::RayBatchPrimitive> primitives;
+  for (unsigned int i = 0; i < 10; ++i)
+  {
+    physics::RayBatchPrimitive sphere;
+    sphere.type = physics::RayBatchPrimitive::SPHERE;
+    sphere.pose.Set(15, -0.9 + 0.2 * i, 0, 0, 0, 0);
+    sphere.size.Set(0.1, 0.1, 0.1);
+    sphere.bounds = ignition::math::AxisAlignedBox(
+        sphere.pose.Pos() - ignition::math::Vector3d(0.1, 0.1, 0.1),
+        sphere.pose.Pos() + ignition::math::Vector3d(0.1, 0.1, 0.1));
+    sphere.id = 100 + i;
+    primitives.push_back(sphere);
+  }
+
+  physics::RayBatchPrimitive box;
+  box.type = physics::RayBatchPrimitive::BOX;
+  box.pose.Set(10, 0.5, 0, 0, 0, 0);
+  box.size.Set(1, 1, 1);
+  box.bounds = ignition::math::AxisAlignedBox(
+      ignition::math::Vector3d(9.5, 0, -0.5),
+      ignition::math::Vector3d(10.5, 1, 0.5));
+  box.id = 1;
+  primitives.push_back(box);
+
+  physics::RayBatch serial;
+  this->FanX(1000, 20, serial);
+
+  batch.Intersect(primitives, true);
+  serial.Intersect(primitives, false);
+
+  for (unsigned int i = 0; i < batch.Count(); ++i)
+  {
+    const double y = -1.0 + 2.0 * i / 999.0;
+    EXPECT_DOUBLE_EQ(batch.Distance(i), serial.Distance(i));
+    EXPECT_EQ(batch.HitId(i), serial.HitId(i));
+    if (y > 1e-9 && y < 1 - 1e-9)
+    {
+      EXPECT_NEAR(batch.Distance(i), 9.5, 1e-9) << y;
+      EXPECT_EQ(batch.HitId(i), 1u);
+    }
+  }
+
+  // Hits from another method are only kept if closer
+  EXPECT_FALSE(batch.SetHit(999, 15, 2, 0));
+  EXPECT_TRUE(batch.SetHit(999, 5, 2, 0.25f));
+  EXPECT_DOUBLE_EQ(batch.Distance(999), 5);
+  EXPECT_EQ(batch.HitId(999), 2u);
+  EXPECT_FLOAT_EQ(batch.Retro(999), 0.25f);
+
+  // Only the packets around the box
+  std::vector<unsigned int> rays;
+  batch.RaysInBox(box.bounds, rays);
+  ASSERT_FALSE(rays.empty());
+  EXPECT_LT(rays.size(), 1000u);
+  EXPECT_LE(rays.front(), 500u);
+  EXPECT_GE(rays.back(), 998u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cstring>
+#include <vector>
+
+#include "gazebo/physics/Snapshot.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Snapshot private data.
+    class SnapshotPrivate
+    {
+      /// \brief Name of the world.
+      public: std::string worldName;
+
+      /// \brief Simulation time.
+      public: common::Time simTime;
+
+      /// \brief Iteration count.
+      public: uint64_t iterations = 0;
+
+      /// \brief The state of the entities.
+      public: std::vector<char> data;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+Snapshot::Snapshot()
+  : dataPtr(new SnapshotPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+Snapshot::Snapshot(const Snapshot &_snapshot)
+  : dataPtr(new SnapshotPrivate(*_snapshot.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+Snapshot::~Snapshot()
+{
+}
+
+/////////////////////////////////////////////////
+Snapshot &Snapshot::operator=(const Snapshot &_snapshot)
+{
+  if (this != &_snapshot)
+    *this->dataPtr = *_snapshot.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+void Snapshot::Clear()
+{
+  this->dataPtr->worldName.clear();
+  this->dataPtr->simTime = common::Time::Zero;
+  this->dataPtr->iterations = 0;
+  // Keep the capacity, snapshots are usually saved over and over
+  this->dataPtr->data.clear();
+}
+
+/////////////////////////////////////////////////
+bool Snapshot::Empty() const
+{
+  return this->dataPtr->data.empty();
+}
+
+/////////////////////////////////////////////////
+size_t Snapshot::Size() const
+{
+  return this->dataPtr->data.size();
+}
+
+/////////////////////////////////////////////////
+std::string Snapshot::WorldName() const
+{
+  return this->dataPtr->worldName;
+}
+
+/////////////////////////////////////////////////
+void Snapshot::SetWorldName(const std::string &_name)
+{
+  this->dataPtr->worldName = _name;
+}
+
+/////////////////////////////////////////////////
+common::Time Snapshot::SimTime() const
+{
+  return this->dataPtr->simTime;
+}
+
+/////////////////////////////////////////////////
+void Snapshot::SetSimTime(const common::Time &_time)
+{
+  this->dataPtr->simTime = _time;
+}
+
+/////////////////////////////////////////////////
+uint64_t Snapshot::Iterations() const
+{
+  return this->dataPtr->iterations;
+}
+
+/////////////////////////////////////////////////
+void Snapshot::SetIterations(const uint64_t _iterations)
+{
+  this->dataPtr->iterations = _iterations;
+}
+
+/////////////////////////////////////////////////
+void Snapshot::Write(const void *_data, const size_t _size)
+{
+  const char *bytes = static_cast<const char *>(_data);
+  this->dataPtr->data.insert(this->dataPtr->data.end(), bytes, bytes + _size);
+}
+
+/////////////////////////////////////////////////
+void *Snapshot::Allocate(const size_t _size)
+{
+  const size_t offset = this->dataPtr->data.size();
+  this->dataPtr->data.resize(offset + _size);
+  return this->dataPtr->data.data() + offset;
+}
+
+/////////////////////////////////////////////////
+bool Snapshot::Read(size_t &_offset, void *_data, const size_t _size) const
+{
+  if (_offset + _size > this->dataPtr->data.size())
+    return false;
+
+  std::memcpy(_data, this->dataPtr->data.data() + _offset, _size);
+  _offset += _size;
+  return true;
+}
+
+/////////////////////////////////////////////////
+const void *Snapshot::Data(size_t &_offset, const size_t _size) const
+{
+  if (_offset + _size > this->dataPtr->data.size())
+    return nullptr;
+
+  const void *data = this->dataPtr->data.data() + _offset;
+  _offset += _size;
+  return data;
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_SNAPSHOT_HH_
+#define GAZEBO_PHYSICS_SNAPSHOT_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    class SnapshotPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class Snapshot Snapshot.hh physics/physics.hh
+    /// \brief Binary, in-memory copy of the physics state of a world, see
+    /// World::SaveSnapshot and World::RestoreSnapshot.
+    ///
+    /// Unlike WorldState, a snapshot holds the engine-specific state of
+    /// the links and joints, such as the solver warm start data, as well
+    /// as the state of the joint controllers and of the random number
+    /// generators. Restoring it makes the world step exactly as it did
+    /// after the snapshot was saved. A snapshot can only be restored to
+    /// the world it was saved from, as long as no entity was added or
+    /// removed.
+    ///
+    /// The entities write their state with the Write functions while the
+    /// snapshot is saved, and read it back in the same order with the
+    /// Read functions.
+    class GZ_PHYSICS_VISIBLE Snapshot
+    {
+      /// \brief Constructor.
+      public: Snapshot();
+
+      /// \brief Copy constructor.
+      /// \param[in] _snapshot Snapshot to copy.
+      public: Snapshot(const Snapshot &_snapshot);
+
+      /// \brief Destructor.
+      public: virtual ~Snapshot();
+
+      /// \brief Assignment operator.
+      /// \param[in] _snapshot Snapshot to copy.
+      /// \return Reference to this snapshot.
+      public: Snapshot &operator=(const Snapshot &_snapshot);
+
+      /// \brief Remove all the data.
+      public: void Clear();
+
+      /// \brief Get whether the snapshot holds no data.
+      /// \return True if nothing was saved.
+      public: bool Empty() const;
+
+      /// \brief Get the size of the data.
+      /// \return Size in bytes.
+      public: size_t Size() const;
+
+      /// \brief Get the name of the world the snapshot was saved from.
+      /// \return Name of the world.
+      public: std::string WorldName() const;
+
+      /// \brief Set the name of the world the snapshot is saved from.
+      /// \param[in] _name Name of the world.
+      public: void SetWorldName(const std::string &_name);
+
+      /// \brief Get the simulation time of the snapshot.
+      /// \return Simulation time.
+      public: common::Time SimTime() const;
+
+      /// \brief Set the simulation time of the snapshot.
+      /// \param[in] _time Simulation time.
+      public: void SetSimTime(const common::Time &_time);
+
+      /// \brief Get the iteration count of the snapshot.
+      /// \return Number of iterations.
+      public: uint64_t Iterations() const;
+
+      /// \brief Set the iteration count of the snapshot.
+      /// \param[in] _iterations Number of iterations.
+      public: void SetIterations(const uint64_t _iterations);
+
+      /// \brief Append bytes to the data.
+      /// \param[in] _data Bytes to append.
+      /// \param[in] _size Number of bytes.
+      public: void Write(const void *_data, const size_t _size);
+
+      /// \brief Append bytes to the data, to be filled in by the caller.
+      /// \param[in] _size Number of bytes.
+      /// \return The bytes, valid until the next write.
+      public: void *Allocate(const size_t _size);
+
+      /// \brief Append a value to the data.
+      /// \param[in] _value Value to append. Its type must be trivially
+      /// copyable.
+      public: template<typename T>
+              void Write(const T &_value)
+              {
+                static_assert(std::is_trivially_copyable<T>::value,
+                    "Snapshot values must be trivially copyable");
+                this->Write(&_value, sizeof(T));
+              }
+
+      /// \brief Read bytes from the data.
+      /// \param[in,out] _offset Position of the bytes in the data, moved
+      /// past them.
+      /// \param[out] _data Buffer that receives the bytes.
+      /// \param[in] _size Number of bytes.
+      /// \return False if the data is too short.
+      public: bool Read(size_t &_offset, void *_data, const size_t _size)
+                  const;
+
+      /// \brief Get bytes of the data without copying them.
+      /// \param[in,out] _offset Position of the bytes in the data, moved
+      /// past them.
+      /// \param[in] _size Number of bytes.
+      /// \return The bytes, or nullptr if the data is too short.
+      public: const void *Data(size_t &_offset, const size_t _size) const;
+
+      /// \brief Read a value from the data.
+      /// \param[in,out] _offset Position of the value in the data, moved
+      /// past it.
+      /// \param[out] _value Value read.
+      /// \return False if the data is too short.
+      public: template<typename T>
+              bool Read(size_t &_offset, T &_value) const
+              {
+                static_assert(std::is_trivially_copyable<T>::value,
+                    "Snapshot values must be trivially copyable");
+                return this->Read(_offset, &_value, sizeof(T));
+              }
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SnapshotPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
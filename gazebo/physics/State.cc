@@ -131,3 +131,11 @@ void State::SetIterations(const uint64_t _iterations)
 {
   this->iterations = _iterations;
 }
+
+/////////////////////////////////////////////////
+bool State::PoseDiffIsZero(const ignition::math::Pose3d &_pose,
+    const ignition::math::Pose3d &_other)
+{
+  return ignition::math::Pose3d(_pose.Pos() - _other.Pos(),
+      _other.Rot().Inverse() * _pose.Rot()) == ignition::math::Pose3d::Zero;
+}
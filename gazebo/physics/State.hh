@@ -23,6 +23,7 @@
 
 #include <string>
 
+#include <ignition/math/Pose3.hh>
 #include <sdf/sdf.hh>
 
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -120,6 +121,46 @@ namespace gazebo
       /// \param[in] _iterations Iterations when the data was recorded.
       public: virtual void SetIterations(const uint64_t _iterations);
 
+      /// \brief Check whether the difference of two poses, computed as in
+      /// the subtraction operators of the derived states, is zero.
+      /// \param[in] _pose Pose of this state.
+      /// \param[in] _other Pose of the state that is subtracted.
+      /// \return True if the difference is zero.
+      protected: static bool PoseDiffIsZero(
+                     const ignition::math::Pose3d &_pose,
+                     const ignition::math::Pose3d &_other);
+
+      /// \brief Copy a map of states into another one. Entries present
+      /// in both maps are assigned in place, so copying between states of
+      /// the same entities does not allocate.
+      /// \param[in,out] _to Map to update.
+      /// \param[in] _from Map to copy.
+      protected: template<typename M>
+                 static void AssignStates(M &_to, const M &_from)
+                 {
+                   auto to = _to.begin();
+                   auto from = _from.begin();
+                   while (from != _from.end())
+                   {
+                     if (to == _to.end() || from->first < to->first)
+                     {
+                       _to.insert(to, *from);
+                       ++from;
+                     }
+                     else if (to->first < from->first)
+                     {
+                       to = _to.erase(to);
+                     }
+                     else
+                     {
+                       to->second = from->second;
+                       ++to;
+                       ++from;
+                     }
+                   }
+                   _to.erase(to, _to.end());
+                 }
+
       /// \brief Name associated with this State
       protected: std::string name;
 
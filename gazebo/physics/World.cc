@@ -22,8 +22,14 @@
 
 #include <sdf/sdf.hh>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <deque>
+#include <functional>
+#include <limits>
 #include <list>
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
@@ -52,8 +58,10 @@
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/ProfileTimeline.hh"
 #include "gazebo/common/SdfFrameSemantics.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/URI.hh"
@@ -64,6 +72,7 @@
 #include "gazebo/util/Diagnostics.hh"
 #include "gazebo/util/IntrospectionManager.hh"
 #include "gazebo/util/LogRecord.hh"
+#include "gazebo/util/LogRecordFilter.hh"
 
 #include "gazebo/physics/Road.hh"
 #include "gazebo/physics/RayShape.hh"
@@ -74,6 +83,7 @@
 #include "gazebo/physics/Atmosphere.hh"
 #include "gazebo/physics/AtmosphereFactory.hh"
 #include "gazebo/physics/PresetManager.hh"
+#include "gazebo/physics/Snapshot.hh"
 #include "gazebo/physics/UserCmdManager.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/Light.hh"
@@ -87,32 +97,65 @@
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/physics/Population.hh"
 
+#include "gazebo/physics/ode/ODEJoint.hh"
+#include "gazebo/physics/ode/ODELink.hh"
+#include "gazebo/physics/ode/ODEPhysics.hh"
+
 using namespace gazebo;
 using namespace physics;
 
-/// \brief Flag used to say if/when to clear all models.
-/// This will be replaced with a class member variable in Gazebo 3.0
-bool g_clearModels;
+/// \brief Dirty pose buffer of the model update group being processed by
+/// the current thread. This is only set during World::ModelUpdateTBB and
+/// World::SignalUpdateEvent.
+thread_local std::vector<physics::Entity *> *g_modelUpdateDirtyPoses =
+    nullptr;
 
 class ModelUpdate_TBB
 {
-  public: explicit ModelUpdate_TBB(Model_V *_models) : models(_models) {}
+  public: ModelUpdate_TBB(std::vector<Base_V> *_groups,
+              std::vector<std::vector<Entity *>> *_dirtyPoses)
+          : groups(_groups), dirtyPoses(_dirtyPoses) {}
   public: void operator() (const tbb::blocked_range<size_t> &_r) const
   {
     for (size_t i = _r.begin(); i != _r.end(); i++)
     {
-      (*models)[i]->Update();
+      // Redirect World::_AddDirty to the buffer of this group, so that the
+      // dirty entities can be merged in a deterministic order.
+      g_modelUpdateDirtyPoses = &(*this->dirtyPoses)[i];
+      for (auto &entity : (*this->groups)[i])
+        entity->Update();
+      g_modelUpdateDirtyPoses = nullptr;
     }
   }
 
-  private: Model_V *models;
+  private: std::vector<Base_V> *groups;
+  private: std::vector<std::vector<Entity *>> *dirtyPoses;
+};
+
+class EventGroup_TBB
+{
+  public: EventGroup_TBB(const std::function<void (const size_t)> *_run,
+              std::vector<std::vector<Entity *>> *_dirtyPoses)
+          : run(_run), dirtyPoses(_dirtyPoses) {}
+  public: void operator() (const tbb::blocked_range<size_t> &_r) const
+  {
+    for (size_t i = _r.begin(); i != _r.end(); i++)
+    {
+      g_modelUpdateDirtyPoses = &(*this->dirtyPoses)[i];
+      (*this->run)(i);
+      g_modelUpdateDirtyPoses = nullptr;
+    }
+  }
+
+  private: const std::function<void (const size_t)> *run;
+  private: std::vector<std::vector<Entity *>> *dirtyPoses;
 };
 
 //////////////////////////////////////////////////
 World::World(const std::string &_name)
   : dataPtr(new WorldPrivate)
 {
-  g_clearModels = false;
+  this->dataPtr->clearModels = false;
   this->dataPtr->sdf.reset(new sdf::Element);
   sdf::initFile("world.sdf", this->dataPtr->sdf);
 
@@ -129,6 +172,7 @@ World::World(const std::string &_name)
   this->dataPtr->stepInc = 0;
   this->dataPtr->pause = false;
   this->dataPtr->thread = nullptr;
+  this->dataPtr->poolStep = false;
   this->dataPtr->logThread = nullptr;
   this->dataPtr->stop = false;
   this->dataPtr->sensorsInitialized = false;
@@ -259,6 +303,11 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->posePub = this->dataPtr->node->Advertise<msgs::PosesStamped>(
     "~/pose/info", 10, 60);
 
+  // same poses without names, for clients that know the ids from the scene
+  this->dataPtr->poseCompactPub =
+    this->dataPtr->node->Advertise<msgs::PosesStamped>(
+        "~/pose/compact/info", 10, 60);
+
   this->dataPtr->guiPub = this->dataPtr->node->Advertise<msgs::GUI>("~/gui", 5);
   if (this->dataPtr->sdf->HasElement("gui"))
   {
@@ -342,6 +391,23 @@ void World::Load(sdf::ElementPtr _sdf)
           << materialShininessService << "]" << std::endl;
   }
 
+  std::string saveSnapshotService("/" + this->Name() + "/snapshot/save");
+  if (!this->dataPtr->ignNode.Advertise(saveSnapshotService,
+      &World::SaveSnapshotService, this))
+  {
+    gzerr << "Error advertising service ["
+          << saveSnapshotService << "]" << std::endl;
+  }
+
+  std::string restoreSnapshotService(
+      "/" + this->Name() + "/snapshot/restore");
+  if (!this->dataPtr->ignNode.Advertise(restoreSnapshotService,
+      &World::RestoreSnapshotService, this))
+  {
+    gzerr << "Error advertising service ["
+          << restoreSnapshotService << "]" << std::endl;
+  }
+
   // This should come before loading of entities
   sdf::ElementPtr physicsElem = this->dataPtr->sdf->GetElement("physics");
 
@@ -413,6 +479,11 @@ void World::Load(sdf::ElementPtr _sdf)
   // information. The joints must be created last, otherwise they get
   // initialized improperly.
   {
+    // Load the collision meshes concurrently, before the entities that
+    // use them are created one at a time.
+    common::MeshManager::Instance()->Prefetch(this->dataPtr->sdf,
+        "collision");
+
     // Create all the entities
     this->LoadEntities(this->dataPtr->sdf, this->dataPtr->rootElement);
 
@@ -420,13 +491,13 @@ void World::Load(sdf::ElementPtr _sdf)
       this->ModelByIndex(i)->LoadJoints();
   }
 
-  // TODO: Performance test to see if TBB model updating is necessary
-  // Choose threaded or unthreaded model updating depending on the number of
-  // models in the scene
-  // if (this->ModelCount() < 20)
-  this->dataPtr->modelUpdateFunc = &World::ModelUpdateSingleLoop;
-  // else
-  // this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
+  // Choose threaded or unthreaded model updating. Models are updated
+  // sequentially unless parallel updates are requested.
+  {
+    const std::string kElementName = "ignition:parallel_model_update";
+    this->SetParallelModelUpdate(this->dataPtr->sdf->HasElement(kElementName)
+        && this->dataPtr->sdf->Get<bool>(kElementName));
+  }
 
   event::Events::worldCreated(this->Name());
 
@@ -604,6 +675,7 @@ void World::Stop()
 void World::RunLoop()
 {
   this->dataPtr->physicsEngine->InitForThread();
+  GZ_PROFILE_THREAD_NAME("World " + this->Name());
 
   this->dataPtr->startTime = common::Time::GetWallTime();
 
@@ -627,7 +699,10 @@ void World::RunLoop()
         (!this->dataPtr->stopIterations ||
          (this->dataPtr->iterations < this->dataPtr->stopIterations));)
     {
-      this->Step();
+      if (this->dataPtr->batchSteps > 0)
+        this->RunBatch();
+      else
+        this->Step();
     }
   }
   else
@@ -642,6 +717,15 @@ void World::RunLoop()
   }
 
   this->dataPtr->stop = true;
+  this->dataPtr->stepCondition.notify_all();
+
+  // Don't leave a batch waiting on a stopped world
+  if (this->dataPtr->batchSteps > 0)
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->batchMutex);
+    this->dataPtr->batchSteps = 0;
+    this->dataPtr->batchPromise.set_value();
+  }
 
   if (this->dataPtr->logThread)
   {
@@ -751,6 +835,7 @@ void World::SetSensorWaitFunc(std::function<void(double, double)> _func)
 //////////////////////////////////////////////////
 void World::Step()
 {
+  GZ_PROFILE("World::Step");
   DIAG_TIMER_START("World::Step");
 
   IGN_PROFILE("World::Step");
@@ -758,6 +843,7 @@ void World::Step()
   IGN_PROFILE_BEGIN("lockMutex");
   std::lock_guard<std::mutex> lock(this->dataPtr->stepMutex);
   IGN_PROFILE_END();
+  GZ_PROFILE_LAP("World::Step:lockMutex");
 
   IGN_PROFILE_BEGIN("loadPlugins");
   /// need this because ODE does not call dxReallocateWorldProcessContext()
@@ -772,6 +858,7 @@ void World::Step()
 
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Step", "loadPlugins");
+  GZ_PROFILE_LAP("World::Step:loadPlugins");
 
   IGN_PROFILE_BEGIN("publishWorldStats");
   // Send statistics about the world simulation
@@ -779,12 +866,14 @@ void World::Step()
   IGN_PROFILE_END();
 
   DIAG_TIMER_LAP("World::Step", "publishWorldStats");
+  GZ_PROFILE_LAP("World::Step:publishWorldStats");
 
   IGN_PROFILE_BEGIN("waitForSensors");
   if (this->dataPtr->waitForSensors)
     this->dataPtr->waitForSensors(this->dataPtr->simTime.Double(),
         this->dataPtr->physicsEngine->GetMaxStepSize());
   IGN_PROFILE_END();
+  GZ_PROFILE_LAP("World::Step:waitForSensors");
 
   IGN_PROFILE_BEGIN("sleepOffset");
   double updatePeriod = this->dataPtr->physicsEngine->GetUpdatePeriod();
@@ -808,6 +897,7 @@ void World::Step()
 
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Step", "sleepOffset");
+  GZ_PROFILE_LAP("World::Step:sleepOffset");
 
   IGN_PROFILE_BEGIN("worldUpdateMutex");
   // throttling update rate, with sleepOffset as tolerance
@@ -818,6 +908,7 @@ void World::Step()
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
 
     DIAG_TIMER_LAP("World::Step", "worldUpdateMutex");
+    GZ_PROFILE_LAP("World::Step:worldUpdateMutex");
 
     this->dataPtr->prevStepWallTime = common::Time::GetWallTime();
 
@@ -832,9 +923,14 @@ void World::Step()
       this->Update();
 
       DIAG_TIMER_LAP("World::Step", "update");
+      GZ_PROFILE_LAP("World::Step:update");
 
       if (this->IsPaused() && this->dataPtr->stepInc > 0)
+      {
         this->dataPtr->stepInc--;
+        if (this->dataPtr->stepInc == 0)
+          this->dataPtr->stepCondition.notify_all();
+      }
     }
     else
     {
@@ -854,12 +950,15 @@ void World::Step()
   this->ProcessMessages();
   IGN_PROFILE_END();
 
+  GZ_PROFILE_LAP("World::Step:processMessages");
+
   DIAG_TIMER_STOP("World::Step");
 
   IGN_PROFILE_BEGIN("ClearModels");
-  if (g_clearModels)
+  if (this->dataPtr->clearModels)
     this->ClearModels();
   IGN_PROFILE_END();
+  GZ_PROFILE_LAP("World::Step:clearModels");
 }
 
 //////////////////////////////////////////////////
@@ -871,25 +970,153 @@ void World::Step(const unsigned int _steps)
     this->SetPaused(true);
   }
 
+  std::unique_lock<std::recursive_mutex> lock(
+      this->dataPtr->worldUpdateMutex);
+  this->dataPtr->stepInc = _steps;
+
+  // block on completion. The step count can also be changed by world
+  // control messages, so check it periodically.
+  while (this->dataPtr->stepInc != 0 && !this->dataPtr->stop)
   {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
-    this->dataPtr->stepInc = _steps;
+    this->dataPtr->stepCondition.wait_for(lock,
+        std::chrono::milliseconds(10));
   }
+}
+
+//////////////////////////////////////////////////
+std::future<void> World::StepBatch(const unsigned int _steps,
+    const unsigned int _publishPeriod)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->batchMutex);
 
-  // block on completion
-  bool wait = true;
-  while (wait)
+  if (this->dataPtr->batchSteps > 0)
   {
-    common::Time::NSleep(1);
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
-    if (this->dataPtr->stepInc == 0 || this->dataPtr->stop)
-      wait = false;
+    gzerr << "A batch of steps is already running in world["
+          << this->Name() << "]\n";
+    return std::future<void>();
+  }
+
+  this->dataPtr->batchPromise = std::promise<void>();
+  std::future<void> result = this->dataPtr->batchPromise.get_future();
+
+  if (_steps == 0 || this->dataPtr->stop)
+  {
+    this->dataPtr->batchPromise.set_value();
+    return result;
+  }
+
+  this->dataPtr->batchPublishPeriod = std::max(1u, _publishPeriod);
+  this->dataPtr->batchSteps = _steps;
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+void World::RunBatch()
+{
+  IGN_PROFILE("World::RunBatch");
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->stepMutex);
+
+  unsigned int steps;
+  unsigned int publishPeriod;
+  {
+    std::lock_guard<std::mutex> batchLock(this->dataPtr->batchMutex);
+    steps = this->dataPtr->batchSteps;
+    publishPeriod = this->dataPtr->batchPublishPeriod;
+  }
+
+  this->RunSteps(steps, publishPeriod);
+
+  // Throttled steps that follow start from now
+  this->dataPtr->prevStepWallTime = common::Time::GetWallTime();
+
+  {
+    std::lock_guard<std::mutex> batchLock(this->dataPtr->batchMutex);
+    this->dataPtr->batchSteps = 0;
+    this->dataPtr->batchPromise.set_value();
+  }
+
+  if (this->dataPtr->clearModels)
+    this->ClearModels();
+}
+
+//////////////////////////////////////////////////
+void World::StepBlocking(const unsigned int _steps,
+    const unsigned int _publishPeriod)
+{
+  IGN_PROFILE("World::StepBlocking");
+
+  if (this->dataPtr->thread)
+  {
+    gzerr << "World[" << this->Name() << "] runs its own thread, "
+          << "use StepBatch instead of StepBlocking\n";
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->stepMutex);
+
+  // A pool may step the world from a different thread every time
+  this->dataPtr->physicsEngine->InitForThread();
+
+  if (this->dataPtr->startTime == common::Time::Zero)
+    this->dataPtr->startTime = common::Time::GetWallTime();
+
+  this->dataPtr->poolStep = true;
+  this->RunSteps(_steps, std::max(1u, _publishPeriod));
+  this->dataPtr->poolStep = false;
+
+  this->dataPtr->prevStepWallTime = common::Time::GetWallTime();
+
+  if (this->dataPtr->clearModels)
+    this->ClearModels();
+}
+
+//////////////////////////////////////////////////
+void World::RunSteps(const unsigned int _steps,
+    const unsigned int _publishPeriod)
+{
+  for (unsigned int i = 0; i < _steps && !this->dataPtr->stop; ++i)
+  {
+    if (!this->dataPtr->pluginsLoaded && this->SensorsInitialized())
+    {
+      this->LoadPlugins();
+      this->dataPtr->pluginsLoaded = true;
+    }
+
+    const bool publish = (i + 1) % _publishPeriod == 0 ||
+        i + 1 == _steps;
+
+    if (this->dataPtr->waitForSensors)
+      this->dataPtr->waitForSensors(this->dataPtr->simTime.Double(),
+          this->dataPtr->physicsEngine->GetMaxStepSize());
+
+    {
+      std::lock_guard<std::recursive_mutex> updateLock(
+          this->dataPtr->worldUpdateMutex);
+
+      this->dataPtr->simTime += this->dataPtr->physicsEngine->GetMaxStepSize();
+      this->dataPtr->iterations++;
+
+      this->dataPtr->publishStep = publish;
+      this->Update();
+      this->dataPtr->publishStep = true;
+    }
+
+    if (publish)
+    {
+      this->PublishWorldStats();
+      if (!this->dataPtr->poolStep)
+        gazebo::util::IntrospectionManager::Instance()->NotifyUpdates();
+      this->ProcessMessages();
+    }
   }
 }
 
 //////////////////////////////////////////////////
 void World::Update()
 {
+  GZ_PROFILE("World::Update");
   DIAG_TIMER_START("World::Update");
 
   IGN_PROFILE("World::Update");
@@ -907,29 +1134,34 @@ void World::Update()
   }
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "needsReset");
+  GZ_PROFILE_LAP("World::Update:needsReset");
 
   IGN_PROFILE_BEGIN("worldUpdateBegin");
   this->dataPtr->updateInfo.simTime = this->SimTime();
   this->dataPtr->updateInfo.realTime = this->RealTime();
-  event::Events::worldUpdateBegin(this->dataPtr->updateInfo);
+  this->SignalUpdateEvent(event::Events::worldUpdateBegin);
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Events::worldUpdateBegin");
+  GZ_PROFILE_LAP("World::Update:Events::worldUpdateBegin");
 
   IGN_PROFILE_BEGIN("Update");
   // Update all the models
   (*this.*dataPtr->modelUpdateFunc)();
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Model::Update");
+  GZ_PROFILE_LAP("World::Update:Model::Update");
 
   IGN_PROFILE_BEGIN("UpdateCollision");
   // This must be called before PhysicsEngine::UpdatePhysics for ODE.
   this->dataPtr->physicsEngine->UpdateCollision();
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "PhysicsEngine::UpdateCollision");
+  GZ_PROFILE_LAP("World::Update:PhysicsEngine::UpdateCollision");
 
   IGN_PROFILE_BEGIN("beforePhysicsUpdate");
-  // Wait for logging to finish, if it's running.
-  if (util::LogRecord::Instance()->Running())
+  // Wait for logging to finish, if it's running. Worlds stepped by a
+  // pool have no log worker, they log their state after the physics update.
+  if (util::LogRecord::Instance()->Running() && this->dataPtr->logThread)
   {
     std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
 
@@ -946,10 +1178,11 @@ void World::Update()
   // Give clients a possibility to react to collisions before the physics
   // gets updated.
   this->dataPtr->updateInfo.realTime = this->RealTime();
-  event::Events::beforePhysicsUpdate(this->dataPtr->updateInfo);
+  this->SignalUpdateEvent(event::Events::beforePhysicsUpdate);
 
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Events::beforePhysicsUpdate");
+  GZ_PROFILE_LAP("World::Update:Events::beforePhysicsUpdate");
 
   // Update the physics engine
   if (this->dataPtr->enablePhysicsEngine && this->dataPtr->physicsEngine)
@@ -960,6 +1193,7 @@ void World::Update()
 
     IGN_PROFILE_END();
     DIAG_TIMER_LAP("World::Update", "PhysicsEngine::UpdatePhysics");
+    GZ_PROFILE_LAP("World::Update:PhysicsEngine::UpdatePhysics");
 
     // do this after physics update as
     //   ode --> MoveCallback sets the dirtyPoses
@@ -980,25 +1214,42 @@ void World::Update()
     }
 
     DIAG_TIMER_LAP("World::Update", "SetWorldPose(dirtyPoses)");
+    GZ_PROFILE_LAP("World::Update:SetWorldPose(dirtyPoses)");
   }
 
   IGN_PROFILE_BEGIN("LogRecordNotify");
   // Only update state information if logging data.
   if (util::LogRecord::Instance()->Running())
-    this->dataPtr->logCondition.notify_one();
+  {
+    if (this->dataPtr->logThread)
+    {
+      this->dataPtr->logCondition.notify_one();
+    }
+    else
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->logMutex);
+      this->LogState();
+    }
+  }
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "LogRecordNotify");
+  GZ_PROFILE_LAP("World::Update:LogRecordNotify");
 
   IGN_PROFILE_BEGIN("PublishContacts");
   // Output the contact information
-  this->dataPtr->physicsEngine->GetContactManager()->PublishContacts();
+  this->dataPtr->physicsEngine->GetContactManager()->PublishContacts(
+      this->dataPtr->publishStep);
 
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "ContactManager::PublishContacts");
+  GZ_PROFILE_LAP("World::Update:ContactManager::PublishContacts");
 
   event::Events::worldUpdateEnd();
 
-  gazebo::util::IntrospectionManager::Instance()->Update();
+  // The introspection manager evaluates the items of every world, so it
+  // can't be updated while the pool steps the other worlds.
+  if (!this->dataPtr->poolStep)
+    gazebo::util::IntrospectionManager::Instance()->Update();
 
   DIAG_TIMER_STOP("World::Update");
 }
@@ -1039,6 +1290,7 @@ void World::Fini()
 
     this->dataPtr->poseLocalPub.reset();
     this->dataPtr->posePub.reset();
+    this->dataPtr->poseCompactPub.reset();
     this->dataPtr->guiPub.reset();
     this->dataPtr->responsePub.reset();
     this->dataPtr->statPub.reset();
@@ -1061,6 +1313,7 @@ void World::Fini()
   this->dataPtr->publishModelPoses.clear();
   this->dataPtr->publishModelScales.clear();
   this->dataPtr->publishLightPoses.clear();
+  this->dataPtr->posePlans.clear();
 
   // Clean entities
   for (auto &model : this->dataPtr->models)
@@ -1091,10 +1344,11 @@ void World::Fini()
   }
   this->dataPtr->prevStates[0].SetWorld(WorldPtr());
   this->dataPtr->prevStates[1].SetWorld(WorldPtr());
-  this->dataPtr->prevUnfilteredState.SetWorld(WorldPtr());
   this->dataPtr->logPlayState.SetWorld(WorldPtr());
   this->dataPtr->states[0].clear();
   this->dataPtr->states[1].clear();
+  this->dataPtr->stateCount[0] = 0;
+  this->dataPtr->stateCount[1] = 0;
 
   this->dataPtr->presetManager.reset();
   this->dataPtr->userCmdManager.reset();
@@ -1125,14 +1379,14 @@ void World::Fini()
 //////////////////////////////////////////////////
 void World::Clear()
 {
-  g_clearModels = true;
+  this->dataPtr->clearModels = true;
   /// \todo Clear lights too?
 }
 
 //////////////////////////////////////////////////
 void World::ClearModels()
 {
-  g_clearModels = false;
+  this->dataPtr->clearModels = false;
   bool pauseState = this->IsPaused();
   this->SetPaused(true);
 
@@ -1281,6 +1535,7 @@ ModelPtr World::LoadModel(sdf::ElementPtr _sdf , BasePtr _parent)
     model->Load(_sdf);
 
     event::Events::addEntity(model->GetScopedName());
+    this->LogInsertion(model->GetName());
 
     msgs::Model msg;
     model->FillMsg(msg);
@@ -1295,6 +1550,7 @@ ModelPtr World::LoadModel(sdf::ElementPtr _sdf , BasePtr _parent)
 
   this->PublishModelPose(model);
   this->dataPtr->models.push_back(model);
+  this->dataPtr->modelUpdateGroupsDirty = true;
   return model;
 }
 
@@ -1320,6 +1576,7 @@ LightPtr World::LoadLight(const sdf::ElementPtr &_sdf, const BasePtr &_parent)
   light->SetWorld(shared_from_this());
   light->Load(_sdf);
   this->dataPtr->lights.push_back(light);
+  this->LogInsertion(light->GetName());
 
   // msg should contain scoped name (consistent with other entities)
   msg->set_name(light->GetScopedName());
@@ -1342,6 +1599,7 @@ ActorPtr World::LoadActor(sdf::ElementPtr _sdf , BasePtr _parent)
   actor->Load(_sdf);
 
   event::Events::addEntity(actor->GetScopedName());
+  this->LogInsertion(actor->GetName());
 
   msgs::Model msg;
   actor->FillMsg(msg);
@@ -1350,6 +1608,7 @@ ActorPtr World::LoadActor(sdf::ElementPtr _sdf , BasePtr _parent)
   this->EnableAllModels();
   this->PublishModelPose(actor);
   this->dataPtr->models.push_back(actor);
+  this->dataPtr->modelUpdateGroupsDirty = true;
 
   return actor;
 }
@@ -1763,12 +2022,169 @@ void World::BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity)
 
 
 //////////////////////////////////////////////////
-// void World::ModelUpdateTBB()
-// {
-//   tbb::parallel_for (tbb::blocked_range<size_t>(0,
-//   this->dataPtr->models.size(), 10),
-//       ModelUpdate_TBB(&this->dataPtr->models));
-// }
+void World::ModelUpdateTBB()
+{
+  // Entities can also be added to or removed from the root element
+  // directly (e.g. lights), so check the number of children as well.
+  if (this->dataPtr->modelUpdateGroupsDirty ||
+      this->dataPtr->rootElement->GetChildCount() !=
+      this->dataPtr->modelUpdateGroupsSize)
+  {
+    this->BuildModelUpdateGroups();
+  }
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0,
+      this->dataPtr->modelUpdateGroups.size()),
+      ModelUpdate_TBB(&this->dataPtr->modelUpdateGroups,
+                      &this->dataPtr->modelUpdateDirtyPoses));
+
+  // Merge the dirty entities in group order.
+  for (auto &dirty : this->dataPtr->modelUpdateDirtyPoses)
+  {
+    this->dataPtr->dirtyPoses.insert(this->dataPtr->dirtyPoses.end(),
+        dirty.begin(), dirty.end());
+    dirty.clear();
+  }
+}
+
+//////////////////////////////////////////////////
+void World::SignalUpdateEvent(
+    event::EventT<void (const common::UpdateInfo &)> &_event)
+{
+  if (!this->ParallelModelUpdate())
+  {
+    _event(this->dataPtr->updateInfo);
+    return;
+  }
+
+  _event.SignalGrouped(this->dataPtr->updateInfo,
+      [this](const size_t _count,
+             const std::function<void (const size_t)> &_run)
+      {
+        auto &dirtyPoses = this->dataPtr->eventDirtyPoses;
+        if (dirtyPoses.size() < _count)
+          dirtyPoses.resize(_count);
+
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, _count),
+            EventGroup_TBB(&_run, &dirtyPoses));
+
+        // Merge the dirty entities in group order.
+        for (size_t i = 0; i < _count; ++i)
+        {
+          this->dataPtr->dirtyPoses.insert(this->dataPtr->dirtyPoses.end(),
+              dirtyPoses[i].begin(), dirtyPoses[i].end());
+          dirtyPoses[i].clear();
+        }
+      });
+}
+
+//////////////////////////////////////////////////
+void World::BuildModelUpdateGroups()
+{
+  this->dataPtr->modelUpdateGroupsDirty = false;
+
+  const BasePtr &root = this->dataPtr->rootElement;
+  const unsigned int count = root->GetChildCount();
+
+  // Index of each top level entity in the root element.
+  std::map<const Base *, size_t> topIndex;
+  for (unsigned int i = 0; i < count; ++i)
+    topIndex[root->GetChild(i).get()] = i;
+
+  // Find the index of the top level entity that contains _base.
+  auto topLevel = [&](BasePtr _base) -> int
+  {
+    while (_base && _base->GetParent() && _base->GetParent() != root)
+      _base = _base->GetParent();
+
+    auto iter = topIndex.find(_base.get());
+    return iter == topIndex.end() ? -1 : static_cast<int>(iter->second);
+  };
+
+  // Union-find over the top level entities.
+  std::vector<size_t> parent(count);
+  for (size_t i = 0; i < count; ++i)
+    parent[i] = i;
+
+  std::function<size_t(size_t)> find = [&](size_t _i) -> size_t
+  {
+    while (parent[_i] != _i)
+    {
+      parent[_i] = parent[parent[_i]];
+      _i = parent[_i];
+    }
+    return _i;
+  };
+
+  auto merge = [&](const size_t _a, const int _b)
+  {
+    if (_b < 0)
+      return;
+    size_t ra = find(_a);
+    size_t rb = find(static_cast<size_t>(_b));
+    // Keep the smallest index as the root, so that groups are ordered by
+    // their first member.
+    if (ra < rb)
+      parent[rb] = ra;
+    else if (rb < ra)
+      parent[ra] = rb;
+  };
+
+  // Connect models that share joints or static attachments, including the
+  // joints and attachments of nested models.
+  std::function<void(size_t, const ModelPtr &)> connect =
+    [&](const size_t _index, const ModelPtr &_model)
+  {
+    for (auto const &attached : _model->AttachedStaticModels())
+      merge(_index, topLevel(attached));
+
+    for (auto const &link : _model->GetLinks())
+    {
+      for (auto const &attached : link->AttachedStaticModels())
+        merge(_index, topLevel(attached));
+
+      for (auto const &joint : link->GetParentJoints())
+      {
+        merge(_index, topLevel(joint->GetParent()));
+        merge(_index, topLevel(joint->GetChild()));
+      }
+
+      for (auto const &joint : link->GetChildJoints())
+      {
+        merge(_index, topLevel(joint->GetParent()));
+        merge(_index, topLevel(joint->GetChild()));
+      }
+    }
+
+    for (auto const &nested : _model->NestedModels())
+      connect(_index, nested);
+  };
+
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    BasePtr child = root->GetChild(i);
+    if (child->HasType(Base::MODEL))
+      connect(i, boost::static_pointer_cast<Model>(child));
+  }
+
+  // Build the groups, ordered by their first member.
+  auto &groups = this->dataPtr->modelUpdateGroups;
+  groups.clear();
+  std::vector<int> groupIndex(count, -1);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    size_t r = find(i);
+    if (groupIndex[r] < 0)
+    {
+      groupIndex[r] = static_cast<int>(groups.size());
+      groups.push_back(Base_V());
+    }
+    groups[groupIndex[r]].push_back(root->GetChild(i));
+  }
+
+  this->dataPtr->modelUpdateDirtyPoses.resize(groups.size());
+  this->dataPtr->modelUpdateGroupsSize = count;
+}
 
 //////////////////////////////////////////////////
 void World::ModelUpdateSingleLoop()
@@ -2029,6 +2445,49 @@ void World::ProcessRequestMsgs()
       sphereCoordMsg.SerializeToString(serializedData);
       response.set_type(sphereCoordMsg.GetTypeName());
     }
+    else if (requestMsg.request().find("profile_") == 0)
+    {
+      common::ProfileTimeline *timeline = common::ProfileTimeline::Instance();
+      std::ostringstream stream;
+      bool known = true;
+
+      if (requestMsg.request() == "profile_enable")
+      {
+        timeline->SetEnabled(requestMsg.data() != "0");
+      }
+      else if (requestMsg.request() == "profile_clear")
+      {
+        timeline->Clear();
+      }
+      else if (requestMsg.request() == "profile_stats")
+      {
+        // The data holds the length of the window in seconds
+        double window = std::strtod(requestMsg.data().c_str(), nullptr);
+        if (window <= 0)
+          window = 10;
+        timeline->WriteStats(stream, window);
+      }
+      else if (requestMsg.request() == "profile_trace")
+      {
+        timeline->WriteTrace(stream);
+      }
+      else
+      {
+        known = false;
+        response.set_type("error");
+        response.set_response("nonexistent");
+      }
+
+      if (known)
+      {
+        msgs::GzString msg;
+        msg.set_data(stream.str());
+
+        std::string *serializedData = response.mutable_serialized_data();
+        msg.SerializeToString(serializedData);
+        response.set_type(msg.GetTypeName());
+      }
+    }
     else
       send = false;
 
@@ -2414,6 +2873,227 @@ EntityPtr World::EntityBelowPoint(const ignition::math::Vector3d &_pt) const
   return this->EntityByName(entityName);
 }
 
+//////////////////////////////////////////////////
+/// \brief Collect the entities that hold state in a snapshot, in a fixed
+/// order.
+/// \param[in] _models Models to visit, along with their nested models.
+/// \param[out] _links Links of the models.
+/// \param[out] _joints Joints of the models.
+/// \param[out] _controllers Joint controllers of the models.
+static void SnapshotEntities(const Model_V &_models, Link_V &_links,
+    Joint_V &_joints, std::vector<JointControllerPtr> &_controllers)
+{
+  for (auto const &model : _models)
+  {
+    _links.insert(_links.end(), model->GetLinks().begin(),
+        model->GetLinks().end());
+    _joints.insert(_joints.end(), model->GetJoints().begin(),
+        model->GetJoints().end());
+    if (model->GetJointController())
+      _controllers.push_back(model->GetJointController());
+
+    SnapshotEntities(model->NestedModels(), _links, _joints, _controllers);
+  }
+}
+
+//////////////////////////////////////////////////
+void World::SaveSnapshot(Snapshot &_snapshot)
+{
+  IGN_PROFILE("World::SaveSnapshot");
+
+  std::lock_guard<std::recursive_mutex> lock(
+      this->dataPtr->worldUpdateMutex);
+  boost::recursive_mutex::scoped_lock plock(
+      *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex());
+
+  _snapshot.Clear();
+  _snapshot.SetWorldName(this->Name());
+  _snapshot.SetSimTime(this->dataPtr->simTime);
+  _snapshot.SetIterations(this->dataPtr->iterations);
+
+  Link_V links;
+  Joint_V joints;
+  std::vector<JointControllerPtr> controllers;
+  SnapshotEntities(this->dataPtr->models, links, joints, controllers);
+
+  // The entities, checked before anything is restored
+  _snapshot.Write(static_cast<uint32_t>(links.size()));
+  for (auto const &link : links)
+    _snapshot.Write(link->GetId());
+  _snapshot.Write(static_cast<uint32_t>(joints.size()));
+  for (auto const &joint : joints)
+    _snapshot.Write(joint->GetId());
+  _snapshot.Write(static_cast<uint32_t>(controllers.size()));
+
+  // The state of the global generator can't be read, so continue from a
+  // seed drawn from it
+  const unsigned int seed = static_cast<unsigned int>(
+      ignition::math::Rand::IntUniform(1, std::numeric_limits<int>::max()));
+  ignition::math::Rand::Seed(seed);
+  _snapshot.Write(seed);
+
+  // ODE saves its own state of the bodies, joints and spaces. Other
+  // engines only save the poses and velocities of the links.
+  ODEPhysicsPtr ode = boost::dynamic_pointer_cast<ODEPhysics>(
+      this->dataPtr->physicsEngine);
+
+  for (auto const &link : links)
+  {
+    if (ode)
+      boost::static_pointer_cast<ODELink>(link)->SaveSnapshot(_snapshot);
+    else
+      link->SaveSnapshot(_snapshot);
+  }
+  for (auto const &joint : joints)
+  {
+    if (ode)
+      boost::static_pointer_cast<ODEJoint>(joint)->SaveSnapshot(_snapshot);
+  }
+  for (auto const &controller : controllers)
+    controller->SaveSnapshot(_snapshot);
+  if (ode)
+    ode->SaveSnapshot(_snapshot);
+}
+
+//////////////////////////////////////////////////
+bool World::RestoreSnapshot(const Snapshot &_snapshot)
+{
+  IGN_PROFILE("World::RestoreSnapshot");
+
+  if (_snapshot.WorldName() != this->Name())
+  {
+    gzerr << "Snapshot of world[" << _snapshot.WorldName()
+          << "] can't be restored to world[" << this->Name() << "]\n";
+    return false;
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(
+      this->dataPtr->worldUpdateMutex);
+  boost::recursive_mutex::scoped_lock plock(
+      *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex());
+
+  Link_V links;
+  Joint_V joints;
+  std::vector<JointControllerPtr> controllers;
+  SnapshotEntities(this->dataPtr->models, links, joints, controllers);
+
+  size_t offset = 0;
+  uint32_t count;
+  uint32_t id;
+  bool match = _snapshot.Read(offset, count) && count == links.size();
+  for (size_t i = 0; match && i < links.size(); ++i)
+    match = _snapshot.Read(offset, id) && id == links[i]->GetId();
+  match = match && _snapshot.Read(offset, count) && count == joints.size();
+  for (size_t i = 0; match && i < joints.size(); ++i)
+    match = _snapshot.Read(offset, id) && id == joints[i]->GetId();
+  match = match && _snapshot.Read(offset, count) &&
+    count == controllers.size();
+  if (!match)
+  {
+    gzerr << "The entities of world[" << this->Name()
+          << "] changed since the snapshot was saved\n";
+    return false;
+  }
+
+  // Check every section before anything is restored, so that a corrupted
+  // snapshot leaves the world untouched
+  ODEPhysicsPtr ode = boost::dynamic_pointer_cast<ODEPhysics>(
+      this->dataPtr->physicsEngine);
+  const size_t stateOffset = offset;
+  unsigned int seed;
+  bool valid = _snapshot.Read(offset, seed);
+  for (size_t i = 0; valid && i < links.size(); ++i)
+  {
+    if (ode)
+    {
+      valid = boost::static_pointer_cast<ODELink>(links[i])->CheckSnapshot(
+          _snapshot, offset);
+    }
+    else
+      valid = links[i]->CheckSnapshot(_snapshot, offset);
+  }
+  for (size_t i = 0; ode && valid && i < joints.size(); ++i)
+  {
+    valid = boost::static_pointer_cast<ODEJoint>(joints[i])->CheckSnapshot(
+        _snapshot, offset);
+  }
+  for (size_t i = 0; valid && i < controllers.size(); ++i)
+    valid = controllers[i]->CheckSnapshot(_snapshot, offset);
+  if (ode)
+    valid = valid && ode->CheckSnapshot(_snapshot, offset);
+  if (!valid || offset != _snapshot.Size())
+  {
+    gzerr << "Snapshot of world[" << this->Name() << "] is corrupted\n";
+    return false;
+  }
+
+  offset = stateOffset;
+  _snapshot.Read(offset, seed);
+  bool restored = true;
+  for (auto const &link : links)
+  {
+    if (ode)
+    {
+      restored = boost::static_pointer_cast<ODELink>(link)->RestoreSnapshot(
+          _snapshot, offset) && restored;
+    }
+    else
+      restored = link->RestoreSnapshot(_snapshot, offset) && restored;
+  }
+  for (auto const &joint : joints)
+  {
+    if (ode)
+    {
+      restored = boost::static_pointer_cast<ODEJoint>(joint)->RestoreSnapshot(
+          _snapshot, offset) && restored;
+    }
+  }
+  for (size_t i = 0; i < controllers.size(); ++i)
+    restored = controllers[i]->RestoreSnapshot(_snapshot, offset) && restored;
+  if (ode)
+    restored = ode->RestoreSnapshot(_snapshot, offset) && restored;
+  GZ_ASSERT(restored, "Snapshot restore failed after it was checked");
+
+  ignition::math::Rand::Seed(seed);
+  this->dataPtr->simTime = _snapshot.SimTime();
+  this->dataPtr->iterations = _snapshot.Iterations();
+
+  // Propagate the restored link poses, as after a step
+  for (auto &dirtyEntity : this->dataPtr->dirtyPoses)
+    dirtyEntity->SetWorldPose(dirtyEntity->DirtyPose(), false);
+  this->dataPtr->dirtyPoses.clear();
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool World::SaveSnapshotService(const ignition::msgs::StringMsg &_request,
+    ignition::msgs::Boolean &_response)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->snapshotsMutex);
+  this->SaveSnapshot(this->dataPtr->snapshots[_request.data()]);
+  _response.set_data(true);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool World::RestoreSnapshotService(const ignition::msgs::StringMsg &_request,
+    ignition::msgs::Boolean &_response)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->snapshotsMutex);
+  auto iter = this->dataPtr->snapshots.find(_request.data());
+  if (iter == this->dataPtr->snapshots.end())
+  {
+    gzerr << "No snapshot named[" << _request.data() << "] in world["
+          << this->Name() << "]\n";
+    _response.set_data(false);
+    return true;
+  }
+
+  _response.set_data(this->RestoreSnapshot(iter->second));
+  return true;
+}
+
 //////////////////////////////////////////////////
 void World::SetState(const WorldState &_state)
 {
@@ -2717,6 +3397,14 @@ bool World::OnLog(std::ostringstream &_stream)
   // Save the entire state when its the first call to OnLog.
   if (util::LogRecord::Instance()->FirstUpdate())
   {
+    // The entities inserted or deleted before recording started, and not
+    // logged by the previous recording, are part of the whole state.
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->logEntityMutex);
+      this->dataPtr->logInsertions.clear();
+      this->dataPtr->logDeletions.clear();
+    }
+
     this->dataPtr->sdf->Update();
     _stream << "<sdf version ='";
     _stream << SDF_VERSION;
@@ -2724,20 +3412,21 @@ bool World::OnLog(std::ostringstream &_stream)
     _stream << this->dataPtr->sdf->ToString("");
     _stream << "</sdf>\n";
   }
-  else if (this->dataPtr->states[bufferIndex].size() >= 1)
+  else if (this->dataPtr->stateCount[bufferIndex] >= 1)
   {
     {
       std::lock_guard<std::mutex> lock(this->dataPtr->logBufferMutex);
       this->dataPtr->currentStateBuffer ^= 1;
     }
-    for (auto const &worldState : this->dataPtr->states[bufferIndex])
+    for (size_t i = 0; i < this->dataPtr->stateCount[bufferIndex]; ++i)
     {
       _stream << "<sdf version='" << SDF_VERSION << "'>"
-              << worldState
+              << this->dataPtr->states[bufferIndex][i]
               << "</sdf>";
     }
 
-    this->dataPtr->states[bufferIndex].clear();
+    // Keep the states, they are reused by the log worker.
+    this->dataPtr->stateCount[bufferIndex] = 0;
   }
 
   // Logging has stopped. Wait for log worker to finish. Output last bit
@@ -2747,27 +3436,22 @@ bool World::OnLog(std::ostringstream &_stream)
     std::lock_guard<std::mutex> lock(this->dataPtr->logBufferMutex);
 
     // Output any data that may have been pushed onto the queue
-    for (size_t i = 0;
-        i < this->dataPtr->states[this->dataPtr->currentStateBuffer^1].size();
-        ++i)
-    {
-      _stream << "<sdf version='" << SDF_VERSION << "'>"
-        << this->dataPtr->states[this->dataPtr->currentStateBuffer^1][i]
-        << "</sdf>";
-    }
-
-    for (size_t i = 0;
-        i < this->dataPtr->states[this->dataPtr->currentStateBuffer].size();
-        ++i)
+    for (int buffer : {this->dataPtr->currentStateBuffer ^ 1,
+                       this->dataPtr->currentStateBuffer})
     {
-      _stream << "<sdf version='" << SDF_VERSION << "'>"
-        << this->dataPtr->states[this->dataPtr->currentStateBuffer][i]
-        << "</sdf>";
+      for (size_t i = 0; i < this->dataPtr->stateCount[buffer]; ++i)
+      {
+        _stream << "<sdf version='" << SDF_VERSION << "'>"
+          << this->dataPtr->states[buffer][i]
+          << "</sdf>";
+      }
     }
 
     // Clear everything.
     this->dataPtr->states[0].clear();
     this->dataPtr->states[1].clear();
+    this->dataPtr->stateCount[0] = 0;
+    this->dataPtr->stateCount[1] = 0;
     this->dataPtr->stateToggle = 0;
     this->dataPtr->prevStates[0] = WorldState();
     this->dataPtr->prevStates[1] = WorldState();
@@ -2778,69 +3462,127 @@ bool World::OnLog(std::ostringstream &_stream)
   return true;
 }
 
+/// \brief Get the pose publication plan of a model, which is rebuilt when
+/// the structure of the model changed.
+/// \param[in,out] _plans Plans by model id.
+/// \param[in] _model The model.
+/// \return The plan.
+static const ModelPosePlan &PosePlan(std::map<uint32_t, ModelPosePlan> &_plans,
+    const ModelPtr &_model)
+{
+  auto inserted = _plans.insert(
+      std::make_pair(_model->GetId(), ModelPosePlan()));
+  ModelPosePlan &plan = inserted.first->second;
+
+  if (!inserted.second &&
+      plan.structureVersion == _model->StructureVersion())
+  {
+    return plan;
+  }
+
+  plan.structureVersion = _model->StructureVersion();
+  plan.entities.clear();
+  plan.ids.clear();
+  plan.names.clear();
+
+  auto add = [&plan](Entity *_entity)
+  {
+    plan.entities.push_back(_entity);
+    plan.ids.push_back(_entity->GetId());
+    plan.names.push_back(_entity->GetScopedName());
+  };
+
+  std::list<ModelPtr> modelList;
+  modelList.push_back(_model);
+  while (!modelList.empty())
+  {
+    ModelPtr m = modelList.front();
+    modelList.pop_front();
+
+    add(m.get());
+
+    for (auto const &link : m->GetLinks())
+      add(link.get());
+
+    // add all nested models to the queue
+    for (auto const &n : m->NestedModels())
+      modelList.push_back(n);
+  }
+
+  return plan;
+}
+
 //////////////////////////////////////////////////
 void World::ProcessMessages()
 {
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
 
+    const bool compact = this->dataPtr->poseCompactPub &&
+        this->dataPtr->poseCompactPub->HasConnections();
+
     if ((this->dataPtr->posePub && this->dataPtr->posePub->HasConnections()) ||
       // When ready to use the direct API for updating scene poses from server,
       // uncomment the following line:
-         this->dataPtr->updateScenePoses ||
+         this->dataPtr->updateScenePoses || compact ||
         (this->dataPtr->poseLocalPub &&
          this->dataPtr->poseLocalPub->HasConnections()))
     {
-      msgs::PosesStamped msg;
+      // Reuse the messages, so that their poses and names are only
+      // allocated when the set of published entities grows.
+      msgs::PosesStamped &msg = this->dataPtr->posesMsg;
+      msg.Clear();
+
+      msgs::PosesStamped &compactMsg = this->dataPtr->compactPosesMsg;
+      compactMsg.Clear();
 
       // Time stamp this PosesStamped message
       msgs::Set(msg.mutable_time(), this->SimTime());
+      if (compact)
+        compactMsg.mutable_time()->CopyFrom(msg.time());
+
+      auto addPose = [&](const uint32_t _id, const std::string &_name,
+          const ignition::math::Pose3d &_pose)
+      {
+        msgs::Pose *poseMsg = msg.add_pose();
+        poseMsg->set_name(_name);
+        poseMsg->set_id(_id);
+        msgs::Set(poseMsg, _pose);
+
+        if (compact)
+        {
+          poseMsg = compactMsg.add_pose();
+          poseMsg->set_id(_id);
+          msgs::Set(poseMsg, _pose);
+        }
+      };
 
       if (!this->dataPtr->publishModelPoses.empty() ||
           !this->dataPtr->publishLightPoses.empty())
       {
         for (auto const &model : this->dataPtr->publishModelPoses)
         {
-          std::list<ModelPtr> modelList;
-          modelList.push_back(model);
-          while (!modelList.empty())
+          // Publish the relative poses of the model, its links and its
+          // nested models
+          const ModelPosePlan &plan =
+              PosePlan(this->dataPtr->posePlans, model);
+          for (size_t i = 0; i < plan.entities.size(); ++i)
           {
-            ModelPtr m = modelList.front();
-            modelList.pop_front();
-            msgs::Pose *poseMsg = msg.add_pose();
-
-            // Publish the model's relative pose
-            poseMsg->set_name(m->GetScopedName());
-            poseMsg->set_id(m->GetId());
-            msgs::Set(poseMsg, m->RelativePose());
-
-            // Publish each of the model's child links relative poses
-            Link_V links = m->GetLinks();
-            for (auto const &link : links)
-            {
-              poseMsg = msg.add_pose();
-              poseMsg->set_name(link->GetScopedName());
-              poseMsg->set_id(link->GetId());
-              msgs::Set(poseMsg, link->RelativePose());
-            }
-
-            // add all nested models to the queue
-            Model_V models = m->NestedModels();
-            for (auto const &n : models)
-              modelList.push_back(n);
+            addPose(plan.ids[i], plan.names[i],
+                plan.entities[i]->RelativePose());
           }
         }
 
         for (auto const &light : this->dataPtr->publishLightPoses)
         {
-          msgs::Pose *poseMsg = msg.add_pose();
-
           // Publish the light's pose
-          poseMsg->set_name(light->GetScopedName());
-          poseMsg->set_id(light->GetId());
-          msgs::Set(poseMsg, light->RelativePose());
+          addPose(light->GetId(), light->GetScopedName(),
+              light->RelativePose());
         }
 
+        if (compact)
+          this->dataPtr->poseCompactPub->Publish(compactMsg);
+
         if (this->dataPtr->posePub && this->dataPtr->posePub->HasConnections())
           this->dataPtr->posePub->Publish(msg);
       }
@@ -3018,90 +3760,131 @@ void World::LogWorker()
 {
   std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
 
-  WorldPtr self = shared_from_this();
   this->dataPtr->logPrevIteration = this->dataPtr->iterations;
 
+  while (!this->dataPtr->stop)
+  {
+    this->LogState();
+
+    this->dataPtr->logContinueCondition.notify_all();
+
+    // Wait until there is work to be done.
+    this->dataPtr->logCondition.wait(lock);
+  }
+
+  // Make sure nothing is blocked by this thread.
+  this->dataPtr->logContinueCondition.notify_all();
+}
+
+/////////////////////////////////////////////////
+void World::LogState()
+{
+  WorldPtr self = shared_from_this();
+
   GZ_ASSERT(self, "Self pointer to World is invalid");
 
-  // Init the prevUnfilteredState
-  this->dataPtr->prevUnfilteredState.Load(self);
+  std::vector<std::string> &insertedNames =
+      this->dataPtr->logStateInsertedNames;
+  std::vector<std::string> &insertions = this->dataPtr->logStateInsertions;
+  std::vector<std::string> &deletions = this->dataPtr->logStateDeletions;
 
-  while (!this->dataPtr->stop)
   {
-    // get unfiltered world state
-    WorldState unfilteredState;
+    std::lock_guard<std::mutex> eLock(this->dataPtr->logEntityMutex);
+    insertedNames.swap(this->dataPtr->logInsertions);
+    deletions.swap(this->dataPtr->logDeletions);
+  }
+  bool insertDelete = !insertedNames.empty() || !deletions.empty();
+
+  // Throttle state capture based on log recording frequency.
+  auto simTime = this->SimTime();
+  if ((simTime - this->dataPtr->logLastStateTime >=
+      util::LogRecord::Instance()->Period()) || insertDelete)
+  {
+    int currState = (this->dataPtr->stateToggle + 1) % 2;
+    WorldState &state = this->dataPtr->prevStates[currState];
+
+    std::shared_ptr<const util::LogRecordFilter> filter =
+        util::LogRecord::Instance()->CompiledFilter();
+    // Update the filtered state in place, and compare it with the
+    // previous one.
+    bool changed;
     {
       std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
-      unfilteredState.Load(self);
-    }
-
-    // compute world state diff and find out about insertions and deletions
-    std::vector<std::string> insertions;
-    std::vector<std::string> deletions;
-    bool insertDelete = false;
+      state.Load(self, *filter);
+      changed = !state.DiffIsZero(
+          this->dataPtr->prevStates[this->dataPtr->stateToggle]);
 
-    {
-      WorldState unfilteredDiffState = unfilteredState -
-          this->dataPtr->prevUnfilteredState;
-      if (!unfilteredDiffState.IsZero())
+      // Get the description of the inserted entities.
+      for (auto const &name : insertedNames)
       {
-        insertions = unfilteredDiffState.Insertions();
-        deletions = unfilteredDiffState.Deletions();
-        insertDelete = !insertions.empty() || !deletions.empty();
+        if (ModelPtr model = this->ModelByName(name))
+          insertions.push_back(model->UnscaledSDF()->ToString(""));
+        else if (LightPtr light = this->LightByName(name))
+          insertions.push_back(light->GetSDF()->ToString(""));
       }
     }
-    this->dataPtr->prevUnfilteredState = unfilteredState;
+    this->dataPtr->logPrevIteration = this->dataPtr->iterations;
 
-    // Throttle state capture based on log recording frequency.
-    auto simTime = this->SimTime();
-    if ((simTime - this->dataPtr->logLastStateTime >=
-        util::LogRecord::Instance()->Period()) || insertDelete)
+    if (changed || insertDelete)
     {
-      int currState = (this->dataPtr->stateToggle + 1) % 2;
-
-      std::string filterStr = util::LogRecord::Instance()->Filter();
-      // compute diff for filtered states
+      this->dataPtr->stateToggle = currState;
       {
-        std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
-        this->dataPtr->prevStates[currState].LoadWithFilter(self, filterStr);
-      }
-      WorldState diffState = this->dataPtr->prevStates[currState] -
-          this->dataPtr->prevStates[this->dataPtr->stateToggle];
-      this->dataPtr->logPrevIteration = this->dataPtr->iterations;
+        // Store the entire current state (instead of the diffState). A slow
+        // moving link may never be captured if only diff state is recorded.
+        std::lock_guard<std::mutex> bLock(this->dataPtr->logBufferMutex);
+
+        state.SetInsertions(insertions);
+        state.SetDeletions(deletions);
+
+        // Reuse a state from the pool if there is one.
+        int buffer = this->dataPtr->currentStateBuffer;
+        size_t &count = this->dataPtr->stateCount[buffer];
+        if (count < this->dataPtr->states[buffer].size())
+          this->dataPtr->states[buffer][count] = state;
+        else
+          this->dataPtr->states[buffer].push_back(state);
+        ++count;
 
-      if (!diffState.IsZero() || insertDelete)
-      {
-        this->dataPtr->stateToggle = currState;
-        {
-          // Store the entire current state (instead of the diffState). A slow
-          // moving link may never be captured if only diff state is recorded.
-          std::lock_guard<std::mutex> bLock(this->dataPtr->logBufferMutex);
-
-          this->dataPtr->prevStates[currState].SetInsertions(insertions);
-          this->dataPtr->prevStates[currState].SetDeletions(deletions);
-          this->dataPtr->states[this->dataPtr->currentStateBuffer].push_back(
-              this->dataPtr->prevStates[currState]);
-
-          // Tell the logger to update, once the number of states exceeds 1000
-          if (this->dataPtr->states[this->dataPtr->currentStateBuffer].size() >
-              1000)
-          {
-            util::LogRecord::Instance()->Notify();
-          }
-        }
+        // Tell the logger to update, once the number of states exceeds 1000
+        if (count > 1000)
+          util::LogRecord::Instance()->Notify();
       }
-
-      this->dataPtr->logLastStateTime = simTime;
     }
 
-    this->dataPtr->logContinueCondition.notify_all();
-
-    // Wait until there is work to be done.
-    this->dataPtr->logCondition.wait(lock);
+    this->dataPtr->logLastStateTime = simTime;
   }
 
-  // Make sure nothing is blocked by this thread.
-  this->dataPtr->logContinueCondition.notify_all();
+  insertedNames.clear();
+  insertions.clear();
+  deletions.clear();
+}
+
+/////////////////////////////////////////////////
+void World::LogInsertion(const std::string &_name)
+{
+  // The first logged frame contains the whole world.
+  if (!util::LogRecord::Instance()->Running())
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->logEntityMutex);
+  this->dataPtr->logInsertions.push_back(_name);
+}
+
+/////////////////////////////////////////////////
+void World::LogDeletion(const std::string &_name)
+{
+  if (!util::LogRecord::Instance()->Running())
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->logEntityMutex);
+
+  // An entity inserted and deleted before it was logged is not recorded.
+  auto &insertions = this->dataPtr->logInsertions;
+  auto iter = std::find(insertions.begin(), insertions.end(), _name);
+  if (iter != insertions.end())
+    insertions.erase(iter);
+  else
+    this->dataPtr->logDeletions.push_back(_name);
 }
 
 /////////////////////////////////////////////////
@@ -3167,8 +3950,10 @@ void World::RemoveModel(const std::string &_name)
     {
       if ((*model)->GetName() == _name || (*model)->GetScopedName() == _name)
       {
+        this->LogDeletion((*model)->GetName());
         this->dataPtr->models.erase(model);
         this->dataPtr->rootElement->RemoveChild(_name);
+        this->dataPtr->modelUpdateGroupsDirty = true;
         break;
       }
     }
@@ -3189,6 +3974,7 @@ void World::RemoveModel(const std::string &_name)
           // list
           (*light)->GetParent()->RemoveChild(*light);
         }
+        this->LogDeletion((*light)->GetName());
         this->dataPtr->lights.erase(light);
         break;
       }
@@ -3219,6 +4005,16 @@ void World::RemoveModel(const std::string &_name)
         break;
       }
     }
+
+    for (auto plan = this->dataPtr->posePlans.begin();
+             plan != this->dataPtr->posePlans.end(); ++plan)
+    {
+      if (!plan->second.names.empty() && plan->second.names[0] == _name)
+      {
+        this->dataPtr->posePlans.erase(plan);
+        break;
+      }
+    }
   }
 
   // Cleanup the publishLightPoses list.
@@ -3314,7 +4110,41 @@ void World::SetAtmosphereEnabled(const bool _enable)
 void World::_AddDirty(Entity *_entity)
 {
   GZ_ASSERT(_entity != nullptr, "_entity is nullptr");
-  this->dataPtr->dirtyPoses.push_back(_entity);
+
+  // During a parallel model update, buffer the entity in the current
+  // group. World::ModelUpdateTBB merges the buffers afterwards.
+  if (g_modelUpdateDirtyPoses)
+    g_modelUpdateDirtyPoses->push_back(_entity);
+  else
+    this->dataPtr->dirtyPoses.push_back(_entity);
+}
+
+/////////////////////////////////////////////////
+void World::SetParallelModelUpdate(const bool _enable)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+
+  if (_enable)
+  {
+    this->dataPtr->modelUpdateGroupsDirty = true;
+    this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
+  }
+  else
+  {
+    this->dataPtr->modelUpdateFunc = &World::ModelUpdateSingleLoop;
+  }
+}
+
+/////////////////////////////////////////////////
+bool World::ParallelModelUpdate() const
+{
+  return this->dataPtr->modelUpdateFunc == &World::ModelUpdateTBB;
+}
+
+/////////////////////////////////////////////////
+void World::_InvalidateModelUpdateGroups()
+{
+  this->dataPtr->modelUpdateGroupsDirty = true;
 }
 
 /////////////////////////////////////////////////
@@ -21,6 +21,7 @@
 #include <list>
 #include <set>
 #include <deque>
+#include <future>
 #include <string>
 #include <memory>
 
@@ -298,6 +299,25 @@ namespace gazebo
       /// \param _state The state to set the World to.
       public: void SetState(const WorldState &_state);
 
+      /// \brief Save the physics state of the world to a binary snapshot,
+      /// without going through SDF. The snapshot holds the engine state of
+      /// the links and joints, the state of the joint controllers, and the
+      /// seeds of the random number generators. The global random number
+      /// generator is reseeded from itself so that its sequence can be
+      /// replayed.
+      /// \param[out] _snapshot The snapshot. Its previous content is
+      /// replaced, its memory is reused.
+      /// \sa Snapshot
+      public: void SaveSnapshot(Snapshot &_snapshot);
+
+      /// \brief Restore a snapshot saved by SaveSnapshot. The world then
+      /// steps exactly as it did after the snapshot was saved. No entity
+      /// may have been added to or removed from the world since.
+      /// \param[in] _snapshot The snapshot.
+      /// \return False if the snapshot wasn't saved from this world, or if
+      /// its entities don't match the ones of the world.
+      public: bool RestoreSnapshot(const Snapshot &_snapshot);
+
       /// \brief Insert a model from an SDF file.
       /// Spawns a model into the world based on an SDF file.
       /// \param[in] _sdfFilename The name of the SDF file (including path).
@@ -332,6 +352,31 @@ namespace gazebo
       /// \param[in] _steps The number of steps the World should take.
       public: void Step(const unsigned int _steps);
 
+      /// \brief Step the world forward in time as fast as possible. The
+      /// world thread runs the steps back to back, without real time
+      /// throttling and whether or not the world is paused. Only one batch
+      /// runs at a time, and the world must be running.
+      /// \param[in] _steps The number of steps the World should take.
+      /// \param[in] _publishPeriod Publish the world statistics, the poses
+      /// and the contacts every _publishPeriod steps, and after the last
+      /// one. Contact filters are still delivered on every step.
+      /// \return A future that is ready once the steps are done. It's
+      /// invalid if another batch is running.
+      public: std::future<void> StepBatch(const unsigned int _steps,
+                  const unsigned int _publishPeriod = 1);
+
+      /// \brief Step the world forward in time as fast as possible, on the
+      /// calling thread. This is for worlds that are stepped by a thread
+      /// pool instead of running their own thread, see
+      /// physics::step_worlds. The world must have been initialized, and
+      /// must not be running.
+      /// \param[in] _steps The number of steps the World should take.
+      /// \param[in] _publishPeriod Publish the world statistics, the poses
+      /// and the contacts every _publishPeriod steps, and after the last
+      /// one.
+      public: void StepBlocking(const unsigned int _steps,
+                  const unsigned int _publishPeriod = 1);
+
       /// \brief Load a plugin
       /// \param[in] _filename The filename of the plugin.
       /// \param[in] _name A unique name for the plugin.
@@ -439,6 +484,32 @@ namespace gazebo
       /// \param[in] _entity Entity that has moved.
       public: void _AddDirty(Entity *_entity);
 
+      /// \brief Enable or disable parallel model updates.
+      /// When enabled, top level models are partitioned into independent
+      /// groups, and each group is updated by a task on the TBB scheduler.
+      /// Models connected by joints, or by static model attachments, are
+      /// always placed in the same group. Plugins that connect to model or
+      /// joint update events must be thread safe when this is enabled.
+      /// This can also be enabled using the
+      /// <ignition:parallel_model_update> world SDF element or the
+      /// gzserver --parallel_model_update flag.
+      /// \param[in] _enable True to update models in parallel.
+      /// \sa ParallelModelUpdate()
+      public: void SetParallelModelUpdate(const bool _enable);
+
+      /// \brief Get whether models are updated in parallel.
+      /// \return True if parallel model updates are enabled.
+      /// \sa SetParallelModelUpdate(const bool)
+      public: bool ParallelModelUpdate() const;
+
+      /// \internal
+      /// \brief Inform the World that the connectivity between models
+      /// has changed (a model was added or removed, a joint was attached or
+      /// detached, or a static model was attached or detached). This causes
+      /// the parallel model update groups to be recomputed.
+      /// If you are unsure whether you should use this function, do not.
+      public: void _InvalidateModelUpdateGroups();
+
       /// \brief Get whether sensors have been initialized.
       /// \return True if sensors have been initialized.
       public: bool SensorsInitialized() const;
@@ -521,6 +592,17 @@ namespace gazebo
       /// \brief Step the world once.
       private: void Step();
 
+      /// \brief Run the steps requested by StepBatch.
+      private: void RunBatch();
+
+      /// \brief Step the world back to back, without real time throttling.
+      /// The caller must hold the step mutex.
+      /// \param[in] _steps The number of steps to take.
+      /// \param[in] _publishPeriod Publish every _publishPeriod steps, and
+      /// after the last one.
+      private: void RunSteps(const unsigned int _steps,
+                   const unsigned int _publishPeriod);
+
       /// \brief Step the world once by reading from a log file.
       private: void LogStep();
 
@@ -567,9 +649,20 @@ namespace gazebo
       /// \brief TBB version of model updating.
       private: void ModelUpdateTBB();
 
+      /// \brief Partition the top level models into groups that can be
+      /// updated concurrently. Used by ModelUpdateTBB.
+      private: void BuildModelUpdateGroups();
+
       /// \brief Single loop version of model updating.
       private: void ModelUpdateSingleLoop();
 
+      /// \brief Signal an update event. When parallel model updates are
+      /// enabled, the callbacks connected with a model run concurrently,
+      /// after the other callbacks.
+      /// \param[in] _event Event to signal.
+      private: void SignalUpdateEvent(
+                   event::EventT<void (const common::UpdateInfo &)> &_event);
+
       /// \brief Helper function to load a plugin from SDF.
       /// \param[in] _sdf SDF plugin description.
       private: void LoadPlugin(sdf::ElementPtr _sdf);
@@ -623,6 +716,21 @@ namespace gazebo
       /// \brief Thread function for logging state data.
       private: void LogWorker();
 
+      /// \brief Add the current state to the log buffers, if it changed
+      /// and the log period elapsed. Called by the log worker, or after
+      /// every step by worlds stepped by a pool.
+      private: void LogState();
+
+      /// \brief Record the insertion of a top level entity, so the log
+      /// worker can add it to the next logged state.
+      /// \param[in] _name Name of the model or light.
+      private: void LogInsertion(const std::string &_name);
+
+      /// \brief Record the deletion of a top level entity, so the log
+      /// worker can add it to the next logged state.
+      /// \param[in] _name Name of the model or light.
+      private: void LogDeletion(const std::string &_name);
+
       /// \brief Register items in the introspection service.
       private: void RegisterIntrospectionItems();
 
@@ -690,6 +798,24 @@ namespace gazebo
       private: bool MaterialShininessService(
           const ignition::msgs::StringMsg &_request, msgs::Any &_response);
 
+      /// \brief Callback for "/<world_name>/snapshot/save" service. Saves a
+      /// snapshot of the world in memory.
+      /// \param[in] _request Name of the snapshot.
+      /// \param[out] _response True if the snapshot was saved.
+      /// \return True if the request was processed.
+      private: bool SaveSnapshotService(
+          const ignition::msgs::StringMsg &_request,
+          ignition::msgs::Boolean &_response);
+
+      /// \brief Callback for "/<world_name>/snapshot/restore" service.
+      /// Restores a snapshot saved by the save service.
+      /// \param[in] _request Name of the snapshot.
+      /// \param[out] _response True if the snapshot was restored.
+      /// \return True if the request was processed.
+      private: bool RestoreSnapshotService(
+          const ignition::msgs::StringMsg &_request,
+          ignition::msgs::Boolean &_response);
+
       /// \brief Helper function for getting shininess values by scoped
       /// visual name.
       /// \param[in] _scopedName Scoped visual name.
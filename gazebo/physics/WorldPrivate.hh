@@ -19,8 +19,10 @@
 
 #include <atomic>
 #include <deque>
+#include <future>
 #include <vector>
 #include <list>
+#include <map>
 #include <memory>
 #include <set>
 #include <sdf/sdf.hh>
@@ -40,12 +42,32 @@
 #include "gazebo/transport/TransportTypes.hh"
 
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/Snapshot.hh"
 #include "gazebo/physics/WorldState.hh"
 
 namespace gazebo
 {
   namespace physics
   {
+    /// \brief Entities whose poses are published for a model, flattened in
+    /// publication order: the model, its links, then its nested models the
+    /// same way.
+    class ModelPosePlan
+    {
+      /// \brief Model::StructureVersion when the plan was built.
+      public: unsigned int structureVersion = 0;
+
+      /// \brief The entities. They're owned by the model, which changes its
+      /// structure version before any of them goes away.
+      public: std::vector<Entity *> entities;
+
+      /// \brief Ids of the entities.
+      public: std::vector<uint32_t> ids;
+
+      /// \brief Scoped names of the entities.
+      public: std::vector<std::string> names;
+    };
+
     /// \brief Private data class for World.
     class WorldPrivate
     {
@@ -92,6 +114,25 @@ namespace gazebo
       /// \brief Number of steps in increment by.
       public: int stepInc;
 
+      /// \brief Notified when World::Step(steps) may be done.
+      public: std::condition_variable_any stepCondition;
+
+      /// \brief Number of steps requested by World::StepBatch, zero when
+      /// no batch is pending.
+      public: std::atomic<unsigned int> batchSteps{0};
+
+      /// \brief Publication period of the pending batch, in steps.
+      public: unsigned int batchPublishPeriod = 1;
+
+      /// \brief Fulfilled when the pending batch is done.
+      public: std::promise<void> batchPromise;
+
+      /// \brief Protects the batch request.
+      public: std::mutex batchMutex;
+
+      /// \brief False during batch steps that don't publish contacts.
+      public: bool publishStep = true;
+
       /// \brief All the event connections.
       public: event::Connection_V connections;
 
@@ -122,6 +163,19 @@ namespace gazebo
       /// \brief Publisher for local pose messages.
       public: transport::PublisherPtr poseLocalPub;
 
+      /// \brief Publisher for pose messages without names, for
+      /// subscribers that get the ids of the entities from the scene.
+      public: transport::PublisherPtr poseCompactPub;
+
+      /// \brief Pose message reused on every publication.
+      public: msgs::PosesStamped posesMsg;
+
+      /// \brief Pose message without names reused on every publication.
+      public: msgs::PosesStamped compactPosesMsg;
+
+      /// \brief Pose publication plans, by model id.
+      public: std::map<uint32_t, ModelPosePlan> posePlans;
+
       /// \brief Subscriber to world control messages.
       public: transport::SubscriberPtr controlSub;
 
@@ -158,6 +212,29 @@ namespace gazebo
       /// \brief Function pointer to the model update function.
       public: void (World::*modelUpdateFunc)();
 
+      /// \brief Groups of top level entities that are updated together by
+      /// ModelUpdateTBB. Entities in different groups do not share joints
+      /// or static attachments. Groups are ordered by the index of their
+      /// first member in the root element.
+      public: std::vector<Base_V> modelUpdateGroups;
+
+      /// \brief Dirty entities reported by each group during a parallel
+      /// model update. They are appended to dirtyPoses in group order once
+      /// all groups have completed, which keeps the order deterministic.
+      public: std::vector<std::vector<Entity *>> modelUpdateDirtyPoses;
+
+      /// \brief Dirty entities reported by each group of callbacks of an
+      /// update event dispatched concurrently. They are merged like
+      /// modelUpdateDirtyPoses.
+      public: std::vector<std::vector<Entity *>> eventDirtyPoses;
+
+      /// \brief True when modelUpdateGroups must be recomputed.
+      public: std::atomic_bool modelUpdateGroupsDirty{true};
+
+      /// \brief Number of root element children when modelUpdateGroups
+      /// was last computed.
+      public: unsigned int modelUpdateGroupsSize = 0;
+
       /// \brief Last time a world statistics message was sent.
       public: common::Time prevStatTime;
 
@@ -185,6 +262,15 @@ namespace gazebo
       /// \brief Used in World::Step and World::Fini
       public: std::mutex stepMutex;
 
+      /// \brief True while the world is stepped by a pool. The
+      /// introspection manager is then updated by step_worlds, once all
+      /// the worlds took their steps.
+      public: bool poolStep;
+
+      /// \brief True when World::Clear was called, the models of this
+      /// world are then removed at the end of the next step.
+      public: std::atomic<bool> clearModels;
+
       /// \brief Used by World classs in following calls:
       /// World::Step for then entire function
       /// World::StepWorld for changing World::stepInc,
@@ -265,8 +351,13 @@ namespace gazebo
       /// \brief Period over which messages should be processed.
       public: common::Time processMsgsPeriod;
 
-      /// \brief Alternating buffer of states.
-      public: std::deque<WorldState> states[2];
+      /// \brief Alternating buffer of states. The buffers are pools:
+      /// only the first stateCount entries are valid, and the others are
+      /// reused by the log worker.
+      public: std::vector<WorldState> states[2];
+
+      /// \brief Number of valid states in each buffer.
+      public: size_t stateCount[2] = {0, 0};
 
       /// \brief Keep track of current state buffer being updated
       public: int currentStateBuffer;
@@ -274,9 +365,28 @@ namespace gazebo
       /// \brief Buffer of prev states
       public: WorldState prevStates[2];
 
-      /// \brief Previous unfiltered state. Used for determining insertions
-      /// and deletions
-      public: WorldState prevUnfilteredState;
+      /// \brief Names of the entities inserted since the log worker last
+      /// ran.
+      public: std::vector<std::string> logInsertions;
+
+      /// \brief Names of the entities deleted since the log worker last
+      /// ran.
+      public: std::vector<std::string> logDeletions;
+
+      /// \brief Mutex to protect logInsertions and logDeletions.
+      public: std::mutex logEntityMutex;
+
+      /// \brief Names of the entities inserted since the last logged
+      /// state, swapped with logInsertions so both keep their capacity.
+      public: std::vector<std::string> logStateInsertedNames;
+
+      /// \brief Descriptions of the entities inserted since the last logged
+      /// state.
+      public: std::vector<std::string> logStateInsertions;
+
+      /// \brief Names of the entities deleted since the last logged state,
+      /// swapped with logDeletions so both keep their capacity.
+      public: std::vector<std::string> logStateDeletions;
 
       /// \brief Int used to toggle between prevStates
       public: int stateToggle;
@@ -383,6 +493,12 @@ namespace gazebo
       /// \brief Node for ignition transport communication.
       public: ignition::transport::Node ignNode;
 
+      /// \brief Snapshots saved by the snapshot services, by name.
+      public: std::map<std::string, Snapshot> snapshots;
+
+      /// \brief Protects snapshots.
+      public: std::mutex snapshotsMutex;
+
       /// \brief Wait until no sensors use the current step any more
       public: std::function<void(double, double)> waitForSensors;
 
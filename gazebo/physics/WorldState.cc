@@ -17,7 +17,7 @@
 /* Desc: A world state
  * Author: Nate Koenig
  */
-#include <boost/algorithm/string.hpp>
+#include <memory>
 
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
@@ -25,19 +25,15 @@
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/Light.hh"
 #include "gazebo/physics/WorldState.hh"
+#include "gazebo/util/LogRecordFilter.hh"
 
 using namespace gazebo;
 using namespace physics;
 
-// TODO added here for ABI compatibility
-// move to class when merging forward
-static std::string worldStateFilter;
-
 /////////////////////////////////////////////////
 WorldState::WorldState()
   : State()
 {
-  worldStateFilter = "";
 }
 
 /////////////////////////////////////////////////
@@ -83,12 +79,24 @@ WorldState::~WorldState()
 void WorldState::LoadWithFilter(const WorldPtr _world,
                                 const std::string &_filter)
 {
-  worldStateFilter = _filter;
-  this->Load(_world);
+  // Only parse the filter again when it changes.
+  thread_local std::unique_ptr<util::LogRecordFilter> filter;
+  if (!filter || filter->Filter() != _filter)
+    filter.reset(new util::LogRecordFilter(_filter));
+
+  this->Load(_world, *filter);
 }
 
 /////////////////////////////////////////////////
 void WorldState::Load(const WorldPtr _world)
+{
+  static const util::LogRecordFilter matchAll;
+  this->Load(_world, matchAll);
+}
+
+/////////////////////////////////////////////////
+void WorldState::Load(const WorldPtr _world,
+                      const util::LogRecordFilter &_filter)
 {
   this->world = _world;
   this->name = _world->Name();
@@ -99,62 +107,60 @@ void WorldState::Load(const WorldPtr _world)
   this->insertions.clear();
   this->deletions.clear();
 
-  std::string filter = worldStateFilter;
-  std::list<std::string> mainParts, parts;
-  boost::split(mainParts, filter, boost::is_any_of("/"));
-
-  // Create the model filter
-  if (!mainParts.empty())
+  // Add a state for all the models that match the filter. Existing states
+  // are updated in place, and the models are visited by index to avoid
+  // copying the model list.
+  const unsigned int modelCount = _world->ModelCount();
+  size_t count = 0;
+  for (unsigned int i = 0; i < modelCount; ++i)
   {
-    boost::split(parts, mainParts.front(), boost::is_any_of("."));
-    if (parts.empty() && !mainParts.front().empty())
-      parts.push_back(mainParts.front());
-  }
-  std::list<std::string>::iterator partIter = parts.begin();
-
-  // Add a state for all the models that match the filter
-  Model_V models = _world->Models();
-  for (Model_V::const_iterator iter = models.begin();
-       iter != models.end(); ++iter)
-  {
-    bool add = true;
-
-    // The first element in the filter must be a model name or a star.
-    if (partIter != parts.end() && !parts.empty() &&
-        !(*partIter).empty() && (*partIter) != "*")
+    ModelPtr model = _world->ModelByIndex(i);
+    if (model && _filter.MatchModel(model->GetName()))
     {
-      std::string regexStr = *partIter;
-      boost::replace_all(regexStr, "*", ".*");
-      boost::regex regex(regexStr);
-      add = boost::regex_match((*iter)->GetName(), regex);
-    }
-
-    if (add)
-    {
-      this->modelStates[(*iter)->GetName()].Load(*iter, this->realTime,
-          this->simTime, this->iterations);
+      this->modelStates[model->GetName()].Load(model, this->realTime,
+          this->simTime, this->iterations, _filter);
+      ++count;
     }
   }
 
-  // Remove models that no longer exist. We determine this by check the time
-  // stamp on each model.
-  for (ModelState_M::iterator iter = this->modelStates.begin();
-       iter != this->modelStates.end();)
+  // Remove models that no longer exist or no longer match the filter. The
+  // time stamps can't be used for this, real time doesn't change while
+  // paused.
+  if (this->modelStates.size() != count)
   {
-    if (iter->second.GetRealTime() != this->realTime)
-      this->modelStates.erase(iter++);
-    else
-      ++iter;
+    for (auto iter = this->modelStates.begin();
+         iter != this->modelStates.end();)
+    {
+      if (!_filter.MatchModel(iter->first) ||
+          !_world->ModelByName(iter->first))
+      {
+        iter = this->modelStates.erase(iter);
+      }
+      else
+        ++iter;
+    }
   }
 
   // Add states for all the lights
-  this->lightStates.clear();
-  Light_V lights = _world->Lights();
+  const Light_V &lights = _world->Lights();
   for (const auto &light : lights)
   {
     this->lightStates[light->GetName()].Load(light, this->realTime,
         this->simTime, this->iterations);
   }
+
+  // Remove lights that no longer exist.
+  if (this->lightStates.size() != lights.size())
+  {
+    for (auto iter = this->lightStates.begin();
+         iter != this->lightStates.end();)
+    {
+      if (!_world->LightByName(iter->first))
+        iter = this->lightStates.erase(iter);
+      else
+        ++iter;
+    }
+  }
 }
 
 /////////////////////////////////////////////////
@@ -434,39 +440,48 @@ bool WorldState::IsZero() const
 }
 
 /////////////////////////////////////////////////
-WorldState &WorldState::operator=(const WorldState &_state)
+bool WorldState::DiffIsZero(const WorldState &_state) const
 {
-  State::operator=(_state);
-
-  // Clear the states
-  this->modelStates.clear();
-  this->lightStates.clear();
-
-  this->insertions.clear();
-  this->deletions.clear();
+  // Models and lights that only exist in one of the states are insertions
+  // or deletions.
+  if (this->modelStates.size() != _state.modelStates.size() ||
+      this->lightStates.size() != _state.lightStates.size())
+  {
+    return false;
+  }
 
-  // Copy the model states.
-  for (ModelState_M::const_iterator iter =
-       _state.modelStates.begin(); iter != _state.modelStates.end(); ++iter)
+  for (auto const &ms : _state.modelStates)
   {
-    this->modelStates.insert(std::make_pair(iter->first,
-          ModelState(iter->second)));
+    auto iter = this->modelStates.find(ms.first);
+    if (iter == this->modelStates.end() || !iter->second.DiffIsZero(ms.second))
+      return false;
   }
 
-  // Copy the light states.
-  for (const auto &light : _state.lightStates)
+  for (auto const &light : _state.lightStates)
   {
-    this->lightStates.insert(std::make_pair(light.first,
-          LightState(light.second)));
+    auto iter = this->lightStates.find(light.first);
+    if (iter == this->lightStates.end() ||
+        !PoseDiffIsZero(iter->second.Pose(), light.second.Pose()))
+    {
+      return false;
+    }
   }
 
-  // Copy the insertions
-  std::copy(_state.insertions.begin(),
-            _state.insertions.end(), this->insertions.begin());
+  return true;
+}
+
+/////////////////////////////////////////////////
+WorldState &WorldState::operator=(const WorldState &_state)
+{
+  State::operator=(_state);
+
+  // Copy the model and light states, reusing the existing entries.
+  AssignStates(this->modelStates, _state.modelStates);
+  AssignStates(this->lightStates, _state.lightStates);
 
-  // Copy the deletions
-  std::copy(_state.deletions.begin(),
-            _state.deletions.end(), this->deletions.begin());
+  // Copy the insertions and deletions
+  this->insertions = _state.insertions;
+  this->deletions = _state.deletions;
 
   return *this;
 }
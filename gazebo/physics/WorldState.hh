@@ -29,6 +29,7 @@
 #include "gazebo/physics/State.hh"
 #include "gazebo/physics/ModelState.hh"
 #include "gazebo/physics/LightState.hh"
+#include "gazebo/util/UtilTypes.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -78,6 +79,16 @@ namespace gazebo
       public: void LoadWithFilter(const WorldPtr _world,
           const std::string &_filter);
 
+      /// \brief Load from a World pointer, keeping only the models and
+      /// links accepted by a filter.
+      ///
+      /// Generate a WorldState from an instance of a World.
+      /// \param[in] _world Pointer to a world
+      /// \param[in] _filter Compiled filter for model and link states
+      /// \sa util::LogRecord::CompiledFilter
+      public: void Load(const WorldPtr _world,
+          const util::LogRecordFilter &_filter);
+
       /// \brief Load state from SDF element.
       ///
       /// Set a WorldState from an SDF element containing WorldState info.
@@ -167,6 +178,14 @@ namespace gazebo
       /// \return True if the values in the state are zero.
       public: bool IsZero() const;
 
+      /// \brief Check whether the difference to another state is zero.
+      ///
+      /// This is equivalent to (*this - _state).IsZero(), without building
+      /// the difference, which makes it cheap to call on every logged step.
+      /// \param[in] _state State to compare with.
+      /// \return True if the difference is zero.
+      public: bool DiffIsZero(const WorldState &_state) const;
+
       /// \brief Populate a state SDF element with data from the object.
       /// \param[out] _sdf SDF element to populate.
       public: void FillSDF(sdf::ElementPtr _sdf);
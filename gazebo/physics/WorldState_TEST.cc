@@ -253,12 +253,57 @@ TEST_F(WorldStateTest, OperatorsNoInsertionsDeletions)
   EXPECT_EQ(lightStates["sun"].Pose(),
       ignition::math::Pose3d(10, 20, 40, 0, 0, 0));
 
+  // Difference checks without building the difference
+  EXPECT_FALSE(worldState1.DiffIsZero(worldState0));
+  EXPECT_TRUE(worldState0.DiffIsZero(worldState0));
+
   // Copy by assignment
   worldState1 = worldState0;
 
   // Check states are equal
   EXPECT_EQ(worldState0.GetName(), worldState1.GetName());
   EXPECT_TRUE((worldState0 - worldState1).IsZero());
+  EXPECT_TRUE(worldState1.DiffIsZero(worldState0));
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldStateTest, LoadInPlace)
+{
+  // Load a world
+  this->Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::WorldState worldState0(world);
+  physics::WorldState worldState1;
+  worldState1.Load(world);
+  EXPECT_EQ(worldState1.GetModelStateCount(), 4u);
+  EXPECT_TRUE(worldState1.DiffIsZero(worldState0));
+
+  // Move a model, the difference is no longer zero
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  box->SetWorldPose(ignition::math::Pose3d(1, 2, 3, 0, 0, 0));
+  worldState1.Load(world);
+  EXPECT_FALSE(worldState1.DiffIsZero(worldState0));
+  EXPECT_FALSE((worldState1 - worldState0).IsZero());
+  EXPECT_EQ(worldState1.GetModelState("box").Pose(),
+      ignition::math::Pose3d(1, 2, 3, 0, 0, 0));
+
+  // Assignment keeps insertions and deletions
+  std::vector<std::string> deletions = {"sphere"};
+  worldState1.SetDeletions(deletions);
+  worldState0 = worldState1;
+  EXPECT_TRUE(worldState0.DiffIsZero(worldState1));
+  ASSERT_EQ(worldState0.Deletions().size(), 1u);
+  EXPECT_EQ(worldState0.Deletions()[0], "sphere");
+
+  // Removed models are removed from the state
+  world->RemoveModel("sphere");
+  worldState1.Load(world);
+  EXPECT_EQ(worldState1.GetModelStateCount(), 3u);
+  EXPECT_FALSE(worldState1.HasModelState("sphere"));
+  EXPECT_FALSE(worldState1.DiffIsZero(worldState0));
 }
 
 //////////////////////////////////////////////////
@@ -15,7 +15,16 @@
  *
 */
 
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <vector>
+
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/Snapshot.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/test/ServerFixture.hh"
 #include "test/util.hh"
@@ -216,6 +225,330 @@ TEST_F(WorldTest, Stop)
   EXPECT_TRUE(world->Running());
 }
 
+//////////////////////////////////////////////////
+/// \brief Poses received on ~/pose/info.
+msgs::PosesStamped g_posesMsg;
+
+/// \brief Poses received on ~/pose/compact/info.
+msgs::PosesStamped g_compactPosesMsg;
+
+/// \brief Protects the received poses.
+std::mutex g_posesMutex;
+
+//////////////////////////////////////////////////
+void OnPoses(ConstPosesStampedPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_posesMutex);
+  g_posesMsg.CopyFrom(*_msg);
+}
+
+//////////////////////////////////////////////////
+void OnCompactPoses(ConstPosesStampedPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_posesMutex);
+  g_compactPosesMsg.CopyFrom(*_msg);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the compact poses have the ids of the named poses.
+TEST_F(WorldTest, CompactPoses)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  auto model = world->ModelByName("box");
+  ASSERT_NE(nullptr, model);
+  auto link = model->GetLinks()[0];
+
+  transport::SubscriberPtr poseSub =
+      this->node->Subscribe("~/pose/info", &OnPoses);
+  transport::SubscriberPtr compactSub =
+      this->node->Subscribe("~/pose/compact/info", &OnCompactPoses);
+
+  // Move the model until both messages have its pose
+  auto hasPose = [](const msgs::PosesStamped &_msg, const uint32_t _id)
+  {
+    for (auto const &pose : _msg.pose())
+    {
+      if (pose.id() == _id)
+        return true;
+    }
+    return false;
+  };
+
+  bool received = false;
+  for (int i = 0; i < 50 && !received; ++i)
+  {
+    model->SetWorldPose(ignition::math::Pose3d(0, 0, 1 + i * 0.01, 0, 0, 0));
+    world->Step(1);
+    common::Time::MSleep(100);
+
+    std::lock_guard<std::mutex> lock(g_posesMutex);
+    received = hasPose(g_posesMsg, model->GetId()) &&
+        hasPose(g_compactPosesMsg, model->GetId());
+  }
+  ASSERT_TRUE(received);
+
+  std::lock_guard<std::mutex> lock(g_posesMutex);
+
+  // The named poses include the model and its link
+  bool linkPose = false;
+  for (auto const &pose : g_posesMsg.pose())
+  {
+    if (pose.id() == model->GetId())
+      EXPECT_EQ(pose.name(), model->GetScopedName());
+    if (pose.id() == link->GetId())
+    {
+      EXPECT_EQ(pose.name(), link->GetScopedName());
+      linkPose = true;
+    }
+  }
+  EXPECT_TRUE(linkPose);
+
+  // The compact poses have no names
+  EXPECT_TRUE(hasPose(g_compactPosesMsg, link->GetId()));
+  for (auto const &pose : g_compactPosesMsg.pose())
+    EXPECT_FALSE(pose.has_name());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that a link created at runtime is published on
+/// ~/pose/info.
+TEST_F(WorldTest, CreateLinkPoses)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  auto model = world->ModelByName("box");
+  ASSERT_NE(nullptr, model);
+
+  transport::SubscriberPtr poseSub =
+      this->node->Subscribe("~/pose/info", &OnPoses);
+
+  auto hasPose = [](const uint32_t _id)
+  {
+    std::lock_guard<std::mutex> lock(g_posesMutex);
+    for (auto const &pose : g_posesMsg.pose())
+    {
+      if (pose.id() == _id)
+        return true;
+    }
+    return false;
+  };
+
+  // Publish the model once, so that its pose plan is cached
+  bool received = false;
+  for (int i = 0; i < 50 && !received; ++i)
+  {
+    model->SetWorldPose(ignition::math::Pose3d(0, 0, 1 + i * 0.01, 0, 0, 0));
+    world->Step(1);
+    common::Time::MSleep(100);
+    received = hasPose(model->GetId());
+  }
+  ASSERT_TRUE(received);
+
+  physics::LinkPtr link = model->CreateLink("runtime_link");
+  ASSERT_NE(nullptr, link);
+
+  {
+    std::lock_guard<std::mutex> lock(g_posesMutex);
+    g_posesMsg.Clear();
+  }
+
+  received = false;
+  for (int i = 0; i < 50 && !received; ++i)
+  {
+    model->SetWorldPose(ignition::math::Pose3d(0, 0, 2 + i * 0.01, 0, 0, 0));
+    world->Step(1);
+    common::Time::MSleep(100);
+    received = hasPose(link->GetId());
+  }
+  EXPECT_TRUE(received);
+
+  std::lock_guard<std::mutex> lock(g_posesMutex);
+  for (auto const &pose : g_posesMsg.pose())
+  {
+    if (pose.id() == link->GetId())
+      EXPECT_EQ(pose.name(), link->GetScopedName());
+  }
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, StepBatch)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  const uint64_t iterations = world->Iterations();
+  const common::Time simTime = world->SimTime();
+
+  // Run a batch and wait for it
+  std::future<void> done = world->StepBatch(500, 100);
+  ASSERT_TRUE(done.valid());
+  EXPECT_EQ(done.wait_for(std::chrono::seconds(30)),
+      std::future_status::ready);
+  EXPECT_EQ(world->Iterations(), iterations + 500);
+  EXPECT_TRUE(world->IsPaused());
+
+  EXPECT_NEAR((world->SimTime() - simTime).Double(),
+      500 * world->Physics()->GetMaxStepSize(), 1e-6);
+
+  // Only one batch at a time
+  done = world->StepBatch(100000);
+  ASSERT_TRUE(done.valid());
+  EXPECT_FALSE(world->StepBatch(1).valid());
+  done.wait();
+
+  // An empty batch is done right away
+  done = world->StepBatch(0);
+  ASSERT_TRUE(done.valid());
+  EXPECT_EQ(done.wait_for(std::chrono::seconds(0)),
+      std::future_status::ready);
+
+  // Stepping a paused world still works
+  world->Step(10);
+  EXPECT_EQ(world->Iterations(), iterations + 100510);
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the poses and velocities of all the links of a world.
+/// \param[in] _world The world.
+/// \return The values, to be compared exactly.
+static std::vector<double> LinkStates(physics::WorldPtr _world)
+{
+  std::vector<double> result;
+  for (auto const &model : _world->Models())
+  {
+    for (auto const &link : model->GetLinks())
+    {
+      const ignition::math::Pose3d pose = link->WorldPose();
+      const ignition::math::Vector3d vel = link->WorldLinearVel();
+      const ignition::math::Vector3d angVel = link->WorldAngularVel();
+      result.insert(result.end(), {pose.Pos().X(), pose.Pos().Y(),
+          pose.Pos().Z(), pose.Rot().W(), pose.Rot().X(), pose.Rot().Y(),
+          pose.Rot().Z(), vel.X(), vel.Y(), vel.Z(),
+          angVel.X(), angVel.Y(), angVel.Z()});
+    }
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, Snapshot)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // Throw the shapes so that they slide and roll on the ground
+  for (auto const &name : {"box", "sphere", "cylinder"})
+  {
+    auto model = world->ModelByName(name);
+    ASSERT_NE(nullptr, model);
+    model->SetLinearVel(ignition::math::Vector3d(1.5, 0.5, 2.0));
+    model->SetAngularVel(ignition::math::Vector3d(0.0, 3.0, 1.0));
+  }
+  world->Step(100);
+
+  physics::Snapshot snapshot;
+  EXPECT_TRUE(snapshot.Empty());
+  world->SaveSnapshot(snapshot);
+  EXPECT_FALSE(snapshot.Empty());
+  EXPECT_EQ(snapshot.WorldName(), "default");
+  EXPECT_EQ(snapshot.SimTime(), world->SimTime());
+  EXPECT_EQ(snapshot.Iterations(), world->Iterations());
+
+  world->Step(300);
+  const std::vector<double> expected = LinkStates(world);
+  const common::Time simTime = world->SimTime();
+
+  // Replaying from the snapshot gives the same values, bit for bit
+  for (int i = 0; i < 2; ++i)
+  {
+    EXPECT_TRUE(world->RestoreSnapshot(snapshot));
+    EXPECT_EQ(world->SimTime(), snapshot.SimTime());
+    EXPECT_EQ(world->Iterations(), snapshot.Iterations());
+
+    world->Step(300);
+    EXPECT_EQ(world->SimTime(), simTime);
+    EXPECT_EQ(LinkStates(world), expected);
+  }
+
+  // A copy restores the same state
+  physics::Snapshot copy(snapshot);
+  EXPECT_EQ(copy.Size(), snapshot.Size());
+  EXPECT_TRUE(world->RestoreSnapshot(copy));
+  world->Step(300);
+  EXPECT_EQ(LinkStates(world), expected);
+
+  // A truncated snapshot is rejected before anything is restored
+  physics::Snapshot truncated;
+  truncated.SetWorldName(snapshot.WorldName());
+  truncated.SetSimTime(snapshot.SimTime());
+  truncated.SetIterations(snapshot.Iterations());
+  size_t offset = 0;
+  const size_t truncatedSize = snapshot.Size() - sizeof(uint32_t);
+  truncated.Write(snapshot.Data(offset, truncatedSize), truncatedSize);
+  EXPECT_FALSE(world->RestoreSnapshot(truncated));
+  EXPECT_EQ(world->SimTime(), simTime);
+  EXPECT_EQ(LinkStates(world), expected);
+
+  // A snapshot can't be restored once the entities changed
+  world->RemoveModel("cylinder");
+  int sleep = 0;
+  while (world->ModelByName("cylinder") && sleep++ < 100)
+    common::Time::MSleep(10);
+  ASSERT_EQ(nullptr, world->ModelByName("cylinder"));
+  EXPECT_FALSE(world->RestoreSnapshot(snapshot));
+
+  // Nor an empty one
+  EXPECT_FALSE(world->RestoreSnapshot(physics::Snapshot()));
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, SnapshotContactWarmStart)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // The contacts are warm started from the impulses of the previous step
+  ASSERT_TRUE(world->Physics()->SetParam("contact_warm_start_distance",
+        0.01));
+
+  for (auto const &name : {"box", "sphere", "cylinder"})
+  {
+    auto model = world->ModelByName(name);
+    ASSERT_NE(nullptr, model);
+    model->SetLinearVel(ignition::math::Vector3d(1.5, 0.5, 0.0));
+  }
+  world->Step(200);
+
+  physics::Snapshot snapshot;
+  world->SaveSnapshot(snapshot);
+
+  world->Step(100);
+  const std::vector<double> expected = LinkStates(world);
+
+  // The kept impulses are restored too, so the replay is exact
+  EXPECT_TRUE(world->RestoreSnapshot(snapshot));
+  world->Step(100);
+  EXPECT_EQ(LinkStates(world), expected);
+
+  // The impulses of a removed model are dropped with its geoms, and
+  // stepping on doesn't reach them
+  world->RemoveModel("box");
+  int sleep = 0;
+  while (world->ModelByName("box") && sleep++ < 100)
+    common::Time::MSleep(10);
+  ASSERT_EQ(nullptr, world->ModelByName("box"));
+  EXPECT_FALSE(world->RestoreSnapshot(snapshot));
+  world->Step(10);
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
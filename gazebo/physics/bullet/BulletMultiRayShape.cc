@@ -45,11 +45,10 @@ BulletMultiRayShape::~BulletMultiRayShape()
 //////////////////////////////////////////////////
 void BulletMultiRayShape::UpdateRays()
 {
-  std::vector<RayShapePtr>::iterator iter;
-  for (iter = this->rays.begin(); iter != this->rays.end(); ++iter)
-  {
-    (*iter)->Update();
-  }
+  // Intersect all the rays at once, instead of one rayTest per ray
+  boost::recursive_mutex::scoped_lock lock(
+      *this->physicsEngine->GetPhysicsUpdateMutex());
+  this->UpdateBatch();
 }
 
 //////////////////////////////////////////////////
@@ -48,11 +48,11 @@ DARTMultiRayShape::~DARTMultiRayShape()
 //////////////////////////////////////////////////
 void DARTMultiRayShape::UpdateRays()
 {
-  std::vector<RayShapePtr>::iterator iter;
-  for (iter = this->rays.begin(); iter != this->rays.end(); ++iter)
-  {
-    (*iter)->Update();
-  }
+  // DARTRayShape::Update does not intersect anything, the batch provides
+  // the intersections with the primitive shapes
+  boost::recursive_mutex::scoped_lock lock(
+      *this->GetWorld()->Physics()->GetPhysicsUpdateMutex());
+  this->UpdateBatch();
 }
 
 //////////////////////////////////////////////////
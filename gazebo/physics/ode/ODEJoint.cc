@@ -22,6 +22,7 @@
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/Snapshot.hh"
 #include "gazebo/physics/ode/ODELink.hh"
 #include "gazebo/physics/ode/ODEJoint.hh"
 #include "gazebo/physics/GearboxJoint.hh"
@@ -1229,3 +1230,75 @@ bool ODEJoint::SetPosition(const unsigned int _index, const double _position,
 
   return result;
 }
+
+//////////////////////////////////////////////////
+void ODEJoint::SaveSnapshot(Snapshot &_snapshot) const
+{
+  if (!this->jointId)
+    return;
+
+  // Constraint forces of the last step, the solver starts from them
+  dReal lambda[6];
+  dReal lambdaErp[6];
+  dJointGetWarmStart(this->jointId, lambda, lambdaErp);
+  _snapshot.Write(lambda);
+  _snapshot.Write(lambdaErp);
+
+  _snapshot.Write(this->forceApplied);
+  _snapshot.Write(this->forceAppliedTime.sec);
+  _snapshot.Write(this->forceAppliedTime.nsec);
+
+  _snapshot.Write(this->implicitDampingState);
+  _snapshot.Write(this->currentKd);
+  _snapshot.Write(this->currentKp);
+  _snapshot.Write(this->stiffnessDampingInitialized);
+
+  if (this->feedback)
+    _snapshot.Write(*this->feedback);
+}
+
+//////////////////////////////////////////////////
+bool ODEJoint::CheckSnapshot(const Snapshot &_snapshot, size_t &_offset) const
+{
+  if (!this->jointId)
+    return true;
+
+  // Same layout as SaveSnapshot
+  size_t size = 12 * sizeof(dReal) + sizeof(this->forceApplied) +
+    sizeof(this->forceAppliedTime.sec) + sizeof(this->forceAppliedTime.nsec) +
+    sizeof(this->implicitDampingState) + sizeof(this->currentKd) +
+    sizeof(this->currentKp) + sizeof(this->stiffnessDampingInitialized);
+  if (this->feedback)
+    size += sizeof(*this->feedback);
+
+  return _snapshot.Data(_offset, size) != nullptr;
+}
+
+//////////////////////////////////////////////////
+bool ODEJoint::RestoreSnapshot(const Snapshot &_snapshot, size_t &_offset)
+{
+  if (!this->jointId)
+    return true;
+
+  dReal lambda[6];
+  dReal lambdaErp[6];
+  if (!_snapshot.Read(_offset, lambda) || !_snapshot.Read(_offset, lambdaErp))
+    return false;
+  dJointSetWarmStart(this->jointId, lambda, lambdaErp);
+
+  if (!_snapshot.Read(_offset, this->forceApplied) ||
+      !_snapshot.Read(_offset, this->forceAppliedTime.sec) ||
+      !_snapshot.Read(_offset, this->forceAppliedTime.nsec) ||
+      !_snapshot.Read(_offset, this->implicitDampingState) ||
+      !_snapshot.Read(_offset, this->currentKd) ||
+      !_snapshot.Read(_offset, this->currentKp) ||
+      !_snapshot.Read(_offset, this->stiffnessDampingInitialized))
+  {
+    return false;
+  }
+
+  if (this->feedback && !_snapshot.Read(_offset, *this->feedback))
+    return false;
+
+  return true;
+}
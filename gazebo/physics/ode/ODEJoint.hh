@@ -254,6 +254,29 @@ namespace gazebo
       // Documentation inherited.
       public: virtual void ApplyStiffnessDamping() override;
 
+      /// \brief Append the solver warm start data, the applied forces and
+      /// the implicit damping state of the joint to a snapshot. The joint
+      /// positions follow from the state of the links.
+      /// \param[in,out] _snapshot Snapshot being saved.
+      /// \sa World::SaveSnapshot
+      public: void SaveSnapshot(Snapshot &_snapshot) const;
+
+      /// \brief Check the state saved by SaveSnapshot without restoring it.
+      /// \param[in] _snapshot Snapshot being restored.
+      /// \param[in,out] _offset Position of the state of the joint in the
+      /// snapshot, moved past it.
+      /// \return False if RestoreSnapshot would fail.
+      public: bool CheckSnapshot(const Snapshot &_snapshot,
+                  size_t &_offset) const;
+
+      /// \brief Restore the state saved by SaveSnapshot.
+      /// \param[in] _snapshot Snapshot being restored.
+      /// \param[in,out] _offset Position of the state of the joint in the
+      /// snapshot, moved past it.
+      /// \return False if the snapshot is too short.
+      public: bool RestoreSnapshot(const Snapshot &_snapshot,
+                  size_t &_offset);
+
       // Documentation inherited.
       /// \brief Set the force applied to this physics::Joint.
       /// Note that the unit of force should be consistent with the rest
@@ -15,6 +15,7 @@
  *
 */
 #include <math.h>
+#include <functional>
 #include <sstream>
 
 #include "gazebo/common/Assert.hh"
@@ -25,6 +26,7 @@
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/WorldPrivate.hh"
 #include "gazebo/physics/Model.hh"
+#include "gazebo/physics/Snapshot.hh"
 #include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODESurfaceParams.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
@@ -38,6 +40,8 @@ ODELink::ODELink(EntityPtr _parent)
     : Link(_parent)
 {
   this->linkId = nullptr;
+  this->SetStaticCallback(
+      std::bind(&ODELink::OnStatic, this, std::placeholders::_1));
 }
 
 //////////////////////////////////////////////////
@@ -174,6 +178,52 @@ void ODELink::MoveCallback(dBodyID _id)
   }
 }
 
+//////////////////////////////////////////////////
+void ODELink::SaveSnapshot(Snapshot &_snapshot) const
+{
+  // Static links have no body
+  if (!this->linkId)
+    return;
+
+  const uint32_t size = dBodyGetStateSize(this->linkId);
+  _snapshot.Write(size);
+  dBodySaveState(this->linkId, _snapshot.Allocate(size));
+}
+
+//////////////////////////////////////////////////
+bool ODELink::CheckSnapshot(const Snapshot &_snapshot, size_t &_offset) const
+{
+  if (!this->linkId)
+    return true;
+
+  uint32_t size;
+  return _snapshot.Read(_offset, size) &&
+    size == dBodyGetStateSize(this->linkId) &&
+    _snapshot.Data(_offset, size) != nullptr;
+}
+
+//////////////////////////////////////////////////
+bool ODELink::RestoreSnapshot(const Snapshot &_snapshot, size_t &_offset)
+{
+  if (!this->linkId)
+    return true;
+
+  uint32_t size;
+  if (!_snapshot.Read(_offset, size) || size != dBodyGetStateSize(this->linkId))
+    return false;
+
+  const void *state = _snapshot.Data(_offset, size);
+  if (!state)
+    return false;
+
+  dBodyRestoreState(this->linkId, state);
+
+  // Same as after a step, the world applies the dirty pose
+  MoveCallback(this->linkId);
+
+  return true;
+}
+
 //////////////////////////////////////////////////
 void ODELink::Fini()
 {
@@ -782,3 +832,41 @@ void ODELink::SetLinkStatic(bool /*_static*/)
 {
   gzlog << "To be implemented\n";
 }
+
+//////////////////////////////////////////////////
+void ODELink::OnStatic(const bool _static)
+{
+  // Links with their own space for self collisions keep it
+  if (!this->odePhysics || !this->spaceId || this->GetSelfCollide())
+    return;
+
+  // Static links share one space, in which collisions aren't tested
+  // against each other. Move the collisions of a link whose model is made
+  // dynamic to the space of its model, and back.
+  boost::recursive_mutex::scoped_lock lock(
+      *this->odePhysics->GetPhysicsUpdateMutex());
+
+  dSpaceID space = this->odePhysics->LinkSpaceId(this->GetModel(), _static);
+  if (space == this->spaceId)
+    return;
+
+  for (auto const &child : this->children)
+  {
+    if (!child->HasType(Base::COLLISION))
+      continue;
+
+    ODECollisionPtr collision =
+        boost::static_pointer_cast<ODECollision>(child);
+    dGeomID geom = collision->GetCollisionId();
+    if (!geom)
+      continue;
+
+    if (dGeomGetSpace(geom))
+      dSpaceRemove(dGeomGetSpace(geom), geom);
+    collision->SetSpaceId(space);
+
+    // Adds the geom to the space and updates its collide bits
+    collision->SetCollision(geom, collision->IsPlaceable());
+  }
+  this->spaceId = space;
+}
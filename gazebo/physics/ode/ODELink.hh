@@ -65,6 +65,29 @@ namespace gazebo
       /// center of mass.
       public: void UpdateCollisionOffsets();
 
+      /// \brief Append the raw ODE state of the body, including its
+      /// accumulators and auto-disable counters, to a snapshot. Static
+      /// links have no body and save nothing.
+      /// \param[in,out] _snapshot Snapshot being saved.
+      /// \sa World::SaveSnapshot
+      public: void SaveSnapshot(Snapshot &_snapshot) const;
+
+      /// \brief Check the state saved by SaveSnapshot without restoring it.
+      /// \param[in] _snapshot Snapshot being restored.
+      /// \param[in,out] _offset Position of the state of the link in the
+      /// snapshot, moved past it.
+      /// \return False if RestoreSnapshot would fail.
+      public: bool CheckSnapshot(const Snapshot &_snapshot,
+                  size_t &_offset) const;
+
+      /// \brief Restore the state saved by SaveSnapshot.
+      /// \param[in] _snapshot Snapshot being restored.
+      /// \param[in,out] _offset Position of the state of the link in the
+      /// snapshot, moved past it.
+      /// \return False if the snapshot is too short.
+      public: bool RestoreSnapshot(const Snapshot &_snapshot,
+                  size_t &_offset);
+
       // Documentation inherited
       public: virtual void UpdateMass();
 
@@ -182,6 +205,11 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetLinkStatic(bool _static);
 
+      /// \brief Move the collisions of the link between the shared static
+      /// space and the space of its model. Called by Link::SetStatic.
+      /// \param[in] _static True if the link was made static.
+      private: void OnStatic(const bool _static);
+
       /// \brief ODE link handle
       private: dBodyID linkId;
 
@@ -14,6 +14,12 @@
  * limitations under the License.
  *
 */
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
@@ -22,13 +28,156 @@
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODEMesh.hh"
 
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Scaled vertices, indices and collision tree of a mesh. They
+    /// are immutable once built, so that shapes can share them.
+    class ODETriMeshData
+    {
+      /// \brief Constructor
+      public: ODETriMeshData() = default;
+
+      /// \brief Destructor
+      public: ~ODETriMeshData()
+              {
+                if (this->odeData)
+                  dGeomTriMeshDataDestroy(this->odeData);
+                delete [] this->vertices;
+                delete [] this->indices;
+              }
+
+      /// \brief Not copyable.
+      public: ODETriMeshData(const ODETriMeshData &) = delete;
+
+      /// \brief Not assignable.
+      public: ODETriMeshData &operator=(const ODETriMeshData &) = delete;
+
+      /// \brief Array of vertex values.
+      public: float *vertices = nullptr;
+
+      /// \brief Array of index values.
+      public: int *indices = nullptr;
+
+      /// \brief Number of vertices.
+      public: unsigned int vertexCount = 0;
+
+      /// \brief Number of indices.
+      public: unsigned int indexCount = 0;
+
+      /// \brief ODE trimesh data.
+      public: dTriMeshDataID odeData = nullptr;
+    };
+
+    /// \internal
+    /// \brief Private data for the ODEMesh class.
+    class ODEMeshPrivate
+    {
+      /// \brief Trimesh data, possibly shared with other meshes.
+      public: std::shared_ptr<ODETriMeshData> data;
+    };
+  }
+}
+
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Key of shared trimesh data: name of the mesh and scale.
+typedef std::tuple<std::string, double, double, double> ODETriMeshKey;
+
+/// \brief Trimesh data shared by the meshes, by key. Entries are removed
+/// when their last mesh is destroyed.
+static std::map<ODETriMeshKey, std::weak_ptr<ODETriMeshData>> g_triMeshCache;
+
+/// \brief Protects g_triMeshCache and the counters below.
+static std::mutex g_triMeshMutex;
+
+/// \brief Number of trimesh data alive.
+static unsigned int g_triMeshDataCount = 0;
+
+/// \brief Size of the vertices and indices of the trimesh data alive.
+static uint64_t g_triMeshDataSize = 0;
+
+/////////////////////////////////////////////////
+/// \brief Build trimesh data from vertex and index arrays.
+/// \param[in] _fill Function that allocates and fills the arrays.
+/// \param[in] _vertexCount Number of vertices.
+/// \param[in] _indexCount Number of indices.
+/// \param[in] _scale Scaling factor.
+/// \param[in] _key Key of the data in the cache, empty if it isn't shared.
+/// \return The trimesh data.
+template<typename F>
+static std::shared_ptr<ODETriMeshData> BuildTriMeshData(const F &_fill,
+    const unsigned int _vertexCount, const unsigned int _indexCount,
+    const ignition::math::Vector3d &_scale, const std::string &_key)
+{
+  const ODETriMeshKey key(_key, _scale.X(), _scale.Y(), _scale.Z());
+
+  // Hold the lock while building, so that concurrent loads of the same
+  // mesh build it once.
+  std::lock_guard<std::mutex> lock(g_triMeshMutex);
+  if (!_key.empty())
+  {
+    auto iter = g_triMeshCache.find(key);
+    if (iter != g_triMeshCache.end())
+    {
+      std::shared_ptr<ODETriMeshData> data = iter->second.lock();
+      if (data)
+        return data;
+    }
+  }
+
+  const uint64_t size = _vertexCount * 3 * sizeof(float) +
+      _indexCount * sizeof(int);
+
+  // The deleter removes the data from the cache, unless it was replaced
+  // after it expired.
+  std::shared_ptr<ODETriMeshData> data(new ODETriMeshData,
+      [key, size](ODETriMeshData *_data)
+      {
+        {
+          std::lock_guard<std::mutex> deleteLock(g_triMeshMutex);
+          auto iter = g_triMeshCache.find(key);
+          if (iter != g_triMeshCache.end() && iter->second.expired())
+            g_triMeshCache.erase(iter);
+          --g_triMeshDataCount;
+          g_triMeshDataSize -= size;
+        }
+        delete _data;
+      });
+
+  _fill(&data->vertices, &data->indices);
+  data->vertexCount = _vertexCount;
+  data->indexCount = _indexCount;
+
+  // Scale the vertex data
+  for (unsigned int j = 0; j < _vertexCount; ++j)
+  {
+    data->vertices[j*3+0] = data->vertices[j*3+0] * _scale.X();
+    data->vertices[j*3+1] = data->vertices[j*3+1] * _scale.Y();
+    data->vertices[j*3+2] = data->vertices[j*3+2] * _scale.Z();
+  }
+
+  // Build the ODE triangle mesh
+  data->odeData = dGeomTriMeshDataCreate();
+  dGeomTriMeshDataBuildSingle(data->odeData,
+      data->vertices, 3*sizeof(data->vertices[0]), _vertexCount,
+      data->indices, _indexCount, 3*sizeof(data->indices[0]));
+
+  ++g_triMeshDataCount;
+  g_triMeshDataSize += size;
+  if (!_key.empty())
+    g_triMeshCache[key] = data;
+
+  return data;
+}
+
 //////////////////////////////////////////////////
 ODEMesh::ODEMesh()
+  : dataPtr(new ODEMeshPrivate)
 {
-  this->odeData = nullptr;
   this->vertices = nullptr;
   this->indices = nullptr;
 }
@@ -36,9 +185,6 @@ ODEMesh::ODEMesh()
 //////////////////////////////////////////////////
 ODEMesh::~ODEMesh()
 {
-  delete [] this->vertices;
-  delete [] this->indices;
-  dGeomTriMeshDataDestroy(this->odeData);
 }
 
 //////////////////////////////////////////////////
@@ -79,25 +225,44 @@ void ODEMesh::Update()
                                    this->transformIndex * 16));
 }
 
+//////////////////////////////////////////////////
+unsigned int ODEMesh::DataCount()
+{
+  std::lock_guard<std::mutex> lock(g_triMeshMutex);
+  return g_triMeshDataCount;
+}
+
+//////////////////////////////////////////////////
+uint64_t ODEMesh::DataSize()
+{
+  std::lock_guard<std::mutex> lock(g_triMeshMutex);
+  return g_triMeshDataSize;
+}
+
 //////////////////////////////////////////////////
 void ODEMesh::Init(const common::SubMesh *_subMesh, ODECollisionPtr _collision,
     const ignition::math::Vector3d &_scale)
+{
+  this->Init(_subMesh, "", _collision, _scale);
+}
+
+//////////////////////////////////////////////////
+void ODEMesh::Init(const common::SubMesh *_subMesh, const std::string &_key,
+    ODECollisionPtr _collision, const ignition::math::Vector3d &_scale)
 {
   if (!_subMesh)
     return;
 
-  unsigned int numVertices = _subMesh->GetVertexCount();
-  unsigned int numIndices = _subMesh->GetIndexCount();
-
-  this->vertices = nullptr;
-  this->indices = nullptr;
-
-  // Get all the vertex and index data
-  _subMesh->FillArrays(&this->vertices, &this->indices);
-
   this->collisionId = _collision->GetCollisionId();
 
-  this->CreateMesh(numVertices, numIndices, _collision, _scale);
+  // Get all the vertex and index data
+  this->CreateMesh(BuildTriMeshData(
+      [_subMesh](float **_vertices, int **_indices)
+      {
+        _subMesh->FillArrays(_vertices, _indices);
+      },
+      _subMesh->GetVertexCount(), _subMesh->GetIndexCount(), _scale, _key),
+      _collision);
 }
 
 //////////////////////////////////////////////////
@@ -107,49 +272,38 @@ void ODEMesh::Init(const common::Mesh *_mesh, ODECollisionPtr _collision,
   if (!_mesh)
     return;
 
-  unsigned int numVertices = _mesh->GetVertexCount();
-  unsigned int numIndices = _mesh->GetIndexCount();
-
-  this->vertices = nullptr;
-  this->indices = nullptr;
-
-  // Get all the vertex and index data
-  _mesh->FillArrays(&this->vertices, &this->indices);
-
   this->collisionId = _collision->GetCollisionId();
-  this->CreateMesh(numVertices, numIndices, _collision, _scale);
+
+  // Meshes are owned by the mesh manager, which names them uniquely.
+  this->CreateMesh(BuildTriMeshData(
+      [_mesh](float **_vertices, int **_indices)
+      {
+        _mesh->FillArrays(_vertices, _indices);
+      },
+      _mesh->GetVertexCount(), _mesh->GetIndexCount(), _scale,
+      _mesh->GetName()),
+      _collision);
 }
 
 //////////////////////////////////////////////////
-void ODEMesh::CreateMesh(unsigned int _numVertices, unsigned int _numIndices,
-    ODECollisionPtr _collision, const ignition::math::Vector3d &_scale)
+void ODEMesh::CreateMesh(std::shared_ptr<ODETriMeshData> _data,
+    ODECollisionPtr _collision)
 {
-  /// This will hold the vertex data of the triangle mesh
-  if (this->odeData == nullptr)
-    this->odeData = dGeomTriMeshDataCreate();
-
-  // Scale the vertex data
-  for (unsigned int j = 0;  j < _numVertices; j++)
-  {
-    this->vertices[j*3+0] = this->vertices[j*3+0] * _scale.X();
-    this->vertices[j*3+1] = this->vertices[j*3+1] * _scale.Y();
-    this->vertices[j*3+2] = this->vertices[j*3+2] * _scale.Z();
-  }
-
-  // Build the ODE triangle mesh
-  dGeomTriMeshDataBuildSingle(this->odeData,
-      this->vertices, 3*sizeof(this->vertices[0]), _numVertices,
-      this->indices, _numIndices, 3*sizeof(this->indices[0]));
+  // Keep the previous data until the collision uses the new one
+  std::shared_ptr<ODETriMeshData> previous = this->dataPtr->data;
+  this->dataPtr->data = _data;
+  this->vertices = _data->vertices;
+  this->indices = _data->indices;
 
   if (_collision->GetCollisionId() == nullptr)
   {
     _collision->SetSpaceId(dSimpleSpaceCreate(_collision->GetSpaceId()));
     _collision->SetCollision(dCreateTriMesh(_collision->GetSpaceId(),
-          this->odeData, 0, 0, 0), true);
+          _data->odeData, 0, 0, 0), true);
   }
   else
   {
-    dGeomTriMeshSetData(_collision->GetCollisionId(), this->odeData);
+    dGeomTriMeshSetData(_collision->GetCollisionId(), _data->odeData);
   }
 
   memset(this->transform, 0, 32*sizeof(dReal));
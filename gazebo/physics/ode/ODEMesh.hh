@@ -18,6 +18,10 @@
 #ifndef GAZEBO_PHYSICS_ODE_ODEMESH_HH_
 #define GAZEBO_PHYSICS_ODE_ODEMESH_HH_
 
+#include <cstdint>
+#include <memory>
+#include <string>
+
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/physics/ode/ODETypes.hh"
@@ -29,10 +33,20 @@ namespace gazebo
 {
   namespace physics
   {
+    // Forward declare private data
+    class ODEMeshPrivate;
+
+    // Forward declare shared trimesh data
+    class ODETriMeshData;
+
     /// \addtogroup gazebo_physics_ode
     /// \{
 
     /// \brief Triangle mesh helper class.
+    ///
+    /// The vertices, indices and collision tree of a mesh are shared by all
+    /// the shapes created from the same mesh with the same scale. Each shape
+    /// only keeps its own transforms.
     class GZ_PHYSICS_VISIBLE ODEMesh
     {
       /// \brief Constructor.
@@ -49,6 +63,19 @@ namespace gazebo
                       ODECollisionPtr _collision,
                       const ignition::math::Vector3d &_scale);
 
+      /// \brief Create a mesh collision shape using a submesh, sharing its
+      /// data with the other shapes created with the same key and scale.
+      /// \param[in] _subMesh Pointer to the submesh.
+      /// \param[in] _key Name that identifies the content of the submesh,
+      /// such as the name of its mesh and its own name. The data isn't
+      /// shared if it's empty.
+      /// \param[in] _collision Pointer to the collision object.
+      /// \param[in] _scale Scaling factor.
+      public: void Init(const common::SubMesh *_subMesh,
+                      const std::string &_key,
+                      ODECollisionPtr _collision,
+                      const ignition::math::Vector3d &_scale);
+
       /// \brief Create a mesh collision shape using a mesh.
       /// \param[in] _mesh Pointer to the mesh.
       /// \param[in] _collision Pointer to the collision object.
@@ -60,13 +87,21 @@ namespace gazebo
       /// \brief Update the collision mesh.
       public: virtual void Update();
 
+      /// \brief Get the number of distinct trimesh data in use by all the
+      /// meshes.
+      /// \return Number of trimesh data.
+      public: static unsigned int DataCount();
+
+      /// \brief Get the size of the vertices and indices in use by all the
+      /// meshes, counting shared data once.
+      /// \return Size in bytes.
+      public: static uint64_t DataSize();
+
       /// \brief Helper function to create the collision shape.
-      /// \param[in] _numVertices Number of vertices.
-      /// \param[in] _numIndices Number of indices.
+      /// \param[in] _data Trimesh data of the shape.
       /// \param[in] _collision Pointer to the collision object.
-      private: void CreateMesh(unsigned int _numVertices,
-                   unsigned int _numIndices, ODECollisionPtr _collision,
-                   const ignition::math::Vector3d &_scale);
+      private: void CreateMesh(std::shared_ptr<ODETriMeshData> _data,
+                   ODECollisionPtr _collision);
 
       /// \brief Transform matrix.
       private: dReal transform[16*2];
@@ -74,14 +109,15 @@ namespace gazebo
       /// \brief Transform matrix index.
       private: int transformIndex;
 
-      /// \brief Array of vertex values.
+      /// \brief Array of vertex values, owned by the trimesh data.
       private: float *vertices;
 
-      /// \brief Array of index values.
+      /// \brief Array of index values, owned by the trimesh data.
       private: int *indices;
 
-      /// \brief ODE trimesh data.
-      private: dTriMeshDataID odeData;
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ODEMeshPrivate> dataPtr;
 
       /// \brief The collision id that this mesh is attached to.
       private: dGeomID collisionId;
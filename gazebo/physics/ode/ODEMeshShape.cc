@@ -59,7 +59,13 @@ void ODEMeshShape::Init()
 
   if (this->submesh)
   {
-    this->odeMesh->Init(this->submesh,
+    // Submeshes are copied from the mesh, and centered on request.
+    sdf::ElementPtr submeshElem = this->sdf->GetElement("submesh");
+    std::string key = this->mesh->GetName() + "::" + this->submesh->GetName();
+    if (submeshElem->Get<bool>("center"))
+      key += "::centered";
+
+    this->odeMesh->Init(this->submesh, key,
         boost::static_pointer_cast<ODECollision>(this->collisionParent),
         this->sdf->Get<ignition::math::Vector3d>("scale"));
   }
@@ -14,6 +14,10 @@
  * limitations under the License.
  *
  */
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Exception.hh"
 
@@ -28,6 +32,33 @@
 using namespace gazebo;
 using namespace physics;
 
+/// \internal
+/// \brief ODE state of the batch ray queries of a multiray shape, shared
+/// by their callbacks.
+class ODEMultiRayBatch
+{
+  /// \brief Constructor.
+  public: ODEMultiRayBatch()
+  {
+    // Box covering all the rays, resized before each scan
+    this->boundsId = dCreateBox(0, 1, 1, 1);
+    dGeomSetCategoryBits(this->boundsId, GZ_SENSOR_COLLIDE);
+    dGeomSetCollideBits(this->boundsId, ~GZ_SENSOR_COLLIDE);
+  }
+
+  /// \brief Destructor.
+  public: ~ODEMultiRayBatch()
+  {
+    dGeomDestroy(this->boundsId);
+  }
+
+  /// \brief Box geom covering all the rays, used to query the broadphase
+  /// once per scan.
+  public: dGeomID boundsId;
+
+  /// \brief Rays that may hit the collision being intersected.
+  public: std::vector<unsigned int> collisionRays;
+};
 
 //////////////////////////////////////////////////
 ODEMultiRayShape::ODEMultiRayShape(CollisionPtr _parent)
@@ -44,14 +75,14 @@ ODEMultiRayShape::ODEMultiRayShape(CollisionPtr _parent)
   // Set collision bits
   dGeomSetCategoryBits((dGeomID) this->raySpaceId, GZ_SENSOR_COLLIDE);
   dGeomSetCollideBits((dGeomID) this->raySpaceId, ~GZ_SENSOR_COLLIDE);
+
+  this->InitBatch();
 }
 
 //////////////////////////////////////////////////
 ODEMultiRayShape::ODEMultiRayShape(PhysicsEnginePtr _physicsEngine)
 : MultiRayShape(_physicsEngine)
 {
-  this->defaultUpdate = false;
-
   this->SetName("ODE Multiray Shape");
 
   // Create a space to contain the ray space
@@ -64,12 +95,19 @@ ODEMultiRayShape::ODEMultiRayShape(PhysicsEnginePtr _physicsEngine)
   dGeomSetCategoryBits((dGeomID) this->raySpaceId, GZ_SENSOR_COLLIDE);
   dGeomSetCollideBits((dGeomID) this->raySpaceId, ~GZ_SENSOR_COLLIDE);
 
+  this->InitBatch();
+
   this->SetWorld(_physicsEngine->World());
 }
 
 //////////////////////////////////////////////////
 ODEMultiRayShape::~ODEMultiRayShape()
 {
+  // Release the state of the batch, held by the callbacks
+  this->SetCandidatesCallback(nullptr);
+  this->SetIntersectCallback(nullptr);
+  this->SetHitCallback(nullptr);
+
   dSpaceSetCleanup(this->raySpaceId, 0);
   dSpaceDestroy(this->raySpaceId);
 
@@ -93,116 +131,104 @@ void ODEMultiRayShape::UpdateRays()
   {
     boost::recursive_mutex::scoped_lock lock(*ode->GetPhysicsUpdateMutex());
 
-    // Do collision detection
-    dSpaceCollide2((dGeomID) (this->superSpaceId),
-        (dGeomID) (ode->GetSpaceId()),
-        this, &UpdateCallback);
+    // Keep the ray geoms in sync, they are used by the intersect callback
+    for (auto &ray : this->rays)
+      ray->Update();
+
+    this->UpdateBatch();
   }
 }
 
 //////////////////////////////////////////////////
-void ODEMultiRayShape::UpdateCallback(void *_data, dGeomID _o1, dGeomID _o2)
+void ODEMultiRayShape::InitBatch()
 {
-  dContactGeom contact;
-  ODEMultiRayShape *self = nullptr;
+  std::shared_ptr<ODEMultiRayBatch> state(new ODEMultiRayBatch);
 
-  self = static_cast<ODEMultiRayShape*>(_data);
-
-  // Check space
-  if (dGeomIsSpace(_o1) || dGeomIsSpace(_o2))
+  this->SetCandidatesCallback([this, state](
+        const ignition::math::AxisAlignedBox &_box,
+        std::vector<Collision *> &_collisions)
   {
-    if (dGeomGetSpace(_o1) == self->superSpaceId ||
-        dGeomGetSpace(_o2) == self->superSpaceId)
-    {
-      dSpaceCollide2(_o1, _o2, self, &UpdateCallback);
-    }
-
-    if (dGeomGetSpace(_o1) == self->raySpaceId ||
-        dGeomGetSpace(_o2) == self->raySpaceId)
-    {
-      dSpaceCollide2(_o1, _o2, self, &UpdateCallback);
-    }
-  }
-  else
+    ODEPhysicsPtr ode = boost::static_pointer_cast<ODEPhysics>(
+        this->GetWorld()->Physics());
+
+    // Query the broadphase of the world space with a box covering all the
+    // rays, instead of colliding every ray with the world space.
+    ignition::math::Vector3d size = _box.Size() + ignition::math::Vector3d(
+        1e-3, 1e-3, 1e-3);
+    ignition::math::Vector3d center = _box.Center();
+    dGeomBoxSetLengths(state->boundsId, size.X(), size.Y(), size.Z());
+    dGeomSetPosition(state->boundsId, center.X(), center.Y(), center.Z());
+
+    dSpaceCollide2(state->boundsId, (dGeomID) (ode->GetSpaceId()),
+        &_collisions, &CandidateCallback);
+  });
+
+  // dCollide supports all the ODE geoms
+  this->SetIntersectCallback([this, state](
+        const std::vector<Collision *> &_collisions, RayBatch &_batch)
   {
-    ODECollision *collision1 = nullptr;
-    ODECollision *collision2 = nullptr;
-    dGeomID rayId = 0;
-
-    // Get pointers to the underlying collisions
-    if (dGeomGetClass(_o1) == dGeomTransformClass)
-    {
-      collision1 = static_cast<ODECollision*>(
-          dGeomGetData(dGeomTransformGetGeom(_o1)));
-    }
-    else
-    {
-      collision1 = static_cast<ODECollision*>(dGeomGetData(_o1));
-    }
-
-    if (dGeomGetClass(_o2) == dGeomTransformClass)
-    {
-      collision2 =
-        static_cast<ODECollision*>(dGeomGetData(dGeomTransformGetGeom(_o2)));
-    }
-    else
-    {
-      collision2 = static_cast<ODECollision*>(dGeomGetData(_o2));
-    }
-
-    ODECollision *rayCollision = nullptr;
-    ODECollision *hitCollision = nullptr;
-
-    // Figure out which one is a ray; note that this assumes
-    // that the ODE dRayClass is used *soley* by the RayCollision.
-    if (dGeomGetClass(_o1) == dRayClass)
+    for (auto const &fallback : _collisions)
     {
-      rayCollision = collision1;
-      rayId = _o1;
-      hitCollision = collision2;
-      dGeomRaySetParams(_o1, 0, 0);
-      dGeomRaySetClosestHit(_o1, 1);
-    }
-    else if (dGeomGetClass(_o2) == dRayClass)
-    {
-      GZ_ASSERT(rayCollision == nullptr, "rayCollision is not null");
-      rayCollision = collision2;
-      hitCollision = collision1;
-      rayId = _o2;
-      dGeomRaySetParams(_o2, 0, 0);
-      dGeomRaySetClosestHit(_o2, 1);
-    }
+      ODECollision *collision = static_cast<ODECollision*>(fallback);
 
-    if (!self->defaultUpdate || (rayCollision && hitCollision))
-    {
-      int n = dCollide(_o1, _o2, 1, &contact, sizeof(contact));
+      // ODE bounding boxes are in the world frame
+      _batch.RaysInBox(collision->BoundingBox(), state->collisionRays);
 
-      if (n > 0 && self->defaultUpdate)
+      for (auto const index : state->collisionRays)
       {
-        RayShape *shape = self->defaultUpdate ?
-          boost::static_pointer_cast<RayShape>(rayCollision->GetShape()).get() :
-          static_cast<RayShape*>(dGeomGetData(rayId));
-
-        if (shape && hitCollision && contact.depth < shape->GetLength())
+        dGeomID rayId = boost::static_pointer_cast<ODERayShape>(
+            this->rays[index])->ODEGeomId();
+        dGeomRaySetParams(rayId, 0, 0);
+        dGeomRaySetClosestHit(rayId, 1);
+
+        dContactGeom contact;
+        if (dCollide(rayId, collision->GetCollisionId(), 1, &contact,
+              sizeof(contact)) > 0)
         {
-          // gzerr << "ODEMultiRayShape UpdateCallback dSpaceCollide2 "
-          //      << " depth[" << contact.depth << "]"
-          //      << " position[" << contact.pos[0]
-          //        << ", " << contact.pos[1]
-          //        << ", " << contact.pos[2]
-          //        << ", " << "]"
-          //      << " ray[" << rayCollision->GetScopedName() << "]"
-          //      << " pose[" << rayCollision->GetWorldPose() << "]"
-          //      << " hit[" << hitCollision->GetScopedName() << "]"
-          //      << " pose[" << hitCollision->GetWorldPose() << "]"
-          //      << "\n";
-          shape->SetLength(contact.depth);
-          shape->SetRetro(hitCollision->GetLaserRetro());
-          shape->SetCollisionName(hitCollision->GetScopedName());
+          _batch.SetHit(index, contact.depth, collision->GetId(),
+              collision->GetLaserRetro());
         }
       }
     }
+  });
+
+  this->SetHitCallback([this](const unsigned int _index,
+        Collision *_collision)
+  {
+    this->rays[_index]->SetCollisionName(
+        _collision ? _collision->GetScopedName() : std::string());
+  });
+}
+
+//////////////////////////////////////////////////
+void ODEMultiRayShape::CandidateCallback(void *_data, dGeomID _o1,
+    dGeomID _o2)
+{
+  // _o1 is always the bounds geom
+  if (dGeomIsSpace(_o2))
+  {
+    dSpaceCollide2(_o1, _o2, _data, &CandidateCallback);
+    return;
   }
+
+  // Note that this assumes that the ODE dRayClass is used *soley* by the
+  // RayCollision.
+  if (dGeomGetClass(_o2) == dRayClass)
+    return;
+
+  ODECollision *collision = nullptr;
+  if (dGeomGetClass(_o2) == dGeomTransformClass)
+  {
+    collision = static_cast<ODECollision*>(
+        dGeomGetData(dGeomTransformGetGeom(_o2)));
+  }
+  else
+  {
+    collision = static_cast<ODECollision*>(dGeomGetData(_o2));
+  }
+
+  if (collision)
+    static_cast<std::vector<Collision *> *>(_data)->push_back(collision);
 }
 
 //////////////////////////////////////////////////
@@ -232,6 +258,7 @@ void ODEMultiRayShape::AddRay(const ignition::math::Vector3d &_start,
     ray.reset(new ODERayShape(boost::dynamic_pointer_cast<ODEPhysics>(
             this->GetWorld()->Physics()), this->raySpaceId));
     dGeomSetData(ray->ODEGeomId(), ray.get());
+    ray->SetWorld(this->GetWorld());
   }
 
   ray->SetPoints(_start, _end);
@@ -44,12 +44,19 @@ namespace gazebo
       // Documentation inherited.
       public: virtual void UpdateRays();
 
-      /// \brief Ray-intersection callback.
-      /// \param[in] _data Pointer to user data.
+      /// \brief Candidate query callback, collects the collisions whose
+      /// bounding box overlaps the bounds of the scan.
+      /// \param[in] _data Pointer to the list of collisions.
       /// \param[in] _o1 First geom to check for collisions.
       /// \param[in] _o2 Second geom to check for collisions.
-      private: static void UpdateCallback(void *_data, dGeomID _o1,
-                                          dGeomID _o2);
+      private: static void CandidateCallback(void *_data, dGeomID _o1,
+                                             dGeomID _o2);
+
+      /// \brief Set the callbacks of the batch ray queries: the candidates
+      /// are found with the broadphase of the world space, the collisions
+      /// that the batch kernels don't support are intersected with
+      /// dCollide, and the names of the collisions are stored in the rays.
+      private: void InitBatch();
 
       /// \brief Add a ray to the collision.
       /// \param[in] _start Start of a ray.
@@ -63,8 +70,8 @@ namespace gazebo
       /// \brief Ray space for collision detector.
       private: dSpaceID raySpaceId;
 
-      /// \brief Helper to get the correct ray shape in the UpdateCallback
-      /// function.
+      /// \brief Unused, the state of the batch ray queries is held by
+      /// their callbacks.
       private: bool defaultUpdate = true;
     };
     /// \}
@@ -21,11 +21,15 @@
 #include <sdf/sdf.hh>
 
 #include <algorithm>
+#include <cmath>
+#include <functional>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <ignition/math/Helpers.hh>
 #include <ignition/math/Rand.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/common/Profiler.hh>
@@ -36,6 +40,7 @@
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/ProfileTimeline.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/Timer.hh"
 
@@ -50,6 +55,7 @@
 #include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/MapShape.hh"
 #include "gazebo/physics/ContactManager.hh"
+#include "gazebo/physics/Snapshot.hh"
 
 #include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODELink.hh"
@@ -103,33 +109,246 @@ class ContactUpdate_TBB
 };
 */
 
-class Colliders_TBB
+/// \brief Runs the narrow phase for chains of collision pairs. Pairs in
+/// the same chain share a geom with per-geom collision caches, so they are
+/// collided sequentially by one thread.
+class CollideChains_TBB
 {
-  public: Colliders_TBB(
-              std::vector<std::pair<ODECollision*, ODECollision*> > *_colliders,
-              ODEPhysics *_engine,
-              dContactGeom* _contactCollisions) :
-    colliders(_colliders),
-              engine(_engine), contactCollisions(_contactCollisions)
+  public: CollideChains_TBB(ODEPhysics *_engine,
+              std::vector<ODECollidePair> *_pairs,
+              const std::vector<unsigned int> *_chainPairs,
+              const std::vector<unsigned int> *_chainStarts) :
+    engine(_engine), pairs(_pairs), chainPairs(_chainPairs),
+    chainStarts(_chainStarts)
   {
-    // dAllocateODEDataForThread(dAllocateMaskAll);
   }
 
   public: void operator() (const tbb::blocked_range<size_t> &_r) const
   {
-    for (size_t i = _r.begin(); i != _r.end(); i++)
+    // Per thread collider caches (OPCODE, GIMPACT) are thread local in ODE
+    dAllocateODEDataForThread(dAllocateMaskAll);
+
+    static thread_local std::vector<dContactGeom> contactCollisions(
+        MAX_COLLIDE_RETURNS);
+
+    for (size_t c = _r.begin(); c != _r.end(); ++c)
     {
-      ODECollision *collision1 = (*this->colliders)[i].first;
-      ODECollision *collision2 = (*this->colliders)[i].second;
-      this->engine->Collide(collision1, collision2, contactCollisions);
+      for (unsigned int i = (*this->chainStarts)[c];
+           i < (*this->chainStarts)[c+1]; ++i)
+      {
+        ODECollidePair &pair = (*this->pairs)[(*this->chainPairs)[i]];
+        this->engine->CollideNarrowPhase(pair.collision1, pair.collision2,
+            contactCollisions.data(), pair);
+      }
     }
   }
 
-  private: std::vector< std::pair<ODECollision*, ODECollision*> > *colliders;
   private: ODEPhysics *engine;
-  private: dContactGeom* contactCollisions;
+  private: std::vector<ODECollidePair> *pairs;
+  private: const std::vector<unsigned int> *chainPairs;
+  private: const std::vector<unsigned int> *chainStarts;
 };
 
+/////////////////////////////////////////////////
+/// \brief Get the contact cache entry of a pair of collisions, and mark it
+/// as used in the current step.
+/// \param[in] _data ODE physics private data.
+/// \param[in] _collision1 First collision.
+/// \param[in] _collision2 Second collision.
+/// \return The cache entry, or null if the contact cache is disabled.
+static ODEContactCacheEntry *ContactCacheEntry(ODEPhysicsPrivate &_data,
+    ODECollision *_collision1, ODECollision *_collision2)
+{
+  if (_data.contactCacheTolerance <= 0)
+    return nullptr;
+
+  dGeomID geom1 = _collision1->GetCollisionId();
+  dGeomID geom2 = _collision2->GetCollisionId();
+  if (std::less<dGeomID>()(geom2, geom1))
+    std::swap(geom1, geom2);
+
+  ODEContactCacheEntry &entry = _data.contactCache[{geom1, geom2}];
+  entry.step = _data.contactCacheStep;
+  return &entry;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that a geom moved less than a tolerance since its state was
+/// stored in a contact cache entry.
+/// \param[in] _geom The geom.
+/// \param[in] _pos Stored position.
+/// \param[in] _rot Stored orientation.
+/// \param[in] _aabb Stored bounding box.
+/// \param[in] _tolerance Largest distance in meters, and largest angle in
+/// radians.
+/// \return True if the geom moved less than the tolerance.
+static bool ContactCacheGeomUnchanged(dGeomID _geom, const dReal *_pos,
+    const dReal *_rot, const dReal *_aabb, const double _tolerance)
+{
+  dReal aabb[6];
+  dGeomGetAABB(_geom, aabb);
+  for (int i = 0; i < 6; ++i)
+  {
+    // Infinite bounds, such as those of planes, compare equal.
+    if (aabb[i] != _aabb[i] && !(std::abs(aabb[i] - _aabb[i]) <= _tolerance))
+      return false;
+  }
+
+  // Planes aren't placeable
+  if (dGeomGetClass(_geom) == dPlaneClass)
+    return true;
+
+  if (dCalcPointsDistance3(dGeomGetPosition(_geom), _pos) > _tolerance)
+    return false;
+
+  // The rotation angle between two quaternions is 2 acos(|q1.q2|)
+  dQuaternion rot;
+  dGeomGetQuaternion(_geom, rot);
+  const dReal dot = rot[0] * _rot[0] + rot[1] * _rot[1] +
+    rot[2] * _rot[2] + rot[3] * _rot[3];
+  return std::abs(dot) >= std::cos(0.5 * _tolerance);
+}
+
+/////////////////////////////////////////////////
+/// \brief Store the state of a geom in a contact cache entry.
+/// \param[in] _geom The geom.
+/// \param[out] _pos Position of the geom.
+/// \param[out] _rot Orientation of the geom.
+/// \param[out] _aabb Bounding box of the geom.
+static void ContactCacheGeomStore(dGeomID _geom, dReal *_pos, dReal *_rot,
+    dReal *_aabb)
+{
+  dGeomGetAABB(_geom, _aabb);
+  if (dGeomGetClass(_geom) == dPlaneClass)
+    return;
+
+  const dReal *pos = dGeomGetPosition(_geom);
+  _pos[0] = pos[0];
+  _pos[1] = pos[1];
+  _pos[2] = pos[2];
+  dGeomGetQuaternion(_geom, _rot);
+}
+
+/////////////////////////////////////////////////
+/// \brief Count the hits and misses of the contact cache after a pair went
+/// through the narrow phase.
+/// \param[in] _data ODE physics private data.
+/// \param[in] _pair The pair.
+static void ContactCacheCount(ODEPhysicsPrivate &_data,
+    const ODECollidePair &_pair)
+{
+  // Pairs filtered by their bitmasks never fill their entry, and aren't
+  // counted.
+  if (_pair.cacheHit)
+    _data.contactCacheHits++;
+  else if (_pair.cacheEntry && _pair.cacheEntry->valid)
+    _data.contactCacheMisses++;
+}
+
+/////////////////////////////////////////////////
+/// \brief Remove the contact cache entries of pairs that weren't collided
+/// in the current step, and publish the hit rate of the step.
+/// \param[in] _data ODE physics private data.
+static void ContactCacheExpire(ODEPhysicsPrivate &_data)
+{
+  for (auto iter = _data.contactCache.begin();
+       iter != _data.contactCache.end();)
+  {
+    if (iter->second.step != _data.contactCacheStep)
+      iter = _data.contactCache.erase(iter);
+    else
+      ++iter;
+  }
+
+  const int pairs = _data.contactCacheHits + _data.contactCacheMisses;
+  if (pairs > 0)
+  {
+    DIAG_VALUE("ODEPhysics::contactCacheHitRate",
+        static_cast<double>(_data.contactCacheHits) / pairs);
+  }
+}
+
+/// \brief Extents of the geoms of a scene, used to select broadphase
+/// parameters. Geoms with infinite or empty bounds, such as planes and
+/// empty spaces, are skipped.
+class BroadphaseExtents
+{
+  /// \brief Add the bounding box of a geom.
+  /// \param[in] _geom Geom to add.
+  /// \param[in] _size True to add the size of the geom to sizes.
+  public: void Add(dGeomID _geom, bool _size)
+  {
+    dReal aabb[6];
+    dGeomGetAABB(_geom, aabb);
+
+    double size = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+      if (aabb[2*i] <= -dInfinity || aabb[2*i+1] >= dInfinity)
+        return;
+      size = std::max(size, static_cast<double>(aabb[2*i+1] - aabb[2*i]));
+    }
+    if (size <= 0)
+      return;
+
+    this->min.Min(ignition::math::Vector3d(aabb[0], aabb[2], aabb[4]));
+    this->max.Max(ignition::math::Vector3d(aabb[1], aabb[3], aabb[5]));
+    if (_size)
+      this->sizes.push_back(size);
+  }
+
+  /// \brief True if no geom was added.
+  public: bool Empty() const
+  {
+    return this->min.X() > this->max.X();
+  }
+
+  /// \brief Minimum corner of the scene.
+  public: ignition::math::Vector3d min = ignition::math::Vector3d(
+              ignition::math::MAX_D, ignition::math::MAX_D,
+              ignition::math::MAX_D);
+
+  /// \brief Maximum corner of the scene.
+  public: ignition::math::Vector3d max = ignition::math::Vector3d(
+              ignition::math::LOW_D, ignition::math::LOW_D,
+              ignition::math::LOW_D);
+
+  /// \brief Largest dimension of each geom.
+  public: std::vector<double> sizes;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get a parameter value. Values are encoded as strings when they
+/// are set from an SDFormat world file.
+/// \param[in] _value Parameter value.
+/// \param[in] _type SDFormat type of the value, such as "int".
+/// \param[out] _result Value.
+/// \return True if the value could be read.
+template<typename T>
+static bool ParamValue(const boost::any &_value, const std::string &_type,
+    T &_result)
+{
+  try
+  {
+    _result = boost::any_cast<T>(_value);
+    return true;
+  }
+  catch(const boost::bad_any_cast &)
+  {
+  }
+
+  try
+  {
+    sdf::Param strParam("key", _type, "0", false, "description");
+    return strParam.Set(boost::any_cast<std::string>(_value)) &&
+        strParam.Get<T>(_result);
+  }
+  catch(const boost::bad_any_cast &)
+  {
+    return false;
+  }
+}
+
 //////////////////////////////////////////////////
 extern "C" void dMessageQuiet(int, const char *, va_list)
 {
@@ -150,7 +369,13 @@ ODEPhysics::ODEPhysics(WorldPtr _world)
   this->dataPtr->worldId = dWorldCreate();
 
   this->dataPtr->spaceId = dHashSpaceCreate(0);
-  dHashSpaceSetLevels(this->dataPtr->spaceId, -2, 8);
+  dHashSpaceSetLevels(this->dataPtr->spaceId, this->dataPtr->hashMinLevel,
+      this->dataPtr->hashMaxLevel);
+
+  // Static collisions rarely move, so their tree is built once and is not
+  // inflated.
+  this->dataPtr->staticSpaceId = dBVHSpaceCreate(this->dataPtr->spaceId);
+  dBVHSpaceSetMargin(this->dataPtr->staticSpaceId, 0);
 
   this->dataPtr->contactGroup = dJointGroupCreate(0);
 
@@ -239,6 +464,36 @@ void ODEPhysics::Load(sdf::ElementPtr _sdf)
   this->SetStepType(this->dataPtr->stepType);
   if (this->dataPtr->physicsStepFunc == nullptr)
     gzthrow(std::string("Invalid step type[") + this->dataPtr->stepType);
+
+  // Broadphase parameters aren't part of the SDF spec, they are read from
+  // custom elements. The type is set last, so that its space is only
+  // built once.
+  std::vector<std::string> broadphaseKeys = {"hash_min_level",
+      "hash_max_level", "sap_axis_order", "quadtree_depth", "bvh_margin",
+      "broadphase_auto", "broadphase"};
+
+  // The hash levels are checked against each other as they are set
+  int minLevel;
+  if (odeElem->HasElement("ignition:hash_min_level") &&
+      ParamValue<int>(odeElem->Get<std::string>("ignition:hash_min_level"),
+        "int", minLevel) && minLevel > this->dataPtr->hashMaxLevel)
+  {
+    std::swap(broadphaseKeys[0], broadphaseKeys[1]);
+  }
+
+  for (auto const &key : broadphaseKeys)
+  {
+    const std::string elemName = "ignition:" + key;
+    if (odeElem->HasElement(elemName))
+      this->SetParam(key, odeElem->Get<std::string>(elemName));
+  }
+
+  // The number of narrow phase threads is a custom element as well
+  if (odeElem->HasElement("ignition:collision_threads"))
+  {
+    this->SetParam("collision_threads",
+        odeElem->Get<std::string>("ignition:collision_threads"));
+  }
 }
 
 /////////////////////////////////////////////////
@@ -365,6 +620,7 @@ void ODEPhysics::InitForThread()
 //////////////////////////////////////////////////
 void ODEPhysics::UpdateCollision()
 {
+  GZ_PROFILE("ODEPhysics::UpdateCollision");
   DIAG_TIMER_START("ODEPhysics::UpdateCollision");
   IGN_PROFILE("ODEPhysics:UpdateCollision");
   IGN_PROFILE_BEGIN("dSpaceCollide");
@@ -376,15 +632,43 @@ void ODEPhysics::UpdateCollision()
   this->dataPtr->collidersCount = 0;
   this->dataPtr->trimeshCollidersCount = 0;
   this->dataPtr->jointFeedbackIndex = 0;
+  this->dataPtr->contactCacheStep++;
+  this->dataPtr->contactCacheHits = 0;
+  this->dataPtr->contactCacheMisses = 0;
 
   // Reset the contact count
   this->contactManager->ResetCount();
 
+  if (this->dataPtr->broadphaseAuto)
+  {
+    // Select the broadphase parameters again when the scene has changed
+    // significantly.
+    const int count = dSpaceGetNumGeoms(this->dataPtr->spaceId) +
+        dSpaceGetNumGeoms(this->dataPtr->staticSpaceId);
+    const int autoCount = this->dataPtr->broadphaseAutoCount;
+    if (autoCount < 0 || count > 2 * autoCount || 2 * count < autoCount)
+      this->TuneBroadphase();
+  }
+
   // Do collision detection; this will add contacts to the contact group
   dSpaceCollide(this->dataPtr->spaceId, this, CollisionCallback);
   DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "dSpaceCollide");
+  GZ_PROFILE_LAP("ODEPhysics::UpdateCollision:dSpaceCollide");
   IGN_PROFILE_END();
 
+  if (this->dataPtr->collisionThreads > 0)
+  {
+    IGN_PROFILE_BEGIN("collideParallel");
+    this->CollideParallel();
+    DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "collideParallel");
+    GZ_PROFILE_LAP("ODEPhysics::UpdateCollision:collideParallel");
+    IGN_PROFILE_END();
+
+    ContactCacheExpire(*this->dataPtr);
+    DIAG_TIMER_STOP("ODEPhysics::UpdateCollision");
+    return;
+  }
+
   IGN_PROFILE_BEGIN("collideShapes");
   // Generate non-trimesh collisions.
   for (i = 0; i < this->dataPtr->collidersCount; ++i)
@@ -393,6 +677,7 @@ void ODEPhysics::UpdateCollision()
         this->dataPtr->colliders[i].second, this->dataPtr->contactCollisions);
   }
   DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "collideShapes");
+  GZ_PROFILE_LAP("ODEPhysics::UpdateCollision:collideShapes");
   IGN_PROFILE_END();
 
 
@@ -406,14 +691,18 @@ void ODEPhysics::UpdateCollision()
     this->Collide(collision1, collision2, this->dataPtr->contactCollisions);
   }
   DIAG_TIMER_LAP("UpdateCollision", "collideTrimeshes");
+  GZ_PROFILE_LAP("ODEPhysics::UpdateCollision:collideTrimeshes");
   IGN_PROFILE_END();
 
+  ContactCacheExpire(*this->dataPtr);
+
   DIAG_TIMER_STOP("ODEPhysics::UpdateCollision");
 }
 
 //////////////////////////////////////////////////
 void ODEPhysics::UpdatePhysics()
 {
+  GZ_PROFILE("ODEPhysics::UpdatePhysics");
   DIAG_TIMER_START("ODEPhysics::UpdatePhysics");
   IGN_PROFILE("ODEPhysics:UpdatePhysics");
 
@@ -478,6 +767,13 @@ void ODEPhysics::Fini()
   }
   this->dataPtr->jointFeedbacks.clear();
 
+  if (this->dataPtr->staticSpaceId)
+  {
+    dSpaceSetCleanup(this->dataPtr->staticSpaceId, 0);
+    dSpaceDestroy(this->dataPtr->staticSpaceId);
+  }
+  this->dataPtr->staticSpaceId = nullptr;
+
   if (this->dataPtr->spaceId)
   {
     dSpaceSetCleanup(this->dataPtr->spaceId, 0);
@@ -499,6 +795,9 @@ void ODEPhysics::Reset()
   boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
   // Very important to clear out the contact group
   dJointGroupEmpty(this->dataPtr->contactGroup);
+
+  // Regenerate all contacts, so that a reset world steps as it first did
+  this->dataPtr->contactCache.clear();
 }
 
 //////////////////////////////////////////////////
@@ -507,21 +806,32 @@ LinkPtr ODEPhysics::CreateLink(ModelPtr _parent)
   if (_parent == nullptr)
     gzthrow("Link must have a parent\n");
 
-  std::map<std::string, dSpaceID>::iterator iter;
-  iter = this->dataPtr->spaces.find(_parent->GetName());
-
-  if (iter == this->dataPtr->spaces.end())
-    this->dataPtr->spaces[_parent->GetName()] =
-      dSimpleSpaceCreate(this->dataPtr->spaceId);
-
   ODELinkPtr link(new ODELink(_parent));
 
-  link->SetSpaceId(this->dataPtr->spaces[_parent->GetName()]);
+  link->SetSpaceId(this->LinkSpaceId(_parent, _parent->IsStatic()));
   link->SetWorld(_parent->GetWorld());
 
   return link;
 }
 
+//////////////////////////////////////////////////
+dSpaceID ODEPhysics::LinkSpaceId(ModelPtr _model, const bool _static)
+{
+  // All static collisions share one space, instead of one top-level
+  // space per static model.
+  if (_static)
+    return this->dataPtr->staticSpaceId;
+
+  std::map<std::string, dSpaceID>::iterator iter;
+  iter = this->dataPtr->spaces.find(_model->GetName());
+
+  if (iter == this->dataPtr->spaces.end())
+    this->dataPtr->spaces[_model->GetName()] =
+      dSimpleSpaceCreate(this->dataPtr->spaceId);
+
+  return this->dataPtr->spaces[_model->GetName()];
+}
+
 //////////////////////////////////////////////////
 CollisionPtr ODEPhysics::CreateCollision(const std::string &_type,
                                          LinkPtr _body)
@@ -917,6 +1227,140 @@ dSpaceID ODEPhysics::GetSpaceId() const
   return this->dataPtr->spaceId;
 }
 
+//////////////////////////////////////////////////
+bool ODEPhysics::RebuildBroadphase()
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  const std::string &type = this->dataPtr->broadphase;
+  dSpaceID space = nullptr;
+  if (type == "hash")
+  {
+    space = dHashSpaceCreate(0);
+    dHashSpaceSetLevels(space, this->dataPtr->hashMinLevel,
+        this->dataPtr->hashMaxLevel);
+  }
+  else if (type == "sap")
+  {
+    int axisOrder = 0;
+    for (unsigned int i = 0; i < 3; ++i)
+      axisOrder |= (this->dataPtr->sapAxisOrder[i] - 'x') << (2 * i);
+    space = dSweepAndPruneSpaceCreate(0, axisOrder);
+  }
+  else if (type == "quadtree")
+  {
+    // The quadtree covers the current scene, geoms outside of it are
+    // kept in its root block.
+    BroadphaseExtents extents;
+    for (int i = 0; i < dSpaceGetNumGeoms(this->dataPtr->spaceId); ++i)
+      extents.Add(dSpaceGetGeom(this->dataPtr->spaceId, i), false);
+    for (int i = 0; i < dSpaceGetNumGeoms(this->dataPtr->staticSpaceId); ++i)
+      extents.Add(dSpaceGetGeom(this->dataPtr->staticSpaceId, i), false);
+
+    dVector3 center = {0, 0, 0};
+    dVector3 halfExtents = {100, 100, 100};
+    if (!extents.Empty())
+    {
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        center[i] = (extents.min[i] + extents.max[i]) * 0.5;
+        halfExtents[i] =
+            std::max((extents.max[i] - extents.min[i]) * 0.5, 1.0);
+      }
+    }
+    space = dQuadTreeSpaceCreate(0, center, halfExtents,
+        this->dataPtr->quadtreeDepth);
+  }
+  else if (type == "bvh")
+  {
+    space = dBVHSpaceCreate(0);
+    dBVHSpaceSetMargin(space, this->dataPtr->bvhMargin);
+  }
+  else
+  {
+    gzerr << "Invalid broadphase [" << type << "]\n";
+    return false;
+  }
+
+  // Move the model spaces and the static space to the new space
+  dSpaceID oldSpace = this->dataPtr->spaceId;
+  std::vector<dGeomID> geoms(dSpaceGetNumGeoms(oldSpace));
+  for (unsigned int i = 0; i < geoms.size(); ++i)
+    geoms[i] = dSpaceGetGeom(oldSpace, i);
+  for (auto const geom : geoms)
+  {
+    dSpaceRemove(oldSpace, geom);
+    dSpaceAdd(space, geom);
+  }
+  dSpaceSetCleanup(oldSpace, 0);
+  dSpaceDestroy(oldSpace);
+
+  this->dataPtr->spaceId = space;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::TuneBroadphase()
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  // Model spaces are sized by the hash space and quadtree, the static
+  // space is a single large geom to them and only extends the scene.
+  BroadphaseExtents extents;
+  for (int i = 0; i < dSpaceGetNumGeoms(this->dataPtr->spaceId); ++i)
+  {
+    dGeomID geom = dSpaceGetGeom(this->dataPtr->spaceId, i);
+    if (geom != (dGeomID) this->dataPtr->staticSpaceId)
+      extents.Add(geom, true);
+  }
+  for (int i = 0; i < dSpaceGetNumGeoms(this->dataPtr->staticSpaceId); ++i)
+    extents.Add(dSpaceGetGeom(this->dataPtr->staticSpaceId, i), false);
+
+  this->dataPtr->broadphaseAutoCount =
+      dSpaceGetNumGeoms(this->dataPtr->spaceId) +
+      dSpaceGetNumGeoms(this->dataPtr->staticSpaceId);
+
+  if (extents.Empty())
+    return;
+
+  const ignition::math::Vector3d size = extents.max - extents.min;
+  if (!extents.sizes.empty())
+  {
+    std::sort(extents.sizes.begin(), extents.sizes.end());
+
+    // Cells from the smallest to the largest model
+    this->dataPtr->hashMinLevel = ignition::math::clamp(static_cast<int>(
+          std::floor(std::log2(extents.sizes.front()))), -10, 20);
+    this->dataPtr->hashMaxLevel = ignition::math::clamp(static_cast<int>(
+          std::ceil(std::log2(extents.sizes.back()))),
+        this->dataPtr->hashMinLevel, 20);
+
+    // Quadtree leaves about the size of the median model
+    const double median = extents.sizes[extents.sizes.size() / 2];
+    this->dataPtr->quadtreeDepth = ignition::math::clamp(static_cast<int>(
+          std::ceil(std::log2(std::max(size.X(), size.Y()) / median))), 1, 8);
+  }
+
+  // Sweep along the longest axis first
+  std::string axisOrder = "xyz";
+  std::sort(axisOrder.begin(), axisOrder.end(),
+      [&size](const char _a, const char _b)
+      {
+        return size[_a - 'x'] > size[_b - 'x'];
+      });
+  this->dataPtr->sapAxisOrder = axisOrder;
+
+  if (this->dataPtr->broadphase == "hash")
+  {
+    dHashSpaceSetLevels(this->dataPtr->spaceId, this->dataPtr->hashMinLevel,
+        this->dataPtr->hashMaxLevel);
+  }
+  else if (this->dataPtr->broadphase != "bvh")
+  {
+    this->RebuildBroadphase();
+  }
+}
+
 //////////////////////////////////////////////////
 std::string ODEPhysics::GetStepType() const
 {
@@ -1018,10 +1462,32 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
 void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
                          dContactGeom *_contactCollisions)
 {
+  ODECollidePair &pair = this->dataPtr->collidePair;
+  pair.cacheEntry = ContactCacheEntry(*this->dataPtr, _collision1,
+      _collision2);
+
+  const bool collided = this->CollideNarrowPhase(_collision1, _collision2,
+      _contactCollisions, pair);
+  ContactCacheCount(*this->dataPtr, pair);
+
+  if (collided)
+    this->AddContactJoints(pair);
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::CollideNarrowPhase(ODECollision *_collision1,
+    ODECollision *_collision2, dContactGeom *_contactCollisions,
+    ODECollidePair &_pair)
+{
+  _pair.collision1 = _collision1;
+  _pair.collision2 = _collision2;
+  _pair.geoms.clear();
+  _pair.cacheHit = false;
+
   // Filter collisions based on collide bitmask.
   if ((_collision1->GetSurface()->collideBitmask &
         _collision2->GetSurface()->collideBitmask) == 0)
-    return;
+    return false;
 
   // Filter collisions based on contact bitmask if collide_without_contact is
   // on.The bitmask is set mainly for speed improvements otherwise a collision
@@ -1033,7 +1499,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     if ((_collision1->GetSurface()->collideWithoutContactBitmask &
          _collision2->GetSurface()->collideWithoutContactBitmask) == 0)
     {
-      return;
+      return false;
     }
   }
 
@@ -1050,9 +1516,12 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   }*/
 
   unsigned int numc = 0;
-  dContact contact;
+  dContact &contact = _pair.contact;
 
-  // maxCollide must less than the size of this->dataPtr->indices
+  // Indices of the selected contacts.
+  int indices[MAX_CONTACT_JOINTS];
+
+  // maxCollide must less than the size of indices
   // Check the header
   unsigned int maxCollide = MAX_CONTACT_JOINTS;
 
@@ -1067,17 +1536,67 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   if (_collision2->GetMaxContacts() < maxCollide)
     maxCollide = _collision2->GetMaxContacts();
 
-  // Generate the contacts
-  numc = dCollide(_collision1->GetCollisionId(), _collision2->GetCollisionId(),
-      MAX_COLLIDE_RETURNS, _contactCollisions, sizeof(_contactCollisions[0]));
+  // Generate the contacts, or reuse the contacts of a previous step if
+  // neither geom has moved since.
+  dGeomID geom1 = _collision1->GetCollisionId();
+  dGeomID geom2 = _collision2->GetCollisionId();
+  ODEContactCacheEntry *entry = _pair.cacheEntry;
+  if (entry && entry->valid)
+  {
+    // Index of each geom in the entry
+    const int index1 = entry->geom1 == geom1 ? 0 : 1;
+    const int index2 = 1 - index1;
+    const double tolerance = this->dataPtr->contactCacheTolerance;
+    _pair.cacheHit =
+      ContactCacheGeomUnchanged(geom1, entry->pos[index1], entry->rot[index1],
+          entry->aabb[index1], tolerance) &&
+      ContactCacheGeomUnchanged(geom2, entry->pos[index2], entry->rot[index2],
+          entry->aabb[index2], tolerance);
+  }
+
+  if (_pair.cacheHit)
+  {
+    numc = static_cast<unsigned int>(entry->geoms.size());
+    std::copy(entry->geoms.begin(), entry->geoms.end(), _contactCollisions);
+
+    // Mirror the contacts if the pair was collided in the other order
+    if (entry->geom1 != geom1)
+    {
+      for (unsigned int i = 0; i < numc; ++i)
+      {
+        dContactGeom &geom = _contactCollisions[i];
+        geom.normal[0] = -geom.normal[0];
+        geom.normal[1] = -geom.normal[1];
+        geom.normal[2] = -geom.normal[2];
+        std::swap(geom.g1, geom.g2);
+        std::swap(geom.side1, geom.side2);
+      }
+    }
+  }
+  else
+  {
+    numc = dCollide(geom1, geom2, MAX_COLLIDE_RETURNS, _contactCollisions,
+        sizeof(_contactCollisions[0]));
+
+    if (entry)
+    {
+      entry->geom1 = geom1;
+      ContactCacheGeomStore(geom1, entry->pos[0], entry->rot[0],
+          entry->aabb[0]);
+      ContactCacheGeomStore(geom2, entry->pos[1], entry->rot[1],
+          entry->aabb[1]);
+      entry->geoms.assign(_contactCollisions, _contactCollisions + numc);
+      entry->valid = true;
+    }
+  }
 
   // Return if no contacts.
   if (numc == 0)
-    return;
+    return false;
 
   // Store the indices of the contacts.
   for (int i = 0; i < MAX_CONTACT_JOINTS; i++)
-    this->dataPtr->indices[i] = i;
+    indices[i] = i;
 
   // Choose only the best contacts if too many were generated.
   if (maxCollide > 0 && numc > maxCollide)
@@ -1088,7 +1607,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
       if (_contactCollisions[i].depth > max)
       {
         max = _contactCollisions[i].depth;
-        this->dataPtr->indices[maxCollide-1] = i;
+        indices[maxCollide-1] = i;
       }
     }
 
@@ -1209,7 +1728,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
       {
         // Copy the contact normal
         dReal *contactNormal =
-          _contactCollisions[this->dataPtr->indices[c]].normal;
+          _contactCollisions[indices[c]].normal;
         contactNormalCopy.Set(
           contactNormal[0], contactNormal[1], contactNormal[2]);
 
@@ -1239,7 +1758,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
 
         // Construct displacement vector from wheel center to contact point
         dReal *contactPosition =
-          _contactCollisions[this->dataPtr->indices[c]].pos;
+          _contactCollisions[indices[c]].pos;
         contactPositionCopy.Set(contactPosition[0] - wheelPosition[0],
                                 contactPosition[1] - wheelPosition[1],
                                 contactPosition[2] - wheelPosition[2]);
@@ -1351,6 +1870,21 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     std::min(surf1->bounceThreshold,
              surf2->bounceThreshold);
 
+  // Keep the selected contacts
+  for (unsigned int j = 0; j < numc; ++j)
+    _pair.geoms.push_back(_contactCollisions[indices[j]]);
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::AddContactJoints(const ODECollidePair &_pair)
+{
+  ODECollision *_collision1 = _pair.collision1;
+  ODECollision *_collision2 = _pair.collision2;
+  const unsigned int numc = _pair.geoms.size();
+  dContact contact = _pair.contact;
+
   // Get the ODE body IDs
   dBodyID b1 = dGeomGetBody(_collision1->GetCollisionId());
   dBodyID b2 = dGeomGetBody(_collision2->GetCollisionId());
@@ -1383,7 +1917,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   // Create a joint for each contact
   for (unsigned int j = 0; j < numc; ++j)
   {
-    contact.geom = _contactCollisions[this->dataPtr->indices[j]];
+    contact.geom = _pair.geoms[j];
 
     // Create the contact joint. This introduces the contact constraint to
     // ODE
@@ -1394,20 +1928,19 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     if (contactFeedback && jointFeedback)
     {
       // Store the contact depth
-      contactFeedback->depths[j] =
-        _contactCollisions[this->dataPtr->indices[j]].depth;
+      contactFeedback->depths[j] = _pair.geoms[j].depth;
 
       // Store the contact position
       contactFeedback->positions[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].pos[0],
-          _contactCollisions[this->dataPtr->indices[j]].pos[1],
-          _contactCollisions[this->dataPtr->indices[j]].pos[2]);
+          _pair.geoms[j].pos[0],
+          _pair.geoms[j].pos[1],
+          _pair.geoms[j].pos[2]);
 
       // Store the contact normal
       contactFeedback->normals[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].normal[0],
-          _contactCollisions[this->dataPtr->indices[j]].normal[1],
-          _contactCollisions[this->dataPtr->indices[j]].normal[2]);
+          _pair.geoms[j].normal[0],
+          _pair.geoms[j].normal[1],
+          _pair.geoms[j].normal[2]);
 
       // Set the joint feedback.
       dJointSetFeedback(contactJoint, &(jointFeedback->feedbacks[j]));
@@ -1424,6 +1957,144 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   }
 }
 
+/////////////////////////////////////////////////
+void ODEPhysics::CollideParallel()
+{
+  const unsigned int pairCount = this->dataPtr->collidersCount +
+    this->dataPtr->trimeshCollidersCount;
+
+  if (this->dataPtr->collidePairs.size() < pairCount)
+    this->dataPtr->collidePairs.resize(pairCount);
+
+  // Non-trimesh pairs come first, followed by trimesh pairs. This is the
+  // same order used by the serial narrow phase.
+  for (unsigned int i = 0; i < this->dataPtr->collidersCount; ++i)
+  {
+    this->dataPtr->collidePairs[i].collision1 =
+      this->dataPtr->colliders[i].first;
+    this->dataPtr->collidePairs[i].collision2 =
+      this->dataPtr->colliders[i].second;
+  }
+  for (unsigned int i = 0; i < this->dataPtr->trimeshCollidersCount; ++i)
+  {
+    ODECollidePair &pair =
+      this->dataPtr->collidePairs[this->dataPtr->collidersCount + i];
+    pair.collision1 = this->dataPtr->trimeshColliders[i].first;
+    pair.collision2 = this->dataPtr->trimeshColliders[i].second;
+  }
+
+  // Cache entries are looked up here, since the cache can't be modified
+  // concurrently.
+  for (unsigned int i = 0; i < pairCount; ++i)
+  {
+    ODECollidePair &pair = this->dataPtr->collidePairs[i];
+    pair.cacheEntry = ContactCacheEntry(*this->dataPtr, pair.collision1,
+        pair.collision2);
+  }
+
+  // Trimeshes and heightfields keep collision caches inside the geom, so
+  // pairs that share one of these geoms must not run concurrently. Group
+  // them into chains with a union-find keyed on the stateful geoms.
+  std::vector<unsigned int> &chainPairs = this->dataPtr->collideChainPairs;
+  std::vector<unsigned int> &chainStarts = this->dataPtr->collideChainStarts;
+  chainPairs.clear();
+  chainStarts.clear();
+
+  std::unordered_map<dGeomID, unsigned int> geomChain;
+  std::vector<int> parent;
+  std::vector<unsigned int> chainOf(pairCount);
+
+  std::function<int(int)> findRoot = [&](int _i)
+  {
+    while (parent[_i] != _i)
+    {
+      parent[_i] = parent[parent[_i]];
+      _i = parent[_i];
+    }
+    return _i;
+  };
+
+  for (unsigned int i = 0; i < pairCount; ++i)
+  {
+    const ODECollidePair &pair = this->dataPtr->collidePairs[i];
+    int chain = -1;
+    for (dGeomID geom : {pair.collision1->GetCollisionId(),
+                         pair.collision2->GetCollisionId()})
+    {
+      const int geomClass = dGeomGetClass(geom);
+      if (geomClass != dTriMeshClass && geomClass != dHeightfieldClass)
+        continue;
+
+      auto iter = geomChain.find(geom);
+      if (iter == geomChain.end())
+      {
+        if (chain < 0)
+        {
+          chain = static_cast<int>(parent.size());
+          parent.push_back(chain);
+        }
+        geomChain[geom] = chain;
+      }
+      else if (chain < 0)
+      {
+        chain = findRoot(iter->second);
+      }
+      else
+      {
+        // This pair joins two existing chains.
+        const int other = findRoot(iter->second);
+        if (other != chain)
+        {
+          parent[std::max(other, chain)] = std::min(other, chain);
+          chain = std::min(other, chain);
+        }
+      }
+    }
+
+    // Stateless pairs get a chain of their own.
+    if (chain < 0)
+    {
+      chain = static_cast<int>(parent.size());
+      parent.push_back(chain);
+    }
+    chainOf[i] = chain;
+  }
+
+  // Build the chains in compressed row form, keeping the pairs of each
+  // chain in their original order.
+  const unsigned int chainCount = parent.size();
+  std::vector<unsigned int> counts(chainCount + 1, 0);
+  for (unsigned int i = 0; i < pairCount; ++i)
+  {
+    chainOf[i] = findRoot(chainOf[i]);
+    counts[chainOf[i] + 1]++;
+  }
+  for (unsigned int c = 0; c < chainCount; ++c)
+    counts[c + 1] += counts[c];
+
+  chainStarts.assign(counts.begin(), counts.end());
+  chainPairs.resize(pairCount);
+  for (unsigned int i = 0; i < pairCount; ++i)
+    chainPairs[counts[chainOf[i]]++] = i;
+
+  // Run the narrow phase. Empty chains are left by merged roots and cost
+  // nothing.
+  CollideChains_TBB collide(this, &this->dataPtr->collidePairs,
+      &chainPairs, &chainStarts);
+  this->dataPtr->collisionArena->execute([&]
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, chainCount), collide);
+  });
+
+  // Create contact joints in the same order as the serial narrow phase.
+  for (unsigned int i = 0; i < pairCount; ++i)
+  {
+    ContactCacheCount(*this->dataPtr, this->dataPtr->collidePairs[i]);
+    if (!this->dataPtr->collidePairs[i].geoms.empty())
+      this->AddContactJoints(this->dataPtr->collidePairs[i]);
+  }
+}
+
 /////////////////////////////////////////////////
 void ODEPhysics::AddTrimeshCollider(ODECollision *_collision1,
                                     ODECollision *_collision2)
@@ -1510,6 +2181,83 @@ void ODEPhysics::SetSeed(uint32_t _seed)
   dRandSetSeed(_seed);
 }
 
+//////////////////////////////////////////////////
+void ODEPhysics::SaveSnapshot(Snapshot &_snapshot) const
+{
+  // The quickstep solver shuffles the constraints with this generator
+  _snapshot.Write(dRandGetSeed());
+
+  // The order of the geoms is the order of the contacts
+  const uint32_t size = dSpaceGetStateSize(this->dataPtr->spaceId);
+  _snapshot.Write(size);
+  dSpaceSaveState(this->dataPtr->spaceId, _snapshot.Allocate(size));
+
+  // The contacts of the next step are warm started from these impulses
+  const uint32_t warmStartSize =
+      dWorldGetContactWarmStartStateSize(this->dataPtr->worldId);
+  _snapshot.Write(warmStartSize);
+  dWorldSaveContactWarmStartState(this->dataPtr->worldId,
+      _snapshot.Allocate(warmStartSize));
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::CheckSnapshot(const Snapshot &_snapshot,
+    size_t &_offset) const
+{
+  unsigned long seed;
+  uint32_t size;
+  if (!_snapshot.Read(_offset, seed) || !_snapshot.Read(_offset, size))
+    return false;
+
+  const void *state = _snapshot.Data(_offset, size);
+  if (!state || size != dSpaceGetStateSize(this->dataPtr->spaceId) ||
+      !dSpaceCheckState(this->dataPtr->spaceId, state, size))
+  {
+    return false;
+  }
+
+  uint32_t warmStartSize;
+  if (!_snapshot.Read(_offset, warmStartSize))
+    return false;
+
+  const void *warmStarts = _snapshot.Data(_offset, warmStartSize);
+  return warmStarts && dWorldCheckContactWarmStartState(
+      this->dataPtr->worldId, this->dataPtr->spaceId, warmStarts,
+      warmStartSize);
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::RestoreSnapshot(const Snapshot &_snapshot, size_t &_offset)
+{
+  unsigned long seed;
+  uint32_t size;
+  if (!_snapshot.Read(_offset, seed) || !_snapshot.Read(_offset, size))
+    return false;
+
+  // Restoring the links moved their geoms, put them back in order
+  const void *state = _snapshot.Data(_offset, size);
+  if (!state || size != dSpaceGetStateSize(this->dataPtr->spaceId) ||
+      !dSpaceRestoreState(this->dataPtr->spaceId, state))
+  {
+    return false;
+  }
+
+  uint32_t warmStartSize;
+  if (!_snapshot.Read(_offset, warmStartSize))
+    return false;
+
+  const void *warmStarts = _snapshot.Data(_offset, warmStartSize);
+  if (!warmStarts || !dWorldRestoreContactWarmStartState(
+      this->dataPtr->worldId, this->dataPtr->spaceId, warmStarts,
+      warmStartSize))
+  {
+    return false;
+  }
+
+  dRandSetSeed(seed);
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
 {
@@ -1629,6 +2377,11 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
       dWorldSetQuickStepWarmStartFactor(this->dataPtr->worldId,
         any_cast<double>(_value));
     }
+    else if (_key == "contact_warm_start_distance")
+    {
+      dWorldSetQuickStepContactWarmStartDistance(this->dataPtr->worldId,
+        any_cast<double>(_value));
+    }
     else if (_key == "extra_friction_iterations")
     {
       dWorldSetQuickStepExtraFrictionIterations(this->dataPtr->worldId,
@@ -1648,6 +2401,181 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
       }
       dWorldSetIslandThreads(this->dataPtr->worldId, value);
     }
+    else if (_key == "collision_threads")
+    {
+      int value;
+      try
+      {
+        value = any_cast<int>(_value);
+      }
+      catch(const boost::bad_any_cast &)
+      {
+        // Encoded as a string when set from an SDFormat world file.
+        sdf::Param strParam("key", "string", "0", false, "description");
+        strParam.Set(any_cast<std::string>(_value));
+        if (!strParam.Get<int>(value))
+        {
+          gzerr << "Unable to parse collision_threads value\n";
+          return false;
+        }
+      }
+
+      if (value < 0)
+      {
+        gzerr << "collision_threads must be non-negative\n";
+        return false;
+      }
+
+      this->dataPtr->collisionThreads = value;
+      if (value > 0)
+      {
+        this->dataPtr->collisionArena.reset(new tbb::task_arena(value));
+      }
+      else
+      {
+        this->dataPtr->collisionArena.reset();
+      }
+    }
+    else if (_key == "broadphase")
+    {
+      const std::string value = any_cast<std::string>(_value);
+      if (value != "hash" && value != "sap" && value != "quadtree" &&
+          value != "bvh")
+      {
+        gzerr << "Invalid broadphase [" << value
+              << "], must be hash, sap, quadtree or bvh\n";
+        return false;
+      }
+
+      if (value != this->dataPtr->broadphase)
+      {
+        this->dataPtr->broadphase = value;
+        this->dataPtr->broadphaseAutoCount = -1;
+        return this->RebuildBroadphase();
+      }
+    }
+    else if (_key == "hash_min_level" || _key == "hash_max_level")
+    {
+      int value;
+      if (!ParamValue<int>(_value, "int", value))
+      {
+        gzerr << "Unable to parse " << _key << " value\n";
+        return false;
+      }
+
+      int minLevel = this->dataPtr->hashMinLevel;
+      int maxLevel = this->dataPtr->hashMaxLevel;
+      if (_key == "hash_min_level")
+        minLevel = value;
+      else
+        maxLevel = value;
+      if (minLevel > maxLevel)
+      {
+        gzerr << "hash_min_level [" << minLevel
+              << "] must not be greater than hash_max_level [" << maxLevel
+              << "]\n";
+        return false;
+      }
+
+      this->dataPtr->hashMinLevel = minLevel;
+      this->dataPtr->hashMaxLevel = maxLevel;
+      if (this->dataPtr->broadphase == "hash")
+      {
+        boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+        dHashSpaceSetLevels(this->dataPtr->spaceId, minLevel, maxLevel);
+      }
+    }
+    else if (_key == "sap_axis_order")
+    {
+      const std::string value = any_cast<std::string>(_value);
+      std::string axes = value;
+      std::sort(axes.begin(), axes.end());
+      if (axes != "xyz")
+      {
+        gzerr << "Invalid sap_axis_order [" << value
+              << "], must be a permutation of xyz\n";
+        return false;
+      }
+
+      this->dataPtr->sapAxisOrder = value;
+      if (this->dataPtr->broadphase == "sap")
+        return this->RebuildBroadphase();
+    }
+    else if (_key == "quadtree_depth")
+    {
+      int value;
+      if (!ParamValue<int>(_value, "int", value))
+      {
+        gzerr << "Unable to parse quadtree_depth value\n";
+        return false;
+      }
+
+      // The quadtree allocates 4^depth blocks
+      if (value < 1 || value > 10)
+      {
+        gzerr << "quadtree_depth must be between 1 and 10\n";
+        return false;
+      }
+
+      this->dataPtr->quadtreeDepth = value;
+      if (this->dataPtr->broadphase == "quadtree")
+        return this->RebuildBroadphase();
+    }
+    else if (_key == "bvh_margin")
+    {
+      double value;
+      if (!ParamValue<double>(_value, "double", value))
+      {
+        gzerr << "Unable to parse bvh_margin value\n";
+        return false;
+      }
+
+      if (value < 0)
+      {
+        gzerr << "bvh_margin must be non-negative\n";
+        return false;
+      }
+
+      // Applies to geoms as they are inserted into the tree
+      this->dataPtr->bvhMargin = value;
+      if (this->dataPtr->broadphase == "bvh")
+      {
+        boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+        dBVHSpaceSetMargin(this->dataPtr->spaceId, value);
+      }
+    }
+    else if (_key == "contact_cache_tolerance")
+    {
+      double value;
+      if (!ParamValue<double>(_value, "double", value))
+      {
+        gzerr << "Unable to parse contact_cache_tolerance value\n";
+        return false;
+      }
+
+      if (value < 0)
+      {
+        gzerr << "contact_cache_tolerance must be non-negative\n";
+        return false;
+      }
+
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->dataPtr->contactCacheTolerance = value;
+      this->dataPtr->contactCache.clear();
+    }
+    else if (_key == "broadphase_auto")
+    {
+      bool value;
+      if (!ParamValue<bool>(_value, "bool", value))
+      {
+        gzerr << "Unable to parse broadphase_auto value\n";
+        return false;
+      }
+
+      // Parameters are selected on the next collision update
+      this->dataPtr->broadphaseAuto = value;
+      this->dataPtr->broadphaseAutoCount = -1;
+    }
     else if (_key == "ode_quiet")
     {
       bool odeQuiet;
@@ -1767,12 +2695,41 @@ bool ODEPhysics::GetParam(const std::string &_key, boost::any &_value) const
   }
   else if (_key == "warm_start_factor")
     _value = dWorldGetQuickStepWarmStartFactor(this->dataPtr->worldId);
+  else if (_key == "contact_warm_start_distance")
+  {
+    _value = dWorldGetQuickStepContactWarmStartDistance(
+        this->dataPtr->worldId);
+  }
+  else if (_key == "iteration_count")
+    _value = dWorldGetQuickStepIterationCount(this->dataPtr->worldId);
   else if (_key == "extra_friction_iterations")
     _value = dWorldGetQuickStepExtraFrictionIterations(this->dataPtr->worldId);
   else if (_key == "friction_model")
     _value = this->GetFrictionModel();
   else if (_key == "island_threads")
     _value = dWorldGetIslandThreads(this->dataPtr->worldId);
+  else if (_key == "collision_threads")
+    _value = this->dataPtr->collisionThreads;
+  else if (_key == "broadphase")
+    _value = this->dataPtr->broadphase;
+  else if (_key == "hash_min_level")
+    _value = this->dataPtr->hashMinLevel;
+  else if (_key == "hash_max_level")
+    _value = this->dataPtr->hashMaxLevel;
+  else if (_key == "sap_axis_order")
+    _value = this->dataPtr->sapAxisOrder;
+  else if (_key == "quadtree_depth")
+    _value = this->dataPtr->quadtreeDepth;
+  else if (_key == "bvh_margin")
+    _value = this->dataPtr->bvhMargin;
+  else if (_key == "broadphase_auto")
+    _value = this->dataPtr->broadphaseAuto;
+  else if (_key == "contact_cache_tolerance")
+    _value = this->dataPtr->contactCacheTolerance;
+  else if (_key == "contact_cache_hits")
+    _value = this->dataPtr->contactCacheHits;
+  else if (_key == "contact_cache_misses")
+    _value = this->dataPtr->contactCacheMisses;
   else if (_key == "ode_quiet")
     _value = dGetMessageHandler() != 0;
   else if (_key == "world_step_solver")
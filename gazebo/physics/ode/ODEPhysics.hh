@@ -36,6 +36,7 @@ namespace gazebo
 {
   namespace physics
   {
+    class ODECollidePair;
     class ODEJointFeedback;
     class ODEPhysicsPrivate;
 
@@ -213,6 +214,31 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetSeed(uint32_t _seed);
 
+      /// \brief Append the state of the engine that isn't held by the
+      /// links and joints to a snapshot: the dRand seed, the geom order of
+      /// the collision spaces and the contact warm starts. It's saved and
+      /// restored after the links and joints.
+      /// \param[in,out] _snapshot Snapshot being saved.
+      /// \sa World::SaveSnapshot
+      public: void SaveSnapshot(Snapshot &_snapshot) const;
+
+      /// \brief Check the state saved by SaveSnapshot without restoring
+      /// it.
+      /// \param[in] _snapshot Snapshot being restored.
+      /// \param[in,out] _offset Position of the state of the engine in
+      /// the snapshot, moved past it.
+      /// \return False if RestoreSnapshot would fail.
+      public: bool CheckSnapshot(const Snapshot &_snapshot,
+                  size_t &_offset) const;
+
+      /// \brief Restore the state saved by SaveSnapshot.
+      /// \param[in] _snapshot Snapshot being restored.
+      /// \param[in,out] _offset Position of the state of the engine in
+      /// the snapshot, moved past it.
+      /// \return False if the snapshot is too short.
+      public: bool RestoreSnapshot(const Snapshot &_snapshot,
+                  size_t &_offset);
+
       /// Documentation inherited
       public: virtual bool SetParam(const std::string &_key,
                   const boost::any &_value);
@@ -224,6 +250,13 @@ namespace gazebo
       public: virtual bool GetParam(const std::string &_key,
                   boost::any &_value) const;
 
+      /// \brief Get the collision space for the links of a model.
+      /// \param[in] _model Model of the links.
+      /// \param[in] _static True to get the space shared by all the static
+      /// links.
+      /// \return The space. The space of the model is created if needed.
+      public: dSpaceID LinkSpaceId(ModelPtr _model, const bool _static);
+
       /// \brief Return the world space id.
       /// \return The space id for the world.
       public: dSpaceID GetSpaceId() const;
@@ -287,6 +320,27 @@ namespace gazebo
       public: void Collide(ODECollision *_collision1, ODECollision *_collision2,
                            dContactGeom *_contactCollisions);
 
+      /// \brief Run the narrow phase for two collision objects, without
+      /// creating any contact joints. This function does not modify the
+      /// ODE world or the contact manager, so it can be called
+      /// concurrently for pairs that don't share a triangle mesh or
+      /// heightfield geom.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[in,out] _contactCollisions Scratch array of at least
+      /// MAX_COLLIDE_RETURNS contacts.
+      /// \param[out] _pair Contacts and surface parameters of the pair.
+      /// \return True if contacts were generated.
+      public: bool CollideNarrowPhase(ODECollision *_collision1,
+                  ODECollision *_collision2, dContactGeom *_contactCollisions,
+                  ODECollidePair &_pair);
+
+      /// \brief Create contact joints and contact feedback for a pair that
+      /// went through CollideNarrowPhase. Must be called from the physics
+      /// thread.
+      /// \param[in] _pair Result of CollideNarrowPhase.
+      public: void AddContactJoints(const ODECollidePair &_pair);
+
       /// \brief process joint feedbacks.
       /// \param[in] _feedback ODE Joint Contact feedback information.
       public: void ProcessJointFeedback(ODEJointFeedback *_feedback);
@@ -315,6 +369,21 @@ namespace gazebo
       private: void AddCollider(ODECollision *_collision1,
                                 ODECollision *_collision2);
 
+      /// \brief Run the narrow phase of all colliders on the collision
+      /// thread pool, then create the contact joints in the same order
+      /// as the sequential path.
+      private: void CollideParallel();
+
+      /// \brief Create a top-level space of the current broadphase type,
+      /// and move all geoms of the current top-level space into it.
+      /// \return True if the space was created.
+      private: bool RebuildBroadphase();
+
+      /// \brief Select the broadphase parameters from the extents of the
+      /// geoms in the scene: hash levels, quadtree depth and sweep and
+      /// prune axis order.
+      private: void TuneBroadphase();
+
       /// \internal
       /// \brief Private data pointer.
       private: ODEPhysicsPrivate *dataPtr;
@@ -18,8 +18,14 @@
 #ifndef _ODEPHYSICS_PRIVATE_HH_
 #define _ODEPHYSICS_PRIVATE_HH_
 
+#include <tbb/task_arena.h>
+
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
@@ -45,6 +51,74 @@ namespace gazebo
       public: dJointFeedback feedbacks[MAX_CONTACT_JOINTS];
     };
 
+    /// \brief Contacts generated by dCollide for a pair of geoms, reused
+    /// in later steps while neither geom moves by more than the contact
+    /// cache tolerance.
+    class ODEContactCacheEntry
+    {
+      /// \brief Geom passed first to dCollide when the contacts were
+      /// generated. The contacts are mirrored when the pair is collided
+      /// in the other order.
+      public: dGeomID geom1 = nullptr;
+
+      /// \brief Positions of the two geoms.
+      public: dVector3 pos[2];
+
+      /// \brief Orientations of the two geoms.
+      public: dQuaternion rot[2];
+
+      /// \brief Axis aligned bounding boxes of the two geoms. They catch
+      /// geoms that are resized, or recreated at the same address.
+      public: dReal aabb[2][6];
+
+      /// \brief Contacts returned by dCollide, before the best contacts
+      /// are selected and the surface parameters are applied.
+      public: std::vector<dContactGeom> geoms;
+
+      /// \brief Last step in which the pair was collided. Entries that
+      /// are not collided in a step are removed.
+      public: uint64_t step = 0;
+
+      /// \brief True once the contacts have been generated.
+      public: bool valid = false;
+    };
+
+    /// \brief Hash of an ordered pair of geoms.
+    struct ODEGeomPairHash
+    {
+      size_t operator()(const std::pair<dGeomID, dGeomID> &_pair) const
+      {
+        const std::hash<dGeomID> hash;
+        return hash(_pair.first) ^ (hash(_pair.second) * 31);
+      }
+    };
+
+    /// \brief Result of the narrow phase for one pair of collisions.
+    /// Contact joints are created from it once all pairs have been
+    /// collided, see ODEPhysics::CollideNarrowPhase.
+    class ODECollidePair
+    {
+      /// \brief First collision.
+      public: ODECollision *collision1 = nullptr;
+
+      /// \brief Second collision.
+      public: ODECollision *collision2 = nullptr;
+
+      /// \brief Contact surface parameters shared by all the contacts.
+      public: dContact contact;
+
+      /// \brief Selected contact geometry, at most MAX_CONTACT_JOINTS.
+      /// The capacity is kept between steps to avoid allocations.
+      public: std::vector<dContactGeom> geoms;
+
+      /// \brief Contact cache entry of the pair, null if the contact cache
+      /// is disabled.
+      public: ODEContactCacheEntry *cacheEntry = nullptr;
+
+      /// \brief True if the contacts were taken from cacheEntry.
+      public: bool cacheHit = false;
+    };
+
     class ODEPhysicsPrivate
     {
       /// \brief Top-level world for all bodies
@@ -53,6 +127,38 @@ namespace gazebo
       /// \brief Top-level space for all sub-spaces/collisions
       public: dSpaceID spaceId;
 
+      /// \brief Space holding the collisions of all static models. It is a
+      /// child of the top-level space, and its tree is only updated when a
+      /// static collision is added, removed or moved.
+      public: dSpaceID staticSpaceId = nullptr;
+
+      /// \brief Type of the top-level space: hash, sap, quadtree or bvh.
+      public: std::string broadphase = "hash";
+
+      /// \brief Smallest cell size of the hash space, as a power of two.
+      public: int hashMinLevel = -2;
+
+      /// \brief Largest cell size of the hash space, as a power of two.
+      public: int hashMaxLevel = 8;
+
+      /// \brief Axis order of the sweep and prune space, such as "xyz".
+      public: std::string sapAxisOrder = "xyz";
+
+      /// \brief Depth of the quadtree space.
+      public: int quadtreeDepth = 6;
+
+      /// \brief Margin by which the bounding boxes of the bvh space are
+      /// inflated, so that small motions don't update the tree.
+      public: double bvhMargin = 0.05;
+
+      /// \brief True to select the broadphase parameters from the extents
+      /// of the scene.
+      public: bool broadphaseAuto = false;
+
+      /// \brief Number of geoms when the broadphase parameters were last
+      /// selected automatically. Negative if never selected.
+      public: int broadphaseAutoCount = -1;
+
       /// \brief Collision attributes
       public: dJointGroupID contactGroup;
 
@@ -78,8 +184,47 @@ namespace gazebo
       /// \brief Array of contact collisions.
       public: dContactGeom contactCollisions[MAX_COLLIDE_RETURNS];
 
-      /// \brief Indices used during creation of contact joints.
-      public: int indices[MAX_CONTACT_JOINTS];
+      /// \brief Narrow phase result used by the sequential path.
+      public: ODECollidePair collidePair;
+
+      /// \brief Number of threads used for the narrow phase. Zero runs the
+      /// narrow phase sequentially on the physics thread.
+      public: int collisionThreads = 0;
+
+      /// \brief Task arena limiting the narrow phase to collisionThreads.
+      public: std::unique_ptr<tbb::task_arena> collisionArena;
+
+      /// \brief Narrow phase results of the parallel path, one per
+      /// collider followed by one per trimesh collider.
+      public: std::vector<ODECollidePair> collidePairs;
+
+      /// \brief Pair indices grouped into chains that must be collided in
+      /// order by a single task, stored contiguously.
+      public: std::vector<unsigned int> collideChainPairs;
+
+      /// \brief Offset of each chain in collideChainPairs, followed by the
+      /// total number of pairs.
+      public: std::vector<unsigned int> collideChainStarts;
+
+      /// \brief Largest motion of a geom, in meters or radians, for which
+      /// the contacts of its pairs are reused. Zero disables the cache.
+      public: double contactCacheTolerance = 0.0;
+
+      /// \brief Contact cache, keyed by the geoms of each pair with the
+      /// smaller address first.
+      public: std::unordered_map<std::pair<dGeomID, dGeomID>,
+              ODEContactCacheEntry, ODEGeomPairHash> contactCache;
+
+      /// \brief Number of collision steps, used to expire cache entries.
+      public: uint64_t contactCacheStep = 0;
+
+      /// \brief Number of pairs whose contacts were reused in the last
+      /// step.
+      public: int contactCacheHits = 0;
+
+      /// \brief Number of pairs whose contacts were generated in the last
+      /// step while the cache was enabled.
+      public: int contactCacheMisses = 0;
 
       /// \brief Current index into the contactFeedbacks buffer
       public: unsigned int jointFeedbackIndex;
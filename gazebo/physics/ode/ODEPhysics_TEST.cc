@@ -17,8 +17,16 @@
 
 #include <gtest/gtest.h>
 
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "gazebo/physics/physics.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/Snapshot.hh"
+#include "gazebo/physics/ode/ODECollision.hh"
+#include "gazebo/physics/ode/ODELink.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODETypes.hh"
 #include "gazebo/test/ServerFixture.hh"
@@ -67,6 +75,7 @@ TEST_F(ODEPhysics_TEST, PhysicsParam)
   bool threadPositionCorrection = true;
   bool experimentalRowReordering = true;
   double warmStartFactor = 1.0;
+  double contactWarmStartDistance = 0.01;
   int extraFrictionIterations = 15;
 
   // test setting/getting physics engine params
@@ -90,6 +99,8 @@ TEST_F(ODEPhysics_TEST, PhysicsParam)
                                     experimentalRowReordering));
   EXPECT_TRUE(odePhysics->SetParam("warm_start_factor",
                                     warmStartFactor));
+  EXPECT_TRUE(odePhysics->SetParam("contact_warm_start_distance",
+                                    contactWarmStartDistance));
   EXPECT_TRUE(odePhysics->SetParam("extra_friction_iterations",
                                     extraFrictionIterations));
 
@@ -133,9 +144,14 @@ TEST_F(ODEPhysics_TEST, PhysicsParam)
   value = odePhysics->GetParam("warm_start_factor");
   double warmStartFactorRet = boost::any_cast<double>(value);
   EXPECT_DOUBLE_EQ(warmStartFactor, warmStartFactorRet);
+  value = odePhysics->GetParam("contact_warm_start_distance");
+  double contactWarmStartDistanceRet = boost::any_cast<double>(value);
+  EXPECT_DOUBLE_EQ(contactWarmStartDistance, contactWarmStartDistanceRet);
   value = odePhysics->GetParam("extra_friction_iterations");
   int extraFrictionIterationsRet = boost::any_cast<int>(value);
   EXPECT_EQ(extraFrictionIterations, extraFrictionIterationsRet);
+  value = odePhysics->GetParam("iteration_count");
+  EXPECT_NO_THROW(boost::any_cast<int>(value));
 
   // verify against equivalent functions
   EXPECT_EQ(type, odePhysics->GetStepType());
@@ -320,6 +336,87 @@ TEST_F(ODEPhysics_TEST, PhysicsParam)
     }
   }
 
+  // Test collision_threads
+  {
+    // collision_threads should be 0 by default
+    int collisionThreads = 1;
+    EXPECT_NO_THROW(collisionThreads =
+      boost::any_cast<int>(odePhysics->GetParam("collision_threads")));
+    EXPECT_EQ(collisionThreads, 0);
+
+    // try enabling threads, then disabling
+    std::vector<int> threads = {1, 4, 0};
+    for (auto const collisionThreadsSet : threads)
+    {
+      EXPECT_TRUE(
+          odePhysics->SetParam("collision_threads", collisionThreadsSet));
+      EXPECT_NO_THROW(collisionThreads =
+        boost::any_cast<int>(odePhysics->GetParam("collision_threads")));
+      EXPECT_EQ(collisionThreads, collisionThreadsSet);
+    }
+
+    // string values come from world files
+    EXPECT_TRUE(odePhysics->SetParam("collision_threads", std::string("2")));
+    EXPECT_EQ(boost::any_cast<int>(
+          odePhysics->GetParam("collision_threads")), 2);
+
+    EXPECT_FALSE(odePhysics->SetParam("collision_threads", -1));
+    EXPECT_TRUE(odePhysics->SetParam("collision_threads", 0));
+  }
+
+  // Test broadphase parameters
+  {
+    EXPECT_EQ(boost::any_cast<std::string>(
+          odePhysics->GetParam("broadphase")), "hash");
+    EXPECT_EQ(boost::any_cast<int>(
+          odePhysics->GetParam("hash_min_level")), -2);
+    EXPECT_EQ(boost::any_cast<int>(
+          odePhysics->GetParam("hash_max_level")), 8);
+    EXPECT_FALSE(boost::any_cast<bool>(
+          odePhysics->GetParam("broadphase_auto")));
+
+    // The top-level space is replaced, and keeps its geoms
+    const int geomCount = dSpaceGetNumGeoms(odePhysics->GetSpaceId());
+    for (auto const &broadphase : {"sap", "quadtree", "bvh", "hash"})
+    {
+      EXPECT_TRUE(odePhysics->SetParam("broadphase", std::string(broadphase)));
+      EXPECT_EQ(boost::any_cast<std::string>(
+            odePhysics->GetParam("broadphase")), broadphase);
+      EXPECT_EQ(dSpaceGetNumGeoms(odePhysics->GetSpaceId()), geomCount);
+    }
+    EXPECT_EQ(dSpaceGetClass(odePhysics->GetSpaceId()), dHashSpaceClass);
+    EXPECT_FALSE(odePhysics->SetParam("broadphase", std::string("octree")));
+
+    // string values come from world files
+    EXPECT_TRUE(odePhysics->SetParam("hash_max_level", std::string("10")));
+    EXPECT_TRUE(odePhysics->SetParam("hash_min_level", -4));
+    EXPECT_EQ(boost::any_cast<int>(
+          odePhysics->GetParam("hash_min_level")), -4);
+    EXPECT_EQ(boost::any_cast<int>(
+          odePhysics->GetParam("hash_max_level")), 10);
+    EXPECT_FALSE(odePhysics->SetParam("hash_min_level", 11));
+
+    EXPECT_TRUE(odePhysics->SetParam("sap_axis_order", std::string("zxy")));
+    EXPECT_EQ(boost::any_cast<std::string>(
+          odePhysics->GetParam("sap_axis_order")), "zxy");
+    EXPECT_FALSE(odePhysics->SetParam("sap_axis_order", std::string("xxy")));
+
+    EXPECT_TRUE(odePhysics->SetParam("quadtree_depth", std::string("4")));
+    EXPECT_EQ(boost::any_cast<int>(
+          odePhysics->GetParam("quadtree_depth")), 4);
+    EXPECT_FALSE(odePhysics->SetParam("quadtree_depth", 0));
+
+    EXPECT_TRUE(odePhysics->SetParam("bvh_margin", 0.1));
+    EXPECT_DOUBLE_EQ(boost::any_cast<double>(
+          odePhysics->GetParam("bvh_margin")), 0.1);
+    EXPECT_FALSE(odePhysics->SetParam("bvh_margin", -1.0));
+
+    EXPECT_TRUE(odePhysics->SetParam("broadphase_auto", std::string("true")));
+    EXPECT_TRUE(boost::any_cast<bool>(
+          odePhysics->GetParam("broadphase_auto")));
+    EXPECT_TRUE(odePhysics->SetParam("broadphase_auto", false));
+  }
+
   // Test ode_quiet
   // convenient for disabling LCP internal error messages from world solver
   {
@@ -490,6 +587,291 @@ TEST_F(ODEPhysics_TEST, PhysicsMsgParam)
   PhysicsMsgParam();
 }
 
+/////////////////////////////////////////////////
+/// Test that collisions are found with each broadphase, and that static
+/// models share a space.
+TEST_F(ODEPhysics_TEST, Broadphase)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::static_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  // The ground plane is in the static space, not in a space of its own
+  physics::ModelPtr ground = world->ModelByName("ground_plane");
+  ASSERT_TRUE(ground != nullptr);
+  ODELinkPtr groundLink =
+      boost::static_pointer_cast<ODELink>(ground->GetLink());
+  ASSERT_TRUE(groundLink != nullptr);
+  dSpaceID staticSpace = groundLink->GetSpaceId();
+  EXPECT_EQ(dSpaceGetClass(staticSpace), dBVHSpaceClass);
+  EXPECT_EQ(dGeomGetSpace((dGeomID) staticSpace), odePhysics->GetSpaceId());
+
+  SpawnSphere("sphere", ignition::math::Vector3d(0, 0, 1),
+      ignition::math::Vector3d::Zero);
+  physics::ModelPtr sphere = world->ModelByName("sphere");
+  ASSERT_TRUE(sphere != nullptr);
+
+  for (auto const &broadphase : {"hash", "sap", "quadtree", "bvh"})
+  {
+    EXPECT_TRUE(odePhysics->SetParam("broadphase", std::string(broadphase)));
+    EXPECT_EQ(dGeomGetSpace((dGeomID) staticSpace), odePhysics->GetSpaceId());
+
+    // Drop the sphere, it should rest on the ground
+    sphere->SetWorldPose(ignition::math::Pose3d(0, 0, 1, 0, 0, 0));
+    sphere->ResetPhysicsStates();
+    world->Step(1000);
+    EXPECT_NEAR(sphere->WorldPose().Pos().Z(), 0.5, 0.01) << broadphase;
+  }
+
+  // Automatic parameters from the scene
+  EXPECT_TRUE(odePhysics->SetParam("broadphase", std::string("hash")));
+  EXPECT_TRUE(odePhysics->SetParam("broadphase_auto", true));
+  world->Step(1);
+  EXPECT_LE(boost::any_cast<int>(odePhysics->GetParam("hash_min_level")), 0);
+  EXPECT_GE(boost::any_cast<int>(odePhysics->GetParam("hash_max_level")), 0);
+  world->Step(100);
+  EXPECT_NEAR(sphere->WorldPose().Pos().Z(), 0.5, 0.01);
+}
+
+/////////////////////////////////////////////////
+/// Test that a snapshot restores with each broadphase, including the ones
+/// that don't keep the order of their geoms.
+TEST_F(ODEPhysics_TEST, BroadphaseSnapshot)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::static_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  SpawnSphere("sphere", ignition::math::Vector3d(0, 0, 1),
+      ignition::math::Vector3d::Zero);
+  physics::ModelPtr sphere = world->ModelByName("sphere");
+  ASSERT_TRUE(sphere != nullptr);
+
+  for (auto const &broadphase : {"hash", "sap", "quadtree", "bvh"})
+  {
+    EXPECT_TRUE(odePhysics->SetParam("broadphase", std::string(broadphase)));
+
+    sphere->SetWorldPose(ignition::math::Pose3d(0, 0, 1, 0, 0, 0));
+    sphere->ResetPhysicsStates();
+    world->Step(100);
+
+    physics::Snapshot snapshot;
+    world->SaveSnapshot(snapshot);
+    world->Step(200);
+    const ignition::math::Pose3d pose = sphere->WorldPose();
+
+    EXPECT_TRUE(world->RestoreSnapshot(snapshot)) << broadphase;
+    world->Step(200);
+    EXPECT_EQ(sphere->WorldPose(), pose) << broadphase;
+  }
+}
+
+/////////////////////////////////////////////////
+/// Test broadphase parameters from a world file
+TEST_F(ODEPhysics_TEST, BroadphaseWorld)
+{
+  Load("worlds/ode_broadphase.world", true);
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::static_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  EXPECT_EQ(boost::any_cast<std::string>(odePhysics->GetParam("broadphase")),
+      "bvh");
+  EXPECT_EQ(dSpaceGetClass(odePhysics->GetSpaceId()), dBVHSpaceClass);
+  EXPECT_EQ(boost::any_cast<int>(odePhysics->GetParam("hash_min_level")), 9);
+  EXPECT_EQ(boost::any_cast<int>(odePhysics->GetParam("hash_max_level")), 12);
+  EXPECT_EQ(boost::any_cast<std::string>(
+        odePhysics->GetParam("sap_axis_order")), "zyx");
+  EXPECT_EQ(boost::any_cast<int>(odePhysics->GetParam("quadtree_depth")), 4);
+  EXPECT_DOUBLE_EQ(boost::any_cast<double>(
+        odePhysics->GetParam("bvh_margin")), 0.1);
+  EXPECT_FALSE(boost::any_cast<bool>(
+        odePhysics->GetParam("broadphase_auto")));
+}
+
+/////////////////////////////////////////////////
+/// Test that the collisions of a static model leave the static space when
+/// the model is made dynamic, and return to it.
+TEST_F(ODEPhysics_TEST, BroadphaseStaticChange)
+{
+  Load("worlds/ode_broadphase.world", true);
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::ModelPtr ground = world->ModelByName("ground_plane");
+  ASSERT_TRUE(ground != nullptr);
+  dSpaceID staticSpace =
+      boost::static_pointer_cast<ODELink>(ground->GetLink())->GetSpaceId();
+
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  ODELinkPtr link = boost::static_pointer_cast<ODELink>(box->GetLink());
+  ASSERT_TRUE(link != nullptr);
+  ODECollisionPtr collision = boost::static_pointer_cast<ODECollision>(
+      link->GetCollision("collision"));
+  ASSERT_TRUE(collision != nullptr);
+  dGeomID geom = collision->GetCollisionId();
+  EXPECT_EQ(link->GetSpaceId(), staticSpace);
+  EXPECT_EQ(dGeomGetSpace(geom), staticSpace);
+
+  msgs::Model msg;
+  msg.set_name(box->GetScopedName());
+  msg.set_is_static(false);
+  box->ProcessMsg(msg);
+  EXPECT_FALSE(link->IsStatic());
+  EXPECT_NE(link->GetSpaceId(), staticSpace);
+  EXPECT_EQ(dSpaceGetClass(link->GetSpaceId()), dSimpleSpaceClass);
+  EXPECT_EQ(collision->GetSpaceId(), link->GetSpaceId());
+  EXPECT_EQ(dGeomGetSpace(geom), link->GetSpaceId());
+  EXPECT_EQ(dGeomGetCollideBits(geom),
+      static_cast<unsigned int>(GZ_ALL_COLLIDE));
+
+  msg.set_is_static(true);
+  box->ProcessMsg(msg);
+  EXPECT_EQ(link->GetSpaceId(), staticSpace);
+  EXPECT_EQ(dGeomGetSpace(geom), staticSpace);
+  EXPECT_EQ(dGeomGetCategoryBits(geom),
+      static_cast<unsigned int>(GZ_FIXED_COLLIDE));
+}
+
+/////////////////////////////////////////////////
+/// Test that the contacts of a resting pair are reused, and that the pair
+/// keeps resting with the cache enabled.
+TEST_F(ODEPhysics_TEST, ContactCache)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::static_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  // Disabled by default
+  EXPECT_DOUBLE_EQ(boost::any_cast<double>(
+        odePhysics->GetParam("contact_cache_tolerance")), 0.0);
+  EXPECT_FALSE(odePhysics->SetParam("contact_cache_tolerance", -1.0));
+
+  SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5));
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  box->SetAutoDisable(false);
+
+  world->Step(500);
+  EXPECT_EQ(boost::any_cast<int>(odePhysics->GetParam("contact_cache_hits")),
+      0);
+  EXPECT_EQ(boost::any_cast<int>(
+        odePhysics->GetParam("contact_cache_misses")), 0);
+
+  for (const int threads : {0, 2})
+  {
+    EXPECT_TRUE(odePhysics->SetParam("collision_threads", threads));
+    EXPECT_TRUE(odePhysics->SetParam("contact_cache_tolerance", 1e-4));
+    EXPECT_DOUBLE_EQ(boost::any_cast<double>(
+          odePhysics->GetParam("contact_cache_tolerance")), 1e-4);
+
+    // The first step generates the contacts
+    world->Step(1);
+    EXPECT_EQ(boost::any_cast<int>(
+          odePhysics->GetParam("contact_cache_hits")), 0);
+    EXPECT_EQ(boost::any_cast<int>(
+          odePhysics->GetParam("contact_cache_misses")), 1);
+
+    // The resting box reuses them
+    int hits = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+      world->Step(1);
+      hits += boost::any_cast<int>(odePhysics->GetParam("contact_cache_hits"));
+    }
+    EXPECT_GT(hits, 50) << threads;
+    EXPECT_NEAR(box->WorldPose().Pos().Z(), 0.5, 0.01) << threads;
+
+    // Lifting the box drops its contacts
+    box->SetWorldPose(ignition::math::Pose3d(0, 0, 0.6, 0, 0, 0));
+    box->ResetPhysicsStates();
+    world->Step(1);
+    EXPECT_EQ(boost::any_cast<int>(
+          odePhysics->GetParam("contact_cache_hits")), 0);
+    world->Step(500);
+    EXPECT_NEAR(box->WorldPose().Pos().Z(), 0.5, 0.01) << threads;
+
+    EXPECT_TRUE(odePhysics->SetParam("contact_cache_tolerance", 0.0));
+  }
+}
+
+/////////////////////////////////////////////////
+/// Test that the parallel narrow phase generates the same contacts and
+/// poses as the sequential one.
+TEST_F(ODEPhysics_TEST, CollisionThreads)
+{
+  Load("worlds/ode_collision_threads.world", true);
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::static_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  // Set from the world file
+  EXPECT_EQ(boost::any_cast<int>(
+        odePhysics->GetParam("collision_threads")), 2);
+
+  ContactManager *contactManager = odePhysics->GetContactManager();
+  ASSERT_TRUE(contactManager != nullptr);
+  contactManager->SetNeverDropContacts(true);
+
+  physics::Snapshot snapshot;
+  world->SaveSnapshot(snapshot);
+
+  const std::vector<int> threads = {0, 2, 4};
+  std::map<int, std::vector<std::string>> contacts;
+  std::map<int, std::vector<ignition::math::Pose3d>> poses;
+  for (const int collisionThreads : threads)
+  {
+    EXPECT_TRUE(odePhysics->SetParam("collision_threads", collisionThreads));
+    EXPECT_TRUE(world->RestoreSnapshot(snapshot)) << collisionThreads;
+    odePhysics->SetSeed(1234);
+
+    for (int i = 0; i < 200; ++i)
+    {
+      world->Step(1);
+      for (unsigned int j = 0; j < contactManager->GetContactCount(); ++j)
+      {
+        const Contact *contact = contactManager->GetContacts()[j];
+        std::ostringstream stream;
+        stream << i << " " << contact->collision1->GetScopedName() << " "
+            << contact->collision2->GetScopedName() << " " << contact->count;
+        for (int k = 0; k < contact->count; ++k)
+          stream << " " << contact->positions[k];
+        contacts[collisionThreads].push_back(stream.str());
+      }
+    }
+    EXPECT_FALSE(contacts[collisionThreads].empty()) << collisionThreads;
+
+    for (const auto &model : world->Models())
+      poses[collisionThreads].push_back(model->WorldPose());
+  }
+
+  for (const int collisionThreads : threads)
+  {
+    EXPECT_EQ(contacts[collisionThreads], contacts[0]) << collisionThreads;
+    EXPECT_EQ(poses[collisionThreads], poses[0]) << collisionThreads;
+  }
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -15,6 +15,7 @@
  *
 */
 #include <boost/algorithm/string.hpp>
+#include <functional>
 #include <sstream>
 
 #include <ignition/common/Profiler.hh>
@@ -116,7 +117,13 @@ void ContactSensor::Load(const std::string &_worldName)
     physics::ContactManager *mgr = this->world->Physics()->GetContactManager();
     std::string topic = mgr->CreateFilter(this->dataPtr->filterName,
         this->dataPtr->collisions);
-    if (!this->dataPtr->contactSub)
+
+    // Prefer receiving the contacts in process, which avoids building and
+    // parsing a message for every physics step.
+    if (!mgr->SetFilterCallback(this->dataPtr->filterName,
+          std::bind(&ContactSensor::OnPhysicsContacts, this,
+            std::placeholders::_1, std::placeholders::_2)) &&
+        !this->dataPtr->contactSub)
     {
       this->dataPtr->contactSub = this->node->Subscribe(topic,
           &ContactSensor::OnContacts, this);
@@ -139,7 +146,7 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Don't do anything if there is no new data to process.
-  if (this->dataPtr->incomingContacts.empty())
+  if (this->dataPtr->incomingCount == 0)
     return false;
 
   std::vector<std::string>::iterator collIter;
@@ -149,13 +156,16 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
   this->dataPtr->contactsMsg.clear_contact();
 
   // Iterate over all the contact messages
-  for (auto iter = this->dataPtr->incomingContacts.begin();
-       iter != this->dataPtr->incomingContacts.end(); ++iter)
+  const size_t bufferSize = this->dataPtr->incomingContacts.size();
+  for (size_t n = 0; n < this->dataPtr->incomingCount; ++n)
   {
+    const msgs::Contacts &incoming = this->dataPtr->incomingContacts[
+        (this->dataPtr->incomingStart + n) % bufferSize];
+
     // Iterate over all the contacts in the message
-    for (int i = 0; i < (*iter)->contact_size(); ++i)
+    for (int i = 0; i < incoming.contact_size(); ++i)
     {
-      collision1 = (*iter)->contact(i).collision1();
+      collision1 = incoming.contact(i).collision1();
 
       // Try to find the first collision's name
       collIter = std::find(this->dataPtr->collisions.begin(),
@@ -164,7 +174,7 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
       // If unable to find the first collision's name, try the second
       if (collIter == this->dataPtr->collisions.end())
       {
-        collision1 = (*iter)->contact(i).collision2();
+        collision1 = incoming.contact(i).collision2();
         collIter = std::find(this->dataPtr->collisions.begin(),
             this->dataPtr->collisions.end(), collision1);
       }
@@ -173,12 +183,12 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
       // contact, then add the contact to our outgoing message.
       if (collIter != this->dataPtr->collisions.end())
       {
-        int count = (*iter)->contact(i).position_size();
+        int count = incoming.contact(i).position_size();
 
         // Check to see if the contact arrays all have the same size.
-        if (count != (*iter)->contact(i).normal_size() ||
-            count != (*iter)->contact(i).wrench_size() ||
-            count != (*iter)->contact(i).depth_size())
+        if (count != incoming.contact(i).normal_size() ||
+            count != incoming.contact(i).wrench_size() ||
+            count != incoming.contact(i).depth_size())
         {
           gzerr << "Contact message has invalid array sizes\n";
           continue;
@@ -186,7 +196,7 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
 
         // Copy the contact message.
         msgs::Contact *contactMsg = this->dataPtr->contactsMsg.add_contact();
-        contactMsg->CopyFrom((*iter)->contact(i));
+        contactMsg->CopyFrom(incoming.contact(i));
       }
     }
   }
@@ -194,8 +204,9 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
   IGN_PROFILE_END();
   IGN_PROFILE_BEGIN("Publish");
 
-  // Clear the incoming contact list.
-  this->dataPtr->incomingContacts.clear();
+  // Clear the incoming contact list. The messages are kept for reuse.
+  this->dataPtr->incomingStart = 0;
+  this->dataPtr->incomingCount = 0;
 
   this->lastMeasurementTime = this->world->SimTime();
   msgs::Set(this->dataPtr->contactsMsg.mutable_time(),
@@ -215,13 +226,23 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
 //////////////////////////////////////////////////
 void ContactSensor::Fini()
 {
-  if (this->world && this->world->Running())
+  // The filter calls back into this sensor, so it's removed even when the
+  // world isn't running
+  if (this->world && this->world->Physics() &&
+      this->world->Physics()->GetContactManager())
   {
     physics::ContactManager *mgr =
         this->world->Physics()->GetContactManager();
     mgr->RemoveFilter(this->dataPtr->filterName);
   }
 
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->incomingContacts.clear();
+    this->dataPtr->incomingStart = 0;
+    this->dataPtr->incomingCount = 0;
+  }
+
   this->dataPtr->contactSub.reset();
   this->dataPtr->contactsPub.reset();
   Sensor::Fini();
@@ -312,12 +333,57 @@ void ContactSensor::OnContacts(ConstContactsPtr &_msg)
   if (this->IsActive())
   {
     // Store the contacts message for processing in UpdateImpl
-    this->dataPtr->incomingContacts.push_back(_msg);
+    this->NextIncomingContacts().CopyFrom(*_msg);
+  }
+}
+
+//////////////////////////////////////////////////
+void ContactSensor::OnPhysicsContacts(
+    const std::vector<physics::Contact *> &_contacts,
+    const common::Time &_time)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // Only store information if the sensor is active
+  if (!this->IsActive())
+    return;
 
-    // Prevent the incomingContacts list to grow indefinitely.
-    if (this->dataPtr->incomingContacts.size() > 100)
-      this->dataPtr->incomingContacts.pop_front();
+  msgs::Contacts &msg = this->NextIncomingContacts();
+  for (auto const &contact : _contacts)
+  {
+    if (contact->count > 0)
+      contact->FillMsg(*msg.add_contact());
+  }
+  msgs::Set(msg.mutable_time(), _time);
+}
+
+//////////////////////////////////////////////////
+msgs::Contacts &ContactSensor::NextIncomingContacts()
+{
+  // Prevent the incoming contacts from growing indefinitely.
+  const size_t maxCount = 100;
+  if (this->dataPtr->incomingContacts.size() < maxCount)
+    this->dataPtr->incomingContacts.resize(maxCount);
+
+  size_t index;
+  if (this->dataPtr->incomingCount < maxCount)
+  {
+    index = (this->dataPtr->incomingStart + this->dataPtr->incomingCount) %
+        maxCount;
+    ++this->dataPtr->incomingCount;
+  }
+  else
+  {
+    // Overwrite the oldest message.
+    index = this->dataPtr->incomingStart;
+    this->dataPtr->incomingStart = (this->dataPtr->incomingStart + 1) %
+        maxCount;
   }
+
+  // Clear keeps the allocated contacts, so they are reused.
+  msgs::Contacts &msg = this->dataPtr->incomingContacts[index];
+  msg.Clear();
+  return msg;
 }
 
 //////////////////////////////////////////////////
@@ -20,6 +20,7 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 
@@ -136,6 +137,19 @@ namespace gazebo
       /// \brief Callback for contact messages from the physics engine.
       private: void OnContacts(ConstContactsPtr &_msg);
 
+      /// \brief Callback for contacts delivered in process by the contact
+      /// manager.
+      /// \param[in] _contacts Contacts of the sensor's filter.
+      /// \param[in] _time Simulation time of the contacts.
+      private: void OnPhysicsContacts(
+                   const std::vector<physics::Contact *> &_contacts,
+                   const common::Time &_time);
+
+      /// \brief Get the next message of the incoming ring buffer. The
+      /// oldest message is reused when the buffer is full.
+      /// \return Cleared message.
+      private: msgs::Contacts &NextIncomingContacts();
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<ContactSensorPrivate> dataPtr;
@@ -18,7 +18,6 @@
 #define _GAZEBO_SENSORS_CONTACTSENSOR_PRIVATE_HH_
 
 #include <vector>
-#include <list>
 #include <string>
 #include <mutex>
 
@@ -39,7 +38,8 @@ namespace gazebo
       /// \brief Output contact information.
       public: transport::PublisherPtr contactsPub;
 
-      /// \brief Subscription to contact messages from the physics engine
+      /// \brief Subscription to contact messages from the physics engine.
+      /// Only used if the contacts can't be delivered in process.
       public: transport::SubscriberPtr contactSub;
 
       /// \brief Mutex to protect reads and writes.
@@ -48,12 +48,15 @@ namespace gazebo
       /// \brief Contacts message used to output sensor data.
       public: msgs::Contacts contactsMsg;
 
-      /// \type ContactMsgs_L
-      /// List of contact messages
-      typedef std::list<boost::shared_ptr<msgs::Contacts const> > ContactMsgs_L;
+      /// \brief Ring buffer of incoming contacts, one message per physics
+      /// step. The messages are reused to avoid allocations.
+      public: std::vector<msgs::Contacts> incomingContacts;
 
-      /// \brief List of incoming messages.
-      public: ContactMsgs_L incomingContacts;
+      /// \brief Index of the oldest message in incomingContacts.
+      public: size_t incomingStart = 0;
+
+      /// \brief Number of messages in incomingContacts.
+      public: size_t incomingCount = 0;
 
       /// \brief Name of filter used to filter contact messages.
       public: std::string filterName;
@@ -28,6 +28,7 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/ProfileTimeline.hh"
 #include "gazebo/common/SdfFrameSemantics.hh"
 
 #include "gazebo/rendering/Camera.hh"
@@ -234,6 +235,8 @@ bool Sensor::NeedsUpdate()
 //////////////////////////////////////////////////
 void Sensor::Update(const bool _force)
 {
+  GZ_PROFILE("Sensor::Update");
+
   if (this->IsActive() || _force)
   {
     if (this->useStrictRate)
@@ -531,8 +534,15 @@ event::ConnectionPtr Sensor::ConnectUpdated(std::function<void()> _subscriber)
 //////////////////////////////////////////////////
 double Sensor::NextRequiredTimestamp() const
 {
-  // implementation by default: next required timestamp is ignored
-  return std::numeric_limits<double>::quiet_NaN();
+  // Rendering sensors only report a timestamp in lockstep mode, since the
+  // world waits for it.
+  if (this->dataPtr->category == IMAGE)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  // Matches the test in Sensor::Update
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+  return (this->lastUpdateTime + this->updatePeriod -
+      this->dataPtr->updateDelay).Double();
 }
 
 //////////////////////////////////////////////////
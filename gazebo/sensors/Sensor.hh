@@ -181,8 +181,11 @@ namespace gazebo
       /// \return The sensor's noise model for the given noise type
       public: NoisePtr Noise(const SensorNoiseType _type) const;
 
-      /// \brief Get the next timestamp that will be used by the sensor
-      /// \return the timestamp
+      /// \brief Get the next timestamp that will be used by the sensor.
+      /// Sensors that don't rely on the rendering engine are scheduled by
+      /// this timestamp.
+      /// \return the timestamp, NaN if unknown. By default, rendering
+      /// sensors return NaN.
       public: virtual double NextRequiredTimestamp() const;
 
       /// \brief Returns true if the sensor is to follow strict update rate
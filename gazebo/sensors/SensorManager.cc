@@ -16,8 +16,10 @@
 */
 
 #include <functional>
+#include <memory>
 #include <boost/bind/bind.hpp>
 
+#include "gazebo/common/ProfileTimeline.hh"
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/PhysicsIface.hh"
@@ -46,12 +48,9 @@ boost::mutex g_sensorTimingMutex;
 /// max update rate needs to be recalculated
 bool g_sensorsDirty = true;
 
-/// Performance metrics variables
-/// \brief last sensor measurement sim time
-std::map<std::string, gazebo::common::Time> sensorsLastMeasurementTime;
-
-/// \brief last sensor measurement real time
-std::map<std::string, gazebo::common::Time> worldLastMeasurementTime;
+/// \brief Updates the non-image sensors. SensorManager is a singleton, so
+/// its scheduler is kept here.
+static std::unique_ptr<SensorScheduler> g_sensorScheduler;
 
 /// \brief Data structure for storing metric data to be published
 struct sensorPerformanceMetricsType
@@ -70,26 +69,42 @@ struct sensorPerformanceMetricsType
   double sensorAvgFPS;
 };
 
-/// \brief A map of sensor name to its performance metrics data
-std::map<std::string, struct sensorPerformanceMetricsType>
-    sensorPerformanceMetrics;
+/// \brief Performance metrics variables of a world
+struct worldPerformanceMetricsType
+{
+  /// \brief last sensor measurement sim time
+  std::map<std::string, gazebo::common::Time> sensorsLastMeasurementTime;
+
+  /// \brief last sensor measurement real time
+  std::map<std::string, gazebo::common::Time> worldLastMeasurementTime;
+
+  /// \brief A map of sensor name to its performance metrics data
+  std::map<std::string, struct sensorPerformanceMetricsType>
+      sensorPerformanceMetrics;
+
+  /// \brief Publisher for run-time simulation performance metrics.
+  transport::PublisherPtr performanceMetricsPub;
 
-/// \brief Publisher for run-time simulation performance metrics.
-transport::PublisherPtr performanceMetricsPub;
+  /// \brief Node for publishing performance metrics
+  transport::NodePtr node = nullptr;
 
-/// \brief Node for publishing performance metrics
-transport::NodePtr node = nullptr;
+  /// \brief Last sim time measured for performance metrics
+  common::Time lastSimTime;
 
-/// \brief Last sim time measured for performance metrics
-common::Time lastSimTime;
+  /// \brief Last real time measured for performance metrics
+  common::Time lastRealTime;
+};
 
-/// \brief Last real time measured for performance metrics
-common::Time lastRealTime;
+/// \brief Performance metrics variables, by world name
+std::map<std::string, struct worldPerformanceMetricsType>
+    worldPerformanceMetrics;
 
 //////////////////////////////////////////////////
 SensorManager::SensorManager()
   : initialized(false), removeAllSensors(false)
 {
+  g_sensorScheduler.reset(new SensorScheduler());
+
   // sensors::IMAGE container
   this->sensorContainers.push_back(new ImageSensorContainer());
 
@@ -104,6 +119,10 @@ SensorManager::SensorManager()
 SensorManager::~SensorManager()
 {
   sensors::disable();
+
+  g_sensorScheduler->Stop();
+  g_sensorScheduler->RemoveSensors();
+
   // Clean up the sensors.
   for (SensorContainer_V::iterator iter = this->sensorContainers.begin();
        iter != this->sensorContainers.end(); ++iter)
@@ -116,27 +135,25 @@ SensorManager::~SensorManager()
   this->sensorContainers.clear();
 
   this->initSensors.clear();
+
+  g_sensorScheduler.reset();
 }
 
 //////////////////////////////////////////////////
 void SensorManager::RunThreads()
 {
-  // Start the non-image sensor containers. The first item in the
-  // sensorsContainers list are the image-based sensors, which rely on the
-  // rendering engine, which in turn requires that they run in the main
-  // thread.
-  for (SensorContainer_V::iterator iter = ++this->sensorContainers.begin();
-       iter != this->sensorContainers.end(); ++iter)
-  {
-    GZ_ASSERT((*iter) != nullptr, "Sensor Constainer is null");
-    (*iter)->Run();
-  }
+  // Start the scheduler of the non-image sensors. The image-based sensors
+  // rely on the rendering engine, which in turn requires that they run in
+  // the main thread.
+  g_sensorScheduler->Start();
 }
 
 //////////////////////////////////////////////////
 void SensorManager::Stop()
 {
-  // Start all the sensor containers.
+  g_sensorScheduler->Stop();
+
+  // Stop all the sensor containers.
   for (SensorContainer_V::iterator iter = this->sensorContainers.begin();
        iter != this->sensorContainers.end(); ++iter)
   {
@@ -151,12 +168,14 @@ void SensorManager::Stop()
 //////////////////////////////////////////////////
 bool SensorManager::Running() const
 {
-  for (auto const &container : this->sensorContainers)
-  {
-    if (container->Running())
-      return true;
-  }
-  return false;
+  return g_sensorScheduler->Running();
+}
+
+//////////////////////////////////////////////////
+bool SensorManager::Lateness(const std::string &_name,
+    SensorLateness &_lateness) const
+{
+  return g_sensorScheduler->Lateness(_name, _lateness);
 }
 
 //////////////////////////////////////////////////
@@ -173,35 +192,40 @@ void SensorManager::WaitForSensors(double _clk, double _dt)
   }
 }
 
-void PublishPerformanceMetrics()
+/// \brief Publish the performance metrics of a world. The first world
+/// publishes on /gazebo/performance_metrics, the others on
+/// /gazebo/<world name>/performance_metrics.
+/// \param[in] _world The world.
+void PublishPerformanceMetrics(const physics::WorldPtr &_world)
 {
-  if (node == nullptr)
+  struct worldPerformanceMetricsType &metrics =
+      worldPerformanceMetrics[_world->Name()];
+
+  if (metrics.node == nullptr)
   {
-    auto world = physics::get_world();
     // Transport
-    node = transport::NodePtr(new transport::Node());
-    node->Init(world->Name());
-    performanceMetricsPub =
-     node->Advertise<msgs::PerformanceMetrics>(
-         "/gazebo/performance_metrics", 10, 5);
+    metrics.node = transport::NodePtr(new transport::Node());
+    metrics.node->Init(_world->Name());
+    metrics.performanceMetricsPub =
+     metrics.node->Advertise<msgs::PerformanceMetrics>(
+         physics::get_world() == _world ? "/gazebo/performance_metrics" :
+         "~/performance_metrics", 10, 5);
   }
 
-  if (!performanceMetricsPub || !performanceMetricsPub->HasConnections())
+  if (!metrics.performanceMetricsPub ||
+      !metrics.performanceMetricsPub->HasConnections())
   {
     return;
   }
 
-  physics::WorldPtr world = physics::get_world(
-    gazebo::physics::get_world()->Name());
-
   /// Outgoing run-time simulation performance metrics.
   msgs::PerformanceMetrics performanceMetricsMsg;
 
   // Real time factor
-  common::Time realTime = world->RealTime();
-  common::Time diffRealtime = realTime - lastRealTime;
-  common::Time simTime = world->SimTime();
-  common::Time diffSimTime = simTime - lastSimTime;
+  common::Time realTime = _world->RealTime();
+  common::Time diffRealtime = realTime - metrics.lastRealTime;
+  common::Time simTime = _world->SimTime();
+  common::Time diffSimTime = simTime - metrics.lastSimTime;
   common::Time realTimeFactor;
 
   if (ignition::math::equal(diffSimTime.Double(), 0.0))
@@ -214,11 +238,11 @@ void PublishPerformanceMetrics()
 
   performanceMetricsMsg.set_real_time_factor(realTimeFactor.Double());
 
-  lastRealTime = realTime;
-  lastSimTime = simTime;
+  metrics.lastRealTime = realTime;
+  metrics.lastSimTime = simTime;
 
   /// update sim time for sensors
-  for (auto model: world->Models())
+  for (auto model: _world->Models())
   {
     for (auto link: model->GetLinks())
     {
@@ -227,23 +251,23 @@ void PublishPerformanceMetrics()
         std::string name = link->GetSensorName(i);
         sensors::SensorPtr sensor = sensors::get_sensor(name);
 
-        auto ret = sensorsLastMeasurementTime.insert(
+        auto ret = metrics.sensorsLastMeasurementTime.insert(
             std::pair<std::string, gazebo::common::Time>(name, 0));
-        worldLastMeasurementTime.insert(
+        metrics.worldLastMeasurementTime.insert(
                 std::pair<std::string, gazebo::common::Time>(name, 0));
         if (ret.second == false)
         {
-          double updateSimRate =
-            (sensor->LastMeasurementTime() - sensorsLastMeasurementTime[name])
-            .Double();
+          double updateSimRate = (sensor->LastMeasurementTime() -
+              metrics.sensorsLastMeasurementTime[name]).Double();
           if (updateSimRate > 0.0)
           {
-            sensorsLastMeasurementTime[name] = sensor->LastMeasurementTime();
-            double updateRealRate =
-              (world->RealTime() - worldLastMeasurementTime[name]).Double();
+            metrics.sensorsLastMeasurementTime[name] =
+                sensor->LastMeasurementTime();
+            double updateRealRate = (_world->RealTime() -
+                metrics.worldLastMeasurementTime[name]).Double();
 
             struct sensorPerformanceMetricsType emptySensorPerfomanceMetrics;
-            auto ret2 = sensorPerformanceMetrics.insert(
+            auto ret2 = metrics.sensorPerformanceMetrics.insert(
                 std::pair<std::string, struct sensorPerformanceMetricsType>
                   (name, emptySensorPerfomanceMetrics));
             if (ret2.second == false)
@@ -252,7 +276,7 @@ void PublishPerformanceMetrics()
                   1.0/updateSimRate;
               ret2.first->second.sensorRealUpdateRate =
                   1.0/updateRealRate;
-              worldLastMeasurementTime[name] = world->RealTime();
+              metrics.worldLastMeasurementTime[name] = _world->RealTime();
 
               // Special case for stereo cameras
               sensors::CameraSensorPtr cameraSensor =
@@ -273,7 +297,7 @@ void PublishPerformanceMetrics()
     }
   }
 
-  for (auto sensorPerformanceMetric: sensorPerformanceMetrics)
+  for (auto sensorPerformanceMetric: metrics.sensorPerformanceMetrics)
   {
     msgs::PerformanceMetrics::PerformanceSensorMetrics
         *performanceSensorMetricsMsg = performanceMetricsMsg.add_sensor();
@@ -290,12 +314,14 @@ void PublishPerformanceMetrics()
   }
 
   // Publish data
-  performanceMetricsPub->Publish(performanceMetricsMsg);
+  metrics.performanceMetricsPub->Publish(performanceMetricsMsg);
 }
 
 //////////////////////////////////////////////////
 void SensorManager::Update(bool _force)
 {
+  GZ_PROFILE("SensorManager::Update");
+
   {
     boost::recursive_mutex::scoped_lock lock(this->mutex);
 
@@ -318,7 +344,7 @@ void SensorManager::Update(bool _force)
             "Sensor container is null");
 
         sensor->Init();
-        this->sensorContainers[sensor->Category()]->AddSensor(sensor);
+        this->AddSensor(sensor);
       }
       this->initSensors.clear();
       for (auto &worldName_worldPtr : this->worlds)
@@ -330,6 +356,10 @@ void SensorManager::Update(bool _force)
     {
       GZ_ASSERT(!(*iter).empty(), "Remove sensor name is empty.");
 
+      // Wait for a scheduled update to finish before the sensor is
+      // finalized.
+      g_sensorScheduler->RemoveSensor(*iter);
+
       bool removed = false;
       for (SensorContainer_V::iterator iter2 = this->sensorContainers.begin();
            iter2 != this->sensorContainers.end() && !removed; ++iter2)
@@ -350,6 +380,7 @@ void SensorManager::Update(bool _force)
 
     if (this->removeAllSensors)
     {
+      g_sensorScheduler->RemoveSensors();
       for (SensorContainer_V::iterator iter2 = this->sensorContainers.begin();
           iter2 != this->sensorContainers.end(); ++iter2)
       {
@@ -369,7 +400,20 @@ void SensorManager::Update(bool _force)
   if (this->sensorContainers[sensors::IMAGE]->sensors.size() > 0)
     this->sensorContainers[sensors::IMAGE]->Update(_force);
 
-  PublishPerformanceMetrics();
+  std::vector<physics::WorldPtr> metricsWorlds;
+  {
+    boost::recursive_mutex::scoped_lock lock(this->mutex);
+    for (auto &worldName_worldPtr : this->worlds)
+      metricsWorlds.push_back(worldName_worldPtr.second);
+  }
+
+  // Publish the metrics of every world, since worlds stepped by a pool
+  // run side by side.
+  for (auto &world : metricsWorlds)
+  {
+    if (world)
+      PublishPerformanceMetrics(world);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -390,6 +434,7 @@ void SensorManager::ResetLastUpdateTimes()
     GZ_ASSERT((*iter) != nullptr, "SensorContainer is null");
     (*iter)->ResetLastUpdateTimes();
   }
+  g_sensorScheduler->Reset();
 }
 
 //////////////////////////////////////////////////
@@ -450,6 +495,10 @@ void SensorManager::Fini()
 {
   boost::recursive_mutex::scoped_lock lock(this->mutex);
 
+  // Stop updating the sensors before they're finalized.
+  g_sensorScheduler->Stop();
+  g_sensorScheduler->RemoveSensors();
+
   // Finalize all the sensor containers.
   for (SensorContainer_V::iterator iter = this->sensorContainers.begin();
        iter != this->sensorContainers.end(); ++iter)
@@ -517,7 +566,7 @@ std::string SensorManager::CreateSensor(sdf::ElementPtr _elem,
   // initialized in SensorManager::Init
   if (!this->initialized)
   {
-    this->sensorContainers[sensor->Category()]->AddSensor(sensor);
+    this->AddSensor(sensor);
   }
   // Otherwise the SensorManager is already running, and the sensor will get
   // initialized during the next SensorManager::Update call.
@@ -637,6 +686,17 @@ void SensorManager::RemoveSensors()
   this->removeAllSensors = true;
 }
 
+//////////////////////////////////////////////////
+void SensorManager::AddSensor(SensorPtr _sensor)
+{
+  this->sensorContainers[_sensor->Category()]->AddSensor(_sensor);
+
+  // Sensors that don't need the rendering engine are updated by the
+  // scheduler's workers.
+  if (_sensor->Category() != sensors::IMAGE)
+    g_sensorScheduler->AddSensor(_sensor);
+}
+
 //////////////////////////////////////////////////
 SensorManager::SensorContainer::SensorContainer()
 {
@@ -31,6 +31,7 @@
 #include "gazebo/common/UpdateInfo.hh"
 #include "gazebo/sensors/SensorTypes.hh"
 #include "gazebo/sensors/Sensor.hh"
+#include "gazebo/sensors/SensorScheduler.hh"
 #include "gazebo/util/system.hh"
 
 /// \brief Explicit instantiation for typed SingletonT.
@@ -115,19 +116,27 @@ namespace gazebo
       public: void Init();
 
       /// \brief Run sensor updates in separate threads.
-      /// This will only run non-image based sensor updates.
+      /// This will only run non-image based sensor updates, which are
+      /// scheduled on a pool of worker threads.
       public: void RunThreads();
 
-      /// \brief Stop the run thread
+      /// \brief Stop the run threads
       public: void Stop();
 
       /// \brief Finalize all the sensors
       public: void Fini();
 
-      /// \brief Get whether there's at least one sensor container running.
+      /// \brief Get whether the non-image sensors are being updated.
       /// \return True if running.
       public: bool Running() const;
 
+      /// \brief Get how late the updates of a non-image sensor start.
+      /// \param[in] _name Scoped name of the sensor.
+      /// \param[out] _lateness Lateness statistics of the sensor.
+      /// \return False if the sensor isn't a scheduled non-image sensor.
+      public: bool Lateness(const std::string &_name,
+                  SensorLateness &_lateness) const;
+
       /// \brief Get all the sensor types
       /// \param[out] All the sensor types.
       public: void GetSensorTypes(std::vector<std::string> &_types) const;
@@ -189,7 +198,8 @@ namespace gazebo
       /// \return True if timeout has NOT been met
       private: bool WaitForPrerendered(double _timeoutsec);
 
-      /// \brief Add a new sensor to a sensor container.
+      /// \brief Add a new sensor to a sensor container. Sensors that don't
+      /// rely on the rendering engine are also added to the scheduler.
       /// \param[in] _sensor Pointer to a sensor to add.
       private: void AddSensor(SensorPtr _sensor);
 
@@ -0,0 +1,386 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <string>
+
+#include "ignition/common/Profiler.hh"
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Events.hh"
+#include "gazebo/common/ProfileTimeline.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/PhysicsIface.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/sensors/Sensor.hh"
+#include "gazebo/sensors/SensorSchedulerPrivate.hh"
+#include "gazebo/sensors/SensorScheduler.hh"
+
+using namespace gazebo;
+using namespace sensors;
+
+/// \brief Heap order of the scheduled sensors, the earliest deadline
+/// first.
+/// \param[in] _a First sensor.
+/// \param[in] _b Second sensor.
+/// \return True if _a is due after _b.
+static bool DueLater(const ScheduledSensorPtr &_a,
+    const ScheduledSensorPtr &_b)
+{
+  return _a->deadline > _b->deadline;
+}
+
+/// \brief Move the sensors of a heap that are due to a ready list.
+/// \param[in,out] _queue Heap of sensors.
+/// \param[in] _simTime Current simulation time.
+/// \param[out] _ready List of the sensors that are due.
+/// \return True if at least one sensor is due.
+static bool Release(std::vector<ScheduledSensorPtr> &_queue,
+    const common::Time &_simTime, std::deque<ScheduledSensorPtr> &_ready)
+{
+  const double now = _simTime.Double();
+
+  bool due = false;
+  while (!_queue.empty() && _queue.front()->deadline <= now)
+  {
+    std::pop_heap(_queue.begin(), _queue.end(), DueLater);
+    _ready.push_back(_queue.back());
+    _queue.pop_back();
+    due = true;
+  }
+
+  return due;
+}
+
+//////////////////////////////////////////////////
+SensorScheduler::SensorScheduler(const unsigned int _threadCount)
+  : dataPtr(new SensorSchedulerPrivate)
+{
+  this->dataPtr->threadCount = _threadCount;
+  if (this->dataPtr->threadCount == 0)
+  {
+    this->dataPtr->threadCount =
+      std::max(1u, std::thread::hardware_concurrency());
+  }
+}
+
+//////////////////////////////////////////////////
+SensorScheduler::~SensorScheduler()
+{
+  this->Stop();
+}
+
+//////////////////////////////////////////////////
+void SensorScheduler::Start()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->stop)
+      return;
+    this->dataPtr->stop = false;
+  }
+
+  for (unsigned int i = 0; i < this->dataPtr->threadCount; ++i)
+  {
+    this->dataPtr->workers.push_back(
+        std::thread(&SensorScheduler::RunWorker, this));
+  }
+
+  this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
+      [this](const common::UpdateInfo &_info)
+      {
+        this->Update(_info.worldName, _info.simTime);
+      });
+}
+
+//////////////////////////////////////////////////
+void SensorScheduler::Stop()
+{
+  this->dataPtr->updateConnection.reset();
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->readyCondition.notify_all();
+
+  for (auto &worker : this->dataPtr->workers)
+    worker.join();
+  this->dataPtr->workers.clear();
+
+  // Sensors that were due are handed to the workers on the next start
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto &scheduled : this->dataPtr->ready)
+  {
+    auto &queue = this->dataPtr->queues[scheduled->world];
+    queue.push_back(scheduled);
+    std::push_heap(queue.begin(), queue.end(), DueLater);
+  }
+  this->dataPtr->ready.clear();
+}
+
+//////////////////////////////////////////////////
+bool SensorScheduler::Running() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return !this->dataPtr->stop;
+}
+
+//////////////////////////////////////////////////
+unsigned int SensorScheduler::ThreadCount() const
+{
+  return this->dataPtr->threadCount;
+}
+
+//////////////////////////////////////////////////
+void SensorScheduler::AddSensor(SensorPtr _sensor)
+{
+  GZ_ASSERT(_sensor != nullptr, "Sensor is null");
+
+  ScheduledSensorPtr scheduled(new ScheduledSensor);
+  scheduled->sensor = _sensor;
+  scheduled->world = _sensor->WorldName();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->sensors.insert(
+        std::make_pair(_sensor->ScopedName(), scheduled)).second)
+  {
+    gzerr << "Sensor [" << _sensor->ScopedName() << "] is already scheduled"
+          << std::endl;
+    return;
+  }
+
+  auto &queue = this->dataPtr->queues[scheduled->world];
+  queue.push_back(scheduled);
+  std::push_heap(queue.begin(), queue.end(), DueLater);
+}
+
+//////////////////////////////////////////////////
+bool SensorScheduler::RemoveSensor(const std::string &_name)
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+
+  auto iter = this->dataPtr->sensors.find(_name);
+  if (iter == this->dataPtr->sensors.end())
+    return false;
+
+  ScheduledSensorPtr scheduled = iter->second;
+  this->dataPtr->sensors.erase(iter);
+  scheduled->removed = true;
+
+  auto &queue = this->dataPtr->queues[scheduled->world];
+  auto queued = std::find(queue.begin(), queue.end(), scheduled);
+  if (queued != queue.end())
+  {
+    queue.erase(queued);
+    std::make_heap(queue.begin(), queue.end(), DueLater);
+  }
+
+  auto ready = std::find(this->dataPtr->ready.begin(),
+      this->dataPtr->ready.end(), scheduled);
+  if (ready != this->dataPtr->ready.end())
+    this->dataPtr->ready.erase(ready);
+
+  // The caller may finalize the sensor once we return
+  this->dataPtr->doneCondition.wait(lock, [&scheduled]
+      {
+        return !scheduled->running;
+      });
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SensorScheduler::RemoveSensors()
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+
+  std::vector<ScheduledSensorPtr> removed;
+  for (auto &named : this->dataPtr->sensors)
+  {
+    named.second->removed = true;
+    removed.push_back(named.second);
+  }
+  this->dataPtr->sensors.clear();
+  this->dataPtr->queues.clear();
+  this->dataPtr->ready.clear();
+
+  this->dataPtr->doneCondition.wait(lock, [&removed]
+      {
+        for (auto const &scheduled : removed)
+        {
+          if (scheduled->running)
+            return false;
+        }
+        return true;
+      });
+}
+
+//////////////////////////////////////////////////
+size_t SensorScheduler::SensorCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->sensors.size();
+}
+
+//////////////////////////////////////////////////
+void SensorScheduler::Reset()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  ++this->dataPtr->resetCount;
+  this->dataPtr->simTimes.clear();
+
+  // Every deadline is now zero, so the heaps stay valid
+  for (auto &queue : this->dataPtr->queues)
+  {
+    for (auto &scheduled : queue.second)
+      scheduled->deadline = 0;
+  }
+}
+
+//////////////////////////////////////////////////
+void SensorScheduler::Update(const common::Time &_simTime)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  for (auto &queue : this->dataPtr->queues)
+    this->dataPtr->simTimes[queue.first] = _simTime;
+  if (this->dataPtr->stop)
+    return;
+
+  bool due = false;
+  for (auto &queue : this->dataPtr->queues)
+    due = Release(queue.second, _simTime, this->dataPtr->ready) || due;
+
+  if (due)
+    this->dataPtr->readyCondition.notify_all();
+}
+
+//////////////////////////////////////////////////
+void SensorScheduler::Update(const std::string &_worldName,
+    const common::Time &_simTime)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  this->dataPtr->simTimes[_worldName] = _simTime;
+  if (this->dataPtr->stop)
+    return;
+
+  auto queue = this->dataPtr->queues.find(_worldName);
+  if (queue != this->dataPtr->queues.end() &&
+      Release(queue->second, _simTime, this->dataPtr->ready))
+  {
+    this->dataPtr->readyCondition.notify_all();
+  }
+}
+
+//////////////////////////////////////////////////
+bool SensorScheduler::Lateness(const std::string &_name,
+    SensorLateness &_lateness) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  auto iter = this->dataPtr->sensors.find(_name);
+  if (iter == this->dataPtr->sensors.end())
+    return false;
+
+  _lateness = iter->second->lateness;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SensorScheduler::RunWorker()
+{
+  IGN_PROFILE_THREAD_NAME("SensorScheduler");
+  GZ_PROFILE_THREAD_NAME("SensorScheduler");
+
+  // Worlds whose physics engine was initialized for this thread
+  std::set<std::string> initWorlds;
+
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  while (true)
+  {
+    this->dataPtr->readyCondition.wait(lock, [this]
+        {
+          return this->dataPtr->stop || !this->dataPtr->ready.empty();
+        });
+    if (this->dataPtr->stop)
+      return;
+
+    ScheduledSensorPtr scheduled = this->dataPtr->ready.front();
+    this->dataPtr->ready.pop_front();
+    scheduled->running = true;
+
+    const double start =
+      this->dataPtr->simTimes[scheduled->world].Double();
+    const uint64_t resetCount = this->dataPtr->resetCount;
+    const double rate = scheduled->sensor->UpdateRate();
+    const double period = rate > 0 ? 1.0 / rate : 0.0;
+
+    const double late = std::max(0.0, start - scheduled->deadline);
+    SensorLateness &lateness = scheduled->lateness;
+    lateness.last = late;
+    lateness.max = std::max(lateness.max, lateness.last);
+    lateness.total += lateness.last;
+    ++lateness.updates;
+    if (period > 0 && scheduled->deadline > 0 && late >= period)
+      ++lateness.missed;
+
+    lock.unlock();
+
+    // Ray sensors query the physics engine of their world from this
+    // thread.
+    if (initWorlds.count(scheduled->world) == 0 &&
+        physics::has_world(scheduled->world))
+    {
+      physics::PhysicsEnginePtr engine =
+        physics::get_world(scheduled->world)->Physics();
+      if (engine)
+        engine->InitForThread();
+      initWorlds.insert(scheduled->world);
+    }
+
+    IGN_PROFILE_BEGIN(scheduled->sensor->Name().c_str());
+    scheduled->sensor->Update(false);
+    IGN_PROFILE_END();
+
+    double next = scheduled->sensor->NextRequiredTimestamp();
+
+    lock.lock();
+    scheduled->running = false;
+
+    if (!scheduled->removed)
+    {
+      // A sensor that didn't produce data, or that doesn't report when
+      // it's due next, waits one update period.
+      if (resetCount != this->dataPtr->resetCount)
+        next = 0;
+      else if (std::isnan(next) || next <= start)
+        next = start + std::max(period, 1e-9);
+
+      scheduled->deadline = next;
+      auto &queue = this->dataPtr->queues[scheduled->world];
+      queue.push_back(scheduled);
+      std::push_heap(queue.begin(), queue.end(), DueLater);
+    }
+
+    this->dataPtr->doneCondition.notify_all();
+  }
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_SENSORSCHEDULER_HH_
+#define GAZEBO_SENSORS_SENSORSCHEDULER_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/sensors/SensorTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    // Forward declare private data
+    class SensorSchedulerPrivate;
+
+    /// \addtogroup gazebo_sensors
+    /// \{
+
+    /// \brief Lateness statistics of a scheduled sensor, in simulation
+    /// time. The lateness of an update is the time between the moment the
+    /// sensor was due and the moment its update started.
+    class GZ_SENSORS_VISIBLE SensorLateness
+    {
+      /// \brief Lateness of the last update.
+      public: common::Time last;
+
+      /// \brief Largest lateness.
+      public: common::Time max;
+
+      /// \brief Sum of the lateness of all updates, used for the mean.
+      public: common::Time total;
+
+      /// \brief Number of updates.
+      public: uint64_t updates = 0;
+
+      /// \brief Number of updates that started more than an update period
+      /// late, which means the sensor missed at least one measurement.
+      public: uint64_t missed = 0;
+    };
+
+    /// \class SensorScheduler SensorScheduler.hh sensors/sensors.hh
+    /// \brief Updates sensors that don't rely on the rendering engine on a
+    /// pool of worker threads.
+    ///
+    /// Sensors are kept in a priority queue ordered by the simulation time
+    /// at which they're due, given by Sensor::NextRequiredTimestamp. On
+    /// every world update, the sensors that are due are handed to the
+    /// workers, and a sensor goes back in the queue once its update is
+    /// done. A sensor is never updated by two workers at the same time.
+    class GZ_SENSORS_VISIBLE SensorScheduler
+    {
+      /// \brief Constructor.
+      /// \param[in] _threadCount Number of worker threads. Zero uses one
+      /// thread per hardware thread.
+      public: explicit SensorScheduler(const unsigned int _threadCount = 0);
+
+      /// \brief Destructor. Stops the workers.
+      public: virtual ~SensorScheduler();
+
+      /// \brief Start the workers, and update the sensors on every world
+      /// update.
+      public: void Start();
+
+      /// \brief Stop the workers. Blocks until the updates in progress are
+      /// done.
+      public: void Stop();
+
+      /// \brief Get whether the workers are running.
+      /// \return True if running.
+      public: bool Running() const;
+
+      /// \brief Get the number of worker threads.
+      /// \return Number of worker threads.
+      public: unsigned int ThreadCount() const;
+
+      /// \brief Add a sensor. It's due right away.
+      /// \param[in] _sensor Sensor to schedule.
+      public: void AddSensor(SensorPtr _sensor);
+
+      /// \brief Remove a sensor. Blocks until the sensor's update is done,
+      /// if it's being updated.
+      /// \param[in] _name Scoped name of the sensor.
+      /// \return True if the sensor was scheduled.
+      public: bool RemoveSensor(const std::string &_name);
+
+      /// \brief Remove all sensors. Blocks until the updates in progress
+      /// are done.
+      public: void RemoveSensors();
+
+      /// \brief Get the number of scheduled sensors.
+      /// \return Number of sensors.
+      public: size_t SensorCount() const;
+
+      /// \brief Make all sensors due, used when the world time is reset.
+      public: void Reset();
+
+      /// \brief Hand the sensors of every world that are due to the
+      /// workers.
+      /// \param[in] _simTime Current simulation time.
+      public: void Update(const common::Time &_simTime);
+
+      /// \brief Hand the sensors of a world that are due to the workers.
+      /// Called on every update of each world once started.
+      /// \param[in] _worldName Name of the world that was updated.
+      /// \param[in] _simTime Current simulation time of the world.
+      public: void Update(const std::string &_worldName,
+                  const common::Time &_simTime);
+
+      /// \brief Get the lateness statistics of a sensor.
+      /// \param[in] _name Scoped name of the sensor.
+      /// \param[out] _lateness Lateness statistics.
+      /// \return False if the sensor isn't scheduled.
+      public: bool Lateness(const std::string &_name,
+                  SensorLateness &_lateness) const;
+
+      /// \brief Update sensors until stopped. Used by the worker threads.
+      private: void RunWorker();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SensorSchedulerPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
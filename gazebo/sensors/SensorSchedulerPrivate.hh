@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_SENSORSCHEDULERPRIVATE_HH_
+#define GAZEBO_SENSORS_SENSORSCHEDULERPRIVATE_HH_
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gazebo/common/Event.hh"
+#include "gazebo/common/Time.hh"
+#include "gazebo/sensors/SensorScheduler.hh"
+#include "gazebo/sensors/SensorTypes.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \internal
+    /// \brief A sensor handled by the scheduler.
+    class ScheduledSensor
+    {
+      /// \brief The sensor.
+      public: SensorPtr sensor;
+
+      /// \brief Name of the world the sensor is in.
+      public: std::string world;
+
+      /// \brief Simulation time at which the sensor is due, in seconds.
+      public: double deadline = 0;
+
+      /// \brief True while a worker updates the sensor.
+      public: bool running = false;
+
+      /// \brief True once the sensor is removed from the scheduler.
+      public: bool removed = false;
+
+      /// \brief Lateness statistics.
+      public: SensorLateness lateness;
+    };
+
+    /// \internal
+    /// \brief Shared pointer to a scheduled sensor.
+    typedef std::shared_ptr<ScheduledSensor> ScheduledSensorPtr;
+
+    /// \internal
+    /// \brief SensorScheduler private data.
+    class SensorSchedulerPrivate
+    {
+      /// \brief Number of worker threads.
+      public: unsigned int threadCount = 1;
+
+      /// \brief The worker threads.
+      public: std::vector<std::thread> workers;
+
+      /// \brief Protects everything below.
+      public: mutable std::mutex mutex;
+
+      /// \brief Notified when sensors are ready, or the workers must stop.
+      public: std::condition_variable readyCondition;
+
+      /// \brief Notified when a worker is done with a sensor.
+      public: std::condition_variable doneCondition;
+
+      /// \brief True when the workers must stop.
+      public: bool stop = true;
+
+      /// \brief All the sensors, by scoped name.
+      public: std::map<std::string, ScheduledSensorPtr> sensors;
+
+      /// \brief Heaps of the sensors waiting to be due, the first one is
+      /// due first, by world name. Worlds advance independently, so each
+      /// one has its own heap.
+      public: std::map<std::string, std::vector<ScheduledSensorPtr>> queues;
+
+      /// \brief Sensors that are due, waiting for a worker.
+      public: std::deque<ScheduledSensorPtr> ready;
+
+      /// \brief Latest simulation time, by world name.
+      public: std::map<std::string, common::Time> simTimes;
+
+      /// \brief Incremented by Reset, so that the workers can tell that
+      /// the world time was reset during an update.
+      public: uint64_t resetCount = 0;
+
+      /// \brief Connection to the world update event.
+      public: event::ConnectionPtr updateConnection;
+    };
+  }
+}
+#endif
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include "gazebo/physics/PhysicsIface.hh"
+#include "gazebo/sensors/SensorScheduler.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class SensorScheduler_TEST : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Check the thread count of the worker pool.
+TEST_F(SensorScheduler_TEST, ThreadCount)
+{
+  sensors::SensorScheduler scheduler(3);
+  EXPECT_EQ(scheduler.ThreadCount(), 3u);
+  EXPECT_FALSE(scheduler.Running());
+  EXPECT_EQ(scheduler.SensorCount(), 0u);
+
+  sensors::SensorScheduler machine;
+  EXPECT_GE(machine.ThreadCount(), 1u);
+
+  sensors::SensorLateness lateness;
+  EXPECT_FALSE(scheduler.Lateness("no_such_sensor", lateness));
+  EXPECT_FALSE(scheduler.RemoveSensor("no_such_sensor"));
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that the non-image sensors of a world are scheduled, and
+/// that their lateness is reported.
+TEST_F(SensorScheduler_TEST, Lateness)
+{
+  Load("worlds/ray_test.world");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+  EXPECT_TRUE(mgr->SensorsInitialized());
+  EXPECT_TRUE(mgr->Running());
+
+  const std::string imuName = "default::box_model::box_link::box_imu_sensor";
+  sensors::SensorPtr imuSensor = mgr->GetSensor(imuName);
+  ASSERT_TRUE(imuSensor != nullptr);
+  imuSensor->SetUpdateRate(100.0);
+
+  // Let the sensor update for a second of simulation time
+  sensors::SensorLateness lateness;
+  for (int i = 0; i < 100 && lateness.updates < 50; ++i)
+  {
+    common::Time::MSleep(100);
+    EXPECT_TRUE(mgr->Lateness(imuName, lateness));
+  }
+  EXPECT_GE(lateness.updates, 50u);
+  EXPECT_LE(lateness.last, lateness.max);
+  EXPECT_LE(lateness.max, lateness.total);
+  EXPECT_LE(lateness.missed, lateness.updates);
+
+  const std::string laserName = "default::hokuyo::link::laser";
+  EXPECT_TRUE(mgr->Lateness(laserName, lateness));
+
+  // Unknown sensors aren't scheduled
+  EXPECT_FALSE(mgr->Lateness("default::no_such_sensor", lateness));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_BOUNDEDQUEUE_HH_
+#define GAZEBO_TRANSPORT_BOUNDEDQUEUE_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \class BoundedQueue BoundedQueue.hh transport/transport.hh
+    /// \brief A fixed capacity first in first out queue, which can be
+    /// used by several producers and consumers without locks.
+    ///
+    /// Each slot carries a sequence number that tells whether it is ready
+    /// to be written or read in the current lap around the buffer, so a
+    /// push or a pop only needs one compare and swap on the shared
+    /// position.
+    template<typename T>
+    class BoundedQueue
+    {
+      /// \brief Constructor.
+      /// \param[in] _capacity Maximum number of elements, at least one.
+      public: explicit BoundedQueue(const size_t _capacity)
+              : slots(std::max(_capacity, static_cast<size_t>(1)))
+              {
+                for (size_t i = 0; i < this->slots.size(); ++i)
+                  this->slots[i].sequence.store(i, std::memory_order_relaxed);
+              }
+
+      /// \brief Get the maximum number of elements.
+      /// \return The capacity of the queue.
+      public: size_t Capacity() const
+              {
+                return this->slots.size();
+              }
+
+      /// \brief Add an element at the back of the queue.
+      /// \param[in] _value The element.
+      /// \return False if the queue is full.
+      public: bool Push(const T &_value)
+              {
+                Slot *slot = nullptr;
+                size_t pos = this->pushPos.load(std::memory_order_relaxed);
+                while (true)
+                {
+                  slot = &this->slots[pos % this->slots.size()];
+                  const size_t seq =
+                    slot->sequence.load(std::memory_order_acquire);
+                  const intptr_t diff =
+                    static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+                  if (diff == 0)
+                  {
+                    if (this->pushPos.compare_exchange_weak(pos, pos + 1,
+                          std::memory_order_relaxed))
+                    {
+                      break;
+                    }
+                  }
+                  else if (diff < 0)
+                    return false;
+                  else
+                    pos = this->pushPos.load(std::memory_order_relaxed);
+                }
+
+                slot->value = _value;
+                slot->sequence.store(pos + 1, std::memory_order_release);
+                return true;
+              }
+
+      /// \brief Remove the element at the front of the queue.
+      /// \param[out] _value The element.
+      /// \return False if the queue is empty.
+      public: bool Pop(T &_value)
+              {
+                Slot *slot = nullptr;
+                size_t pos = this->popPos.load(std::memory_order_relaxed);
+                while (true)
+                {
+                  slot = &this->slots[pos % this->slots.size()];
+                  const size_t seq =
+                    slot->sequence.load(std::memory_order_acquire);
+                  const intptr_t diff = static_cast<intptr_t>(seq) -
+                    static_cast<intptr_t>(pos + 1);
+
+                  if (diff == 0)
+                  {
+                    if (this->popPos.compare_exchange_weak(pos, pos + 1,
+                          std::memory_order_relaxed))
+                    {
+                      break;
+                    }
+                  }
+                  else if (diff < 0)
+                    return false;
+                  else
+                    pos = this->popPos.load(std::memory_order_relaxed);
+                }
+
+                _value = std::move(slot->value);
+                slot->value = T();
+                slot->sequence.store(pos + this->slots.size(),
+                    std::memory_order_release);
+                return true;
+              }
+
+      /// \brief Get the number of elements. The result is only a snapshot
+      /// when other threads use the queue.
+      /// \return Number of elements in the queue.
+      public: size_t Size() const
+              {
+                const size_t popped =
+                  this->popPos.load(std::memory_order_acquire);
+                const size_t pushed =
+                  this->pushPos.load(std::memory_order_acquire);
+                return pushed > popped ? pushed - popped : 0;
+              }
+
+      /// \brief Remove all the elements.
+      public: void Clear()
+              {
+                T value;
+                while (this->Pop(value))
+                  continue;
+              }
+
+      /// \brief A slot of the ring buffer.
+      private: struct Slot
+               {
+                 /// \brief Position at which the slot can next be written,
+                 /// or one past the position at which it can be read.
+                 std::atomic<size_t> sequence;
+
+                 /// \brief The element.
+                 T value;
+               };
+
+      /// \brief The ring buffer.
+      private: std::vector<Slot> slots;
+
+      /// \brief Position of the next push.
+      private: std::atomic<size_t> pushPos{0};
+
+      /// \brief Keeps the positions on separate cache lines, so producers
+      /// and consumers don't invalidate each other's line.
+      private: char padding[64];
+
+      /// \brief Position of the next pop.
+      private: std::atomic<size_t> popPos{0};
+    };
+    /// \}
+  }
+}
+#endif
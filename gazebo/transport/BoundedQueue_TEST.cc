@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gazebo/transport/BoundedQueue.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class BoundedQueueTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(BoundedQueueTest, PushPop)
+{
+  transport::BoundedQueue<int> queue(3);
+  EXPECT_EQ(3u, queue.Capacity());
+  EXPECT_EQ(0u, queue.Size());
+
+  int value = 0;
+  EXPECT_FALSE(queue.Pop(value));
+
+  EXPECT_TRUE(queue.Push(1));
+  EXPECT_TRUE(queue.Push(2));
+  EXPECT_TRUE(queue.Push(3));
+  EXPECT_FALSE(queue.Push(4));
+  EXPECT_EQ(3u, queue.Size());
+
+  // Elements come out in order, and the slots are reused
+  for (int lap = 0; lap < 5; ++lap)
+  {
+    EXPECT_TRUE(queue.Pop(value));
+    EXPECT_EQ(lap + 1, value);
+    EXPECT_TRUE(queue.Push(lap + 4));
+    EXPECT_EQ(3u, queue.Size());
+  }
+
+  queue.Clear();
+  EXPECT_EQ(0u, queue.Size());
+  EXPECT_FALSE(queue.Pop(value));
+
+  // A zero capacity queue holds one element
+  transport::BoundedQueue<int> single(0);
+  EXPECT_EQ(1u, single.Capacity());
+}
+
+/////////////////////////////////////////////////
+TEST_F(BoundedQueueTest, Release)
+{
+  // Popped elements must not be kept alive by the queue
+  transport::BoundedQueue<std::shared_ptr<int>> queue(2);
+  std::shared_ptr<int> value(new int(5));
+  EXPECT_TRUE(queue.Push(value));
+  EXPECT_EQ(2, value.use_count());
+
+  std::shared_ptr<int> popped;
+  EXPECT_TRUE(queue.Pop(popped));
+  popped.reset();
+  EXPECT_EQ(1, value.use_count());
+}
+
+/////////////////////////////////////////////////
+TEST_F(BoundedQueueTest, Threads)
+{
+  const int producerCount = 4;
+  const int pushCount = 5000;
+
+  transport::BoundedQueue<int> queue(64);
+  std::atomic<int> done(0);
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < producerCount; ++p)
+  {
+    producers.push_back(std::thread([&queue, &done, p]()
+    {
+      for (int i = 0; i < pushCount; ++i)
+      {
+        while (!queue.Push(p * pushCount + i))
+          std::this_thread::yield();
+      }
+      ++done;
+    }));
+  }
+
+  // Every element is received once, and the elements of each producer
+  // are received in order.
+  std::vector<int> last(producerCount, -1);
+  int received = 0;
+  int value;
+  while (done < producerCount || queue.Size() > 0)
+  {
+    if (!queue.Pop(value))
+      continue;
+
+    const int producer = value / pushCount;
+    EXPECT_LT(last[producer], value % pushCount);
+    last[producer] = value % pushCount;
+    ++received;
+  }
+
+  for (auto &producer : producers)
+    producer.join();
+
+  EXPECT_EQ(producerCount * pushCount, received);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -19,6 +19,8 @@
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Events.hh"
+#include "gazebo/common/ProfileTimeline.hh"
+#include "gazebo/transport/ShmRing.hh"
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/transport/ConnectionManager.hh"
 
@@ -262,6 +264,8 @@ void ConnectionManager::Stop()
 //////////////////////////////////////////////////
 void ConnectionManager::RunUpdate()
 {
+  GZ_PROFILE("ConnectionManager::RunUpdate");
+
   std::list<ConnectionPtr>::iterator iter;
   std::list<ConnectionPtr>::iterator endIter;
 
@@ -307,6 +311,8 @@ void ConnectionManager::RunUpdate()
 //////////////////////////////////////////////////
 void ConnectionManager::Run()
 {
+  GZ_PROFILE_THREAD_NAME("ConnectionManager");
+
   boost::mutex::scoped_lock lock(this->updateMutex);
 
   this->stopped = false;
@@ -494,7 +500,7 @@ void ConnectionManager::OnRead(ConnectionPtr _connection,
     // Create a transport link for the publisher to the remote subscriber
     // via the connection
     SubscriptionTransportPtr subLink(new SubscriptionTransport());
-    subLink->Init(_connection, sub.latching());
+    subLink->Init(_connection, sub.latching(), sub.shm());
 
     // Connect the publisher to this transport mechanism
     TopicManager::Instance()->ConnectPubToSub(sub.topic(), subLink);
@@ -515,6 +521,7 @@ void ConnectionManager::Advertise(const std::string &topic,
   msg.set_msg_type(msgType);
   msg.set_host(this->serverConn->GetLocalAddress());
   msg.set_port(this->serverConn->GetLocalPort());
+  msg.set_shm(ShmRing::Enabled());
 
   this->masterConn->EnqueueMsg(msgs::Package("advertise", msg));
 }
@@ -15,12 +15,45 @@
  *
 */
 
+#include <algorithm>
 #include <boost/bind/bind.hpp>
 #include <boost/function.hpp>
 #include "gazebo/common/WeakBind.hh"
 #include "SubscriptionTransport.hh"
 #include "Publication.hh"
 #include "Node.hh"
+#include "ShmRing.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief Private data for Publication.
+    class PublicationPrivate
+    {
+      /// \brief Get the shared memory ring of the publication, creating
+      /// it, or replacing it with larger slots, if needed. Must be called
+      /// with the callback mutex of the publication locked.
+      /// \param[in] _topic Topic of the publication.
+      /// \param[in] _size Size of the message to write.
+      /// \return The ring, null if messages must be sent over TCP.
+      public: ShmRingPtr SharedMemory(const std::string &_topic,
+                  const size_t _size);
+
+      /// \brief Shared memory for the subscribers on this host.
+      public: ShmRingPtr shmRing;
+
+      /// \brief True if shared memory could not be created.
+      public: bool shmFailed = false;
+
+      /// \brief Mutex to protect the last messages. Separate from the
+      /// callback mutex so that publishing threads don't wait for the
+      /// delivery of previous messages.
+      public: boost::mutex prevMsgMutex;
+    };
+  }
+}
 
 using namespace gazebo;
 using namespace transport;
@@ -30,7 +63,8 @@ unsigned int Publication::idCounter = 0;
 
 //////////////////////////////////////////////////
 Publication::Publication(const std::string &_topic, const std::string &_msgType)
-  : topic(_topic), msgType(_msgType), locallyAdvertised(false)
+  : topic(_topic), msgType(_msgType), locallyAdvertised(false),
+    dataPtr(new PublicationPrivate)
 {
   this->id = idCounter++;
 }
@@ -59,7 +93,7 @@ void Publication::AddSubscription(const NodePtr &_node)
     this->nodes.push_back(_node);
   }
 
-  boost::mutex::scoped_lock lock(this->callbackMutex);
+  boost::mutex::scoped_lock lock(this->dataPtr->prevMsgMutex);
 
   // Send latched messages to the subscription.
   for (std::map<uint32_t, MessagePtr>::iterator pubIter =
@@ -86,6 +120,8 @@ void Publication::AddSubscription(const CallbackHelperPtr _callback)
 
     if (_callback->GetLatching())
     {
+      boost::mutex::scoped_lock prevLock(this->dataPtr->prevMsgMutex);
+
       // Send latched messages to the subscription.
       for (std::map<uint32_t, MessagePtr>::iterator pubIter =
           this->prevMsgs.begin(); pubIter != this->prevMsgs.end(); ++pubIter)
@@ -103,14 +139,14 @@ void Publication::AddSubscription(const CallbackHelperPtr _callback)
 //////////////////////////////////////////////////
 void Publication::SetPrevMsg(uint32_t _pubId, MessagePtr _msg)
 {
-  boost::mutex::scoped_lock lock(this->callbackMutex);
+  boost::mutex::scoped_lock lock(this->dataPtr->prevMsgMutex);
   this->prevMsgs[_pubId] = _msg;
 }
 
 //////////////////////////////////////////////////
 void Publication::ClearPrevMsgs()
 {
-  boost::mutex::scoped_lock lock(this->callbackMutex);
+  boost::mutex::scoped_lock lock(this->dataPtr->prevMsgMutex);
   this->prevMsgs.clear();
 }
 
@@ -316,19 +352,59 @@ int Publication::Publish(MessagePtr _msg, boost::function<void(uint32_t)> _cb,
   // will clean up the nodes that have then been marked for removal
   this->RemoveNodes();
 
+  // Serialize once, outside the lock, for all the remote connections
+  std::string data;
+  bool serialized = false;
+  if (this->GetCallbackCount() > 0)
+  {
+    _msg->SerializeToString(&data);
+    serialized = true;
+  }
+
   {
     boost::mutex::scoped_lock lock(this->callbackMutex);
 
     if (!this->callbacks.empty())
     {
-      std::string data;
-      _msg->SerializeToString(&data);
+      // A callback may have been added since we checked
+      if (!serialized)
+        _msg->SerializeToString(&data);
+
+      // Written to shared memory at most once, for all the subscribers on
+      // this host that opened the ring.
+      ShmRingPtr ring;
+      std::string frame;
+
       std::list<CallbackHelperPtr>::iterator cbIter;
       cbIter = this->callbacks.begin();
 
       while (cbIter != this->callbacks.end())
       {
-        if ((*cbIter)->HandleData(data, _cb, _id))
+        SubscriptionTransportPtr subLink;
+        if (!(*cbIter)->IsLocal() && data.size() >= ShmRing::MinSize)
+        {
+          subLink = boost::dynamic_pointer_cast<SubscriptionTransport>(
+              *cbIter);
+          if (subLink && !subLink->SharedMemory())
+            subLink.reset();
+        }
+
+        if (subLink && !ring)
+          ring = this->dataPtr->SharedMemory(this->topic, data.size());
+
+        bool handled;
+        if (subLink && ring)
+        {
+          if (frame.empty() && subLink->RingAccepted(ring->Name()))
+            ring->Write(data, frame);
+          handled = subLink->HandleRing(ring, frame, data, _cb, _id);
+        }
+        else
+        {
+          handled = (*cbIter)->HandleData(data, _cb, _id);
+        }
+
+        if (handled)
         {
           ++result;
           ++cbIter;
@@ -516,12 +592,44 @@ void Publication::RemoveNodes()
   }
 }
 
+//////////////////////////////////////////////////
+ShmRingPtr PublicationPrivate::SharedMemory(const std::string &_topic,
+    const size_t _size)
+{
+  if (this->shmFailed)
+    return ShmRingPtr();
+
+  // The slots are sized for the largest message seen so far. The old ring
+  // is kept by the frames that point to it until they are sent, and the
+  // new ring is offered to the subscribers.
+  if (!this->shmRing || _size > this->shmRing->SlotSize())
+  {
+    const size_t slotSize = std::max(static_cast<size_t>(4 * 1024 * 1024),
+        2 * _size);
+
+    ShmRingPtr ring(new ShmRing());
+    if (!ring->Create(8, slotSize))
+    {
+      // Send everything over TCP from now on
+      gzwarn << "Unable to use shared memory for topic[" << _topic
+             << "]. Falling back to TCP.\n";
+      this->shmFailed = true;
+      this->shmRing.reset();
+      return ShmRingPtr();
+    }
+    this->shmRing = ring;
+  }
+
+  return this->shmRing;
+}
+
 //////////////////////////////////////////////////
 MessagePtr Publication::GetPrevMsg(uint32_t _pubId)
 {
-  boost::mutex::scoped_lock lock(this->callbackMutex);
-  if (this->prevMsgs.find(_pubId) != this->prevMsgs.end())
-    return this->prevMsgs[_pubId];
+  boost::mutex::scoped_lock lock(this->dataPtr->prevMsgMutex);
+  auto iter = this->prevMsgs.find(_pubId);
+  if (iter != this->prevMsgs.end())
+    return iter->second;
   else
     return MessagePtr();
 }
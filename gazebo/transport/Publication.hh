@@ -23,6 +23,7 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/thread/mutex.hpp>
 #include <list>
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
@@ -36,6 +37,8 @@ namespace gazebo
 {
   namespace transport
   {
+    class PublicationPrivate;
+
     /// \addtogroup gazebo_transport
     /// \{
 
@@ -211,6 +214,10 @@ namespace gazebo
 
       /// \brief Publishers and their last messages.
       private: std::map<uint32_t, MessagePtr> prevMsgs;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PublicationPrivate> dataPtr;
     };
     /// \}
   }
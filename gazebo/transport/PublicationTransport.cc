@@ -18,8 +18,33 @@
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/transport/ConnectionManager.hh"
 #include "gazebo/transport/PublicationTransport.hh"
+#include "gazebo/transport/ShmRing.hh"
 #include "gazebo/common/WeakBind.hh"
 
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief Private data for PublicationTransport.
+    class PublicationTransportPrivate
+    {
+      /// \brief True if the publisher sends frames, see ShmRing.
+      public: bool shm = false;
+
+      /// \brief Shared memory of the publisher, opened when it is offered.
+      public: ShmRingPtr ring;
+
+      /// \brief Number of messages lost because their slot was reused
+      /// before they were read.
+      public: uint64_t dropped = 0;
+
+      /// \brief True once the ring was rejected after a lost message.
+      public: bool rejected = false;
+    };
+  }
+}
+
 using namespace gazebo;
 using namespace transport;
 
@@ -28,7 +53,8 @@ int PublicationTransport::counter = 0;
 /////////////////////////////////////////////////
 PublicationTransport::PublicationTransport(const std::string &_topic,
                                            const std::string &_msgType)
-: topic(_topic), msgType(_msgType)
+: topic(_topic), msgType(_msgType),
+  dataPtr(new PublicationTransportPrivate)
 {
   this->id = counter++;
   TopicManager::Instance()->UpdatePublications(this->topic, this->msgType);
@@ -55,14 +81,23 @@ PublicationTransport::~PublicationTransport()
 
 /////////////////////////////////////////////////
 void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
+{
+  this->Init(_conn, _latched, false);
+}
+
+/////////////////////////////////////////////////
+void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched,
+    bool _shm)
 {
   this->connection = _conn;
+  this->dataPtr->shm = _shm;
   msgs::Subscribe sub;
   sub.set_topic(this->topic);
   sub.set_msg_type(this->msgType);
   sub.set_host(this->connection->GetLocalAddress());
   sub.set_port(this->connection->GetLocalPort());
   sub.set_latching(_latched);
+  sub.set_shm(_shm);
 
   this->connection->EnqueueMsg(msgs::Package("sub", sub));
 
@@ -91,14 +126,101 @@ void PublicationTransport::OnPublish(const std::string &_data)
         common::weakBind(&PublicationTransport::OnPublish,
             this->shared_from_this(), _1));
 
-    if (!_data.empty())
+    if (_data.empty())
+      return;
+
+    if (this->dataPtr->shm && _data[0] == ShmRing::OfferTag)
+    {
+      this->OnOffer(_data.substr(1));
+    }
+    else if (this->callback)
     {
-      if (this->callback)
+      if (!this->dataPtr->shm)
+      {
         (this->callback)(_data);
+      }
+      else
+      {
+        std::string data;
+        if (this->ReadFrame(_data, data))
+          (this->callback)(data);
+      }
     }
   }
 }
 
+/////////////////////////////////////////////////
+void PublicationTransport::OnOffer(const std::string &_name)
+{
+  // Accept the ring only once it is mapped, so that the publisher never
+  // sends a frame that we can't read.
+  ShmRingPtr offered(new ShmRing());
+  if (ShmRing::Enabled() && offered->Open(_name))
+  {
+    this->dataPtr->ring = offered;
+    this->connection->EnqueueMsg(ShmRing::AcceptTag + _name);
+  }
+  else
+  {
+    gzwarn << "Unable to open shared memory[" << _name << "] of topic["
+           << this->topic << "]. Large messages are sent over TCP.\n";
+    this->connection->EnqueueMsg(ShmRing::RejectTag + _name);
+  }
+}
+
+/////////////////////////////////////////////////
+bool PublicationTransport::ReadFrame(const std::string &_frame,
+    std::string &_data)
+{
+  if (_frame[0] == ShmRing::InlineTag)
+  {
+    _data = _frame.substr(1);
+    return true;
+  }
+
+  const std::string name = ShmRing::FrameName(_frame);
+  if (name.empty())
+  {
+    gzerr << "Invalid frame on topic[" << this->topic << "]\n";
+    return false;
+  }
+
+  // Frames only point to the ring we accepted last, see OnOffer
+  if (!this->dataPtr->ring || this->dataPtr->ring->Name() != name)
+  {
+    gzerr << "Frame of shared memory[" << name << "] that wasn't accepted, "
+          << "on topic[" << this->topic << "]\n";
+    return false;
+  }
+
+  // Fails if the publisher reused the slot before we got to it
+  if (this->dataPtr->ring->Read(_frame, _data))
+    return true;
+
+  ++this->dataPtr->dropped;
+  if (this->dataPtr->dropped == 1)
+  {
+    gzwarn << "Message on topic[" << this->topic << "] lost, its shared "
+           << "memory slot was reused before it was read. Receiving large "
+           << "messages inline.\n";
+  }
+  else
+  {
+    gzlog << this->dataPtr->dropped << " messages on topic["
+          << this->topic << "] lost in shared memory\n";
+  }
+
+  // The publisher writes faster than we read. Reject the ring, so that
+  // the next messages are queued on the connection instead of lost.
+  if (!this->dataPtr->rejected)
+  {
+    this->dataPtr->rejected = true;
+    this->connection->EnqueueMsg(ShmRing::RejectTag + name);
+  }
+
+  return false;
+}
+
 /////////////////////////////////////////////////
 const ConnectionPtr PublicationTransport::GetConnection() const
 {
@@ -20,9 +20,11 @@
 
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
+#include <memory>
 #include <string>
 
 #include "gazebo/transport/Connection.hh"
+#include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/common/Event.hh"
 #include "gazebo/util/system.hh"
 
@@ -30,6 +32,8 @@ namespace gazebo
 {
   namespace transport
   {
+    class PublicationTransportPrivate;
+
     /// \addtogroup gazebo_transport
     /// \{
 
@@ -55,6 +59,15 @@ namespace gazebo
       /// topic.
       public: void Init(const ConnectionPtr &_conn, bool _latched);
 
+      /// \brief Initialize the transport
+      /// \param[in] _conn The underlying connection.
+      /// \param[in] _latched True to grab the last message sent on the
+      /// topic.
+      /// \param[in] _shm True to ask for large messages through shared
+      /// memory, see ShmRing.
+      public: void Init(const ConnectionPtr &_conn, bool _latched,
+                  bool _shm);
+
       /// \brief Finalize the transport
       public: void Fini();
 
@@ -79,6 +92,18 @@ namespace gazebo
       /// \param[in] _data Data to be published.
       private: void OnPublish(const std::string &_data);
 
+      /// \brief Map a ring offered by the publisher, and tell it whether
+      /// frames that point to the ring can be sent.
+      /// \param[in] _name Name of the ring.
+      private: void OnOffer(const std::string &_name);
+
+      /// \brief Extract the message from a frame of a shared memory
+      /// connection.
+      /// \param[in] _frame The frame.
+      /// \param[out] _data The serialized message.
+      /// \return False if the message was lost.
+      private: bool ReadFrame(const std::string &_frame, std::string &_data);
+
       /// \brief The topic for this publication transport.
       private: std::string topic;
 
@@ -96,6 +121,10 @@ namespace gazebo
 
       /// \brief The unique id for the publication transport.
       private: int id;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PublicationTransportPrivate> dataPtr;
     };
     /// \}
   }
@@ -18,10 +18,13 @@
  * Author: Nate Koenig
  */
 
+#include <atomic>
+
 #include <ignition/math/Helpers.hh>
 
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/WeakBind.hh"
+#include "gazebo/transport/BoundedQueue.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/transport/Publisher.hh"
@@ -31,16 +34,41 @@ using namespace transport;
 
 uint32_t Publisher::idCounter = 0;
 
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief Private data for Publisher
+    class PublisherPrivate
+    {
+      /// \brief Constructor.
+      /// \param[in] _limit Maximum number of queued messages.
+      public: explicit PublisherPrivate(const unsigned int _limit)
+        : messages(_limit)
+      {
+      }
+
+      /// \brief True if queueLimit has been reached, and a warning message
+      /// was produced.
+      public: std::atomic<bool> queueLimitWarned{false};
+
+      /// \brief Messages to publish, holds at most queueLimit messages.
+      /// Publishing threads push without locking.
+      public: BoundedQueue<MessagePtr> messages;
+    };
+  }
+}
+
 //////////////////////////////////////////////////
 Publisher::Publisher(const std::string &_topic, const std::string &_msgType,
                      unsigned int _limit, double _hzRate)
   : topic(_topic), msgType(_msgType), queueLimit(_limit),
-    updatePeriod(0)
+    updatePeriod(0), dataPtr(new PublisherPrivate(_limit))
 {
   if (!ignition::math::equal(_hzRate, 0.0))
     this->updatePeriod = 1.0 / _hzRate;
 
-  this->queueLimitWarned = false;
   this->pubId = 0;
   this->id = ++idCounter;
 }
@@ -83,8 +111,7 @@ bool Publisher::WaitForConnection(const common::Time &_timeout) const
 }
 
 //////////////////////////////////////////////////
-void Publisher::PublishImpl(const google::protobuf::Message &_message,
-                            bool _block)
+bool Publisher::Accept(const google::protobuf::Message &_message)
 {
   if (_message.GetTypeName() != this->msgType)
     gzthrow("Invalid message type\n");
@@ -94,7 +121,7 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
     gzerr << "Publishing an uninitialized message on topic[" <<
       this->topic << "]. Required field [" <<
       _message.InitializationErrorString() << "] missing.\n";
-    return;
+    return false;
   }
 
   // Check if a throttling rate has been set
@@ -108,36 +135,67 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
         (this->currentTime - this->prevPublishTime).Double() <
         this->updatePeriod)
     {
-      return;
+      return false;
     }
 
     // Set the previous time a message was published
     this->prevPublishTime = this->currentTime;
   }
 
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Publisher::PublishImpl(const google::protobuf::Message &_message,
+                            bool _block)
+{
+  if (!this->Accept(_message))
+    return;
+
   // Save the latest message
   MessagePtr msgPtr(_message.New());
   msgPtr->CopyFrom(_message);
 
-  this->publication->SetPrevMsg(this->id, msgPtr);
+  this->Enqueue(msgPtr, _block);
+}
 
+//////////////////////////////////////////////////
+void Publisher::PublishImpl(const MessagePtr &_message, bool _block,
+    bool _copy)
+{
+  if (!_message)
   {
-    boost::mutex::scoped_lock lock(this->mutex);
+    gzerr << "Publishing a null message on topic[" << this->topic << "]\n";
+    return;
+  }
 
-    this->messages.push_back(msgPtr);
+  if (_copy)
+    this->PublishImpl(*_message, _block);
+  else if (this->Accept(*_message))
+    this->Enqueue(_message, _block);
+}
 
-    if (this->messages.size() > this->queueLimit)
+//////////////////////////////////////////////////
+void Publisher::Enqueue(const MessagePtr &_message, bool _block)
+{
+  this->publication->SetPrevMsg(this->id, _message);
+
+  // Drop the oldest messages until there is room for the new one
+  if (!this->dataPtr->messages.Push(_message))
+  {
+    MessagePtr oldest;
+    do
     {
-      this->messages.pop_front();
+      this->dataPtr->messages.Pop(oldest);
+    }
+    while (!this->dataPtr->messages.Push(_message));
 
-      if (!queueLimitWarned)
-      {
-        gzwarn << "Queue limit reached for topic "
-          << this->topic
-          << ", deleting message. "
-          << "This warning is printed only once." << std::endl;
-        queueLimitWarned = true;
-      }
+    if (!this->dataPtr->queueLimitWarned.exchange(true))
+    {
+      gzwarn << "Queue limit reached for topic "
+        << this->topic
+        << ", deleting message. "
+        << "This warning is printed only once." << std::endl;
     }
   }
 
@@ -162,21 +220,22 @@ void Publisher::SendMessage()
 
   {
     boost::mutex::scoped_lock lock(this->mutex);
-    if (!this->pubIds.empty() || this->messages.empty())
+    if (!this->pubIds.empty())
     {
       return;
     }
 
-    for (unsigned int i = 0; i < this->messages.size(); ++i)
+    // Only take the messages that were queued when we started, so a fast
+    // publisher can't keep us here forever.
+    MessagePtr msg;
+    for (size_t count = this->dataPtr->messages.Size();
+         count > 0 && this->dataPtr->messages.Pop(msg); --count)
     {
       this->pubId = (this->pubId + 1) % 10000;
       this->pubIds[this->pubId] = 0;
       localIds.push_back(this->pubId);
+      localBuffer.push_back(msg);
     }
-
-    std::copy(this->messages.begin(), this->messages.end(),
-        std::back_inserter(localBuffer));
-    this->messages.clear();
   }
 
   // Only send messages if there is something to send
@@ -261,8 +320,7 @@ void Publisher::SetNode(NodePtr _node)
 //////////////////////////////////////////////////
 unsigned int Publisher::GetOutgoingCount() const
 {
-  boost::mutex::scoped_lock lock(this->mutex);
-  return this->messages.size();
+  return this->dataPtr->messages.Size();
 }
 
 //////////////////////////////////////////////////
@@ -316,9 +374,9 @@ unsigned int Publisher::GetRemoteSubscriptionCount()
 //////////////////////////////////////////////////
 void Publisher::Fini()
 {
-  if (!this->messages.empty())
+  if (this->dataPtr->messages.Size() > 0)
     this->SendMessage();
-  this->messages.clear();
+  this->dataPtr->messages.Clear();
 
   if (!this->topic.empty())
     TopicManager::Instance()->Unadvertise(this->topic, this->id);
@@ -24,8 +24,9 @@
 #include <google/protobuf/message.h>
 #include <boost/thread.hpp>
 #include <boost/shared_ptr.hpp>
-#include <string>
 #include <list>
+#include <memory>
+#include <string>
 #include <map>
 
 #include "gazebo/common/Time.hh"
@@ -36,6 +37,8 @@ namespace gazebo
 {
   namespace transport
   {
+    class PublisherPrivate;
+
     /// \addtogroup gazebo_transport
     /// \{
 
@@ -101,6 +104,32 @@ namespace gazebo
               void Publish(M _message, bool _block = false)
               { this->PublishImpl(_message, _block); }
 
+      /// \brief Publish a message without copying it. The publisher, and
+      /// the local subscribers, share ownership of the message. It's only
+      /// shared through a pointer to const, so that it can't be modified
+      /// while it's queued.
+      /// \param[in] _message Message to be published
+      /// \param[in] _block Whether to block until the message is actually
+      /// written into the local message buffer, and SendMessage() is called.
+      public: template<typename M>
+              void Publish(const boost::shared_ptr<const M> &_message,
+                           bool _block = false)
+              {
+                this->PublishImpl(boost::const_pointer_cast<M>(_message),
+                    _block, false);
+              }
+
+      /// \brief Publish a copy of a message held by a pointer to non-const.
+      /// The caller may still modify the message, so it isn't shared. Pass
+      /// a pointer to const to publish it without a copy.
+      /// \param[in] _message Message to be published
+      /// \param[in] _block Whether to block until the message is actually
+      /// written into the local message buffer, and SendMessage() is called.
+      public: template<typename M>
+              void Publish(const boost::shared_ptr<M> &_message,
+                           bool _block = false)
+              { this->PublishImpl(_message, _block, true); }
+
       /// \brief Get the number of outgoing messages
       /// \return The number of outgoing messages
       public: unsigned int GetOutgoingCount() const;
@@ -147,6 +176,26 @@ namespace gazebo
       private: void PublishImpl(const google::protobuf::Message &_message,
                                 bool _block);
 
+      /// \brief Implementation of Publish, for messages held by a pointer.
+      /// \param[in] _message Message to be published.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      /// \param[in] _copy True to publish a copy of the message, false to
+      /// share it.
+      private: void PublishImpl(const MessagePtr &_message, bool _block,
+                   bool _copy);
+
+      /// \brief Check the type of a message, and apply the rate limit.
+      /// \param[in] _message Message to be published.
+      /// \return True if the message should be published.
+      private: bool Accept(const google::protobuf::Message &_message);
+
+      /// \brief Save a message as the latest one, and queue it.
+      /// \param[in] _message Message to be published.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void Enqueue(const MessagePtr &_message, bool _block);
+
       /// \brief Callback when a publish is completed
       /// \param[in] _id ID associated with the publication.
       private: void OnPublishComplete(uint32_t _id);
@@ -165,14 +214,12 @@ namespace gazebo
       /// limit.
       private: double updatePeriod;
 
-      /// \brief True if queueLimit has been reached, and a warning message
-      /// was produced.
-      private: bool queueLimitWarned;
-
-      /// \brief List of messages to publish.
-      private: std::list<MessagePtr> messages;
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PublisherPrivate> dataPtr;
 
-      /// \brief For mutual exclusion.
+      /// \brief For mutual exclusion of SendMessage and the publication
+      /// ids.
       private: mutable boost::mutex mutex;
 
       /// \brief The publication pointers. One for normal publication, and
@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/ShmRing.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+/// \brief Identifies a mapped ring.
+static const uint32_t kShmRingMagic = 0x475a5352;
+
+/// \brief Header at the start of the shared memory.
+struct ShmRingHeader
+{
+  /// \brief Always kShmRingMagic.
+  uint32_t magic;
+
+  /// \brief Number of slots.
+  uint32_t slotCount;
+
+  /// \brief Maximum size of a message.
+  uint64_t slotSize;
+};
+
+/// \brief Header of a slot, followed by the message.
+struct ShmRingSlot
+{
+  /// \brief Odd while the slot is written, otherwise twice the sequence
+  /// number of the message plus two.
+  std::atomic<uint64_t> sequence;
+
+  /// \brief Size of the message.
+  uint64_t size;
+};
+
+/// \brief Size of a slot frame, before the name of the ring.
+static const size_t kSlotFrameSize = 1 + 2 * sizeof(uint64_t);
+
+/// \brief Align slots on cache lines.
+static const size_t kShmRingAlign = 64;
+
+/// \brief Offset of the first slot.
+static const size_t kShmRingHeaderSize =
+    (sizeof(ShmRingHeader) + kShmRingAlign - 1) / kShmRingAlign *
+    kShmRingAlign;
+
+const char ShmRing::InlineTag;
+const char ShmRing::SlotTag;
+const char ShmRing::OfferTag;
+const char ShmRing::AcceptTag;
+const char ShmRing::RejectTag;
+const size_t ShmRing::MinSize;
+
+//////////////////////////////////////////////////
+ShmRing::ShmRing()
+{
+}
+
+//////////////////////////////////////////////////
+ShmRing::~ShmRing()
+{
+  this->Close();
+}
+
+//////////////////////////////////////////////////
+bool ShmRing::Enabled()
+{
+#ifdef _WIN32
+  return false;
+#else
+  const char *env = std::getenv("GAZEBO_TRANSPORT_SHM");
+  return !env || std::string(env) != "0";
+#endif
+}
+
+//////////////////////////////////////////////////
+bool ShmRing::Create(const unsigned int _slotCount, const size_t _slotSize)
+{
+#ifdef _WIN32
+  return false;
+#else
+  this->Close();
+
+  static std::atomic<unsigned int> counter(0);
+  const std::string shmName = "/gazebo_shm_" + std::to_string(getpid()) + "_" +
+      std::to_string(counter++);
+
+  this->slotStride = (sizeof(ShmRingSlot) + _slotSize + kShmRingAlign - 1) /
+      kShmRingAlign * kShmRingAlign;
+  this->size = kShmRingHeaderSize + this->slotStride * _slotCount;
+
+  // Remove a leftover of a crashed process
+  shm_unlink(shmName.c_str());
+
+  // Only readable by the user, since the messages may be private
+  int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0)
+  {
+    gzwarn << "Unable to create shared memory [" << shmName << "]: "
+           << strerror(errno) << "\n";
+    return false;
+  }
+
+  // The pages are only allocated when they are written
+  if (ftruncate(fd, this->size) != 0)
+  {
+    gzwarn << "Unable to size shared memory [" << shmName << "]: "
+           << strerror(errno) << "\n";
+    close(fd);
+    shm_unlink(shmName.c_str());
+    return false;
+  }
+
+  void *mem = mmap(nullptr, this->size, PROT_READ | PROT_WRITE, MAP_SHARED,
+      fd, 0);
+  close(fd);
+  if (mem == MAP_FAILED)
+  {
+    shm_unlink(shmName.c_str());
+    return false;
+  }
+
+  this->memory = static_cast<unsigned char *>(mem);
+  this->name = shmName;
+  this->slotCount = _slotCount;
+  this->slotSize = _slotSize;
+  this->owner = true;
+  this->sequence = 0;
+
+  ShmRingHeader *header = reinterpret_cast<ShmRingHeader *>(this->memory);
+  header->slotCount = _slotCount;
+  header->slotSize = _slotSize;
+  for (unsigned int i = 0; i < _slotCount; ++i)
+  {
+    ShmRingSlot *slot = new (this->memory + kShmRingHeaderSize +
+        i * this->slotStride) ShmRingSlot;
+    slot->sequence.store(0, std::memory_order_relaxed);
+    slot->size = 0;
+  }
+
+  // Readers check the magic number last
+  std::atomic_thread_fence(std::memory_order_release);
+  header->magic = kShmRingMagic;
+
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool ShmRing::Open(const std::string &_name)
+{
+#ifdef _WIN32
+  return false;
+#else
+  this->Close();
+
+  int fd = shm_open(_name.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+    return false;
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 ||
+      static_cast<size_t>(info.st_size) < sizeof(ShmRingHeader))
+  {
+    close(fd);
+    return false;
+  }
+
+  void *mem = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mem == MAP_FAILED)
+    return false;
+
+  this->memory = static_cast<unsigned char *>(mem);
+  this->size = info.st_size;
+  this->name = _name;
+  this->owner = false;
+
+  const ShmRingHeader *header =
+    reinterpret_cast<const ShmRingHeader *>(this->memory);
+  this->slotCount = header->slotCount;
+  this->slotSize = header->slotSize;
+  this->slotStride = (sizeof(ShmRingSlot) + this->slotSize +
+      kShmRingAlign - 1) / kShmRingAlign * kShmRingAlign;
+
+  if (header->magic != kShmRingMagic || this->slotCount == 0 ||
+      kShmRingHeaderSize + this->slotStride * this->slotCount > this->size)
+  {
+    gzerr << "Invalid shared memory [" << _name << "]\n";
+    this->Close();
+    return false;
+  }
+
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+std::string ShmRing::Name() const
+{
+  return this->name;
+}
+
+//////////////////////////////////////////////////
+size_t ShmRing::SlotSize() const
+{
+  return this->slotSize;
+}
+
+//////////////////////////////////////////////////
+bool ShmRing::Write(const std::string &_data, std::string &_frame)
+{
+  if (!this->memory || !this->owner || _data.size() > this->slotSize)
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->writeMutex);
+
+  const uint64_t seq = ++this->sequence;
+  unsigned char *start = this->memory + kShmRingHeaderSize +
+      (seq % this->slotCount) * this->slotStride;
+  ShmRingSlot *slot = reinterpret_cast<ShmRingSlot *>(start);
+
+  // Mark the slot as being written, then publish the new sequence number
+  // once the message is complete.
+  slot->sequence.store(2 * seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot->size = _data.size();
+  std::memcpy(start + sizeof(ShmRingSlot), _data.data(), _data.size());
+  slot->sequence.store(2 * seq + 2, std::memory_order_release);
+
+  const uint64_t size = _data.size();
+  _frame.resize(kSlotFrameSize);
+  _frame[0] = SlotTag;
+  std::memcpy(&_frame[1], &seq, sizeof(seq));
+  std::memcpy(&_frame[1 + sizeof(seq)], &size, sizeof(size));
+  _frame += this->name;
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ShmRing::Read(const std::string &_frame, std::string &_data) const
+{
+  if (!this->memory || _frame.size() < kSlotFrameSize ||
+      _frame[0] != SlotTag)
+  {
+    return false;
+  }
+
+  uint64_t seq;
+  uint64_t size;
+  std::memcpy(&seq, &_frame[1], sizeof(seq));
+  std::memcpy(&size, &_frame[1 + sizeof(seq)], sizeof(size));
+  if (size > this->slotSize)
+    return false;
+
+  const unsigned char *start = this->memory + kShmRingHeaderSize +
+      (seq % this->slotCount) * this->slotStride;
+  const ShmRingSlot *slot = reinterpret_cast<const ShmRingSlot *>(start);
+
+  if (slot->sequence.load(std::memory_order_acquire) != 2 * seq + 2)
+    return false;
+
+  _data.assign(reinterpret_cast<const char *>(start + sizeof(ShmRingSlot)),
+      size);
+
+  // The writer may have reused the slot while we were copying
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return slot->sequence.load(std::memory_order_relaxed) == 2 * seq + 2;
+}
+
+//////////////////////////////////////////////////
+std::string ShmRing::FrameName(const std::string &_frame)
+{
+  if (_frame.size() <= kSlotFrameSize || _frame[0] != SlotTag)
+    return std::string();
+  return _frame.substr(kSlotFrameSize);
+}
+
+//////////////////////////////////////////////////
+void ShmRing::Close()
+{
+#ifndef _WIN32
+  if (this->memory)
+    munmap(this->memory, this->size);
+
+  if (this->owner && !this->name.empty())
+    shm_unlink(this->name.c_str());
+#endif
+
+  this->memory = nullptr;
+  this->size = 0;
+  this->name.clear();
+  this->owner = false;
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_SHMRING_HH_
+#define GAZEBO_TRANSPORT_SHMRING_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \class ShmRing ShmRing.hh transport/transport.hh
+    /// \brief A ring of preallocated shared memory slots, used to pass
+    /// large messages to subscribers on the same host.
+    ///
+    /// A publication writes each large message once in the next slot, and
+    /// sends a small frame over TCP that tells the subscribers which slot
+    /// to read. Every slot has a sequence number, so a reader can tell
+    /// whether the slot was overwritten while it was late, in which case
+    /// the message is dropped and the subscriber rejects the ring, so that
+    /// the next messages are sent inline.
+    ///
+    /// Frames sent on a connection that negotiated shared memory start
+    /// with a tag: InlineTag followed by the serialized message, SlotTag
+    /// followed by the location of the message in a ring, or OfferTag
+    /// followed by the name of a ring. The subscriber replies to an offer
+    /// with AcceptTag once it has mapped the ring, or with RejectTag.
+    /// Slot frames are only sent for accepted rings, and messages are
+    /// sent inline until then, or for good after a rejection.
+    ///
+    /// Rings can only be opened by the user that created them. Subscribers
+    /// run by other users reject them and get messages inline.
+    ///
+    /// Shared memory is only used on POSIX systems, and can be disabled by
+    /// setting the GAZEBO_TRANSPORT_SHM environment variable to 0.
+    class GZ_TRANSPORT_VISIBLE ShmRing
+    {
+      /// \brief Tag of a frame holding the message.
+      public: static const char InlineTag = 'D';
+
+      /// \brief Tag of a frame pointing to a slot of a ring.
+      public: static const char SlotTag = 'S';
+
+      /// \brief Tag of a frame offering a ring to a subscriber.
+      public: static const char OfferTag = 'O';
+
+      /// \brief Tag of the reply of a subscriber that mapped an offered
+      /// ring.
+      public: static const char AcceptTag = 'A';
+
+      /// \brief Tag of the reply of a subscriber that couldn't map an
+      /// offered ring.
+      public: static const char RejectTag = 'R';
+
+      /// \brief Messages smaller than this are sent inline.
+      public: static const size_t MinSize = 64 * 1024;
+
+      /// \brief Constructor.
+      public: ShmRing();
+
+      /// \brief Destructor. Removes the shared memory object if this
+      /// ring created it.
+      public: virtual ~ShmRing();
+
+      /// \brief Is shared memory transport available?
+      /// \return True on POSIX systems, unless disabled by the
+      /// GAZEBO_TRANSPORT_SHM environment variable.
+      public: static bool Enabled();
+
+      /// \brief Create a new ring, for writing. The shared memory object
+      /// gets a name unique to this process.
+      /// \param[in] _slotCount Number of slots.
+      /// \param[in] _slotSize Maximum size of a message.
+      /// \return True on success.
+      public: bool Create(const unsigned int _slotCount,
+                  const size_t _slotSize);
+
+      /// \brief Map an existing ring, for reading.
+      /// \param[in] _name Name of the shared memory object.
+      /// \return True on success.
+      public: bool Open(const std::string &_name);
+
+      /// \brief Get the name of the ring.
+      /// \return Name of the shared memory object, empty if the ring is not
+      /// mapped.
+      public: std::string Name() const;
+
+      /// \brief Get the maximum size of a message.
+      /// \return Size of a slot in bytes.
+      public: size_t SlotSize() const;
+
+      /// \brief Write a message in the next slot. Only valid for a ring
+      /// created by this object.
+      /// \param[in] _data Serialized message.
+      /// \param[out] _frame Frame that locates the message, to be sent to
+      /// the readers.
+      /// \return False if the message doesn't fit in a slot.
+      public: bool Write(const std::string &_data, std::string &_frame);
+
+      /// \brief Read the message located by a frame.
+      /// \param[in] _frame Frame produced by Write.
+      /// \param[out] _data Serialized message.
+      /// \return False if the frame is invalid, or the slot was
+      /// overwritten.
+      public: bool Read(const std::string &_frame, std::string &_data) const;
+
+      /// \brief Get the name of the ring a frame points to.
+      /// \param[in] _frame Frame produced by Write.
+      /// \return Name of the shared memory object, empty if the frame is
+      /// invalid.
+      public: static std::string FrameName(const std::string &_frame);
+
+      /// \brief Unmap the ring.
+      private: void Close();
+
+      /// \brief Name of the shared memory object.
+      private: std::string name;
+
+      /// \brief Start of the mapping.
+      private: unsigned char *memory = nullptr;
+
+      /// \brief Size of the mapping.
+      private: size_t size = 0;
+
+      /// \brief Number of slots.
+      private: unsigned int slotCount = 0;
+
+      /// \brief Maximum size of a message.
+      private: size_t slotSize = 0;
+
+      /// \brief Distance between two slots.
+      private: size_t slotStride = 0;
+
+      /// \brief True if this object created the ring.
+      private: bool owner = false;
+
+      /// \brief Sequence number of the last message written.
+      private: uint64_t sequence = 0;
+
+      /// \brief Serializes the writers.
+      private: std::mutex writeMutex;
+    };
+    /// \}
+  }
+}
+#endif
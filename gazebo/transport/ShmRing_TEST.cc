@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "gazebo/transport/ShmRing.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ShmRingTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(ShmRingTest, WriteRead)
+{
+  if (!transport::ShmRing::Enabled())
+  {
+    SUCCEED();
+    return;
+  }
+
+  transport::ShmRing writer;
+  ASSERT_TRUE(writer.Create(4, 100000));
+  EXPECT_FALSE(writer.Name().empty());
+  EXPECT_EQ(100000u, writer.SlotSize());
+
+  std::string data(70000, 'x');
+  data[5] = 'y';
+
+  std::string frame;
+  ASSERT_TRUE(writer.Write(data, frame));
+  EXPECT_EQ(transport::ShmRing::SlotTag, frame[0]);
+  EXPECT_LT(frame.size(), 100u);
+  EXPECT_EQ(writer.Name(), transport::ShmRing::FrameName(frame));
+
+  transport::ShmRing reader;
+  ASSERT_TRUE(reader.Open(transport::ShmRing::FrameName(frame)));
+  EXPECT_EQ(writer.Name(), reader.Name());
+  EXPECT_EQ(writer.SlotSize(), reader.SlotSize());
+
+  std::string result;
+  EXPECT_TRUE(reader.Read(frame, result));
+  EXPECT_EQ(data, result);
+
+  // A reader can't write
+  std::string readerFrame;
+  EXPECT_FALSE(reader.Write(data, readerFrame));
+
+  // Messages larger than a slot are rejected
+  EXPECT_FALSE(writer.Write(std::string(100001, 'z'), readerFrame));
+
+  // Once the slot is reused, the old frame is stale
+  std::string newFrame;
+  for (unsigned int i = 0; i < 4; ++i)
+    EXPECT_TRUE(writer.Write(std::string(10, 'a' + i), newFrame));
+  EXPECT_FALSE(reader.Read(frame, result));
+  EXPECT_TRUE(reader.Read(newFrame, result));
+  EXPECT_EQ(std::string(10, 'd'), result);
+
+  // Invalid frames
+  EXPECT_FALSE(reader.Read("", result));
+  EXPECT_FALSE(reader.Read(std::string(1, transport::ShmRing::InlineTag) +
+        "data", result));
+  EXPECT_TRUE(transport::ShmRing::FrameName("Dabc").empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmRingTest, OpenMissing)
+{
+  transport::ShmRing reader;
+  EXPECT_FALSE(reader.Open("/gazebo_shm_missing_ring"));
+  EXPECT_TRUE(reader.Name().empty());
+
+  std::string result;
+  EXPECT_FALSE(reader.Read(std::string(40, transport::ShmRing::SlotTag),
+        result));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
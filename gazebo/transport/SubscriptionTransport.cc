@@ -16,9 +16,56 @@
 */
 #include <boost/bind/bind.hpp>
 #include <boost/function.hpp>
+#include <boost/weak_ptr.hpp>
+#include <mutex>
+#include <string>
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/WeakBind.hh"
 #include "gazebo/transport/ConnectionManager.hh"
+#include "gazebo/transport/ShmRing.hh"
 #include "gazebo/transport/SubscriptionTransport.hh"
 
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief Private data for SubscriptionTransport.
+    class SubscriptionTransportPrivate
+    {
+      /// \brief Handle a reply of the subscriber to an offered ring, and
+      /// read the next one.
+      /// \param[in] _data The reply, see ShmRing::AcceptTag.
+      public: void OnReply(const std::string &_data);
+
+      /// \brief Read the next reply of the subscriber.
+      public: void ReadReply();
+
+      /// \brief Connection the replies are read from.
+      public: ConnectionPtr connection;
+
+      /// \brief True if the data is sent as frames.
+      public: bool shm = false;
+
+      /// \brief False once the subscriber failed to open a ring. Large
+      /// messages are then sent inline.
+      public: bool rings = true;
+
+      /// \brief Name of the last ring offered to the subscriber.
+      public: std::string offeredRing;
+
+      /// \brief Name of the last ring opened by the subscriber.
+      public: std::string acceptedRing;
+
+      /// \brief Protects the ring state, which is updated by the replies.
+      public: mutable std::mutex ringMutex;
+
+      /// \brief Weak pointer to this, which the reads are bound to.
+      public: boost::weak_ptr<SubscriptionTransportPrivate> self;
+    };
+  }
+}
+
 using namespace gazebo;
 using namespace transport;
 
@@ -26,7 +73,9 @@ extern void dummy_callback_fn(uint32_t);
 
 //////////////////////////////////////////////////
 SubscriptionTransport::SubscriptionTransport()
+  : dataPtr(new SubscriptionTransportPrivate)
 {
+  this->dataPtr->self = this->dataPtr;
 }
 
 //////////////////////////////////////////////////
@@ -38,9 +87,75 @@ SubscriptionTransport::~SubscriptionTransport()
 
 //////////////////////////////////////////////////
 void SubscriptionTransport::Init(ConnectionPtr _conn, bool _latching)
+{
+  this->Init(_conn, _latching, false);
+}
+
+//////////////////////////////////////////////////
+void SubscriptionTransport::Init(ConnectionPtr _conn, bool _latching,
+    bool _shm)
 {
   this->connection = _conn;
   this->latching = _latching;
+  this->dataPtr->shm = _shm;
+
+  // The subscriber replies to the rings we offer
+  if (this->dataPtr->shm && this->connection && this->connection->IsOpen())
+  {
+    this->dataPtr->connection = this->connection;
+    this->dataPtr->ReadReply();
+  }
+}
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::SharedMemory() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->ringMutex);
+  return this->dataPtr->shm && this->dataPtr->rings;
+}
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::RingAccepted(const std::string &_name) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->ringMutex);
+  return this->dataPtr->rings && this->dataPtr->acceptedRing == _name;
+}
+
+//////////////////////////////////////////////////
+void SubscriptionTransportPrivate::ReadReply()
+{
+  using namespace boost::placeholders;
+  this->connection->AsyncRead(common::weakBind(
+        &SubscriptionTransportPrivate::OnReply, this->self.lock(), _1));
+}
+
+//////////////////////////////////////////////////
+void SubscriptionTransportPrivate::OnReply(const std::string &_data)
+{
+  if (!this->connection->IsOpen())
+    return;
+
+  if (!_data.empty())
+  {
+    std::lock_guard<std::mutex> lock(this->ringMutex);
+    const std::string name = _data.substr(1);
+    if (_data[0] == ShmRing::AcceptTag)
+    {
+      this->acceptedRing = name;
+    }
+    else if (_data[0] == ShmRing::RejectTag && name == this->offeredRing)
+    {
+      // Rejections of replaced rings are ignored, the current ring is
+      // offered with the next message. The subscriber rejects a ring it
+      // can't open, or one it reads too slowly from.
+      gzwarn << "Subscriber rejected shared memory[" << name
+             << "], sending large messages inline.\n";
+      this->rings = false;
+      return;
+    }
+  }
+
+  this->ReadReply();
 }
 
 //////////////////////////////////////////////////
@@ -56,6 +171,9 @@ bool SubscriptionTransport::HandleMessage(MessagePtr _newMsg)
 bool SubscriptionTransport::HandleData(const std::string &_newdata,
     boost::function<void(uint32_t)> _cb, uint32_t _id)
 {
+  if (this->dataPtr->shm)
+    return this->HandleFrame(ShmRing::InlineTag + _newdata, _cb, _id);
+
   bool result = false;
   if (this->connection->IsOpen())
   {
@@ -68,6 +186,67 @@ bool SubscriptionTransport::HandleData(const std::string &_newdata,
   return result;
 }
 
+//////////////////////////////////////////////////
+bool SubscriptionTransport::HandleFrame(const std::string &_frame,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  bool result = false;
+  if (this->connection->IsOpen())
+  {
+    this->connection->EnqueueMsg(_frame, _cb, _id);
+    result = true;
+  }
+  else
+    this->connection.reset();
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::HandleRing(const ShmRingPtr &_ring,
+    const std::string &_frame,
+    const std::string &_newdata,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  if (!this->connection->IsOpen())
+  {
+    this->connection.reset();
+    return false;
+  }
+
+  std::unique_lock<std::mutex> lock(this->dataPtr->ringMutex);
+  if (!_frame.empty() && this->dataPtr->rings &&
+      this->dataPtr->acceptedRing == _ring->Name())
+  {
+    lock.unlock();
+
+    // The callback holds the ring until the frame is sent, so that a
+    // replaced ring isn't removed while frames still point to it. The
+    // subscriber mapped the ring when it accepted it, so the slot stays
+    // readable after that.
+    ShmRingPtr ring = _ring;
+    return this->HandleFrame(_frame, [ring, _cb](uint32_t _cbId)
+        {
+          if (_cb)
+            _cb(_cbId);
+        }, _id);
+  }
+
+  if (this->dataPtr->rings && this->dataPtr->offeredRing != _ring->Name())
+  {
+    this->dataPtr->offeredRing = _ring->Name();
+
+    // Keep the ring until the offer is sent. A subscriber that gets it
+    // after the ring was replaced rejects it, which is ignored.
+    ShmRingPtr ring = _ring;
+    this->connection->EnqueueMsg(ShmRing::OfferTag + this->dataPtr->offeredRing,
+        [ring](uint32_t) {}, 0);
+  }
+  lock.unlock();
+
+  return this->HandleData(_newdata, _cb, _id);
+}
+
 //////////////////////////////////////////////////
 const ConnectionPtr &SubscriptionTransport::GetConnection() const
 {
@@ -23,12 +23,15 @@
 
 #include "Connection.hh"
 #include "CallbackHelper.hh"
+#include "TransportTypes.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
 {
   namespace transport
   {
+    class SubscriptionTransportPrivate;
+
     /// \addtogroup gazebo_transport
     /// \{
 
@@ -50,6 +53,52 @@ namespace gazebo
       /// don't latch
       public: void Init(ConnectionPtr _conn, bool _latching);
 
+      /// \brief Initialize the publication link
+      /// \param[in] _conn The connection to use
+      /// \param[in] _latching If true, latch the latest message; if false,
+      /// don't latch
+      /// \param[in] _shm True if the subscriber asked for large messages
+      /// through shared memory, in which case all the data is sent as
+      /// frames, see ShmRing.
+      public: void Init(ConnectionPtr _conn, bool _latching, bool _shm);
+
+      /// \brief Does the subscriber read large messages from shared memory?
+      /// \return True if the data is sent as frames, and the subscriber
+      /// didn't fail to open a ring.
+      public: bool SharedMemory() const;
+
+      /// \brief Has the subscriber opened a ring?
+      /// \param[in] _name Name of the ring.
+      /// \return True if frames that point to the ring can be sent.
+      public: bool RingAccepted(const std::string &_name) const;
+
+      /// \brief Output a large message to a subscriber that reads shared
+      /// memory. Frames are only sent once the subscriber has opened the
+      /// ring. Until then, the ring is offered to the subscriber and the
+      /// message is sent inline.
+      /// \param[in] _ring Ring of the publication.
+      /// \param[in] _frame Frame that locates the message in _ring, empty
+      /// if the message wasn't written to it.
+      /// \param[in] _newdata The message.
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \return true if the message was handled successfully, false
+      /// otherwise
+      public: bool HandleRing(const ShmRingPtr &_ring,
+                  const std::string &_frame,
+                  const std::string &_newdata,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id);
+
+      /// \brief Output a frame that locates a message in shared memory.
+      /// \param[in] _frame The frame, see ShmRing::Write.
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \return true if the frame was handled successfully, false otherwise
+      public: bool HandleFrame(const std::string &_frame,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id);
+
       /// \brief Output a message to a connection
       /// \param[in] _newdata The message to be handled
       /// \return true if the message was handled successfully, false otherwise
@@ -72,6 +121,11 @@ namespace gazebo
       public: virtual bool IsLocal() const;
 
       private: ConnectionPtr connection;
+
+      /// \internal
+      /// \brief Private data pointer. It's shared with the reads of the
+      /// replies of the subscriber, which may outlive the transport.
+      private: boost::shared_ptr<SubscriptionTransportPrivate> dataPtr;
     };
     /// \}
   }
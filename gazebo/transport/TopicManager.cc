@@ -18,9 +18,11 @@
 #include <tbb/blocked_range.h>
 
 #include <boost/function.hpp>
+#include "gazebo/common/ProfileTimeline.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Publication.hh"
+#include "gazebo/transport/ShmRing.hh"
 #include "gazebo/transport/TopicManager.hh"
 
 using namespace gazebo;
@@ -152,6 +154,8 @@ void TopicManager::AddNodeToProcess(NodePtr _ptr)
 //////////////////////////////////////////////////
 void TopicManager::ProcessNodes(bool _onlyOut)
 {
+  GZ_PROFILE("TopicManager::ProcessNodes");
+
   {
     boost::mutex::scoped_lock lock(this->processNodesMutex);
     for (boost::unordered_set<NodePtr>::iterator iter =
@@ -358,7 +362,12 @@ void TopicManager::ConnectSubToPub(const msgs::Publish &_pub)
         }
       }
 
-      publink->Init(conn, latched);
+      // Large messages go through shared memory if the publisher is on
+      // this host, and supports it.
+      bool shm = _pub.shm() && ShmRing::Enabled() &&
+        conn->GetRemoteAddress() == conn->GetLocalAddress();
+
+      publink->Init(conn, latched, shm);
 
       publication->AddTransport(publink);
     }
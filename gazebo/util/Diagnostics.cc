@@ -120,6 +120,7 @@ void DiagnosticManager::Update(const common::UpdateInfo &_info)
     this->dataPtr->pub->Publish(this->dataPtr->msg);
 
   this->dataPtr->msg.clear_time();
+  this->dataPtr->msg.clear_value();
 }
 
 //////////////////////////////////////////////////
@@ -132,6 +133,15 @@ void DiagnosticManager::AddTime(const std::string &_name,
   msgs::Set(time->mutable_wall(), _wallTime);
 }
 
+//////////////////////////////////////////////////
+void DiagnosticManager::AddValue(const std::string &_name,
+    const double _value)
+{
+  msgs::Diagnostics::DiagValue *value = this->dataPtr->msg.add_value();
+  value->set_name(_name);
+  value->set_value(_value);
+}
+
 //////////////////////////////////////////////////
 void DiagnosticManager::StartTimer(const std::string &_name)
 {
@@ -66,10 +66,18 @@ namespace gazebo
     /// \param[in] name Name of the timer to stop
     #define DIAG_TIMER_STOP(_name) \
     gazebo::util::DiagnosticManager::Instance()->StopTimer(_name);
+
+    /// \brief Publish a value, such as a count or a ratio, with the
+    /// diagnostics of the current iteration.
+    /// \param[in] _name Name of the value.
+    /// \param[in] _value The value.
+    #define DIAG_VALUE(_name, _value) \
+    gazebo::util::DiagnosticManager::Instance()->AddValue(_name, _value);
 #else
     #define DIAG_TIMER_START(_name) ((void) 0)
     #define DIAG_TIMER_LAP(_name, _prefix) ((void)0)
     #define DIAG_TIMER_STOP(_name) ((void) 0)
+    #define DIAG_VALUE(_name, _value) ((void) 0)
 #endif
 
     /// \class DiagnosticManager Diagnostics.hh util/util.hh
@@ -126,6 +134,12 @@ namespace gazebo
       /// \return Label of the specified timer
       public: std::string Label(const int _index) const;
 
+      /// \brief Add a value for publication with the diagnostics of the
+      /// current iteration.
+      /// \param[in] _name Name of the value.
+      /// \param[in] _value The value.
+      public: void AddValue(const std::string &_name, const double _value);
+
       /// \brief Get the path in which logs are stored.
       /// \return The path in which logs are stored.
       public: boost::filesystem::path LogPath() const;
@@ -0,0 +1,422 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/util/LogBinary.hh"
+
+using namespace gazebo;
+using namespace util;
+
+namespace
+{
+  /// \brief Magic bytes at the start of a binary log.
+  const char kFileMagic[] = "GZLOGBIN";
+
+  /// \brief Magic bytes at the end of a binary log with an index.
+  const char kIndexMagic[] = "GZLOGIDX";
+
+  /// \brief Size of the magic strings.
+  const size_t kMagicSize = 8;
+
+  /// \brief Size of a frame record header: size, sec, nsec.
+  const size_t kFrameHeaderSize = 12;
+
+  /// \brief Size of an index entry: offset, sec, nsec.
+  const size_t kIndexEntrySize = 16;
+
+  /// \brief Value of the size field that starts the index.
+  const uint32_t kIndexMarker = 0xFFFFFFFF;
+
+  /// \brief Tags delimiting frames and their simulation time.
+  const std::string kStartFrame = "<sdf ";
+  const std::string kEndFrame = "</sdf>";
+  const std::string kStartTime = "<sim_time>";
+  const std::string kEndTime = "</sim_time>";
+
+  /////////////////////////////////////////////////
+  void AppendU32(const uint32_t _value, std::string &_out)
+  {
+    for (int i = 0; i < 4; ++i)
+      _out.push_back(static_cast<char>((_value >> (8 * i)) & 0xFF));
+  }
+
+  /////////////////////////////////////////////////
+  void AppendU64(const uint64_t _value, std::string &_out)
+  {
+    for (int i = 0; i < 8; ++i)
+      _out.push_back(static_cast<char>((_value >> (8 * i)) & 0xFF));
+  }
+
+  /////////////////////////////////////////////////
+  uint32_t ReadU32(const char *_data)
+  {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i)
+      value |= static_cast<uint32_t>(static_cast<uint8_t>(_data[i])) << (8*i);
+    return value;
+  }
+
+  /////////////////////////////////////////////////
+  uint64_t ReadU64(const char *_data)
+  {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i)
+      value |= static_cast<uint64_t>(static_cast<uint8_t>(_data[i])) << (8*i);
+    return value;
+  }
+}
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief Private data for LogBinaryReader
+    class LogBinaryReaderPrivate
+    {
+      /// \brief The memory mapped log file.
+      public: boost::iostreams::mapped_file_source file;
+
+      /// \brief The XML header.
+      public: std::string header;
+
+      /// \brief Index of all the frames.
+      public: std::vector<LogBinaryFrame> frames;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+void LogBinaryWriter::Header(const std::string &_header, std::string &_out)
+{
+  const size_t size = _out.size();
+
+  _out.append(kFileMagic, kMagicSize);
+  AppendU32(GZ_LOG_BINARY_VERSION, _out);
+  AppendU32(_header.size(), _out);
+  _out.append(_header);
+
+  this->offset += _out.size() - size;
+}
+
+/////////////////////////////////////////////////
+unsigned int LogBinaryWriter::AddFrames(const std::string &_data,
+    std::string &_out)
+{
+  unsigned int count = 0;
+  size_t pos = 0;
+
+  while (true)
+  {
+    size_t from = _data.find(kStartFrame, pos);
+    if (from == std::string::npos)
+      break;
+
+    size_t to = _data.find(kEndFrame, from);
+    if (to == std::string::npos)
+    {
+      gzerr << "Incomplete <sdf> frame in log data\n";
+      break;
+    }
+    to += kEndFrame.size();
+
+    // Frames without a time inherit the time of the previous frame.
+    common::Time time = this->lastTime;
+    size_t timeFrom = _data.find(kStartTime, from);
+    if (timeFrom != std::string::npos && timeFrom < to)
+    {
+      timeFrom += kStartTime.size();
+      size_t timeTo = _data.find(kEndTime, timeFrom);
+      if (timeTo != std::string::npos && timeTo < to)
+      {
+        std::istringstream stream(_data.substr(timeFrom, timeTo - timeFrom));
+        stream >> time;
+      }
+    }
+
+    this->AddFrame(_data.data() + from, to - from, time, _out);
+    ++count;
+    pos = to;
+  }
+
+  return count;
+}
+
+/////////////////////////////////////////////////
+void LogBinaryWriter::AddFrame(const char *_data, const size_t _size,
+    const common::Time &_time, std::string &_out)
+{
+  LogBinaryFrame frame;
+  frame.offset = this->offset;
+  frame.size = _size;
+  frame.time = _time;
+  this->frames.push_back(frame);
+
+  AppendU32(_size, _out);
+  AppendU32(static_cast<uint32_t>(_time.sec), _out);
+  AppendU32(static_cast<uint32_t>(_time.nsec), _out);
+  _out.append(_data, _size);
+
+  this->offset += kFrameHeaderSize + _size;
+  this->lastTime = _time;
+}
+
+/////////////////////////////////////////////////
+void LogBinaryWriter::Footer(std::string &_out)
+{
+  const uint64_t indexOffset = this->offset;
+
+  AppendU32(kIndexMarker, _out);
+  AppendU64(this->frames.size(), _out);
+  for (auto const &frame : this->frames)
+  {
+    AppendU64(frame.offset, _out);
+    AppendU32(static_cast<uint32_t>(frame.time.sec), _out);
+    AppendU32(static_cast<uint32_t>(frame.time.nsec), _out);
+  }
+  AppendU64(indexOffset, _out);
+  _out.append(kIndexMagic, kMagicSize);
+
+  this->offset += 4 + 8 + this->frames.size() * kIndexEntrySize + 8 +
+    kMagicSize;
+}
+
+/////////////////////////////////////////////////
+uint64_t LogBinaryWriter::Offset() const
+{
+  return this->offset;
+}
+
+/////////////////////////////////////////////////
+size_t LogBinaryWriter::FrameCount() const
+{
+  return this->frames.size();
+}
+
+/////////////////////////////////////////////////
+LogBinaryReader::LogBinaryReader()
+  : dataPtr(new LogBinaryReaderPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+LogBinaryReader::~LogBinaryReader()
+{
+}
+
+/////////////////////////////////////////////////
+bool LogBinaryReader::IsBinary(const std::string &_filename)
+{
+  std::ifstream file(_filename, std::ios::binary);
+  char magic[kMagicSize];
+  if (!file.read(magic, kMagicSize))
+    return false;
+
+  return std::memcmp(magic, kFileMagic, kMagicSize) == 0;
+}
+
+/////////////////////////////////////////////////
+bool LogBinaryReader::Open(const std::string &_filename)
+{
+  this->dataPtr->header.clear();
+  this->dataPtr->frames.clear();
+  if (this->dataPtr->file.is_open())
+    this->dataPtr->file.close();
+
+  try
+  {
+    this->dataPtr->file.open(_filename);
+  }
+  catch(const std::exception &_e)
+  {
+    gzerr << "Unable to map log file[" << _filename << "]: "
+          << _e.what() << std::endl;
+    return false;
+  }
+
+  const char *data = this->dataPtr->file.data();
+  const uint64_t size = this->dataPtr->file.size();
+
+  // File header
+  if (size < kMagicSize + 8 ||
+      std::memcmp(data, kFileMagic, kMagicSize) != 0)
+  {
+    gzerr << "Log file[" << _filename << "] is not a binary log\n";
+    return false;
+  }
+
+  const uint32_t version = ReadU32(data + kMagicSize);
+  if (version > GZ_LOG_BINARY_VERSION)
+  {
+    gzerr << "Binary log version[" << version << "] in file[" << _filename
+          << "] is newer than the supported version["
+          << GZ_LOG_BINARY_VERSION << "]\n";
+    return false;
+  }
+
+  const uint32_t headerSize = ReadU32(data + kMagicSize + 4);
+  const uint64_t framesStart = kMagicSize + 8 + headerSize;
+  if (framesStart > size)
+  {
+    gzerr << "Log file[" << _filename << "] has a truncated header\n";
+    return false;
+  }
+  this->dataPtr->header.assign(data + kMagicSize + 8, headerSize);
+
+  // Frame index, written when the log was closed.
+  const uint64_t trailerSize = 8 + kMagicSize;
+  if (size >= framesStart + 12 + trailerSize &&
+      std::memcmp(data + size - kMagicSize, kIndexMagic, kMagicSize) == 0)
+  {
+    // The offset and the count are read from the file, so they are
+    // checked without any arithmetic that could overflow.
+    const uint64_t indexOffset = ReadU64(data + size - trailerSize);
+    if (indexOffset >= framesStart &&
+        indexOffset <= size - trailerSize - 12 &&
+        ReadU32(data + indexOffset) == kIndexMarker)
+    {
+      const uint64_t count = ReadU64(data + indexOffset + 4);
+      const char *entry = data + indexOffset + 12;
+      const uint64_t entriesSize = size - trailerSize - indexOffset - 12;
+
+      if (count <= entriesSize / kIndexEntrySize &&
+          count * kIndexEntrySize == entriesSize)
+      {
+        this->dataPtr->frames.resize(count);
+        for (auto &frame : this->dataPtr->frames)
+        {
+          frame.offset = ReadU64(entry);
+          frame.time.sec = static_cast<int32_t>(ReadU32(entry + 8));
+          frame.time.nsec = static_cast<int32_t>(ReadU32(entry + 12));
+          entry += kIndexEntrySize;
+
+          if (frame.offset < framesStart ||
+              frame.offset > indexOffset - kFrameHeaderSize)
+          {
+            this->dataPtr->frames.clear();
+            break;
+          }
+
+          frame.size = ReadU32(data + frame.offset);
+          if (frame.offset + kFrameHeaderSize + frame.size > indexOffset)
+          {
+            this->dataPtr->frames.clear();
+            break;
+          }
+        }
+
+        if (this->dataPtr->frames.size() == count)
+          return true;
+      }
+    }
+
+    gzwarn << "Log file[" << _filename << "] has an invalid index\n";
+  }
+
+  gzwarn << "Rebuilding frame index of log file[" << _filename << "]\n";
+  return this->ScanFrames(framesStart);
+}
+
+/////////////////////////////////////////////////
+bool LogBinaryReader::ScanFrames(const uint64_t _start)
+{
+  const char *data = this->dataPtr->file.data();
+  const uint64_t size = this->dataPtr->file.size();
+
+  uint64_t pos = _start;
+  while (pos + kFrameHeaderSize <= size)
+  {
+    LogBinaryFrame frame;
+    frame.offset = pos;
+    frame.size = ReadU32(data + pos);
+
+    // Start of the index
+    if (frame.size == kIndexMarker)
+      break;
+
+    if (pos + kFrameHeaderSize + frame.size > size)
+    {
+      gzwarn << "Ignoring truncated frame at the end of the log\n";
+      break;
+    }
+
+    frame.time.sec = static_cast<int32_t>(ReadU32(data + pos + 4));
+    frame.time.nsec = static_cast<int32_t>(ReadU32(data + pos + 8));
+    this->dataPtr->frames.push_back(frame);
+
+    pos += kFrameHeaderSize + frame.size;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string LogBinaryReader::Header() const
+{
+  return this->dataPtr->header;
+}
+
+/////////////////////////////////////////////////
+size_t LogBinaryReader::FrameCount() const
+{
+  return this->dataPtr->frames.size();
+}
+
+/////////////////////////////////////////////////
+const LogBinaryFrame *LogBinaryReader::Frame(const size_t _index) const
+{
+  if (_index >= this->dataPtr->frames.size())
+    return nullptr;
+
+  return &this->dataPtr->frames[_index];
+}
+
+/////////////////////////////////////////////////
+bool LogBinaryReader::FrameData(const size_t _index, const char *&_data,
+    size_t &_size) const
+{
+  const LogBinaryFrame *frame = this->Frame(_index);
+  if (!frame)
+    return false;
+
+  _data = this->dataPtr->file.data() + frame->offset + kFrameHeaderSize;
+  _size = frame->size;
+  return true;
+}
+
+/////////////////////////////////////////////////
+size_t LogBinaryReader::LowerBound(const common::Time &_time,
+    const size_t _first) const
+{
+  const auto &frames = this->dataPtr->frames;
+  if (_first >= frames.size())
+    return frames.size();
+
+  auto iter = std::lower_bound(frames.begin() + _first, frames.end(), _time,
+      [](const LogBinaryFrame &_frame, const common::Time &_t)
+      {
+        return _frame.time < _t;
+      });
+
+  return iter - frames.begin();
+}
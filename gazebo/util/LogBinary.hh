@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef _GAZEBO_UTIL_LOGBINARY_HH_
+#define _GAZEBO_UTIL_LOGBINARY_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Version of the binary log container.
+#define GZ_LOG_BINARY_VERSION 1
+
+namespace gazebo
+{
+  namespace util
+  {
+    // Forward declare private data class
+    class LogBinaryReaderPrivate;
+
+    /// addtogroup gazebo_util
+    /// \{
+
+    /// \brief Location of one frame in a binary log file.
+    class GZ_UTIL_VISIBLE LogBinaryFrame
+    {
+      /// \brief Offset of the frame record in the file.
+      public: uint64_t offset = 0;
+
+      /// \brief Size of the frame data in bytes.
+      public: uint32_t size = 0;
+
+      /// \brief Simulation time of the frame.
+      public: common::Time time;
+    };
+
+    /// \class LogBinaryWriter LogBinary.hh util/util.hh
+    /// \brief Encodes frames in the "bin" log encoding.
+    ///
+    /// A binary log is a file header followed by length prefixed frame
+    /// records and, once the log is closed, an index of frame offsets:
+    ///
+    ///   "GZLOGBIN" | uint32 version | uint32 size | header xml
+    ///   uint32 size | int32 sec | int32 nsec | frame data   (per frame)
+    ///   uint32 0xFFFFFFFF | uint64 count |
+    ///       (uint64 offset | int32 sec | int32 nsec) * count
+    ///   uint64 index offset | "GZLOGIDX"
+    ///
+    /// All integers are little endian. Each frame is the <sdf> text of one
+    /// state, as returned by LogPlay::Step. Frames without a <sim_time>
+    /// (such as the initial world description) are stored with the time of
+    /// the previous frame.
+    ///
+    /// The writer only produces bytes, the caller is responsible for
+    /// writing them to disk in order.
+    class GZ_UTIL_VISIBLE LogBinaryWriter
+    {
+      /// \brief Constructor
+      public: LogBinaryWriter() = default;
+
+      /// \brief Encode the file header.
+      /// \param[in] _header XML log header, with a <gazebo_log> root.
+      /// \param[out] _out Buffer the encoded bytes are appended to.
+      public: void Header(const std::string &_header, std::string &_out);
+
+      /// \brief Split a block of <sdf> frames and encode each of them.
+      /// \param[in] _data Frames as produced by the log callbacks.
+      /// \param[out] _out Buffer the encoded bytes are appended to.
+      /// \return Number of frames encoded.
+      public: unsigned int AddFrames(const std::string &_data,
+                                     std::string &_out);
+
+      /// \brief Encode one frame.
+      /// \param[in] _data Frame data.
+      /// \param[in] _size Size of the frame data.
+      /// \param[in] _time Simulation time of the frame.
+      /// \param[out] _out Buffer the encoded bytes are appended to.
+      public: void AddFrame(const char *_data, const size_t _size,
+                            const common::Time &_time, std::string &_out);
+
+      /// \brief Encode the frame index. No frames can be added afterwards.
+      /// \param[out] _out Buffer the encoded bytes are appended to.
+      public: void Footer(std::string &_out);
+
+      /// \brief Number of bytes encoded so far.
+      /// \return Offset of the next record in the file.
+      public: uint64_t Offset() const;
+
+      /// \brief Number of frames encoded so far.
+      /// \return Frame count.
+      public: size_t FrameCount() const;
+
+      /// \brief Offset of the next record.
+      private: uint64_t offset = 0;
+
+      /// \brief Time of the last frame.
+      private: common::Time lastTime;
+
+      /// \brief Frames encoded so far.
+      private: std::vector<LogBinaryFrame> frames;
+    };
+
+    /// \class LogBinaryReader LogBinary.hh util/util.hh
+    /// \brief Memory maps a log file in the "bin" encoding.
+    ///
+    /// Frames are accessed in place, and the frame index makes random access
+    /// and time lookups O(log n). A log that was not closed properly has no
+    /// index, in which case it is rebuilt by walking the frame records.
+    class GZ_UTIL_VISIBLE LogBinaryReader
+    {
+      /// \brief Constructor
+      public: LogBinaryReader();
+
+      /// \brief Destructor
+      public: virtual ~LogBinaryReader();
+
+      /// \brief Check whether a file uses the binary encoding.
+      /// \param[in] _filename Path to the log file.
+      /// \return True if the file starts with the binary log magic.
+      public: static bool IsBinary(const std::string &_filename);
+
+      /// \brief Open and map a log file.
+      /// \param[in] _filename Path to the log file.
+      /// \return True on success.
+      public: bool Open(const std::string &_filename);
+
+      /// \brief Get the XML header stored in the log.
+      /// \return The log header.
+      public: std::string Header() const;
+
+      /// \brief Get the number of frames.
+      /// \return Frame count.
+      public: size_t FrameCount() const;
+
+      /// \brief Get the location of a frame.
+      /// \param[in] _index Frame index.
+      /// \return The frame, or nullptr if _index is out of range.
+      public: const LogBinaryFrame *Frame(const size_t _index) const;
+
+      /// \brief Get the data of a frame without copying it.
+      /// \param[in] _index Frame index.
+      /// \param[out] _data Pointer to the mapped frame data.
+      /// \param[out] _size Size of the frame data.
+      /// \return True if _index is valid.
+      public: bool FrameData(const size_t _index, const char *&_data,
+                             size_t &_size) const;
+
+      /// \brief Find the first frame, at or after _first, with a simulation
+      /// time greater than or equal to _time.
+      /// \param[in] _time Simulation time.
+      /// \param[in] _first Index of the first frame to consider.
+      /// \return Frame index, FrameCount() if there is none.
+      public: size_t LowerBound(const common::Time &_time,
+                                const size_t _first = 0) const;
+
+      /// \brief Rebuild the index by walking the frame records.
+      /// \param[in] _start Offset of the first frame record.
+      /// \return True if at least the header could be parsed.
+      private: bool ScanFrames(const uint64_t _start);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LogBinaryReaderPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/LogBinary.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class LogBinary_TEST : public gazebo::testing::AutoLogFixture
+{
+  /// \brief Create a state frame.
+  /// \param[in] _sec Simulation time seconds.
+  /// \return The frame.
+  public: std::string StateFrame(const int _sec)
+  {
+    std::ostringstream stream;
+    stream << "<sdf version='1.6'><state world_name='default'>"
+           << "<sim_time>" << _sec << " 0</sim_time>"
+           << "<iterations>" << _sec * 1000 << "</iterations>"
+           << "</state></sdf>";
+    return stream.str();
+  }
+
+  /// \brief Write a buffer to a temporary file.
+  /// \param[in] _data Data to write.
+  /// \return Filename.
+  public: std::string WriteFile(const std::string &_data)
+  {
+    boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gz_log_binary_%%%%%%%%.log");
+    std::ofstream file(path.string(), std::ios::binary);
+    file.write(_data.c_str(), _data.size());
+    this->filenames.push_back(path.string());
+    return path.string();
+  }
+
+  /// \brief Remove the temporary files.
+  protected: virtual void TearDown()
+  {
+    for (auto const &filename : this->filenames)
+      boost::filesystem::remove(filename);
+  }
+
+  /// \brief Temporary files.
+  private: std::vector<std::string> filenames;
+};
+
+/////////////////////////////////////////////////
+/// \brief Write frames and read them back.
+TEST_F(LogBinary_TEST, WriteRead)
+{
+  const std::string header =
+    "<gazebo_log><header><log_version>1.0</log_version></header>"
+    "</gazebo_log>";
+  const std::string world = "<sdf version ='1.6'><world name='default'>"
+    "</world></sdf>\n";
+
+  std::string buffer;
+  util::LogBinaryWriter writer;
+  writer.Header(header, buffer);
+  EXPECT_EQ(writer.AddFrames(world, buffer), 1u);
+
+  std::string states;
+  for (int i = 1; i <= 10; ++i)
+    states += this->StateFrame(i);
+  EXPECT_EQ(writer.AddFrames(states, buffer), 10u);
+  EXPECT_EQ(writer.FrameCount(), 11u);
+  EXPECT_EQ(writer.Offset(), buffer.size());
+
+  writer.Footer(buffer);
+  EXPECT_EQ(writer.Offset(), buffer.size());
+
+  std::string filename = this->WriteFile(buffer);
+  EXPECT_TRUE(util::LogBinaryReader::IsBinary(filename));
+
+  util::LogBinaryReader reader;
+  ASSERT_TRUE(reader.Open(filename));
+  EXPECT_EQ(reader.Header(), header);
+  ASSERT_EQ(reader.FrameCount(), 11u);
+
+  const char *data;
+  size_t size;
+  ASSERT_TRUE(reader.FrameData(0, data, size));
+  EXPECT_EQ(std::string(data, size), world.substr(0, world.size() - 1));
+  EXPECT_EQ(reader.Frame(0)->time, common::Time::Zero);
+
+  for (int i = 1; i <= 10; ++i)
+  {
+    ASSERT_TRUE(reader.FrameData(i, data, size));
+    EXPECT_EQ(std::string(data, size), this->StateFrame(i));
+    EXPECT_EQ(reader.Frame(i)->time, common::Time(i, 0));
+  }
+  EXPECT_FALSE(reader.FrameData(11, data, size));
+  EXPECT_TRUE(reader.Frame(11) == nullptr);
+
+  // Time lookups
+  EXPECT_EQ(reader.LowerBound(common::Time(0.5), 1), 1u);
+  EXPECT_EQ(reader.LowerBound(common::Time(3.0), 1), 3u);
+  EXPECT_EQ(reader.LowerBound(common::Time(3.5), 1), 4u);
+  EXPECT_EQ(reader.LowerBound(common::Time(11.0), 1), 11u);
+}
+
+/////////////////////////////////////////////////
+/// \brief A log without an index, as left by a crash, is still readable.
+TEST_F(LogBinary_TEST, MissingIndex)
+{
+  std::string buffer;
+  util::LogBinaryWriter writer;
+  writer.Header("<gazebo_log/>", buffer);
+  for (int i = 1; i <= 5; ++i)
+    writer.AddFrames(this->StateFrame(i), buffer);
+
+  // Truncate the last frame.
+  std::string filename = this->WriteFile(buffer.substr(0, buffer.size() - 3));
+
+  util::LogBinaryReader reader;
+  ASSERT_TRUE(reader.Open(filename));
+  ASSERT_EQ(reader.FrameCount(), 4u);
+
+  const char *data;
+  size_t size;
+  ASSERT_TRUE(reader.FrameData(3, data, size));
+  EXPECT_EQ(std::string(data, size), this->StateFrame(4));
+}
+
+/////////////////////////////////////////////////
+/// \brief A log with a corrupt index is read by scanning its frames.
+TEST_F(LogBinary_TEST, CorruptIndex)
+{
+  std::string buffer;
+  util::LogBinaryWriter writer;
+  writer.Header("<gazebo_log/>", buffer);
+  for (int i = 1; i <= 5; ++i)
+    writer.AddFrames(this->StateFrame(i), buffer);
+  writer.Footer(buffer);
+
+  // The index offset is stored before the magic string that ends the log
+  uint64_t indexOffset = 0;
+  for (int i = 0; i < 8; ++i)
+  {
+    indexOffset |= static_cast<uint64_t>(
+        static_cast<unsigned char>(buffer[buffer.size() - 16 + i])) << (8 * i);
+  }
+
+  // A count whose size in bytes overflows to the size of the index
+  std::string badCount = buffer;
+  badCount[indexOffset + 4 + 7] = static_cast<char>(0x10);
+
+  // An offset past the end of the file that overflows to a valid one
+  std::string badOffset = buffer;
+  for (int i = 0; i < 8; ++i)
+    badOffset[badOffset.size() - 16 + i] = static_cast<char>(0xFF);
+
+  for (auto const &data : {badCount, badOffset})
+  {
+    std::string filename = this->WriteFile(data);
+
+    util::LogBinaryReader reader;
+    ASSERT_TRUE(reader.Open(filename));
+    ASSERT_EQ(reader.FrameCount(), 5u);
+
+    const char *frame;
+    size_t size;
+    ASSERT_TRUE(reader.FrameData(4, frame, size));
+    EXPECT_EQ(std::string(frame, size), this->StateFrame(5));
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Text logs are not binary logs.
+TEST_F(LogBinary_TEST, NotBinary)
+{
+  std::string filename = this->WriteFile("<?xml version='1.0'?>\n");
+  EXPECT_FALSE(util::LogBinaryReader::IsBinary(filename));
+
+  util::LogBinaryReader reader;
+  EXPECT_FALSE(reader.Open(filename));
+  EXPECT_FALSE(reader.Open("non-existing-file"));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -64,6 +64,7 @@ LogPlay::~LogPlay()
 void LogPlay::Open(const std::string &_logFile)
 {
   this->dataPtr->currentChunk.clear();
+  this->dataPtr->binaryLog.reset();
 
   boost::filesystem::path path(_logFile);
   if (!boost::filesystem::exists(path))
@@ -72,6 +73,40 @@ void LogPlay::Open(const std::string &_logFile)
   if (boost::filesystem::is_directory(path))
     gzthrow("Invalid logfile [" + _logFile + "]. This is a directory.");
 
+  // Binary logs are memory mapped, only the header is parsed as XML.
+  if (LogBinaryReader::IsBinary(_logFile))
+  {
+    this->dataPtr->logStartXml = nullptr;
+
+    std::unique_ptr<LogBinaryReader> binaryLog(new LogBinaryReader());
+    if (!binaryLog->Open(_logFile))
+      gzthrow("Error parsing log file");
+
+    if (this->dataPtr->xmlDoc.Parse(binaryLog->Header().c_str()) !=
+        tinyxml2::XML_SUCCESS)
+    {
+      gzthrow("Unable to parse the header of log file [" + _logFile + "]");
+    }
+
+    if (binaryLog->FrameCount() == 0)
+      gzthrow("Unable to find the first chunk");
+
+    this->dataPtr->logStartXml =
+      this->dataPtr->xmlDoc.FirstChildElement("gazebo_log");
+    if (!this->dataPtr->logStartXml)
+      gzthrow("Log file is missing the <gazebo_log> element");
+
+    this->dataPtr->filename = _logFile;
+    this->dataPtr->binaryLog = std::move(binaryLog);
+    this->dataPtr->encoding = "bin";
+    this->dataPtr->frame = -1;
+
+    this->ReadHeader();
+    this->ReadLogTimes();
+    this->dataPtr->iterationsFound = this->ReadIterations();
+    return;
+  }
+
   // Flag use to indicate if a parser failure has occurred
   bool xmlParserFail = this->dataPtr->xmlDoc.LoadFile(_logFile.c_str()) !=
     tinyxml2::XML_SUCCESS;
@@ -258,6 +293,18 @@ void LogPlay::ReadHeader()
 /////////////////////////////////////////////////
 void LogPlay::ReadLogTimes()
 {
+  if (this->dataPtr->binaryLog)
+  {
+    // The first frame is the world description, the times come from the
+    // frame index.
+    const size_t count = this->dataPtr->binaryLog->FrameCount();
+    this->dataPtr->logStartTime =
+      this->dataPtr->binaryLog->Frame(std::min<size_t>(1, count - 1))->time;
+    this->dataPtr->logEndTime =
+      this->dataPtr->binaryLog->Frame(count - 1)->time;
+    return;
+  }
+
   std::string chunk;
   bool found = false;
 
@@ -344,15 +391,25 @@ bool LogPlay::ReadIterations()
 
   for (unsigned int i = 0; i < numChunksToTry; ++i)
   {
-    if (!chunkXml)
+    std::string chunk;
+    if (this->dataPtr->binaryLog)
     {
-      gzerr << "Unable to find the first chunk" << std::endl;
-      return false;
+      if (!this->dataPtr->BinaryFrameData(i, chunk))
+        return false;
     }
+    else
+    {
+      if (!chunkXml)
+      {
+        gzerr << "Unable to find the first chunk" << std::endl;
+        return false;
+      }
 
-    std::string chunk;
-    if (!this->dataPtr->ChunkData(chunkXml, chunk))
-      return false;
+      if (!this->dataPtr->ChunkData(chunkXml, chunk))
+        return false;
+
+      chunkXml = chunkXml->NextSiblingElement("chunk");
+    }
 
     // Find the first <iterations> of the log.
     auto from = chunk.find(kStartDelim);
@@ -365,8 +422,6 @@ bool LogPlay::ReadIterations()
       ss >> this->dataPtr->initialIterations;
       return true;
     }
-
-    chunkXml = chunkXml->NextSiblingElement("chunk");
   }
 
   gzwarn << "Unable to find <iterations>...</iterations> tags in the first "
@@ -436,6 +491,15 @@ bool LogPlay::Step(std::string &_data)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
+  if (this->dataPtr->binaryLog)
+  {
+    if (!this->dataPtr->BinaryFrameData(this->dataPtr->frame + 1, _data))
+      return false;
+
+    ++this->dataPtr->frame;
+    return true;
+  }
+
   auto from = this->dataPtr->currentChunk.find(this->dataPtr->kStartFrame,
       this->dataPtr->end + this->dataPtr->kEndFrame.size());
   auto to = this->dataPtr->currentChunk.find(this->dataPtr->kEndFrame,
@@ -497,6 +561,19 @@ bool LogPlay::StepBack(std::string &_data)
 
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
+  if (this->dataPtr->binaryLog)
+  {
+    // The world description in frame 0 is only returned by the first Step.
+    if (this->dataPtr->frame - 1 < 1 ||
+        !this->dataPtr->BinaryFrameData(this->dataPtr->frame - 1, _data))
+    {
+      return false;
+    }
+
+    --this->dataPtr->frame;
+    return true;
+  }
+
   if (this->dataPtr->start > 0)
   {
     from = this->dataPtr->currentChunk.rfind(
@@ -535,6 +612,13 @@ bool LogPlay::Rewind()
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
+  if (this->dataPtr->binaryLog)
+  {
+    // Skip the first frame (it doesn't have a world state).
+    this->dataPtr->frame = 0;
+    return true;
+  }
+
   this->dataPtr->currentChunk.clear();
   this->dataPtr->logCurrXml =
     this->dataPtr->logStartXml->FirstChildElement("chunk");
@@ -575,6 +659,12 @@ bool LogPlay::Forward()
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
+  if (this->dataPtr->binaryLog)
+  {
+    this->dataPtr->frame = this->dataPtr->binaryLog->FrameCount();
+    return true;
+  }
+
   // Get the last chunk.
   this->dataPtr->logCurrXml =
     this->dataPtr->logStartXml->LastChildElement("chunk");
@@ -600,6 +690,21 @@ bool LogPlay::Forward()
 /////////////////////////////////////////////////
 bool LogPlay::Seek(const common::Time &_time)
 {
+  if (this->dataPtr->binaryLog)
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+    // Find the first state frame at or after the target time, the next
+    // Step() will return it. Past the end, the last frame is returned.
+    const int64_t count = this->dataPtr->binaryLog->FrameCount();
+    int64_t next = this->dataPtr->binaryLog->LowerBound(_time, 1);
+    if (next >= count)
+      next = count - 1;
+
+    this->dataPtr->frame = std::max<int64_t>(next - 1, 0);
+    return true;
+  }
+
   if (_time >= this->dataPtr->logEndTime)
   {
     this->Forward();
@@ -690,6 +795,9 @@ bool LogPlay::Seek(const common::Time &_time)
 /////////////////////////////////////////////////
 bool LogPlay::Chunk(unsigned int _index, std::string &_data) const
 {
+  if (this->dataPtr->binaryLog)
+    return this->dataPtr->BinaryFrameData(_index, _data);
+
   unsigned int count = 0;
   this->dataPtr->logCurrXml =
     this->dataPtr->logStartXml->FirstChildElement("chunk");
@@ -778,6 +886,19 @@ bool LogPlayPrivate::ChunkData(
   return true;
 }
 
+/////////////////////////////////////////////////
+bool LogPlayPrivate::BinaryFrameData(const int64_t _index,
+    std::string &_data) const
+{
+  const char *data;
+  size_t size;
+  if (_index < 0 || !this->binaryLog->FrameData(_index, data, size))
+    return false;
+
+  _data.assign(data, size);
+  return true;
+}
+
 /////////////////////////////////////////////////
 std::string LogPlay::Encoding() const
 {
@@ -787,6 +908,9 @@ std::string LogPlay::Encoding() const
 /////////////////////////////////////////////////
 unsigned int LogPlay::ChunkCount() const
 {
+  if (this->dataPtr->binaryLog)
+    return this->dataPtr->binaryLog->FrameCount();
+
   unsigned int count = 0;
   auto xml = this->dataPtr->logStartXml->FirstChildElement("chunk");
 
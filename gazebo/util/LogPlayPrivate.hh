@@ -25,10 +25,12 @@
 #include <tinyxml2.h>
 #endif
 
+#include <memory>
 #include <mutex>
 #include <string>
 
 #include "gazebo/common/Time.hh"
+#include "gazebo/util/LogBinary.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -47,6 +49,13 @@ namespace gazebo
                   tinyxml2::XMLElement *_xml,
                   std::string &_data);
 
+      /// \brief Helper function to get a frame from a binary log.
+      /// \param[in] _index Index of the frame.
+      /// \param[out] _data Storage for the frame's data.
+      /// \return True if _index was valid.
+      public: bool BinaryFrameData(const int64_t _index,
+                  std::string &_data) const;
+
       /// \brief Max number of chunks to inspect when looking for XML elements.
       public: const unsigned int kNumChunksToTry = 2u;
 
@@ -111,6 +120,14 @@ namespace gazebo
       /// may not include this tag in the log files.
       public: bool iterationsFound = false;
 
+      /// \brief Memory mapped log, set when the open log file uses the
+      /// binary encoding. The XML members are unused in that case.
+      public: std::unique_ptr<LogBinaryReader> binaryLog;
+
+      /// \brief Index of the last frame dispatched from a binary log.
+      /// -1 before the first frame, the frame count after Forward().
+      public: int64_t frame = -1;
+
       /// \brief A mutex to avoid race conditions.
       public: std::mutex mutex;
     };
@@ -19,8 +19,10 @@
 #include <boost/filesystem.hpp>
 #include <string>
 #include <thread>
+#include <vector>
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Time.hh"
+#include "gazebo/util/LogBinary.hh"
 #include "gazebo/util/LogPlay.hh"
 #include "test_config.h"
 #include "test/util.hh"
@@ -406,6 +408,101 @@ TEST_F(LogPlay_TEST, Seek)
   EXPECT_EQ(shasum, expectedShashum4);
 }
 
+/////////////////////////////////////////////////
+/// \brief Convert a log file to the binary encoding, and check that it
+/// plays back the same frames.
+TEST_F(LogPlay_TEST, Binary)
+{
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  boost::filesystem::path logFilePath(TEST_PATH);
+  logFilePath /= boost::filesystem::path("logs");
+  logFilePath /= boost::filesystem::path("state.log");
+  EXPECT_NO_THROW(player->Open(logFilePath.string()));
+
+  const unsigned int frameCount = 1000;
+  const common::Time startTime = player->LogStartTime();
+  const common::Time endTime = player->LogEndTime();
+
+  // Convert the log.
+  std::string buffer;
+  gazebo::util::LogBinaryWriter writer;
+  writer.Header(player->Header() + "</gazebo_log>\n", buffer);
+
+  std::vector<std::string> frames;
+  std::string frame;
+  while (player->Step(frame))
+  {
+    EXPECT_EQ(writer.AddFrames(frame, buffer), 1u);
+    if (frames.size() < frameCount)
+      frames.push_back(frame.substr(0, frame.find("</sdf>") + 6));
+  }
+  writer.Footer(buffer);
+
+  boost::filesystem::path binPath =
+    boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("gz_log_play_%%%%%%%%.log");
+  {
+    std::ofstream binFile(binPath.string(), std::ios::binary);
+    binFile.write(buffer.c_str(), buffer.size());
+  }
+
+  EXPECT_NO_THROW(player->Open(binPath.string()));
+  EXPECT_TRUE(player->IsOpen());
+  EXPECT_EQ(player->Encoding(), "bin");
+  EXPECT_EQ(player->LogVersion(), "1.0");
+  EXPECT_EQ(player->RandSeed(), 27838u);
+  EXPECT_EQ(player->LogStartTime(), startTime);
+  EXPECT_EQ(player->LogEndTime(), endTime);
+  EXPECT_EQ(player->ChunkCount(), writer.FrameCount());
+
+  // Step forward
+  for (auto const &expected : frames)
+  {
+    EXPECT_TRUE(player->Step(frame));
+    EXPECT_EQ(frame, expected);
+  }
+
+  // Same frames as the text log.
+  EXPECT_TRUE(player->Rewind());
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame),
+      "0a61e946f14f7395a8bdb7974cb1e18c0d9e3d22");
+  EXPECT_FALSE(player->StepBack(frame));
+
+  EXPECT_TRUE(player->Forward());
+  EXPECT_FALSE(player->Step(frame));
+  EXPECT_TRUE(player->StepBack(frame));
+  EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame),
+      "961cf9dcd38c12f33a8b2f3a3a6fdb879b2faa98");
+  EXPECT_TRUE(player->StepBack(frame));
+  EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame),
+      "c1cf8582d0cb6b628b89c22f91bb9573ee804bf6");
+
+  // Seek
+  EXPECT_TRUE(player->Seek(common::Time(30.0)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame),
+      "a2af44bc561194dfeae9526c224d56bb332a4233");
+
+  EXPECT_TRUE(player->Seek(common::Time(31.5)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame),
+      "113748a3c02575f514b27bc5b4307f621644ad41");
+
+  EXPECT_TRUE(player->Seek(common::Time(25.0)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame),
+      "0a61e946f14f7395a8bdb7974cb1e18c0d9e3d22");
+
+  EXPECT_TRUE(player->Seek(common::Time(35.0)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame),
+      "961cf9dcd38c12f33a8b2f3a3a6fdb879b2faa98");
+
+  boost::filesystem::remove(binPath);
+}
+
 /////////////////////////////////////////////////
 /// \brief Test reading a log file that is missing the closing </gazebo_log>
 /// tag
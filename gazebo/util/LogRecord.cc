@@ -69,6 +69,7 @@ LogRecord::LogRecord()
   this->dataPtr->stopThread = false;
   this->dataPtr->firstUpdate = true;
   this->dataPtr->readyToStart = false;
+  this->dataPtr->compiledFilter.reset(new LogRecordFilter());
 
   // Get the user's home directory
 #ifndef _WIN32
@@ -138,7 +139,7 @@ bool LogRecord::Init(const std::string &_subdir)
 bool LogRecord::Start(const LogRecordParams &_params)
 {
   this->dataPtr->period = _params.period;
-  this->dataPtr->filter = _params.filter;
+  this->SetFilter(_params.filter);
   this->dataPtr->recordResources = _params.recordResources;
   return this->Start(_params.encoding, _params.path);
 }
@@ -186,9 +187,12 @@ bool LogRecord::Start(const std::string &_encoding, const std::string &_path)
   if (!boost::filesystem::exists(this->dataPtr->logCompletePath))
     boost::filesystem::create_directories(this->dataPtr->logCompletePath);
 
-  if (_encoding != "bz2" && _encoding != "txt" && _encoding != "zlib")
+  if (_encoding != "bz2" && _encoding != "txt" && _encoding != "zlib" &&
+      _encoding != "bin")
+  {
     gzthrow("Invalid log encoding[" + _encoding +
-            "]. Must be one of [bz2, zlib, txt]");
+            "]. Must be one of [bz2, zlib, txt, bin]");
+  }
 
   this->dataPtr->encoding = _encoding;
 
@@ -325,13 +329,26 @@ void LogRecord::SetPeriod(const double _period)
 //////////////////////////////////////////////////
 std::string LogRecord::Filter() const
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->filterMutex);
   return this->dataPtr->filter;
 }
 
 //////////////////////////////////////////////////
 void LogRecord::SetFilter(const std::string &_filter)
 {
+  std::shared_ptr<const LogRecordFilter> compiled(
+      new LogRecordFilter(_filter));
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->filterMutex);
   this->dataPtr->filter = _filter;
+  this->dataPtr->compiledFilter = compiled;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const LogRecordFilter> LogRecord::CompiledFilter() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->filterMutex);
+  return this->dataPtr->compiledFilter;
 }
 
 //////////////////////////////////////////////////
@@ -792,7 +809,12 @@ unsigned int LogRecordPrivate::Log::Update()
   if (this->logCB(stream))
   {
     std::string data = stream.str();
-    if (!data.empty())
+    if (!data.empty() && this->binaryWriter)
+    {
+      // Binary logs store each frame as its own record.
+      this->binaryWriter->AddFrames(data, this->buffer);
+    }
+    else if (!data.empty())
     {
       const std::string &encodingLocal = this->parent->Encoding();
 
@@ -877,12 +899,23 @@ void LogRecordPrivate::Log::Stop()
     this->Update();
     this->Write();
 
-    std::string xmlEnd = "</gazebo_log>";
-    this->logFile.write(xmlEnd.c_str(), xmlEnd.size());
+    if (this->binaryWriter)
+    {
+      // Append the frame index.
+      std::string footer;
+      this->binaryWriter->Footer(footer);
+      this->logFile.write(footer.c_str(), footer.size());
+    }
+    else
+    {
+      std::string xmlEnd = "</gazebo_log>";
+      this->logFile.write(xmlEnd.c_str(), xmlEnd.size());
+    }
 
     this->logFile.close();
   }
 
+  this->binaryWriter.reset();
   this->completePath.clear();
 }
 
@@ -906,7 +939,16 @@ void LogRecordPrivate::Log::Start(const boost::filesystem::path &_path)
          << "<rand_seed>" << ignition::math::Rand::Seed() << "</rand_seed>\n"
          << "</header>\n";
 
-  this->buffer.append(stream.str());
+  if (this->parent->Encoding() == "bin")
+  {
+    stream << "</gazebo_log>\n";
+    this->binaryWriter.reset(new LogBinaryWriter());
+    this->binaryWriter->Header(stream.str(), this->buffer);
+  }
+  else
+  {
+    this->buffer.append(stream.str());
+  }
 }
 
 //////////////////////////////////////////////////
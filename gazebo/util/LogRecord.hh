@@ -18,11 +18,13 @@
 #define _GAZEBO_UTIL_LOGRECORD_HH_
 
 #include <fstream>
+#include <memory>
 #include <set>
 #include <string>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/UtilTypes.hh"
 #include "gazebo/util/system.hh"
 
 #define GZ_LOG_VERSION "1.0"
@@ -38,7 +40,7 @@ namespace gazebo
     /// \sa LogRecord::Start
     class LogRecordParams
     {
-      /// \brief The type of encoding (txt, zlib, or bz2).
+      /// \brief The type of encoding (txt, zlib, bz2, or bin).
       public: std::string encoding = "zlib";
 
       /// \brief Path in which to store log files.
@@ -153,6 +155,13 @@ namespace gazebo
       /// \param[in] _filter New log record filter regex string
       public: void SetFilter(const std::string &_filter);
 
+      /// \brief Get the log recording filter, compiled when the filter
+      /// string was set. The returned filter is never null, and stays valid
+      /// when the filter is changed.
+      /// \return Log recording filter.
+      /// \sa SetFilter
+      public: std::shared_ptr<const LogRecordFilter> CompiledFilter() const;
+
       /// \brief Get whether the model meshes and materials are saved when
       /// recording.
       /// \return True if model meshes and materials are saved when recording.
@@ -176,14 +185,15 @@ namespace gazebo
       public: bool Start(const LogRecordParams &_params);
 
       /// \brief Start the logger.
-      /// \param[in] _encoding The type of encoding (txt, zlib, or bz2).
+      /// \param[in] _encoding The type of encoding (txt, zlib, bz2, or bin).
       /// \param[in] _path Path in which to store log files.
       public: bool Start(const std::string &_encoding="zlib",
                          const std::string &_path="");
 
       /// \brief Get the encoding used.
-      /// \return Either [txt, zlib, or bz2], where txt is plain txt and bz2
-      /// and zlib are compressed data with Base64 encoding.
+      /// \return Either [txt, zlib, bz2, or bin], where txt is plain txt,
+      /// bz2 and zlib are compressed data with Base64 encoding, and bin is
+      /// the indexed binary format described in LogBinaryWriter.
       public: const std::string &Encoding() const;
 
       /// \brief Get the filename for a log object.
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <list>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/regex.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/util/LogRecordFilter.hh"
+
+using namespace gazebo;
+using namespace util;
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief One level of a filter.
+    class LogRecordFilterPattern
+    {
+      /// \brief How names are matched.
+      public: enum MatchType
+      {
+        /// \brief Every name matches.
+        ALL,
+
+        /// \brief Names must be equal to the pattern.
+        LITERAL,
+
+        /// \brief Names must match the regular expression.
+        REGEX
+      };
+
+      /// \brief Parse a pattern.
+      /// \param[in] _pattern Name pattern, with "*" wildcards.
+      public: void Parse(const std::string &_pattern)
+      {
+        if (_pattern.empty() || _pattern == "*")
+        {
+          this->type = ALL;
+          return;
+        }
+
+        // Plain names are compared directly.
+        if (_pattern.find_first_of("*+?[](){}|^$\\") == std::string::npos)
+        {
+          this->type = LITERAL;
+          this->literal = _pattern;
+          return;
+        }
+
+        std::string regexStr = _pattern;
+        boost::replace_all(regexStr, "*", ".*");
+        try
+        {
+          this->regex.assign(regexStr);
+          this->type = REGEX;
+        }
+        catch(const boost::regex_error &_e)
+        {
+          gzerr << "Invalid log filter pattern[" << _pattern << "]: "
+                << _e.what() << ". The pattern will be matched literally.\n";
+          this->type = LITERAL;
+          this->literal = _pattern;
+        }
+      }
+
+      /// \brief Match a name.
+      /// \param[in] _name Name to match.
+      /// \return True if the name matches.
+      public: bool Match(const std::string &_name) const
+      {
+        switch (this->type)
+        {
+          case LITERAL:
+            return _name == this->literal;
+          case REGEX:
+            return boost::regex_match(_name, this->regex);
+          default:
+            return true;
+        }
+      }
+
+      /// \brief How names are matched.
+      public: MatchType type = ALL;
+
+      /// \brief Name used by LITERAL patterns.
+      public: std::string literal;
+
+      /// \brief Compiled expression used by REGEX patterns.
+      public: boost::regex regex;
+    };
+
+    /// \internal
+    /// \brief Private data for LogRecordFilter
+    class LogRecordFilterPrivate
+    {
+      /// \brief The filter string.
+      public: std::string filter;
+
+      /// \brief Model name pattern.
+      public: LogRecordFilterPattern model;
+
+      /// \brief Link name pattern.
+      public: LogRecordFilterPattern link;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+LogRecordFilter::LogRecordFilter()
+  : dataPtr(new LogRecordFilterPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+LogRecordFilter::LogRecordFilter(const std::string &_filter)
+  : dataPtr(new LogRecordFilterPrivate)
+{
+  this->dataPtr->filter = _filter;
+
+  std::list<std::string> mainParts;
+  boost::split(mainParts, _filter, boost::is_any_of("/"));
+
+  // The first element of each level is a name or a star, followed by the
+  // state components. Joint states are not recorded, so the joint level
+  // is ignored.
+  LogRecordFilterPattern *patterns[] = {&this->dataPtr->model,
+    &this->dataPtr->link};
+  auto partIter = mainParts.begin();
+  for (auto pattern : patterns)
+  {
+    if (partIter == mainParts.end())
+      break;
+
+    pattern->Parse(partIter->substr(0, partIter->find('.')));
+    ++partIter;
+  }
+}
+
+/////////////////////////////////////////////////
+LogRecordFilter::~LogRecordFilter()
+{
+}
+
+/////////////////////////////////////////////////
+const std::string &LogRecordFilter::Filter() const
+{
+  return this->dataPtr->filter;
+}
+
+/////////////////////////////////////////////////
+bool LogRecordFilter::MatchAll() const
+{
+  return this->dataPtr->model.type == LogRecordFilterPattern::ALL &&
+    this->dataPtr->link.type == LogRecordFilterPattern::ALL;
+}
+
+/////////////////////////////////////////////////
+bool LogRecordFilter::MatchModel(const std::string &_name) const
+{
+  return this->dataPtr->model.Match(_name);
+}
+
+/////////////////////////////////////////////////
+bool LogRecordFilter::MatchLink(const std::string &_name) const
+{
+  return this->dataPtr->link.Match(_name);
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef _GAZEBO_UTIL_LOGRECORDFILTER_HH_
+#define _GAZEBO_UTIL_LOGRECORDFILTER_HH_
+
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    // Forward declare private data class
+    class LogRecordFilterPrivate;
+
+    /// addtogroup gazebo_util
+    /// \{
+
+    /// \class LogRecordFilter LogRecordFilter.hh util/util.hh
+    /// \brief A log recording filter, parsed once.
+    ///
+    /// The filter string has the form model/link/joint, where each level is
+    /// a name pattern optionally followed by "." separated state
+    /// components, e.g. "robot*.pose/arm_*". Patterns support the "*"
+    /// wildcard and regular expressions. An empty level, or "*", matches
+    /// every name without evaluating a regular expression. Joint states
+    /// are not recorded, so the joint level is ignored.
+    ///
+    /// \sa LogRecord::SetFilter
+    class GZ_UTIL_VISIBLE LogRecordFilter
+    {
+      /// \brief Constructor for a filter that matches everything.
+      public: LogRecordFilter();
+
+      /// \brief Constructor
+      /// \param[in] _filter Filter string.
+      public: explicit LogRecordFilter(const std::string &_filter);
+
+      /// \brief Destructor
+      public: virtual ~LogRecordFilter();
+
+      /// \brief Get the filter string.
+      /// \return The string the filter was built from.
+      public: const std::string &Filter() const;
+
+      /// \brief Get whether the filter matches every entity.
+      /// \return True if no level of the filter restricts names.
+      public: bool MatchAll() const;
+
+      /// \brief Check a model name against the model pattern.
+      /// \param[in] _name Name of a model.
+      /// \return True if the model state should be recorded.
+      public: bool MatchModel(const std::string &_name) const;
+
+      /// \brief Check a link name against the link pattern.
+      /// \param[in] _name Name of a link.
+      /// \return True if the link state should be recorded.
+      public: bool MatchLink(const std::string &_name) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LogRecordFilterPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
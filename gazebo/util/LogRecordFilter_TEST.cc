@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "gazebo/util/LogRecordFilter.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class LogRecordFilter_TEST : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Empty and star filters match everything.
+TEST_F(LogRecordFilter_TEST, MatchAll)
+{
+  for (auto const &str : {"", "*", "*/*", "*.pose/*.velocity", "*/*/*"})
+  {
+    util::LogRecordFilter filter(str);
+    EXPECT_EQ(filter.Filter(), str);
+    EXPECT_TRUE(filter.MatchAll()) << str;
+    EXPECT_TRUE(filter.MatchModel("box")) << str;
+    EXPECT_TRUE(filter.MatchLink("link")) << str;
+  }
+
+  util::LogRecordFilter filter;
+  EXPECT_TRUE(filter.MatchAll());
+  EXPECT_TRUE(filter.Filter().empty());
+}
+
+/////////////////////////////////////////////////
+/// \brief Model and link levels. The joint level is ignored.
+TEST_F(LogRecordFilter_TEST, Levels)
+{
+  util::LogRecordFilter filter("pendulum_*.pose/arm/joint_[0-9]");
+  EXPECT_FALSE(filter.MatchAll());
+
+  EXPECT_TRUE(filter.MatchModel("pendulum_0deg"));
+  EXPECT_TRUE(filter.MatchModel("pendulum_"));
+  EXPECT_FALSE(filter.MatchModel("box"));
+  EXPECT_FALSE(filter.MatchModel("my_pendulum_0deg"));
+
+  EXPECT_TRUE(filter.MatchLink("arm"));
+  EXPECT_FALSE(filter.MatchLink("arm2"));
+  EXPECT_FALSE(filter.MatchLink("base"));
+}
+
+/////////////////////////////////////////////////
+/// \brief Only the model level is restricted.
+TEST_F(LogRecordFilter_TEST, ModelOnly)
+{
+  util::LogRecordFilter filter("box");
+  EXPECT_FALSE(filter.MatchAll());
+  EXPECT_TRUE(filter.MatchModel("box"));
+  EXPECT_FALSE(filter.MatchModel("box2"));
+  EXPECT_TRUE(filter.MatchLink("link"));
+}
+
+/////////////////////////////////////////////////
+/// \brief An invalid expression is matched literally.
+TEST_F(LogRecordFilter_TEST, Invalid)
+{
+  util::LogRecordFilter filter("box[");
+  EXPECT_TRUE(filter.MatchModel("box["));
+  EXPECT_FALSE(filter.MatchModel("box"));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -19,6 +19,8 @@
 
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <thread>
@@ -26,6 +28,9 @@
 #include <condition_variable>
 #include <boost/filesystem.hpp>
 
+#include "gazebo/util/LogBinary.hh"
+#include "gazebo/util/LogRecordFilter.hh"
+
 namespace gazebo
 {
   namespace util
@@ -101,6 +106,9 @@ namespace gazebo
 
         /// \brief Complete file path.
         public: boost::filesystem::path completePath;
+
+        /// \brief Frame encoder, used with the "bin" encoding.
+        public: std::unique_ptr<LogBinaryWriter> binaryWriter;
       };
 
       /// \def Log_M
@@ -209,6 +217,12 @@ namespace gazebo
       /// \brief Record filter string.
       public: std::string filter = "";
 
+      /// \brief Record filter, compiled from the filter string.
+      public: std::shared_ptr<const LogRecordFilter> compiledFilter;
+
+      /// \brief Mutex to protect the compiled filter.
+      public: mutable std::mutex filterMutex;
+
       /// \brief Record with model resources.
       public: bool recordResources = false;
 
@@ -23,6 +23,7 @@
 #include "gazebo/common/SystemPaths.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/util/LogRecord.hh"
+#include "gazebo/util/LogRecordFilter.hh"
 #include "test/util.hh"
 
 class LogRecord_TEST : public gazebo::testing::AutoLogFixture { };
@@ -184,6 +185,37 @@ TEST_F(LogRecord_TEST, Start_zlib)
   }
 }
 
+/////////////////////////////////////////////////
+/// \brief Test LogRecord Start with the binary encoding
+TEST_F(LogRecord_TEST, Start_bin)
+{
+  gazebo::util::LogRecord *recorder = gazebo::util::LogRecord::Instance();
+
+  EXPECT_TRUE(recorder->Init("test"));
+  EXPECT_TRUE(recorder->Start("bin"));
+
+  // Make sure the right flags have been set
+  EXPECT_FALSE(recorder->Paused());
+  EXPECT_TRUE(recorder->Running());
+  EXPECT_TRUE(recorder->FirstUpdate());
+
+  // Make sure the right encoding is set
+  EXPECT_EQ(recorder->Encoding(), std::string("bin"));
+
+  // Stop recording.
+  recorder->Stop();
+  EXPECT_FALSE(recorder->Running());
+
+  // Logger may still be writing so make sure we exit cleanly
+  int i = 0;
+  while (!recorder->IsReadyToStart())
+  {
+    gazebo::common::Time::MSleep(100);
+    if ((++i % 50) == 0)
+      gzdbg << "Waiting for recorder->IsReadyToStart()" << std::endl;
+  }
+}
+
 /////////////////////////////////////////////////
 /// \brief Test LogRecord filter
 TEST_F(LogRecord_TEST, Filter)
@@ -203,11 +235,23 @@ TEST_F(LogRecord_TEST, Filter)
 
 
   // filter by regex string
+  ASSERT_TRUE(recorder->CompiledFilter() != nullptr);
+  EXPECT_TRUE(recorder->CompiledFilter()->MatchAll());
+
   recorder->SetFilter("robot*");
   EXPECT_EQ(recorder->Filter(), "robot*");
+  auto filter = recorder->CompiledFilter();
+  ASSERT_TRUE(filter != nullptr);
+  EXPECT_EQ(filter->Filter(), "robot*");
+  EXPECT_TRUE(filter->MatchModel("robot_1"));
+  EXPECT_FALSE(filter->MatchModel("box"));
 
   recorder->SetFilter("");
   EXPECT_EQ(recorder->Filter(), "");
+  EXPECT_TRUE(recorder->CompiledFilter()->MatchAll());
+
+  // A filter that was handed out stays valid.
+  EXPECT_EQ(filter->Filter(), "robot*");
 }
 
 /////////////////////////////////////////////////
@@ -32,6 +32,7 @@ namespace gazebo
   namespace util
   {
     class DiagnosticTimer;
+    class LogRecordFilter;
     class OpenALSink;
     class OpenALSource;
 
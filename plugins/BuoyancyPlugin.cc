@@ -148,7 +148,7 @@ void BuoyancyPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
 void BuoyancyPlugin::Init()
 {
   this->updateConnection = event::Events::ConnectWorldUpdateBegin(
-      std::bind(&BuoyancyPlugin::OnUpdate, this));
+      std::bind(&BuoyancyPlugin::OnUpdate, this), _model->GetScopedName());
 }
 
 /////////////////////////////////////////////////
@@ -142,7 +142,8 @@ void LiftDragPlugin::Load(physics::ModelPtr _model,
     else
     {
       this->updateConnection = event::Events::ConnectWorldUpdateBegin(
-          std::bind(&LiftDragPlugin::OnUpdate, this));
+          std::bind(&LiftDragPlugin::OnUpdate, this),
+          _model->GetScopedName());
     }
   }
 
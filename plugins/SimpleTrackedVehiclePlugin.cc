@@ -219,6 +219,8 @@ void SimpleTrackedVehiclePlugin::Init()
   this->node = transport::NodePtr(new transport::Node());
   this->node->Init(model->GetWorld()->Name());
 
+  // DriveTracks rewrites the world-wide contacts that touch the tracks,
+  // which may be shared with other vehicles, so it is not model local.
   this->beforePhysicsUpdateConnection =
       event::Events::ConnectBeforePhysicsUpdate(
           std::bind(&SimpleTrackedVehiclePlugin::DriveTracks, this,
@@ -16,9 +16,15 @@
 */
 
 #ifndef _WIN32
+#include <stdlib.h>
 #include <unistd.h>
 #endif
+#include <atomic>
+#include <list>
+#include <string>
+
 #include "gazebo/test/ServerFixture.hh"
+#include "gazebo/transport/ConnectionManager.hh"
 
 using namespace gazebo;
 
@@ -788,6 +794,128 @@ TEST_F(TransportTest, TryInit)
   EXPECT_EQ(physics::get_world()->Name(), node->GetTopicNamespace());
 }
 
+#ifndef _WIN32
+/////////////////////////////////////////////////
+/// \brief Count the large messages received by a publication transport.
+/// \param[in] _data Serialized message.
+/// \param[in,out] _count Number of messages received.
+void ReceiveLargeMsg(const std::string &_data, std::atomic<int> *_count)
+{
+  msgs::GzString msg;
+  if (msg.ParseFromString(_data) && msg.data().size() == 100 * 1024)
+    ++(*_count);
+}
+
+/////////////////////////////////////////////////
+/// \brief Connect a publication transport to a publisher of this
+/// process, as a subscriber in another process on this host would.
+/// \param[in] _pub The publisher.
+/// \param[in,out] _count Number of messages received.
+/// \return The transport, null on error.
+transport::PublicationTransportPtr ConnectLargeMsg(
+    transport::PublisherPtr _pub, std::atomic<int> *_count)
+{
+  msgs::Publish publish;
+  bool found = false;
+  for (int i = 0; i < 50 && !found; ++i)
+  {
+    std::list<msgs::Publish> publishers;
+    transport::ConnectionManager::Instance()->GetAllPublishers(publishers);
+    for (auto const &p : publishers)
+    {
+      if (p.topic() == _pub->GetTopic())
+      {
+        publish = p;
+        found = true;
+      }
+    }
+    if (!found)
+      common::Time::MSleep(100);
+  }
+  if (!found || !publish.shm())
+    return transport::PublicationTransportPtr();
+
+  transport::ConnectionPtr conn =
+    transport::ConnectionManager::Instance()->ConnectToRemoteHost(
+        publish.host(), publish.port());
+  if (!conn)
+    return transport::PublicationTransportPtr();
+
+  transport::PublicationTransportPtr link(
+      new transport::PublicationTransport(publish.topic(),
+        publish.msg_type()));
+  link->AddCallback([_count](const std::string &_data)
+      {
+        ReceiveLargeMsg(_data, _count);
+      });
+
+  const unsigned int count = _pub->GetRemoteSubscriptionCount();
+  link->Init(conn, false, true);
+  for (int i = 0; i < 50 && _pub->GetRemoteSubscriptionCount() == count;
+       ++i)
+  {
+    common::Time::MSleep(100);
+  }
+
+  return link;
+}
+
+/////////////////////////////////////////////////
+/// Large messages negotiate shared memory, and are sent inline to a
+/// subscriber that can't open it.
+TEST_F(TransportTest, SharedMemory)
+{
+  unsetenv("GAZEBO_TRANSPORT_SHM");
+  Load("worlds/empty.world");
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::PublisherPtr pub =
+    node->Advertise<msgs::GzString>("~/shm_test");
+
+  std::atomic<int> shmCount(0);
+  transport::PublicationTransportPtr shmLink = ConnectLargeMsg(pub,
+      &shmCount);
+  ASSERT_TRUE(shmLink != nullptr);
+  EXPECT_EQ(pub->GetRemoteSubscriptionCount(), 1u);
+
+  msgs::GzString msg;
+  msg.set_data(std::string(100 * 1024, 'x'));
+
+  // None are lost while the subscriber opens the ring
+  for (int i = 0; i < 10; ++i)
+  {
+    pub->Publish(msg);
+    common::Time::MSleep(10);
+  }
+  for (int i = 0; i < 100 && shmCount < 10; ++i)
+    common::Time::MSleep(50);
+  EXPECT_EQ(shmCount.load(), 10);
+
+  // This subscriber rejects the ring. The first one already opened it.
+  setenv("GAZEBO_TRANSPORT_SHM", "0", 1);
+  std::atomic<int> tcpCount(0);
+  transport::PublicationTransportPtr tcpLink = ConnectLargeMsg(pub,
+      &tcpCount);
+  ASSERT_TRUE(tcpLink != nullptr);
+  EXPECT_EQ(pub->GetRemoteSubscriptionCount(), 2u);
+
+  for (int i = 0; i < 10; ++i)
+  {
+    pub->Publish(msg);
+    common::Time::MSleep(10);
+  }
+  for (int i = 0; i < 100 && (shmCount < 20 || tcpCount < 10); ++i)
+    common::Time::MSleep(50);
+  unsetenv("GAZEBO_TRANSPORT_SHM");
+  EXPECT_EQ(shmCount.load(), 20);
+  EXPECT_EQ(tcpCount.load(), 10);
+
+  shmLink->Fini();
+  tcpLink->Fini();
+}
+#endif
+
 /////////////////////////////////////////////////
 // Main
 int main(int argc, char **argv)
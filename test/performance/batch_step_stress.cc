@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <future>
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class BatchStepStressTest : public ServerFixture
+{
+  /// \brief Spawn a number of pioneer2dx robots.
+  /// \param[in] _count Number of robots to spawn.
+  public: void SpawnRobots(const unsigned int _count);
+
+  /// \brief Compare World::Step and World::StepBatch with different
+  /// publication periods, and print the steps per second of each.
+  /// \param[in] _label Description of the world.
+  public: void Compare(const std::string &_label);
+};
+
+/////////////////////////////////////////////////
+void BatchStepStressTest::SpawnRobots(const unsigned int _count)
+{
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  const unsigned int initialCount = world->ModelCount();
+  const int side = static_cast<int>(std::ceil(std::sqrt(_count)));
+
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+      << "<include>"
+      << "  <uri>model://pioneer2dx</uri>"
+      << "  <name>robot_" << i << "</name>"
+      << "  <pose>" << 2.0 * (i % side) << " " << 2.0 * (i / side)
+      << " 0 0 0 0</pose>"
+      << "</include>"
+      << "</sdf>";
+    world->InsertModelString(sdf.str());
+  }
+
+  int sleep = 0;
+  while (world->ModelCount() < initialCount + _count && sleep++ < 6000)
+    common::Time::MSleep(10);
+  ASSERT_EQ(world->ModelCount(), initialCount + _count);
+}
+
+/////////////////////////////////////////////////
+void BatchStepStressTest::Compare(const std::string &_label)
+{
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Remove the real time throttle
+  world->Physics()->SetRealTimeUpdateRate(0.0);
+
+  const unsigned int steps = 5000;
+
+  common::Time startTime = common::Time::GetWallTime();
+  world->Step(steps);
+  const double stepRate =
+    steps / (common::Time::GetWallTime() - startTime).Double();
+
+  gzmsg << _label << " Steps[" << steps << "]\n"
+        << "  Step               [" << stepRate << "] steps/s\n";
+
+  for (auto const period : {1u, 10u, 100u})
+  {
+    startTime = common::Time::GetWallTime();
+    std::future<void> done = world->StepBatch(steps, period);
+    ASSERT_TRUE(done.valid());
+    done.wait();
+    const double batchRate =
+      steps / (common::Time::GetWallTime() - startTime).Double();
+
+    gzmsg << "  StepBatch period " << period << "\t["
+          << batchRate << "] steps/s, speedup [" << batchRate / stepRate
+          << "]\n";
+    EXPECT_GT(batchRate, 0.0);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(BatchStepStressTest, EmptyWorld)
+{
+  Load("worlds/empty.world", true);
+  Compare("Empty world");
+}
+
+/////////////////////////////////////////////////
+TEST_F(BatchStepStressTest, Robots)
+{
+  Load("worlds/empty.world", true);
+  SpawnRobots(50);
+  Compare("50 pioneer2dx");
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
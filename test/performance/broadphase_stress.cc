@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class BroadphaseStressTest : public ServerFixture
+{
+  /// \brief Spawn a warehouse: rows of static shelves, and boxes moving
+  /// along the aisles.
+  /// \param[in] _shelves Number of shelves.
+  /// \param[in] _boxes Number of moving boxes.
+  public: void SpawnWarehouse(const unsigned int _shelves,
+              const unsigned int _boxes);
+
+  /// \brief Step the world and return the mean step duration.
+  /// \param[in] _steps Number of steps.
+  /// \return Wall clock time per step in microseconds.
+  public: double StepTime(const unsigned int _steps);
+};
+
+/////////////////////////////////////////////////
+void BroadphaseStressTest::SpawnWarehouse(const unsigned int _shelves,
+    const unsigned int _boxes)
+{
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  const unsigned int initialCount = world->ModelCount();
+  for (unsigned int i = 0; i < _shelves; ++i)
+  {
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='shelf_" << i << "'>"
+      << "<static>true</static>"
+      << "<pose>" << 1.2 * (i % 50) << " " << 3.0 * (i / 50)
+      << " 1 0 0 0</pose>"
+      << "<link name='link'>"
+      << "  <collision name='c'><geometry><box><size>1 0.5 2</size>"
+      << "  </box></geometry></collision>"
+      << "</link>"
+      << "</model>"
+      << "</sdf>";
+    world->InsertModelString(sdf.str());
+  }
+
+  for (unsigned int i = 0; i < _boxes; ++i)
+  {
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='box_" << i << "'>"
+      << "<pose>" << 1.2 * (i % 50) << " " << 3.0 * (i / 50) + 1.5
+      << " 0.25 0 0 0</pose>"
+      << "<link name='link'>"
+      << "  <velocity_decay><linear>0</linear></velocity_decay>"
+      << "  <collision name='c'><geometry><box><size>0.5 0.5 0.5</size>"
+      << "  </box></geometry>"
+      << "  <surface><friction><ode><mu>0</mu><mu2>0</mu2></ode>"
+      << "  </friction></surface></collision>"
+      << "</link>"
+      << "</model>"
+      << "</sdf>";
+    world->InsertModelString(sdf.str());
+  }
+
+  int sleep = 0;
+  while (world->ModelCount() < initialCount + _shelves + _boxes &&
+         sleep++ < 6000)
+  {
+    common::Time::MSleep(10);
+  }
+  ASSERT_EQ(world->ModelCount(), initialCount + _shelves + _boxes);
+
+  // Boxes slide along the aisles without friction
+  for (unsigned int i = 0; i < _boxes; ++i)
+  {
+    physics::ModelPtr box = world->ModelByName("box_" + std::to_string(i));
+    ASSERT_TRUE(box != nullptr);
+    box->SetLinearVel(ignition::math::Vector3d(1, 0, 0));
+  }
+}
+
+/////////////////////////////////////////////////
+double BroadphaseStressTest::StepTime(const unsigned int _steps)
+{
+  physics::WorldPtr world = physics::get_world("default");
+
+  common::Time startTime = common::Time::GetWallTime();
+  world->Step(_steps);
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+  return elapsed.Double() * 1e6 / _steps;
+}
+
+/////////////////////////////////////////////////
+/// \brief Compare the step time of each broadphase, for a world with
+/// many static shelves.
+TEST_F(BroadphaseStressTest, Warehouse)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+  physics->SetRealTimeUpdateRate(0.0);
+
+  const unsigned int shelves = 2000;
+  const unsigned int boxes = 100;
+  SpawnWarehouse(shelves, boxes);
+
+  const unsigned int steps = 500;
+  std::ostringstream result;
+  for (auto const &broadphase : {"hash", "sap", "quadtree", "bvh"})
+  {
+    for (const bool autoParams : {false, true})
+    {
+      EXPECT_TRUE(physics->SetParam("broadphase", std::string(broadphase)));
+      EXPECT_TRUE(physics->SetParam("broadphase_auto", autoParams));
+      world->Step(10);
+
+      result << "  " << broadphase << (autoParams ? " auto" : "      ")
+             << " [" << this->StepTime(steps) << "] us/step\n";
+    }
+  }
+
+  gzmsg << "Shelves[" << shelves << "] Boxes[" << boxes << "] Steps["
+        << steps << "]\n" << result.str();
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <memory>
+#include <string>
+
+#include "gazebo/common/ColladaLoader.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ColladaLoadStressTest : public ServerFixture,
+                              public testing::WithParamInterface<const char *>
+{
+};
+
+/////////////////////////////////////////////////
+TEST_P(ColladaLoadStressTest, Load)
+{
+  const std::string filename =
+      std::string(PROJECT_SOURCE_PATH) + "/" + GetParam();
+  const int loads = 5;
+
+  common::Time best;
+  unsigned int vertexCount = 0;
+  for (int i = 0; i < loads; ++i)
+  {
+    common::ColladaLoader loader;
+
+    common::Time startTime = common::Time::GetWallTime();
+    std::unique_ptr<common::Mesh> mesh(loader.Load(filename));
+    common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+    ASSERT_TRUE(mesh != nullptr);
+    EXPECT_GT(mesh->GetSubMeshCount(), 0u);
+    if (i == 0)
+      vertexCount = mesh->GetVertexCount();
+    else
+      EXPECT_EQ(mesh->GetVertexCount(), vertexCount);
+
+    if (i == 0 || elapsed < best)
+      best = elapsed;
+  }
+  EXPECT_GT(vertexCount, 0u);
+
+  gzmsg << "File[" << GetParam() << "]\n"
+        << "  vertices  [" << vertexCount << "]\n"
+        << "  load time [" << best.Double() * 1e3 << "] ms (best of "
+        << loads << ")\n";
+}
+
+// The largest COLLADA files in the tree
+INSTANTIATE_TEST_CASE_P(LargestFiles, ColladaLoadStressTest,
+    ::testing::Values(
+      "media/models/stand.dae",
+      "media/models/run.dae",
+      "media/models/walk.dae",
+      "media/models/sub_16.dae",
+      "media/models/chair3/models/chair.dae",
+      "test/data/cordless_drill/meshes/cordless_drill.dae"));
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
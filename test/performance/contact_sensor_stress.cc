@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/sensors/sensors.hh"
+#include "gazebo/transport/transport.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ContactSensorStressTest : public ServerFixture
+{
+  /// \brief Spawn boxes resting on the ground, each with a contact sensor.
+  /// \param[in] _count Number of boxes.
+  public: void SpawnBoxes(const unsigned int _count);
+
+  /// \brief Step the world and return the mean step duration.
+  /// \param[in] _steps Number of steps.
+  /// \return Wall clock time per step in microseconds.
+  public: double StepTime(const unsigned int _steps);
+
+  /// \brief Callback for contact messages.
+  /// \param[in] _msg Contacts message.
+  public: void OnContacts(ConstContactsPtr &_msg);
+
+  /// \brief Number of contact messages received.
+  public: unsigned int msgCount = 0;
+};
+
+/////////////////////////////////////////////////
+void ContactSensorStressTest::SpawnBoxes(const unsigned int _count)
+{
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  const unsigned int initialCount = world->ModelCount();
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='box_" << i << "'>"
+      << "<pose>" << 2.0 * (i % 10) << " " << 2.0 * (i / 10)
+      << " 0.25 0 0 0</pose>"
+      << "<link name='link'>"
+      << "  <collision name='c'><geometry><box><size>0.5 0.5 0.5</size>"
+      << "  </box></geometry></collision>"
+      << "  <sensor name='contact' type='contact'>"
+      << "    <always_on>true</always_on>"
+      << "    <update_rate>1000</update_rate>"
+      << "    <contact><collision>c</collision></contact>"
+      << "  </sensor>"
+      << "</link>"
+      << "</model>"
+      << "</sdf>";
+    world->InsertModelString(sdf.str());
+  }
+
+  int sleep = 0;
+  while (world->ModelCount() < initialCount + _count && sleep++ < 6000)
+    common::Time::MSleep(10);
+  ASSERT_EQ(world->ModelCount(), initialCount + _count);
+
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::string name = "default::box_" + std::to_string(i) +
+        "::link::contact";
+    sleep = 0;
+    while (!sensors::get_sensor(name) && sleep++ < 1000)
+      common::Time::MSleep(10);
+    ASSERT_TRUE(sensors::get_sensor(name) != nullptr) << name;
+  }
+}
+
+/////////////////////////////////////////////////
+double ContactSensorStressTest::StepTime(const unsigned int _steps)
+{
+  physics::WorldPtr world = physics::get_world("default");
+
+  common::Time startTime = common::Time::GetWallTime();
+  world->Step(_steps);
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+  return elapsed.Double() * 1e6 / _steps;
+}
+
+/////////////////////////////////////////////////
+void ContactSensorStressTest::OnContacts(ConstContactsPtr &/*_msg*/)
+{
+  ++this->msgCount;
+}
+
+/////////////////////////////////////////////////
+/// \brief Compare in process contact delivery with contact messages, for
+/// 100 contact sensors.
+TEST_F(ContactSensorStressTest, InProcess)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  world->Physics()->SetRealTimeUpdateRate(0.0);
+
+  const unsigned int count = 100;
+  SpawnBoxes(count);
+
+  // Let the boxes settle
+  world->Step(100);
+
+  const unsigned int steps = 2000;
+  const double inProcess = this->StepTime(steps);
+
+  // The sensors receive contacts without any message
+  physics::ContactManager *manager = world->Physics()->GetContactManager();
+  EXPECT_EQ(manager->GetFilterCount(), count);
+
+  auto sensor = std::dynamic_pointer_cast<sensors::ContactSensor>(
+      sensors::get_sensor("default::box_0::link::contact"));
+  ASSERT_TRUE(sensor != nullptr);
+  int sleep = 0;
+  while (sensor->Contacts().contact_size() == 0 && sleep++ < 100)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  EXPECT_GT(sensor->Contacts().contact_size(), 0);
+
+  // Subscribe to every filter topic, which forces a message per filter and
+  // step, as before contacts could be delivered in process.
+  std::vector<transport::SubscriberPtr> subs;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    subs.push_back(this->node->Subscribe(
+        "~/box_" + std::to_string(i) + "/link/contact/contacts",
+        &ContactSensorStressTest::OnContacts, this));
+  }
+  common::Time::MSleep(500);
+
+  const double withMessages = this->StepTime(steps);
+  EXPECT_GT(this->msgCount, 0u);
+
+  gzmsg << "Contact sensors[" << count << "] Steps[" << steps << "]\n"
+        << "  in process    [" << inProcess << "] us/step\n"
+        << "  with messages [" << withMessages << "] us/step\n"
+        << "  saving        [" << withMessages - inProcess << "] us/step\n";
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
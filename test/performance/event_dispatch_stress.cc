@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class EventDispatchStressTest
+  : public ServerFixture, public testing::WithParamInterface<unsigned int>
+{
+  /// \brief Spawn a number of boxes, each with a model local callback on
+  /// worldUpdateBegin and beforePhysicsUpdate.
+  /// \param[in] _count Number of models to spawn.
+  public: void SpawnBoxes(const unsigned int _count);
+
+  /// \brief Callback of a model, which does a fixed amount of work and
+  /// pushes the model up.
+  /// \param[in] _model Model of the callback.
+  public: void OnUpdate(physics::Model *_model);
+
+  /// \brief Step the world and return the achieved steps per second.
+  /// \param[in] _steps Number of steps to take.
+  /// \return Steps per second of wall clock time.
+  public: double StepRate(const unsigned int _steps);
+
+  /// \brief Compare serial and concurrent event dispatch.
+  /// \param[in] _count Number of models.
+  public: void Compare(const unsigned int _count);
+
+  /// \brief Connections of the model callbacks.
+  public: std::vector<event::ConnectionPtr> connections;
+
+  /// \brief Number of callbacks run.
+  public: std::atomic<uint64_t> callbackCount{0};
+};
+
+/////////////////////////////////////////////////
+void EventDispatchStressTest::SpawnBoxes(const unsigned int _count)
+{
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  const unsigned int initialCount = world->ModelCount();
+  const int side = static_cast<int>(std::ceil(std::sqrt(_count)));
+
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='box_" << i << "'>"
+      << "<pose>" << 2.0 * (i % side) << " " << 2.0 * (i / side)
+      << " 2 0 0 0</pose>"
+      << "<link name='link'>"
+      << "  <gravity>false</gravity>"
+      << "  <collision name='c'><geometry><box><size>1 1 1</size>"
+      << "  </box></geometry></collision>"
+      << "</link>"
+      << "</model>"
+      << "</sdf>";
+    world->InsertModelString(sdf.str());
+  }
+
+  int sleep = 0;
+  while (world->ModelCount() < initialCount + _count && sleep++ < 6000)
+    common::Time::MSleep(10);
+  ASSERT_EQ(world->ModelCount(), initialCount + _count);
+
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    physics::ModelPtr model = world->ModelByName("box_" + std::to_string(i));
+    ASSERT_TRUE(model != nullptr);
+
+    this->connections.push_back(event::Events::ConnectWorldUpdateBegin(
+        std::bind(&EventDispatchStressTest::OnUpdate, this, model.get()),
+        model->GetScopedName()));
+    this->connections.push_back(event::Events::ConnectBeforePhysicsUpdate(
+        std::bind(&EventDispatchStressTest::OnUpdate, this, model.get()),
+        model->GetScopedName()));
+  }
+}
+
+/////////////////////////////////////////////////
+void EventDispatchStressTest::OnUpdate(physics::Model *_model)
+{
+  // Stand in for the work of a plugin such as LiftDragPlugin
+  double sum = 0;
+  for (int i = 1; i < 2000; ++i)
+    sum += std::sin(i * 0.001) / i;
+
+  _model->GetLink("link")->AddForce(
+      ignition::math::Vector3d(0, 0, 1e-6 * (1.0 + sum)));
+  ++this->callbackCount;
+}
+
+/////////////////////////////////////////////////
+double EventDispatchStressTest::StepRate(const unsigned int _steps)
+{
+  physics::WorldPtr world = physics::get_world("default");
+
+  common::Time startTime = common::Time::GetWallTime();
+  world->Step(_steps);
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+  return _steps / elapsed.Double();
+}
+
+/////////////////////////////////////////////////
+void EventDispatchStressTest::Compare(const unsigned int _count)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Remove the real time throttle
+  world->Physics()->SetRealTimeUpdateRate(0.0);
+
+  SpawnBoxes(_count);
+
+  const unsigned int steps = 10000 / _count + 100;
+
+  world->SetParallelModelUpdate(false);
+  this->callbackCount = 0;
+  const double serialRate = this->StepRate(steps);
+  EXPECT_EQ(this->callbackCount.load(), 2u * _count * steps);
+
+  world->SetParallelModelUpdate(true);
+  this->callbackCount = 0;
+  const double parallelRate = this->StepRate(steps);
+  EXPECT_EQ(this->callbackCount.load(), 2u * _count * steps);
+
+  gzmsg << "Models[" << _count << "] Steps[" << steps << "]\n"
+        << "  serial   [" << serialRate << "] steps/s\n"
+        << "  parallel [" << parallelRate << "] steps/s\n"
+        << "  speedup  [" << parallelRate / serialRate << "]\n";
+
+  EXPECT_GT(serialRate, 0.0);
+  EXPECT_GT(parallelRate, 0.0);
+
+  // Every model was pushed up by its callbacks.
+  physics::ModelPtr model = world->ModelByName("box_0");
+  ASSERT_TRUE(model != nullptr);
+  EXPECT_GT(model->WorldLinearVel().Z(), 0.0);
+
+  this->connections.clear();
+}
+
+/////////////////////////////////////////////////
+TEST_P(EventDispatchStressTest, SerialVsParallel)
+{
+  Compare(GetParam());
+}
+
+INSTANTIATE_TEST_CASE_P(ModelCounts, EventDispatchStressTest,
+                        ::testing::Values(10u, 100u, 1000u));
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
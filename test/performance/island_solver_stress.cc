@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class IslandSolverStressTest : public ServerFixture
+{
+  /// \brief Reset the world, let the stacks settle, and step it.
+  /// \param[in] _steps Number of steps to measure.
+  /// \param[out] _iterations Mean number of PGS iterations per step.
+  /// \param[out] _time Wall clock time per step in microseconds.
+  public: void Measure(const unsigned int _steps, double &_iterations,
+              double &_time);
+};
+
+/////////////////////////////////////////////////
+void IslandSolverStressTest::Measure(const unsigned int _steps,
+    double &_iterations, double &_time)
+{
+  physics::WorldPtr world = physics::get_world("default");
+  physics::PhysicsEnginePtr physics = world->Physics();
+
+  world->Reset();
+  world->Step(200);
+
+  _iterations = 0;
+  common::Time startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < _steps; ++i)
+  {
+    world->Step(1);
+    _iterations += boost::any_cast<int>(physics->GetParam("iteration_count"));
+  }
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+  _iterations /= _steps;
+  _time = elapsed.Double() * 1e6 / _steps;
+}
+
+/////////////////////////////////////////////////
+/// \brief Compare the iterations to convergence and the step time of
+/// quickstep, with and without contact warm starting and island threads,
+/// on stacks of resting boxes, spheres and cylinders.
+TEST_F(IslandSolverStressTest, Stacks)
+{
+  Load("worlds/stacks.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+  ASSERT_EQ(physics->GetType(), "ode");
+  physics->SetRealTimeUpdateRate(0.0);
+
+  // Stop iterating once converged, so warm starting shows as fewer sweeps
+  EXPECT_TRUE(physics->SetParam("iters", 200));
+  EXPECT_TRUE(physics->SetParam("sor_lcp_tolerance", 1e-6));
+  EXPECT_TRUE(physics->SetParam("warm_start_factor", 1.0));
+
+  const unsigned int steps = 2000;
+  std::ostringstream result;
+  for (const int threads : {0, 4})
+  {
+    for (const double distance : {0.0, 0.01})
+    {
+      EXPECT_TRUE(physics->SetParam("island_threads", threads));
+      EXPECT_TRUE(physics->SetParam("contact_warm_start_distance", distance));
+
+      double iterations, time;
+      this->Measure(steps, iterations, time);
+      EXPECT_GT(iterations, 0.0);
+
+      result << "  island threads[" << threads << "] contact warm start["
+             << (distance > 0 ? "on " : "off") << "] iterations["
+             << iterations << "] [" << time << "] us/step\n";
+    }
+  }
+
+  gzmsg << "Models[" << world->ModelCount() << "] Steps[" << steps << "]\n"
+        << result.str();
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <memory>
+#include <string>
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/ColladaLoader.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+#include "gazebo/common/STLLoader.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class MeshCacheStressTest : public ServerFixture,
+                            public testing::WithParamInterface<const char *>
+{
+};
+
+/////////////////////////////////////////////////
+TEST_P(MeshCacheStressTest, ColdVsWarm)
+{
+  const std::string filename =
+      std::string(PROJECT_SOURCE_PATH) + "/" + GetParam();
+  const boost::filesystem::path path =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gz_mesh_cache_stress_%%%%%%%%");
+  common::MeshCache cache(path.string(), 1024 * 1024 * 1024);
+
+  // Cold start: parse the file, and save it in the cache
+  common::Time startTime = common::Time::GetWallTime();
+  const std::string key = common::MeshCache::Key(filename);
+  std::unique_ptr<common::Mesh> mesh;
+  if (boost::filesystem::path(filename).extension() == ".stl")
+    mesh.reset(common::STLLoader().Load(filename));
+  else
+    mesh.reset(common::ColladaLoader().Load(filename));
+  ASSERT_TRUE(mesh != nullptr);
+  const common::Time parseTime = common::Time::GetWallTime() - startTime;
+  EXPECT_TRUE(cache.Save(key, mesh.get()));
+
+  // Warm start: load it from the cache
+  const int loads = 5;
+  common::Time warmTime;
+  for (int i = 0; i < loads; ++i)
+  {
+    startTime = common::Time::GetWallTime();
+    std::unique_ptr<common::Mesh> cached(
+        cache.Load(common::MeshCache::Key(filename)));
+    const common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+    ASSERT_TRUE(cached != nullptr);
+    EXPECT_EQ(cached->GetVertexCount(), mesh->GetVertexCount());
+    EXPECT_EQ(cached->GetIndexCount(), mesh->GetIndexCount());
+    if (i == 0 || elapsed < warmTime)
+      warmTime = elapsed;
+  }
+
+  gzmsg << "File[" << GetParam() << "]\n"
+        << "  vertices   [" << mesh->GetVertexCount() << "]\n"
+        << "  cache size [" << cache.Size() / 1024 << "] KiB\n"
+        << "  cold load  [" << parseTime.Double() * 1e3 << "] ms\n"
+        << "  warm load  [" << warmTime.Double() * 1e3 << "] ms (best of "
+        << loads << ")\n";
+
+  boost::filesystem::remove_all(path);
+}
+
+// The largest meshes without a skeleton in the tree
+INSTANTIATE_TEST_CASE_P(LargestFiles, MeshCacheStressTest,
+    ::testing::Values(
+      "media/models/sub_16.dae",
+      "media/models/chair3/models/chair.dae",
+      "test/data/cordless_drill/meshes/cordless_drill.dae",
+      "test/media/models/cube_20k/meshes/cube_20k.stl"));
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
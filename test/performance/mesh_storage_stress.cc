@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <fstream>
+#include <memory>
+#include <set>
+#include <string>
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/STLLoader.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class MeshStorageStressTest : public ServerFixture,
+                              public testing::WithParamInterface<unsigned int>
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Write an ASCII STL file of a square grid of triangles.
+/// \param[in] _filename Path to the file.
+/// \param[in] _side Number of squares along each side of the grid.
+static void WriteGrid(const std::string &_filename, const unsigned int _side)
+{
+  std::ofstream out(_filename);
+  out << "solid grid\n";
+  for (unsigned int i = 0; i < _side; ++i)
+  {
+    for (unsigned int j = 0; j < _side; ++j)
+    {
+      const double x0 = i * 0.01;
+      const double y0 = j * 0.01;
+      const double x1 = (i + 1) * 0.01;
+      const double y1 = (j + 1) * 0.01;
+      out << "facet normal 0 0 1\nouter loop\n"
+          << "vertex " << x0 << " " << y0 << " 0\n"
+          << "vertex " << x1 << " " << y0 << " 0\n"
+          << "vertex " << x1 << " " << y1 << " 0\n"
+          << "endloop\nendfacet\n"
+          << "facet normal 0 0 1\nouter loop\n"
+          << "vertex " << x0 << " " << y0 << " 0\n"
+          << "vertex " << x1 << " " << y1 << " 0\n"
+          << "vertex " << x0 << " " << y1 << " 0\n"
+          << "endloop\nendfacet\n";
+    }
+  }
+  out << "endsolid grid\n";
+}
+
+/////////////////////////////////////////////////
+TEST_P(MeshStorageStressTest, LoadAndFill)
+{
+  const unsigned int side = GetParam();
+  const boost::filesystem::path path =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gz_mesh_storage_%%%%%%%%.stl");
+  WriteGrid(path.string(), side);
+
+  // Loading finds the duplicated vertices of each triangle
+  common::Time startTime = common::Time::GetWallTime();
+  std::unique_ptr<common::Mesh> mesh(common::STLLoader().Load(path.string()));
+  const common::Time loadTime = common::Time::GetWallTime() - startTime;
+  boost::filesystem::remove(path);
+
+  ASSERT_TRUE(mesh != nullptr);
+  ASSERT_EQ(mesh->GetSubMeshCount(), 1u);
+  const unsigned int vertexCount = mesh->GetVertexCount();
+  EXPECT_EQ(vertexCount, side * side * 6);
+  const common::SubMesh *subMesh = mesh->GetSubMesh(0);
+  std::set<unsigned int> uniqueIndices;
+  for (unsigned int i = 0; i < subMesh->GetIndexCount(); ++i)
+    uniqueIndices.insert(subMesh->GetIndex(i));
+  EXPECT_EQ(uniqueIndices.size(), (side + 1) * (side + 1));
+
+  // Fill the arrays given to the physics engines, in both storages
+  common::Time fillTime[2];
+  for (int compact = 0; compact < 2; ++compact)
+  {
+    mesh->SetCompact(compact != 0);
+
+    float *vertices = nullptr;
+    int *indices = nullptr;
+    startTime = common::Time::GetWallTime();
+    mesh->FillArrays(&vertices, &indices);
+    fillTime[compact] = common::Time::GetWallTime() - startTime;
+
+    EXPECT_FLOAT_EQ(vertices[3 * vertexCount - 2], side * 0.01f);
+    delete [] vertices;
+    delete [] indices;
+  }
+
+  gzmsg << "Triangles[" << side * side * 2 << "]\n"
+        << "  load time          [" << loadTime.Double() * 1e3 << "] ms\n"
+        << "  vertex storage     [" << vertexCount * 2 * 24 / 1024
+        << "] KiB double, [" << vertexCount * 2 * 12 / 1024
+        << "] KiB compact\n"
+        << "  fill time double   [" << fillTime[0].Double() * 1e3 << "] ms\n"
+        << "  fill time compact  [" << fillTime[1].Double() * 1e3 << "] ms\n";
+}
+
+INSTANTIATE_TEST_CASE_P(Sides, MeshStorageStressTest,
+    ::testing::Values(50u, 200u));
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ModelUpdateStressTest : public ServerFixture,
+                              public testing::WithParamInterface<unsigned int>
+{
+  /// \brief Spawn a number of double pendulums, and command their joints
+  /// with position controllers.
+  /// \param[in] _count Number of models to spawn.
+  public: void SpawnPendulums(const unsigned int _count);
+
+  /// \brief Step the world and return the achieved steps per second.
+  /// \param[in] _steps Number of steps to take.
+  /// \return Steps per second of wall clock time.
+  public: double StepRate(const unsigned int _steps);
+
+  /// \brief Compare serial and parallel model updates.
+  /// \param[in] _count Number of models.
+  public: void Compare(const unsigned int _count);
+};
+
+/////////////////////////////////////////////////
+void ModelUpdateStressTest::SpawnPendulums(const unsigned int _count)
+{
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  const unsigned int initialCount = world->ModelCount();
+  const int side = static_cast<int>(std::ceil(std::sqrt(_count)));
+
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='pendulum_" << i << "'>"
+      << "<pose>" << 2.0 * (i % side) << " " << 2.0 * (i / side)
+      << " 1.5 0 0 0</pose>"
+      << "<link name='base'>"
+      << "  <collision name='c'><geometry><box><size>0.2 0.2 0.2</size>"
+      << "  </box></geometry></collision>"
+      << "</link>"
+      << "<link name='arm1'><pose>0 0 -0.5 0 0 0</pose>"
+      << "  <collision name='c'><geometry><box><size>0.05 0.05 0.5</size>"
+      << "  </box></geometry></collision>"
+      << "</link>"
+      << "<link name='arm2'><pose>0 0 -1.0 0 0 0</pose>"
+      << "  <collision name='c'><geometry><box><size>0.05 0.05 0.5</size>"
+      << "  </box></geometry></collision>"
+      << "</link>"
+      << "<joint name='fix' type='fixed'>"
+      << "  <parent>world</parent><child>base</child>"
+      << "</joint>"
+      << "<joint name='j1' type='revolute'>"
+      << "  <parent>base</parent><child>arm1</child>"
+      << "  <axis><xyz>1 0 0</xyz></axis>"
+      << "</joint>"
+      << "<joint name='j2' type='revolute'>"
+      << "  <parent>arm1</parent><child>arm2</child>"
+      << "  <axis><xyz>1 0 0</xyz></axis>"
+      << "</joint>"
+      << "</model>"
+      << "</sdf>";
+    world->InsertModelString(sdf.str());
+  }
+
+  int sleep = 0;
+  while (world->ModelCount() < initialCount + _count && sleep++ < 6000)
+    common::Time::MSleep(10);
+  ASSERT_EQ(world->ModelCount(), initialCount + _count);
+
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    physics::ModelPtr model =
+        world->ModelByName("pendulum_" + std::to_string(i));
+    ASSERT_TRUE(model != nullptr);
+
+    physics::JointControllerPtr controller = model->GetJointController();
+    ASSERT_TRUE(controller != nullptr);
+    for (auto const &joint : {"j1", "j2"})
+    {
+      std::string name = model->GetScopedName() + "::" + joint;
+      controller->SetPositionPID(name, common::PID(10, 0.1, 1));
+      EXPECT_TRUE(controller->SetPositionTarget(name, 0.5));
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+double ModelUpdateStressTest::StepRate(const unsigned int _steps)
+{
+  physics::WorldPtr world = physics::get_world("default");
+
+  common::Time startTime = common::Time::GetWallTime();
+  world->Step(_steps);
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+  return _steps / elapsed.Double();
+}
+
+/////////////////////////////////////////////////
+void ModelUpdateStressTest::Compare(const unsigned int _count)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Remove the real time throttle
+  world->Physics()->SetRealTimeUpdateRate(0.0);
+
+  SpawnPendulums(_count);
+
+  const unsigned int steps = 10000 / _count + 100;
+
+  world->SetParallelModelUpdate(false);
+  EXPECT_FALSE(world->ParallelModelUpdate());
+  const double serialRate = this->StepRate(steps);
+
+  world->SetParallelModelUpdate(true);
+  EXPECT_TRUE(world->ParallelModelUpdate());
+  const double parallelRate = this->StepRate(steps);
+
+  gzmsg << "Models[" << _count << "] Steps[" << steps << "]\n"
+        << "  serial   [" << serialRate << "] steps/s\n"
+        << "  parallel [" << parallelRate << "] steps/s\n"
+        << "  speedup  [" << parallelRate / serialRate << "]\n";
+
+  EXPECT_GT(serialRate, 0.0);
+  EXPECT_GT(parallelRate, 0.0);
+
+  // The joint controllers must still be driving every model.
+  physics::ModelPtr model = world->ModelByName("pendulum_0");
+  ASSERT_TRUE(model != nullptr);
+  EXPECT_GT(model->GetJoint("j1")->Position(0), 0.1);
+}
+
+/////////////////////////////////////////////////
+TEST_P(ModelUpdateStressTest, SerialVsParallel)
+{
+  Compare(GetParam());
+}
+
+INSTANTIATE_TEST_CASE_P(ModelCounts, ModelUpdateStressTest,
+                        ::testing::Values(10u, 100u, 1000u));
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
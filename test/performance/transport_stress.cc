@@ -15,6 +15,10 @@
  *
 */
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 #include <boost/thread.hpp>
 #include "gazebo/test/ServerFixture.hh"
 #include "RAMLibrary.hh"
@@ -110,7 +114,8 @@ TEST_F(TransportStressTest, LocalPublish)
 
   // Out time time for human testing purposes
   gzmsg << "Time to publish " << g_localPublishCount  << " messages = "
-    << diff << "\n";
+    << diff << " (" << g_localPublishCount / diff.Double()
+    << " msgs/sec)\n";
 
   delete [] fakeData;
 }
@@ -236,6 +241,104 @@ TEST_F(TransportStressTest, ManyNodes)
   delete [] fakeData;
 }
 
+/////////////////////////////////////////////////
+// Latencies of the messages received by ThroughputCB, in microseconds.
+std::vector<double> g_latencies;
+
+void ThroughputCB(ConstTimePtr &_msg)
+{
+  common::Time latency = common::Time::GetWallTime() - msgs::Convert(*_msg);
+
+  boost::mutex::scoped_lock lock(g_mutex);
+  g_latencies.push_back(latency.Double() * 1e6);
+}
+
+/////////////////////////////////////////////////
+// Publish small time stamped messages from several threads, with both the
+// copying and the shared publish functions, and report the throughput and
+// the 99th percentile latency.
+TEST_F(TransportStressTest, Throughput)
+{
+  Load("worlds/empty.world");
+
+  transport::NodePtr testNode = transport::NodePtr(new transport::Node());
+  testNode->Init("default");
+
+  const unsigned int threadCount = 4;
+  const unsigned int msgCount = 100000;
+
+  transport::PublisherPtr pub = testNode->Advertise<msgs::Time>(
+      "~/test/throughput__", threadCount * msgCount);
+  transport::SubscriberPtr sub = testNode->Subscribe("~/test/throughput__",
+      &ThroughputCB);
+
+  for (const bool shared : {false, true})
+  {
+    {
+      boost::mutex::scoped_lock lock(g_mutex);
+      g_latencies.clear();
+      g_latencies.reserve(threadCount * msgCount);
+    }
+
+    common::Time startTime = common::Time::GetWallTime();
+
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < threadCount; ++t)
+    {
+      threads.push_back(std::thread([&]()
+      {
+        for (unsigned int i = 0; i < msgCount; ++i)
+        {
+          if (shared)
+          {
+            boost::shared_ptr<msgs::Time> msg(new msgs::Time);
+            msgs::Set(msg.get(), common::Time::GetWallTime());
+            pub->Publish(boost::shared_ptr<const msgs::Time>(msg));
+          }
+          else
+          {
+            msgs::Time msg;
+            msgs::Set(&msg, common::Time::GetWallTime());
+            pub->Publish(msg);
+          }
+        }
+      }));
+    }
+    for (auto &thread : threads)
+      thread.join();
+
+    // Wait for all the messages
+    size_t received = 0;
+    int waitCount = 0;
+    while (waitCount++ < 300)
+    {
+      {
+        boost::mutex::scoped_lock lock(g_mutex);
+        received = g_latencies.size();
+      }
+      if (received >= threadCount * msgCount)
+        break;
+      common::Time::MSleep(100);
+    }
+    common::Time duration = common::Time::GetWallTime() - startTime;
+
+    EXPECT_EQ(threadCount * msgCount, received);
+
+    boost::mutex::scoped_lock lock(g_mutex);
+    double p99 = 0;
+    if (!g_latencies.empty())
+    {
+      auto p99Iter = g_latencies.begin() + g_latencies.size() * 99 / 100;
+      std::nth_element(g_latencies.begin(), p99Iter, g_latencies.end());
+      p99 = *p99Iter;
+    }
+
+    gzmsg << (shared ? "Shared" : "Copied") << " publish: "
+      << received / duration.Double() << " msgs/sec, p99 latency "
+      << p99 << " us\n";
+  }
+}
+
 /////////////////////////////////////////////////
 // Main function
 int main(int argc, char **argv)
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/physics/ode/ODEMesh.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class TrimeshInstancesStressTest : public ServerFixture,
+                                   public testing::WithParamInterface<bool>
+{
+  /// \brief Spawn instances of a 20k triangle mesh, and report the time
+  /// taken and the memory used.
+  /// \param[in] _count Number of instances.
+  /// \param[in] _shared True to give every instance the same scale, so
+  /// that they share their trimesh data.
+  public: void SpawnInstances(const unsigned int _count, const bool _shared);
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the resident set size of the process.
+/// \return Resident set size in kilobytes, 0 if unknown.
+static uint64_t ResidentSize()
+{
+  std::ifstream file("/proc/self/status");
+  std::string token;
+  while (file >> token)
+  {
+    if (token == "VmRSS:")
+    {
+      uint64_t size = 0;
+      file >> size;
+      return size;
+    }
+  }
+  return 0;
+}
+
+/////////////////////////////////////////////////
+void TrimeshInstancesStressTest::SpawnInstances(const unsigned int _count,
+    const bool _shared)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  const std::string uri = std::string(TEST_PATH) +
+      "/media/models/cube_20k/meshes/cube_20k.stl";
+  const int side = static_cast<int>(std::ceil(std::sqrt(_count)));
+  const unsigned int initialCount = world->ModelCount();
+  const unsigned int initialDataCount = physics::ODEMesh::DataCount();
+  const uint64_t initialDataSize = physics::ODEMesh::DataSize();
+  const uint64_t initialResident = ResidentSize();
+
+  common::Time startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    // A slightly different scale gives each instance its own data
+    const double scale = _shared ? 0.001 : 0.001 * (1.0 + 1e-6 * i);
+
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='shelf_" << i << "'>"
+      << "<static>true</static>"
+      << "<pose>" << 2.0 * (i % side) << " " << 2.0 * (i / side)
+      << " 0 0 0 0</pose>"
+      << "<link name='link'>"
+      << "  <collision name='c'><geometry><mesh>"
+      << "    <uri>" << uri << "</uri>"
+      << "    <scale>" << scale << " " << scale << " " << scale << "</scale>"
+      << "  </mesh></geometry></collision>"
+      << "</link>"
+      << "</model>"
+      << "</sdf>";
+    world->InsertModelString(sdf.str());
+  }
+
+  int sleep = 0;
+  while (world->ModelCount() < initialCount + _count && sleep++ < 60000)
+    common::Time::MSleep(10);
+  ASSERT_EQ(world->ModelCount(), initialCount + _count);
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+  const unsigned int dataCount =
+      physics::ODEMesh::DataCount() - initialDataCount;
+  const uint64_t dataSize = physics::ODEMesh::DataSize() - initialDataSize;
+  const uint64_t resident = ResidentSize();
+
+  gzmsg << "Instances[" << _count << "] Shared[" << _shared << "]\n"
+        << "  load time     [" << elapsed.Double() << "] s\n"
+        << "  trimesh data  [" << dataCount << "]\n"
+        << "  trimesh size  [" << dataSize / 1024 << "] KiB\n"
+        << "  resident size [" << (resident - initialResident) / 1024
+        << "] MiB more\n";
+
+  if (_shared)
+    EXPECT_EQ(dataCount, 1u);
+  else
+    EXPECT_EQ(dataCount, _count);
+
+  // The instances still collide
+  world->Step(10);
+}
+
+/////////////////////////////////////////////////
+TEST_P(TrimeshInstancesStressTest, SharedVsUnique)
+{
+  SpawnInstances(500, GetParam());
+}
+
+INSTANTIATE_TEST_CASE_P(Shared, TrimeshInstancesStressTest,
+                        ::testing::Values(true, false));
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
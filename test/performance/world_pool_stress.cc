@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/gazebo.hh"
+#include "gazebo/physics/physics.hh"
+
+using namespace gazebo;
+
+class WorldPoolStressTest : public ::testing::Test
+{
+  protected: virtual void SetUp()
+  {
+    ASSERT_TRUE(gazebo::setupServer());
+  }
+
+  protected: virtual void TearDown()
+  {
+    gazebo::shutdown();
+  }
+
+  /// \brief Create, load and initialize a world with a few falling boxes.
+  /// The world is stepped by the pool, so it isn't run.
+  /// \param[in] _index Index of the world, used to name it.
+  /// \return The world.
+  protected: physics::WorldPtr CreateWorld(const unsigned int _index);
+};
+
+/////////////////////////////////////////////////
+physics::WorldPtr WorldPoolStressTest::CreateWorld(const unsigned int _index)
+{
+  std::ostringstream worldStr;
+  worldStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<world name='pool_" << _index << "'>"
+    << "  <include><uri>model://ground_plane</uri></include>";
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    worldStr << "  <model name='box_" << i << "'>"
+      << "    <pose>0 " << i * 1.5 << " " << 0.5 + i << " 0 0 0</pose>"
+      << "    <link name='link'>"
+      << "      <collision name='collision'>"
+      << "        <geometry><box><size>1 1 1</size></box></geometry>"
+      << "      </collision>"
+      << "    </link>"
+      << "  </model>";
+  }
+  worldStr << "</world></sdf>";
+
+  sdf::SDFPtr worldSDF(new sdf::SDF);
+  sdf::init(worldSDF);
+  sdf::readString(worldStr.str(), worldSDF);
+
+  physics::WorldPtr world = physics::create_world();
+  physics::load_world(world, worldSDF->Root()->GetElement("world"));
+  physics::init_world(world);
+  return world;
+}
+
+/////////////////////////////////////////////////
+/// \brief Step a growing number of worlds on the shared pool, and print
+/// the aggregate steps per second.
+TEST_F(WorldPoolStressTest, Scaling)
+{
+  const unsigned int steps = 1000;
+  unsigned int worldCount = 0;
+
+  for (auto const count : {1u, 2u, 4u, 8u, 16u, 32u, 64u})
+  {
+    for (; worldCount < count; ++worldCount)
+      ASSERT_TRUE(this->CreateWorld(worldCount) != nullptr);
+
+    std::vector<common::Time> startSimTimes;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      startSimTimes.push_back(
+          physics::get_world("pool_" + std::to_string(i))->SimTime());
+    }
+
+    common::Time startTime = common::Time::GetWallTime();
+    physics::step_worlds(steps, 100);
+    const double elapsed =
+      (common::Time::GetWallTime() - startTime).Double();
+
+    gzmsg << "Worlds[" << count << "] Steps[" << steps << "] aggregate ["
+          << count * steps / elapsed << "] steps/s\n";
+
+    // Every world took its steps
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      physics::WorldPtr world =
+        physics::get_world("pool_" + std::to_string(i));
+      ASSERT_TRUE(world != nullptr);
+      EXPECT_NEAR((world->SimTime() - startSimTimes[i]).Double(),
+          steps * world->Physics()->GetMaxStepSize(), 1e-6);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
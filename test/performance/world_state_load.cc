@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <functional>
+#include <sstream>
+#include <string>
+
+#include <boost/regex.hpp>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/util/LogRecordFilter.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class WorldStateLoadTest : public ServerFixture
+{
+  /// \brief Spawn a number of static boxes.
+  /// \param[in] _count Number of models to spawn.
+  public: void SpawnBoxes(const unsigned int _count);
+
+  /// \brief Call a function repeatedly and return the mean duration.
+  /// \param[in] _func Function to time.
+  /// \return Mean wall clock time per call in microseconds.
+  public: double Time(const std::function<void()> &_func);
+};
+
+/////////////////////////////////////////////////
+void WorldStateLoadTest::SpawnBoxes(const unsigned int _count)
+{
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  const unsigned int initialCount = world->ModelCount();
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='box_" << i << "'>"
+      << "<static>true</static>"
+      << "<pose>" << i % 100 << " " << i / 100 << " 0.5 0 0 0</pose>"
+      << "<link name='link'>"
+      << "  <collision name='c'><geometry><box><size>0.5 0.5 0.5</size>"
+      << "  </box></geometry></collision>"
+      << "</link>"
+      << "</model>"
+      << "</sdf>";
+    world->InsertModelString(sdf.str());
+  }
+
+  int sleep = 0;
+  while (world->ModelCount() < initialCount + _count && sleep++ < 6000)
+    common::Time::MSleep(10);
+  ASSERT_EQ(world->ModelCount(), initialCount + _count);
+}
+
+/////////////////////////////////////////////////
+double WorldStateLoadTest::Time(const std::function<void()> &_func)
+{
+  const unsigned int iterations = 200;
+
+  common::Time startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < iterations; ++i)
+    _func();
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+  return elapsed.Double() * 1e6 / iterations;
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldStateLoadTest, Filters)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  const unsigned int count = 1000;
+  SpawnBoxes(count);
+  const unsigned int models = world->ModelCount();
+
+  // Each variant uses its own state, since model states are only removed
+  // when the (paused) real time changes.
+  physics::WorldState unfilteredState, filteredState, compiledState,
+      literalState;
+
+  // Regular expression compiled for every model, as the filter used to be.
+  const std::string filterStr = "box_1*";
+  const double perModelRegex = this->Time([&]()
+  {
+    unsigned int matches = 0;
+    for (auto const &model : world->Models())
+    {
+      boost::regex regex("box_1.*");
+      if (boost::regex_match(model->GetName(), regex))
+        ++matches;
+    }
+    EXPECT_EQ(matches, 111u);
+  });
+
+  const double unfiltered = this->Time([&]()
+  {
+    unfilteredState.Load(world);
+  });
+  EXPECT_EQ(unfilteredState.GetModelStateCount(), models);
+
+  const double filtered = this->Time([&]()
+  {
+    filteredState.LoadWithFilter(world, filterStr);
+  });
+  EXPECT_EQ(filteredState.GetModelStateCount(), 111u);
+
+  util::LogRecordFilter filter(filterStr);
+  const double compiled = this->Time([&]()
+  {
+    compiledState.Load(world, filter);
+  });
+  EXPECT_EQ(compiledState.GetModelStateCount(), 111u);
+
+  util::LogRecordFilter literal("box_42");
+  const double literalFiltered = this->Time([&]()
+  {
+    literalState.Load(world, literal);
+  });
+  EXPECT_EQ(literalState.GetModelStateCount(), 1u);
+
+  // Log worker change detection: a fresh state and a full difference, as
+  // opposed to updating a state in place and comparing it.
+  physics::WorldState prevState(world);
+  const double copyDiff = this->Time([&]()
+  {
+    physics::WorldState newState;
+    newState.Load(world);
+    EXPECT_TRUE((newState - prevState).IsZero());
+  });
+
+  physics::WorldState inPlaceState;
+  const double inPlaceDiff = this->Time([&]()
+  {
+    inPlaceState.Load(world);
+    EXPECT_TRUE(inPlaceState.DiffIsZero(prevState));
+  });
+
+  gzmsg << "WorldState::Load with [" << models << "] models\n"
+        << "  unfiltered                [" << unfiltered << "] us\n"
+        << "  LoadWithFilter(box_1*)    [" << filtered << "] us\n"
+        << "  compiled filter (box_1*)  [" << compiled << "] us\n"
+        << "  compiled filter (box_42)  [" << literalFiltered << "] us\n"
+        << "  per model regex, no load  [" << perModelRegex << "] us\n"
+        << "  new state and operator-   [" << copyDiff << "] us\n"
+        << "  in place and DiffIsZero   [" << inPlaceDiff << "] us\n";
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
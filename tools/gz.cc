@@ -1003,6 +1003,121 @@ void StatsCommand::CB(ConstWorldStatisticsPtr &_msg)
         percent, simTime.Double(), realTime.Double(), paused);
 }
 
+/////////////////////////////////////////////////
+ProfileCommand::ProfileCommand()
+  : Command("profile", "Record and export a profile of a running gzserver.")
+{
+  // Options that are visible to the user through help.
+  this->visibleOptions.add_options()
+    ("world-name,w", po::value<std::string>(), "World name.")
+    ("enable,e", "Start recording profiling zones.")
+    ("disable,d", "Stop recording profiling zones.")
+    ("clear,c", "Drop the recorded profiling zones.")
+    ("stats,s", po::value<double>()->implicit_value(10),
+     "Print the statistics of the zones recorded in the last arg seconds.")
+    ("trace,t", po::value<std::string>(),
+     "Write the recorded zones to a Chrome trace file, which Perfetto and "
+     "chrome://tracing can open.");
+}
+
+/////////////////////////////////////////////////
+void ProfileCommand::HelpDetailed()
+{
+  std::cerr <<
+    "\tRecord the profiling zones of a running gzserver, and print their\n"
+    "\tstatistics or export them as a trace. Recording is disabled until\n"
+    "\toption -e is given. If a name for the world, option -w, is not\n"
+    "\tspecified, the first world found on the Gazebo master will be used.\n"
+    << std::endl;
+}
+
+/////////////////////////////////////////////////
+bool ProfileCommand::Request(const std::string &_worldName,
+    const std::string &_request, const std::string &_data,
+    std::string &_result)
+{
+  boost::shared_ptr<msgs::Response> response = transport::request(
+      _worldName, _request, _data);
+
+  msgs::GzString msg;
+  if (!response || response->type() != msg.GetTypeName() ||
+      !msg.ParseFromString(response->serialized_data()))
+  {
+    std::string tmpWorldName = _worldName.empty() ? "default" : _worldName;
+    std::cerr << "Unable to send request[" << _request << "] to the world["
+      << tmpWorldName << "]\n";
+    return false;
+  }
+
+  _result = msg.data();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool ProfileCommand::RunImpl()
+{
+  std::string worldName;
+
+  if (this->vm.count("world-name"))
+    worldName = this->vm["world-name"].as<std::string>();
+
+  if (!this->vm.count("enable") && !this->vm.count("disable") &&
+      !this->vm.count("clear") && !this->vm.count("stats") &&
+      !this->vm.count("trace"))
+  {
+    this->Help();
+    return false;
+  }
+
+  std::string result;
+
+  // Export before changing the state of the timeline, so that the zones
+  // recorded so far can be saved and then cleared in one command.
+  if (this->vm.count("stats"))
+  {
+    std::ostringstream window;
+    window << this->vm["stats"].as<double>();
+    if (!this->Request(worldName, "profile_stats", window.str(), result))
+      return false;
+    std::cout << result;
+  }
+
+  if (this->vm.count("trace"))
+  {
+    if (!this->Request(worldName, "profile_trace", "", result))
+      return false;
+
+    const std::string filename = this->vm["trace"].as<std::string>();
+    std::ofstream out(filename.c_str());
+    if (!out)
+    {
+      std::cerr << "Unable to open file[" << filename << "]\n";
+      return false;
+    }
+    out << result;
+  }
+
+  if (this->vm.count("clear") &&
+      !this->Request(worldName, "profile_clear", "", result))
+  {
+    return false;
+  }
+
+  if (this->vm.count("enable") &&
+      !this->Request(worldName, "profile_enable", "1", result))
+  {
+    return false;
+  }
+
+  if (this->vm.count("disable") &&
+      !this->Request(worldName, "profile_enable", "0", result))
+  {
+    return false;
+  }
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 SDFCommand::SDFCommand()
   : Command("sdf",
@@ -1308,6 +1423,7 @@ int main(int argc, char **argv)
   g_commandMap["model"] = new ModelCommand();
   g_commandMap["world"] = new WorldCommand();
   g_commandMap["physics"] = new PhysicsCommand();
+  g_commandMap["profile"] = new ProfileCommand();
   g_commandMap["stats"] = new StatsCommand();
   g_commandMap["topic"] = new TopicCommand();
   g_commandMap["log"] = new LogCommand();
@@ -202,6 +202,29 @@ namespace gazebo
     private: std::list<common::Time> realTimes;
   };
 
+  /// \brief Profile command
+  class ProfileCommand : public Command
+  {
+    /// \brief Constructor
+    public: ProfileCommand();
+
+    // Documentation inherited
+    public: virtual void HelpDetailed();
+
+    // Documentation inherited
+    protected: virtual bool RunImpl();
+
+    /// \brief Send a profiling request to the world.
+    /// \param[in] _worldName Name of the world.
+    /// \param[in] _request Name of the request.
+    /// \param[in] _data Data of the request.
+    /// \param[out] _result Text sent back by the world.
+    /// \return True if the world answered the request.
+    private: bool Request(const std::string &_worldName,
+                 const std::string &_request, const std::string &_data,
+                 std::string &_result);
+  };
+
   /// \brief SDF command
   class SDFCommand : public Command
   {
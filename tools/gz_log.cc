@@ -618,9 +618,10 @@ LogCommand::LogCommand()
      "encoding commands. By default, the output file will have the same "
      "encoding as the source file. Override with the --encoding option")
     ("encoding,n", po::value<std::string>(),
-     "Specify the encoding (txt, zlib, or bz2) for an output file. "
+     "Specify the encoding (txt, zlib, bz2, or bin) for an output file. "
      "Valid in conjunction with the output command. See also the "
-     "--output argument.")
+     "--output argument. Use bin to convert a log to the indexed binary "
+     "format.")
     ("filter", po::value<std::string>(),
      "Filter output. Valid only with the echo, step, and output commands");
 }
@@ -841,10 +842,22 @@ void LogCommand::Output(const std::string &_outFilename,
   std::string stateString, bufferString;
 
   std::string encoding = _encoding.empty() ? play->Encoding() : _encoding;
-  if (encoding != "txt" && encoding != "zlib" && encoding != "bz2")
+  if (encoding != "txt" && encoding != "zlib" && encoding != "bz2" &&
+      encoding != "bin")
   {
     std::cerr << "Invalid log file encoding[" << encoding << "]. "
-      << "Use one of: txt, bz2, zlib.\n";
+      << "Use one of: txt, bz2, zlib, bin.\n";
+    outFile.close();
+    return;
+  }
+
+  if (encoding == "bin")
+  {
+    if (_raw)
+      std::cerr << "The raw option can't be used with the bin encoding.\n";
+    else
+      this->OutputBinary(outFile, _filter, _stamp, _hz);
+
     outFile.close();
     return;
   }
@@ -892,6 +905,44 @@ void LogCommand::Output(const std::string &_outFilename,
   outFile.close();
 }
 
+/////////////////////////////////////////////////
+void LogCommand::OutputBinary(std::ofstream &_outFile,
+    const std::string &_filter, const std::string &_stamp, const double _hz)
+{
+  gazebo::util::LogPlay *play = gazebo::util::LogPlay::Instance();
+
+  std::string buffer;
+  gazebo::util::LogBinaryWriter writer;
+  writer.Header(play->Header() + "</gazebo_log>\n", buffer);
+
+  // Frames are copied as they are, unless they have to be filtered.
+  const bool filtered = !_filter.empty() || !_stamp.empty() || _hz > 0;
+  StateFilter filter(true, _stamp, _hz);
+  filter.Init(_filter);
+
+  std::string stateString;
+  unsigned int i = 0;
+  while (play->Step(stateString))
+  {
+    if (i == 0 || !filtered)
+      writer.AddFrames(stateString, buffer);
+    else
+      writer.AddFrames(filter.Filter(stateString), buffer);
+
+    if (buffer.size() > 1000000)
+    {
+      _outFile.write(buffer.c_str(), buffer.size());
+      buffer.clear();
+    }
+
+    ++i;
+  }
+
+  // Append the frame index.
+  writer.Footer(buffer);
+  _outFile.write(buffer.c_str(), buffer.size());
+}
+
 /////////////////////////////////////////////////
 void LogCommand::Echo(const std::string &_filter, bool _raw,
     const std::string &_stamp, double _hz)
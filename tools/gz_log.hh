@@ -216,12 +216,23 @@ namespace gazebo
     /// \param[in] _hz Hertz rate.
     /// \param[in] _encoding Specify output log file encoding. If empty, the
     /// encoding from the source log file is used.
-    /// Valid values include (txt, zlib, bz2)
+    /// Valid values include (txt, zlib, bz2, bin)
     private: void Output(const std::string &_outFilename,
                  const std::string &_filter, const bool _raw,
                  const std::string &_stamp, const double _hz,
                  const std::string &_encoding = "");
 
+    /// \brief Output the open log file in the binary encoding. This
+    /// converts text and compressed logs to the indexed format.
+    /// \param[in] _outFile Output file stream reference.
+    /// \param[in] _filter Filter string
+    /// \param[in] _stamp Type of stamp to apply.
+    /// Valid values are (sim,real,wall)
+    /// \param[in] _hz Hertz rate.
+    private: void OutputBinary(std::ofstream &_outFile,
+                 const std::string &_filter, const std::string &_stamp,
+                 const double _hz);
+
     /// \brief Dump the contents of a log file to screen
     /// \param[in] _filter Filter string
     /// \param[in] _raw True to output data without xml formatting.